@@ -11,6 +11,9 @@
 
 #include "local_player.h"
 #include "tts_manager.h"
+#ifdef CONFIG_MEDIA_SEEK_TABLE
+#include <media_seek_table.h>
+#endif
 
 
 #define ENABLE_LCPLAYER_FADEIN_FADEOUT 1
@@ -96,6 +99,13 @@ static void _mplayer_cleanup(struct local_player_t *lcplayer)
 		lcplayer->player = NULL;
 	}
 
+#ifdef CONFIG_MEDIA_SEEK_TABLE
+	if (lcplayer->seek_table) {
+		media_seek_table_close(lcplayer->seek_table);
+		lcplayer->seek_table = NULL;
+	}
+#endif
+
 	if (lcplayer->file_stream) {
 		stream_close(lcplayer->file_stream);
 		stream_destroy(lcplayer->file_stream);
@@ -167,6 +177,10 @@ struct local_player_t *mplayer_start_play(struct lcplay_param *lcparam)
 		return NULL;
 	}
 
+#ifdef CONFIG_MEDIA_SEEK_TABLE
+	lcplayer->seek_table = media_seek_table_open(lcparam->url, get_music_file_type(lcparam->url));
+#endif
+
 #ifdef CONFIG_PLAYTTS
 	tts_manager_wait_finished(false);
 #endif
@@ -210,6 +224,19 @@ struct local_player_t *mplayer_start_play(struct lcplay_param *lcparam)
 		init_param.bp_time_offset = lcparam->seek_time;
 	}
 
+#ifdef CONFIG_MEDIA_SEEK_TABLE
+	/* resume from an exact point close to the breakpoint */
+	if (lcplayer->seek_table && init_param.bp_file_offset <= 0 && init_param.bp_time_offset > 0) {
+		media_breakpoint_info_t bp;
+
+		if (!media_seek_table_find(lcplayer->seek_table, init_param.bp_time_offset,
+				MEDIA_SEEK_TABLE_TOLERANCE, &bp)) {
+			init_param.bp_time_offset = bp.time_offset;
+			init_param.bp_file_offset = bp.file_offset;
+		}
+	}
+#endif
+
 	/* open service */
 	lcplayer->player = media_player_open(&init_param);
 	if (!lcplayer->player) {
@@ -217,6 +244,10 @@ struct local_player_t *mplayer_start_play(struct lcplay_param *lcparam)
 		goto err_exit;
 	}
 
+#ifdef CONFIG_MEDIA_SEEK_TABLE
+	media_player_set_seek_table(lcplayer->player, lcplayer->seek_table);
+#endif
+
 #ifdef CONFIG_BT_TRANSMIT
 	/*makesure bt transmit STEREO mode*/
 	media_player_set_effect_output_mode(lcplayer->player, MEDIA_EFFECT_OUTPUT_DEFAULT);
@@ -57,6 +57,9 @@
 struct local_player_t {
 	media_player_t *player;
 	io_stream_t file_stream;
+#ifdef CONFIG_MEDIA_SEEK_TABLE
+	void *seek_table;
+#endif
 };
 
 struct lcplay_param {
@@ -54,6 +54,10 @@
 
 #define DUMP_API                              0   // Dump VGLite API.
 #define USE_BOUNDARY_JUDGMENT                 0   // When USE_BOUNDARY_JUDGMENT is enabled, determine if the rendering boundary of path is within buffer.
+#ifndef SVG_PATH_CACHE
+#define SVG_PATH_CACHE                        1   // Compile the paths of an image once and reuse them in later renders.
+#endif
+#define SVG_RENDER_PROFILE                    0   // Print the time spent in each renderSVGImage().
 
 
 #if VG_STABLE_MODE
@@ -61,6 +65,11 @@
 static int commit_count = 0;
 #endif
 
+#if SVG_PATH_CACHE
+#define SVG_CACHE_MAX_IMAGES                  4      // Number of images keeping compiled paths.
+#define SVG_CACHE_SCALE_THRESHOLD             0.1f   // Relative scale change that recompiles the paths.
+#endif
+
 #include "nanosvg.h"
 #include "vg_lite.h"
 
@@ -102,8 +111,35 @@ static unsigned int unicode;
 static vg_lite_fill_t fill_rule;
 static vg_lite_float_t shape_bound[4]; // [minx,miny,maxx,maxy]
 static vg_lite_float_t global_scale = 1.0f;
-
-#ifdef CONFIG_FREETYPE_FONT
+static vg_lite_path_t *draw_path = &vgl_path; // path of the shape being rendered
+
+/* Gradient stops resolved with the shape opacity */
+typedef struct {
+    vg_lite_color_ramp_t *ramps;
+    uint8_t translucent;    // some stop is not opaque before applying opacity
+} svg_cached_paint_t;
+
+/* Shape compiled at the scale of the cache */
+typedef struct {
+    vg_lite_path_t path;    // path data, and stroke path if stroked
+    vg_lite_float_t bound[4];
+    svg_cached_paint_t fill;
+    svg_cached_paint_t stroke;
+    uint8_t compiled;
+} svg_cached_shape_t;
+
+typedef struct {
+    NSVGimage *image;
+    vg_lite_float_t scale;
+    int nshapes;
+    svg_cached_shape_t *shapes;
+    uint32_t last_use;
+} svg_cache_t;
+
+#if SVG_PATH_CACHE
+static svg_cache_t svg_caches[SVG_CACHE_MAX_IMAGES];
+static uint32_t svg_cache_clock;
+#endif
 
 static void setOpacity(vg_lite_color_t* pcolor, float opacity)
 {
@@ -118,6 +154,8 @@ static void setOpacity(vg_lite_color_t* pcolor, float opacity)
     }
 }
 
+#ifdef CONFIG_FREETYPE_FONT
+
 static vg_lite_error_t drawCharacter(vg_lite_buffer_t * render_buffer_ptr, NSVGshape* shape, svgfont_t * font, svgfont_glyph_dsc_t * g,
         uint32_t unicode, float x, float y, unsigned int color)
 {
@@ -276,19 +314,30 @@ VGLError:
     return 1;
 }
 
-static vg_lite_error_t generateVGLitePath(NSVGpath* shape_path, vg_lite_path_t* vgl_path, vg_lite_path_type_t path_type)
+/* Number of floats to hold the VGLite path data of shape_path */
+static int getVGLitePathSize(NSVGpath* shape_path)
+{
+    int size = 1; /* VLC_OP_END */
+
+    for (NSVGpath* path = shape_path; path != NULL; path = path->next)
+        size += (7 * path->npts + 10) / 3;
+
+    return size;
+}
+
+static vg_lite_error_t generateVGLitePath(NSVGpath* shape_path, vg_lite_path_t* vgl_path, vg_lite_path_type_t path_type, int buf_size)
 {
     float* d = &((float*)vgl_path->path)[0];
-    float* bufend = d + PATH_DATA_BUFFER_SIZE;
+    float* bufend = d + buf_size;
 
     for (NSVGpath* path = shape_path; path != NULL; path = path->next)
     {
         float* s = &path->pts[0];
 
-        /* Exit if remaining path_data_buf[] is not sufficient to hold the path data */
+        /* Exit if remaining path data buffer is not sufficient to hold the path data */
         if ((bufend - d) < (7 * path->npts + 10) / 3)
         {
-            NANOSVG_PRINT("Error: Need to increase PATH_DATA_BUFFER_SIZE for path_data_buf[].\n");
+            NANOSVG_PRINT("Error: Need to increase the size of path data buffer (%d).\n", buf_size);
             goto VGLError;
         }
 
@@ -328,7 +377,7 @@ VGLError:
 
 static int renderGradientPath(vg_lite_buffer_t* render_buffer_ptr, NSVGpaint *paint, char *gradid, unsigned int color, float opacity,
                               float fill_opacity, float stroke_opacity, int is_fill, int is_stroke, char* patternid,
-                              int shape_blend)
+                              int shape_blend, const svg_cached_paint_t *cpaint)
 {
     vg_lite_blend_t blend_mode = VG_LITE_BLEND_NONE;
     if (is_fill)
@@ -368,15 +417,22 @@ static int renderGradientPath(vg_lite_buffer_t* render_buffer_ptr, NSVGpaint *pa
                 vg_lite_matrix_t* grad_matrix;
                 float dx, dy, X0, X1, Y0, Y1;
 
+                vg_lite_color_ramp_t* ramps = grad_ramps;
+
                 memset(&grad, 0, sizeof(grad));
 
-                for (int i = 0; i < paint->gradient->nstops; i++) {
-                    setOpacity(&(paint->gradient->stops[i].color), opacity);
-                    grad_ramps[i].stop = paint->gradient->stops[i].offset;
-                    grad_ramps[i].alpha = ((paint->gradient->stops[i].color & 0xFF000000) >> 24) / 255.0f;
-                    grad_ramps[i].blue = ((paint->gradient->stops[i].color & 0x00FF0000) >> 16) / 255.0f;
-                    grad_ramps[i].green = ((paint->gradient->stops[i].color & 0x0000FF00) >> 8) / 255.0f;;
-                    grad_ramps[i].red = (paint->gradient->stops[i].color & 0x000000FF) / 255.0f;;
+                if (cpaint && cpaint->ramps) {
+                    ramps = cpaint->ramps;
+                }
+                else {
+                    for (int i = 0; i < paint->gradient->nstops; i++) {
+                        setOpacity(&(paint->gradient->stops[i].color), opacity);
+                        grad_ramps[i].stop = paint->gradient->stops[i].offset;
+                        grad_ramps[i].alpha = ((paint->gradient->stops[i].color & 0xFF000000) >> 24) / 255.0f;
+                        grad_ramps[i].blue = ((paint->gradient->stops[i].color & 0x00FF0000) >> 16) / 255.0f;
+                        grad_ramps[i].green = ((paint->gradient->stops[i].color & 0x0000FF00) >> 8) / 255.0f;;
+                        grad_ramps[i].red = (paint->gradient->stops[i].color & 0x000000FF) / 255.0f;;
+                    }
                 }
 
                 X0 = paint->gradient->param[0];
@@ -400,7 +456,7 @@ static int renderGradientPath(vg_lite_buffer_t* render_buffer_ptr, NSVGpaint *pa
                     grad_param.Y1 = Y1 * global_scale;
                 }
 
-                VGL_ERROR_CHECK(vg_lite_set_linear_grad(&grad, paint->gradient->nstops, grad_ramps, grad_param, vglspread[(int)paint->gradient->spread], 0));
+                VGL_ERROR_CHECK(vg_lite_set_linear_grad(&grad, paint->gradient->nstops, ramps, grad_param, vglspread[(int)paint->gradient->spread], 0));
 
                 grad_matrix = vg_lite_get_linear_grad_matrix(&grad);
                 VGL_ERROR_CHECK(vg_lite_identity(grad_matrix));
@@ -418,7 +474,7 @@ static int renderGradientPath(vg_lite_buffer_t* render_buffer_ptr, NSVGpaint *pa
 
                 VGL_ERROR_CHECK(vg_lite_update_linear_grad(&grad));
 
-                VGL_ERROR_CHECK(vg_lite_draw_linear_grad(render_buffer_ptr, &vgl_path, VG_LITE_FILL_EVEN_ODD, &global_matrix, &grad, color, grad_blend, VG_LITE_FILTER_POINT));
+                VGL_ERROR_CHECK(vg_lite_draw_linear_grad(render_buffer_ptr, draw_path, VG_LITE_FILL_EVEN_ODD, &global_matrix, &grad, color, grad_blend, VG_LITE_FILTER_POINT));
 
                 VGL_ERROR_CHECK(vg_lite_finish());
                 VGL_ERROR_CHECK(vg_lite_clear_linear_grad(&grad));
@@ -484,7 +540,7 @@ static int renderGradientPath(vg_lite_buffer_t* render_buffer_ptr, NSVGpaint *pa
                 if (paint->gradient->units == NSVG_OBJECT_SPACE)
                     VGL_ERROR_CHECK(vg_lite_rotate(angle, grad_matrix));
 
-                VGL_ERROR_CHECK(vg_lite_draw_grad(render_buffer_ptr, &vgl_path, VG_LITE_FILL_EVEN_ODD, &global_matrix, &grad, grad_blend));
+                VGL_ERROR_CHECK(vg_lite_draw_grad(render_buffer_ptr, draw_path, VG_LITE_FILL_EVEN_ODD, &global_matrix, &grad, grad_blend));
 
                 VGL_ERROR_CHECK(vg_lite_finish());
                 VGL_ERROR_CHECK(vg_lite_clear_grad(&grad));
@@ -498,20 +554,28 @@ static int renderGradientPath(vg_lite_buffer_t* render_buffer_ptr, NSVGpaint *pa
                 vg_lite_matrix_t* grad_matrix;
                 float cx, cy, r, fx, fy;
                 float dx, dy;
+                vg_lite_color_ramp_t* ramps = grad_ramps;
 
                 memset(&grad, 0, sizeof(grad));
 
-                for (int i = 0; i < paint->gradient->nstops; i++) {
-
-                    if (((((paint->gradient->stops[i].color & 0xFF000000) >> 24) / 255.0f) < 1) && grad_blend == VG_LITE_BLEND_SRC_OVER)
+                if (cpaint && cpaint->ramps) {
+                    ramps = cpaint->ramps;
+                    if (cpaint->translucent && grad_blend == VG_LITE_BLEND_SRC_OVER)
                         grad_blend = OPENVG_BLEND_SRC_OVER;
+                }
+                else {
+                    for (int i = 0; i < paint->gradient->nstops; i++) {
 
-                    setOpacity(&(paint->gradient->stops[i].color), opacity);
-                    grad_ramps[i].stop = paint->gradient->stops[i].offset;
-                    grad_ramps[i].alpha = ((paint->gradient->stops[i].color & 0xFF000000) >> 24) / 255.0f;
-                    grad_ramps[i].blue = ((paint->gradient->stops[i].color & 0x00FF0000) >> 16) / 255.0f;
-                    grad_ramps[i].green = ((paint->gradient->stops[i].color & 0x0000FF00) >> 8) / 255.0f;
-                    grad_ramps[i].red = (paint->gradient->stops[i].color & 0x000000FF) / 255.0f;
+                        if (((((paint->gradient->stops[i].color & 0xFF000000) >> 24) / 255.0f) < 1) && grad_blend == VG_LITE_BLEND_SRC_OVER)
+                            grad_blend = OPENVG_BLEND_SRC_OVER;
+
+                        setOpacity(&(paint->gradient->stops[i].color), opacity);
+                        grad_ramps[i].stop = paint->gradient->stops[i].offset;
+                        grad_ramps[i].alpha = ((paint->gradient->stops[i].color & 0xFF000000) >> 24) / 255.0f;
+                        grad_ramps[i].blue = ((paint->gradient->stops[i].color & 0x00FF0000) >> 16) / 255.0f;
+                        grad_ramps[i].green = ((paint->gradient->stops[i].color & 0x0000FF00) >> 8) / 255.0f;
+                        grad_ramps[i].red = (paint->gradient->stops[i].color & 0x000000FF) / 255.0f;
+                    }
                 }
 
                 cx = paint->gradient->param[0];
@@ -538,7 +602,7 @@ static int renderGradientPath(vg_lite_buffer_t* render_buffer_ptr, NSVGpaint *pa
                     grad_param.fy = (fy == 0.0f) ? grad_param.cy : (fy * global_scale);
                 }
 
-                VGL_ERROR_CHECK(vg_lite_set_radial_grad(&grad, paint->gradient->nstops, grad_ramps, grad_param, vglspread[(int)paint->gradient->spread], 0));
+                VGL_ERROR_CHECK(vg_lite_set_radial_grad(&grad, paint->gradient->nstops, ramps, grad_param, vglspread[(int)paint->gradient->spread], 0));
                 VGL_ERROR_CHECK(vg_lite_update_radial_grad(&grad));
 
                 grad_matrix = vg_lite_get_radial_grad_matrix(&grad);
@@ -554,7 +618,7 @@ static int renderGradientPath(vg_lite_buffer_t* render_buffer_ptr, NSVGpaint *pa
                         j++;
                     }
                 }
-                VGL_ERROR_CHECK(vg_lite_draw_radial_grad(render_buffer_ptr, &vgl_path, VG_LITE_FILL_EVEN_ODD, &global_matrix, &grad, color, grad_blend, VG_LITE_FILTER_POINT));
+                VGL_ERROR_CHECK(vg_lite_draw_radial_grad(render_buffer_ptr, draw_path, VG_LITE_FILL_EVEN_ODD, &global_matrix, &grad, color, grad_blend, VG_LITE_FILTER_POINT));
 
                 VGL_ERROR_CHECK(vg_lite_finish());
                 VGL_ERROR_CHECK(vg_lite_clear_radial_grad(&grad));
@@ -570,7 +634,7 @@ static int renderGradientPath(vg_lite_buffer_t* render_buffer_ptr, NSVGpaint *pa
     else
     {
         /* Render the shape with VGLite cubic bezier path data */
-        VGL_ERROR_CHECK(vg_lite_draw(render_buffer_ptr, &vgl_path, fill_rule, &global_matrix, blend_mode, color));
+        VGL_ERROR_CHECK(vg_lite_draw(render_buffer_ptr, draw_path, fill_rule, &global_matrix, blend_mode, color));
     }
 
     return 0;
@@ -634,7 +698,7 @@ static int renderPatternPath(vg_lite_buffer_t *render_buffer_ptr, NSVGpaint* pai
                 path_type |= VG_LITE_DRAW_STROKE_PATH;
 
 
-            VGL_ERROR_CHECK(generateVGLitePath(pattern_shape->paths, &pattern_path, path_type));
+            VGL_ERROR_CHECK(generateVGLitePath(pattern_shape->paths, &pattern_path, path_type, PATTERN_BUFFER_SIZE));
 
             if (pattern_shape->stroke.type != NSVG_PAINT_NONE)
             {
@@ -678,7 +742,7 @@ static int renderPatternPath(vg_lite_buffer_t *render_buffer_ptr, NSVGpaint* pai
                 VGL_ERROR_CHECK(vg_lite_translate(paint->pattern->x, paint->pattern->y, &matrix));
             }
 
-            VGL_ERROR_CHECK(vg_lite_draw_pattern(render_buffer_ptr, &vgl_path, VG_LITE_FILL_EVEN_ODD, &vglmatrix, &pattern_buf, &matrix, VG_LITE_BLEND_NONE, VG_LITE_PATTERN_REPEAT, 0, 0, VG_LITE_FILTER_POINT));
+            VGL_ERROR_CHECK(vg_lite_draw_pattern(render_buffer_ptr, draw_path, VG_LITE_FILL_EVEN_ODD, &vglmatrix, &pattern_buf, &matrix, VG_LITE_BLEND_NONE, VG_LITE_PATTERN_REPEAT, 0, 0, VG_LITE_FILTER_POINT));
             VGL_ERROR_CHECK(vg_lite_finish());
         }
         else
@@ -697,7 +761,7 @@ static int renderPatternPath(vg_lite_buffer_t *render_buffer_ptr, NSVGpaint* pai
 
             VGL_ERROR_CHECK(vg_lite_identity(&temp_mat));
             VGL_ERROR_CHECK(vg_lite_translate(-shape_bound[0], -shape_bound[1], &temp_mat));
-            VGL_ERROR_CHECK(vg_lite_draw(&temp_buf, &vgl_path, VG_LITE_FILL_EVEN_ODD, &temp_mat, VG_LITE_BLEND_SRC_OVER, 0xFFFFFFFF));
+            VGL_ERROR_CHECK(vg_lite_draw(&temp_buf, draw_path, VG_LITE_FILL_EVEN_ODD, &temp_mat, VG_LITE_BLEND_SRC_OVER, 0xFFFFFFFF));
 
             int start_x = 0;
             int start_y = 0;
@@ -776,7 +840,7 @@ static vg_lite_buffer_t* renderClipPath(vg_lite_buffer_t* render_buffer_ptr, NSV
     VGL_ERROR_CHECK(vg_lite_identity(&clip_path_matrix));
     VGL_ERROR_CHECK(vg_lite_init_path(&clip_path, VG_LITE_FP32, VG_LITE_MEDIUM, 0, &path_data_buf[0],
         shape->clipPath->path->bounds[0], shape->clipPath->path->bounds[1], shape->clipPath->path->bounds[2], shape->clipPath->path->bounds[3]));
-    generateVGLitePath(shape->clipPath->path, &clip_path, VG_LITE_DRAW_FILL_PATH);
+    generateVGLitePath(shape->clipPath->path, &clip_path, VG_LITE_DRAW_FILL_PATH, PATH_DATA_BUFFER_SIZE);
     VGL_ERROR_CHECK(vg_lite_draw(&clip_path_buffer, &clip_path, VG_LITE_FILL_EVEN_ODD, &global_matrix, VG_LITE_BLEND_NONE, 0xFF000000));
     VGL_ERROR_CHECK(vg_lite_blit(&clip_path_buffer, render_buffer_ptr, &clip_path_matrix, VG_LITE_BLEND_SRC_IN, 0, 0));
     VGL_ERROR_CHECK(vg_lite_finish());
@@ -789,6 +853,172 @@ VGLError:
     return NULL;
 }
 
+#if SVG_PATH_CACHE
+static void resolveGradientPaint(NSVGpaint *paint, char *gradid, float opacity, svg_cached_paint_t *cpaint)
+{
+    if (gradid[0] == '\0' || paint->gradient == NULL ||
+        (paint->type != NSVG_PAINT_LINEAR_GRADIENT && paint->type != NSVG_PAINT_RADIAL_GRADIENT))
+        return;
+
+    /* Stay with per render resolving if out of memory */
+    cpaint->ramps = NANOSVG_MALLOC(paint->gradient->nstops * sizeof(vg_lite_color_ramp_t));
+    if (cpaint->ramps == NULL)
+        return;
+
+    for (int i = 0; i < paint->gradient->nstops; i++) {
+        vg_lite_color_t color = paint->gradient->stops[i].color;
+
+        if ((color & 0xFF000000) != 0xFF000000)
+            cpaint->translucent = 1;
+
+        setOpacity(&color, opacity);
+        cpaint->ramps[i].stop = paint->gradient->stops[i].offset;
+        cpaint->ramps[i].alpha = ((color & 0xFF000000) >> 24) / 255.0f;
+        cpaint->ramps[i].blue = ((color & 0x00FF0000) >> 16) / 255.0f;
+        cpaint->ramps[i].green = ((color & 0x0000FF00) >> 8) / 255.0f;
+        cpaint->ramps[i].red = (color & 0x000000FF) / 255.0f;
+    }
+}
+
+static void freeSVGShape(svg_cached_shape_t *cshape)
+{
+    if (cshape->compiled) {
+        vg_lite_clear_path(&cshape->path);
+        NANOSVG_FREE(cshape->path.path);
+    }
+
+    if (cshape->fill.ramps)
+        NANOSVG_FREE(cshape->fill.ramps);
+    if (cshape->stroke.ramps)
+        NANOSVG_FREE(cshape->stroke.ramps);
+
+    memset(cshape, 0, sizeof(*cshape));
+}
+
+/* Generate the scaled path data and stroke path of a shape at global_scale */
+static int compileSVGShape(NSVGshape *shape, svg_cached_shape_t *cshape)
+{
+    vg_lite_path_type_t path_type = 0;
+    float *path_data;
+    int size;
+
+    /* Text and image are not drawn by the shape path */
+    if (shape->fill.type == NSVG_PAINT_TEXT || shape->fill.type == NSVG_PAINT_IMAGE)
+        return 0;
+
+    if (shape->fill.type != NSVG_PAINT_NONE)
+        path_type |= VG_LITE_DRAW_FILL_PATH;
+    if (shape->stroke.type != NSVG_PAINT_NONE)
+        path_type |= VG_LITE_DRAW_STROKE_PATH;
+    if (path_type == 0)
+        return 0;
+
+    size = getVGLitePathSize(shape->paths);
+    path_data = NANOSVG_MALLOC(size * sizeof(float));
+    if (path_data == NULL)
+        return 1;
+
+    cshape->bound[0] = shape->bounds[0] * global_scale;
+    cshape->bound[1] = shape->bounds[1] * global_scale;
+    cshape->bound[2] = shape->bounds[2] * global_scale;
+    cshape->bound[3] = shape->bounds[3] * global_scale;
+
+    VGL_ERROR_CHECK(vg_lite_init_path(&cshape->path, VG_LITE_FP32, VG_LITE_MEDIUM, 0, path_data,
+        cshape->bound[0], cshape->bound[1], cshape->bound[2], cshape->bound[3]));
+    VGL_ERROR_CHECK(generateVGLitePath(shape->paths, &cshape->path, path_type, size));
+
+    if (shape->stroke.type != NSVG_PAINT_NONE)
+    {
+        vg_lite_cap_style_t linecap = VG_LITE_CAP_BUTT + shape->strokeLineCap;
+        vg_lite_join_style_t joinstyle = VG_LITE_JOIN_MITER + shape->strokeLineJoin;
+        vg_lite_float_t strokewidth = shape->strokeWidth * global_scale;
+
+        cshape->path.path_type = VG_LITE_DRAW_STROKE_PATH;
+        VGL_ERROR_CHECK(vg_lite_set_stroke(&cshape->path, linecap, joinstyle, strokewidth, shape->miterLimit,
+            shape->strokeDashArray, shape->strokeDashCount, shape->strokeDashOffset, 0xFFFFFFFF));
+        VGL_ERROR_CHECK(vg_lite_update_stroke(&cshape->path));
+    }
+
+    cshape->compiled = 1;
+
+    resolveGradientPaint(&shape->fill, shape->fillGradient, shape->opacity, &cshape->fill);
+    resolveGradientPaint(&shape->stroke, shape->strokeGradient, shape->opacity, &cshape->stroke);
+    return 0;
+
+VGLError:
+    vg_lite_clear_path(&cshape->path);
+    NANOSVG_FREE(path_data);
+    memset(cshape, 0, sizeof(*cshape));
+    return 1;
+}
+
+static void freeSVGCache(svg_cache_t *cache)
+{
+    if (cache->shapes) {
+        for (int i = 0; i < cache->nshapes; i++)
+            freeSVGShape(&cache->shapes[i]);
+
+        NANOSVG_FREE(cache->shapes);
+    }
+
+    memset(cache, 0, sizeof(*cache));
+}
+
+/* Get the compiled paths of image, compile them if not cached or scaled too much */
+static svg_cache_t* getSVGCache(NSVGimage *image, vg_lite_float_t scale)
+{
+    svg_cache_t *cache = NULL;
+    NSVGshape *shape;
+    int i;
+
+    for (i = 0; i < SVG_CACHE_MAX_IMAGES; i++) {
+        if (svg_caches[i].image == image) {
+            cache = &svg_caches[i];
+            break;
+        }
+
+        /* Prefer free entry, else the least recently used one */
+        if (cache == NULL || (cache->image && (svg_caches[i].image == NULL ||
+            (int32_t)(svg_caches[i].last_use - cache->last_use) < 0)))
+            cache = &svg_caches[i];
+    }
+
+    if (cache->image == image) {
+        vg_lite_float_t ratio = scale / cache->scale;
+
+        if (ratio >= 1.0f - SVG_CACHE_SCALE_THRESHOLD && ratio <= 1.0f + SVG_CACHE_SCALE_THRESHOLD) {
+            cache->last_use = ++svg_cache_clock;
+            return cache;
+        }
+    }
+
+    freeSVGCache(cache);
+
+    for (shape = image->shapes; shape != NULL; shape = shape->next)
+        cache->nshapes++;
+
+    cache->shapes = NANOSVG_MALLOC(cache->nshapes * sizeof(svg_cached_shape_t));
+    if (cache->shapes == NULL) {
+        cache->nshapes = 0;
+        return NULL;
+    }
+
+    memset(cache->shapes, 0, cache->nshapes * sizeof(svg_cached_shape_t));
+    cache->image = image;
+    cache->scale = scale;
+    cache->last_use = ++svg_cache_clock;
+
+    global_scale = scale;
+    for (i = 0, shape = image->shapes; shape != NULL; shape = shape->next, i++) {
+        /* Shapes failed to compile are rendered without cache */
+        if (shape->flags & NSVG_FLAGS_VISIBLE)
+            compileSVGShape(shape, &cache->shapes[i]);
+    }
+
+    return cache;
+}
+#endif /* SVG_PATH_CACHE */
+
 int renderSVGImage(NSVGimage *image, vg_lite_buffer_t *render_buffer_ptr, vg_lite_matrix_t *extra_matrix, vg_lite_float_t scale_size, void *ft_face)
 {
     NSVGshape *shape = NULL;
@@ -796,8 +1026,15 @@ int renderSVGImage(NSVGimage *image, vg_lite_buffer_t *render_buffer_ptr, vg_lit
 
     vg_lite_buffer_t* current_render_buffer_ptr;
     char clip_flag = 0;
+    svg_cache_t *cache = NULL;
+    svg_cached_shape_t *cshape = NULL;
+    int shape_idx;
+#if SVG_RENDER_PROFILE
+    uint32_t start_time = NANOSVG_GETTIME();
+#endif
 
     memset(&vgl_path, 0, sizeof(vg_lite_path_t));
+    draw_path = &vgl_path;
     current_render_buffer_ptr = render_buffer_ptr;
     global_scale = scale_size;
 
@@ -811,12 +1048,25 @@ int renderSVGImage(NSVGimage *image, vg_lite_buffer_t *render_buffer_ptr, vg_lit
         VGL_ERROR_CHECK(vg_lite_identity(&global_matrix));
     }
 
+#if SVG_PATH_CACHE
+    cache = getSVGCache(image, scale_size);
+    if (cache) {
+        /* Render at the compiled scale, the matrix takes the remaining difference */
+        if (cache->scale != scale_size)
+            VGL_ERROR_CHECK(vg_lite_scale(scale_size / cache->scale, scale_size / cache->scale, &global_matrix));
+
+        global_scale = cache->scale;
+    }
+#endif
+
     /* Loop through all shape structures in NSVGimage to render all primitves */
-    for (shape = image->shapes; shape != NULL; shape = shape->next)
+    for (shape = image->shapes, shape_idx = 0; shape != NULL; shape = shape->next, shape_idx++)
     {
         if (!(shape->flags & NSVG_FLAGS_VISIBLE))
             continue;
 
+        cshape = (cache && cache->shapes[shape_idx].compiled) ? &cache->shapes[shape_idx] : NULL;
+
         if (shape->mediaFlag)
         {
             if ((shape->maxWidth > 0 && shape->maxWidth < global_matrix.m[0][0] * render_buffer_ptr->width) || (shape->maxHeight > 0 && shape->maxHeight < global_matrix.m[1][1] * render_buffer_ptr->height))
@@ -858,27 +1108,35 @@ int renderSVGImage(NSVGimage *image, vg_lite_buffer_t *render_buffer_ptr, vg_lit
             current_render_buffer_ptr = renderClipPath(current_render_buffer_ptr, shape, &clip_flag);
         }
 
-        shape_bound[0] = shape->bounds[0] * global_scale;
-        shape_bound[1] = shape->bounds[1] * global_scale;
-        shape_bound[2] = shape->bounds[2] * global_scale;
-        shape_bound[3] = shape->bounds[3] * global_scale;
-
-        VGL_ERROR_CHECK(vg_lite_init_path(&vgl_path, VG_LITE_FP32, VG_LITE_MEDIUM, 0, &path_data_buf[0],
-            shape_bound[0], shape_bound[1], shape_bound[2], shape_bound[3]));
+        /* Set VGLite fill rule */
+        fill_rule = VG_LITE_FILL_NON_ZERO - shape->fillRule;
 
-        path_type = 0;
-        if (shape->fill.type != NSVG_PAINT_NONE) {
-            path_type |= VG_LITE_DRAW_FILL_PATH;
-        }
-        if (shape->stroke.type != NSVG_PAINT_NONE) {
-            path_type |= VG_LITE_DRAW_STROKE_PATH;
+        if (cshape) {
+            /* Path data and stroke path are ready */
+            memcpy(shape_bound, cshape->bound, sizeof(shape_bound));
+            draw_path = &cshape->path;
         }
+        else {
+            shape_bound[0] = shape->bounds[0] * global_scale;
+            shape_bound[1] = shape->bounds[1] * global_scale;
+            shape_bound[2] = shape->bounds[2] * global_scale;
+            shape_bound[3] = shape->bounds[3] * global_scale;
 
-        /* Set VGLite fill rule */
-        fill_rule = VG_LITE_FILL_NON_ZERO - shape->fillRule;
+            draw_path = &vgl_path;
+            VGL_ERROR_CHECK(vg_lite_init_path(&vgl_path, VG_LITE_FP32, VG_LITE_MEDIUM, 0, &path_data_buf[0],
+                shape_bound[0], shape_bound[1], shape_bound[2], shape_bound[3]));
 
-        /* Generate VGLite cubic bezier path data from current shape */
-        VGL_ERROR_CHECK(generateVGLitePath(shape->paths, &vgl_path, path_type));
+            path_type = 0;
+            if (shape->fill.type != NSVG_PAINT_NONE) {
+                path_type |= VG_LITE_DRAW_FILL_PATH;
+            }
+            if (shape->stroke.type != NSVG_PAINT_NONE) {
+                path_type |= VG_LITE_DRAW_STROKE_PATH;
+            }
+
+            /* Generate VGLite cubic bezier path data from current shape */
+            VGL_ERROR_CHECK(generateVGLitePath(shape->paths, &vgl_path, path_type, PATH_DATA_BUFFER_SIZE));
+        }
 
         /* Render VGLite fill path with linear/radial gradient support */
         if (shape->fill.type != NSVG_PAINT_NONE)
@@ -886,7 +1144,7 @@ int renderSVGImage(NSVGimage *image, vg_lite_buffer_t *render_buffer_ptr, vg_lit
             int is_fill = 1;
             int is_stroke = 0;
             /* Render the fill path only */
-            vgl_path.path_type = VG_LITE_DRAW_FILL_PATH;
+            draw_path->path_type = VG_LITE_DRAW_FILL_PATH;
 
             vg_lite_color_t fill_color = shape->fill.color;
             setOpacity(&fill_color, shape->opacity);
@@ -910,7 +1168,7 @@ int renderSVGImage(NSVGimage *image, vg_lite_buffer_t *render_buffer_ptr, vg_lit
 
                 VGL_ERROR_CHECK(renderGradientPath(current_render_buffer_ptr, &shape->fill, shape->fillGradient, fill_color, shape->opacity,
                                 shape->fill_opacity, shape->stroke_opacity, is_fill, is_stroke, shape->fillPattern,
-                                shape->blendMode));
+                                shape->blendMode, cshape ? &cshape->fill : NULL));
             }
         }
 
@@ -925,7 +1183,7 @@ int renderSVGImage(NSVGimage *image, vg_lite_buffer_t *render_buffer_ptr, vg_lit
             vg_lite_color_t stroke_color = shape->stroke.color;
 
             /* Render the stroke path only */
-            vgl_path.path_type = VG_LITE_DRAW_STROKE_PATH;
+            draw_path->path_type = VG_LITE_DRAW_STROKE_PATH;
             if (shape->opacity < 1 || shape->fill_opacity == 0)
             {
                 vg_lite_color_t color = stroke_color;
@@ -937,19 +1195,22 @@ int renderSVGImage(NSVGimage *image, vg_lite_buffer_t *render_buffer_ptr, vg_lit
             }
 
             /* Setup stroke parameters properly */
-            VGL_ERROR_CHECK(vg_lite_set_stroke(&vgl_path, linecap, joinstyle, strokewidth, shape->miterLimit,
-                shape->strokeDashArray, shape->strokeDashCount, shape->strokeDashOffset, 0xFFFFFFFF));
-            VGL_ERROR_CHECK(vg_lite_update_stroke(&vgl_path));
+            if (cshape == NULL) {
+                VGL_ERROR_CHECK(vg_lite_set_stroke(&vgl_path, linecap, joinstyle, strokewidth, shape->miterLimit,
+                    shape->strokeDashArray, shape->strokeDashCount, shape->strokeDashOffset, 0xFFFFFFFF));
+                VGL_ERROR_CHECK(vg_lite_update_stroke(&vgl_path));
+            }
 
             /* Draw stroke path with stroke color */
-            vgl_path.stroke_color = stroke_color;
+            draw_path->stroke_color = stroke_color;
             VGL_ERROR_CHECK(renderGradientPath(current_render_buffer_ptr, &shape->stroke, shape->strokeGradient, stroke_color, shape->opacity,
                             shape->fill_opacity, shape->stroke_opacity, is_fill, is_stroke, shape->fillPattern,
-                            shape->blendMode));
+                            shape->blendMode, cshape ? &cshape->stroke : NULL));
         }
 
-        /* Clear vglpath. */
-        VGL_ERROR_CHECK(vg_lite_clear_path(&vgl_path));
+        /* Clear vglpath, the compiled path is kept for the next render. */
+        if (cshape == NULL)
+            VGL_ERROR_CHECK(vg_lite_clear_path(&vgl_path));
 
         if (shape->next != NULL && shape->next->clipPath != NULL)
             shape->next->blendMode = VG_MIXBLENDMODE_SRCIN;
@@ -982,6 +1243,10 @@ int renderSVGImage(NSVGimage *image, vg_lite_buffer_t *render_buffer_ptr, vg_lit
 
     VGL_ERROR_CHECK(vg_lite_frame_delimiter(VG_LITE_FRAME_END_FLAG));
 
+#if SVG_RENDER_PROFILE
+    NANOSVG_PRINT("render SVG %u ms%s\n", NANOSVG_GETTIME() - start_time, cache ? " (cached)" : "");
+#endif
+
     return 0;
 
 VGLError:
@@ -1021,5 +1286,12 @@ NSVGimage* parseSVGImageFromFile(const char *filename, int *pwidth, int *pheight
 
 void deleteSVGImage(NSVGimage *image)
 {
+#if SVG_PATH_CACHE
+    for (int i = 0; i < SVG_CACHE_MAX_IMAGES; i++) {
+        if (svg_caches[i].image == image)
+            freeSVGCache(&svg_caches[i]);
+    }
+#endif
+
     nsvgDelete(image);
 }
@@ -33,6 +33,24 @@
 
 #define AUDIO_APS_ADJUST_INTERVAL            30
 
+#ifdef CONFIG_AUDIO_APS_PI_CONTROLLER
+/* stream length low pass time constant (ms) */
+#define AUDIO_APS_PI_FILTER_TIME             2000
+/* proportional gain, ppm per ms of stream length error */
+#define AUDIO_APS_PI_KP                      40
+/* integral gain divider, 1/2 ppm per ms error per second */
+#define AUDIO_APS_PI_KI_DIV                  2
+
+/* rate offset of APS_LEVEL_1 ~ APS_LEVEL_8 in ppm, 44.1KHz and 48KHz family */
+static const int16_t aps_level_ppm_44k[] = {
+	-2254, -1712, -850, -345, -11, 399, 732, 2186,
+};
+
+static const int16_t aps_level_ppm_48k[] = {
+	-2510, -1735, -727, -406, 37, 498, 977, 2262,
+};
+#endif
+
 static aps_monitor_info_t aps_monitor;
 
 aps_monitor_info_t *audio_aps_monitor_get_instance(void)
@@ -129,6 +147,171 @@ void audio_aps_monitor_normal(aps_monitor_info_t *handle, int stream_length, uin
 	    break;
     }
 }
+
+#ifdef CONFIG_AUDIO_APS_PI_CONTROLLER
+static void audio_aps_monitor_pi_table(aps_monitor_info_t *handle)
+{
+	uint32_t sample_rate_hz = handle->audio_track ? handle->audio_track->output_sample_rate_hz : 0;
+
+	handle->level_ppm = (sample_rate_hz % 11025 == 0) ? aps_level_ppm_44k : aps_level_ppm_48k;
+}
+
+static void audio_aps_monitor_pi_start(aps_monitor_info_t *handle, int stream_length, uint32_t now)
+{
+	audio_aps_monitor_pi_table(handle);
+	if (!handle->target_len) {
+		handle->target_len = handle->aps_increase_water_mark -
+				(handle->aps_increase_water_mark - handle->aps_reduce_water_mark) / 2;
+	}
+
+	handle->fill_q8 = stream_length << 8;
+	handle->fill_var_q8 = 0;
+	handle->integ_q8 = 0;
+	handle->drift_ppm = 0;
+	handle->dither_ppm = 0;
+	handle->last_time = now;
+	handle->pi_started = 1;
+}
+
+/* pick one of the two levels around ppm, carrying the quantization error to next time */
+static uint8_t audio_aps_monitor_pi_level(aps_monitor_info_t *handle, int32_t ppm)
+{
+	const int16_t *level_ppm = handle->level_ppm;
+	uint8_t lo = handle->aps_min_level;
+	uint8_t hi;
+	int32_t target;
+
+	while (lo < handle->aps_max_level && level_ppm[lo + 1] <= ppm) {
+		lo++;
+	}
+
+	hi = (lo < handle->aps_max_level) ? lo + 1 : lo;
+	if (ppm <= level_ppm[lo]) {
+		handle->dither_ppm = 0;
+		return lo;
+	}
+
+	target = ppm + handle->dither_ppm;
+	if (target * 2 >= level_ppm[lo] + level_ppm[hi]) {
+		lo = hi;
+	}
+
+	handle->dither_ppm = target - level_ppm[lo];
+	return lo;
+}
+
+int32_t audio_aps_monitor_level_to_ppm(aps_monitor_info_t *handle, uint8_t level)
+{
+	if (!handle->level_ppm) {
+		audio_aps_monitor_pi_table(handle);
+	}
+
+	if (level >= ARRAY_SIZE(aps_level_ppm_48k)) {
+		level = ARRAY_SIZE(aps_level_ppm_48k) - 1;
+	}
+
+	return handle->level_ppm[level];
+}
+
+uint8_t audio_aps_monitor_ppm_to_level(aps_monitor_info_t *handle, int32_t ppm)
+{
+	if (!handle->level_ppm) {
+		audio_aps_monitor_pi_table(handle);
+	}
+
+	return audio_aps_monitor_pi_level(handle, ppm);
+}
+
+/*
+ * PI control of the low passed stream length around the target. In steady
+ * state the integral term equals the source/sink clock offset, so it is
+ * also the drift estimate.
+ */
+static void audio_aps_monitor_pi(aps_monitor_info_t *handle, int stream_length)
+{
+	void *audio_handle = handle->audio_track->audio_handle;
+	uint32_t now = k_uptime_get_32();
+	int32_t dev, err_q8, dt, ppm, min_ppm, max_ppm;
+	int64_t var_q8;
+	uint8_t level;
+
+	if (!handle->need_aps) {
+		return;
+	}
+
+	if (!handle->pi_started) {
+		audio_aps_monitor_pi_start(handle, stream_length, now);
+		return;
+	}
+
+	dt = MIN(now - handle->last_time, AUDIO_APS_PI_FILTER_TIME);
+	handle->last_time = now;
+
+	/* low pass against packet jitter, and variance around it */
+	dev = (stream_length << 8) - handle->fill_q8;
+	handle->fill_q8 += dev * dt / AUDIO_APS_PI_FILTER_TIME;
+	var_q8 = (int64_t)(dev / 16) * (dev / 16);
+	var_q8 = handle->fill_var_q8 + (var_q8 - handle->fill_var_q8) * dt / AUDIO_APS_PI_FILTER_TIME;
+	handle->fill_var_q8 = MIN(var_q8, INT32_MAX);
+
+	min_ppm = handle->level_ppm[handle->aps_min_level];
+	max_ppm = handle->level_ppm[handle->aps_max_level];
+
+	/* stream length drifting 1ms per second equals 1000 ppm */
+	err_q8 = handle->fill_q8 - (handle->target_len << 8);
+	handle->drift_ppm = handle->integ_q8 / 256 / AUDIO_APS_PI_KI_DIV;
+	ppm = handle->drift_ppm + AUDIO_APS_PI_KP * err_q8 / 256;
+
+	/* no integration further into saturation */
+	if ((ppm < max_ppm || err_q8 < 0) && (ppm > min_ppm || err_q8 > 0)) {
+		handle->integ_q8 += err_q8 * dt / 1000;
+		handle->integ_q8 = MAX(MIN(handle->integ_q8, max_ppm * 256 * AUDIO_APS_PI_KI_DIV),
+				min_ppm * 256 * AUDIO_APS_PI_KI_DIV);
+	}
+
+	handle->command_ppm = MAX(MIN(ppm, max_ppm), min_ppm);
+
+	level = audio_aps_monitor_pi_level(handle, handle->command_ppm);
+	if (level != handle->current_level) {
+		SYS_LOG_DBG("len %d drift %d cmd %d level %d\n", handle->fill_q8 >> 8,
+				handle->drift_ppm, handle->command_ppm, level);
+		audio_aps_monitor_set_aps(audio_handle, APS_OPR_FAST_SET, level);
+	}
+}
+#endif
+
+int audio_aps_monitor_set_target(uint16_t target_len)
+{
+#ifdef CONFIG_AUDIO_APS_PI_CONTROLLER
+	aps_monitor_info_t *handle = audio_aps_monitor_get_instance();
+
+	handle->target_len = target_len;
+	if (!target_len) {
+		handle->pi_started = 0;
+	}
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+int audio_aps_monitor_get_stat(aps_monitor_stat_t *stat)
+{
+#ifdef CONFIG_AUDIO_APS_PI_CONTROLLER
+	aps_monitor_info_t *handle = audio_aps_monitor_get_instance();
+
+	stat->drift_ppm = handle->drift_ppm;
+	stat->command_ppm = handle->command_ppm;
+	stat->fill_len = handle->fill_q8 >> 8;
+	stat->fill_var = handle->fill_var_q8 >> 8;
+	stat->target_len = handle->target_len;
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
 extern void audio_aps_monitor_slave(aps_monitor_info_t *handle, int stream_length, uint8_t aps_max_level, uint8_t aps_min_level, uint8_t slave_aps_level);
 extern void audio_aps_monitor_master(aps_monitor_info_t *handle, int stream_length, uint8_t aps_max_level, uint8_t aps_min_level, uint8_t slave_aps_level);
 
@@ -147,24 +330,39 @@ void audio_aps_monitor(int pcm_time)
 
 #ifdef CONFIG_TWS
 	if (handle->role == BTSRV_TWS_NONE) {
+#ifdef CONFIG_AUDIO_APS_PI_CONTROLLER
+		audio_aps_monitor_pi(handle, pcm_time);
+#else
 		audio_aps_monitor_normal(handle, pcm_time, handle->aps_max_level, handle->aps_min_level, handle->aps_default_level);
+#endif
 	} else if (handle->role == BTSRV_TWS_MASTER) {
 		audio_aps_monitor_master(handle, pcm_time, handle->aps_max_level, handle->aps_min_level, handle->aps_default_level);
 	} else if (handle->role == BTSRV_TWS_SLAVE) {
 		audio_aps_monitor_slave(handle, pcm_time, handle->aps_max_level, handle->aps_min_level, handle->current_level);
 	}
+#else
+#ifdef CONFIG_AUDIO_APS_PI_CONTROLLER
+	audio_aps_monitor_pi(handle, pcm_time);
 #else
 	audio_aps_monitor_normal(handle, pcm_time, handle->aps_max_level, handle->aps_min_level, handle->aps_default_level);
 #endif
+#endif
 }
 
 void audio_aps_monitor_init(int format, void *tws_observer, struct audio_track_t *audio_track)
 {
 	aps_monitor_info_t *handle = audio_aps_monitor_get_instance();
+#ifdef CONFIG_AUDIO_APS_PI_CONTROLLER
+	uint16_t target_len = handle->target_len;
+#endif
 
 	SYS_LOG_INF("tws_observer %p audio_track %p\n", tws_observer, audio_track);
 
 	memset(handle, 0, sizeof(aps_monitor_info_t));
+#ifdef CONFIG_AUDIO_APS_PI_CONTROLLER
+	/* target may be set before the track starts, keep it */
+	handle->target_len = target_len;
+#endif
 	handle->audio_track = audio_track;
 	handle->aps_status = APS_STATUS_DEFAULT;
 	handle->aps_min_level = APS_LEVEL_1;
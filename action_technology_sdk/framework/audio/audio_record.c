@@ -18,6 +18,9 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <media_mem.h>
+#ifdef CONFIG_AUDIO_RESAMPLE
+#include <audio_resample.h>
+#endif
 #include <ringbuff_stream.h>
 #include <audio_device.h>
 
@@ -35,9 +38,112 @@
 static uint8_t record_pcm_buff[1024] __aligned(4) __in_section_unique(audio.bss.input_pcm);
 #endif
 
+static void _audio_record_write(struct audio_record_t *handle, uint8_t *buf, int num)
+{
+	int ret = stream_write(handle->audio_stream, buf, num);
+
+	if (ret <= 0) {
+        if(handle->printk_cnt == 0) {
+    		SYS_LOG_WRN("data full ret %d ", ret);
+        }
+
+        handle->printk_cnt++;
+	} else {
+        handle->printk_cnt = 0;
+	}
+}
+
+#ifdef CONFIG_AUDIO_RESAMPLE
+/* dma half buffers queued for the resample work */
+#define AUDIO_RECORD_RES_IN_BLOCKS	4
+
+extern uint32_t get_sample_rate_hz(uint8_t fs_khz);
+
+/*
+ * The filter cost grows with the taps of the ratio, so it runs in the
+ * system work queue, not in the dma irq, which only copies the pcm.
+ */
+static void _audio_record_resample_work(os_work *work)
+{
+	struct audio_record_t *handle = CONTAINER_OF(work, struct audio_record_t, res_work);
+	int num = handle->pcm_buff_size / 2;
+	int16_t *in_buf[2] = { NULL, NULL };
+	int16_t *out_buf[2] = { handle->res_buff, NULL };
+	int out;
+
+	while (handle->res_in_rd != handle->res_in_wr) {
+		in_buf[0] = (int16_t *)&handle->res_in_buff[(handle->res_in_rd % AUDIO_RECORD_RES_IN_BLOCKS) * num];
+		out = audio_resample_process(handle->res_handle, out_buf, in_buf,
+				num / handle->frame_size, handle->res_buff_samples);
+		handle->res_in_rd++;
+
+		_audio_record_write(handle, (uint8_t *)handle->res_buff, out * handle->frame_size);
+	}
+}
+
+static void _audio_record_resample_put(struct audio_record_t *handle, uint8_t *buf, int num)
+{
+	if ((uint8_t)(handle->res_in_wr - handle->res_in_rd) >= AUDIO_RECORD_RES_IN_BLOCKS) {
+		if (handle->printk_cnt == 0) {
+			SYS_LOG_WRN("resample behind");
+		}
+		handle->printk_cnt++;
+		return;
+	}
+
+	memcpy(&handle->res_in_buff[(handle->res_in_wr % AUDIO_RECORD_RES_IN_BLOCKS) * num], buf, num);
+	handle->res_in_wr++;
+
+	os_work_submit(&handle->res_work);
+}
+
+static int _audio_record_resample_open(struct audio_record_t *handle)
+{
+	int in_samples = handle->pcm_buff_size / 2 / handle->frame_size;
+
+	handle->res_handle = audio_resample_open(handle->frame_size / 2, 1,
+			get_sample_rate_hz(handle->sample_rate), get_sample_rate_hz(handle->output_sample_rate));
+	if (!handle->res_handle)
+		return -EINVAL;
+
+	handle->res_buff_samples = audio_resample_get_max_out(handle->res_handle, in_samples);
+	handle->res_buff = mem_malloc(handle->res_buff_samples * handle->frame_size);
+	if (!handle->res_buff)
+		return -ENOMEM;
+
+	handle->res_in_buff = mem_malloc(handle->pcm_buff_size / 2 * AUDIO_RECORD_RES_IN_BLOCKS);
+	if (!handle->res_in_buff)
+		return -ENOMEM;
+
+	os_work_init(&handle->res_work, _audio_record_resample_work);
+	return 0;
+}
+
+static void _audio_record_resample_close(struct audio_record_t *handle)
+{
+	if (handle->res_in_buff) {
+		struct k_work_sync sync;
+
+		/* dma stopped, wait the work out before its buffers go */
+		k_work_cancel_sync(&handle->res_work, &sync);
+		mem_free(handle->res_in_buff);
+		handle->res_in_buff = NULL;
+	}
+
+	if (handle->res_buff) {
+		mem_free(handle->res_buff);
+		handle->res_buff = NULL;
+	}
+
+	if (handle->res_handle) {
+		audio_resample_close(handle->res_handle);
+		handle->res_handle = NULL;
+	}
+}
+#endif
+
 static int _audio_record_request_more_data(void *priv_data, uint32_t reason)
 {
-	int ret = 0;
     struct audio_record_t *handle = (struct audio_record_t *)priv_data;
 	int num = handle->pcm_buff_size / 2;
 	uint8_t *buf = NULL;
@@ -61,16 +167,14 @@ static int _audio_record_request_more_data(void *priv_data, uint32_t reason)
 		handle->first_frame = 0;
 	}
 
-	ret = stream_write(handle->audio_stream, buf, num);
-	if (ret <= 0) {
-        if(handle->printk_cnt == 0) {
-    		SYS_LOG_WRN("data full ret %d ", ret);
-        }
-
-        handle->printk_cnt++;
-	} else {
-        handle->printk_cnt = 0;
+#ifdef CONFIG_AUDIO_RESAMPLE
+	if (handle->res_handle) {
+		_audio_record_resample_put(handle, buf, num);
+		goto exit;
 	}
+#endif
+
+	_audio_record_write(handle, buf, num);
 
 exit:
 	return 0;
@@ -148,6 +252,15 @@ struct audio_record_t *audio_record_create(uint8_t stream_type, int sample_rate_
 		audio_record->frame_size = 4;
 	}
 
+#ifdef CONFIG_AUDIO_RESAMPLE
+	if (sample_rate_output && sample_rate_output != sample_rate_input) {
+		if (_audio_record_resample_open(audio_record)) {
+			SYS_LOG_ERR("resample %d->%d failed", sample_rate_input, sample_rate_output);
+			goto err_exit;
+		}
+	}
+#endif
+
 	audio_record->audio_handle = _audio_record_init(audio_record);
 	if (!audio_record->audio_handle) {
 		goto err_exit;
@@ -214,6 +327,10 @@ struct audio_record_t *audio_record_create(uint8_t stream_type, int sample_rate_
 
 err_exit:
 
+#ifdef CONFIG_AUDIO_RESAMPLE
+	_audio_record_resample_close(audio_record);
+#endif
+
 #ifndef CONFIG_FIXED_DMA_ACCESS_PSRAM
 	if (audio_record->pcm_buff)
 		mem_free(audio_record->pcm_buff);
@@ -237,6 +354,11 @@ int audio_record_destory(struct audio_record_t *handle)
 	if (handle->audio_handle)
 		hal_ain_channel_close(handle->audio_handle);
 
+#ifdef CONFIG_AUDIO_RESAMPLE
+	/* before the stream, the resample work still writes to it */
+	_audio_record_resample_close(handle);
+#endif
+
 	if (handle->audio_stream)
 		stream_destroy(handle->audio_stream);
 
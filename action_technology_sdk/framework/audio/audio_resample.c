@@ -0,0 +1,486 @@
+/*
+ * Copyright (c) 2016 Actions Semi Co., Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief audio resample.
+ *
+ * Streaming resampler of 16 bits pcm. The input is kept in a history buffer
+ * per channel, and each output sample is filtered from the history as soon
+ * as all its taps arrived, so the delay only depends on the filter length.
+ * Integer ratios between 8K, 16K and 48K run a polyphase FIR from the tables
+ * below, with dual 16 bits MAC where the core has DSP instructions. Other
+ * ratios interpolate the coefficient of each tap from an oversampled
+ * prototype, stretched for decimation.
+*/
+
+#include <os_common_api.h>
+#include <mem_manager.h>
+#include <string.h>
+#include <audio_resample.h>
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#include <arch/arm/aarch32/cortex_m/cmsis.h>
+#define RESAMPLE_DUAL_MAC
+#endif
+
+#define SYS_LOG_NO_NEWLINE
+#ifdef SYS_LOG_DOMAIN
+#undef SYS_LOG_DOMAIN
+#endif
+#define SYS_LOG_DOMAIN "resample"
+
+/* taps per phase of the fixed ratio tables */
+#define RESAMPLE_TAPS				16
+/* zero crossings on each side of the prototype */
+#define RESAMPLE_PROTO_NZ			8
+/* prototype entries per input sample */
+#define RESAMPLE_PROTO_PHASES		64
+/* max input to output rate ratio */
+#define RESAMPLE_MAX_DECIM			6
+/* history samples per channel, holds taps of the max decimation */
+#define RESAMPLE_BUF_LEN			256
+
+enum {
+	RESAMPLE_MODE_COPY,
+	RESAMPLE_MODE_FIXED,
+	RESAMPLE_MODE_ARBITRARY,
+};
+
+struct audio_resample {
+	uint8_t channels;
+	uint8_t interleaved;
+	uint8_t mode;
+	uint8_t phases;			/* fixed, output samples per decim input samples */
+	uint8_t decim;
+	uint8_t phase;
+	uint8_t taps;			/* fixed, taps per phase */
+	uint8_t half;			/* arbitrary, taps on each side */
+	const int16_t *coef;
+
+	uint32_t in_rate_hz;
+	uint32_t out_rate_hz;
+	uint64_t step_q32;		/* input samples per output sample */
+	uint32_t frac;			/* arbitrary, output time after pos */
+	uint32_t dstep_q16;		/* arbitrary, prototype entries per input sample */
+	int32_t gain_q15;		/* arbitrary, gain of stretched prototype */
+
+	int16_t pos;			/* fixed, newest tap, arbitrary, tap before output time */
+	int16_t fill;
+	int16_t buf[2][RESAMPLE_BUF_LEN];
+};
+
+/*
+ * Kaiser (beta 7) windowed sinc, cutoff at 0.9 of the lower nyquist, each
+ * phase normalized to unity dc gain and stored in tap order of the history.
+ */
+static const int16_t resample_up2[32] __aligned(4) = {
+	40, -143, 314, -480, 429, 280, -2949, 27006,
+	11524, -4954, 2550, -1211, 477, -136, 20, 1,
+	1, 20, -136, 477, -1211, 2550, -4954, 11523,
+	27007, -2949, 280, 429, -480, 314, -143, 40,
+};
+
+static const int16_t resample_dn2[32] __aligned(4) = {
+	1, 20, 10, -71, -68, 157, 238, -240,
+	-606, 215, 1275, 140, -2477, -1474, 5761, 13503,
+	13503, 5761, -1474, -2477, 140, 1275, 215, -606,
+	-240, 238, 157, -68, -71, 10, 20, 1,
+};
+
+static const int16_t resample_up3[48] __aligned(4) = {
+	46, -167, 396, -690, 882, -591, -1305, 28367,
+	8542, -4267, 2392, -1222, 522, -169, 34, -2,
+	18, -52, 52, 119, -706, 2134, -5523, 20343,
+	20341, -5523, 2134, -706, 119, 52, -52, 18,
+	-2, 34, -169, 522, -1222, 2392, -4267, 8543,
+	28366, -1305, -591, 882, -690, 396, -167, 46,
+};
+
+static const int16_t resample_dn3[48] __aligned(4) = {
+	-1, 6, 15, 11, -17, -56, -56, 17,
+	132, 174, 40, -230, -407, -235, 294, 797,
+	711, -197, -1422, -1841, -435, 2848, 6781, 9456,
+	9454, 6781, 2848, -435, -1841, -1422, -197, 711,
+	797, 294, -235, -407, -230, 40, 174, 132,
+	17, -56, -56, -17, 11, 15, 6, -1,
+};
+
+static const int16_t resample_up6[96] __aligned(4) = {
+	48, -185, 464, -884, 1334, -1532, 712, 29203,
+	5697, -3427, 2118, -1164, 533, -188, 43, -4,
+	40, -143, 314, -480, 429, 280, -2949, 27006,
+	11524, -4954, 2550, -1211, 477, -136, 20, 1,
+	26, -83, 136, -64, -384, 1667, -5054, 22923,
+	17520, -5635, 2435, -955, 273, -24, -24, 11,
+	11, -24, -24, 273, -955, 2435, -5635, 17519,
+	22924, -5054, 1667, -384, -64, 136, -83, 26,
+	1, 20, -136, 477, -1211, 2550, -4954, 11523,
+	27007, -2949, 280, 429, -480, 314, -143, 40,
+	-4, 43, -188, 533, -1164, 2118, -3427, 5696,
+	29204, 712, -1532, 1334, -884, 464, -185, 48,
+};
+
+static const int16_t resample_dn6[96] __aligned(4) = {
+	-1, 0, 2, 4, 7, 8, 7, 3,
+	-4, -14, -24, -31, -31, -23, -4, 23,
+	52, 77, 89, 79, 46, -11, -80, -147,
+	-194, -202, -159, -64, 72, 222, 353, 425,
+	406, 278, 47, -255, -571, -826, -939, -842,
+	-491, 119, 949, 1920, 2920, 3820, 4501, 4867,
+	4869, 4501, 3820, 2920, 1920, 949, 119, -491,
+	-842, -939, -826, -571, -255, 47, 278, 406,
+	425, 353, 222, 72, -64, -159, -202, -194,
+	-147, -80, -11, 46, 79, 89, 77, 52,
+	23, -4, -23, -31, -31, -24, -14, -4,
+	3, 7, 8, 7, 4, 2, 0, -1,
+};
+
+static const int16_t resample_proto[514] __aligned(4) = {
+	29491, 29481, 29451, 29402, 29332, 29243, 29134, 29006,
+	28858, 28692, 28506, 28302, 28079, 27838, 27580, 27304,
+	27010, 26700, 26374, 26032, 25674, 25301, 24913, 24511,
+	24096, 23667, 23226, 22773, 22308, 21832, 21346, 20850,
+	20345, 19831, 19309, 18780, 18244, 17703, 17155, 16603,
+	16047, 15487, 14925, 14360, 13793, 13226, 12658, 12091,
+	11524, 10959, 10397, 9837, 9280, 8727, 8179, 7636,
+	7099, 6567, 6043, 5525, 5016, 4514, 4021, 3538,
+	3064, 2599, 2145, 1702, 1270, 849, 440, 43,
+	-341, -713, -1073, -1419, -1752, -2072, -2378, -2670,
+	-2949, -3214, -3465, -3702, -3925, -4133, -4328, -4509,
+	-4676, -4829, -4969, -5094, -5207, -5306, -5391, -5464,
+	-5524, -5571, -5606, -5628, -5639, -5638, -5626, -5603,
+	-5570, -5525, -5471, -5407, -5334, -5252, -5161, -5062,
+	-4955, -4840, -4719, -4590, -4456, -4315, -4169, -4018,
+	-3862, -3702, -3539, -3371, -3201, -3028, -2852, -2675,
+	-2496, -2316, -2136, -1955, -1773, -1593, -1413, -1234,
+	-1056, -880, -706, -534, -365, -199, -36, 124,
+	280, 432, 581, 725, 864, 999, 1129, 1254,
+	1374, 1488, 1597, 1701, 1799, 1892, 1978, 2059,
+	2134, 2203, 2267, 2324, 2376, 2421, 2461, 2495,
+	2523, 2546, 2562, 2574, 2580, 2580, 2575, 2565,
+	2551, 2531, 2506, 2477, 2443, 2406, 2364, 2318,
+	2268, 2215, 2158, 2098, 2035, 1969, 1900, 1829,
+	1756, 1680, 1603, 1524, 1443, 1362, 1279, 1195,
+	1110, 1025, 940, 854, 768, 683, 598, 513,
+	429, 346, 264, 183, 104, 26, -51, -126,
+	-199, -270, -339, -406, -471, -534, -594, -651,
+	-706, -759, -809, -856, -900, -942, -980, -1016,
+	-1049, -1080, -1107, -1132, -1153, -1172, -1188, -1201,
+	-1212, -1219, -1224, -1227, -1227, -1224, -1219, -1211,
+	-1201, -1189, -1175, -1158, -1140, -1119, -1097, -1073,
+	-1047, -1019, -990, -960, -928, -895, -861, -826,
+	-790, -753, -716, -678, -639, -600, -560, -520,
+	-480, -440, -400, -360, -320, -280, -241, -202,
+	-163, -125, -88, -52, -16, 19, 54, 87,
+	119, 150, 181, 210, 238, 265, 290, 315,
+	338, 360, 381, 400, 418, 435, 450, 464,
+	477, 488, 498, 507, 515, 521, 526, 529,
+	532, 533, 533, 532, 530, 527, 523, 518,
+	512, 504, 496, 488, 478, 467, 456, 444,
+	432, 419, 405, 391, 376, 361, 346, 330,
+	314, 298, 282, 265, 248, 231, 214, 198,
+	181, 164, 147, 131, 115, 98, 83, 67,
+	52, 37, 22, 8, -6, -20, -33, -45,
+	-57, -69, -80, -91, -101, -110, -119, -128,
+	-136, -143, -150, -157, -163, -168, -173, -177,
+	-181, -184, -186, -189, -190, -191, -192, -192,
+	-192, -192, -191, -189, -188, -185, -183, -180,
+	-177, -173, -170, -166, -162, -157, -152, -148,
+	-143, -137, -132, -127, -121, -115, -110, -104,
+	-98, -92, -87, -81, -75, -69, -64, -58,
+	-52, -47, -41, -36, -31, -26, -21, -16,
+	-12, -7, -3, 1, 5, 9, 13, 16,
+	20, 23, 26, 28, 31, 33, 36, 38,
+	39, 41, 43, 44, 45, 46, 47, 48,
+	48, 48, 49, 49, 49, 49, 48, 48,
+	47, 47, 46, 45, 44, 43, 42, 41,
+	40, 39, 38, 36, 35, 34, 32, 31,
+	30, 28, 27, 25, 24, 22, 21, 20,
+	18, 17, 16, 14, 13, 12, 11, 10,
+	8, 7, 6, 5, 4, 4, 3, 2,
+	1, 1, 0, -1, -1, -2, -2, -3,
+	-3, -3, -4, -4, -4, -4, -4, -4,
+	-5, 0,
+};
+
+static const struct {
+	uint8_t phases;
+	uint8_t decim;
+	const int16_t *coef;
+} resample_fixed[] = {
+	{ 2, 1, resample_up2 },
+	{ 3, 1, resample_up3 },
+	{ 6, 1, resample_up6 },
+	{ 1, 2, resample_dn2 },
+	{ 1, 3, resample_dn3 },
+	{ 1, 6, resample_dn6 },
+};
+
+static uint32_t _resample_gcd(uint32_t a, uint32_t b)
+{
+	while (b) {
+		uint32_t t = a % b;
+
+		a = b;
+		b = t;
+	}
+
+	return a;
+}
+
+static inline int16_t _resample_sat16(int32_t v)
+{
+#ifdef RESAMPLE_DUAL_MAC
+	return (int16_t)__SSAT(v, 16);
+#else
+	return (int16_t)((v > INT16_MAX) ? INT16_MAX : ((v < INT16_MIN) ? INT16_MIN : v));
+#endif
+}
+
+/* |sum of coef| < 2, a Q30 sum of taps of 16 bits pcm fits 32 bits */
+static inline int16_t _resample_dot(const int16_t *x, const int16_t *c, int taps)
+{
+	int32_t acc = 1 << 14;
+#ifdef RESAMPLE_DUAL_MAC
+	uint32_t xv, cv;
+
+	for (; taps > 0; taps -= 2) {
+		memcpy(&xv, x, 4);
+		memcpy(&cv, c, 4);
+		acc = __SMLAD(xv, cv, acc);
+		x += 2;
+		c += 2;
+	}
+#else
+	for (; taps > 0; taps--) {
+		acc += *x++ * *c++;
+	}
+#endif
+
+	return _resample_sat16(acc >> 15);
+}
+
+/* prototype at idx_q16 entries from center, linear interpolated */
+static inline int32_t _resample_proto_at(uint32_t idx_q16)
+{
+	const int16_t *p = &resample_proto[idx_q16 >> 16];
+
+	return p[0] + (((p[1] - p[0]) * (int32_t)(idx_q16 & 0xffff)) >> 16);
+}
+
+/* x points to the tap before the output time */
+static int16_t _resample_arbitrary_one(struct audio_resample *res, const int16_t *x)
+{
+	const uint32_t end = (RESAMPLE_PROTO_NZ * RESAMPLE_PROTO_PHASES) << 16;
+	uint32_t frac_q16 = res->frac >> 16;
+	uint32_t idx;
+	int64_t acc = 0;
+	int m;
+
+	idx = (uint32_t)(((uint64_t)frac_q16 * res->dstep_q16) >> 16);
+	for (m = 0; idx < end; m++, idx += res->dstep_q16) {
+		acc += _resample_proto_at(idx) * x[-m];
+	}
+
+	idx = (uint32_t)(((uint64_t)(0x10000 - frac_q16) * res->dstep_q16) >> 16);
+	for (m = 1; idx < end; m++, idx += res->dstep_q16) {
+		acc += _resample_proto_at(idx) * x[m];
+	}
+
+	return _resample_sat16((int32_t)((acc * res->gain_q15 + (1 << 29)) >> 30));
+}
+
+static void _resample_set_arbitrary(struct audio_resample *res)
+{
+	if (res->out_rate_hz < res->in_rate_hz) {
+		res->dstep_q16 = (uint32_t)(((uint64_t)res->out_rate_hz * RESAMPLE_PROTO_PHASES << 16) / res->in_rate_hz);
+		res->gain_q15 = (int32_t)(((uint64_t)res->out_rate_hz << 15) / res->in_rate_hz);
+		res->half = (RESAMPLE_PROTO_NZ * res->in_rate_hz + res->out_rate_hz - 1) / res->out_rate_hz;
+	} else {
+		res->dstep_q16 = RESAMPLE_PROTO_PHASES << 16;
+		res->gain_q15 = 1 << 15;
+		res->half = RESAMPLE_PROTO_NZ;
+	}
+}
+
+void *audio_resample_open(uint8_t channels, uint8_t interleaved,
+		uint32_t in_rate_hz, uint32_t out_rate_hz)
+{
+	struct audio_resample *res;
+	uint32_t gcd;
+	int i;
+
+	if (channels < 1 || channels > 2 || !in_rate_hz || !out_rate_hz
+		|| in_rate_hz > out_rate_hz * RESAMPLE_MAX_DECIM) {
+		SYS_LOG_ERR("unsupported %d ch %d->%d", channels, in_rate_hz, out_rate_hz);
+		return NULL;
+	}
+
+	res = mem_malloc(sizeof(*res));
+	if (!res)
+		return NULL;
+
+	memset(res, 0, sizeof(*res));
+	res->channels = channels;
+	res->interleaved = (channels > 1) ? interleaved : 0;
+	res->in_rate_hz = in_rate_hz;
+	res->out_rate_hz = out_rate_hz;
+	res->step_q32 = ((uint64_t)in_rate_hz << 32) / out_rate_hz;
+
+	if (in_rate_hz == out_rate_hz) {
+		res->mode = RESAMPLE_MODE_COPY;
+		return res;
+	}
+
+	gcd = _resample_gcd(in_rate_hz, out_rate_hz);
+
+	for (i = 0; i < ARRAY_SIZE(resample_fixed); i++) {
+		if (resample_fixed[i].phases == out_rate_hz / gcd
+			&& resample_fixed[i].decim == in_rate_hz / gcd) {
+			res->mode = RESAMPLE_MODE_FIXED;
+			res->phases = resample_fixed[i].phases;
+			res->decim = resample_fixed[i].decim;
+			res->coef = resample_fixed[i].coef;
+			res->taps = RESAMPLE_TAPS * res->decim;
+			res->pos = res->taps - 1;
+			res->fill = res->taps - 1;
+			return res;
+		}
+	}
+
+	res->mode = RESAMPLE_MODE_ARBITRARY;
+	_resample_set_arbitrary(res);
+	res->pos = res->half - 1;
+	res->fill = res->half;
+
+	return res;
+}
+
+int audio_resample_get_max_out(void *handle, int in_samples)
+{
+	struct audio_resample *res = handle;
+
+	if (res->mode == RESAMPLE_MODE_COPY)
+		return in_samples;
+
+	return (int)((((uint64_t)in_samples << 32) + res->step_q32 - 1) / res->step_q32) + 2;
+}
+
+static int _resample_run_fixed(struct audio_resample *res, int16_t *out[2], int out_cnt, int max_out)
+{
+	const int16_t *coef;
+	int ch, o;
+
+	while (out_cnt < max_out && res->pos < res->fill) {
+		coef = res->coef + res->phase * res->taps;
+
+		for (ch = 0; ch < res->channels; ch++) {
+			o = res->interleaved ? (out_cnt * res->channels + ch) : out_cnt;
+			out[res->interleaved ? 0 : ch][o] =
+					_resample_dot(&res->buf[ch][res->pos - res->taps + 1], coef, res->taps);
+		}
+
+		out_cnt++;
+		res->phase += res->decim;
+		res->pos += res->phase / res->phases;
+		res->phase %= res->phases;
+	}
+
+	return out_cnt;
+}
+
+static int _resample_run_arbitrary(struct audio_resample *res, int16_t *out[2], int out_cnt, int max_out)
+{
+	uint64_t t;
+	int ch, o;
+
+	while (out_cnt < max_out && res->pos + res->half < res->fill) {
+		for (ch = 0; ch < res->channels; ch++) {
+			o = res->interleaved ? (out_cnt * res->channels + ch) : out_cnt;
+			out[res->interleaved ? 0 : ch][o] =
+					_resample_arbitrary_one(res, &res->buf[ch][res->pos]);
+		}
+
+		out_cnt++;
+		t = (uint64_t)res->frac + res->step_q32;
+		res->pos += (int16_t)(t >> 32);
+		res->frac = (uint32_t)t;
+	}
+
+	return out_cnt;
+}
+
+/* drop the history no longer reached by the taps of next output */
+static void _resample_shift(struct audio_resample *res)
+{
+	int keep = res->pos - ((res->mode == RESAMPLE_MODE_FIXED) ? (res->taps - 1) : (res->half - 1));
+	int ch;
+
+	if (keep <= 0)
+		return;
+
+	for (ch = 0; ch < res->channels; ch++) {
+		memmove(res->buf[ch], &res->buf[ch][keep], (res->fill - keep) * sizeof(int16_t));
+	}
+
+	res->pos -= keep;
+	res->fill -= keep;
+}
+
+int audio_resample_process(void *handle, int16_t *output_buf[2],
+		int16_t *input_buf[2], int in_samples, int max_out)
+{
+	struct audio_resample *res = handle;
+	int stride = res->interleaved ? res->channels : 1;
+	int out_cnt = 0, done = 0;
+	int ch, i, n;
+
+	if (res->mode == RESAMPLE_MODE_COPY) {
+		n = MIN(in_samples, max_out);
+		if (res->interleaved) {
+			memcpy(output_buf[0], input_buf[0], n * res->channels * sizeof(int16_t));
+		} else {
+			for (ch = 0; ch < res->channels; ch++) {
+				memcpy(output_buf[ch], input_buf[ch], n * sizeof(int16_t));
+			}
+		}
+
+		return n;
+	}
+
+	do {
+		n = MIN(in_samples - done, RESAMPLE_BUF_LEN - res->fill);
+
+		for (ch = 0; ch < res->channels; ch++) {
+			const int16_t *src = res->interleaved ? (input_buf[0] + ch) : input_buf[ch];
+			int16_t *dst = &res->buf[ch][res->fill];
+
+			src += done * stride;
+			for (i = 0; i < n; i++) {
+				dst[i] = src[i * stride];
+			}
+		}
+
+		done += n;
+		res->fill += n;
+
+		if (res->mode == RESAMPLE_MODE_FIXED) {
+			out_cnt = _resample_run_fixed(res, output_buf, out_cnt, max_out);
+		} else {
+			out_cnt = _resample_run_arbitrary(res, output_buf, out_cnt, max_out);
+		}
+
+		_resample_shift(res);
+	} while (done < in_samples && res->fill < RESAMPLE_BUF_LEN);
+
+	return out_cnt;
+}
+
+void audio_resample_close(void *handle)
+{
+	mem_free(handle);
+}
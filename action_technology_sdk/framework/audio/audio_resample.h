@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2016 Actions Semi Co., Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief audio resample.
+*/
+#ifndef __AUDIO_RESAMPLE_H__
+#define __AUDIO_RESAMPLE_H__
+
+#include <stdint.h>
+
+/**
+ * @defgroup audio_resample_apis Audio Resample APIs
+ * @{
+ */
+
+/**
+ * @brief open a streaming resampler
+ *
+ * Integer ratios between 8K, 16K and 48K use precomputed polyphase tables,
+ * other ratios (44.1K family) are interpolated from a single prototype. The
+ * delay is fixed by the filter length, whatever the block size of process.
+ *
+ * @param channels channels, 1 or 2
+ * @param interleaved pcm of two channels is interleaved in in[0] and out[0]
+ * @param in_rate_hz input sample rate in Hz
+ * @param out_rate_hz output sample rate in Hz
+ *
+ * @return handle of resampler, NULL if ratio not supported or no memory
+ */
+void *audio_resample_open(uint8_t channels, uint8_t interleaved,
+		uint32_t in_rate_hz, uint32_t out_rate_hz);
+
+/**
+ * @brief get max output samples of one process call
+ *
+ * @param handle handle of resampler
+ * @param in_samples input samples per channel of the call
+ *
+ * @return output samples per channel the output buffer must hold
+ */
+int audio_resample_get_max_out(void *handle, int in_samples);
+
+/**
+ * @brief resample 16 bits pcm
+ *
+ * @param handle handle of resampler
+ * @param output_buf output buffer of each channel, only output_buf[0] if interleaved
+ * @param input_buf input buffer of each channel, only input_buf[0] if interleaved
+ * @param in_samples input samples per channel
+ * @param max_out output samples per channel output_buf can hold
+ *
+ * @return output samples per channel
+ */
+int audio_resample_process(void *handle, int16_t *output_buf[2],
+		int16_t *input_buf[2], int in_samples, int max_out);
+
+/**
+ * @brief close resampler
+ *
+ * @param handle handle of resampler
+ */
+void audio_resample_close(void *handle);
+
+/**
+ * @} end defgroup audio_resample_apis
+ */
+
+#endif /* __AUDIO_RESAMPLE_H__ */
@@ -150,6 +150,12 @@ struct audio_track_t {
 
     uint64_t total_samples_filled;
     int32_t sample_fix;
+
+#ifdef CONFIG_AUDIO_TRACK_ZERO_COPY
+	/* ring buffer region in flight to dma */
+	uint32_t zc_head;
+	uint16_t zc_pending;
+#endif
 };
 
 #define AUDIO_ADC_NUM   (4)
@@ -190,6 +196,17 @@ struct audio_record_t {
 	/** audio hal handle*/
 	void *audio_handle;
 	io_stream_t audio_stream;
+
+#ifdef CONFIG_AUDIO_RESAMPLE
+	/* resample from sample_rate to output_sample_rate, out of dma irq */
+	void *res_handle;
+	int16_t *res_buff;
+	uint16_t res_buff_samples;
+	uint8_t res_in_wr;
+	uint8_t res_in_rd;
+	uint8_t *res_in_buff;
+	os_work res_work;
+#endif
 };
 
 struct audio_system_t {
@@ -271,9 +288,38 @@ typedef struct {
     uint16_t first_pkt_num;
 #endif
 
+#ifdef CONFIG_AUDIO_APS_PI_CONTROLLER
+	uint8_t pi_started:1;
+	uint16_t target_len;
+	const int16_t *level_ppm;
+	int32_t fill_q8;
+	int32_t fill_var_q8;
+	int32_t integ_q8;
+	int32_t drift_ppm;
+	int32_t command_ppm;
+	int32_t dither_ppm;
+	uint32_t last_time;
+#endif
+
 	struct audio_track_t *audio_track;
 	void *tws_observer;
 }aps_monitor_info_t;
+
+typedef struct {
+	int16_t drift_ppm;		/* estimated source clock offset from sink */
+	int16_t command_ppm;	/* playback rate correction commanded */
+	uint16_t fill_len;		/* filtered stream length */
+	uint16_t fill_var;		/* variance of stream length */
+	uint16_t target_len;	/* target stream length */
+}aps_monitor_stat_t;
+
+typedef struct {
+	int32_t offset_us;		/* master ahead of slave */
+	int16_t drift_ppm;		/* master rate against uncorrected slave */
+	int16_t local_ppm;		/* slave output rate against bt clock */
+	int16_t command_ppm;	/* slave rate correction against master */
+	uint8_t points;			/* sync points in the fit */
+}audio_tws_sync_stat_t;
 /**
  * INTERNAL_HIDDEN @endcond
  */
@@ -414,6 +460,49 @@ void audio_aps_monitor_tws_deinit(void *tws_observer);
 
 aps_monitor_info_t *audio_aps_monitor_get_instance(void);
 
+/**
+ * @brief set target stream length of aps PI controller
+ *
+ * May be called before audio_aps_monitor_init, the target is kept
+ * across init until set again.
+ *
+ * @param target_len target stream length, 0 for middle of water marks
+ *
+ * @return 0 excute successed , others failed
+ */
+int audio_aps_monitor_set_target(uint16_t target_len);
+
+/**
+ * @brief get aps PI controller statistics
+ *
+ * @param stat pointer to store the statistics
+ *
+ * @return 0 excute successed , others failed
+ */
+int audio_aps_monitor_get_stat(aps_monitor_stat_t *stat);
+
+#ifdef CONFIG_AUDIO_APS_PI_CONTROLLER
+int32_t audio_aps_monitor_level_to_ppm(aps_monitor_info_t *handle, uint8_t level);
+
+uint8_t audio_aps_monitor_ppm_to_level(aps_monitor_info_t *handle, int32_t ppm);
+#endif
+
+/**
+ * @brief get tws slave sync statistics
+ *
+ * @param stat pointer to store the statistics
+ *
+ * @return 0 excute successed , others failed
+ */
+#ifdef CONFIG_AUDIO_TWS_SYNC_ENGINE
+int audio_tws_sync_get_stat(audio_tws_sync_stat_t *stat);
+#else
+static inline int audio_tws_sync_get_stat(audio_tws_sync_stat_t *stat)
+{
+	return -ENOTSUP;
+}
+#endif
+
 struct audio_track_t * audio_system_get_track(void);
 
 int audio_system_mutex_lock(void);
@@ -22,6 +22,12 @@
 #include <assert.h>
 #include <ringbuff_stream.h>
 #include <arithmetic.h>
+#ifdef CONFIG_AUDIO_TRACK_ZERO_COPY
+#include <memory/mem_cache.h>
+#endif
+#ifdef CONFIG_AUDIO_RESAMPLE
+#include <audio_resample.h>
+#endif
 
 #define SYS_LOG_NO_NEWLINE
 #ifdef SYS_LOG_DOMAIN
@@ -60,6 +66,30 @@ extern void *media_mix_open(uint8_t sample_rate, uint8_t channels, uint8_t is_in
 extern void media_mix_close(void *handle);
 extern int media_mix_process(void *handle, void **inout_buf, void *mix_buf,
 			     int samples);
+
+#ifdef CONFIG_AUDIO_RESAMPLE
+/* mix stream read per resample, ms */
+#define AUDIO_TRACK_RES_FRAME_MS	10
+
+static void *_audio_track_resample_open(uint8_t channels, uint8_t samplerate_in,
+		uint8_t samplerate_out, int *samples_in, int *samples_out, uint8_t stream_type)
+{
+	void *res_handle = audio_resample_open(channels, 0,
+			get_sample_rate_hz(samplerate_in), get_sample_rate_hz(samplerate_out));
+
+	if (res_handle) {
+		*samples_in = get_sample_rate_hz(samplerate_in) * AUDIO_TRACK_RES_FRAME_MS / 1000;
+		*samples_out = audio_resample_get_max_out(res_handle, *samples_in);
+	}
+
+	return res_handle;
+}
+
+#define _audio_track_resample_close audio_resample_close
+#else
+#define _audio_track_resample_open media_resample_open
+#define _audio_track_resample_close media_resample_close
+#endif
 #endif /* CONFIG_MEDIA_EFFECT */
 
 #ifdef CONFIG_MEDIA_EFFECT
@@ -147,7 +177,13 @@ static int _audio_track_data_mix(struct audio_track_t *handle, s16_t *src_buff,
 		}
 
 		if (handle->res_handle) {
-#ifdef CONFIG_RESAMPLE
+#if defined(CONFIG_AUDIO_RESAMPLE)
+			/* streaming, a short read needs no padding */
+			handle->res_out_samples = audio_resample_process(handle->res_handle,
+					handle->res_out_buf, (int16_t **)mix_pcm.pcm, ret,
+					audio_resample_get_max_out(handle->res_handle, handle->res_in_samples));
+			handle->res_remain_samples = handle->res_out_samples;
+#elif defined(CONFIG_RESAMPLE)
 			uint8_t res_channels = MIN(handle->mix_channels, handle->channels);
 
 			if (ret < handle->res_in_samples) {
@@ -171,6 +207,80 @@ static int _audio_track_data_mix(struct audio_track_t *handle, s16_t *src_buff,
 }
 #endif /* CONFIG_MEDIA_EFFECT */
 
+#ifdef CONFIG_AUDIO_TRACK_ZERO_COPY
+/*
+ * claim len bytes of pcm in place, fails if the region wraps or is unaligned
+ * for dma, or if the cpu has to write the pcm (muted or fading out)
+ */
+static bool _audio_track_zero_copy_claim(struct audio_track_t *handle, uint8_t **buf, int len)
+{
+	struct acts_ringbuf *ringbuf = stream_get_ringbuffer(handle->audio_stream);
+	void *data = NULL;
+	int num;
+
+	if (!ringbuf || len <= 0 || handle->muted)
+		return false;
+
+#ifdef CONFIG_MUSIC_DAE_FADE
+	if (handle->fade_handle && (handle->fade_mode == FADE_MODE_OUT))
+		return false;
+#endif
+
+	num = stream_read_claim(handle->audio_stream, &data, len);
+	if (num <= 0)
+		return false;
+
+	if (num != len || ((uint32_t)data & 0x3)) {
+		stream_read_commit(handle->audio_stream, 0);
+		return false;
+	}
+
+	handle->zc_head = ringbuf->head;
+	handle->zc_pending = len;
+	*buf = data;
+	return true;
+}
+
+/* release the region claimed for the previous dma transfer */
+static void _audio_track_zero_copy_release(struct audio_track_t *handle)
+{
+	struct acts_ringbuf *ringbuf;
+
+	if (!handle->zc_pending)
+		return;
+
+	ringbuf = stream_get_ringbuffer(handle->audio_stream);
+
+	/* stream flushed meanwhile, region already gone, only drop the claim */
+	if (ringbuf && (ringbuf->head == handle->zc_head)) {
+		stream_read_commit(handle->audio_stream, handle->zc_pending);
+	} else {
+		stream_read_commit(handle->audio_stream, 0);
+	}
+
+	handle->zc_pending = 0;
+}
+#endif /* CONFIG_AUDIO_TRACK_ZERO_COPY */
+
+static void _audio_track_drop_data(struct audio_track_t *handle, uint8_t *buf, int len)
+{
+#ifdef CONFIG_AUDIO_TRACK_ZERO_COPY
+	void *data;
+	int num;
+
+	/* dropped in place, in two parts if the region wraps */
+	while ((len > 0) && ((num = stream_read_claim(handle->audio_stream, &data, len)) > 0)) {
+		stream_read_commit(handle->audio_stream, num);
+		len -= num;
+	}
+
+	if (len <= 0)
+		return;
+#endif
+
+	stream_read(handle->audio_stream, buf, len);
+}
+
 static int _audio_track_request_more_data(void *handle, uint32_t reason)
 {
 	static uint8_t printk_cnt = 0;
@@ -179,6 +289,7 @@ static int _audio_track_request_more_data(void *handle, uint32_t reason)
 	int stream_length = stream_get_length(audio_track->audio_stream);
 	int ret = 0;
 	bool reload_mode = ((audio_track->channel_mode & AUDIO_DMA_RELOAD_MODE) == AUDIO_DMA_RELOAD_MODE);
+	bool zero_copy = false;
 	uint8_t *buf = NULL;
 
     if(!audio_track->stared) {
@@ -192,6 +303,11 @@ static int _audio_track_request_more_data(void *handle, uint32_t reason)
 			buf = audio_track->pcm_frame_buff + read_len;
 		}
 	} else {
+#ifdef CONFIG_AUDIO_TRACK_ZERO_COPY
+		/* pcm buffer asking for more means the previous transfer is done */
+		_audio_track_zero_copy_release(audio_track);
+		stream_length = stream_get_length(audio_track->audio_stream);
+#endif
 		buf = audio_track->pcm_frame_buff;
 		if (stream_length > audio_track->pcm_frame_size) {
 			read_len = audio_track->pcm_frame_size;
@@ -221,7 +337,7 @@ static int _audio_track_request_more_data(void *handle, uint32_t reason)
 			read_len = -audio_track->compensate_samples;
 		}
 		if (stream_get_length(audio_track->audio_stream) >= read_len * 2) {
-			stream_read(audio_track->audio_stream, buf, read_len);
+			_audio_track_drop_data(audio_track, buf, read_len);
 			audio_track->fill_cnt -= read_len;
 			audio_track->compensate_samples += read_len;
 		}
@@ -247,7 +363,17 @@ static int _audio_track_request_more_data(void *handle, uint32_t reason)
 	    printk_cnt = 0;
 	}
 
+#ifdef CONFIG_AUDIO_TRACK_ZERO_COPY
+	/* hand the ring buffer region itself to dma, it is released on next request */
+	if (!reload_mode && _audio_track_zero_copy_claim(audio_track, &buf, read_len)) {
+		zero_copy = true;
+		ret = read_len;
+	} else {
+		ret = stream_read(audio_track->audio_stream, buf, read_len);
+	}
+#else
 	ret = stream_read(audio_track->audio_stream, buf, read_len);
+#endif
 	if (ret != read_len) {
 		if (!printk_cnt++) {
 			printk("F\n");
@@ -282,6 +408,13 @@ exit:
 #endif
 
 	if (!reload_mode && read_len > 0) {
+#ifdef CONFIG_AUDIO_TRACK_ZERO_COPY
+		/* dma reads the claimed region from memory, after the last cpu write */
+		if (zero_copy) {
+			mem_dcache_clean(buf, read_len);
+			mem_dcache_sync();
+		}
+#endif
 		hal_aout_channel_write_data(audio_track->audio_handle, buf, read_len);
 	}
 
@@ -633,6 +766,10 @@ int audio_track_start(struct audio_track_t *handle)
 
 int audio_track_stop(struct audio_track_t *handle)
 {
+#ifdef CONFIG_AUDIO_TRACK_ZERO_COPY
+	uint32_t flags;
+#endif
+
 	assert(handle);
 
 	SYS_LOG_INF("stop %p begin ", handle);
@@ -641,6 +778,12 @@ int audio_track_stop(struct audio_track_t *handle)
 	if (handle->audio_handle)
 		hal_aout_channel_stop(handle->audio_handle);
 
+#ifdef CONFIG_AUDIO_TRACK_ZERO_COPY
+	flags = irq_lock();
+	_audio_track_zero_copy_release(handle);
+	irq_unlock(flags);
+#endif
+
 	SYS_LOG_INF("stop %p ok ", handle);
 	return 0;
 }
@@ -1009,7 +1152,7 @@ int audio_track_set_mix_stream(struct audio_track_t *handle, io_stream_t mix_str
 		if (sample_rate != handle->sample_rate) {
 			int frame_size;
 
-			handle->res_handle = media_resample_open(
+			handle->res_handle = _audio_track_resample_open(
 					res_channels, sample_rate, handle->sample_rate,
 					&handle->res_in_samples, &handle->res_out_samples, stream_type);
 			if (!handle->res_handle) {
@@ -1022,7 +1165,7 @@ int audio_track_set_mix_stream(struct audio_track_t *handle, io_stream_t mix_str
 
 			if (frame_buf_size / 2 < frame_size) {
 				SYS_LOG_ERR("frame mem not enough");
-				media_resample_close(handle->res_handle);
+				_audio_track_resample_close(handle->res_handle);
 				handle->res_handle = NULL;
 				res = -ENOMEM;
 				goto exit;
@@ -1060,7 +1203,7 @@ int audio_track_set_mix_stream(struct audio_track_t *handle, io_stream_t mix_str
 
 	if (!handle->mix_stream) {
 		if (handle->res_handle) {
-			media_resample_close(handle->res_handle);
+			_audio_track_resample_close(handle->res_handle);
 			handle->res_handle = NULL;
 		}
 
@@ -23,6 +23,14 @@
 #ifdef CONFIG_TWS
 #include <btservice_api.h>
 #endif
+#ifdef CONFIG_AUDIO_TWS_SYNC_ENGINE
+#include "audio_tws_sync.h"
+
+/* bt clock counts 312.5us */
+#define TWS_BT_CLOCK_TO_US(a)		((uint32_t)((uint64_t)(a) * 3125 / 10))
+/* interval to add slave sample counter sync point, us */
+#define TWS_SYNC_LOCAL_INTERVAL		200000
+#endif
 
 #define SYS_LOG_NO_NEWLINE
 #ifdef SYS_LOG_DOMAIN
@@ -120,6 +128,9 @@ void audio_aps_monitor_tws_init(void *tws_observer)
 		handle->tws_observer = tws_observer;
 		handle->role = observer->get_role();
 		hal_aout_channel_enable_sample_cnt(handle->audio_track->audio_handle, true);
+#ifdef CONFIG_AUDIO_TWS_SYNC_ENGINE
+		audio_tws_sync_reset(handle->audio_track->output_sample_rate_hz);
+#endif
 	}
 	audio_aps_monitor_set_aps(handle->audio_track->audio_handle, APS_OPR_FAST_SET, handle->aps_default_level);
 }
@@ -256,11 +267,40 @@ void audio_aps_monitor_slave(aps_monitor_info_t *handle, int stream_length, uint
 	int diff_samples = 0;
 	int local_compensate_samples;
 	int remote_compensate_samples;
+#ifdef CONFIG_AUDIO_TWS_SYNC_ENGINE
+	static uint32_t local_bt_us;
+	uint32_t bt_ticks, bt_us;
+	int32_t applied_ppm, ppm;
+#endif
 
 	audio_track = handle->audio_track;
 
 	tws_observer->get_samples_diff(&sample_diff, &master_aps_level, &bt_clock);
 
+#ifdef CONFIG_AUDIO_TWS_SYNC_ENGINE
+	bt_ticks = btif_tws_get_bt_clock();
+	bt_us = TWS_BT_CLOCK_TO_US(bt_ticks);
+
+	if ((bt_us - local_bt_us) >= TWS_SYNC_LOCAL_INTERVAL) {
+		local_bt_us = bt_us;
+		audio_tws_sync_add_local(bt_us, hal_aout_channel_get_sample_cnt(audio_track->audio_handle));
+	}
+
+	/* bt_clock is the low 16 bits of the bt clock the difference was measured at */
+	if (pre_bt_clock != bt_clock) {
+		audio_tws_sync_add_diff(bt_us - TWS_BT_CLOCK_TO_US((uint16_t)(bt_ticks - bt_clock)), sample_diff);
+	}
+
+	applied_ppm = audio_aps_monitor_level_to_ppm(handle, slave_aps_level)
+			- audio_aps_monitor_level_to_ppm(handle, master_aps_level);
+
+	if (!audio_tws_sync_get_correction(bt_us, applied_ppm, &ppm)) {
+		req_aps = audio_aps_monitor_ppm_to_level(handle,
+				audio_aps_monitor_level_to_ppm(handle, master_aps_level) + ppm);
+		req_aps = MAX(MIN(req_aps, aps_max_level), aps_min_level);
+		pre_bt_clock = bt_clock;
+	} else
+#endif
 	if ((pre_bt_clock != bt_clock) || (sample_diff > 20) || (sample_diff < -20)) {
 		if (sample_diff < -15) {
 			req_aps = master_aps_level - 3;
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2016 Actions Semi Co., Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief audio tws sync engine.
+ *
+ * Keeps a linear map from bt clock to the slave output sample counter and to
+ * the master minus slave sample difference, least squares fitted over the
+ * recent sync points. The difference is mapped open loop, with the samples
+ * the slave rate correction already made up added back, so its slope is the
+ * master drift against the uncorrected slave. The fit gives the inter-ear
+ * offset with sub-sample resolution, which is removed by a small rate
+ * correction on top of the drift instead of inserting or dropping samples.
+*/
+
+#include <os_common_api.h>
+#include <audio_system.h>
+#include <string.h>
+#include "audio_tws_sync.h"
+
+#define SYS_LOG_NO_NEWLINE
+#ifdef SYS_LOG_DOMAIN
+#undef SYS_LOG_DOMAIN
+#endif
+#define SYS_LOG_DOMAIN "tws_sync"
+
+/* min sync points before the fit is used */
+#define AUDIO_TWS_SYNC_MIN_POINTS		4
+/* time to remove the offset in, ms */
+#define AUDIO_TWS_SYNC_CORR_TIME		2000
+/* max rate correction for the offset, ppm */
+#define AUDIO_TWS_SYNC_MAX_CORR_PPM		300
+/* difference away from the fit handled as a step, restart the fit */
+#define AUDIO_TWS_SYNC_STEP_SAMPLES		8
+/* sync point older than the previous or this far after it restarts the fit */
+#define AUDIO_TWS_SYNC_MAX_GAP_US		10000000
+
+struct audio_tws_sync {
+	struct audio_tws_clkmap local;
+	struct audio_tws_clkmap diff;
+	uint32_t sample_rate_hz;
+	uint32_t last_us;
+	int32_t command_ppm;
+	/* samples made up by the applied correction, 1/256 sample */
+	int32_t made_up_q8;
+	int64_t made_up_rem;
+};
+
+static struct audio_tws_sync tws_sync;
+
+/* drop all points, next point is stored at index 0 */
+static void _clkmap_restart(struct audio_tws_clkmap *map)
+{
+	map->count = 0;
+	map->head = AUDIO_TWS_SYNC_POINTS - 1;
+}
+
+void audio_tws_clkmap_reset(struct audio_tws_clkmap *map, uint32_t rate)
+{
+	memset(map, 0, sizeof(*map));
+	map->rate = rate;
+	_clkmap_restart(map);
+}
+
+/* residual of point i against the newest point and the nominal rate, 1/256 sample */
+static int32_t _clkmap_residual_q8(struct audio_tws_clkmap *map, int i, int32_t *dx)
+{
+	*dx = (int32_t)(map->time_us[i] - map->ref_time);
+
+	return (int32_t)(map->value[i] - map->ref_value) * 256
+		+ (map->frac_q8[i] - map->ref_frac_q8)
+		- (int32_t)((int64_t)map->rate * *dx * 256 / 1000000);
+}
+
+static void _clkmap_fit(struct audio_tws_clkmap *map)
+{
+	int64_t sum_dx = 0, sum_dy = 0, num = 0, den = 0;
+	int32_t dx, dy;
+	int i;
+
+	map->ref_time = map->time_us[map->head];
+	map->ref_value = map->value[map->head];
+	map->ref_frac_q8 = map->frac_q8[map->head];
+
+	for (i = 0; i < map->count; i++) {
+		dy = _clkmap_residual_q8(map, i, &dx);
+		sum_dx += dx;
+		sum_dy += dy;
+	}
+
+	map->mean_dx = (int32_t)(sum_dx / map->count);
+	map->mean_q8 = (int32_t)(sum_dy / map->count);
+
+	/*
+	 * centered sums, only the variation around the means is left, dx in ms
+	 * so the sums of points seconds apart stay far from overflow
+	 */
+	for (i = 0; i < map->count; i++) {
+		dy = _clkmap_residual_q8(map, i, &dx) - map->mean_q8;
+		dx = (dx - map->mean_dx) / 1000;
+		num += (int64_t)dx * dy;
+		den += (int64_t)dx * dx;
+	}
+
+	map->slope_q8 = den ? (int32_t)(num * 1000 / den) : 0;
+}
+
+void audio_tws_clkmap_add(struct audio_tws_clkmap *map, uint32_t time_us, int32_t value, uint8_t frac_q8)
+{
+	if (map->count) {
+		uint32_t gap = time_us - map->time_us[map->head];
+
+		if (gap == 0 || gap > AUDIO_TWS_SYNC_MAX_GAP_US) {
+			_clkmap_restart(map);
+		}
+	}
+
+	/* points fill index 0 up, so the first count entries are valid */
+	map->head = (map->head + 1) % AUDIO_TWS_SYNC_POINTS;
+	map->time_us[map->head] = time_us;
+	map->value[map->head] = value;
+	map->frac_q8[map->head] = frac_q8;
+	if (map->count < AUDIO_TWS_SYNC_POINTS) {
+		map->count++;
+	}
+
+	_clkmap_fit(map);
+}
+
+int64_t audio_tws_clkmap_eval_q8(struct audio_tws_clkmap *map, uint32_t time_us)
+{
+	int32_t dx = (int32_t)(time_us - map->ref_time);
+
+	return (int64_t)map->ref_value * 256 + map->ref_frac_q8
+		+ (int64_t)map->rate * dx * 256 / 1000000
+		+ map->mean_q8
+		+ (int64_t)map->slope_q8 * (dx - map->mean_dx) / 1000000;
+}
+
+void audio_tws_sync_reset(uint32_t sample_rate_hz)
+{
+	unsigned int key = irq_lock();
+
+	memset(&tws_sync, 0, sizeof(tws_sync));
+	audio_tws_clkmap_reset(&tws_sync.local, sample_rate_hz);
+	audio_tws_clkmap_reset(&tws_sync.diff, 0);
+	tws_sync.sample_rate_hz = sample_rate_hz;
+
+	irq_unlock(key);
+}
+
+/* offset of master from slave at bt_us, 1/256 sample */
+static int64_t _tws_sync_offset_q8(uint32_t bt_us)
+{
+	return audio_tws_clkmap_eval_q8(&tws_sync.diff, bt_us) - tws_sync.made_up_q8;
+}
+
+void audio_tws_sync_add_local(uint32_t bt_us, uint32_t samples)
+{
+	unsigned int key = irq_lock();
+
+	audio_tws_clkmap_add(&tws_sync.local, bt_us, (int32_t)samples, 0);
+
+	irq_unlock(key);
+}
+
+void audio_tws_sync_add_diff(uint32_t bt_us, int32_t diff_samples)
+{
+	struct audio_tws_clkmap *map = &tws_sync.diff;
+	unsigned int key = irq_lock();
+	int32_t open_loop_q8;
+
+	if (map->count >= AUDIO_TWS_SYNC_MIN_POINTS) {
+		int64_t err_q8 = (int64_t)diff_samples * 256 - _tws_sync_offset_q8(bt_us);
+
+		if (err_q8 > AUDIO_TWS_SYNC_STEP_SAMPLES * 256 || err_q8 < -AUDIO_TWS_SYNC_STEP_SAMPLES * 256) {
+			SYS_LOG_INF("diff step %d, refit\n", (int32_t)(err_q8 / 256));
+			_clkmap_restart(map);
+		}
+	}
+
+	/* whole samples and fraction of the difference plus the made up samples */
+	open_loop_q8 = diff_samples * 256 + tws_sync.made_up_q8;
+	audio_tws_clkmap_add(map, bt_us, open_loop_q8 >> 8, open_loop_q8 & 0xff);
+
+	irq_unlock(key);
+}
+
+int audio_tws_sync_get_correction(uint32_t bt_us, int32_t applied_ppm, int32_t *ppm)
+{
+	struct audio_tws_clkmap *map = &tws_sync.diff;
+	int64_t offset_q8, corr;
+	unsigned int key;
+
+	if (!tws_sync.sample_rate_hz) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+
+	/* integrate the correction in effect since the last call */
+	if (tws_sync.last_us) {
+		tws_sync.made_up_rem += (int64_t)applied_ppm * (int32_t)(bt_us - tws_sync.last_us)
+				* tws_sync.sample_rate_hz * 256 / 1000000;
+		tws_sync.made_up_q8 += (int32_t)(tws_sync.made_up_rem / 1000000);
+		tws_sync.made_up_rem %= 1000000;
+	}
+	tws_sync.last_us = bt_us;
+
+	if (map->count < AUDIO_TWS_SYNC_MIN_POINTS) {
+		irq_unlock(key);
+		return -EAGAIN;
+	}
+
+	offset_q8 = _tws_sync_offset_q8(bt_us);
+
+	/* offset samples / rate / correction time, in ppm */
+	corr = offset_q8 * 1000000000 / 256 / tws_sync.sample_rate_hz / AUDIO_TWS_SYNC_CORR_TIME;
+	corr = MAX(MIN(corr, AUDIO_TWS_SYNC_MAX_CORR_PPM), -AUDIO_TWS_SYNC_MAX_CORR_PPM);
+
+	/* difference growing 1 sample per second is 1000000 / rate ppm */
+	tws_sync.command_ppm = (int32_t)((int64_t)map->slope_q8 * 1000000 / 256 / tws_sync.sample_rate_hz + corr);
+	*ppm = tws_sync.command_ppm;
+
+	irq_unlock(key);
+	return 0;
+}
+
+int audio_tws_sync_get_stat(audio_tws_sync_stat_t *stat)
+{
+	struct audio_tws_clkmap *map = &tws_sync.diff;
+	unsigned int key;
+
+	if (!tws_sync.sample_rate_hz) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+
+	stat->offset_us = 0;
+	stat->drift_ppm = 0;
+	stat->local_ppm = 0;
+	stat->points = map->count;
+	stat->command_ppm = tws_sync.command_ppm;
+
+	if (map->count) {
+		stat->offset_us = (int32_t)(_tws_sync_offset_q8(tws_sync.last_us) * 1000000 / 256 / tws_sync.sample_rate_hz);
+		stat->drift_ppm = (int32_t)((int64_t)map->slope_q8 * 1000000 / 256 / tws_sync.sample_rate_hz);
+	}
+
+	if (tws_sync.local.count) {
+		stat->local_ppm = (int32_t)((int64_t)tws_sync.local.slope_q8 * 1000000 / 256 / tws_sync.sample_rate_hz);
+	}
+
+	irq_unlock(key);
+	return 0;
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2016 Actions Semi Co., Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief audio tws sync engine.
+*/
+#ifndef __AUDIO_TWS_SYNC_H__
+#define __AUDIO_TWS_SYNC_H__
+
+#include <stdint.h>
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+/* sync points kept for the least squares fit of a clock map */
+#define AUDIO_TWS_SYNC_POINTS		16
+
+/*
+ * Linear map from bt time (us) to a sample position, least squares fitted
+ * over the recent sync points. Fitted as residual against the nominal rate
+ * so the sums stay small in fixed point.
+ */
+struct audio_tws_clkmap {
+	uint32_t time_us[AUDIO_TWS_SYNC_POINTS];
+	int32_t value[AUDIO_TWS_SYNC_POINTS];		/* samples */
+	uint8_t frac_q8[AUDIO_TWS_SYNC_POINTS];		/* fraction of value, 1/256 sample */
+	uint32_t rate;			/* nominal value increase per second */
+	uint8_t count;
+	uint8_t head;
+
+	/* fit result, relative to the newest point */
+	uint32_t ref_time;
+	int32_t ref_value;
+	uint8_t ref_frac_q8;
+	int32_t mean_dx;		/* us */
+	int32_t mean_q8;		/* residual, 1/256 sample */
+	int32_t slope_q8;		/* residual per second, 1/256 sample */
+};
+
+void audio_tws_clkmap_reset(struct audio_tws_clkmap *map, uint32_t rate);
+
+/* add point of value + frac_q8 / 256 samples at time_us */
+void audio_tws_clkmap_add(struct audio_tws_clkmap *map, uint32_t time_us, int32_t value, uint8_t frac_q8);
+
+/* value at time_us in 1/256 sample */
+int64_t audio_tws_clkmap_eval_q8(struct audio_tws_clkmap *map, uint32_t time_us);
+
+/**
+ * @brief reset tws sync engine for a new playback
+ *
+ * @param sample_rate_hz output sample rate
+ */
+void audio_tws_sync_reset(uint32_t sample_rate_hz);
+
+/**
+ * @brief add local sync point of slave
+ *
+ * @param bt_us bt clock in us
+ * @param samples local output sample counter at bt_us
+ */
+void audio_tws_sync_add_local(uint32_t bt_us, uint32_t samples);
+
+/**
+ * @brief add master minus slave sample difference measured at bt_us
+ *
+ * @param bt_us bt clock in us of the measurement
+ * @param diff_samples master samples minus slave samples
+ */
+void audio_tws_sync_add_diff(uint32_t bt_us, int32_t diff_samples);
+
+/**
+ * @brief get rate correction to converge to master
+ *
+ * Returns the slave rate relative to the master rate, in ppm, needed to
+ * follow the master drift and remove the current offset over the
+ * correction time instead of inserting or dropping samples.
+ *
+ * @param bt_us current bt clock in us
+ * @param applied_ppm slave rate relative to master in effect since last call
+ * @param ppm pointer to store the correction
+ *
+ * @return 0 correction valid, others not enough sync points yet
+ */
+int audio_tws_sync_get_correction(uint32_t bt_us, int32_t applied_ppm, int32_t *ppm);
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+#endif /* __AUDIO_TWS_SYNC_H__ */
@@ -70,6 +70,470 @@ exit:
 	return listener;
 }
 
+#ifdef CONFIG_MSG_MANAGER_QUEUE
+
+#define MSG_SLOT_NIL			0xFFFF
+#define MSG_FREE_HEAD(tag, idx)	((((uint32_t)(tag) & 0xFFFF) << 16) | (idx))
+
+#define MSG_HANDLE_IDX(handle)	((handle) & 0xFF)
+#define MSG_HANDLE_GEN(handle)	(((handle) >> 8) & 0x7FFF)
+#define MSG_HANDLE(gen, idx)	((((gen) & 0x7FFF) << 8) | (idx))
+
+struct msg_slot {
+	uint16_t next;
+	uint32_t timestamp;
+	struct app_msg msg;
+};
+
+struct msg_lane {
+	uint16_t head;
+	uint16_t tail;
+};
+
+struct msg_receiver {
+	/* NULL if not used */
+	struct msg_listener *listener;
+	uint16_t gen;
+	struct msg_lane lanes[MSG_NUM_LANES];
+	os_sem sem;
+	struct msg_receiver_stats stats;
+	uint64_t total_latency_us;
+};
+
+static struct msg_slot msg_slots[CONFIG_MSG_MANAGER_NUM_SLOTS];
+/* free list head of msg_slots, ABA tag in high 16 bits and slot index in low 16 bits */
+static atomic_t msg_free_head;
+static atomic_t msg_free_cnt;
+
+static struct msg_receiver msg_receivers[CONFIG_MSG_MANAGER_MAX_RECEIVERS];
+
+#define MSG_NAME_CACHE_SIZE		8
+
+/* receiver handles resolved by name, indexed by the name string address */
+static struct {
+	const char *name;
+	msg_handle_t handle;
+} msg_name_cache[MSG_NAME_CACHE_SIZE];
+
+static struct msg_slot *_msg_slot_alloc(void)
+{
+	uint32_t old_head, new_head;
+	uint16_t idx;
+
+	do {
+		old_head = (uint32_t)atomic_get(&msg_free_head);
+		idx = old_head & 0xFFFF;
+		if (idx == MSG_SLOT_NIL) {
+			return NULL;
+		}
+
+		new_head = MSG_FREE_HEAD((old_head >> 16) + 1, msg_slots[idx].next);
+	} while (!atomic_cas(&msg_free_head, (atomic_val_t)old_head, (atomic_val_t)new_head));
+
+	atomic_dec(&msg_free_cnt);
+	return &msg_slots[idx];
+}
+
+static void _msg_slot_free(struct msg_slot *slot)
+{
+	uint32_t old_head, new_head;
+	uint16_t idx = slot - msg_slots;
+
+	do {
+		old_head = (uint32_t)atomic_get(&msg_free_head);
+		slot->next = old_head & 0xFFFF;
+		new_head = MSG_FREE_HEAD((old_head >> 16) + 1, idx);
+	} while (!atomic_cas(&msg_free_head, (atomic_val_t)old_head, (atomic_val_t)new_head));
+
+	atomic_inc(&msg_free_cnt);
+}
+
+static void _msg_queue_init(void)
+{
+	for (int i = 0; i < CONFIG_MSG_MANAGER_NUM_SLOTS; i++) {
+		msg_slots[i].next = (i + 1 < CONFIG_MSG_MANAGER_NUM_SLOTS) ? i + 1 : MSG_SLOT_NIL;
+	}
+
+	atomic_set(&msg_free_head, MSG_FREE_HEAD(0, 0));
+	atomic_set(&msg_free_cnt, CONFIG_MSG_MANAGER_NUM_SLOTS);
+}
+
+static struct msg_receiver *_msg_receiver_get(msg_handle_t handle)
+{
+	struct msg_receiver *receiver;
+
+	if (handle < 0 || MSG_HANDLE_IDX(handle) >= CONFIG_MSG_MANAGER_MAX_RECEIVERS) {
+		return NULL;
+	}
+
+	receiver = &msg_receivers[MSG_HANDLE_IDX(handle)];
+	if (receiver->listener == NULL || receiver->gen != MSG_HANDLE_GEN(handle)) {
+		return NULL;
+	}
+
+	return receiver;
+}
+
+static struct msg_receiver *_msg_receiver_find_by_tid(os_tid_t tid)
+{
+	for (int i = 0; i < CONFIG_MSG_MANAGER_MAX_RECEIVERS; i++) {
+		struct msg_listener *listener = msg_receivers[i].listener;
+
+		if (listener && listener->tid == tid) {
+			return &msg_receivers[i];
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * Senders pass the same name strings on every send, so the handle is
+ * cached by string address. A cached handle of a removed receiver fails
+ * the generation check in _msg_receiver_get() and is resolved again.
+ */
+static struct msg_receiver *_msg_receiver_get_by_name(char *name)
+{
+	int idx = ((uintptr_t)name >> 2) % MSG_NAME_CACHE_SIZE;
+	struct msg_receiver *receiver;
+	msg_handle_t handle;
+	int key;
+
+	key = os_irq_lock();
+	handle = (msg_name_cache[idx].name == name) ? msg_name_cache[idx].handle : -ENOENT;
+	receiver = _msg_receiver_get(handle);
+	/* the caller may reuse a buffer for another name */
+	if (receiver && receiver->listener->name != name && strcmp(receiver->listener->name, name)) {
+		receiver = NULL;
+	}
+	os_irq_unlock(key);
+
+	if (receiver) {
+		return receiver;
+	}
+
+	handle = msg_manager_get_handle(name);
+	receiver = _msg_receiver_get(handle);
+	if (receiver) {
+		key = os_irq_lock();
+		msg_name_cache[idx].name = name;
+		msg_name_cache[idx].handle = handle;
+		os_irq_unlock(key);
+	}
+
+	return receiver;
+}
+
+/*
+ * ALL_RECEIVER_NAME: like the global mailbox, where the message is taken
+ * by whichever receiver gets it first, the message goes to one receiver,
+ * the one with the fewest pending messages.
+ */
+static struct msg_receiver *_msg_receiver_get_any(void)
+{
+	struct msg_receiver *receiver = NULL;
+	int key = os_irq_lock();
+
+	for (int i = 0; i < CONFIG_MSG_MANAGER_MAX_RECEIVERS; i++) {
+		if (msg_receivers[i].listener &&
+			(receiver == NULL || msg_receivers[i].stats.depth < receiver->stats.depth)) {
+			receiver = &msg_receivers[i];
+		}
+	}
+
+	os_irq_unlock(key);
+	return receiver;
+}
+
+/* must be called with irq locked */
+static msg_handle_t _msg_receiver_open(struct msg_listener *listener)
+{
+	for (int i = 0; i < CONFIG_MSG_MANAGER_MAX_RECEIVERS; i++) {
+		struct msg_receiver *receiver = &msg_receivers[i];
+
+		if (receiver->listener == NULL) {
+			receiver->listener = listener;
+			receiver->gen = (receiver->gen + 1) & 0x7FFF;
+			for (int lane = 0; lane < MSG_NUM_LANES; lane++) {
+				receiver->lanes[lane].head = MSG_SLOT_NIL;
+				receiver->lanes[lane].tail = MSG_SLOT_NIL;
+			}
+
+			os_sem_init(&receiver->sem, 0, CONFIG_MSG_MANAGER_QUEUE_DEPTH);
+			memset(&receiver->stats, 0, sizeof(receiver->stats));
+			receiver->total_latency_us = 0;
+			return MSG_HANDLE(receiver->gen, i);
+		}
+	}
+
+	return -ENOMEM;
+}
+
+static struct msg_slot *_msg_queue_pop(struct msg_receiver *receiver, bool count)
+{
+	struct msg_slot *slot = NULL;
+	int key = os_irq_lock();
+
+	for (int lane = MSG_NUM_LANES - 1; lane >= 0; lane--) {
+		struct msg_lane *msg_lane = &receiver->lanes[lane];
+
+		if (msg_lane->head != MSG_SLOT_NIL) {
+			slot = &msg_slots[msg_lane->head];
+			msg_lane->head = slot->next;
+			if (msg_lane->head == MSG_SLOT_NIL) {
+				msg_lane->tail = MSG_SLOT_NIL;
+			}
+
+			receiver->stats.depth--;
+			if (count) {
+				uint32_t latency_us = k_cyc_to_us_floor32(os_cycle_get_32() - slot->timestamp);
+
+				receiver->stats.received++;
+				receiver->total_latency_us += latency_us;
+				if (latency_us > receiver->stats.max_latency_us) {
+					receiver->stats.max_latency_us = latency_us;
+				}
+			}
+			break;
+		}
+	}
+
+	os_irq_unlock(key);
+	return slot;
+}
+
+/*
+ * drop all pending messages
+ *
+ * The semaphore is reset before popping: a message posted meanwhile is
+ * either drained here, leaving a count the receiver sees as -ENOENT, or
+ * keeps its own count. Resetting after popping could lose its count.
+ */
+static void _msg_queue_drain(struct msg_receiver *receiver)
+{
+	struct msg_slot *slot;
+
+	os_sem_reset(&receiver->sem);
+
+	while ((slot = _msg_queue_pop(receiver, false)) != NULL) {
+		_msg_slot_free(slot);
+	}
+}
+
+static int _msg_queue_post(struct msg_receiver *receiver, struct app_msg *msg, int lane)
+{
+	struct msg_slot *slot;
+	struct msg_lane *msg_lane = &receiver->lanes[lane];
+	int key;
+
+	slot = _msg_slot_alloc();
+	if (slot == NULL) {
+		key = os_irq_lock();
+		receiver->stats.dropped++;
+		os_irq_unlock(key);
+		return -ENOMEM;
+	}
+
+	slot->msg = *msg;
+	slot->next = MSG_SLOT_NIL;
+	slot->timestamp = os_cycle_get_32();
+
+	key = os_irq_lock();
+
+	if (receiver->stats.depth >= CONFIG_MSG_MANAGER_QUEUE_DEPTH) {
+		receiver->stats.dropped++;
+		os_irq_unlock(key);
+		_msg_slot_free(slot);
+		return -EBUSY;
+	}
+
+	if (msg_lane->tail == MSG_SLOT_NIL) {
+		msg_lane->head = slot - msg_slots;
+	} else {
+		msg_slots[msg_lane->tail].next = slot - msg_slots;
+	}
+	msg_lane->tail = slot - msg_slots;
+
+	receiver->stats.posted++;
+	if (++receiver->stats.depth > receiver->stats.max_depth) {
+		receiver->stats.max_depth = receiver->stats.depth;
+	}
+
+	os_irq_unlock(key);
+
+	os_sem_give(&receiver->sem);
+	return 0;
+}
+
+static bool _msg_queue_find(struct msg_receiver *receiver, struct app_msg *msg, int lane)
+{
+	bool found = false;
+	int key = os_irq_lock();
+
+	for (uint16_t idx = receiver->lanes[lane].head; idx != MSG_SLOT_NIL; idx = msg_slots[idx].next) {
+		if (!memcmp(&msg_slots[idx].msg, msg, sizeof(*msg))) {
+			found = true;
+			break;
+		}
+	}
+
+	os_irq_unlock(key);
+	return found;
+}
+
+static int _msg_queue_receive(struct msg_receiver *receiver, struct app_msg *msg, int timeout)
+{
+	struct msg_slot *slot;
+
+	if (os_sem_take(&receiver->sem, timeout)) {
+		return -ETIMEDOUT;
+	}
+
+	slot = _msg_queue_pop(receiver, true);
+	if (slot == NULL) {
+		/* dropped by msg_manager_drop_all_msg() */
+		return -ENOENT;
+	}
+
+	*msg = slot->msg;
+	_msg_slot_free(slot);
+	return 0;
+}
+
+static int _msg_queue_poll(struct msg_receiver *receiver, struct app_msg *msg, os_sem *sem, int timeout)
+{
+#ifdef CONFIG_POLL
+	struct k_poll_event events[2];
+	int ret = OS_POLL_TIMEOUT;
+
+	if (sem == NULL) {
+		return _msg_queue_receive(receiver, msg, timeout) ? OS_POLL_TIMEOUT : OS_POLL_MSG;
+	}
+
+	k_poll_event_init(&events[0], K_POLL_TYPE_SEM_AVAILABLE,
+						K_POLL_MODE_NOTIFY_ONLY, &receiver->sem);
+	k_poll_event_init(&events[1], K_POLL_TYPE_SEM_AVAILABLE,
+						K_POLL_MODE_NOTIFY_ONLY, sem);
+
+	if (k_poll(events, ARRAY_SIZE(events), SYS_TIMEOUT_MS(timeout)) == 0) {
+		if (events[0].state == K_POLL_STATE_SEM_AVAILABLE &&
+			!_msg_queue_receive(receiver, msg, 0)) {
+			ret = OS_POLL_MSG;
+		} else if (events[1].state == K_POLL_STATE_SEM_AVAILABLE &&
+			!os_sem_take(sem, OS_NO_WAIT)) {
+			ret = OS_POLL_SEM;
+		}
+	}
+
+	return ret;
+#else
+	return _msg_queue_receive(receiver, msg, timeout) ? OS_POLL_TIMEOUT : OS_POLL_MSG;
+#endif
+}
+
+static int _msg_queue_send(struct msg_receiver *receiver, struct app_msg *msg, int lane, bool discardable)
+{
+	int try_cnt = 500;
+	int ret;
+
+	/* keep only one such message in the queue */
+	if (discardable && _msg_queue_find(receiver, msg, lane)) {
+		return 0;
+	}
+
+	while ((ret = _msg_queue_post(receiver, msg, lane)) != 0) {
+		if (discardable || os_is_in_isr() || receiver->listener->tid == os_current_get()
+			|| try_cnt-- <= 0) {
+			break;
+		}
+
+		os_sleep(2);
+	}
+
+	return ret;
+}
+
+static bool _msg_manager_send_by_name(char *name, struct app_msg *msg, int lane, bool discardable)
+{
+	struct msg_receiver *receiver;
+	bool in_isr = os_is_in_isr();
+	bool result = false;
+	int prio = 0;
+
+	if (lock_flag) {
+		SYS_LOG_WRN("msg mng is lock %s \n", name);
+	}
+
+	/* not preempted by the receiver before the message is queued */
+	if (!in_isr) {
+		prio = os_thread_priority_get(os_current_get());
+		os_thread_priority_set(os_current_get(), -1);
+	}
+
+	if (strcmp(name, ALL_RECEIVER_NAME)) {
+		receiver = _msg_receiver_get_by_name(name);
+	} else {
+		receiver = _msg_receiver_get_any();
+	}
+
+	if (receiver == NULL) {
+		SYS_LOG_ERR("app %s not ready\n", name);
+		goto exit;
+	}
+
+	if (_msg_queue_send(receiver, msg, lane, discardable)) {
+		SYS_LOG_ERR("send fail, type:%d, cmd:%d\n", msg->type, msg->cmd);
+#ifdef CONFIG_MESSAGE_DEBUG
+		msg_manager_dump_busy_msg();
+#endif
+		goto exit;
+	}
+
+	result = true;
+exit:
+	if (!in_isr) {
+		os_thread_priority_set(os_current_get(), prio);
+	}
+	return result;
+}
+
+msg_handle_t msg_manager_get_handle(const char *name)
+{
+	struct msg_listener *listener = msg_manager_find_by_name((char *)name);
+
+	return listener ? listener->handle : -ENOENT;
+}
+
+bool msg_manager_send_async_msg_by_handle(msg_handle_t handle, struct app_msg *msg, int lane)
+{
+	struct msg_receiver *receiver = _msg_receiver_get(handle);
+
+	if (receiver == NULL || lane < 0 || lane >= MSG_NUM_LANES) {
+		return false;
+	}
+
+	return _msg_queue_post(receiver, msg, lane) == 0;
+}
+
+int msg_manager_get_receiver_stats(msg_handle_t handle, struct msg_receiver_stats *stats)
+{
+	struct msg_receiver *receiver = _msg_receiver_get(handle);
+	int key;
+
+	if (receiver == NULL) {
+		return -EINVAL;
+	}
+
+	key = os_irq_lock();
+	*stats = receiver->stats;
+	stats->avg_latency_us = stats->received ?
+			(uint32_t)(receiver->total_latency_us / stats->received) : 0;
+	os_irq_unlock(key);
+
+	return 0;
+}
+#endif /* CONFIG_MSG_MANAGER_QUEUE */
+
 char *msg_manager_get_current(void)
 {
 	struct msg_listener *listener = msg_manager_find_by_tid(os_current_get());
@@ -116,6 +580,15 @@ bool msg_manager_add_listener(char *name, os_tid_t tid)
 	listener->channel_id = -1;
 #endif
 	listener->tid = tid;
+#ifdef CONFIG_MSG_MANAGER_QUEUE
+	listener->handle = _msg_receiver_open(listener);
+	if (listener->handle < 0) {
+		SYS_LOG_ERR("too many receivers %s\n", name);
+		mem_free(listener);
+		os_irq_unlock(key);
+		return false;
+	}
+#endif
 	sys_slist_append(&global_receiver_list, (sys_snode_t *)listener);
 
 exit:
@@ -131,6 +604,13 @@ bool msg_manager_remove_listener(char *name)
 	int key = os_irq_lock();
 	if (listener != NULL) {
 		sys_slist_find_and_remove(&global_receiver_list, (sys_snode_t *)listener);
+#ifdef CONFIG_MSG_MANAGER_QUEUE
+		struct msg_receiver *receiver = _msg_receiver_get(listener->handle);
+		if (receiver) {
+			_msg_queue_drain(receiver);
+			receiver->listener = NULL;
+		}
+#endif
 #ifdef CONFIG_TASK_WDT
 		if (listener && listener->channel_id >= 0) {
 			task_wdt_delete(listener->channel_id);
@@ -159,6 +639,9 @@ os_tid_t  msg_manager_listener_tid(char *name)
 bool msg_manager_init(void)
 {
 	os_msg_init();
+#ifdef CONFIG_MSG_MANAGER_QUEUE
+	_msg_queue_init();
+#endif
 	lock_flag = false;
 #ifdef CONFIG_TASK_WDT
 	task_wdt_manager_init();
@@ -175,6 +658,9 @@ bool msg_manager_init(void)
 
 bool msg_manager_send_async_msg(char *receiver, struct app_msg *msg)
 {
+#ifdef CONFIG_MSG_MANAGER_QUEUE
+	return _msg_manager_send_by_name(receiver, msg, MSG_LANE_NORMAL, false);
+#else
 	int prio;
 	bool result = false;
 	os_tid_t target_thread_tid = OS_ANY;
@@ -212,10 +698,14 @@ exit:
 #endif
 	os_thread_priority_set(os_current_get(), prio);
 	return result;
+#endif /* CONFIG_MSG_MANAGER_QUEUE */
 }
 
 bool msg_manager_send_async_msg_discardable(char *receiver, struct app_msg *msg)
 {
+#ifdef CONFIG_MSG_MANAGER_QUEUE
+	return _msg_manager_send_by_name(receiver, msg, MSG_LANE_HIGH, true);
+#else
 	int prio;
 	bool result = false;
 	os_tid_t target_thread_tid = OS_ANY;
@@ -253,6 +743,7 @@ exit:
 #endif
 	os_thread_priority_set(os_current_get(), prio);
 	return result;
+#endif /* CONFIG_MSG_MANAGER_QUEUE */
 }
 
 #if 0
@@ -317,6 +808,12 @@ bool msg_manager_receive_msg(struct app_msg *msg, int timeout)
 	}
 #endif
 
+#ifdef CONFIG_MSG_MANAGER_QUEUE
+	struct msg_receiver *receiver = _msg_receiver_find_by_tid(os_current_get());
+	if (receiver) {
+		result = !_msg_queue_receive(receiver, msg, timeout);
+	} else
+#endif
 	if (!os_receive_msg(msg, sizeof(struct app_msg), timeout))
 	{
 		result  = true;
@@ -333,21 +830,44 @@ bool msg_manager_receive_msg(struct app_msg *msg, int timeout)
 
 int msg_manager_poll_msg(struct app_msg *msg, os_sem *sem, int timeout)
 {
+#ifdef CONFIG_MSG_MANAGER_QUEUE
+	struct msg_receiver *receiver = _msg_receiver_find_by_tid(os_current_get());
+	if (receiver) {
+		return _msg_queue_poll(receiver, msg, sem, timeout);
+	}
+#endif
 	return os_poll_msg(msg, sizeof(struct app_msg), sem, timeout);
 }
 
 int msg_manager_get_free_msg_num(void)
 {
+#ifdef CONFIG_MSG_MANAGER_QUEUE
+	return atomic_get(&msg_free_cnt);
+#else
 	return msg_pool_get_free_msg_num();
+#endif
 }
 
 void msg_manager_drop_all_msg(void)
 {
+#ifdef CONFIG_MSG_MANAGER_QUEUE
+	for (int i = 0; i < CONFIG_MSG_MANAGER_MAX_RECEIVERS; i++) {
+		if (msg_receivers[i].listener) {
+			_msg_queue_drain(&msg_receivers[i]);
+		}
+	}
+#endif
 	os_msg_clean();
 }
 
 int msg_manager_get_pending_msg_cnt(void)
 {
+#ifdef CONFIG_MSG_MANAGER_QUEUE
+	struct msg_receiver *receiver = _msg_receiver_find_by_tid(os_current_get());
+	if (receiver) {
+		return receiver->stats.depth;
+	}
+#endif
 	return os_get_pending_msg_cnt();
 }
 
@@ -381,6 +901,33 @@ static void _msg_manager_dump_cb(os_tid_t sender, os_tid_t receiver,
 
 void msg_manager_dump_busy_msg(void)
 {
+#ifdef CONFIG_MSG_MANAGER_QUEUE
+	os_printk("msg free slot cnt %d/%d\n", (int)atomic_get(&msg_free_cnt), CONFIG_MSG_MANAGER_NUM_SLOTS);
+
+	for (int i = 0; i < CONFIG_MSG_MANAGER_MAX_RECEIVERS; i++) {
+		struct msg_receiver *receiver = &msg_receivers[i];
+		struct msg_receiver_stats stats;
+
+		if (receiver->listener == NULL ||
+			msg_manager_get_receiver_stats(receiver->listener->handle, &stats)) {
+			continue;
+		}
+
+		os_printk("receiver %s: depth %u/%u, posted %u, received %u, dropped %u, latency avg %u us max %u us\n",
+			receiver->listener->name, stats.depth, stats.max_depth, stats.posted,
+			stats.received, stats.dropped, stats.avg_latency_us, stats.max_latency_us);
+
+		int key = os_irq_lock();
+		for (int lane = MSG_NUM_LANES - 1; lane >= 0; lane--) {
+			for (uint16_t idx = receiver->lanes[lane].head; idx != MSG_SLOT_NIL; idx = msg_slots[idx].next) {
+				_msg_manager_dump_cb(OS_ANY, receiver->listener->tid,
+						(const char *)&msg_slots[idx].msg, sizeof(struct app_msg));
+			}
+		}
+		os_irq_unlock(key);
+	}
+#else
 	msg_pool_dump(_msg_manager_dump_cb);
+#endif
 }
 
@@ -38,6 +38,19 @@ extern "C" {
 void *mem_malloc_debug(size_t size,const char *func);
 #define mem_malloc(size) mem_malloc_debug(size, __func__)
 
+/**
+ * @brief Allocate memory from system mem heap without clearing it.
+ *
+ * Same as mem_malloc(), but the content of the memory is undefined. Only
+ * for callers that initialize the whole block themselves.
+ *
+ * @param num_bytes Amount of memory requested (in bytes).
+ *
+ * @return Address of the allocated memory if successful; otherwise NULL.
+ */
+void *mem_malloc_nozero_debug(size_t size, const char *func);
+#define mem_malloc_nozero(size) mem_malloc_nozero_debug(size, __func__)
+
 /**
  * @brief Free memory allocated  system mem heap.
  *
@@ -96,6 +96,17 @@ typedef enum
 } msg_type;
 
 
+/** handle of a message receiver, negative if invalid */
+typedef int msg_handle_t;
+
+/** message lanes of a receiver, the high priority lane is received first */
+enum {
+	MSG_LANE_NORMAL = 0,
+	MSG_LANE_HIGH,
+
+	MSG_NUM_LANES,
+};
+
 struct msg_listener
 {
 	sys_snode_t node;
@@ -104,6 +115,9 @@ struct msg_listener
 #ifdef CONFIG_TASK_WDT
 	int channel_id;
 #endif
+#ifdef CONFIG_MSG_MANAGER_QUEUE
+	msg_handle_t handle;
+#endif
 };
 
 #define LISTENER_INFO(_node) CONTAINER_OF(_node, struct msg_listener, node)
@@ -248,6 +262,65 @@ int msg_manager_get_pending_msg_cnt(void);
  */
 void msg_manager_dump_busy_msg(void);
 
+#ifdef CONFIG_MSG_MANAGER_QUEUE
+/** @brief statistics of a message receiver
+ *  @param posted number of messages posted
+ *  @param received number of messages received
+ *  @param dropped number of messages dropped for queue full or no free slot
+ *  @param depth current number of pending messages
+ *  @param max_depth maximum number of pending messages
+ *  @param avg_latency_us average latency from post to receive in us
+ *  @param max_latency_us maximum latency from post to receive in us
+ */
+struct msg_receiver_stats
+{
+	uint32_t posted;
+	uint32_t received;
+	uint32_t dropped;
+	uint16_t depth;
+	uint16_t max_depth;
+	uint32_t avg_latency_us;
+	uint32_t max_latency_us;
+};
+
+/**
+ * @brief get message receiver handle by name
+ *
+ * This routine get the handle of a message listener, the handle keeps
+ * valid until the listener removed.
+ *
+ * @param name name of message receiver
+ *
+ * @return handle of the receiver, negative if not found
+ */
+msg_handle_t msg_manager_get_handle(const char *name);
+
+/**
+ * @brief Send a Asynchronous message by receiver handle
+ *
+ * This routine Send a Asynchronous message without name lookup, and
+ * never waits for free message slot, so can be called in interrupt.
+ *
+ * @param handle handle of message receiver
+ * @param msg message to send
+ * @param lane MSG_LANE_NORMAL or MSG_LANE_HIGH
+ *
+ * @return true send success
+ * @return false send failed
+ */
+bool msg_manager_send_async_msg_by_handle(msg_handle_t handle, struct app_msg *msg, int lane);
+
+/**
+ * @brief get message receiver statistics
+ *
+ * @param handle handle of message receiver
+ * @param stats store the statistics
+ *
+ * @return 0 on success, negative if handle invalid
+ */
+int msg_manager_get_receiver_stats(msg_handle_t handle, struct msg_receiver_stats *stats);
+#endif /* CONFIG_MSG_MANAGER_QUEUE */
+
 /**
  * @cond INTERNAL_HIDDEN
  */
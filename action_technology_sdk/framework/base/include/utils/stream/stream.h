@@ -115,6 +115,14 @@ typedef struct {
 	/** stream destroy operation Function pointer*/
 	int (*destroy)(io_stream_t handle);
 	void *(*get_ringbuffer)(io_stream_t handle);
+	/** stream read claim operation Function pointer, return contiguous readable bytes*/
+	int (*read_claim)(io_stream_t handle, unsigned char **buf, int num);
+	/** stream read commit operation Function pointer*/
+	int (*read_commit)(io_stream_t handle, int num);
+	/** stream write claim operation Function pointer, return contiguous writable bytes*/
+	int (*write_claim)(io_stream_t handle, unsigned char **buf, int num);
+	/** stream write commit operation Function pointer*/
+	int (*write_commit)(io_stream_t handle, int num);
 } stream_ops_t;
 
 /**
@@ -152,6 +160,11 @@ int stream_open(io_stream_t handle, stream_mode mode);
  * This routine provides read num of bytes from stream, if stream states is
  * not STATE_OPEN , return err , else return the realy read data len to user
  *
+ * In MODE_READ_BLOCK mode it waits until num bytes are available, woken by
+ * stream_write or stream_write_commit once they are. Data put behind the
+ * stream api, as by the dsp into a shared ring buffer, wakes nobody: only a
+ * 50 ms poll sees it, so such a reader may lag its peer by up to 50 ms.
+ *
  * @param handle handle of stream
  * @param buf out put data buffer pointer
   * @param num bytes user want to read
@@ -167,6 +180,10 @@ int stream_read(io_stream_t handle, void *buf, int num);
  * This routine provides write num of bytes to stream, if stream states is
  * not STATE_OPEN , return err , else return the realy write data len to user
  *
+ * In MODE_WRITE_BLOCK mode it waits until num bytes of space are available,
+ * woken by stream_read or stream_read_commit; space freed behind the stream
+ * api is only seen by the 50 ms poll, as for stream_read.
+ *
  *
  * @param handle handle of stream
  * @param buf data poninter of write
@@ -177,6 +194,70 @@ int stream_read(io_stream_t handle, void *buf, int num);
  */
 int stream_write(io_stream_t handle, const void *buf, int num);
 
+/**
+ * @brief claim data of stream in place
+ *
+ * This routine provides the address of the stream data itself, so user can
+ * consume it without copying. The region must be released by
+ * stream_read_commit before claiming again. In MODE_READ_BLOCK mode it
+ * waits until num bytes are available.
+ *
+ * @param handle handle of stream
+ * @param buf address of claimed data
+ * @param num bytes user want to read
+ *
+ * @return >=0 contiguous bytes claimed, may be less than num if buffer wraps
+ * @return -ENOTSUP stream not support claim
+ * @return <0  stream claim failed
+ */
+int stream_read_claim(io_stream_t handle, void **buf, int num);
+
+/**
+ * @brief commit data consumed from claimed region
+ *
+ * Attached streams and read observers get the data directly from the
+ * claimed region before it is released.
+ *
+ * @param handle handle of stream
+ * @param num bytes consumed, not larger than claimed
+ *
+ * @return >=0 bytes committed
+ * @return <0  stream commit failed
+ */
+int stream_read_commit(io_stream_t handle, int num);
+
+/**
+ * @brief claim free space of stream in place
+ *
+ * This routine provides the address of the stream free space itself, so user
+ * can produce data into it without copying. The region must be released by
+ * stream_write_commit before claiming again. In MODE_WRITE_BLOCK mode it
+ * waits until num bytes of space are available.
+ *
+ * @param handle handle of stream
+ * @param buf address of claimed space
+ * @param num bytes user want to write
+ *
+ * @return >=0 contiguous bytes claimed, may be less than num if buffer wraps
+ * @return -ENOTSUP stream not support claim
+ * @return <0  stream claim failed
+ */
+int stream_write_claim(io_stream_t handle, void **buf, int num);
+
+/**
+ * @brief commit data produced into claimed region
+ *
+ * Pre write observers process the data in place before it is committed,
+ * attached streams and write observers get it from the claimed region.
+ *
+ * @param handle handle of stream
+ * @param num bytes produced, not larger than claimed
+ *
+ * @return >=0 bytes committed
+ * @return <0  stream commit failed
+ */
+int stream_write_commit(io_stream_t handle, int num);
+
 /**
  * @brief seek stream
  *
@@ -366,6 +447,14 @@ struct __stream {
 	uint32_t total_size;
 
 	os_sem *sync_sem;
+	/** data length a blocked reader waits for */
+	int read_wait;
+	/** space a blocked writer waits for */
+	int write_wait;
+	/** region claimed by reader */
+	unsigned char *read_claim_buf;
+	/** region claimed by writer */
+	unsigned char *write_claim_buf;
 
 	void *observer[2];
 	uint8_t  observer_type[2];
@@ -13,6 +13,7 @@
 
 #ifdef CONFIG_APP_USED_MEM_POOL
 void *mem_pool_malloc(unsigned int num_bytes);
+void *mem_pool_malloc_nozero(unsigned int num_bytes);
 void mem_pool_free(void *ptr);
 void mem_pool_dump(void);
 void mem_pool_init(void);
@@ -27,6 +27,15 @@ void *mem_malloc_debug(size_t size,const char *func)
 #endif
 }
 
+void *mem_malloc_nozero_debug(size_t size, const char *func)
+{
+#ifdef CONFIG_SYS_MEMORY_DEBUG
+	return mem_guard_malloc(&mem_guard, mem_pool_malloc_nozero, size, func);
+#else
+	return mem_pool_malloc_nozero(size);
+#endif
+}
+
 void mem_free(void *ptr)
 {
 	if (ptr == NULL)
@@ -31,17 +31,8 @@ struct k_heap sys_mem_pool = {
 					.init_bytes = SYS_MEM_POOL_SIZE,
 				},
 };
-void* mem_pool_malloc(unsigned int num_bytes)
-{
-	void* ptr = k_heap_aligned_alloc(&sys_mem_pool, sizeof(void*), num_bytes, OS_FOREVER);
-	if (ptr == NULL) {
-		sys_heap_dump(&sys_mem_pool.heap);
-	}
-	else {
-		memset(ptr, 0, num_bytes);
-	}
-	return ptr;
-}
+#define MEM_POOL_NO_WAIT	OS_NO_WAIT
+#define MEM_POOL_FOREVER	OS_FOREVER
 #else
 STRUCT_SECTION_ITERABLE(k_heap, sys_mem_pool) = {
 				.heap = {
@@ -49,23 +40,300 @@ STRUCT_SECTION_ITERABLE(k_heap, sys_mem_pool) = {
 					.init_bytes = SYS_MEM_POOL_SIZE,
 				},
 };
+#define MEM_POOL_NO_WAIT	K_NO_WAIT
+#define MEM_POOL_FOREVER	K_FOREVER
+#endif
 
-void *mem_pool_malloc(unsigned int num_bytes)
+#ifdef CONFIG_MEM_POOL_SIZE_CLASS
+
+/*
+ * Size-class front end.
+ *
+ * Every block carries a pointer sized header recording its size class. Freed blocks
+ * of a class are kept on a per-class free list (up to
+ * CONFIG_MEM_POOL_SIZE_CLASS_CACHE blocks) and handed out again without
+ * entering the heap, the class of a request is found by a table lookup.
+ * Requests larger than the biggest class go to the heap directly.
+ */
+
+#define MEM_POOL_HDR_MAGIC	0xA55A
+#define MEM_POOL_CLASS_LARGE	0xFF
+#define MEM_POOL_CLASS_SHIFT	3
+#define MEM_POOL_CLASS_MAX	256
+
+/* pointer sized, so the payload stays pointer aligned on 64-bit hosts */
+union mem_pool_hdr {
+	struct {
+		uint16_t magic;
+		uint8_t cls;
+		uint8_t reserved;
+	};
+	void *align;
+};
+
+struct mem_pool_class {
+	void *free_list;
+	uint16_t size;
+	uint16_t free_cnt;
+
+	/* statistics */
+	uint32_t alloc_cnt;
+	uint32_t hit_cnt;
+	uint32_t busy_cnt;
+};
+
+struct mem_pool_stats {
+	uint32_t alloc_cnt;
+	uint32_t free_cnt;
+	uint32_t fail_cnt;
+	/* bytes requested from and held by the size classes */
+	uint32_t req_bytes;
+	uint32_t used_bytes;
+	uint32_t peak_bytes;
+	/* snapshot of the last dump, to compute the allocation rate */
+	uint32_t last_alloc_cnt;
+	uint32_t last_dump_ms;
+};
+
+static struct mem_pool_class mem_pool_classes[] = {
+	{ .size = 16, }, { .size = 24, }, { .size = 32, }, { .size = 48, },
+	{ .size = 64, }, { .size = 96, }, { .size = 128, }, { .size = 192, },
+	{ .size = 256, },
+};
+
+#define MEM_POOL_NUM_CLASSES	ARRAY_SIZE(mem_pool_classes)
+
+/* class index of every (size >> MEM_POOL_CLASS_SHIFT) up to MEM_POOL_CLASS_MAX */
+static const uint8_t mem_pool_class_lut[(MEM_POOL_CLASS_MAX >> MEM_POOL_CLASS_SHIFT) + 1] = {
+	0, 0, 0, 1, 2, 3, 3, 4, 4,		/* 0 - 64 */
+	5, 5, 5, 5, 6, 6, 6, 6,			/* 72 - 128 */
+	7, 7, 7, 7, 7, 7, 7, 7,			/* 136 - 192 */
+	8, 8, 8, 8, 8, 8, 8, 8,			/* 200 - 256 */
+};
+
+static struct mem_pool_stats mem_pool_stats;
+
+static inline int _mem_pool_size_to_class(unsigned int num_bytes)
+{
+	if (num_bytes > MEM_POOL_CLASS_MAX) {
+		return MEM_POOL_CLASS_LARGE;
+	}
+
+	return mem_pool_class_lut[(num_bytes + (1 << MEM_POOL_CLASS_SHIFT) - 1) >> MEM_POOL_CLASS_SHIFT];
+}
+
+/* return all cached blocks to the heap */
+static void _mem_pool_class_flush(void)
+{
+	for (int i = 0; i < MEM_POOL_NUM_CLASSES; i++) {
+		struct mem_pool_class *sc = &mem_pool_classes[i];
+		void *block;
+		int key;
+
+		for (;;) {
+			key = os_irq_lock();
+			block = sc->free_list;
+			if (block) {
+				sc->free_list = *(void **)block;
+				sc->free_cnt--;
+				mem_pool_stats.used_bytes -= sc->size;
+			}
+			os_irq_unlock(key);
+
+			if (block == NULL) {
+				break;
+			}
+
+			k_heap_free(&sys_mem_pool, (union mem_pool_hdr *)block - 1);
+		}
+	}
+}
+
+static void *_mem_pool_heap_alloc(unsigned int num_bytes)
 {
-	void *ptr =  k_heap_aligned_alloc(&sys_mem_pool, sizeof(void *), num_bytes, K_FOREVER);
+	unsigned int size = num_bytes + sizeof(union mem_pool_hdr);
+	void *ptr;
+
+	ptr = k_heap_aligned_alloc(&sys_mem_pool, sizeof(void *), size, MEM_POOL_NO_WAIT);
+	if (ptr == NULL) {
+		/* cached blocks may be what the heap is short of */
+		_mem_pool_class_flush();
+		ptr = k_heap_aligned_alloc(&sys_mem_pool, sizeof(void *), size, MEM_POOL_FOREVER);
+	}
+
+	return ptr;
+}
+
+static void *_mem_pool_alloc(unsigned int num_bytes)
+{
+	struct mem_pool_class *sc = NULL;
+	union mem_pool_hdr *hdr;
+	void *block;
+	unsigned int size = num_bytes;
+	int cls = _mem_pool_size_to_class(num_bytes);
+	int key;
+
+	if (cls != MEM_POOL_CLASS_LARGE) {
+		sc = &mem_pool_classes[cls];
+		size = sc->size;
+
+		key = os_irq_lock();
+		block = sc->free_list;
+		if (block) {
+			sc->free_list = *(void **)block;
+			sc->free_cnt--;
+			sc->hit_cnt++;
+			sc->alloc_cnt++;
+			sc->busy_cnt++;
+			mem_pool_stats.alloc_cnt++;
+			mem_pool_stats.req_bytes += num_bytes;
+			os_irq_unlock(key);
+			return block;
+		}
+		os_irq_unlock(key);
+	}
+
+	hdr = _mem_pool_heap_alloc(size);
+	if (hdr == NULL) {
+		mem_pool_stats.fail_cnt++;
+		return NULL;
+	}
+
+	hdr->magic = MEM_POOL_HDR_MAGIC;
+	hdr->cls = cls;
+	hdr->reserved = 0;
+
+	key = os_irq_lock();
+	mem_pool_stats.alloc_cnt++;
+	if (sc) {
+		sc->alloc_cnt++;
+		sc->busy_cnt++;
+		mem_pool_stats.req_bytes += num_bytes;
+		mem_pool_stats.used_bytes += size;
+		if (mem_pool_stats.used_bytes > mem_pool_stats.peak_bytes) {
+			mem_pool_stats.peak_bytes = mem_pool_stats.used_bytes;
+		}
+	}
+	os_irq_unlock(key);
+
+	return hdr + 1;
+}
+
+static void _mem_pool_free(void *ptr)
+{
+	union mem_pool_hdr *hdr = (union mem_pool_hdr *)ptr - 1;
+	struct mem_pool_class *sc;
+	int key;
+
+	if (hdr->magic != MEM_POOL_HDR_MAGIC) {
+		SYS_LOG_ERR("invalid ptr %p\n", ptr);
+		return;
+	}
+
+	key = os_irq_lock();
+	mem_pool_stats.free_cnt++;
+
+	if (hdr->cls == MEM_POOL_CLASS_LARGE) {
+		os_irq_unlock(key);
+		k_heap_free(&sys_mem_pool, hdr);
+		return;
+	}
+
+	sc = &mem_pool_classes[hdr->cls];
+	sc->busy_cnt--;
+
+	if (sc->free_cnt < CONFIG_MEM_POOL_SIZE_CLASS_CACHE) {
+		*(void **)ptr = sc->free_list;
+		sc->free_list = ptr;
+		sc->free_cnt++;
+		os_irq_unlock(key);
+		return;
+	}
+
+	mem_pool_stats.used_bytes -= sc->size;
+	os_irq_unlock(key);
+
+	k_heap_free(&sys_mem_pool, hdr);
+}
+
+static void _mem_pool_class_dump(void)
+{
+	struct mem_pool_stats *stats = &mem_pool_stats;
+	uint32_t now = os_uptime_get_32();
+	uint32_t elapsed = now - stats->last_dump_ms;
+	uint32_t cached_bytes = 0;
+	uint32_t class_bytes = 0;
+	uint32_t class_req = 0;
+
+	os_printk("size class: size alloc hit busy cached\n");
+	for (int i = 0; i < MEM_POOL_NUM_CLASSES; i++) {
+		struct mem_pool_class *sc = &mem_pool_classes[i];
+
+		os_printk("  %4u %8u %8u %4u %4u\n", sc->size, sc->alloc_cnt,
+				sc->hit_cnt, sc->busy_cnt, sc->free_cnt);
+		cached_bytes += sc->free_cnt * sc->size;
+		class_bytes += sc->busy_cnt * sc->size;
+	}
+
+	os_printk("alloc %u free %u fail %u, rate %u/s\n", stats->alloc_cnt,
+			stats->free_cnt, stats->fail_cnt,
+			elapsed ? (stats->alloc_cnt - stats->last_alloc_cnt) * 1000 / elapsed : 0);
+	os_printk("class bytes %u (peak %u), busy %u, cached %u\n", stats->used_bytes,
+			stats->peak_bytes, class_bytes, cached_bytes);
+
+	/* requested sizes are not kept per block, so estimate the internal
+	 * fragmentation from the cumulative class usage.
+	 */
+	for (int i = 0; i < MEM_POOL_NUM_CLASSES; i++) {
+		class_req += mem_pool_classes[i].alloc_cnt * mem_pool_classes[i].size;
+	}
+	if (class_req > 0 && stats->req_bytes <= class_req) {
+		os_printk("fragmentation: internal ~%u%%, cached %u%%\n",
+			(class_req - stats->req_bytes) * 100 / class_req,
+			stats->used_bytes ? cached_bytes * 100 / stats->used_bytes : 0);
+	}
+
+	stats->last_alloc_cnt = stats->alloc_cnt;
+	stats->last_dump_ms = now;
+}
+
+#endif /* CONFIG_MEM_POOL_SIZE_CLASS */
+
+void *mem_pool_malloc_nozero(unsigned int num_bytes)
+{
+	void *ptr;
+
+#ifdef CONFIG_MEM_POOL_SIZE_CLASS
+	ptr = _mem_pool_alloc(num_bytes);
+#else
+	ptr = k_heap_aligned_alloc(&sys_mem_pool, sizeof(void *), num_bytes, MEM_POOL_FOREVER);
+#endif
 	if (ptr == NULL) {
 		sys_heap_dump(&sys_mem_pool.heap);
-	} else {
+	}
+
+	return ptr;
+}
+
+void *mem_pool_malloc(unsigned int num_bytes)
+{
+	void *ptr = mem_pool_malloc_nozero(num_bytes);
+
+	if (ptr) {
 		memset(ptr, 0, num_bytes);
 	}
+
 	return ptr;
 }
-#endif
 
 void mem_pool_free(void *ptr)
 {
 	if (ptr) {
+#ifdef CONFIG_MEM_POOL_SIZE_CLASS
+		_mem_pool_free(ptr);
+#else
 		k_heap_free(&sys_mem_pool, ptr);
+#endif
 	}
 }
 
@@ -73,6 +341,9 @@ void mem_pool_dump(void)
 {
 	sys_heap_dump(&sys_mem_pool.heap);
 	os_printk("total size of pool %d \n", SYS_MEM_POOL_SIZE);
+#ifdef CONFIG_MEM_POOL_SIZE_CLASS
+	_mem_pool_class_dump();
+#endif
 }
 
 void mem_pool_init(void)
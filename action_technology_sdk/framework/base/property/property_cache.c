@@ -142,7 +142,7 @@ int property_cache_set(const char *name, const void *data, int len)
 		} else {
 			void *old_data = item->data;
 			if (len > 0) {
-				item->data = mem_malloc(len);
+				item->data = mem_malloc_nozero(len);
 				memcpy(item->data, data, len);
 			}
 			item->data_len = len;
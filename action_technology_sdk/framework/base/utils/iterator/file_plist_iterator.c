@@ -10,6 +10,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <os_common_api.h>
+#include <sys/crc.h>
 
 #define MAX_DIR_LEVEL 9
 #define FULL_PATH_LEN (MAX_URL_LEN + 2)
@@ -39,6 +40,9 @@ struct play_list_t {
 	uint16_t csize;			/* Cluster size [sectors] */
 	const char *topdir;
 	int (*match_fn)(const char *path, int is_dir);
+#ifdef CONFIG_FILE_ITERATOR_MEDIA_INDEX
+	struct media_index *index;
+#endif
 };
 
 static struct play_list_t *play_list = NULL;
@@ -70,6 +74,482 @@ static struct play_list_t *get_play_list(void)
 	return play_list;
 }
 
+#ifdef CONFIG_FILE_ITERATOR_MEDIA_INDEX
+/*
+ * Media index: one record per track, in play list order, followed by the
+ * folder table of the play list. It is kept under
+ * CONFIG_FILE_ITERATOR_MEDIA_INDEX_DIR, on an internal volume, never in the
+ * media tree of the user, with one file per top directory.
+ *
+ * While the disk is unchanged the play list is restored from the index
+ * without scanning the disk. The disk counts as unchanged when its size and
+ * free clusters are those recorded, and the last track of every folder is
+ * still at its recorded offset with no new track after it. A change this
+ * misses (a track moved within its folder) is caught when the track is
+ * read, and drops the index so the next update scans again.
+ *
+ * Otherwise the index is rebuilt while scanning the disk: records are
+ * compared chunk by chunk against the index file and only the chunks from
+ * the first difference on are written back. Afterwards the dir entry of any
+ * track is found by one read of the index file and one fs_readdir at the
+ * recorded offset, instead of counting entries from the start of its folder.
+ */
+#define MEDIA_INDEX_MAGIC		0x5844494D	/* "MIDX" */
+#define MEDIA_INDEX_VERSION		2
+#define MEDIA_INDEX_CHUNK		32
+
+struct media_index_header {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t rec_size;
+	uint32_t top_cluster;
+	uint16_t file_count;
+	uint16_t folder_count;
+	uint16_t folder_size;
+	uint16_t max_level;
+	uint32_t match_fn;	/* filter of the play list */
+	uint32_t blocks;	/* clusters of the disk */
+	uint32_t bfree;		/* free clusters of the disk */
+};
+
+struct media_index_rec {
+	uint32_t dir_cluster;	/* start cluster of the folder */
+	uint32_t blk_ofs;	/* offset of the dir entry in the folder */
+	uint32_t size;		/* file size, to detect a stale index */
+};
+
+struct media_index {
+	struct fs_file_t file;
+	uint8_t valid : 1;	/* usable for lookup */
+	uint8_t dirty : 1;	/* file differs from the scanned records */
+	uint8_t error : 1;	/* file access failed, index disabled */
+	uint8_t unchanged : 1;	/* header matches the disk, the scan may be skipped */
+	uint16_t count;		/* number of records */
+	uint16_t folder_count;	/* number of folders */
+	uint16_t chunk_base;	/* track index (from 0) of chunk[0] */
+	uint16_t chunk_cnt;
+	struct media_index_header header;	/* of the disk as it is now */
+	struct media_index_rec chunk[MEDIA_INDEX_CHUNK];
+	struct media_index_rec cmp[MEDIA_INDEX_CHUNK];
+};
+
+#define MEDIA_INDEX_REC_OFS(n) \
+	(sizeof(struct media_index_header) + (n) * sizeof(struct media_index_rec))
+
+static int get_cursor_info(const char *path, uint32_t *cluster, uint32_t *blk_ofs, uint32_t *file_size);
+
+static int media_index_rw(struct media_index *index, uint16_t base, void *buf, uint16_t cnt, bool write)
+{
+	ssize_t len = cnt * sizeof(struct media_index_rec);
+	ssize_t res;
+
+	if (fs_seek(&index->file, MEDIA_INDEX_REC_OFS(base), FS_SEEK_SET))
+		return -EIO;
+
+	res = write ? fs_write(&index->file, buf, len) : fs_read(&index->file, buf, len);
+
+	return (res == len) ? 0 : -EIO;
+}
+
+/* clear the magic on the file, so the next update scans the disk */
+static void media_index_invalidate(struct media_index *index)
+{
+	uint32_t magic = 0;
+
+	index->valid = 0;
+	index->unchanged = 0;
+
+	if (fs_seek(&index->file, 0, FS_SEEK_SET) ||
+		fs_write(&index->file, &magic, sizeof(magic)) != sizeof(magic) ||
+		fs_sync(&index->file)) {
+		SYS_LOG_WRN("media index invalidate failed\n");
+		index->error = 1;
+	}
+}
+
+/* size and free clusters of the disk, which change with its content */
+static void media_index_fingerprint(struct play_list_t *plist, struct media_index_header *header)
+{
+	struct fs_statvfs stat;
+
+	if (fs_statvfs(plist->topdir, &stat)) {
+		header->blocks = 0;
+		header->bfree = 0;
+		return;
+	}
+
+	header->blocks = stat.f_blocks;
+	header->bfree = stat.f_bfree;
+}
+
+/* compare the built chunk with the file, write it back if different */
+static void media_index_flush_chunk(struct media_index *index)
+{
+	if (index->error || index->chunk_cnt == 0)
+		return;
+
+	if (!index->dirty) {
+		if (index->chunk_base + index->chunk_cnt > index->count ||
+			media_index_rw(index, index->chunk_base, index->cmp, index->chunk_cnt, false) ||
+			memcmp(index->cmp, index->chunk, index->chunk_cnt * sizeof(struct media_index_rec))) {
+			SYS_LOG_INF("media index changed from track %d\n", index->chunk_base + 1);
+			index->dirty = 1;
+			media_index_invalidate(index);
+		}
+	}
+
+	if (index->dirty && !index->error &&
+		media_index_rw(index, index->chunk_base, index->chunk, index->chunk_cnt, true)) {
+		SYS_LOG_WRN("media index write failed\n");
+		index->error = 1;
+	}
+
+	index->chunk_base += index->chunk_cnt;
+	index->chunk_cnt = 0;
+}
+
+/* open the index of topdir and check its header against the disk */
+static void media_index_open(struct play_list_t *plist, struct file_iterator_data *data)
+{
+	struct media_index *index = plist->index;
+	struct media_index_header header;
+	char path[sizeof(CONFIG_FILE_ITERATOR_MEDIA_INDEX_DIR) + 20];
+
+	if (!index) {
+		index = mem_malloc(sizeof(*index));
+		if (!index)
+			return;
+		plist->index = index;
+	} else {
+		fs_close(&index->file);
+		memset(index, 0, sizeof(*index));
+	}
+
+	fs_file_t_init(&index->file);
+	index->header.magic = MEDIA_INDEX_MAGIC;
+	index->header.version = MEDIA_INDEX_VERSION;
+	index->header.rec_size = sizeof(struct media_index_rec);
+	index->header.top_cluster = plist->folder_info[0]->cur_cluster;
+	index->header.folder_size = sizeof(struct folder_info_t);
+	index->header.max_level = data->max_level;
+	index->header.match_fn = (uint32_t)(uintptr_t)plist->match_fn;
+
+	snprintf(path, sizeof(path), "%s/plist_%08x.idx", CONFIG_FILE_ITERATOR_MEDIA_INDEX_DIR,
+		crc32_ieee((const uint8_t *)plist->topdir, strlen(plist->topdir)));
+
+	if (fs_open(&index->file, path, FS_O_RDWR | FS_O_CREATE)) {
+		SYS_LOG_WRN("media index %s open failed\n", path);
+		index->error = 1;
+		return;
+	}
+
+	media_index_fingerprint(plist, &index->header);
+
+	if (fs_read(&index->file, &header, sizeof(header)) != sizeof(header) ||
+		header.magic != MEDIA_INDEX_MAGIC || header.version != MEDIA_INDEX_VERSION ||
+		header.rec_size != sizeof(struct media_index_rec) ||
+		header.top_cluster != index->header.top_cluster) {
+		/* a blank header, the records are written after it */
+		memset(&header, 0, sizeof(header));
+		if (fs_seek(&index->file, 0, FS_SEEK_SET) ||
+			fs_write(&index->file, &header, sizeof(header)) != sizeof(header)) {
+			SYS_LOG_WRN("media index %s write failed\n", path);
+			index->error = 1;
+		}
+		index->dirty = 1;
+		return;
+	}
+
+	index->count = header.file_count;
+	index->folder_count = header.folder_count;
+	index->unchanged = (index->header.blocks != 0 &&
+		header.folder_size == index->header.folder_size &&
+		header.max_level == index->header.max_level &&
+		header.match_fn == index->header.match_fn &&
+		header.blocks == index->header.blocks && header.bfree == index->header.bfree &&
+		header.folder_count > 0 && header.folder_count <= CONFIG_PLIST_SUPPORT_FOLDER_CNT);
+}
+
+static void media_index_begin(struct play_list_t *plist)
+{
+	struct media_index *index = plist->index;
+
+	if (!index || index->error)
+		return;
+
+	index->valid = 0;
+	index->chunk_base = 0;
+	index->chunk_cnt = 0;
+}
+
+static void media_index_add(struct play_list_t *plist, uint32_t dir_cluster, uint32_t blk_ofs, uint32_t size)
+{
+	struct media_index *index = plist->index;
+	struct media_index_rec *rec;
+
+	if (!index || index->error)
+		return;
+
+	rec = &index->chunk[index->chunk_cnt++];
+	rec->dir_cluster = dir_cluster;
+	rec->blk_ofs = blk_ofs;
+	rec->size = size;
+
+	if (index->chunk_cnt == MEDIA_INDEX_CHUNK)
+		media_index_flush_chunk(index);
+}
+
+static void media_index_end(struct play_list_t *plist)
+{
+	struct media_index *index = plist->index;
+	struct media_index_header *header;
+	int i;
+
+	if (!index || index->error)
+		return;
+
+	media_index_flush_chunk(index);
+	if (index->error)
+		return;
+
+	if (index->dirty || !index->unchanged || index->count != plist->sum_file_count ||
+		index->folder_count != plist->sum_folder_count + 1) {
+		header = &index->header;
+		header->file_count = plist->sum_file_count;
+		header->folder_count = plist->sum_folder_count + 1;
+
+		if (fs_seek(&index->file, MEDIA_INDEX_REC_OFS(plist->sum_file_count), FS_SEEK_SET))
+			goto err_out;
+
+		for (i = 0; i <= plist->sum_folder_count; i++) {
+			if (fs_write(&index->file, plist->folder_info[i], sizeof(struct folder_info_t)) !=
+				sizeof(struct folder_info_t))
+				goto err_out;
+		}
+
+		if (fs_truncate(&index->file, MEDIA_INDEX_REC_OFS(plist->sum_file_count) +
+				header->folder_count * sizeof(struct folder_info_t)) ||
+			fs_sync(&index->file))
+			goto err_out;
+
+		/* the header goes last, after the index may have changed the free clusters */
+		media_index_fingerprint(plist, header);
+
+		if (fs_seek(&index->file, 0, FS_SEEK_SET) ||
+			fs_write(&index->file, header, sizeof(*header)) != sizeof(*header) ||
+			fs_sync(&index->file))
+			goto err_out;
+	}
+
+	SYS_LOG_INF("media index %s, %d tracks\n", index->dirty ? "rebuilt" : "reused",
+		plist->sum_file_count);
+
+	index->count = plist->sum_file_count;
+	index->folder_count = plist->sum_folder_count + 1;
+	index->chunk_base = 0;
+	index->chunk_cnt = 0;
+	index->valid = 1;
+	return;
+
+err_out:
+	SYS_LOG_WRN("media index update failed\n");
+	index->error = 1;
+}
+
+static int media_index_lookup(struct play_list_t *plist, uint16_t track_no, struct media_index_rec *rec)
+{
+	struct media_index *index = plist->index;
+	uint16_t n = track_no - 1;
+
+	if (!index || !index->valid || n >= index->count)
+		return -ENOENT;
+
+	if (n < index->chunk_base || n >= index->chunk_base + index->chunk_cnt) {
+		index->chunk_base = n - n % MEDIA_INDEX_CHUNK;
+		index->chunk_cnt = MIN(MEDIA_INDEX_CHUNK, index->count - index->chunk_base);
+
+		if (media_index_rw(index, index->chunk_base, index->chunk, index->chunk_cnt, false)) {
+			index->chunk_cnt = 0;
+			index->valid = 0;
+			return -EIO;
+		}
+	}
+
+	*rec = index->chunk[n - index->chunk_base];
+	return 0;
+}
+
+/* the last track of the folder is at its recorded offset, and no track follows */
+static int media_index_check_folder(struct play_list_t *plist, struct fs_dir_t *zdp,
+		struct fs_dirent *entry, const struct folder_info_t *folder, uint16_t last_track_no)
+{
+	struct media_index_rec rec = { .dir_cluster = folder->cur_cluster, };
+	int res;
+
+	if (folder->dir_file_count) {
+		res = media_index_lookup(plist, last_track_no, &rec);
+		if (res)
+			return res;
+		if (rec.dir_cluster != folder->cur_cluster)
+			return -ESTALE;
+	}
+
+	memset(zdp, 0, sizeof(struct fs_dir_t));
+	res = fs_opendir_cluster(zdp, plist->topdir, rec.dir_cluster, rec.blk_ofs);
+	if (res)
+		return res;
+
+	if (folder->dir_file_count) {
+		memset(entry, 0, sizeof(struct fs_dirent));
+		res = fs_readdir(zdp, entry);
+		if (!res && (entry->type != FS_DIR_ENTRY_FILE || (uint32_t)entry->size != rec.size))
+			res = -ESTALE;
+	}
+
+	while (!res) {
+		memset(entry, 0, sizeof(struct fs_dirent));
+		res = fs_readdir(zdp, entry);
+		if (res || entry->name[0] == 0)
+			break;
+
+		if (entry->name[0] != '.' && entry->type == FS_DIR_ENTRY_FILE &&
+			(!plist->match_fn || plist->match_fn(entry->name, 0)))
+			res = -ESTALE;
+	}
+
+	fs_closedir(zdp);
+	return res;
+}
+
+static int media_index_check(struct play_list_t *plist)
+{
+	struct fs_dir_t *zdp = mem_malloc(sizeof(struct fs_dir_t));
+	struct fs_dirent *entry = mem_malloc(sizeof(struct fs_dirent));
+	uint16_t track_no = 0;
+	int i, res = -ENOMEM;
+
+	if (!zdp || !entry)
+		goto exit;
+
+	for (i = 0; i <= plist->sum_folder_count; i++) {
+		track_no += plist->folder_info[i]->dir_file_count;
+		res = media_index_check_folder(plist, zdp, entry, plist->folder_info[i], track_no);
+		if (res)
+			break;
+	}
+
+exit:
+	if (zdp)
+		mem_free(zdp);
+	if (entry)
+		mem_free(entry);
+	return res;
+}
+
+/* set the play list position on the track at cluster, blk_ofs and size */
+static void media_index_seek(struct play_list_t *plist, uint32_t cluster, uint32_t blk_ofs, uint32_t size)
+{
+	struct media_index_rec rec;
+	uint16_t track_no = 0;
+	int i, n;
+
+	for (i = 0; i <= plist->sum_folder_count; i++) {
+		if (plist->folder_info[i]->cur_cluster == cluster) {
+			for (n = 1; n <= plist->folder_info[i]->dir_file_count; n++) {
+				if (media_index_lookup(plist, track_no + n, &rec))
+					return;
+
+				if (rec.blk_ofs == blk_ofs && rec.size == size) {
+					plist->file_seq_num = track_no + n;
+					plist->dir_file_seq_num = n;
+					plist->folder_seq_num = i;
+					SYS_LOG_INF("cur file_seq_num=%d,dir_file_seq_num=%d,folder_seq_num=%d\n",
+						plist->file_seq_num, plist->dir_file_seq_num, plist->folder_seq_num);
+					return;
+				}
+			}
+		}
+		track_no += plist->folder_info[i]->dir_file_count;
+	}
+}
+
+/* restore the play list of an unchanged disk from the index, instead of a scan */
+static int media_index_restore(struct play_list_t *plist, struct iterator *iter, const void *param)
+{
+	const struct file_iterator_param *iter_param = (struct file_iterator_param *)param;
+	struct file_iterator_data *data = iter->data;
+	struct folder_info_t topdir_info = *plist->folder_info[0];
+	struct media_index *index;
+	uint32_t cursor_cluster = 0;
+	uint32_t cursor_blk_ofs = 0;
+	uint32_t cursor_file_size = 0;
+	uint16_t file_count = 0;
+	int i, res = -EIO;
+
+	media_index_open(plist, data);
+
+	index = plist->index;
+	if (!index || index->error || !index->unchanged)
+		return -ESTALE;
+
+	/* no cursor scans nothing, a cursor by name is only found by the scan */
+	if (!iter_param->cursor)
+		return -EINVAL;
+	if (iter_param->cursor->path &&
+		get_cursor_info(iter_param->cursor->path, &cursor_cluster, &cursor_blk_ofs, &cursor_file_size))
+		return -EINVAL;
+
+	if (fs_seek(&index->file, MEDIA_INDEX_REC_OFS(index->count), FS_SEEK_SET))
+		goto err_out;
+
+	for (i = 0; i < index->folder_count; i++) {
+		if (fs_read(&index->file, plist->folder_info[i], sizeof(struct folder_info_t)) !=
+			sizeof(struct folder_info_t))
+			goto err_out;
+		file_count += plist->folder_info[i]->dir_file_count;
+	}
+
+	if (file_count != index->count || plist->folder_info[0]->cur_cluster != topdir_info.cur_cluster)
+		goto err_out;
+
+	plist->sum_file_count = index->count;
+	plist->sum_folder_count = index->folder_count - 1;
+	index->valid = 1;
+
+	res = media_index_check(plist);
+	if (res) {
+		SYS_LOG_INF("media index outdated (%d), scan disk\n", res);
+		goto err_out;
+	}
+
+	if (iter_param->cursor->path)
+		media_index_seek(plist, cursor_cluster, cursor_blk_ofs, cursor_file_size);
+
+	iter->cursor = NULL;
+	data->has_query_prev = 0;
+
+	SYS_LOG_INF("media index restored, %d tracks\n", plist->sum_file_count);
+	return 0;
+
+err_out:
+	*plist->folder_info[0] = topdir_info;
+	plist->sum_file_count = 0;
+	plist->sum_folder_count = 0;
+	index->valid = 0;
+	index->unchanged = 0;
+	return res ? res : -EIO;
+}
+
+static void media_index_destroy(struct play_list_t *plist)
+{
+	if (plist->index) {
+		fs_close(&plist->index->file);
+		mem_free(plist->index);
+		plist->index = NULL;
+	}
+}
+#endif /* CONFIG_FILE_ITERATOR_MEDIA_INDEX */
+
 static int file_iterator_get_plist_info(struct iterator *iter, void *param)
 {
 	*(uint16_t *)param = play_list->sum_file_count;
@@ -104,6 +584,9 @@ static int file_iterator_destroy(struct iterator *iter)
 				play_list->folder_info[i] = NULL;
 			}
 		}
+#ifdef CONFIG_FILE_ITERATOR_MEDIA_INDEX
+		media_index_destroy(play_list);
+#endif
 		mem_free(play_list);
 		play_list = NULL;
 	}
@@ -218,6 +701,66 @@ static void calc_next_folder_playlist_info(struct play_list_t *plist, uint8_t ad
 			plist->folder_info[plist->folder_seq_num]->cur_cluster);
 	}
 }
+
+/* read the dir entry of the current track, and its offset in the folder */
+static int file_entry_get(struct play_list_t *plist, struct fs_dir_t *zdp,
+		struct fs_dirent *entry, uint32_t *blk_ofs)
+{
+	uint32_t cluster = plist->folder_info[plist->folder_seq_num]->cur_cluster;
+	uint16_t times = 0;
+	DIR* dp = NULL;
+	int res;
+
+#ifdef CONFIG_FILE_ITERATOR_MEDIA_INDEX
+	struct media_index_rec rec;
+
+	if (!media_index_lookup(plist, plist->file_seq_num, &rec)) {
+		res = fs_opendir_cluster(zdp, plist->topdir, rec.dir_cluster, rec.blk_ofs);
+		if (!res) {
+			dp = zdp->dirp;
+			memset(entry, 0, sizeof(struct fs_dirent));
+			res = fs_readdir(zdp, entry);
+			*blk_ofs = dp->blk_ofs;
+			fs_closedir(zdp);
+
+			if (!res && rec.dir_cluster == cluster && entry->type == FS_DIR_ENTRY_FILE &&
+				(uint32_t)entry->size == rec.size)
+				return 0;
+		}
+
+		/* disk changed behind the index, count entries until the next scan */
+		SYS_LOG_WRN("media index stale at track %d\n", plist->file_seq_num);
+		media_index_invalidate(plist->index);
+		memset(zdp, 0, sizeof(struct fs_dir_t));
+	}
+#endif
+
+	res = fs_opendir_cluster(zdp, plist->topdir, cluster, 0);
+	if (res) {
+		SYS_LOG_ERR("fs_opendir failed (res=%d)\n", res);
+		fs_closedir(zdp);
+		return res;
+	}
+
+	dp = zdp->dirp;
+	do {
+		memset(entry, 0, sizeof(struct fs_dirent));
+		res = fs_readdir(zdp, entry);
+		if (res || entry->name[0] == 0) {
+			SYS_LOG_ERR("fs_readdir failed (res=%d), skip this\n", res);
+			fs_closedir(zdp);
+			return res ? res : -ENOENT;
+		}
+		/* filter out unmatch directory or file */
+		if (plist->match_fn && entry->type == FS_DIR_ENTRY_FILE && plist->match_fn(entry->name, 0))
+			times++;
+	} while (times < plist->dir_file_seq_num);
+
+	*blk_ofs = dp->blk_ofs;
+	fs_closedir(zdp);
+	return 0;
+}
+
 //source:SN60~B.MP3/SNA0~ROOTDI~1/,dest=SD:
 //SD:SNA0~ROOTDI~1/SN60~B.MP3
 #if CONFIG_SUPPORT_FILE_FULL_NAME
@@ -245,7 +788,7 @@ static int file_dirname_get(struct play_list_t *plist, struct iterator *iter)
 {
 	struct file_iterator_data *data = iter->data;
 	int res = -ENOENT;
-	uint16_t times = 0;
+	uint32_t blk_ofs;
 	uint8_t i = 0;
 	uint8_t temp_folder_seq = 0;
 	char *path_buff = mem_malloc(FULL_PATH_LEN);
@@ -256,29 +799,13 @@ static int file_dirname_get(struct play_list_t *plist, struct iterator *iter)
 		goto exit;
 
 	/*read file name*/
-	res = fs_opendir_cluster(zdp, plist->topdir, plist->folder_info[plist->folder_seq_num]->cur_cluster, 0);
-	if (!res) {
-		do {
-			memset(entry, 0, sizeof(struct fs_dirent));
-			res = fs_readdir(zdp, entry);
-			if (res || entry->name[0] == 0) {
-				SYS_LOG_ERR("fs_readdir failed (res=%d), skip this\n", res);
-				fs_closedir(zdp);
-				goto exit;
-			}
-			/* filter out unmatch directory or file */
-			if (plist->match_fn && entry->type == FS_DIR_ENTRY_FILE && plist->match_fn(entry->name, 0))
-				times++;
-		} while (times < plist->dir_file_seq_num);
-		strcpy(path_buff + strlen(path_buff), entry->name);
-		path_buff[strlen(path_buff)] = '/';
-		SYS_LOG_DBG("file name:%s\n",path_buff);
-		fs_closedir(zdp);
-	} else {
-		SYS_LOG_ERR("fs_opendir failed (res=%d)\n", res);
-		fs_closedir(zdp);
+	res = file_entry_get(plist, zdp, entry, &blk_ofs);
+	if (res)
 		goto exit;
-	}
+
+	strcpy(path_buff + strlen(path_buff), entry->name);
+	path_buff[strlen(path_buff)] = '/';
+	SYS_LOG_DBG("file name:%s\n",path_buff);
 
 	/*gets all parent directory names*/
 	temp_folder_seq = plist->folder_seq_num;
@@ -366,8 +893,7 @@ static int file_dirname_get(struct play_list_t *plist, struct iterator *iter)
 {
 	struct file_iterator_data *data = iter->data;
 	int res = -ENOENT;
-	uint16_t times = 0;
-	DIR* dp = NULL;
+	uint32_t blk_ofs;
 	char *file_format = NULL;
 	struct fs_dir_t *zdp = mem_malloc(sizeof(struct fs_dir_t));
 	struct fs_dirent *entry = mem_malloc(sizeof(struct fs_dirent));
@@ -376,34 +902,17 @@ static int file_dirname_get(struct play_list_t *plist, struct iterator *iter)
 		goto exit;
 
 	/*read file name*/
-	res = fs_opendir_cluster(zdp, plist->topdir, plist->folder_info[plist->folder_seq_num]->cur_cluster, 0);
-	dp = zdp->dirp;
-	if (!res) {
-		do {
-			memset(entry, 0, sizeof(struct fs_dirent));
-			res = fs_readdir(zdp, entry);
-			if (res || entry->name[0] == 0) {
-				SYS_LOG_ERR("fs_readdir failed (res=%d), skip this\n", res);
-				fs_closedir(zdp);
-				goto exit;
-			}
-			/* filter out unmatch directory or file */
-			if (plist->match_fn && entry->type == FS_DIR_ENTRY_FILE && plist->match_fn(entry->name, 0))
-				times++;
-		} while (times < plist->dir_file_seq_num);
-		SYS_LOG_INF("file name:%s\n", entry->name);
-		fs_closedir(zdp);
-	} else {
-		SYS_LOG_ERR("fs_opendir failed (res=%d)\n", res);
-		fs_closedir(zdp);
+	res = file_entry_get(plist, zdp, entry, &blk_ofs);
+	if (res)
 		goto exit;
-	}
+
+	SYS_LOG_INF("file name:%s\n", entry->name);
 	/* get file format */
 	_file_format_get(entry->name, &file_format);
 	/*get file path*/
 	memset(data->full_path, 0, FULL_PATH_LEN);
 	snprintf(data->full_path, FULL_PATH_LEN, "%s%s/%s%u/%lu/%u/%s", OPEN_MODE, plist->topdir, CLUSTER,
-		plist->folder_info[plist->folder_seq_num]->cur_cluster, dp->blk_ofs, entry->size, entry->name);
+		plist->folder_info[plist->folder_seq_num]->cur_cluster, blk_ofs, entry->size, entry->name);
 
 	data->cursor.path = data->full_path;
 	iter->cursor = &data->cursor;
@@ -885,6 +1394,9 @@ static const char *file_iterator_scan_disk(struct play_list_t *plist, struct ite
 		if (data->dirent->type == FS_DIR_ENTRY_FILE && is_file_type) {
 			plist->folder_info[plist->sum_folder_count]->dir_file_count++;
 			plist->sum_file_count++;
+#ifdef CONFIG_FILE_ITERATOR_MEDIA_INDEX
+			media_index_add(plist, temp_cluster, dp->blk_ofs, (uint32_t)data->dirent->size);
+#endif
 
 			/*set cursor*/
 			if (cursor && cursor->path && 
@@ -967,14 +1479,25 @@ static int file_iterator_update_playlist(struct play_list_t *plist, struct itera
 
 	file_iterator_playlist_init(plist, data, param);
 
+#ifdef CONFIG_FILE_ITERATOR_MEDIA_INDEX
+	if (!media_index_restore(plist, iter, param))
+		return 0;
+#endif
+
 	res = _back_to_topdir(data);
 	if (res)
 		return res;
 	/* scan disk to update playlist */
 #if CONFIG_SYS_LOG_DEFAULT_LEVEL >= 3
 	uint32_t begin = k_cycle_get_32();
+#endif
+#ifdef CONFIG_FILE_ITERATOR_MEDIA_INDEX
+	media_index_begin(plist);
 #endif
 	file_iterator_scan_disk(plist, iter, param);
+#ifdef CONFIG_FILE_ITERATOR_MEDIA_INDEX
+	media_index_end(plist);
+#endif
 #if CONFIG_SYS_LOG_DEFAULT_LEVEL >= 3
 	SYS_LOG_INF("scan disk case %u us \n", (k_cycle_get_32() - begin)/24);
 #endif
@@ -1167,6 +1690,9 @@ err_out:
 				play_list->folder_info[i] = NULL;
 			}
 		}
+#ifdef CONFIG_FILE_ITERATOR_MEDIA_INDEX
+		media_index_destroy(play_list);
+#endif
 
 		mem_free(play_list);
 		play_list = NULL;
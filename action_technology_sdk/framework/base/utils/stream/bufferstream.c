@@ -150,6 +150,94 @@ int buffer_stream_write(io_stream_t handle, unsigned char * buf, int num)
 	return wirte_len;
 }
 
+/* contiguous readable length at the read offset, called with lock held */
+static int _buffer_stream_read_len(io_stream_t handle, buffer_info_t *info, int *file_off)
+{
+	if ((handle->mode & MODE_IN_OUT) == MODE_IN_OUT) {
+		*file_off = handle->rofs % info->length;
+		return MIN(info->length - *file_off, handle->wofs - handle->rofs);
+	}
+
+	*file_off = handle->rofs;
+	return info->length - handle->rofs;
+}
+
+int buffer_stream_read_claim(io_stream_t handle, unsigned char **buf, int num)
+{
+	int len = 0;
+	int file_off = 0;
+	buffer_info_t *info = (buffer_info_t *)handle->data;
+
+	assert(info);
+
+	os_mutex_lock(&info->lock, OS_FOREVER);
+
+	len = _buffer_stream_read_len(handle, info, &file_off);
+
+	*buf = (unsigned char *)info->buffer_base + file_off;
+
+	os_mutex_unlock(&info->lock);
+	return MIN(num, len);
+}
+
+int buffer_stream_read_commit(io_stream_t handle, int num)
+{
+	int file_off = 0;
+	buffer_info_t *info = (buffer_info_t *)handle->data;
+
+	assert(info);
+
+	os_mutex_lock(&info->lock, OS_FOREVER);
+
+	/** commit no more than a claim could return */
+	if (num < 0 || num > _buffer_stream_read_len(handle, info, &file_off)) {
+		os_mutex_unlock(&info->lock);
+		return -EINVAL;
+	}
+
+	handle->rofs += num;
+	os_mutex_unlock(&info->lock);
+
+	return 0;
+}
+
+int buffer_stream_write_claim(io_stream_t handle, unsigned char **buf, int num)
+{
+	int len = 0;
+	int file_off = 0;
+	buffer_info_t *info = (buffer_info_t *)handle->data;
+
+	assert(info);
+
+	os_mutex_lock(&info->lock, OS_FOREVER);
+
+	file_off = handle->wofs % info->length;
+	len = info->length - file_off;
+
+	/** do not claim unread data */
+	if ((handle->mode & MODE_IN_OUT) == MODE_IN_OUT) {
+		len = MIN(len, info->length - (int)(handle->wofs - handle->rofs));
+	}
+
+	*buf = (unsigned char *)info->buffer_base + file_off;
+
+	os_mutex_unlock(&info->lock);
+	return MIN(num, len);
+}
+
+int buffer_stream_write_commit(io_stream_t handle, int num)
+{
+	buffer_info_t *info = (buffer_info_t *)handle->data;
+
+	assert(info);
+
+	os_mutex_lock(&info->lock, OS_FOREVER);
+	handle->wofs += num;
+	os_mutex_unlock(&info->lock);
+
+	return 0;
+}
+
 int buffer_stream_close(io_stream_t handle)
 {
 	int res;
@@ -217,6 +305,10 @@ const stream_ops_t buffer_stream_ops = {
     .write = buffer_stream_write,
     .close = buffer_stream_close,
 	.destroy = buffer_stream_destory,
+	.read_claim = buffer_stream_read_claim,
+	.read_commit = buffer_stream_read_commit,
+	.write_claim = buffer_stream_write_claim,
+	.write_commit = buffer_stream_write_commit,
 };
 
 io_stream_t buffer_stream_create(struct buffer_t *param)
@@ -114,6 +114,60 @@ static int clone_stream_write(io_stream_t handle, unsigned char *buf,int num)
 	return len;
 }
 
+static int clone_stream_read_claim(io_stream_t handle, unsigned char **buf, int num)
+{
+	struct clone_stream_info *info = handle->data;
+
+	return stream_read_claim(info->origin, (void **)buf, num);
+}
+
+static int clone_stream_read_commit(io_stream_t handle, int num)
+{
+	struct clone_stream_info *info = handle->data;
+	int i;
+
+	/* clone straight from the claimed region of origin */
+	if ((num > 0) && (handle->mode & info->clone_mode)) {
+		for (i = 0; i < ARRAY_SIZE(info->clones); i++) {
+			if (!info->clones[i])
+				break;
+
+			info->clones[i]->ops->write(info->clones[i], handle->read_claim_buf, num);
+		}
+	}
+
+	return stream_read_commit(info->origin, num);
+}
+
+static int clone_stream_write_claim(io_stream_t handle, unsigned char **buf, int num)
+{
+	struct clone_stream_info *info = handle->data;
+
+	return stream_write_claim(info->origin, (void **)buf, num);
+}
+
+static int clone_stream_write_commit(io_stream_t handle, int num)
+{
+	struct clone_stream_info *info = handle->data;
+	int len, i;
+
+	len = stream_write_commit(info->origin, num);
+	if (len <= 0)
+		return len;
+
+	/* clone straight from the committed region of origin */
+	if (handle->mode & info->clone_mode) {
+		for (i = 0; i < ARRAY_SIZE(info->clones); i++) {
+			if (!info->clones[i])
+				break;
+
+			info->clones[i]->ops->write(info->clones[i], handle->write_claim_buf, len);
+		}
+	}
+
+	return len;
+}
+
 static int clone_stream_seek(io_stream_t handle, int offset, seek_dir origin)
 {
 	/* FIXME: seek ops will make clone stream data disordered */
@@ -193,6 +247,10 @@ const stream_ops_t clone_stream_ops = {
 	.flush = clone_stream_flush,
 	.close = clone_stream_close,
 	.destroy = clone_stream_destroy,
+	.read_claim = clone_stream_read_claim,
+	.read_commit = clone_stream_read_commit,
+	.write_claim = clone_stream_write_claim,
+	.write_commit = clone_stream_write_commit,
 };
 
 io_stream_t clone_stream_create(struct clone_stream_info *info)
@@ -101,11 +101,162 @@ int stream_open(io_stream_t handle, stream_mode mode)
 	return res;
 }
 
-int stream_read(io_stream_t handle, void *buf, int num)
+/*
+ * Wait until num bytes of data (for_read) or space are available. The waiter
+ * records the length so the other side only wakes it once it is reached,
+ * the timeout only covers peers accessing the buffer behind the stream api.
+ *
+ * return 0 if available, 1 if timed out, < 0 if stream closed.
+ */
+static int _stream_wait(io_stream_t handle, int num, bool for_read)
+{
+	int try_cnt = 0;
+	int res = 0;
+
+	if (for_read) {
+		handle->read_wait = num;
+	} else {
+		handle->write_wait = num;
+	}
+
+	while ((for_read ? stream_get_length(handle) : stream_get_space(handle)) < num) {
+		if ((handle->mode & MODE_BLOCK_TIMEOUT)) {
+			if (try_cnt ++ > 20) {
+				SYS_LOG_INF("time out 1s");
+				handle->write_finished = 1;
+				res = 1;
+				break;
+			}
+		}
+		os_sem_take(handle->sync_sem, 50);
+		if(!_stream_check_handle_state(handle,STATE_OPEN)) {
+			res = -ENOSYS;
+			break;
+		}
+		if (for_read && handle->write_finished) {
+			break;
+		}
+	}
+
+	if (for_read) {
+		handle->read_wait = 0;
+	} else {
+		handle->write_wait = 0;
+	}
+
+	return res;
+}
+
+/*
+ * wake the blocked reader or writer once the length it waits for is reached,
+ * nobody waiting is not given a wakeup it would take as a spurious one later
+ */
+static void _stream_wakeup(io_stream_t handle)
+{
+	if (!handle->sync_sem || (!handle->read_wait && !handle->write_wait))
+		return;
+
+	if (handle->read_wait && !handle->write_finished
+		&& stream_get_length(handle) < handle->read_wait)
+		return;
+
+	if (handle->write_wait && stream_get_space(handle) < handle->write_wait)
+		return;
+
+	os_sem_give(handle->sync_sem);
+}
+
+static int _stream_write_attached(io_stream_t handle, int attach_mode, const void *buf, int num)
 {
 	int i;
+	int brw = num;
+
+	if (!os_is_in_isr()) {
+		os_mutex_lock(&handle->attach_lock, OS_FOREVER);
+	}
+
+	for (i = 0; i < ARRAY_SIZE(handle->attach_stream); i++) {
+		if (handle->attach_mode[i] != attach_mode)
+			continue;
+
+		if (!handle->attach_stream[i])
+			continue;
+
+		brw = handle->attach_stream[i]->ops->write(handle->attach_stream[i], (void *)buf, num);
+		if (brw != num)
+			break;
+
+		_stream_wakeup(handle->attach_stream[i]);
+	}
+
+	if (!os_is_in_isr()) {
+		os_mutex_unlock(&handle->attach_lock);
+	}
+
+	return brw;
+}
+
+static bool _stream_has_attached(io_stream_t handle, int attach_mode)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(handle->attach_stream); i++) {
+		if (handle->attach_stream[i] && (handle->attach_mode[i] == attach_mode))
+			return true;
+	}
+
+	return false;
+}
+
+/*
+ * Read through the claim ops, so attached streams are fed by reference from
+ * the region of the origin, in two parts if it wraps, with only the bytes
+ * really read. teed is less than the return if an attached stream is full.
+ */
+static int _stream_read_tee(io_stream_t handle, unsigned char *buf, int num, int *teed)
+{
+	unsigned char *data;
+	int brw = 0;
+	int len, res;
+
+	*teed = 0;
+	while (brw < num) {
+		len = handle->ops->read_claim(handle, &data, num - brw);
+		if (len <= 0)
+			break;
+
+		memcpy(buf + brw, data, len);
+		res = _stream_write_attached(handle, MODE_IN, data, len);
+		*teed += MAX(res, 0);
+
+		handle->read_claim_buf = data;
+		handle->ops->read_commit(handle, len);
+		handle->read_claim_buf = NULL;
+
+		brw += len;
+		if (res != len)
+			break;
+	}
+
+	return brw;
+}
+
+static void _stream_notify(io_stream_t handle, const void *buf, int num, stream_notify_type type)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(handle->observer_notify); i++) {
+		if (handle->observer_notify[i] && (handle->observer_type[i] & type)) {
+			handle->observer_notify[i](handle->observer[i], handle->rofs,
+				handle->wofs, handle->total_size, (void *)buf, num, type);
+		}
+	}
+}
+
+int stream_read(io_stream_t handle, void *buf, int num)
+{
 	int brw;
-	int try_cnt = 0;
+	int res;
 
 	if (!_stream_check_handle_state(handle,STATE_OPEN)) {
 		return -ENOSYS;
@@ -116,24 +267,29 @@ int stream_read(io_stream_t handle, void *buf, int num)
 	}
 
 	if ((handle->mode & MODE_READ_BLOCK)) {
-		while (stream_get_length(handle) < num) {
-			if((handle->mode & MODE_BLOCK_TIMEOUT)){
-				if (try_cnt ++ > 20) {
-					SYS_LOG_INF("time out 1s");
-					handle->write_finished = 1;
-					return 0;
-				}
-			}
-			os_sem_take(handle->sync_sem, 50);
-			if(!_stream_check_handle_state(handle,STATE_OPEN)) {
-				return -ENOSYS;
-			}
-			if (handle->write_finished) {
-				break;
-			}
+		res = _stream_wait(handle, num, true);
+		if (res) {
+			return (res < 0) ? res : 0;
 		}
 	}
 
+	/**
+	 * data read to attached stream, from the region of origin if it can be
+	 * claimed, a short read is left to ops->read as each stream has its way
+	 */
+	if (handle->ops->read_claim && handle->ops->read_commit
+		&& !handle->read_claim_buf && _stream_has_attached(handle, MODE_IN)
+		&& stream_get_length(handle) >= num) {
+		brw = _stream_read_tee(handle, buf, num, &res);
+		_stream_wakeup(handle);
+		if (res != brw) {
+			return res;
+		}
+
+		_stream_notify(handle, buf, brw, STREAM_NOTIFY_READ);
+		return brw;
+	}
+
 	brw = handle->ops->read(handle, buf, num);
 	if (brw < 0) {
 		SYS_LOG_DBG("read failed [%d]\n", brw);
@@ -141,42 +297,81 @@ int stream_read(io_stream_t handle, void *buf, int num)
 		return brw;
 	}
 
-	if (handle->sync_sem) {
-		os_sem_give(handle->sync_sem);
+	_stream_wakeup(handle);
+
+	res = _stream_write_attached(handle, MODE_IN, buf, brw);
+	if (res != brw) {
+		return res;
 	}
 
-	if (!os_is_in_isr()) {
-		os_mutex_lock(&handle->attach_lock, OS_FOREVER);
+	_stream_notify(handle, buf, brw, STREAM_NOTIFY_READ);
+
+	return brw;
+}
+
+int stream_read_claim(io_stream_t handle, void **buf, int num)
+{
+	int brw;
+	int res;
+
+	if (!_stream_check_handle_state(handle,STATE_OPEN)) {
+		return -ENOSYS;
 	}
 
-	/**data read to attached stream */
-	for (i = 0; i < ARRAY_SIZE(handle->attach_stream); i++) {
-		if (handle->attach_mode[i] != MODE_IN)
-			continue;
+	if (!(handle->mode & MODE_IN)) {
+		return -EPERM;
+	}
 
-		if (!handle->attach_stream[i])
-			continue;
+	if (!handle->ops->read_claim || !handle->ops->read_commit) {
+		return -ENOTSUP;
+	}
 
-		brw = handle->attach_stream[i]->ops->write(handle->attach_stream[i], buf, num);
-		if (brw != num) {
-			if (!os_is_in_isr()) {
-				os_mutex_unlock(&handle->attach_lock);
-			}
-			return brw;
+	if ((handle->mode & MODE_READ_BLOCK)) {
+		res = _stream_wait(handle, num, true);
+		if (res) {
+			return (res < 0) ? res : 0;
 		}
 	}
 
-	if (!os_is_in_isr()) {
-		os_mutex_unlock(&handle->attach_lock);
+	brw = handle->ops->read_claim(handle, (unsigned char **)buf, num);
+	if (brw <= 0) {
+		return brw;
 	}
 
-	for (i = 0; i < ARRAY_SIZE(handle->observer_notify); i++) {
-		if (handle->observer_notify[i] && (handle->observer_type[i] & STREAM_NOTIFY_READ)) {
-			handle->observer_notify[i](handle->observer[i], handle->rofs,
-				handle->wofs, handle->total_size, buf, brw, STREAM_NOTIFY_READ);
+	handle->read_claim_buf = *buf;
+	return brw;
+}
+
+int stream_read_commit(io_stream_t handle, int num)
+{
+	unsigned char *buf = handle->read_claim_buf;
+	int brw = num;
+	int res;
+
+	if (!_stream_check_handle_state(handle,STATE_OPEN)) {
+		return -ENOSYS;
+	}
+
+	if (!buf) {
+		return -EINVAL;
+	}
+
+	/**tee and notify from claimed region before it is released */
+	if (num > 0) {
+		brw = _stream_write_attached(handle, MODE_IN, buf, num);
+		if (brw == num) {
+			_stream_notify(handle, buf, num, STREAM_NOTIFY_READ);
 		}
 	}
 
+	res = handle->ops->read_commit(handle, num);
+	handle->read_claim_buf = NULL;
+	if (res < 0) {
+		SYS_LOG_ERR("commit failed [%d]\n", res);
+		return res;
+	}
+
+	_stream_wakeup(handle);
 	return brw;
 }
 
@@ -262,8 +457,7 @@ int stream_tell(io_stream_t handle)
 int stream_write(io_stream_t handle, const void *buf, int num)
 {
 	int brw;
-	int i;
-	int try_cnt = 0;
+	int res;
 
 	if (!_stream_check_handle_state(handle,STATE_OPEN)) {
 		return -ENOSYS;
@@ -274,27 +468,13 @@ int stream_write(io_stream_t handle, const void *buf, int num)
 	}
 
 	if ((handle->mode & MODE_WRITE_BLOCK)) {
-		while (stream_get_space(handle) < num) {
-			if ((handle->mode & MODE_BLOCK_TIMEOUT)) {
-				if (try_cnt ++ > 20) {
-					SYS_LOG_INF("time out 1s");
-					handle->write_finished = 1;
-					return 0;
-				}
-			}
-			os_sem_take(handle->sync_sem, 50);
-			if(!_stream_check_handle_state(handle,STATE_OPEN)) {
-				return -ENOSYS;
-			}
+		res = _stream_wait(handle, num, false);
+		if (res) {
+			return (res < 0) ? res : 0;
 		}
 	}
 
-	for (i = 0; i < ARRAY_SIZE(handle->observer_notify); i++) {
-		if (handle->observer_notify[i] && (handle->observer_type[i] & STREAM_NOTIFY_PRE_WRITE)) {
-			handle->observer_notify[i](handle->observer[i], handle->rofs,
-				handle->wofs, handle->total_size, (void *)buf, num, STREAM_NOTIFY_PRE_WRITE);
-		}
-	}
+	_stream_notify(handle, buf, num, STREAM_NOTIFY_PRE_WRITE);
 
 	brw = handle->ops->write(handle, (void *)buf, num);
 	if (brw != num) {
@@ -306,41 +486,93 @@ int stream_write(io_stream_t handle, const void *buf, int num)
 		handle->write_finished = 1;
 	}
 
-	if (handle->sync_sem)
-		os_sem_give(handle->sync_sem);
+	_stream_wakeup(handle);
 
+	/**data write to attached stream */
+	brw = _stream_write_attached(handle, MODE_OUT, buf, num);
+	if (brw != num) {
+		return brw;
+	}
 
-	if (!os_is_in_isr()) {
-		os_mutex_lock(&handle->attach_lock, OS_FOREVER);
+	_stream_notify(handle, buf, num, STREAM_NOTIFY_WRITE);
+	return brw;
+}
+
+int stream_write_claim(io_stream_t handle, void **buf, int num)
+{
+	int brw;
+	int res;
+
+	if (!_stream_check_handle_state(handle,STATE_OPEN)) {
+		return -ENOSYS;
 	}
 
-	/**data write to attached stream */
-	for (i = 0; i < ARRAY_SIZE(handle->attach_stream); i++) {
-		if (handle->attach_mode[i] != MODE_OUT)
-			continue;
+	if (!(handle->mode & MODE_OUT)) {
+		return -EPERM;
+	}
 
-		if (!handle->attach_stream[i])
-			continue;
+	if (!handle->ops->write_claim || !handle->ops->write_commit) {
+		return -ENOTSUP;
+	}
 
-		brw = handle->attach_stream[i]->ops->write(handle->attach_stream[i], (void *)buf, num);
-		if (brw != num) {
-			//SYS_LOG_ERR("Failed writing to stream [%d]\n", brw);
-			if (!os_is_in_isr()) {
-				os_mutex_unlock(&handle->attach_lock);
-			}
-			return brw;
+	if ((handle->mode & MODE_WRITE_BLOCK)) {
+		res = _stream_wait(handle, num, false);
+		if (res) {
+			return (res < 0) ? res : 0;
 		}
 	}
 
-	if (!os_is_in_isr()) {
-		os_mutex_unlock(&handle->attach_lock);
+	brw = handle->ops->write_claim(handle, (unsigned char **)buf, num);
+	if (brw <= 0) {
+		return brw;
 	}
-	for (i = 0; i < ARRAY_SIZE(handle->observer_notify); i++) {
-		if (handle->observer_notify[i] && (handle->observer_type[i] & STREAM_NOTIFY_WRITE)) {
-			handle->observer_notify[i](handle->observer[i], handle->rofs,
-				handle->wofs, handle->total_size, (void *)buf, num, STREAM_NOTIFY_WRITE);
-		}
+
+	/**attached streams may have less space */
+	res = stream_get_space(handle);
+	if (brw > res) {
+		brw = MAX(res, 0);
+	}
+
+	handle->write_claim_buf = *buf;
+	return brw;
+}
+
+int stream_write_commit(io_stream_t handle, int num)
+{
+	unsigned char *buf = handle->write_claim_buf;
+	int brw;
+
+	if (!_stream_check_handle_state(handle,STATE_OPEN)) {
+		return -ENOSYS;
+	}
+
+	if (!buf) {
+		return -EINVAL;
+	}
+
+	if (num <= 0) {
+		handle->write_claim_buf = NULL;
+		return 0;
+	}
+
+	/**pre write observers process claimed region in place */
+	_stream_notify(handle, buf, num, STREAM_NOTIFY_PRE_WRITE);
+
+	brw = handle->ops->write_commit(handle, num);
+	if (brw < 0) {
+		handle->write_claim_buf = NULL;
+		SYS_LOG_ERR("commit failed [%d]\n", brw);
+		return brw;
 	}
+
+	_stream_wakeup(handle);
+
+	brw = _stream_write_attached(handle, MODE_OUT, buf, num);
+	if (brw == num) {
+		_stream_notify(handle, buf, num, STREAM_NOTIFY_WRITE);
+	}
+
+	handle->write_claim_buf = NULL;
 	return brw;
 }
 
@@ -78,6 +78,250 @@ enum {
 };
 
 static struct a2dp_codec_info s_codec_info[A2DP_CODEC_INFO_MAX];
+static uint8_t media_print_cnt;
+
+#ifdef CONFIG_BT_A2DP_JITTER_BUFFER
+#define A2DP_JITTER_SLOTS		CONFIG_BT_A2DP_JITTER_BUFFER_SLOTS
+#define A2DP_JITTER_PKT_SIZE	CONFIG_BT_A2DP_JITTER_BUFFER_PKT_SIZE
+/* slot of a sequence number, stays consistent across the 16 bits wrap */
+#define A2DP_JITTER_SLOT(seq)	(&a2dp_jitter.slot[(seq) & (A2DP_JITTER_SLOTS - 1)])
+
+BUILD_ASSERT((A2DP_JITTER_SLOTS & (A2DP_JITTER_SLOTS - 1)) == 0,
+	"a2dp jitter buffer slots must be a power of two");
+/* in order packets before the target depth is lowered again */
+#define A2DP_JITTER_SHRINK_CNT	512
+/* sequence jump handled as stream restart instead of loss */
+#define A2DP_JITTER_RESYNC_GAP	64
+
+/* same layout as struct avdtp_data_header_t packed by bt service */
+struct a2dp_media_head {
+	uint16_t frame_cnt;
+	uint16_t seq_no;
+	uint16_t frame_len;
+	uint16_t padding_len;
+} __packed;
+
+struct a2dp_jitter_slot {
+	uint16_t size;		/* 0: empty */
+	uint16_t seq_no;
+	uint8_t data[A2DP_JITTER_PKT_SIZE];
+};
+
+struct a2dp_jitter_buffer {
+	struct a2dp_jitter_slot slot[A2DP_JITTER_SLOTS];
+	uint8_t conceal_buf[A2DP_JITTER_PKT_SIZE];
+	struct a2dp_codec_info *codec;	/* codec of the held stream */
+	uint32_t history;	/* bit n: seq (next_seq - 1 - n) delivered from a received packet */
+	uint16_t next_seq;
+	uint16_t last_frame_cnt;
+	uint16_t in_order_cnt;
+	uint8_t held;
+	uint8_t started;
+	struct bt_a2dp_jitter_stat stat;
+};
+
+static struct a2dp_jitter_buffer a2dp_jitter;
+#endif
+
+static int _bt_manager_a2dp_write_media(io_stream_t bt_stream, void *packet, int size)
+{
+	int ret;
+
+	if (stream_get_space(bt_stream) < size) {
+		if (media_print_cnt == 0) {
+			SYS_LOG_WRN(" stream is full\n");
+		}
+		media_print_cnt++;
+		return -ENOSPC;
+	}
+
+	ret = stream_write(bt_stream, packet, size);
+	if (ret != size) {
+		if (media_print_cnt == 0) {
+			SYS_LOG_WRN("write %d error %d\n", size, ret);
+		}
+		media_print_cnt++;
+		return -EIO;
+	}
+
+	media_print_cnt = 0;
+	return 0;
+}
+
+#ifdef CONFIG_BT_A2DP_JITTER_BUFFER
+static struct a2dp_codec_info *_a2dp_get_codec_info(uint16_t hdl)
+{
+	if (bt_mgr_check_dev_type(BTSRV_DEVICE_PLAYER, hdl)) {
+		return &s_codec_info[A2DP_CODEC_INFO_TRS];
+	}
+
+	return &s_codec_info[A2DP_CODEC_INFO_PHONE];
+}
+
+static void _a2dp_jitter_reset(void)
+{
+	for (int i = 0; i < A2DP_JITTER_SLOTS; i++) {
+		a2dp_jitter.slot[i].size = 0;
+	}
+
+	a2dp_jitter.history = 0;
+	a2dp_jitter.in_order_cnt = 0;
+	a2dp_jitter.held = 0;
+	a2dp_jitter.started = 0;
+}
+
+static void _a2dp_jitter_write(io_stream_t bt_stream, void *packet, int size)
+{
+	if (_bt_manager_a2dp_write_media(bt_stream, packet, size)) {
+		a2dp_jitter.stat.overflow++;
+	}
+}
+
+/* replace a lost packet with zero frames of the same play time */
+static void _a2dp_jitter_conceal(io_stream_t bt_stream, uint16_t seq_no)
+{
+	struct a2dp_media_head *head = (struct a2dp_media_head *)a2dp_jitter.conceal_buf;
+	struct a2dp_codec_info *info = a2dp_jitter.codec;
+	uint16_t frame_len = 0, len = 0, frame_cnt = 0;
+	uint8_t *frame;
+
+	frame = btif_a2dp_get_zero_frame(info->codec_id, &frame_len, info->sample_rate);
+	if (!frame || !frame_len) {
+		return;
+	}
+
+	while (frame_cnt < MAX(a2dp_jitter.last_frame_cnt, 1) &&
+		sizeof(*head) + len + frame_len < A2DP_JITTER_PKT_SIZE) {
+		memcpy(&a2dp_jitter.conceal_buf[sizeof(*head) + len], frame, frame_len);
+		len += frame_len;
+		frame_cnt++;
+	}
+
+	if (!frame_cnt) {
+		return;
+	}
+
+	head->frame_cnt = frame_cnt;
+	head->seq_no = seq_no;
+	head->frame_len = len;
+	head->padding_len = len % 2;
+	if (head->padding_len) {
+		a2dp_jitter.conceal_buf[sizeof(*head) + len] = 0;
+	}
+
+	a2dp_jitter.stat.concealed++;
+	_a2dp_jitter_write(bt_stream, head, sizeof(*head) + len + head->padding_len);
+}
+
+/* deliver the packet of next_seq, conceal it if not received */
+static void _a2dp_jitter_release(io_stream_t bt_stream, bool conceal)
+{
+	struct a2dp_jitter_slot *slot = A2DP_JITTER_SLOT(a2dp_jitter.next_seq);
+
+	a2dp_jitter.history <<= 1;
+
+	if (slot->size && slot->seq_no == a2dp_jitter.next_seq) {
+		a2dp_jitter.last_frame_cnt = ((struct a2dp_media_head *)slot->data)->frame_cnt;
+		_a2dp_jitter_write(bt_stream, slot->data, slot->size);
+		slot->size = 0;
+		a2dp_jitter.held--;
+		a2dp_jitter.history |= 1;
+
+		if (++a2dp_jitter.in_order_cnt >= A2DP_JITTER_SHRINK_CNT) {
+			a2dp_jitter.in_order_cnt = 0;
+			if (a2dp_jitter.stat.target_depth > 0) {
+				a2dp_jitter.stat.target_depth--;
+			}
+		}
+	} else {
+		a2dp_jitter.stat.lost++;
+		a2dp_jitter.in_order_cnt = 0;
+		if (conceal) {
+			_a2dp_jitter_conceal(bt_stream, a2dp_jitter.next_seq);
+		}
+	}
+
+	a2dp_jitter.next_seq++;
+}
+
+static void _a2dp_jitter_put(io_stream_t bt_stream, struct a2dp_codec_info *codec,
+				void *packet, int size)
+{
+	struct a2dp_media_head *head = (struct a2dp_media_head *)packet;
+	struct a2dp_jitter_slot *slot;
+	int16_t diff;
+
+	a2dp_jitter.stat.received++;
+	a2dp_jitter.codec = codec;
+
+	if (size < (int)sizeof(*head) || size > A2DP_JITTER_PKT_SIZE) {
+		/* can not be held, deliver in arrival order */
+		_a2dp_jitter_write(bt_stream, packet, size);
+		return;
+	}
+
+	if (!a2dp_jitter.started) {
+		a2dp_jitter.started = 1;
+		a2dp_jitter.next_seq = head->seq_no;
+	}
+
+	diff = (int16_t)(head->seq_no - a2dp_jitter.next_seq);
+	if (diff < 0) {
+		if (-diff <= 32 && (a2dp_jitter.history & (1u << (-diff - 1)))) {
+			a2dp_jitter.stat.duplicate++;
+		} else {
+			/* already concealed, wait longer for holes from now on */
+			a2dp_jitter.stat.late++;
+			if (a2dp_jitter.stat.target_depth < A2DP_JITTER_SLOTS - 1) {
+				a2dp_jitter.stat.target_depth++;
+			}
+		}
+		return;
+	}
+
+	if (diff >= A2DP_JITTER_RESYNC_GAP) {
+		SYS_LOG_INF("a2dp seq jump %d -> %d\n", a2dp_jitter.next_seq, head->seq_no);
+		a2dp_jitter.stat.resync++;
+		while (a2dp_jitter.held > 0) {
+			_a2dp_jitter_release(bt_stream, false);
+		}
+		a2dp_jitter.next_seq = head->seq_no;
+		a2dp_jitter.history = 0;
+		diff = 0;
+	}
+
+	/* out of window, give up the oldest holes */
+	while (diff >= A2DP_JITTER_SLOTS) {
+		_a2dp_jitter_release(bt_stream, true);
+		diff--;
+	}
+
+	slot = A2DP_JITTER_SLOT(head->seq_no);
+	if (slot->size && slot->seq_no == head->seq_no) {
+		a2dp_jitter.stat.duplicate++;
+		return;
+	}
+
+	memcpy(slot->data, packet, size);
+	slot->size = size;
+	slot->seq_no = head->seq_no;
+	a2dp_jitter.held++;
+	if (a2dp_jitter.held > a2dp_jitter.stat.max_depth) {
+		a2dp_jitter.stat.max_depth = a2dp_jitter.held;
+	}
+
+	/* deliver in order packets, conceal a hole once enough packets wait behind it */
+	while (a2dp_jitter.held > 0) {
+		slot = A2DP_JITTER_SLOT(a2dp_jitter.next_seq);
+		if (!(slot->size && slot->seq_no == a2dp_jitter.next_seq) &&
+			a2dp_jitter.held <= a2dp_jitter.stat.target_depth) {
+			break;
+		}
+
+		_a2dp_jitter_release(bt_stream, true);
+	}
+}
+#endif
 
 static void _bt_manager_a2dp_callback(uint16_t hdl, btsrv_a2dp_event_e event, void *packet, int size)
 {
@@ -96,6 +340,9 @@ static void _bt_manager_a2dp_callback(uint16_t hdl, btsrv_a2dp_event_e event, vo
 	case BTSRV_A2DP_STREAM_STARED:
 	{
 		SYS_LOG_INF("stream started\n");
+#ifdef CONFIG_BT_A2DP_JITTER_BUFFER
+		_a2dp_jitter_reset();
+#endif
 		bt_manager_event_notify(BT_A2DP_STREAM_START_EVENT, NULL, 0);
 	}
 	break;
@@ -107,40 +354,27 @@ static void _bt_manager_a2dp_callback(uint16_t hdl, btsrv_a2dp_event_e event, vo
 	break;
 	case BTSRV_A2DP_DATA_INDICATED:
 	{
-		static uint8_t print_cnt;
-		int ret = 0;
-
 		bt_manager_stream_pool_lock();
 		io_stream_t bt_stream = bt_manager_get_stream(STREAM_TYPE_A2DP);
 
 		if (!bt_stream) {
 			bt_manager_stream_pool_unlock();
-			if (print_cnt == 0) {
+			if (media_print_cnt == 0) {
 				SYS_LOG_INF("stream is null\n");
 			}
-			print_cnt++;
-			break;
-		}
-		if (stream_get_space(bt_stream) < size) {
-			bt_manager_stream_pool_unlock();
-			if (print_cnt == 0) {
-				SYS_LOG_WRN(" stream is full\n");
-			}
-			print_cnt++;
+			media_print_cnt++;
+#ifdef CONFIG_BT_A2DP_JITTER_BUFFER
+			_a2dp_jitter_reset();
+#endif
 			break;
 		}
 
-		ret = stream_write(bt_stream, packet, size);
-		if (ret != size) {
-			if (print_cnt == 0) {
-				SYS_LOG_WRN("write %d error %d\n", size, ret);
-			}
-			print_cnt++;
-			bt_manager_stream_pool_unlock();
-			break;
-		}
+#ifdef CONFIG_BT_A2DP_JITTER_BUFFER
+		_a2dp_jitter_put(bt_stream, _a2dp_get_codec_info(hdl), packet, size);
+#else
+		_bt_manager_a2dp_write_media(bt_stream, packet, size);
+#endif
 		bt_manager_stream_pool_unlock();
-		print_cnt = 0;
 		break;
 	}
 	case BTSRV_A2DP_CODEC_INFO:
@@ -224,6 +458,26 @@ int bt_manager_a2dp_send_delay_report(uint16_t delay_time)
 	return btif_a2dp_send_delay_report(delay_time);
 }
 
+int bt_manager_a2dp_get_jitter_stat(struct bt_a2dp_jitter_stat *stat, bool clear)
+{
+#ifdef CONFIG_BT_A2DP_JITTER_BUFFER
+	unsigned int key = irq_lock();
+
+	memcpy(stat, &a2dp_jitter.stat, sizeof(*stat));
+	if (clear) {
+		uint8_t target_depth = a2dp_jitter.stat.target_depth;
+
+		memset(&a2dp_jitter.stat, 0, sizeof(a2dp_jitter.stat));
+		a2dp_jitter.stat.target_depth = target_depth;
+	}
+
+	irq_unlock(key);
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
 int bt_manager_a2dp_disable(void)
 {
 	return btif_a2dp_disable();
@@ -36,42 +36,224 @@ struct bt_manager_hfp_sco_info_t {
 };
 
 static struct bt_manager_hfp_sco_info_t hfp_sco_manager;
+static uint8_t sco_print_cnt;
+
+#ifdef CONFIG_BT_SCO_JITTER_BUFFER
+#define SCO_JITTER_MAX_DEPTH	CONFIG_BT_SCO_JITTER_BUFFER_MAX_DEPTH
+#define SCO_JITTER_PAYLOAD_SIZE	60
+#define SCO_JITTER_FRAME_US		7500
+/* good frames in a row before the target depth is lowered again */
+#define SCO_JITTER_SHRINK_CNT	800
+/* frames above target depth tolerated before an inserted one is trimmed */
+#define SCO_JITTER_TRIM_MARGIN	2
+#define SCO_JITTER_TRIM_CNT		200
+/* frame count jump handled as restart instead of loss */
+#define SCO_JITTER_RESYNC_GAP	16
+
+/* same layout as the media frame packed by bt service sco */
+struct sco_media_head {
+	uint16_t pkg_flag;
+	uint16_t frame_cnt;
+	uint16_t payload_len;
+	uint16_t payload_offset;
+} __packed;
+
+struct sco_jitter_buffer {
+	io_stream_t stream;
+	uint8_t conceal_buf[sizeof(struct sco_media_head) + SCO_JITTER_PAYLOAD_SIZE];
+	uint32_t last_cycle;
+	uint16_t next_cnt;
+	uint16_t good_cnt;
+	uint16_t high_cnt;
+	uint8_t inserted;
+	uint8_t started;
+	struct bt_sco_jitter_stat stat;
+};
+
+static struct sco_jitter_buffer sco_jitter;
+#endif
+
+static int _bt_manager_sco_write_frame(io_stream_t bt_stream, void *frame, int size)
+{
+	int ret;
+
+	if (stream_get_space(bt_stream) < size) {
+		if (sco_print_cnt == 0) {
+			SYS_LOG_WRN("stream is full\n");
+		}
+		sco_print_cnt++;
+		return -ENOSPC;
+	}
+
+	ret = stream_write(bt_stream, frame, size);
+	if (ret != size) {
+		SYS_LOG_WRN("write %d error %d\n", size, ret);
+		return -EIO;
+	}
+
+	sco_print_cnt = 0;
+	return 0;
+}
+
+#ifdef CONFIG_BT_SCO_JITTER_BUFFER
+static void _sco_jitter_write(io_stream_t bt_stream, void *frame, int size)
+{
+	if (_bt_manager_sco_write_frame(bt_stream, frame, size)) {
+		sco_jitter.stat.overflow++;
+	}
+}
+
+/*
+ * Insert a frame flagged bad in place of a missing one, the decoder runs its
+ * packet loss concealment on bad frames the same as for frames the controller
+ * reported in error, so the call timeline stays continuous.
+ */
+static void _sco_jitter_conceal(io_stream_t bt_stream, const struct sco_media_head *ref, uint16_t frame_cnt)
+{
+	struct sco_media_head *head = (struct sco_media_head *)sco_jitter.conceal_buf;
+
+	head->pkg_flag = 1;
+	head->frame_cnt = frame_cnt;
+	head->payload_len = ref->payload_len;
+	head->payload_offset = ref->payload_offset;
+	memset(&sco_jitter.conceal_buf[sizeof(*head)], 0, SCO_JITTER_PAYLOAD_SIZE);
+
+	sco_jitter.stat.concealed++;
+	_sco_jitter_write(bt_stream, head, sizeof(sco_jitter.conceal_buf));
+}
+
+static void _sco_jitter_put(io_stream_t bt_stream, void *frame, int size)
+{
+	struct sco_media_head *head = (struct sco_media_head *)frame;
+	uint32_t cycle = k_cycle_get_32();
+	uint32_t gap_us;
+	int16_t diff;
+	int depth;
+
+	if (sco_jitter.stream != bt_stream) {
+		/* new call stream, statistics are per call */
+		memset(&sco_jitter, 0, sizeof(sco_jitter));
+		sco_jitter.stream = bt_stream;
+	}
+
+	sco_jitter.stat.received++;
+
+	if (size != sizeof(sco_jitter.conceal_buf)) {
+		/* not a packed media frame, deliver as is */
+		_sco_jitter_write(bt_stream, frame, size);
+		return;
+	}
+
+	if (head->pkg_flag) {
+		sco_jitter.stat.bad++;
+	}
+
+	depth = stream_get_length(bt_stream) / size;
+	gap_us = k_cyc_to_us_floor32(cycle - sco_jitter.last_cycle);
+	sco_jitter.last_cycle = cycle;
+
+	if (!sco_jitter.started) {
+		sco_jitter.started = 1;
+		sco_jitter.next_cnt = head->frame_cnt;
+		gap_us = 0;
+	}
+
+	diff = (int16_t)(head->frame_cnt - sco_jitter.next_cnt);
+	if (diff < 0 || diff >= SCO_JITTER_RESYNC_GAP) {
+		diff = 0;
+	}
+
+	/*
+	 * Delayed long enough that the decoder drained the stream, queue more.
+	 * The time of the frames lost in between is not a delay.
+	 */
+	if (depth == 0 && gap_us >= SCO_JITTER_FRAME_US * (diff + 2)) {
+		sco_jitter.stat.late++;
+		sco_jitter.good_cnt = 0;
+		if (sco_jitter.stat.target_depth < SCO_JITTER_MAX_DEPTH) {
+			sco_jitter.stat.target_depth++;
+		}
+	}
+
+	if (diff > 0) {
+		/* the decoder drained the stream in the hole, these are latency */
+		bool drained = (depth == 0);
+
+		sco_jitter.stat.lost += diff;
+		sco_jitter.good_cnt = 0;
+		while (diff-- > 0) {
+			_sco_jitter_conceal(bt_stream, head, sco_jitter.next_cnt++);
+			if (drained && sco_jitter.inserted < UINT8_MAX) {
+				sco_jitter.inserted++;
+			}
+			depth++;
+		}
+	}
+	sco_jitter.next_cnt = head->frame_cnt + 1;
+
+	/* refill to target depth so the next delay does not underrun */
+	while (depth < sco_jitter.stat.target_depth) {
+		_sco_jitter_conceal(bt_stream, head, head->frame_cnt);
+		if (sco_jitter.inserted < UINT8_MAX) {
+			sco_jitter.inserted++;
+		}
+		depth++;
+	}
+
+	/*
+	 * Give back latency this buffer added once the link settles, drop a
+	 * frame, prefer a bad one. Queue depth kept by the media side is left.
+	 */
+	if (sco_jitter.inserted && depth > sco_jitter.stat.target_depth + SCO_JITTER_TRIM_MARGIN) {
+		if (++sco_jitter.high_cnt >= SCO_JITTER_TRIM_CNT && (head->pkg_flag ||
+			sco_jitter.high_cnt >= SCO_JITTER_TRIM_CNT * 2)) {
+			sco_jitter.high_cnt = 0;
+			sco_jitter.inserted--;
+			sco_jitter.stat.trimmed++;
+			return;
+		}
+	} else {
+		sco_jitter.high_cnt = 0;
+	}
+
+	if (!head->pkg_flag && ++sco_jitter.good_cnt >= SCO_JITTER_SHRINK_CNT) {
+		sco_jitter.good_cnt = 0;
+		if (sco_jitter.stat.target_depth > 0) {
+			sco_jitter.stat.target_depth--;
+		}
+	}
+
+	_sco_jitter_write(bt_stream, frame, size);
+
+	if (depth + 1 > sco_jitter.stat.max_depth) {
+		sco_jitter.stat.max_depth = depth + 1;
+	}
+}
+#endif
 
 static void _bt_manager_sco_callback(btsrv_hfp_event_e event, uint8_t *param, int param_size)
 {
 	switch (event) {
 	case BTSRV_SCO_DATA_INDICATED:
 	{
-		int ret = 0;
-		static uint8_t print_cnt = 0;
-
 		bt_manager_stream_pool_lock();
 		io_stream_t bt_stream = bt_manager_get_stream(STREAM_TYPE_SCO);
 
 		if (!bt_stream) {
 			bt_manager_stream_pool_unlock();
-			if (print_cnt == 0) {
+			if (sco_print_cnt == 0) {
 				SYS_LOG_WRN("stream is null\n");
 			}
-			print_cnt++;
-			break;
-		}
-
-		if (stream_get_space(bt_stream) < param_size) {
-			bt_manager_stream_pool_unlock();
-			if (print_cnt == 0) {
-				SYS_LOG_WRN("stream is full\n");
-			}
-			print_cnt++;
+			sco_print_cnt++;
 			break;
 		}
 
-		ret = stream_write(bt_stream, param, param_size);
-		if (ret != param_size) {
-			SYS_LOG_WRN("write %d error %d\n", param_size, ret);
-		}
+#ifdef CONFIG_BT_SCO_JITTER_BUFFER
+		_sco_jitter_put(bt_stream, param, param_size);
+#else
+		_bt_manager_sco_write_frame(bt_stream, param, param_size);
+#endif
 		bt_manager_stream_pool_unlock();
-		print_cnt = 0;
 		break;
 	}
 	default:
@@ -89,6 +271,26 @@ int bt_manager_hfp_sco_stop(void)
 	return btif_sco_stop();
 }
 
+int bt_manager_sco_get_jitter_stat(struct bt_sco_jitter_stat *stat, bool clear)
+{
+#ifdef CONFIG_BT_SCO_JITTER_BUFFER
+	unsigned int key = irq_lock();
+
+	memcpy(stat, &sco_jitter.stat, sizeof(*stat));
+	if (clear) {
+		uint8_t target_depth = sco_jitter.stat.target_depth;
+
+		memset(&sco_jitter.stat, 0, sizeof(sco_jitter.stat));
+		sco_jitter.stat.target_depth = target_depth;
+	}
+
+	irq_unlock(key);
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
 int bt_manager_sco_get_codecid(void)
 {
 #ifdef CONFIG_MEDIA
@@ -67,3 +67,8 @@ void btif_a2dp_get_active_mac(bd_address_t *addr)
 	btsrv_rdm_get_a2dp_acitve_mac(addr);
 	btsrv_revert_prio(flags);
 }
+
+uint8_t *btif_a2dp_get_zero_frame(uint8_t codec_id, uint16_t *len, uint8_t sample_rate)
+{
+	return btsrv_a2dp_media_get_zero_frame(codec_id, len, sample_rate);
+}
@@ -488,6 +488,29 @@ int bt_manager_a2dp_check_state(void);
  */
 int bt_manager_a2dp_send_delay_report(uint16_t delay_time);
 
+/** a2dp media jitter buffer statistics */
+struct bt_a2dp_jitter_stat {
+	uint32_t received;		/* media packets received */
+	uint32_t late;			/* packets arrived after their slot was concealed */
+	uint32_t duplicate;		/* packets already received */
+	uint32_t lost;			/* sequence numbers never received in time */
+	uint32_t concealed;		/* lost packets replaced by zero frames */
+	uint32_t overflow;		/* packets dropped for media stream full */
+	uint32_t resync;		/* sequence jumps handled as stream restart */
+	uint8_t target_depth;	/* packets held before a hole is concealed */
+	uint8_t max_depth;		/* max packets held */
+};
+
+/**
+ * @brief Get a2dp media jitter buffer statistics
+ *
+ * @param stat pointer to store the statistics
+ * @param clear clear the counters after read
+ *
+ * @return 0 excute successed , others failed
+ */
+int bt_manager_a2dp_get_jitter_stat(struct bt_a2dp_jitter_stat *stat, bool clear);
+
 /**
  * @brief disable bt music
  *
@@ -829,6 +852,29 @@ int bt_manager_sco_get_codecid(void);
  */
 int bt_manager_sco_get_sample_rate(void);
 
+/** sco receive jitter buffer statistics, cleared when a call stream starts */
+struct bt_sco_jitter_stat {
+	uint32_t received;		/* sco frames received */
+	uint32_t bad;			/* frames flagged bad by controller or bt service */
+	uint32_t lost;			/* frames missing from the frame count sequence */
+	uint32_t late;			/* frames arrived after the decoder drained the stream */
+	uint32_t concealed;		/* bad frames inserted for lost frames or to refill depth */
+	uint32_t trimmed;		/* frames dropped to shrink latency */
+	uint32_t overflow;		/* frames dropped for sco stream full */
+	uint8_t target_depth;	/* frames kept queued for the decoder */
+	uint8_t max_depth;		/* max frames queued */
+};
+
+/**
+ * @brief Get sco receive jitter buffer statistics
+ *
+ * @param stat pointer to store the statistics
+ * @param clear clear the counters after read
+ *
+ * @return 0 excute successed , others failed
+ */
+int bt_manager_sco_get_jitter_stat(struct bt_sco_jitter_stat *stat, bool clear);
+
 /**
  * @brief get profile hfp call state
  *
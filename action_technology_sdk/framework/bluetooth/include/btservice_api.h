@@ -787,6 +787,17 @@ int btif_a2dp_send_delay_report(uint16_t delay_time);
  */
 void btif_a2dp_get_active_mac(bd_address_t *addr);
 
+/**
+ * @brief Get a2dp zero (silence) frame
+ *
+ * @param codec_id a2dp codec id
+ * @param len return length of the frame
+ * @param sample_rate sample rate (unit: KHz)
+ *
+ * @return pointer to the frame, NULL if not support codec
+ */
+uint8_t *btif_a2dp_get_zero_frame(uint8_t codec_id, uint16_t *len, uint8_t sample_rate);
+
 /*=============================================================================
  *				avrcp service api
  *===========================================================================*/
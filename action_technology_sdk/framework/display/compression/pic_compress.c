@@ -43,6 +43,21 @@ static bool dma2d_inited = false;
 static hal_dma2d_handle_t dma2d;
 #endif
 
+#ifdef CONFIG_PIC_DECOMPRESS_STAT
+static pic_decompress_stat_t decompress_stat;
+
+void pic_decompress_get_stat(pic_decompress_stat_t *stat, bool clear)
+{
+	unsigned int key = os_irq_lock();
+
+	memcpy(stat, &decompress_stat, sizeof(*stat));
+	if (clear)
+		memset(&decompress_stat, 0, sizeof(decompress_stat));
+
+	os_irq_unlock(key);
+}
+#endif
+
 __ramfunc int hardware_copy(char *dest, int16_t d_stride, const char *src,
 		int16_t s_width, int16_t s_height, int16_t s_stride, uint8_t bytes_per_pixel)
 {
@@ -301,39 +316,6 @@ __ramfunc int pic_decompress(const char* picSource, char* picDst, int compressed
 	for (int j = y_start_tile; j <= y_end_tile; j++) {
 		for (int i = x_start_tile; i <= x_end_tile; i++) {
 			int tile_index = i + j * tile_x_num;
-			//uint32_t get_cache_start = k_cycle_get_32();
-			tile_cache_item_t * cache_item = tile_cache_get(picSource, tile_index);
-			//get_cache_time +=  (k_cycle_get_32() - get_cache_start);
-			//if (!tile_cache_is_valid(cache_item)) {
-				//dec = true;
-
-			if (pic_head->magic == LZ4_PIC_MAGIC) {
-#ifdef CONFIG_SOC_SERIES_LEOPARD
-				p_brom_misc_api->p_decompress(picSource + tile_head_info[tile_index].tile_addr,
-					cache_item->tile_data,
-					tile_head_info[tile_index].tile_size,
-					sizeof(cache_item->tile_data));
-#else
-
-				LZ4_decompress_safe(picSource + tile_head_info[tile_index].tile_addr,
-					cache_item->tile_data,
-					tile_head_info[tile_index].tile_size,
-					sizeof(cache_item->tile_data));
-
-#endif
-			} else if (pic_head->magic == RLE_PIC_MAGIC) {
-				rle_decompress(picSource + tile_head_info[tile_index].tile_addr,
-						 cache_item->tile_data,
-						 tile_head_info[tile_index].tile_size,
-						 sizeof(cache_item->tile_data), pic_head->bytes_per_pixel);
-			} else {
-				return -ENOEXEC;
-			}
-
-				//tile_cache_set_valid(cache_item, picSource, tile_index,
-									 //tile_head_info[tile_index].tile_size);
-			//}
-
 			ui_region_t tile_region = {
 				.x1 = i * pic_head->tile_width,
 				.y1 = j * pic_head->tile_height,
@@ -353,22 +335,93 @@ __ramfunc int pic_decompress(const char* picSource, char* picDst, int compressed
 				continue;
 			}
 
-			int src_stride = pic_head->bytes_per_pixel * ui_region_get_width(&tile_region);
+			const char *tile_src = picSource + tile_head_info[tile_index].tile_addr;
+			int tile_size = tile_head_info[tile_index].tile_size;
+			int tile_w = ui_region_get_width(&tile_region);
+			int src_stride = pic_head->bytes_per_pixel * tile_w;
+			/* only the rows of the tile inside the clip are needed */
+			int skip_rows = copy_region.y1 - tile_region.y1;
+			int dec_rows = ui_region_get_height(&copy_region);
+			int copy_w = ui_region_get_width(&copy_region);
 
 			char* tile_dest_addr = picDst + (copy_region.x1 - x) * pic_head->bytes_per_pixel
 											 				+ (copy_region.y1 - y) * out_stride;
 
-			char* tile_src_addr = cache_item->tile_data + (copy_region.x1 - tile_region.x1) * pic_head->bytes_per_pixel
-									+ (copy_region.y1 - tile_region.y1) * src_stride;
+			/* full tile rows matching the output stride are decompressed in place */
+			bool direct = (copy_w == tile_w && out_stride == src_stride);
+			tile_cache_item_t *cache_item = NULL;
+			char *tile_src_addr;
+
+			if (pic_head->magic == LZ4_PIC_MAGIC) {
+#ifdef CONFIG_SOC_SERIES_LEOPARD
+				/* brom decompress always outputs the whole tile */
+				cache_item = tile_cache_get(picSource, tile_index);
+				p_brom_misc_api->p_decompress(tile_src,
+					cache_item->tile_data,
+					tile_size,
+					sizeof(cache_item->tile_data));
+				direct = false;
+				dec_rows = ui_region_get_height(&tile_region);
+#else
+				/* LZ4 can only stop early, rows before the clip are decoded too */
+				int target_size = (skip_rows + dec_rows) * src_stride;
+
+				direct = direct && (skip_rows == 0);
+				if (direct) {
+					LZ4_decompress_safe_partial(tile_src, tile_dest_addr,
+						tile_size, target_size, target_size);
+				} else {
+					cache_item = tile_cache_get(picSource, tile_index);
+					LZ4_decompress_safe_partial(tile_src, cache_item->tile_data,
+						tile_size, target_size, sizeof(cache_item->tile_data));
+				}
+
+				dec_rows += skip_rows;
+#endif
+				tile_src_addr = direct ? NULL : (char *)cache_item->tile_data
+						+ (copy_region.x1 - tile_region.x1) * pic_head->bytes_per_pixel
+						+ (copy_region.y1 - tile_region.y1) * src_stride;
+			} else if (pic_head->magic == RLE_PIC_MAGIC) {
+				if (!direct) {
+					cache_item = tile_cache_get(picSource, tile_index);
+				}
+
+				rle_decompress_window(tile_src,
+						direct ? (uint8_t *)tile_dest_addr : cache_item->tile_data,
+						tile_size, skip_rows * tile_w, dec_rows * tile_w,
+						pic_head->bytes_per_pixel);
+
+				/* decoded from the first row in clip */
+				tile_src_addr = direct ? NULL : (char *)cache_item->tile_data
+						+ (copy_region.x1 - tile_region.x1) * pic_head->bytes_per_pixel;
+			} else {
+				return -ENOEXEC;
+			}
+
+#ifdef CONFIG_PIC_DECOMPRESS_STAT
+			decompress_stat.decoded_pixels += dec_rows * tile_w;
+			decompress_stat.output_pixels += copy_w * ui_region_get_height(&copy_region);
+			decompress_stat.tiles++;
+			if (direct)
+				decompress_stat.direct_tiles++;
+#endif
+
+			if (direct) {
+#ifndef CONFIG_NO_PSRAM
+				/* written through the cache, next to tiles copied by DMA2D */
+				mem_dcache_clean(tile_dest_addr, src_stride * ui_region_get_height(&copy_region));
+				mem_dcache_sync();
+#endif
+				out_size += src_stride * ui_region_get_height(&copy_region);
+				continue;
+			}
 
 			out_size += hardware_copy(tile_dest_addr, out_stride, tile_src_addr,
-					ui_region_get_width(&copy_region), ui_region_get_height(&copy_region),
+					copy_w, ui_region_get_height(&copy_region),
 					src_stride, pic_head->bytes_per_pixel);
 #if CONFIG_TILE_CACHE_NUM == 1
 			hardware_wait_finish();
 #endif
-
-			//copy_time += (k_cycle_get_32() - copy_start);
 		}
 	}
 
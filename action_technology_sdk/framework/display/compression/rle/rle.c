@@ -222,3 +222,61 @@ int rle_decompress(const uint8_t * in_buf, uint8_t * out_buf, int in_size, int o
 
 	return dec_size;
 }
+
+/**
+ * @brief RLE decode a window of elements
+ *
+ * @param in_buf pointer to encoded input buffer
+ * @param out_buf pointer to output buffer
+ * @param in_size size of input buffer in bytes
+ * @param skip_count number of leading elements to skip without output
+ * @param out_count number of elements to decode after the skipped ones
+ * @param size size of each element in bytes
+ *
+ * @retval number of bytes actually decoded
+ */
+RLE_FORCE_O3
+int rle_decompress_window(const uint8_t * in_buf, uint8_t * out_buf, int in_size,
+		int skip_count, int out_count, size_t size)
+{
+	int dec_size = 0;
+
+	/* skip whole runs before the window */
+	while (in_size > 0 && skip_count > 0) {
+		uint8_t sign = in_buf[0];
+		int count = sign & 0x7F;
+		int run_size = ((sign & 0x80) != 0) ? (1 + size) : (1 + size * count);
+
+		if (count > skip_count)
+			break;
+
+		skip_count -= count;
+		in_buf += run_size;
+		in_size -= run_size;
+	}
+
+	/* window starts inside a run */
+	if (in_size > 0 && skip_count > 0 && out_count > 0) {
+		uint8_t sign = in_buf[0];
+		int count = (sign & 0x7F) - skip_count;
+
+		if (count > out_count)
+			count = out_count;
+
+		if ((sign & 0x80) != 0) {
+			fill_repetition(out_buf, &in_buf[1], count, size);
+			in_buf += (1 + size);
+			in_size -= (1 + size);
+		} else {
+			memcpy(out_buf, &in_buf[1 + size * skip_count], size * count);
+			in_buf += (1 + size * (sign & 0x7F));
+			in_size -= (1 + size * (sign & 0x7F));
+		}
+
+		out_buf += size * count;
+		out_count -= count;
+		dec_size += size * count;
+	}
+
+	return dec_size + rle_decompress(in_buf, out_buf, in_size, out_count, size);
+}
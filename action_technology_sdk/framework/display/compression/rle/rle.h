@@ -43,6 +43,21 @@ int rle_compress(const uint8_t* in_buf, uint8_t * out_buf,  size_t in_count, siz
 
 int rle_decompress(const uint8_t * in_buf, uint8_t * out_buf, int in_size, int out_count, size_t size);
 
+/**
+ * @brief RLE decode a window of elements, skipping the elements before it
+ *
+ * @param in_buf pointer to encoded input buffer
+ * @param out_buf pointer to output buffer
+ * @param in_size size of input buffer in bytes
+ * @param skip_count number of leading elements to skip without output
+ * @param out_count number of elements to decode after the skipped ones
+ * @param size size of each element in bytes
+ *
+ * @retval number of bytes actually decoded
+ */
+int rle_decompress_window(const uint8_t * in_buf, uint8_t * out_buf, int in_size,
+		int skip_count, int out_count, size_t size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -8,6 +8,7 @@
 #define FRAMEWORK_DISPLAY_INCLUDE_COMPRESS_API_H_
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -73,6 +74,17 @@ typedef struct compress_pic_head {
 	uint16_t tile_num;
 } compress_pic_head_t;
 
+/**
+ * @struct pic_decompress_stat
+ * @brief Structure holding picture decompress statistics
+ */
+typedef struct pic_decompress_stat {
+	uint32_t decoded_pixels; /* pixels decompressed, including the ones out of clip */
+	uint32_t output_pixels; /* pixels written to the destination */
+	uint32_t tiles; /* tiles decompressed */
+	uint32_t direct_tiles; /* tiles decompressed directly into the destination */
+} pic_decompress_stat_t;
+
 int pic_compress(const char* picSrc, char* picDst, int srcWidth, int srcHight,
 		int tileWidth, int tileHight, int maxOutputSize, uint8_t format, uint8_t compress_format);
 
@@ -83,6 +95,22 @@ int pic_compress_size(const char* picSource);
 
 int pic_compress_format(const char* picSource);
 
+#ifdef CONFIG_PIC_DECOMPRESS_STAT
+/**
+ * @brief Get picture decompress statistics
+ *
+ * @param stat pointer to store the statistics
+ * @param clear clear the statistics after read
+ *
+ * @retval N/A
+ */
+void pic_decompress_get_stat(pic_decompress_stat_t *stat, bool clear);
+#else
+static inline void pic_decompress_get_stat(pic_decompress_stat_t *stat, bool clear)
+{
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -234,6 +234,8 @@ typedef struct _preload_param
 	void* param;
 	resource_info_t* res_info;
 	struct _preload_param* next;
+	struct _preload_param* prev;
+	struct _preload_param* scene_next;
 }preload_param_t;
 
 
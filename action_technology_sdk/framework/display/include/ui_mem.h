@@ -191,6 +191,19 @@ void * ui_mem_gui_aligned_alloc(size_t align, size_t size);
 void * ui_mem_gui_realloc(void * ptr, size_t size);
 void ui_mem_gui_free(void * ptr);
 
+#if defined(CONFIG_UI_GUI_FRAME_ARENA_SIZE) && CONFIG_UI_GUI_FRAME_ARENA_SIZE > 0
+/* allocate from the GUI frame arena, falling back to the GUI heap when full.
+ * Release with ui_mem_gui_free() (or ui_mem_free(MEM_GUI, ...)) before the
+ * next frame starts.
+ */
+void * ui_mem_gui_frame_alloc(size_t size);
+/* check at the start of each frame that every block allocated by
+ * ui_mem_gui_frame_alloc() in the previous frame has been freed. The arena
+ * rewinds by itself once its last block is freed.
+ */
+void ui_mem_gui_frame_reset(void);
+#endif
+
 #if defined(CONFIG_UI_RES_MEM_POOL_SIZE) && CONFIG_UI_RES_MEM_POOL_SIZE > 0
 void * ui_mem_res_alloc(size_t size);
 void * ui_mem_res_aligned_alloc(size_t align, size_t size);
@@ -119,6 +119,10 @@ typedef struct surface {
 
 #if CONFIG_SURFACE_MAX_BUFFER_COUNT > 0
 	ui_region_t dirty_area;
+#ifdef CONFIG_SURFACE_DIRTY_REGION_LIST
+	/* precise dirty regions, used to minimize the swap buffer copy */
+	ui_region_list_t dirty_list;
+#endif
 
 	graphic_buffer_t *buffers[CONFIG_SURFACE_MAX_BUFFER_COUNT];
 	uint8_t buf_count;
@@ -137,8 +137,10 @@ static lv_result_t _img_decoder_acts_res_open(lv_image_decoder_t * decoder, lv_i
 		return LV_RESULT_INVALID;
 
 	lv_draw_buf_t * decoded = lv_malloc(sizeof(lv_draw_buf_t));
-	if (decoded == NULL)
+	if (decoded == NULL) {
+		res_manager_free_bitmap_for_decoder(sty->buffer);
 		return LV_RESULT_INVALID;
+	}
 
 	lv_draw_buf_init(decoded, dsc->header.w, dsc->header.h, dsc->header.cf, dsc->header.stride,
                      sty->buffer, dsc->header.stride * dsc->header.h);
@@ -70,6 +70,39 @@ static uint32_t preload_running = 1;
 static preload_param_t* param_list = NULL;
 static preload_param_t* sync_param_list = NULL;
 
+#define PRELOAD_MAX_SCENES			8
+#define PRELOAD_DISPATCH_BATCH		4
+#define PRELOAD_ID_SET_MIN_SLOTS	64
+#define PRELOAD_ID_SET_EMPTY		0xffffffff
+
+/* per scene index of the preload queue, items chained by scene_next in queue order */
+typedef struct
+{
+	uint32_t scene_id;
+	preload_param_t* head;
+	preload_param_t* tail;
+	uint32_t pending;
+	uint32_t start_time;
+	uint32_t last_latency;
+	uint32_t max_latency;
+}preload_scene_t;
+
+static preload_param_t* param_tail = NULL;
+static uint32_t preload_depth = 0;
+static uint32_t preload_max_depth = 0;
+static uint32_t preload_unindexed = 0;
+static preload_scene_t preload_scenes[PRELOAD_MAX_SCENES];
+
+/* preload list under construction, with a bitmap id set for dedup */
+typedef struct
+{
+	preload_param_t* head;
+	preload_param_t* tail;
+	uint32_t* ids;
+	uint32_t id_slots;
+	uint32_t id_count;
+}preload_sublist_t;
+
 static lvgl_res_scene_t current_scene;
 static lvgl_res_group_t current_group;
 static lvgl_res_group_t current_subgrp;
@@ -1590,89 +1623,328 @@ int lvgl_res_load_picregion(uint32_t group_id, uint32_t subgroup_id, uint32_t pi
 
 }
 
-static preload_param_t* _check_item_in_list(preload_param_t* sublist, resource_bitmap_t* bitmap)
+static inline uint32_t _preload_id_hash(uint32_t id, uint32_t slots)
 {
-	preload_param_t* item;
+	return (id * 2654435761u) & (slots - 1);
+}
+
+static void _init_sublist(preload_sublist_t* sublist)
+{
+	memset(sublist, 0, sizeof(preload_sublist_t));
 
-	if(sublist == NULL)
+	sublist->ids = (uint32_t*)res_array_alloc(RES_MEM_SIMPLE_PRELOAD, PRELOAD_ID_SET_MIN_SLOTS*sizeof(uint32_t));
+	if(sublist->ids)
 	{
-		SYS_LOG_ERR("shouldnt happen");
-		return NULL;
+		memset(sublist->ids, 0xff, PRELOAD_ID_SET_MIN_SLOTS*sizeof(uint32_t));
+		sublist->id_slots = PRELOAD_ID_SET_MIN_SLOTS;
 	}
-	else
+}
+
+static void _deinit_sublist(preload_sublist_t* sublist)
+{
+	if(sublist->ids)
 	{
-		item = sublist;
-		if(item->bitmap && item->bitmap->sty_data->id == bitmap->sty_data->id)
+		res_array_free(sublist->ids);
+		sublist->ids = NULL;
+	}
+}
+
+static void _add_sublist_id(preload_sublist_t* sublist, uint32_t id)
+{
+	uint32_t i;
+
+	if(sublist->ids == NULL)
+	{
+		return;
+	}
+
+	/* keep load factor below 1/2, fall back to list scan if cannot grow */
+	if((sublist->id_count + 1)*2 > sublist->id_slots)
+	{
+		uint32_t slots = sublist->id_slots*2;
+		uint32_t* ids = (uint32_t*)res_array_alloc(RES_MEM_SIMPLE_PRELOAD, slots*sizeof(uint32_t));
+
+		if(ids == NULL)
 		{
-			return NULL;
+			_deinit_sublist(sublist);
+			return;
 		}
-		
-		while(item->next != NULL)
+
+		memset(ids, 0xff, slots*sizeof(uint32_t));
+		for(i=0; i<sublist->id_slots; i++)
 		{
-			if(item->bitmap && item->bitmap->sty_data->id == bitmap->sty_data->id)
+			uint32_t k;
+
+			if(sublist->ids[i] == PRELOAD_ID_SET_EMPTY)
 			{
-				return NULL;
+				continue;
 			}
-			item = item->next;
+
+			k = _preload_id_hash(sublist->ids[i], slots);
+			while(ids[k] != PRELOAD_ID_SET_EMPTY)
+			{
+				k = (k + 1) & (slots - 1);
+			}
+			ids[k] = sublist->ids[i];
 		}
-		
-		if(item->bitmap && item->bitmap->sty_data->id == bitmap->sty_data->id)
+
+		res_array_free(sublist->ids);
+		sublist->ids = ids;
+		sublist->id_slots = slots;
+	}
+
+	i = _preload_id_hash(id, sublist->id_slots);
+	while(sublist->ids[i] != PRELOAD_ID_SET_EMPTY)
+	{
+		if(sublist->ids[i] == id)
 		{
-			return NULL;
-		}	
-		//found tail		
-		return item;
+			return;
+		}
+		i = (i + 1) & (sublist->id_slots - 1);
 	}
+
+	sublist->ids[i] = id;
+	sublist->id_count++;
 }
 
-static void _add_item_to_list(preload_param_t** sublist, preload_param_t* param)
+static bool _check_item_in_list(preload_sublist_t* sublist, resource_bitmap_t* bitmap)
 {
 	preload_param_t* item;
+	uint32_t id = bitmap->sty_data->id;
+	uint32_t i;
 
-	os_strace_u32x4(SYS_TRACE_ID_RES_PRELOAD_ADD, (uint32_t)param->scene_id, (uint32_t)*sublist, (uint32_t)param, (uint32_t)param->next);
+	if(sublist->head == NULL)
+	{
+		SYS_LOG_ERR("shouldnt happen");
+		return true;
+	}
 
-	if(*sublist == NULL)
+	if(sublist->ids)
 	{
-		*sublist = param;
+		i = _preload_id_hash(id, sublist->id_slots);
+		while(sublist->ids[i] != PRELOAD_ID_SET_EMPTY)
+		{
+			if(sublist->ids[i] == id)
+			{
+				return true;
+			}
+			i = (i + 1) & (sublist->id_slots - 1);
+		}
+		return false;
+	}
+
+	for(item = sublist->head; item != NULL; item = item->next)
+	{
+		if(item->bitmap && item->bitmap->sty_data->id == id)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+static void _add_item_to_list(preload_sublist_t* sublist, preload_param_t* param)
+{
+	os_strace_u32x4(SYS_TRACE_ID_RES_PRELOAD_ADD, (uint32_t)param->scene_id, (uint32_t)sublist->head, (uint32_t)param, (uint32_t)param->next);
+
+	param->next = NULL;
+	if(sublist->tail == NULL)
+	{
+		sublist->head = param;
 	}
 	else
 	{
-		item = *sublist;
-		while(1)
+		sublist->tail->next = param;
+	}
+	sublist->tail = param;
+
+	if(param->bitmap)
+	{
+		_add_sublist_id(sublist, param->bitmap->sty_data->id);
+	}
+	os_strace_end_call_u32(SYS_TRACE_ID_RES_PRELOAD_ADD, (uint32_t)param_list);
+}
+
+static preload_scene_t* _find_preload_scene(uint32_t scene_id)
+{
+	int i;
+
+	for(i=0; i<PRELOAD_MAX_SCENES; i++)
+	{
+		if(preload_scenes[i].scene_id == scene_id)
 		{
-			if(item->next == NULL)
+			return &preload_scenes[i];
+		}
+	}
+	return NULL;
+}
+
+static preload_scene_t* _get_preload_scene(uint32_t scene_id)
+{
+	preload_scene_t* scene;
+	int i;
+
+	scene = _find_preload_scene(scene_id);
+	if(scene)
+	{
+		return scene;
+	}
+
+	/* reuse an idle entry */
+	for(i=0; i<PRELOAD_MAX_SCENES; i++)
+	{
+		scene = &preload_scenes[i];
+		if(scene->pending == 0)
+		{
+			memset(scene, 0, sizeof(preload_scene_t));
+			scene->scene_id = scene_id;
+			return scene;
+		}
+	}
+	return NULL;
+}
+
+static void _index_preload_item(preload_param_t* param, uint32_t now)
+{
+	preload_scene_t* scene;
+
+	param->scene_next = NULL;
+	if(param->scene_id == 0)
+	{
+		return;
+	}
+
+	scene = _get_preload_scene(param->scene_id);
+	if(scene == NULL)
+	{
+		preload_unindexed++;
+		return;
+	}
+
+	if(scene->pending == 0)
+	{
+		scene->start_time = now;
+	}
+
+	if(scene->tail == NULL)
+	{
+		scene->head = param;
+	}
+	else
+	{
+		scene->tail->scene_next = param;
+	}
+	scene->tail = param;
+	scene->pending++;
+}
+
+static void _unlink_preload_item(preload_param_t* param)
+{
+	if(param->prev)
+	{
+		param->prev->next = param->next;
+	}
+	else
+	{
+		param_list = param->next;
+	}
+
+	if(param->next)
+	{
+		param->next->prev = param->prev;
+	}
+	else
+	{
+		param_tail = param->prev;
+	}
+
+	preload_depth--;
+}
+
+/* remove the queue head, which is also the head of its scene chain if indexed */
+static preload_param_t* _pop_preload_item(void)
+{
+	preload_param_t* param = param_list;
+	preload_scene_t* scene;
+
+	_unlink_preload_item(param);
+
+	if(param->scene_id > 0)
+	{
+		scene = _find_preload_scene(param->scene_id);
+		if(scene && scene->head == param)
+		{
+			scene->head = param->scene_next;
+			if(scene->head == NULL)
 			{
-				item->next = param;
-				break;
+				scene->tail = NULL;
 			}
-			item = item->next;
+			scene->pending--;
+		}
+		else
+		{
+			preload_unindexed--;
 		}
 	}
-	os_strace_end_call_u32(SYS_TRACE_ID_RES_PRELOAD_ADD, (uint32_t)param_list);
+
+	return param;
+}
+
+static void _cancel_preload_item(preload_param_t* item)
+{
+	if(item->preload_type == PRELOAD_TYPE_END_CALLBACK)
+	{
+		if(item->scene_id > 0)
+		{
+			res_manager_unload_scene(item->scene_id, NULL);
+		}
+		if (item->callback)
+			item->callback(LVGL_RES_PRELOAD_STATUS_CANCELED, item->param);
+	}
+	else
+	{
+		res_manager_free_resource_structure(item->bitmap);
+	}
+	memset(item, 0, sizeof(preload_param_t));
+	res_array_free(item);
 }
 
 static void _add_item_to_preload_list(preload_param_t* param)
 {
 	preload_param_t* item;
+	preload_param_t* next;
+	uint32_t now = os_uptime_get_32();
+
 	os_mutex_lock(&preload_mutex, OS_FOREVER);
 	os_strace_u32x4(SYS_TRACE_ID_RES_PRELOAD_ADD, (uint32_t)param->scene_id, (uint32_t)param_list, (uint32_t)param, (uint32_t)param->next);
 	if(param_list == NULL)
 	{
-		param_list = param;
 		os_sem_give(&preload_sem);
 	}
-	else
+
+	for(item = param; item != NULL; item = next)
 	{
-		item = param_list;
-		while(1)
+		next = item->next;
+
+		item->next = NULL;
+		item->prev = param_tail;
+		if(param_tail)
 		{
-			if(item->next == NULL)
-			{
-				item->next = param;
-				break;
-			}
-			item = item->next;
+			param_tail->next = item;
 		}
+		else
+		{
+			param_list = item;
+		}
+		param_tail = item;
+
+		_index_preload_item(item, now);
+		preload_depth++;
+	}
+
+	if(preload_depth > preload_max_depth)
+	{
+		preload_max_depth = preload_depth;
 	}
 
 	os_strace_end_call_u32(SYS_TRACE_ID_RES_PRELOAD_ADD, (uint32_t)param_list);
@@ -1705,8 +1977,10 @@ static void _add_item_to_loading_list(preload_param_t* param)
 void _clear_preload_list(uint32_t scene_id)
 {
 	preload_param_t* item;
-	preload_param_t* prev;
-	preload_param_t* found;
+	preload_param_t* next;
+	preload_scene_t* scene;
+	int i;
+
 	os_mutex_lock(&preload_mutex, OS_FOREVER);
 	os_strace_u32x2(SYS_TRACE_ID_RES_PRELOAD_CANCEL, (uint32_t)scene_id, (uint32_t)param_list);
 
@@ -1717,68 +1991,55 @@ void _clear_preload_list(uint32_t scene_id)
 		return;
 	}
 
-	item = param_list;
-	prev = NULL;
 	if(scene_id == 0)
 	{
+		item = param_list;
+		param_list = NULL;
+		param_tail = NULL;
+		preload_depth = 0;
+		preload_unindexed = 0;
+		for(i=0; i<PRELOAD_MAX_SCENES; i++)
+		{
+			preload_scenes[i].head = NULL;
+			preload_scenes[i].tail = NULL;
+			preload_scenes[i].pending = 0;
+		}
+
 		while(item != NULL)
 		{
-			param_list = item->next;
-			if(item->preload_type == PRELOAD_TYPE_END_CALLBACK)
-			{
-				if(item->scene_id > 0)
-				{
-					res_manager_unload_scene(item->scene_id, NULL);
-				}			
-				if (item->callback)
-					item->callback(LVGL_RES_PRELOAD_STATUS_CANCELED, item->param);
-			}
-			else
-			{
-				res_manager_free_resource_structure(item->bitmap);
-			}
-			memset(item, 0, sizeof(preload_param_t));
-			res_array_free(item);
-			item = param_list;
+			next = item->next;
+			_cancel_preload_item(item);
+			item = next;
 		}
 	}
 	else
 	{
-		while(item != NULL)
+		scene = _find_preload_scene(scene_id);
+		if(scene)
 		{
-			if(item->scene_id == scene_id)
-			{
-				if(item->preload_type == PRELOAD_TYPE_END_CALLBACK)
-				{
-					if(item->scene_id > 0)
-					{
-						res_manager_unload_scene(item->scene_id, NULL);
-					}
-					if (item->callback)
-						item->callback(LVGL_RES_PRELOAD_STATUS_CANCELED, item->param);
-				}
-				else
-				{
-					res_manager_free_resource_structure(item->bitmap);
-				}				
+			item = scene->head;
+			scene->head = NULL;
+			scene->tail = NULL;
+			scene->pending = 0;
 
-				if(param_list == item)
-				{
-					param_list = item->next;
-				}
-				if(prev != NULL)
-				{
-					prev->next = item->next;
-				}
-				found = item;
-				item = item->next;
-				memset(found, 0, sizeof(preload_param_t));
-				res_array_free(found);
+			while(item != NULL)
+			{
+				next = item->scene_next;
+				_unlink_preload_item(item);
+				_cancel_preload_item(item);
+				item = next;
 			}
-			else
+		}
+
+		/* items queued while the scene index was full */
+		for(item = param_list; item != NULL && preload_unindexed > 0; item = next)
+		{
+			next = item->next;
+			if(item->scene_id == scene_id)
 			{
-				prev = item;
-				item = item->next;
+				_unlink_preload_item(item);
+				_cancel_preload_item(item);
+				preload_unindexed--;
 			}
 		}
 	}
@@ -1835,6 +2096,7 @@ int lvgl_res_preload_pictures_from_scene(uint32_t scene_id, lvgl_res_scene_t* sc
 		else
 		{
 			param->preload_type = PRELOAD_TYPE_NORMAL;
+			param->scene_id = 0;
 		}
 		param->bitmap = bitmap;
 		param->next = NULL;
@@ -1887,6 +2149,7 @@ int lvgl_res_preload_pictures_from_group(uint32_t scene_id, lvgl_res_group_t* gr
 		else
 		{
 			param->preload_type = PRELOAD_TYPE_NORMAL;
+			param->scene_id = 0;
 		}
 		param->bitmap = bitmap;
 		param->next = NULL;
@@ -1941,6 +2204,7 @@ int lvgl_res_preload_pictures_from_picregion(uint32_t scene_id, lvgl_res_picregi
 		else
 		{
 			param->preload_type = PRELOAD_TYPE_NORMAL;
+			param->scene_id = 0;
 		}
 		param->bitmap = bitmap;
 		param->next = NULL;
@@ -1955,15 +2219,74 @@ int lvgl_res_preload_pictures_from_picregion(uint32_t scene_id, lvgl_res_picregi
 }
 
 #ifndef CONFIG_RES_MANAGER_SKIP_PRELOAD
+static void _dispatch_preload_item(preload_param_t* param_item)
+{
+	preload_scene_t* scene;
+	uint32_t latency;
+	int32_t ret = 0;
+
+	if(param_item->preload_type == PRELOAD_TYPE_NORMAL)
+	{
+		ret = res_manager_preload_bitmap(param_item->res_info, param_item->bitmap);
+		res_manager_free_resource_structure(param_item->bitmap);
+	}
+	else if(param_item->preload_type == PRELOAD_TYPE_NORMAL_COMPACT)
+	{
+		ret = res_manager_preload_bitmap_compact(param_item->scene_id, param_item->res_info, param_item->bitmap);
+		res_manager_free_resource_structure(param_item->bitmap);
+	}
+	else if(param_item->preload_type == PRELOAD_TYPE_BEGIN_CALLBACK)
+	{
+		if (param_item->callback)
+			param_item->callback(LVGL_RES_PRELOAD_STATUS_LOADING, param_item->param);
+
+	}
+	else if(param_item->preload_type == PRELOAD_TYPE_END_CALLBACK)
+	{
+		//user callback ,add at the end of preloaded pics to inform user about preload finish
+		//res_manager_preload_finish_check(param_item->scene_id);
+
+		scene = _find_preload_scene(param_item->scene_id);
+		if(scene)
+		{
+			latency = os_uptime_get_32() - scene->start_time;
+			scene->last_latency = latency;
+			if(latency > scene->max_latency)
+			{
+				scene->max_latency = latency;
+			}
+			SYS_LOG_DBG("scene 0x%x preloaded in %u ms\n", scene->scene_id, latency);
+		}
+
+		if (param_item->callback)
+			param_item->callback(LVGL_RES_PRELOAD_STATUS_FINISHED, param_item->param);
+//			_dump_sram_usage();
+
+	}
+	else
+	{
+		//presumably already freed, just continue;
+		SYS_LOG_ERR("unknown preload type: %d\n", param_item->preload_type);
+	}
+
+	if(ret < 0)
+	{
+		SYS_LOG_DBG("preload type %d failed\n", param_item->preload_type);
+	}
+
+	memset(param_item, 0, sizeof(preload_param_t));
+	res_array_free(param_item);
+}
+
 static void _res_preload_thread(void *parama1, void *parama2, void *parama3)
 {
 	preload_param_t* param_item;
-	int32_t ret = 0;
+	int batch;
 
 	while(preload_running)
 	{
 		os_mutex_lock(&preload_mutex, OS_FOREVER);
-		
+
 		if(param_list == NULL)
 		{
 			os_mutex_unlock(&preload_mutex);
@@ -1976,52 +2299,23 @@ static void _res_preload_thread(void *parama1, void *parama2, void *parama3)
 			os_mutex_unlock(&preload_mutex);
 			continue;
 		}
-		os_strace_u32x2(SYS_TRACE_ID_RES_SCENE_PRELOAD_0, (uint32_t)param_list, (uint32_t)param_list->next);
-		param_item = param_list;
-		param_list = param_item->next;
-		
 
-		if(preload_running == 2)
+		/* dispatch a few items per lock, cancel still waits at most one batch */
+		for(batch = 0; batch < PRELOAD_DISPATCH_BATCH && param_list != NULL; batch++)
 		{
-			os_strace_end_call_u32(SYS_TRACE_ID_RES_SCENE_PRELOAD_0, (uint32_t)param_list);
-			os_mutex_unlock(&preload_mutex);
-			continue;
-		}
+			os_strace_u32x2(SYS_TRACE_ID_RES_SCENE_PRELOAD_0, (uint32_t)param_list, (uint32_t)param_list->next);
+			param_item = _pop_preload_item();
 
-		if(param_item->preload_type == PRELOAD_TYPE_NORMAL)
-		{
-			ret = res_manager_preload_bitmap(param_item->res_info, param_item->bitmap);				
-			res_manager_free_resource_structure(param_item->bitmap);
-		}
-		else if(param_item->preload_type == PRELOAD_TYPE_NORMAL_COMPACT)
-		{
-			ret = res_manager_preload_bitmap_compact(param_item->scene_id, param_item->res_info, param_item->bitmap);	
-			res_manager_free_resource_structure(param_item->bitmap);
-		}
-		else if(param_item->preload_type == PRELOAD_TYPE_BEGIN_CALLBACK)
-		{
-			if (param_item->callback)
-				param_item->callback(LVGL_RES_PRELOAD_STATUS_LOADING, param_item->param);
-
-		}
-		else if(param_item->preload_type == PRELOAD_TYPE_END_CALLBACK)
-		{
-			//user callback ,add at the end of preloaded pics to inform user about preload finish
-			//res_manager_preload_finish_check(param_item->scene_id);
+			if(preload_running == 2)
+			{
+				_cancel_preload_item(param_item);
+				os_strace_end_call_u32(SYS_TRACE_ID_RES_SCENE_PRELOAD_0, (uint32_t)param_list);
+				break;
+			}
 
-			if (param_item->callback)
-				param_item->callback(LVGL_RES_PRELOAD_STATUS_FINISHED, param_item->param);
-//			_dump_sram_usage();
-			
-		}
-		else
-		{
-			//presumably already freed, just continue;
-			SYS_LOG_ERR("unknown preload type: %d\n", param_item->preload_type);
+			_dispatch_preload_item(param_item);
+			os_strace_end_call_u32(SYS_TRACE_ID_RES_SCENE_PRELOAD_0, (uint32_t)param_list);
 		}
-		memset(param_item, 0, sizeof(preload_param_t));
-		res_array_free(param_item);
-		os_strace_end_call_u32(SYS_TRACE_ID_RES_SCENE_PRELOAD_0, (uint32_t)param_list);
 		os_mutex_unlock(&preload_mutex);
 	}
 }
@@ -2030,12 +2324,24 @@ static void _res_preload_thread(void *parama1, void *parama2, void *parama3)
 void _dump_preload_list(void)
 {
 	preload_param_t* item = param_list;
+	int i;
 
 	while(item)
 	{
 		printf("preload item scene 0x%x, type %d\n", item->scene_id, item->preload_type);
 		item=item->next;
 	}
+
+	printf("preload queue depth %u, max %u, unindexed %u\n", preload_depth, preload_max_depth, preload_unindexed);
+	for(i=0; i<PRELOAD_MAX_SCENES; i++)
+	{
+		if(preload_scenes[i].scene_id > 0)
+		{
+			printf("preload scene 0x%x, pending %u, latency %u ms, max %u ms\n",
+				preload_scenes[i].scene_id, preload_scenes[i].pending,
+				preload_scenes[i].last_latency, preload_scenes[i].max_latency);
+		}
+	}
 }
 
 int lvgl_res_preload_cancel(void)
@@ -2057,11 +2363,10 @@ int lvgl_res_preload_cancel_scene(uint32_t scene_id)
 	return 0;
 }
 
-int _res_preload_pictures_from_picregion(uint32_t scene_id, lvgl_res_picregion_t* picreg, uint32_t start, uint32_t end, preload_param_t** sublist)
+int _res_preload_pictures_from_picregion(uint32_t scene_id, lvgl_res_picregion_t* picreg, uint32_t start, uint32_t end, preload_sublist_t* sublist)
 {
 	int32_t i;
 	preload_param_t* param;
-	preload_param_t* tail;
 	resource_bitmap_t* bitmap;
 	int preload_count = 0;
 
@@ -2080,8 +2385,7 @@ int _res_preload_pictures_from_picregion(uint32_t scene_id, lvgl_res_picregion_t
 			SYS_LOG_ERR("preload %d bitmap error", i);
 			continue;
 		}
-		tail = _check_item_in_list(*sublist, bitmap);
-		if(tail == NULL)
+		if(_check_item_in_list(sublist, bitmap))
 		{
 			//already in sublist, FIXME:only checked sublist for performance
 			res_manager_release_resource(bitmap);
@@ -2103,12 +2407,13 @@ int _res_preload_pictures_from_picregion(uint32_t scene_id, lvgl_res_picregion_t
 		else
 		{
 			param->preload_type = PRELOAD_TYPE_NORMAL;
+			param->scene_id = 0;
 		}
 		param->bitmap = bitmap;
 		param->next = NULL;
 		param->res_info = picreg->res_info;
 
-		tail->next = param;	
+		_add_item_to_list(sublist, param);
 		preload_count++;
 	}
 
@@ -2160,10 +2465,9 @@ void _add_preload_total_size(uint32_t scene_id, uint32_t* ptotal_size, uint32_t
 	return;
 }
 
-int _res_preload_group_compact(resource_info_t* info, uint32_t scene_id, uint32_t pargroup_id, resource_group_t* group, uint32_t* ptotal_size, uint32_t preload, preload_param_t** sublist)
+int _res_preload_group_compact(resource_info_t* info, uint32_t scene_id, uint32_t pargroup_id, resource_group_t* group, uint32_t* ptotal_size, uint32_t preload, preload_sublist_t* sublist)
 {
 	preload_param_t* param;
-	preload_param_t* tail;
 	resource_group_t* res_group;
 	resource_bitmap_t* bitmap;
 	lvgl_res_picregion_t picreg;
@@ -2236,8 +2540,7 @@ int _res_preload_group_compact(resource_info_t* info, uint32_t scene_id, uint32_
 			break;
 		case RESOURCE_TYPE_PICTURE:
 			bitmap = (resource_bitmap_t*)resource;
-			tail = _check_item_in_list(*sublist, bitmap);
-			if(tail == NULL)
+			if(_check_item_in_list(sublist, bitmap))
 			{
 				//already in sublist, FIXME:only checked sublist for performance
 				res_manager_release_resource(resource);
@@ -2271,6 +2574,7 @@ int _res_preload_group_compact(resource_info_t* info, uint32_t scene_id, uint32_
 				if(scene_id == 0)
 				{
 					param->preload_type = PRELOAD_TYPE_NORMAL;
+					param->scene_id = 0;
 				}
 				else
 				{
@@ -2299,8 +2603,7 @@ int _res_preload_scene_compact(uint32_t scene_id, const uint32_t* resource_id, u
 {
 	resource_info_t* info;
 	preload_param_t* param;
-	preload_param_t* sublist;
-	preload_param_t* tail;
+	preload_sublist_t sublist;
 	resource_bitmap_t* bitmap;
 	resource_scene_t* res_scene;
 	resource_group_t* res_group;
@@ -2328,13 +2631,13 @@ int _res_preload_scene_compact(uint32_t scene_id, const uint32_t* resource_id, u
 	}
 	os_strace_end_call_u32(SYS_TRACE_ID_RES_SCENE_PRELOAD_1, (uint32_t)scene_id);
 	os_strace_u32(SYS_TRACE_ID_RES_SCENE_PRELOAD_3, (uint32_t)scene_id);	
-	sublist = NULL;
 	param = (preload_param_t*)res_array_alloc(RES_MEM_SIMPLE_PRELOAD, sizeof(preload_param_t));
 	if(param == NULL)
 	{
 		SYS_LOG_ERR("no space for param for preload");
 		return -1;
 	}
+	_init_sublist(&sublist);
 	memset(param, 0, sizeof(preload_param_t));
 	param->callback = callback;
 	param->param = user_data;
@@ -2383,8 +2686,7 @@ int _res_preload_scene_compact(uint32_t scene_id, const uint32_t* resource_id, u
 				break;
 			case RESOURCE_TYPE_PICTURE:
 				bitmap = (resource_bitmap_t*)resource;
-				tail = _check_item_in_list(sublist, bitmap);
-				if(tail == NULL)
+				if(_check_item_in_list(&sublist, bitmap))
 				{
 					//already in sublist, FIXME:only checked sublist for performance
 					res_manager_release_resource(resource);
@@ -2418,7 +2720,7 @@ int _res_preload_scene_compact(uint32_t scene_id, const uint32_t* resource_id, u
 				param->next = NULL;
 				param->res_info = info;
 
-				tail->next = param;
+				_add_item_to_list(&sublist, param);
 				break;
 			default:
 				break;
@@ -2429,6 +2731,7 @@ int _res_preload_scene_compact(uint32_t scene_id, const uint32_t* resource_id, u
 		if(param == NULL)
 		{
 			SYS_LOG_ERR("no space for param for preload");
+			_deinit_sublist(&sublist);
 			return -1;
 		}
 		memset(param, 0, sizeof(preload_param_t));
@@ -2450,13 +2753,14 @@ int _res_preload_scene_compact(uint32_t scene_id, const uint32_t* resource_id, u
 			res_manager_init_compact_buffer(scene_id, buf_block_struct_size);
 		}
 		
+		_deinit_sublist(&sublist);
 		if(async_preload)
 		{
-			_add_item_to_preload_list(sublist);		
+			_add_item_to_preload_list(sublist.head);
 		}
 		else
 		{
-			_add_item_to_loading_list(sublist);
+			_add_item_to_loading_list(sublist.head);
 		}
 		
 //		_dump_sram_usage();
@@ -2512,8 +2816,7 @@ int _res_preload_scene_compact(uint32_t scene_id, const uint32_t* resource_id, u
 			break;
 		case RESOURCE_TYPE_PICTURE:
 			bitmap = (resource_bitmap_t*)resource;
-			tail = _check_item_in_list(sublist, bitmap);
-			if(tail == NULL)
+			if(_check_item_in_list(&sublist, bitmap))
 			{
 				//already in sublist, FIXME:only checked sublist for performance
 				res_manager_release_resource(resource);
@@ -2548,7 +2851,7 @@ int _res_preload_scene_compact(uint32_t scene_id, const uint32_t* resource_id, u
 			param->next = NULL;
 			param->res_info = info;
 
-			tail->next = param;
+			_add_item_to_list(&sublist, param);
 			break;
 		default:
 			//ignore text resource
@@ -2560,6 +2863,7 @@ int _res_preload_scene_compact(uint32_t scene_id, const uint32_t* resource_id, u
 	if(param == NULL)
 	{
 		SYS_LOG_ERR("no space for param for preload");
+		_deinit_sublist(&sublist);
 		return -1;
 	}
 
@@ -2581,13 +2885,14 @@ int _res_preload_scene_compact(uint32_t scene_id, const uint32_t* resource_id, u
 		res_manager_init_compact_buffer(scene_id, buf_block_struct_size);
 	}
 	
+	_deinit_sublist(&sublist);
 	if(async_preload)
 	{
-		_add_item_to_preload_list(sublist); 	
+		_add_item_to_preload_list(sublist.head);
 	}
 	else
 	{
-		_add_item_to_loading_list(sublist);
+		_add_item_to_loading_list(sublist.head);
 	}
 //	_dump_sram_usage();
 	os_strace_end_call_u32(SYS_TRACE_ID_RES_SCENE_PRELOAD_3, (uint32_t)scene_id);
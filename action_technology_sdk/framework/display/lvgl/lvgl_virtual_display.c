@@ -434,6 +434,10 @@ static void _lvgl_render_start_cb(lv_event_t * e)
 	lv_display_t *disp = lv_event_get_target(e);
 	lvgl_disp_drv_data_t *drv_data = lv_display_get_driver_data(disp);
 
+#if defined(CONFIG_UI_GUI_FRAME_ARENA_SIZE) && CONFIG_UI_GUI_FRAME_ARENA_SIZE > 0
+	ui_mem_gui_frame_reset();
+#endif
+
 	surface_begin_frame(drv_data->surface);
 
 	if (disp->render_mode == LV_DISPLAY_RENDER_MODE_DIRECT) {
@@ -10,6 +10,7 @@
 #include <sys/sys_heap.h>
 #include <ui_mem.h>
 #include <assert.h>
+#include <string.h>
 #ifdef CONFIG_LVGL
 #  include <lvgl/lvgl.h>
 #endif
@@ -47,6 +48,90 @@ static void _assert_in_gui_tid(const char *tag)
 	}
 }
 
+#if defined(CONFIG_UI_GUI_FRAME_ARENA_SIZE) && CONFIG_UI_GUI_FRAME_ARENA_SIZE > 0
+
+#define GUI_ARENA_ALIGN       8
+#define GUI_ARENA_HDR_SIZE    GUI_ARENA_ALIGN
+
+/*
+ * Bump allocator for draw tasks and other short-lived GUI allocations which
+ * never survive the frame. Each block is preceded by a header holding its
+ * size, so that realloc can move it out to the heap. Free only decreases the
+ * live count; the arena rewinds once all blocks are released.
+ */
+__in_section_unique(lvgl.noinit.malloc) __aligned(GUI_ARENA_ALIGN)
+	static uint8_t gui_arena_mem[CONFIG_UI_GUI_FRAME_ARENA_SIZE];
+
+static struct {
+	uint32_t offset;
+	uint32_t peak;
+	uint32_t live;
+	/* statistics */
+	uint32_t num_alloc;
+	uint32_t num_fallback;
+	uint32_t num_frame_leak;
+} gui_arena;
+
+static inline bool _is_in_arena(const void * ptr)
+{
+	const uint8_t *ptr8 = ptr;
+
+	return ptr8 >= gui_arena_mem && ptr8 < gui_arena_mem + CONFIG_UI_GUI_FRAME_ARENA_SIZE;
+}
+
+static size_t _arena_block_size(const void * ptr)
+{
+	return *(const uint32_t *)((const uint8_t *)ptr - GUI_ARENA_HDR_SIZE);
+}
+
+static void _arena_free(void)
+{
+	assert(gui_arena.live > 0);
+
+	if (--gui_arena.live == 0) {
+		gui_arena.offset = 0;
+	}
+}
+
+void * ui_mem_gui_frame_alloc(size_t size)
+{
+	uint32_t total = ROUND_UP(size, GUI_ARENA_ALIGN) + GUI_ARENA_HDR_SIZE;
+	uint8_t *hdr;
+
+	_assert_in_gui_tid("gui_frame_malloc");
+
+	if (size == 0 || total > CONFIG_UI_GUI_FRAME_ARENA_SIZE - gui_arena.offset) {
+		gui_arena.num_fallback++;
+		return sys_heap_alloc(&gui_heap, size);
+	}
+
+	hdr = gui_arena_mem + gui_arena.offset;
+	*(uint32_t *)hdr = size;
+
+	gui_arena.offset += total;
+	if (gui_arena.offset > gui_arena.peak) {
+		gui_arena.peak = gui_arena.offset;
+	}
+
+	gui_arena.live++;
+	gui_arena.num_alloc++;
+
+	return hdr + GUI_ARENA_HDR_SIZE;
+}
+
+void ui_mem_gui_frame_reset(void)
+{
+	_assert_in_gui_tid("gui_frame_reset");
+
+	/* the arena already rewound on the last free, nothing may survive a frame */
+	if (gui_arena.live > 0) {
+		gui_arena.num_frame_leak++;
+		assert(gui_arena.live == 0);
+	}
+}
+
+#endif /* CONFIG_UI_GUI_FRAME_ARENA_SIZE > 0 */
+
 int ui_mem_gui_init(void)
 {
 	sys_heap_init(&gui_heap, gui_heap_mem, CONFIG_UI_GUI_MEM_POOL_SIZE);
@@ -69,6 +154,24 @@ void * ui_mem_gui_realloc(void * ptr, size_t size)
 {
 	_assert_in_gui_tid("gui_realloc");
 
+#if defined(CONFIG_UI_GUI_FRAME_ARENA_SIZE) && CONFIG_UI_GUI_FRAME_ARENA_SIZE > 0
+	if (_is_in_arena(ptr)) {
+		void *new_ptr = NULL;
+
+		if (size > 0) {
+			new_ptr = sys_heap_alloc(&gui_heap, size);
+			if (new_ptr == NULL) {
+				return NULL;
+			}
+
+			memcpy(new_ptr, ptr, MIN(size, _arena_block_size(ptr)));
+		}
+
+		_arena_free();
+		return new_ptr;
+	}
+#endif
+
 	return sys_heap_realloc(&gui_heap, ptr, size);
 }
 
@@ -76,6 +179,13 @@ void ui_mem_gui_free(void * ptr)
 {
 	_assert_in_gui_tid("gui_free");
 
+#if defined(CONFIG_UI_GUI_FRAME_ARENA_SIZE) && CONFIG_UI_GUI_FRAME_ARENA_SIZE > 0
+	if (_is_in_arena(ptr)) {
+		_arena_free();
+		return;
+	}
+#endif
+
 	sys_heap_free(&gui_heap, ptr);
 }
 
@@ -87,6 +197,15 @@ size_t ui_mem_gui_get_size(void)
 void ui_mem_gui_dump(void)
 {
 	sys_heap_dump(&gui_heap);
+
+#if defined(CONFIG_UI_GUI_FRAME_ARENA_SIZE) && CONFIG_UI_GUI_FRAME_ARENA_SIZE > 0
+	os_printk("frame arena: size %u, used %u, peak %u, live %u\n",
+			CONFIG_UI_GUI_FRAME_ARENA_SIZE, gui_arena.offset,
+			gui_arena.peak, gui_arena.live);
+	os_printk("frame arena: alloc %u, fallback %u, frame leak %u\n",
+			gui_arena.num_alloc, gui_arena.num_fallback,
+			gui_arena.num_frame_leak);
+#endif
 }
 
 bool ui_mem_is_gui(const void * ptr)
@@ -94,6 +213,12 @@ bool ui_mem_is_gui(const void * ptr)
 	const uint8_t *gui_mem_end = gui_heap_mem + CONFIG_UI_GUI_MEM_POOL_SIZE;
 	const uint8_t *ptr8 = ptr;
 
+#if defined(CONFIG_UI_GUI_FRAME_ARENA_SIZE) && CONFIG_UI_GUI_FRAME_ARENA_SIZE > 0
+	if (_is_in_arena(ptr)) {
+		return true;
+	}
+#endif
+
 	return (ptr8 >= gui_heap_mem && ptr8 < gui_mem_end) ? true : false;
 }
 
@@ -101,6 +101,20 @@ typedef struct
     uint8_t ch_extend;
 }res_head_t;
 
+/*
+ * picture pack version 3 (aligned layout):
+ * - reserved[0] is log2 of the alignment applied to bitmap data, that is
+ *   entry offset + 4, for entries flagged RES_ENTRY_FLAG_UNCOMPRESSED
+ * - flagged entries store pixels with natural stride, exactly as loaded
+ *   into the bitmap pool, so they can be used in place from mmapped file
+ * - other entries are compressed as in version 2
+ */
+#define RES_PIC_VERSION_ALIGNED			3
+#define RES_ENTRY_FLAG_UNCOMPRESSED		0x80
+
+//mapped picture files, bitmaps in them are never freed
+#define RES_MMAP_MAX_WINDOWS			8
+
 typedef struct
 {
     uint32_t   offset;
@@ -167,7 +181,18 @@ extern res_string_item_t res_string_id_dic[];
 #endif
 
 extern int sd_fmap(const char *filename, void** addr, int *len);
+#if defined(CONFIG_RES_MANAGER_USE_STYLE_MMAP) && !defined(CONFIG_SIMULATOR)
+static struct
+{
+	uint8_t* addr;
+	uint32_t size;
+}res_mmap_windows[RES_MMAP_MAX_WINDOWS];
+static int _is_mmap_addr(const void* p);
+#endif
 static int _search_res_id_in_files(void* info, void* bitmap, uint32_t* bmp_pos, uint32_t* compress_size);
+#ifdef CONFIG_RES_MANAGER_DIRECT_MAP_BITMAP
+static int32_t _get_resource_bitmap_direct_map(void* data, void* bitmap_data);
+#endif
 
 void _resource_buffer_deinit(uint32_t force_clear)
 {
@@ -229,6 +254,7 @@ compact_buffer_t* _init_compact_buffer(uint32_t scene_id, uint32_t request_size)
 	compact_buffer_t* buffer;
 	compact_buffer_t* tail;
 	buf_block_t* item;
+	uint32_t prev_scene;
 
 	buffer = (compact_buffer_t*)res_array_alloc(RES_MEM_SIMPLE_COMPACT, sizeof(compact_buffer_t));
 	if(buffer == NULL)
@@ -237,6 +263,7 @@ compact_buffer_t* _init_compact_buffer(uint32_t scene_id, uint32_t request_size)
 		return NULL;
 	}
 
+	prev_scene = res_mem_set_scene(scene_id);
 #ifdef CONFIG_RES_MANAGER_ALIGN
 	buffer->addr = (uint8_t*)res_mem_aligned_alloc(RES_MEM_POOL_BMP, res_mem_align, request_size);
 #else
@@ -253,6 +280,7 @@ compact_buffer_t* _init_compact_buffer(uint32_t scene_id, uint32_t request_size)
 		buffer->addr = res_mem_alloc_block(screen_bitmap_size, __func__);
 		if(buffer->addr == NULL)
 		{
+			res_mem_set_scene(prev_scene);
 			SYS_LOG_INF("no extra sapce for scene 0x%x\n", scene_id);
 			res_array_free(buffer);
 			res_manager_dump_info();
@@ -266,6 +294,7 @@ compact_buffer_t* _init_compact_buffer(uint32_t scene_id, uint32_t request_size)
 	{
 		buffer->free_size = request_size;
 	}
+	res_mem_set_scene(prev_scene);
 
 	//init first item block to prevent false check
 	item = (buf_block_t*)buffer->addr;
@@ -885,12 +914,16 @@ static int32_t _get_resource_bitmap_map(void* data, void* bitmap_data, uint16_t
 	&& format != RESOURCE_BITMAP_FORMAT_INDEX4
 	 )
 	{
+#ifdef CONFIG_RES_MANAGER_DIRECT_MAP_BITMAP
+		return _get_resource_bitmap_direct_map(data, bitmap_data);
+#else
 		return -1;
+#endif
 	}
 
 
 #ifndef CONFIG_SIMULATOR
-	if(info->pic_res_mmap_addr == NULL)
+	if(info->pic_res_mmap_addr == NULL || !_is_mmap_addr(info->pic_res_mmap_addr))
 	{
 		SYS_LOG_INF("info->pic_res_mmap_addr %p\n", info->pic_res_mmap_addr);
 		return -1;
@@ -934,6 +967,50 @@ static int32_t _get_resource_bitmap_map(void* data, void* bitmap_data, uint16_t
 
 }
 
+#ifdef CONFIG_RES_MANAGER_DIRECT_MAP_BITMAP
+static int32_t _get_resource_bitmap_direct_map(void* data, void* bitmap_data)
+{
+#ifndef CONFIG_SIMULATOR
+#ifndef CONFIG_RES_MANAGER_IMG_DECODER
+	resource_info_t* info = (resource_info_t*)data;
+	resource_bitmap_t* bitmap = (resource_bitmap_t*)bitmap_data;
+#else
+	res_bin_info_t* info = (res_bin_info_t*)data;
+	style_bitmap_t* bitmap = (style_bitmap_t*)bitmap_data;
+#endif
+	int32_t ret;
+	uint32_t compress_size = 0;
+	uint32_t bmp_pos = 0;
+	uint8_t* addr;
+
+	//frees skip only bitmaps in a tracked window
+	if(info->pic_res_mmap_addr == NULL || !_is_mmap_addr(info->pic_res_mmap_addr))
+	{
+		return -1;
+	}
+
+	//only uncompressed bitmaps in the mapped main picture file
+	ret = _search_res_id_in_files(info, bitmap, &bmp_pos, &compress_size);
+	if(ret != 0 || compress_size != 0)
+	{
+		return -1;
+	}
+
+	addr = info->pic_res_mmap_addr + bmp_pos;
+	if(((uintptr_t)addr & (res_mem_align - 1)) != 0)
+	{
+		//not packed with aligned layout, copy into bitmap pool
+		return -1;
+	}
+
+	bitmap->buffer = addr;
+	return 0;
+#else
+	return -1;
+#endif
+}
+#endif //CONFIG_RES_MANAGER_DIRECT_MAP_BITMAP
+
 
 uint32_t _check_bitmap_in_compact_buffer(void* p)
 {
@@ -982,6 +1059,12 @@ void _free_resource_bitmap_buffer(void *p)
 		return;
 	}
 #endif
+#elif defined(CONFIG_RES_MANAGER_USE_STYLE_MMAP)
+	if(_is_mmap_addr(p))
+	{
+		//used in place from mapped file
+		return;
+	}
 #endif
 
 	while(item != NULL)
@@ -1120,13 +1203,66 @@ static void _init_pic_mmap_addr(void* data, const char* picres_path)
 	res_bin_info_t* info = (res_bin_info_t*)data;
 #endif	 //CONFIG_RES_MANAGER_IMG_DECODER
 
-	uint32_t res_size;
+	uint32_t res_size = 0;
+	int i;
+
+	if(sd_fmap(picres_path, (void**)&info->pic_res_mmap_addr, &res_size) < 0)
+	{
+		return;
+	}
+
+	for(i=0;i<RES_MMAP_MAX_WINDOWS;i++)
+	{
+		if(res_mmap_windows[i].addr == info->pic_res_mmap_addr)
+		{
+			res_mmap_windows[i].size = MAX(res_mmap_windows[i].size, res_size);
+			return;
+		}
+
+		if(res_mmap_windows[i].addr == NULL)
+		{
+			res_mmap_windows[i].addr = info->pic_res_mmap_addr;
+			res_mmap_windows[i].size = res_size;
+			return;
+		}
+	}
 
-	sd_fmap(picres_path, (void**)&info->pic_res_mmap_addr, &res_size);
+	//bitmaps of it are copied, compressed data is still read in place
+	SYS_LOG_ERR("too many mapped picture files %s\n", picres_path);
 #endif //CONFIG_SIMULATOR
 #endif //CONFIG_RES_MANAGER_USE_STYLE_MMAP
 }
 
+#if defined(CONFIG_RES_MANAGER_USE_STYLE_MMAP) && !defined(CONFIG_SIMULATOR)
+static int _is_mmap_addr(const void* p)
+{
+	int i;
+
+	for(i=0;i<RES_MMAP_MAX_WINDOWS && res_mmap_windows[i].addr != NULL;i++)
+	{
+		if((const uint8_t*)p >= res_mmap_windows[i].addr
+			&& (const uint8_t*)p < res_mmap_windows[i].addr + res_mmap_windows[i].size)
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
+#endif
+
+
+static uint32_t _get_pic_entry_compress_size(res_head_t* res_head, res_entry_t* entry)
+{
+	if(res_head->version >= RES_PIC_VERSION_ALIGNED && (entry->type & RES_ENTRY_FLAG_UNCOMPRESSED))
+	{
+		//stored uncompressed, read by bitmap size or used in place
+		return 0;
+	}
+
+	//skip 4 bytes before bitmap data, which are metric params
+	return ((entry->len_ext << 16) | entry->length) - 4;
+}
 
 static int _init_pic_search_param(void* data, const char* picres_path)
 {
@@ -1266,12 +1402,16 @@ static int _init_pic_search_param(void* data, const char* picres_path)
 				return -1;
 			}
 
-			SYS_LOG_INF("id start %d, id_end %d\n", info->pic_search_param[i].id_start, info->pic_search_param[i].id_end);
+			SYS_LOG_INF("id start %d, id_end %d, version %d\n", info->pic_search_param[i].id_start, info->pic_search_param[i].id_end, res_head.version);
+			if(res_head.version >= RES_PIC_VERSION_ALIGNED && (1 << res_head.reserved[0]) < res_mem_align)
+			{
+				SYS_LOG_INF("pic pack aligned to %d, less than %d\n", 1 << res_head.reserved[0], (int)res_mem_align);
+			}
 			for(k=0;k<res_head.counts;k++)
 			{
 				//skip 4 bytes before bitmap data, which are metric params
 				info->pic_search_param[i].pic_offsets[k]= entry[k].offset+4;
-				info->pic_search_param[i].compress_size[k] = ((entry[k].len_ext << 16) | entry[k].length) - 4;
+				info->pic_search_param[i].compress_size[k] = _get_pic_entry_compress_size(&res_head, &entry[k]);
 			}
 			res_mem_free(RES_MEM_POOL_BMP, entry);
 		}
@@ -1335,13 +1475,17 @@ static int _init_pic_search_param(void* data, const char* picres_path)
 				return -1;
 			}
 
-			SYS_LOG_INF("id start %d, id_end %d\n", info->pic_search_param[i].id_start, info->pic_search_param[i].id_end);
+			SYS_LOG_INF("id start %d, id_end %d, version %d\n", info->pic_search_param[i].id_start, info->pic_search_param[i].id_end, res_head.version);
+			if(res_head.version >= RES_PIC_VERSION_ALIGNED && (1 << res_head.reserved[0]) < res_mem_align)
+			{
+				SYS_LOG_INF("pic pack aligned to %d, less than %d\n", 1 << res_head.reserved[0], (int)res_mem_align);
+			}
 
 			for(k=0;k<res_head.counts;k++)
 			{
 				//skip 4 bytes before bitmap data, which are metric params
 				info->pic_search_param[i].pic_offsets[k]= entry[k].offset+4;
-				info->pic_search_param[i].compress_size[k] = ((entry[k].len_ext << 16) | entry[k].length) - 4;
+				info->pic_search_param[i].compress_size[k] = _get_pic_entry_compress_size(&res_head, &entry[k]);
 			}
 			res_mem_free(RES_MEM_POOL_BMP, entry);
 		}
@@ -1948,7 +2092,9 @@ resource_scene_t* res_manager_load_scene(resource_info_t* info, uint32_t scene_i
     	//SYS_LOG_INF("scene_item 0x%x\n", scenes[i].scene_id);
         if ( scenes[i].scene_id == scene_id )
         {
-
+			/* group children, picregion frames and single bitmaps loaded
+			 * later on this thread carry no scene, account them here */
+			res_mem_set_scene(scene_id);
 			return &scenes[i];
         }
     }
@@ -2167,6 +2313,15 @@ void _unload_scene(uint32_t id, resource_scene_t* scene)
 
 void res_manager_unload_scene(uint32_t id, resource_scene_t* scene)
 {
+	uint32_t prev_scene;
+
+	/* leave the scene if the thread is still in it */
+	prev_scene = res_mem_set_scene(0);
+	if(prev_scene != id)
+	{
+		res_mem_set_scene(prev_scene);
+	}
+
 	if(scene != NULL)
 	{
 		_unload_scene(id, scene);
@@ -2408,7 +2563,21 @@ int32_t _load_bitmap(resource_info_t* info, resource_bitmap_t* bitmap, uint32_t
 	}
 	else
 	{
+#if !defined(CONFIG_RES_MANAGER_USE_STYLE_MMAP)||defined(CONFIG_SIMULATOR)
 		ret = fs_read(pic_fp, bitmap->buffer, bmp_size);
+#else
+		//fs position is not set when mmapped
+		if(pic_fp == &info->pic_fp && info->pic_res_mmap_addr != NULL)
+		{
+			memcpy(bitmap->buffer, info->pic_res_mmap_addr + bmp_pos, bmp_size);
+			ret = bmp_size;
+		}
+		else
+		{
+			fs_seek(pic_fp, bmp_pos, FS_SEEK_SET);
+			ret = fs_read(pic_fp, bitmap->buffer, bmp_size);
+		}
+#endif
 		os_strace_end_call_u32(SYS_TRACE_ID_RES_BMP_LOAD_1, (uint32_t)bitmap->sty_data->id);
 	}
 
@@ -2516,7 +2685,7 @@ uint32_t _check_resource_is_regular(uint32_t res_magic, uint32_t res_sty_id)
 	return 0;
 }
 
-void* res_manager_get_scene_child(resource_info_t* res_info, resource_scene_t* scene, uint32_t id)
+static void* _get_scene_child(resource_info_t* res_info, resource_scene_t* scene, uint32_t id)
 {
     uint32_t i;
     resource_t* resource;
@@ -2628,6 +2797,23 @@ void* res_manager_get_scene_child(resource_info_t* res_info, resource_scene_t* s
 	return NULL;
 }
 
+void* res_manager_get_scene_child(resource_info_t* res_info, resource_scene_t* scene, uint32_t id)
+{
+	uint32_t prev_scene;
+	void* res;
+
+	if ( scene == NULL )
+	{
+		SYS_LOG_INF("null scene \n");
+		return NULL;
+	}
+
+	prev_scene = res_mem_set_scene(scene->scene_id);
+	res = _get_scene_child(res_info, scene, id);
+	res_mem_set_scene(prev_scene);
+	return res;
+}
+
 void* res_manager_get_group_child(resource_info_t* res_info, resource_group_t* resgroup, uint32_t id )
 {
     unsigned int i;
@@ -2850,9 +3036,12 @@ int32_t res_manager_preload_bitmap(resource_info_t* res_info, resource_bitmap_t*
 int32_t res_manager_preload_bitmap_compact(uint32_t scene_id, resource_info_t* res_info, resource_bitmap_t* bitmap)
 {
 	int32_t ret;
+	uint32_t prev_scene;
 
 //	SYS_LOG_INF("\n res_manager_preload_bitmap_compact scene_id 0x%x\n", scene_id);
+	prev_scene = res_mem_set_scene(scene_id);
 	ret = _load_bitmap(res_info, bitmap, scene_id);
+	res_mem_set_scene(prev_scene);
 	if(ret < 0)
 	{
 		SYS_LOG_INF("preload bitmap compact error scene 0x%x, 0x%x\n", scene_id, bitmap->sty_data->id);
@@ -2906,7 +3095,7 @@ int32_t res_manager_init_compact_buffer(uint32_t scene_id, size_t size)
 	return 0;
 }
 
-void* res_manager_preload_from_scene(resource_info_t* res_info, resource_scene_t* scene, uint32_t id)
+static void* _preload_from_scene(resource_info_t* res_info, resource_scene_t* scene, uint32_t id)
 {
 	uint32_t i;
 	resource_t* resource;
@@ -3002,7 +3191,24 @@ void* res_manager_preload_from_scene(resource_info_t* res_info, resource_scene_t
 	return NULL;
 }
 
-resource_bitmap_t* res_manager_preload_from_group(resource_info_t* res_info, resource_group_t* group, uint32_t scene_id, uint32_t id)
+void* res_manager_preload_from_scene(resource_info_t* res_info, resource_scene_t* scene, uint32_t id)
+{
+	uint32_t prev_scene;
+	void* res;
+
+	if ( scene == NULL )
+	{
+		SYS_LOG_INF("%s %d: null scene to preload \n", __func__, __LINE__);
+		return NULL;
+	}
+
+	prev_scene = res_mem_set_scene(scene->scene_id);
+	res = _preload_from_scene(res_info, scene, id);
+	res_mem_set_scene(prev_scene);
+	return res;
+}
+
+static resource_bitmap_t* _preload_from_group(resource_info_t* res_info, resource_group_t* group, uint32_t scene_id, uint32_t id)
 {
 	uint32_t i;
 	resource_t* resource;
@@ -3069,6 +3275,17 @@ resource_bitmap_t* res_manager_preload_from_group(resource_info_t* res_info, res
 
 }
 
+resource_bitmap_t* res_manager_preload_from_group(resource_info_t* res_info, resource_group_t* group, uint32_t scene_id, uint32_t id)
+{
+	uint32_t prev_scene;
+	resource_bitmap_t* bitmap;
+
+	prev_scene = res_mem_set_scene(scene_id);
+	bitmap = _preload_from_group(res_info, group, scene_id, id);
+	res_mem_set_scene(prev_scene);
+	return bitmap;
+}
+
 resource_bitmap_t* res_manager_preload_from_picregion(resource_info_t* res_info, resource_picregion_t* picreg, uint32_t frame)
 {
 	resource_bitmap_t* bitmap;
@@ -3096,7 +3313,7 @@ resource_bitmap_t* res_manager_preload_from_picregion(resource_info_t* res_info,
 }
 
 
-void* res_manager_preload_next_group_child(resource_info_t * info, resource_group_t* group, int* count, uint32_t* offset, uint32_t scene_id, uint32_t pargroup_id)
+static void* _preload_next_group_child(resource_info_t * info, resource_group_t* group, int* count, uint32_t* offset, uint32_t scene_id, uint32_t pargroup_id)
 {
     resource_t* resource;
 	char* buf = NULL;   //地址不对齐，不能用数据类型指针。
@@ -3191,7 +3408,18 @@ void* res_manager_preload_next_group_child(resource_info_t * info, resource_grou
 	return NULL;
 }
 
-void* res_manager_preload_next_scene_child(resource_info_t* info, resource_scene_t* scene, uint32_t* count, uint32_t* offset)
+void* res_manager_preload_next_group_child(resource_info_t * info, resource_group_t* group, int* count, uint32_t* offset, uint32_t scene_id, uint32_t pargroup_id)
+{
+	uint32_t prev_scene;
+	void* res;
+
+	prev_scene = res_mem_set_scene(scene_id);
+	res = _preload_next_group_child(info, group, count, offset, scene_id, pargroup_id);
+	res_mem_set_scene(prev_scene);
+	return res;
+}
+
+static void* _preload_next_scene_child(resource_info_t* info, resource_scene_t* scene, uint32_t* count, uint32_t* offset)
 {
     resource_t* resource;
 	uint8_t* buf = NULL;   //地址不对齐，不能用数据类型指针。
@@ -3284,6 +3512,23 @@ void* res_manager_preload_next_scene_child(resource_info_t* info, resource_scene
 	return NULL;
 }
 
+void* res_manager_preload_next_scene_child(resource_info_t* info, resource_scene_t* scene, uint32_t* count, uint32_t* offset)
+{
+	uint32_t prev_scene;
+	void* res;
+
+	if(scene == NULL)
+	{
+		SYS_LOG_INF("invalid param for res_manager_preload_next_scene_child\n");
+		return NULL;
+	}
+
+	prev_scene = res_mem_set_scene(scene->scene_id);
+	res = _preload_next_scene_child(info, scene, count, offset);
+	res_mem_set_scene(prev_scene);
+	return res;
+}
+
 void res_manager_preload_finish_check(uint32_t scene_id)
 {
 	compact_buffer_t* buffer;
@@ -3432,7 +3677,21 @@ static int32_t _load_bitmap_for_decoder(style_bitmap_t* bitmap)
 	}
 	else
 	{
+#if !defined(CONFIG_RES_MANAGER_USE_STYLE_MMAP)||defined(CONFIG_SIMULATOR)
 		ret = fs_read(pic_fp, bitmap->buffer, bmp_size);
+#else
+		//fs position is not set when mmapped
+		if(pic_fp == &info->pic_fp && info->pic_res_mmap_addr != NULL)
+		{
+			memcpy(bitmap->buffer, info->pic_res_mmap_addr + bmp_pos, bmp_size);
+			ret = bmp_size;
+		}
+		else
+		{
+			fs_seek(pic_fp, bmp_pos, FS_SEEK_SET);
+			ret = fs_read(pic_fp, bitmap->buffer, bmp_size);
+		}
+#endif
 	}
 
 	if(ret < bmp_size)
@@ -3477,6 +3736,13 @@ int res_manager_load_bitmap_for_decoder(style_bitmap_t* bitmap)
 
 void res_manager_free_bitmap_for_decoder(void* ptr)
 {
+#if defined(CONFIG_RES_MANAGER_USE_STYLE_MMAP) && !defined(CONFIG_SIMULATOR)
+	if(_is_mmap_addr(ptr))
+	{
+		//used in place from mapped file
+		return;
+	}
+#endif
 	res_mem_free(RES_MEM_POOL_BMP, ptr);
 }
 
@@ -24,13 +24,6 @@
 #define RES_DEBUG_LOAD_BMP					0
 #define RES_PRELOAD_MAX_BLOCK_SIZE		100*1024
 
-typedef struct _mem_info
-{
-	void* ptr;
-	size_t size;
-	struct _mem_info* next;
-}mem_info_t;
-
 static uint32_t res_mem_peak = 0;
 
 static uint8_t* block_mem = NULL;
@@ -38,94 +31,307 @@ static uint32_t block_size = 0;
 static uint32_t block_num = 0;
 static uint32_t block_stat = 0;
 
-#ifdef RES_MEM_PEAK_STATISTIC
-static mem_info_t* mem_info_list = NULL;
+#ifdef CONFIG_RES_MANAGER_MEM_STATISTIC
+#define RES_MEM_PEAK_STATISTIC
+
+#define RES_MEM_STAT_SLOTS			CONFIG_RES_MANAGER_MEM_STATISTIC_SLOTS
+#define RES_MEM_STAT_SCENES			8
+
+#define RES_MEM_SCENE_THREADS		4
+
+/*
+ * Live allocations are kept in an open addressing table hashed by pointer,
+ * so add and remove are O(1) on average. Slot 0 of the scene table counts
+ * allocations made outside of any scene.
+ *
+ * The scene is kept per thread, the UI and the preload thread load for
+ * different scenes at the same time.
+ */
+typedef struct _mem_info
+{
+	void* ptr;
+	uint32_t size;
+	uint8_t type;
+	uint8_t scene;
+}mem_info_t;
+
+typedef struct
+{
+	uint32_t scene_id;
+	uint32_t total;
+	uint32_t peak;
+}mem_scene_stat_t;
+
+typedef struct
+{
+	os_tid_t tid;
+	uint8_t scene;
+}mem_thread_scene_t;
+
+static mem_info_t mem_info_table[RES_MEM_STAT_SLOTS];
+static uint32_t mem_info_count = 0;
+static uint32_t mem_info_untracked = 0;
+static uint32_t mem_info_untracked_scene = 0;
 static uint32_t res_mem_total = 0;
+static uint32_t res_mem_type_total[RES_MEM_POOL_TYPE_MAX];
+static uint32_t res_mem_type_peak[RES_MEM_POOL_TYPE_MAX];
+static mem_scene_stat_t res_mem_scene_stat[RES_MEM_STAT_SCENES];
+static mem_thread_scene_t res_mem_thread_scene[RES_MEM_SCENE_THREADS];
 
+static inline uint32_t _mem_info_hash(const void* ptr)
+{
+	return (((uint32_t)ptr >> 2) * 2654435761u) % RES_MEM_STAT_SLOTS;
+}
+
+/* called with irq locked */
+static mem_thread_scene_t* _find_thread_scene(os_tid_t tid)
+{
+	int i;
+
+	for(i = 0; i < RES_MEM_SCENE_THREADS; i++)
+	{
+		if(res_mem_thread_scene[i].tid == tid)
+		{
+			return &res_mem_thread_scene[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* called with irq locked */
+static uint8_t _get_thread_scene(void)
+{
+	mem_thread_scene_t* thread = _find_thread_scene(os_current_get());
+
+	return thread ? thread->scene : 0;
+}
 
-void _add_mem_info(void* ptr, size_t size)
+void _add_mem_info(void* ptr, size_t size, uint32_t type)
 {
-	mem_info_t* prev = NULL;
-	mem_info_t* listp = NULL;
 	mem_info_t* item;
+	mem_scene_stat_t* scene;
+	uint32_t i;
+	unsigned int key;
 
-	//item = mem_malloc(sizeof(mem_info_t));
-	item = (mem_info_t*)res_array_alloc(RES_MEM_SIMPLE_INNER, sizeof(mem_info_t));
-	if(item == NULL)
+	if(type >= RES_MEM_POOL_TYPE_MAX)
 	{
-		SYS_LOG_ERR("no ram for res mem info\n");
-		return;
+		type = RES_MEM_POOL_BMP;
 	}
-	item->ptr = ptr;
-	item->size = size;
-	item->next = NULL;
 
-	listp = mem_info_list;
-	if(mem_info_list == NULL)
+	key = os_irq_lock();
+
+	/* keep one slot empty so that probing always terminates */
+	if(mem_info_count >= RES_MEM_STAT_SLOTS - 1)
 	{
-		mem_info_list = item;
+		mem_info_untracked++;
+		os_irq_unlock(key);
+		return;
 	}
-	else
+
+	i = _mem_info_hash(ptr);
+	while(mem_info_table[i].ptr != NULL)
 	{
-		while(listp != NULL)
-		{
-			prev = listp;
-			listp = listp->next;
-		}
-		prev->next = item;
+		i = (i + 1) % RES_MEM_STAT_SLOTS;
 	}
 
+	item = &mem_info_table[i];
+	item->ptr = ptr;
+	item->size = size;
+	item->type = type;
+	item->scene = _get_thread_scene();
+	mem_info_count++;
+
 	res_mem_total += size;
 	if(res_mem_total > res_mem_peak)
 	{
 		res_mem_peak = res_mem_total;
 	}
-	//SYS_LOG_INF("testalloc alloc == ptr 0x%x, size %d, total %d, peak %d\n", ptr, size, res_mem_total, res_mem_peak);
 
+	res_mem_type_total[type] += size;
+	if(res_mem_type_total[type] > res_mem_type_peak[type])
+	{
+		res_mem_type_peak[type] = res_mem_type_total[type];
+	}
+
+	scene = &res_mem_scene_stat[item->scene];
+	scene->total += size;
+	if(scene->total > scene->peak)
+	{
+		scene->peak = scene->total;
+	}
+
+	os_irq_unlock(key);
 }
 
 void _remove_mem_info(void* ptr)
 {
-	mem_info_t* prev;
-	mem_info_t* listp;
 	mem_info_t* item;
+	uint32_t i, j, k;
+	unsigned int key;
+
+	if(ptr == NULL)
+	{
+		return;
+	}
+
+	key = os_irq_lock();
+
+	i = _mem_info_hash(ptr);
+	while(mem_info_table[i].ptr != ptr)
+	{
+		if(mem_info_table[i].ptr == NULL)
+		{
+			os_irq_unlock(key);
+			if(mem_info_untracked == 0)
+			{
+				SYS_LOG_ERR("testalloc remove mem info not found %p\n", ptr);
+			}
+			return;
+		}
+		i = (i + 1) % RES_MEM_STAT_SLOTS;
+	}
+
+	item = &mem_info_table[i];
+	res_mem_total -= item->size;
+	res_mem_type_total[item->type] -= item->size;
+	res_mem_scene_stat[item->scene].total -= item->size;
 
-	listp = mem_info_list;
-	prev = NULL;
-	while(listp != NULL)
+	/* backward shift the following entries of the probe sequence */
+	j = i;
+	while(1)
 	{
-		if(listp->ptr == ptr)
+		j = (j + 1) % RES_MEM_STAT_SLOTS;
+		if(mem_info_table[j].ptr == NULL)
 		{
 			break;
 		}
-		prev = listp;
-		listp = listp->next;
+
+		k = _mem_info_hash(mem_info_table[j].ptr);
+		if((j > i && (k <= i || k > j)) || (j < i && k <= i && k > j))
+		{
+			mem_info_table[i] = mem_info_table[j];
+			i = j;
+		}
 	}
 
-	if(listp == NULL)
+	mem_info_table[i].ptr = NULL;
+	mem_info_count--;
+
+	os_irq_unlock(key);
+}
+
+/* called with irq locked, a slot a thread is in may not be reused */
+static bool _scene_is_current(uint8_t scene)
+{
+	int i;
+
+	for(i = 0; i < RES_MEM_SCENE_THREADS; i++)
 	{
-		SYS_LOG_ERR("testalloc remove mem info not found %p\n", ptr);
-		return;
+		if(res_mem_thread_scene[i].tid != 0 && res_mem_thread_scene[i].scene == scene)
+		{
+			return true;
+		}
 	}
 
-	item = listp;
+	return false;
+}
+
+uint32_t res_mem_set_scene(uint32_t scene_id)
+{
+	mem_thread_scene_t* thread;
+	uint32_t prev_id;
+	uint8_t scene = 0;
+	int free_slot = -1;
+	int i;
+	unsigned int key;
+
+	key = os_irq_lock();
 
+	thread = _find_thread_scene(os_current_get());
+	prev_id = thread ? res_mem_scene_stat[thread->scene].scene_id : 0;
 
-	if(prev == NULL)
+	if(scene_id > 0)
 	{
-		mem_info_list = listp->next;
-		res_mem_total -= item->size;
-		//SYS_LOG_INF("testalloc free == item 0x%x, ptr 0x%x size %d, total %d, peak %d\n", item, item->ptr, item->size, res_mem_total, res_mem_peak);
-		res_array_free(item);
+		for(i = 1; i < RES_MEM_STAT_SCENES; i++)
+		{
+			if(res_mem_scene_stat[i].scene_id == scene_id)
+			{
+				scene = i;
+				break;
+			}
+
+			if(free_slot < 0 && res_mem_scene_stat[i].total == 0 &&
+				!_scene_is_current(i))
+			{
+				free_slot = i;
+			}
+		}
+
+		/* reuse the slot of an unloaded scene, or count as no scene */
+		if(scene == 0 && free_slot > 0)
+		{
+			res_mem_scene_stat[free_slot].scene_id = scene_id;
+			res_mem_scene_stat[free_slot].peak = 0;
+			scene = free_slot;
+		}
+	}
+
+	if(scene == 0)
+	{
+		/* a thread out of any scene needs no slot */
+		if(thread)
+		{
+			thread->tid = 0;
+		}
 	}
 	else
 	{
-		prev->next = listp->next;
-		res_mem_total -= item->size;
-		//SYS_LOG_INF("testalloc free == item 0x%x, ptr 0x%x size %d, total %d, peak %d\n", item, item->ptr, item->size, res_mem_total, res_mem_peak);
-		res_array_free(item);
+		if(thread == NULL)
+		{
+			thread = _find_thread_scene(0);
+		}
+
+		if(thread)
+		{
+			thread->tid = os_current_get();
+			thread->scene = scene;
+		}
+		else
+		{
+			mem_info_untracked_scene++;
+		}
+	}
+
+	os_irq_unlock(key);
+
+	return prev_id;
+}
+
+static void _dump_mem_info(void)
+{
+	static const char* type_names[RES_MEM_POOL_TYPE_MAX] = { "bmp", "txt", "scene" };
+	int i;
+
+	SYS_LOG_INF("res mem total %d, peak %d, live %d, untracked %d, no scene slot %d\n",
+		res_mem_total, res_mem_peak, mem_info_count, mem_info_untracked,
+		mem_info_untracked_scene);
+
+	for(i = 0; i < RES_MEM_POOL_TYPE_MAX; i++)
+	{
+		SYS_LOG_INF("res mem type %s: total %d, peak %d\n",
+			type_names[i], res_mem_type_total[i], res_mem_type_peak[i]);
 	}
 
+	for(i = 0; i < RES_MEM_STAT_SCENES; i++)
+	{
+		if(res_mem_scene_stat[i].peak > 0)
+		{
+			SYS_LOG_INF("res mem scene 0x%x: total %d, peak %d\n",
+				res_mem_scene_stat[i].scene_id, res_mem_scene_stat[i].total,
+				res_mem_scene_stat[i].peak);
+		}
+	}
 }
 #endif
 
@@ -263,9 +469,8 @@ void *res_mem_alloc_debug(uint32_t type, size_t size, const char *func)
 #ifdef RES_MEM_PEAK_STATISTIC
 	if(ptr != NULL)
 	{
-		_add_mem_info(ptr, size);
-	
-}
+		_add_mem_info(ptr, size, type);
+	}
 #endif	
 	return ptr;
 }
@@ -280,7 +485,23 @@ void res_mem_free(uint32_t type, void *ptr)
 
 void *res_mem_realloc_debug(uint32_t type, void *ptr, size_t requested_size, const char* func)
 {
-	return ui_mem_realloc(MEM_RES, ptr, requested_size, func);
+	void* new_ptr;
+
+	new_ptr = ui_mem_realloc(MEM_RES, ptr, requested_size, func);
+#ifdef RES_MEM_PEAK_STATISTIC
+	if(new_ptr != NULL || requested_size == 0)
+	{
+		if(ptr != NULL)
+		{
+			_remove_mem_info(ptr);
+		}
+		if(new_ptr != NULL)
+		{
+			_add_mem_info(new_ptr, requested_size, type);
+		}
+	}
+#endif
+	return new_ptr;
 }
 
 void * res_mem_aligned_alloc_debug(uint8_t type, size_t align, size_t size, const void* caller)
@@ -290,7 +511,7 @@ void * res_mem_aligned_alloc_debug(uint8_t type, size_t align, size_t size, cons
 #ifdef RES_MEM_PEAK_STATISTIC
 	if(ptr != NULL)
 	{
-		_add_mem_info(ptr, size);
+		_add_mem_info(ptr, size, type);
 	}
 #endif	
 	return ptr;
@@ -308,6 +529,9 @@ size_t res_mem_get_align(void)
 void res_mem_dump(void)
 {
 	ui_mem_dump(MEM_RES);
+#ifdef RES_MEM_PEAK_STATISTIC
+	_dump_mem_info();
+#endif
 }
 
 int res_is_auto_search_files(void)
@@ -103,6 +103,23 @@ void res_mem_free_block(void* ptr);
 
 size_t res_mem_get_align(void);
 
+/**
+ * @brief Set the scene that following res buffer allocations of the calling
+ *        thread are accounted to
+ *
+ * @param scene_id scene id, 0 for allocations not belonging to a scene
+ *
+ * @retval the previous scene id.
+ */
+#ifdef CONFIG_RES_MANAGER_MEM_STATISTIC
+uint32_t res_mem_set_scene(uint32_t scene_id);
+#else
+static inline uint32_t res_mem_set_scene(uint32_t scene_id)
+{
+	return 0;
+}
+#endif
+
 
 #ifdef __cplusplus
 }
@@ -303,6 +303,10 @@ int surface_set_min_buffer_count(surface_t *surface, uint8_t min_count)
 
 		/* invalidate the new dirty area */
 		ui_region_set(&surface->dirty_area, 0, 0, surface->width - 1, surface->height - 1);
+#ifdef CONFIG_SURFACE_DIRTY_REGION_LIST
+		ui_region_list_init(&surface->dirty_list);
+		ui_region_list_add(&surface->dirty_list, &surface->dirty_area);
+#endif
 
 		SYS_LOG_DBG("buf count %d", surface->buf_count);
 	}
@@ -422,6 +426,9 @@ int surface_begin_frame(surface_t *surface)
 	}
 
 	ui_region_set(&surface->dirty_area, surface->width, surface->height, 0, 0);
+#ifdef CONFIG_SURFACE_DIRTY_REGION_LIST
+	ui_region_list_init(&surface->dirty_list);
+#endif
 
 #else
 	/* surface_update() may called in another thread, so synchronization is required */
@@ -630,6 +637,9 @@ static int _surface_end_draw_internal(surface_t *surface, const ui_region_t *are
 
 	/* post based on frame */
 	ui_region_merge(&surface->dirty_area, &surface->dirty_area, area);
+#ifdef CONFIG_SURFACE_DIRTY_REGION_LIST
+	ui_region_list_add(&surface->dirty_list, area);
+#endif
 
 	_surface_invoke_draw_ready(surface);
 
@@ -875,26 +885,40 @@ static void _surface_swapbuf(surface_t *surface)
 	graphic_buffer_t *backbuf = surface->buffers[surface->draw_idx];
 	graphic_buffer_t *frontbuf = surface->buffers[surface->draw_idx ? 0 : 1] ;
 	uint8_t *frontptr;
-	uint16_t pitch, stride;
-	uint8_t bytes_per_pixel;
+	uint16_t stride;
 
 #if defined(CONFIG_TRACING) && defined(CONFIG_UI_SERVICE)
 	ui_view_context_t *view = surface->user_data[SURFACE_CB_POST];
 	os_strace_u32(SYS_TRACE_ID_VIEW_SWAPBUF, view->entry->id);
 #endif
 
-	frontptr = (uint8_t *)graphic_buffer_get_bufptr(
-			frontbuf, surface->dirty_area.x1, surface->dirty_area.y1);
-	bytes_per_pixel = graphic_buffer_get_bits_per_pixel(frontbuf) / 8;
 	stride = graphic_buffer_get_stride(frontbuf);
-	pitch = stride * bytes_per_pixel;
 
 #ifdef CONFIG_DMA2D_HAL
 	surface->swapping = 1;
 	SYS_LOG_DBG("%p swap pending", surface);
 #endif /* CONFIG_DMA2D_HAL */
 
+#ifdef CONFIG_SURFACE_DIRTY_REGION_LIST
+	const ui_region_cost_t cost = {
+		.pixel_cost = 1,
+		.rect_cost = CONFIG_SURFACE_DIRTY_REGION_RECT_COST,
+	};
+
+	ui_region_list_coalesce(&surface->dirty_list, &cost);
+
+	for (int i = 0; i < surface->dirty_list.count; i++) {
+		const ui_region_t *rect = &surface->dirty_list.rects[i];
+
+		frontptr = (uint8_t *)graphic_buffer_get_bufptr(frontbuf, rect->x1, rect->y1);
+		_surface_buffer_copy(backbuf, rect, frontptr, surface->pixel_format, stride, 0);
+	}
+#else
+	frontptr = (uint8_t *)graphic_buffer_get_bufptr(
+			frontbuf, surface->dirty_area.x1, surface->dirty_area.y1);
+
 	_surface_buffer_copy(backbuf, &surface->dirty_area, frontptr, surface->pixel_format, stride, 0);
+#endif /* CONFIG_SURFACE_DIRTY_REGION_LIST */
 
 #if defined(CONFIG_TRACING) && defined(CONFIG_UI_SERVICE)
 	os_strace_end_call_u32(SYS_TRACE_ID_VIEW_SWAPBUF, view->entry->id);
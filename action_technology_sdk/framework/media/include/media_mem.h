@@ -150,6 +150,65 @@ void *media_mem_get_cache_pool(int mem_type, int stream_type);
  */
 int media_mem_get_cache_pool_size(int mem_type, int stream_type);
 
+/**
+ * @brief check two media scenes can run concurrently
+ *
+ * This routine provides to check the memory layouts of two stream types
+ * do not overlap, for example music and tts playing at the same time.
+ *
+ * @param stream_type1 indicator for first meida sence
+ * @param stream_type2 indicator for second meida sence
+ *
+ * @return true if no memory of the two scenes overlaps
+ */
+bool media_mem_check_concurrent(int stream_type1, int stream_type2);
+
+/**
+ * @brief check and dump media memory layout
+ *
+ * This routine provides to validate the memory layout of all stream types
+ * and print the usage of each backing region. Only available with
+ * CONFIG_MEDIA_MEM_CHECK.
+ *
+ * @return number of layout errors found
+ */
+#ifdef CONFIG_MEDIA_MEM_CHECK
+int media_mem_check_layout(void);
+#else
+static inline int media_mem_check_layout(void)
+{
+	return 0;
+}
+#endif
+
+/** planned buffer of a media scene */
+struct media_mem_layout_cell {
+	/** memory type @see cache_pool_type_e */
+	int mem_type;
+	/** memory type overlaid by this buffer, -1 if none */
+	int overlay_type;
+	/** name and size of the backing region */
+	const char *region;
+	uint32_t region_size;
+	/** place in the backing region */
+	uint32_t offset;
+	uint32_t size;
+};
+
+/**
+ * @brief get planned memory layout of a media scene
+ *
+ * This routine provides to get the buffers planned for a stream type, in
+ * plan order. Only available with CONFIG_MEDIA_MEM_CHECK.
+ *
+ * @param stream_type indicator for meida sence
+ * @param cells buffers of the layout
+ * @param num max number of cells
+ *
+ * @return number of cells, 0 if the stream type has no layout
+ */
+int media_mem_get_layout(int stream_type, struct media_mem_layout_cell *cells, int num);
+
 typedef enum {
 	MCU_MEMORY,
 	DSP_MEMORY,
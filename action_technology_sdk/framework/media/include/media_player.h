@@ -101,8 +101,14 @@ typedef struct {
 	uint8_t is_tws;
 	/** dvfs level */
 	uint8_t dvfs_level;
+	/** stream type of media player @see audio_stream_type_e */
+	uint8_t stream_type;
 	/** handle of media service*/
 	void *media_srv_handle;
+#ifdef CONFIG_MEDIA_SEEK_TABLE
+	/** seek table of local music @see media_seek_table_open */
+	void *seek_table;
+#endif
 } media_player_t;
 
 /** media voice effect mode */
@@ -190,6 +196,23 @@ int media_player_resume(media_player_t *handle);
  */
 int media_player_seek(media_player_t *handle, media_seek_info_t *info);
 
+#ifdef CONFIG_MEDIA_SEEK_TABLE
+/**
+ * @brief set seek table for media player
+ *
+ * This routine provides to set seek table of the playing file, seeks
+ * without file offset then start from its nearest point, and the exact
+ * positions of seeks and breakpoints are added to it.
+ * the table is still owned by caller, set NULL before closing it.
+ *
+ * @param handle handle of media player
+ * @param seek_table handle of seek table @see media_seek_table_open
+ *
+ * @return 0 excute successed , others failed
+ */
+int media_player_set_seek_table(media_player_t *handle, void *seek_table);
+#endif
+
 /**
  * @brief stop for media player
  *
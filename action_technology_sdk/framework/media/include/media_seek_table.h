@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2016 Actions Semi Co., Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief media seek table.
+*/
+#ifndef __MEDIA_SEEK_TABLE_H__
+#define __MEDIA_SEEK_TABLE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <media_service.h>
+
+/** max distance of a table point from the target of a seek or resume, ms */
+#define MEDIA_SEEK_TABLE_TOLERANCE	300
+
+/**
+ * @defgroup media_seek_table_apis Media Seek Table APIs
+ * @{
+ */
+
+/**
+ * @brief open seek table of a local music file
+ *
+ * Loads the table of the file from the cache under
+ * CONFIG_MEDIA_SEEK_TABLE_CACHE_DIR, or builds it from the stream header
+ * (FLAC SEEKTABLE or MP3 VBRI table, Xing tag for the duration only).
+ *
+ * @param url url of the file
+ * @param format media format of the file @see media_type_e
+ *
+ * @return handle of seek table, NULL if format not supported or no memory
+ */
+void *media_seek_table_open(const char *url, uint8_t format);
+
+/**
+ * @brief close seek table, saving it to the cache if points were added
+ *
+ * @param handle handle of seek table
+ */
+void media_seek_table_close(void *handle);
+
+/**
+ * @brief find the seek point nearest to a time
+ *
+ * @param handle handle of seek table
+ * @param time_ms target time in ms
+ * @param max_err_ms max distance of the point from time_ms in ms
+ * @param bp address to store time and file offset of the seek point
+ *
+ * @return 0 found, -ENOENT no point within max_err_ms of time_ms
+ */
+int media_seek_table_find(void *handle, int time_ms, int max_err_ms,
+		media_breakpoint_info_t *bp);
+
+/**
+ * @brief add exact seek point reported by the parser after a seek
+ *
+ * @param handle handle of seek table
+ * @param time_ms time of the chunk in ms
+ * @param file_offset file offset of the chunk in bytes
+ */
+void media_seek_table_add(void *handle, int time_ms, int file_offset);
+
+/**
+ * @brief add playing breakpoint as seek point, if consistent for the format
+ *
+ * @param handle handle of seek table
+ * @param bp playing breakpoint
+ */
+void media_seek_table_add_breakpoint(void *handle, media_breakpoint_info_t *bp);
+
+/**
+ * @} end defgroup media_seek_table_apis
+ */
+
+#endif /* __MEDIA_SEEK_TABLE_H__ */
@@ -18,15 +18,68 @@
 
 #include "media_mem.h"
 
-struct media_memory_cell {
+#define MEDIA_MEM_REQ_NUM		24
+#define MEDIA_MEM_CELL_ALIGN	4
+#define MEDIA_MEM_OFFSET_NONE	UINT16_MAX
+
+/* requirement present, unused tail entries are zero */
+#define MEDIA_MEM_CELL_USED		BIT(0)
+/* cell overlays the earlier cell of overlay_type, only one is used at a time */
+#define MEDIA_MEM_CELL_OVERLAY	BIT(1)
+/* cell is placed down from the end of its region */
+#define MEDIA_MEM_CELL_TOP		BIT(2)
+
+/* memory requirement of one buffer of a stream type */
+struct media_memory_req {
 	uint8_t mem_type;
-	uint32_t mem_base;
-	uint32_t mem_size;
+	uint8_t region;
+	uint8_t flags;
+	uint8_t overlay_type;
+	uint32_t size;
 };
 
-struct media_memory_block {
+/* requirements of a stream type, planned into the regions in order */
+struct media_memory_plan {
 	uint8_t stream_type;
-	struct media_memory_cell mem_cell[24];
+	struct media_memory_req req[MEDIA_MEM_REQ_NUM];
+};
+
+/* planned buffer */
+struct media_memory_cell {
+	const struct media_memory_req *req;
+	uintptr_t mem_base;
+	uint32_t mem_size;
+};
+
+struct media_memory_region {
+	const char *name;
+	uintptr_t base;
+	uint32_t size;
+};
+
+#define MEDIA_MEM_REQ(type, rgn, sz) \
+	{.mem_type = type, .region = MEDIA_MEM_REGION_##rgn, .flags = MEDIA_MEM_CELL_USED, .size = (sz),}
+#define MEDIA_MEM_REQ_TOP(type, rgn, sz) \
+	{.mem_type = type, .region = MEDIA_MEM_REGION_##rgn, \
+	 .flags = MEDIA_MEM_CELL_USED | MEDIA_MEM_CELL_TOP, .size = (sz),}
+#define MEDIA_MEM_REQ_OVERLAY(type, rgn, sz, over) \
+	{.mem_type = type, .region = MEDIA_MEM_REGION_##rgn, \
+	 .flags = MEDIA_MEM_CELL_USED | MEDIA_MEM_CELL_OVERLAY, .overlay_type = over, .size = (sz),}
+
+/* backing buffers the cells are carved from */
+enum {
+	MEDIA_MEM_REGION_PLAYBACK_INPUT,
+	MEDIA_MEM_REGION_OUTPUT_DECODER,
+	MEDIA_MEM_REGION_PLAYBACK_OUTPUT,
+	MEDIA_MEM_REGION_OUTPUT_PCM,
+	MEDIA_MEM_REGION_DECODER_SHARE,
+	MEDIA_MEM_REGION_PARSER_CHUCK,
+	MEDIA_MEM_REGION_CODEC_STACK,
+	MEDIA_MEM_REGION_PARSER_STACK,
+	MEDIA_MEM_REGION_DAE_PARA,
+	MEDIA_MEM_REGION_ECTT,
+
+	MEDIA_MEM_REGION_NUM,
 };
 
 typedef struct  {
@@ -66,151 +119,269 @@ static char parser_stack[2048] __aligned(ARCH_STACK_PTR_ALIGN);
 static dae_para_t dae_para  __in_section_unique(DSP_SHARE_RAM);
 #endif
 
-static const struct media_memory_block media_memory_config[] = {
+/* regions absent from the configuration stay empty */
+static const struct media_memory_region media_memory_regions[MEDIA_MEM_REGION_NUM] = {
+	[MEDIA_MEM_REGION_PLAYBACK_INPUT]  = {"playback_input",  (uintptr_t)playback_input_buffer,  sizeof(playback_input_buffer)},
+	[MEDIA_MEM_REGION_OUTPUT_DECODER]  = {"output_decoder",  (uintptr_t)output_decoder,         sizeof(output_decoder)},
+	[MEDIA_MEM_REGION_PLAYBACK_OUTPUT] = {"playback_output", (uintptr_t)playback_output_buffer, sizeof(playback_output_buffer)},
+	[MEDIA_MEM_REGION_OUTPUT_PCM]      = {"output_pcm",      (uintptr_t)output_pcm,             sizeof(output_pcm)},
+#if defined(CONFIG_ACTIONS_DECODER) && !defined(CONFIG_DECODER_ACT_HW_ACCELERATION) && defined(CONFIG_DECODER_ACT)
+	[MEDIA_MEM_REGION_DECODER_SHARE]   = {"decoder_share",   (uintptr_t)decoder_share_ram,      sizeof(decoder_share_ram)},
+#endif
+#if defined(CONFIG_ACTIONS_DECODER) && defined(CONFIG_ACTIONS_PARSER)
+	[MEDIA_MEM_REGION_PARSER_CHUCK]    = {"parser_chuck",    (uintptr_t)parser_chuck_buffer,    sizeof(parser_chuck_buffer)},
+	[MEDIA_MEM_REGION_CODEC_STACK]     = {"codec_stack",     (uintptr_t)codec_stack,            sizeof(codec_stack)},
+	[MEDIA_MEM_REGION_PARSER_STACK]    = {"parser_stack",    (uintptr_t)parser_stack,           sizeof(parser_stack)},
+#endif
+#ifdef CONFIG_MEDIA_EFFECT
+	[MEDIA_MEM_REGION_DAE_PARA]        = {"dae_para",        (uintptr_t)&dae_para,              sizeof(dae_para)},
+#endif
+#ifdef CONFIG_TOOL_ECTT
+	[MEDIA_MEM_REGION_ECTT]            = {"ectt_tool",       (uintptr_t)ectt_tool_buf,          sizeof(ectt_tool_buf)},
+#endif
+};
+
+/*
+ * Buffers of each stream type, in the order they are planned. A region is
+ * filled from its start, MEDIA_MEM_REQ_TOP buffers from its end, so
+ * capture and playback buffers of one stream type keep apart.
+ */
+static const struct media_memory_plan media_memory_plan[] = {
 	{
 		.stream_type = AUDIO_STREAM_MUSIC,
-		.mem_cell = {
-            {.mem_type = OUTPUT_PKG_HDR,  .mem_base = (uint32_t)&playback_input_buffer[0], .mem_size = 0x100,},
-			{.mem_type = INPUT_PLAYBACK,  .mem_base = (uint32_t)&playback_input_buffer[0x100], .mem_size = 0x2B00,},
-			{.mem_type = OUTPUT_DECODER,  .mem_base = (uint32_t)&output_decoder[0], .mem_size = sizeof(output_decoder),},
-			{.mem_type = OUTPUT_PLAYBACK, .mem_base = (uint32_t)&playback_output_buffer[0], .mem_size = sizeof(playback_output_buffer),},
-			{.mem_type = OUTPUT_PCM,      .mem_base = (uint32_t)&output_pcm[0], .mem_size = sizeof(output_pcm),},
-
+		.req = {
+			MEDIA_MEM_REQ(OUTPUT_PKG_HDR,  PLAYBACK_INPUT, 0x100),
+			MEDIA_MEM_REQ(INPUT_PLAYBACK,  PLAYBACK_INPUT, 0x2B00),
+			MEDIA_MEM_REQ(MIX_INPUT_BUF,   PLAYBACK_INPUT, 0x400),
+			MEDIA_MEM_REQ(MIX_RES_BUF,     PLAYBACK_INPUT, 0x400),
+			MEDIA_MEM_REQ(OUTPUT_DECODER,  OUTPUT_DECODER, sizeof(output_decoder)),
+			MEDIA_MEM_REQ(OUTPUT_PLAYBACK, PLAYBACK_OUTPUT, sizeof(playback_output_buffer)),
+			MEDIA_MEM_REQ(OUTPUT_PCM,      OUTPUT_PCM, sizeof(output_pcm)),
 #ifdef CONFIG_MEDIA_EFFECT
-			{.mem_type = DAE_PARAM,  .mem_base = (uint32_t)&dae_para, .mem_size = sizeof(dae_para),},
+			MEDIA_MEM_REQ(DAE_PARAM,       DAE_PARA, sizeof(dae_para)),
 #endif
-            {.mem_type = MIX_INPUT_BUF,   .mem_base = (uint32_t)&playback_input_buffer[0x2C00], .mem_size = 0x400,},
-            {.mem_type = MIX_RES_BUF,     .mem_base = (uint32_t)&playback_input_buffer[0x3000], .mem_size = 0x400,},
-
 		},
 	},
 	{
 		.stream_type = AUDIO_STREAM_LOCAL_MUSIC,
-		.mem_cell = {
+		.req = {
+			MEDIA_MEM_REQ(OUTPUT_PARSER,   PLAYBACK_INPUT, 0x1800),
 			// INPUT_PLAYBACK overlay for OUTPUT_PARSER, only used if no need parser decode.
-			{.mem_type = INPUT_PLAYBACK,  .mem_base = (uint32_t)&playback_input_buffer[0], .mem_size = 0x800,},
-			{.mem_type = OUTPUT_DECODER,  .mem_base = (uint32_t)&output_decoder[0], .mem_size = sizeof(output_decoder),},
-			{.mem_type = OUTPUT_PLAYBACK, .mem_base = (uint32_t)&playback_output_buffer[0], .mem_size = sizeof(playback_output_buffer),},
-			{.mem_type = OUTPUT_PCM,      .mem_base = (uint32_t)&output_pcm[0], .mem_size = sizeof(output_pcm),},
-		#ifdef CONFIG_ACTIONS_PARSER
-			{.mem_type = PARSER_CHUCK,    .mem_base = (uint32_t)&parser_chuck_buffer[0], .mem_size = sizeof(parser_chuck_buffer),},
+			MEDIA_MEM_REQ_OVERLAY(INPUT_PLAYBACK, PLAYBACK_INPUT, 0x800, OUTPUT_PARSER),
+			MEDIA_MEM_REQ(PARSER_EVT_BUFFER, PLAYBACK_INPUT, 0x20),
+			MEDIA_MEM_REQ(BT_TRANSMIT_INPUT, PLAYBACK_INPUT, 0xC00),
+			MEDIA_MEM_REQ(BT_TRANSMIT_OUTPUT, PLAYBACK_INPUT, 0x800),
+			MEDIA_MEM_REQ(MIX_INPUT_BUF,   PLAYBACK_INPUT, 0x400),
+			MEDIA_MEM_REQ(MIX_RES_BUF,     PLAYBACK_INPUT, 0x400),
+			MEDIA_MEM_REQ(OUTPUT_DECODER,  OUTPUT_DECODER, sizeof(output_decoder)),
+			MEDIA_MEM_REQ(OUTPUT_PLAYBACK, PLAYBACK_OUTPUT, sizeof(playback_output_buffer)),
+			MEDIA_MEM_REQ(OUTPUT_PCM,      OUTPUT_PCM, sizeof(output_pcm)),
+		#if defined(CONFIG_ACTIONS_DECODER) && defined(CONFIG_ACTIONS_PARSER)
+			MEDIA_MEM_REQ(PARSER_CHUCK,    PARSER_CHUCK, sizeof(parser_chuck_buffer)),
+			MEDIA_MEM_REQ(PARSER_STACK,    PARSER_STACK, sizeof(parser_stack)),
+			MEDIA_MEM_REQ(CODEC_STACK,     CODEC_STACK, sizeof(codec_stack)),
 		#endif
-			{.mem_type = OUTPUT_PARSER,   .mem_base = (uint32_t)&playback_input_buffer[0], .mem_size = 0x1800,},
-      		{.mem_type = PARSER_EVT_BUFFER, .mem_base = (uint32_t)&playback_input_buffer[0x1800], .mem_size = 0x20,},
-			{.mem_type = BT_TRANSMIT_INPUT,    .mem_base = (uint32_t)&playback_input_buffer[0x1820], .mem_size = 0xC00,},
-			{.mem_type = BT_TRANSMIT_OUTPUT,   .mem_base = (uint32_t)&playback_input_buffer[0x2420], .mem_size = 0x800,},
-        #ifdef CONFIG_MEDIA_EFFECT
-			{.mem_type = DAE_PARAM,  .mem_base = (uint32_t)&dae_para, .mem_size = sizeof(dae_para),},
-        #endif
-
-		#ifdef CONFIG_ACTIONS_PARSER
-			{.mem_type = PARSER_STACK, 	  .mem_base = (uint32_t)&parser_stack[0], .mem_size = sizeof(parser_stack),},
-			{.mem_type = CODEC_STACK, .mem_base = (uint32_t)&codec_stack[0], .mem_size = sizeof(codec_stack),},
+		#ifdef CONFIG_MEDIA_EFFECT
+			MEDIA_MEM_REQ(DAE_PARAM,       DAE_PARA, sizeof(dae_para)),
 		#endif
-
 		#ifdef CONFIG_TOOL_ECTT
-			{.mem_type = TOOL_ECTT_BUF, .mem_base = (uint32_t)&ectt_tool_buf[0], .mem_size = sizeof(ectt_tool_buf),},
+			MEDIA_MEM_REQ(TOOL_ECTT_BUF,   ECTT, sizeof(ectt_tool_buf)),
 		#endif
-            {.mem_type = MIX_INPUT_BUF,   .mem_base = (uint32_t)&playback_input_buffer[0x2C20], .mem_size = 0x400,},
-            {.mem_type = MIX_RES_BUF,     .mem_base = (uint32_t)&playback_input_buffer[0x3020], .mem_size = 0x400,},
-
 		},
 	},
 	{
 		.stream_type = AUDIO_STREAM_VOICE,
-		.mem_cell = {
-			{.mem_type = INPUT_PLAYBACK,  .mem_base = (uint32_t)&playback_input_buffer[0x000], .mem_size = 0x2A8,},
-			{.mem_type = OUTPUT_DECODER,  .mem_base = (uint32_t)&playback_input_buffer[0x2A8], .mem_size = 0x400,},
-			{.mem_type = OUTPUT_PLAYBACK, .mem_base = (uint32_t)&playback_input_buffer[0x6A8], .mem_size = 0x400,},
-			{.mem_type = INPUT_PCM,      .mem_base = (uint32_t)&playback_input_buffer[0xAA8], .mem_size = 0x000,},
-			{.mem_type = INPUT_CAPTURE,  .mem_base = (uint32_t)&playback_input_buffer[0xAA8], .mem_size = 0x800,},
-			{.mem_type = INPUT_ENCBUF,   .mem_base = (uint32_t)&playback_input_buffer[0x12A8], .mem_size = 0x400,},
-			{.mem_type = OUTPUT_CAPTURE, .mem_base = (uint32_t)&playback_input_buffer[0x16A8], .mem_size = 0x15C,},
-			{.mem_type = OUTPUT_SCO, .mem_base = (uint32_t)&playback_input_buffer[0x1804], .mem_size = 0xE8,},
-			{.mem_type = TX_SCO,     .mem_base = (uint32_t)&playback_input_buffer[0x18EC], .mem_size = 0x7C,},
-			{.mem_type = RX_SCO,     .mem_base = (uint32_t)&playback_input_buffer[0x1968], .mem_size = 0xF0,},
-            {.mem_type = AEC_REFBUF0,    .mem_base = (uint32_t)&playback_input_buffer[0x1A58], .mem_size = 0x200,},
-			{.mem_type = OUTPUT_PCM,      .mem_base = (uint32_t)&output_pcm[0], .mem_size = sizeof(output_pcm),},
-
-        #if defined(CONFIG_TOOL_ASET)
- 			{.mem_type = TOOL_ASQT_DUMP_BUF, .mem_base = (uint32_t)&playback_input_buffer[0x1C58], .mem_size = 0xC00,},
+		.req = {
+			MEDIA_MEM_REQ(INPUT_PLAYBACK,  PLAYBACK_INPUT, 0x2A8),
+			MEDIA_MEM_REQ(OUTPUT_DECODER,  PLAYBACK_INPUT, 0x400),
+			MEDIA_MEM_REQ(OUTPUT_PLAYBACK, PLAYBACK_INPUT, 0x400),
+			MEDIA_MEM_REQ(INPUT_PCM,       PLAYBACK_INPUT, 0x000),
+			MEDIA_MEM_REQ(INPUT_CAPTURE,   PLAYBACK_INPUT, 0x800),
+			MEDIA_MEM_REQ(INPUT_ENCBUF,    PLAYBACK_INPUT, 0x400),
+			MEDIA_MEM_REQ(OUTPUT_CAPTURE,  PLAYBACK_INPUT, 0x15C),
+			MEDIA_MEM_REQ(OUTPUT_SCO,      PLAYBACK_INPUT, 0xE8),
+			MEDIA_MEM_REQ(TX_SCO,          PLAYBACK_INPUT, 0x7C),
+			MEDIA_MEM_REQ(RX_SCO,          PLAYBACK_INPUT, 0xF0),
+			MEDIA_MEM_REQ(AEC_REFBUF0,     PLAYBACK_INPUT, 0x200),
+		#if defined(CONFIG_TOOL_ASET)
+			MEDIA_MEM_REQ(TOOL_ASQT_DUMP_BUF, PLAYBACK_INPUT, 0xC00),
+		#endif
+			MEDIA_MEM_REQ(OUTPUT_PKG_HDR,  PLAYBACK_INPUT, 0x100),
+			MEDIA_MEM_REQ(OUTPUT_PCM,      OUTPUT_PCM, sizeof(output_pcm)),
+		#ifdef CONFIG_MEDIA_EFFECT
+			MEDIA_MEM_REQ(DAE_PARAM,       DAE_PARA, sizeof(dae_para)),
 		#endif
-        #ifdef CONFIG_MEDIA_EFFECT
-			{.mem_type = DAE_PARAM,  .mem_base = (uint32_t)&dae_para, .mem_size = sizeof(dae_para),},
-        #endif
-
-            {.mem_type = OUTPUT_PKG_HDR,  .mem_base = (uint32_t)&playback_input_buffer[0x2858], .mem_size = 0x100,},
 		},
 	},
-
 	{
 		.stream_type = AUDIO_STREAM_AI,
-		.mem_cell = {
-			{.mem_type = INPUT_PCM,      .mem_base = (u32_t)&playback_input_buffer[0x0000], .mem_size = 0x800,},
-			{.mem_type = INPUT_CAPTURE,  .mem_base = (uint32_t)&playback_input_buffer[0x800], .mem_size = 0x800,},
-			{.mem_type = INPUT_ENCBUF,   .mem_base = (u32_t)&playback_input_buffer[0x1000], .mem_size = 0x1200,},
-			{.mem_type = OUTPUT_CAPTURE, .mem_base = (u32_t)&playback_input_buffer[0x2200], .mem_size = 0x1000,},
-			{.mem_type = VAD_STATE, 	 .mem_base = (u32_t)&playback_input_buffer[0x3200], .mem_size = 0x10},
+		.req = {
+			MEDIA_MEM_REQ(INPUT_PCM,       PLAYBACK_INPUT, 0x800),
+			MEDIA_MEM_REQ(INPUT_CAPTURE,   PLAYBACK_INPUT, 0x800),
+			MEDIA_MEM_REQ(INPUT_ENCBUF,    PLAYBACK_INPUT, 0x1200),
+			MEDIA_MEM_REQ(OUTPUT_CAPTURE,  PLAYBACK_INPUT, 0x1000),
+			MEDIA_MEM_REQ(VAD_STATE,       PLAYBACK_INPUT, 0x10),
 		},
 	},
 	{
 		.stream_type = AUDIO_STREAM_LE_AUDIO,
-		.mem_cell = {
-
-            {.mem_type = OUTPUT_PKG_HDR,  .mem_base = (uint32_t)&playback_input_buffer[0x1D00], .mem_size = 0x100,},
-			{.mem_type = INPUT_PLAYBACK,  .mem_base = (uint32_t)&playback_input_buffer[0x1E00], .mem_size = 0xE00,},
-			{.mem_type = OUTPUT_DECODER,  .mem_base = (uint32_t)&output_decoder[0], .mem_size = sizeof(output_decoder),},
-			{.mem_type = OUTPUT_PLAYBACK, .mem_base = (uint32_t)&playback_output_buffer[0], .mem_size = sizeof(playback_output_buffer),},
-			{.mem_type = OUTPUT_PCM,      .mem_base = (uint32_t)&output_pcm[0], .mem_size = sizeof(output_pcm),},
-
+		.req = {
+			/* capture from the start */
+			MEDIA_MEM_REQ(INPUT_PCM,       PLAYBACK_INPUT, 0x800),
+			MEDIA_MEM_REQ(INPUT_CAPTURE,   PLAYBACK_INPUT, 0x400),
+			MEDIA_MEM_REQ(INPUT_ENCBUF,    PLAYBACK_INPUT, 640),
+			MEDIA_MEM_REQ(OUTPUT_CAPTURE,  PLAYBACK_INPUT, 960),
+			MEDIA_MEM_REQ(VAD_STATE,       PLAYBACK_INPUT, 0x10),
+			MEDIA_MEM_REQ(AEC_REFBUF0,     PLAYBACK_INPUT, 0x400),
+			/* playback from the end */
+			MEDIA_MEM_REQ_TOP(MIX_RES_BUF,    PLAYBACK_INPUT, 0x400),
+			MEDIA_MEM_REQ_TOP(MIX_INPUT_BUF,  PLAYBACK_INPUT, 0x400),
+			MEDIA_MEM_REQ_TOP(INPUT_PLAYBACK, PLAYBACK_INPUT, 0xE00),
+			MEDIA_MEM_REQ_TOP(OUTPUT_PKG_HDR, PLAYBACK_INPUT, 0x100),
+			MEDIA_MEM_REQ(OUTPUT_DECODER,  OUTPUT_DECODER, sizeof(output_decoder)),
+			MEDIA_MEM_REQ(OUTPUT_PLAYBACK, PLAYBACK_OUTPUT, sizeof(playback_output_buffer)),
+			MEDIA_MEM_REQ(OUTPUT_PCM,      OUTPUT_PCM, sizeof(output_pcm)),
 #ifdef CONFIG_MEDIA_EFFECT
-			{.mem_type = DAE_PARAM,  .mem_base = (uint32_t)&dae_para, .mem_size = sizeof(dae_para),},
+			MEDIA_MEM_REQ(DAE_PARAM,       DAE_PARA, sizeof(dae_para)),
 #endif
-            {.mem_type = MIX_INPUT_BUF,   .mem_base = (uint32_t)&playback_input_buffer[0x2C00], .mem_size = 0x400,},
-            {.mem_type = MIX_RES_BUF,     .mem_base = (uint32_t)&playback_input_buffer[0x3000], .mem_size = 0x400,},
-
-
-
-			{.mem_type = INPUT_PCM,      .mem_base = (u32_t)&playback_input_buffer[0x0000], .mem_size = 0x800,},
-			{.mem_type = INPUT_CAPTURE,  .mem_base = (uint32_t)&playback_input_buffer[0x800], .mem_size = 0x400,},
-			{.mem_type = INPUT_ENCBUF,   .mem_base = (u32_t)&playback_input_buffer[0xC00], .mem_size = 640,},
-			{.mem_type = OUTPUT_CAPTURE, .mem_base = (u32_t)&playback_input_buffer[0xE80], .mem_size = 960,},
-			{.mem_type = VAD_STATE, 	 .mem_base = (u32_t)&playback_input_buffer[0x1240], .mem_size = 0x10},
-			{.mem_type = AEC_REFBUF0,    .mem_base = (uint32_t)&playback_input_buffer[0x1250], .mem_size = 0x400,},
 		},
 	},
 #ifdef CONFIG_DECODER_ACT_HW_ACCELERATION
 	{
 		.stream_type = AUDIO_STREAM_TTS,
-		.mem_cell = {
-			{.mem_type = OUTPUT_PCM,      .mem_base = (uint32_t)&output_pcm[0], .mem_size = sizeof(output_pcm),},
-            {.mem_type = INPUT_PLAYBACK,  .mem_base = (uint32_t)&playback_input_buffer[0], .mem_size = 0x800,},
-			{.mem_type = OUTPUT_DECODER,  .mem_base = (uint32_t)&playback_input_buffer[0x800], .mem_size = 0x400,},
-			{.mem_type = OUTPUT_PLAYBACK, .mem_base = (uint32_t)&playback_input_buffer[0xc00], .mem_size = 0x800,},
+		.req = {
+			MEDIA_MEM_REQ(INPUT_PLAYBACK,  PLAYBACK_INPUT, 0x800),
+			MEDIA_MEM_REQ(OUTPUT_DECODER,  PLAYBACK_INPUT, 0x400),
+			MEDIA_MEM_REQ(OUTPUT_PLAYBACK, PLAYBACK_INPUT, 0x800),
+			MEDIA_MEM_REQ(OUTPUT_PCM,      OUTPUT_PCM, sizeof(output_pcm)),
 		},
 	},
 #else
 	{
 		.stream_type = AUDIO_STREAM_TTS,
-		.mem_cell = {
-			{.mem_type = OUTPUT_PCM,      .mem_base = (uint32_t)&output_pcm[0], .mem_size = 960,},
-
-        #ifdef CONFIG_DECODER_ACT
-            {.mem_type = DECODER_GLOBAL_DATA, .mem_base = (uint32_t)&decoder_share_ram[0], .mem_size = 0x1928,},
-        #endif
-
-		#ifdef CONFIG_ACTIONS_DECODER
-			//{.mem_type = CODEC_STACK, .mem_base = (uint32_t)&decoder_stack[0], .mem_size = sizeof(decoder_stack),},
+		.req = {
+			MEDIA_MEM_REQ(OUTPUT_PCM,      OUTPUT_PCM, 960),
+		#if defined(CONFIG_ACTIONS_DECODER) && defined(CONFIG_DECODER_ACT)
+			MEDIA_MEM_REQ(DECODER_GLOBAL_DATA, DECODER_SHARE, 0x1928),
 		#endif
 		},
 	},
 #endif
-
 };
 
-static const struct media_memory_block *_memdia_mem_find_memory_block(int stream_type)
+/* region offsets of the planned requirements, MEDIA_MEM_OFFSET_NONE if not placed */
+static uint16_t media_memory_offset[ARRAY_SIZE(media_memory_plan)][MEDIA_MEM_REQ_NUM];
+static bool media_memory_planned;
+
+#ifdef CONFIG_MEDIA_MEM_CHECK
+static bool media_mem_checked;
+#endif
+
+static int _media_mem_find_req(const struct media_memory_plan *plan, int mem_type)
 {
-	const struct media_memory_block *mem_block = NULL;
+	for (int i = 0; i < MEDIA_MEM_REQ_NUM; i++) {
+		const struct media_memory_req *req = &plan->req[i];
+
+		if ((req->flags & MEDIA_MEM_CELL_USED) && req->mem_type == mem_type) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+/*
+ * Place the requirements of a stream type, return the number not placed.
+ * Planned aside and copied, a racing first use only rewrites equal values.
+ */
+static int _media_mem_plan_block(int b)
+{
+	const struct media_memory_plan *plan = &media_memory_plan[b];
+	uint16_t offset[MEDIA_MEM_REQ_NUM];
+	uint32_t low[MEDIA_MEM_REGION_NUM] = {0};
+	uint32_t high[MEDIA_MEM_REGION_NUM];
+	int err = 0;
+
+	for (int r = 0; r < MEDIA_MEM_REGION_NUM; r++) {
+		high[r] = MIN(media_memory_regions[r].size, MEDIA_MEM_OFFSET_NONE);
+	}
+
+	for (int i = 0; i < MEDIA_MEM_REQ_NUM; i++) {
+		const struct media_memory_req *req = &plan->req[i];
+		int r = req->region;
+		uint32_t base;
+
+		offset[i] = MEDIA_MEM_OFFSET_NONE;
+
+		if (!(req->flags & MEDIA_MEM_CELL_USED)) {
+			continue;
+		}
+
+		if (req->flags & MEDIA_MEM_CELL_OVERLAY) {
+			int j = _media_mem_find_req(plan, req->overlay_type);
+
+			if (j < 0 || j >= i || offset[j] == MEDIA_MEM_OFFSET_NONE
+				|| plan->req[j].region != r || plan->req[j].size < req->size) {
+				SYS_LOG_ERR("stream %d type %d overlay of type %d invalid",
+					plan->stream_type, req->mem_type, req->overlay_type);
+				err++;
+				continue;
+			}
+
+			offset[i] = offset[j];
+			continue;
+		}
+
+		if (req->flags & MEDIA_MEM_CELL_TOP) {
+			base = (high[r] >= req->size) ?
+				ROUND_DOWN(high[r] - req->size, MEDIA_MEM_CELL_ALIGN) : 0;
+		} else {
+			base = ROUND_UP(low[r], MEDIA_MEM_CELL_ALIGN);
+		}
+
+		if (base < low[r] || base + req->size > high[r]) {
+			SYS_LOG_ERR("stream %d type %d 0x%x does not fit %s",
+				plan->stream_type, req->mem_type, req->size,
+				media_memory_regions[r].name ? media_memory_regions[r].name : "region");
+			err++;
+			continue;
+		}
+
+		offset[i] = base;
+		if (req->flags & MEDIA_MEM_CELL_TOP) {
+			high[r] = base;
+		} else {
+			low[r] = base + req->size;
+		}
+	}
+
+	memcpy(media_memory_offset[b], offset, sizeof(offset));
+	return err;
+}
+
+static void _media_mem_plan(void)
+{
+	int err = 0;
+
+	if (media_memory_planned) {
+		return;
+	}
+
+	for (int b = 0; b < ARRAY_SIZE(media_memory_plan); b++) {
+		err += _media_mem_plan_block(b);
+	}
+
+	media_memory_planned = true;
+
+	if (err) {
+		SYS_LOG_ERR("media memory plan: %d buffers not placed", err);
+	}
+}
+
+static int _memdia_mem_find_memory_block(int stream_type)
+{
+	_media_mem_plan();
+
 	if (stream_type == AUDIO_STREAM_FM
 		|| stream_type == AUDIO_STREAM_I2SRX_IN
 		|| stream_type == AUDIO_STREAM_SPDIF_IN
@@ -218,76 +389,242 @@ static const struct media_memory_block *_memdia_mem_find_memory_block(int stream
 		stream_type = AUDIO_STREAM_LINEIN;
 	}
 
-	for (int i = 0; i < ARRAY_SIZE(media_memory_config) ; i++) {
-		mem_block = &media_memory_config[i];
-		if (mem_block->stream_type == stream_type) {
-			return mem_block;
+	for (int i = 0; i < ARRAY_SIZE(media_memory_plan) ; i++) {
+		if (media_memory_plan[i].stream_type == stream_type) {
+			return i;
 		}
 	}
 
-	return NULL;
+	return -1;
 }
 
-static const struct media_memory_cell *_memdia_mem_find_memory_cell(const struct media_memory_block *mem_block, int mem_type)
+/* planned cell of requirement i of block b, false if not placed */
+static bool _media_mem_get_cell(int b, int i, struct media_memory_cell *mem_cell)
 {
-	const struct media_memory_cell *mem_cell = NULL;
+	const struct media_memory_req *req = &media_memory_plan[b].req[i];
 
-	for (int i = 0; i < ARRAY_SIZE(mem_block->mem_cell) ; i++) {
-		mem_cell = &mem_block->mem_cell[i];
-		if (mem_cell->mem_type == mem_type) {
-			return mem_cell;
-		}
+	if (!(req->flags & MEDIA_MEM_CELL_USED) || media_memory_offset[b][i] == MEDIA_MEM_OFFSET_NONE) {
+		return false;
 	}
 
-	return NULL;
+	mem_cell->req = req;
+	mem_cell->mem_base = media_memory_regions[req->region].base + media_memory_offset[b][i];
+	mem_cell->mem_size = req->size;
+	return true;
 }
 
-void *media_mem_get_cache_pool(int mem_type, int stream_type)
+static bool _memdia_mem_find_memory_cell(int b, int mem_type, struct media_memory_cell *mem_cell)
 {
-	const struct media_memory_block *mem_block = NULL;
-	const struct media_memory_cell *mem_cell = NULL;
-	void *addr = NULL;
+	int i = _media_mem_find_req(&media_memory_plan[b], mem_type);
 
-	mem_block = _memdia_mem_find_memory_block(stream_type);
+	return i >= 0 && _media_mem_get_cell(b, i, mem_cell);
+}
 
-	if (!mem_block) {
-		goto exit;
+static bool _media_mem_cell_overlap(const struct media_memory_cell *a, const struct media_memory_cell *b)
+{
+	return a->mem_base < b->mem_base + b->mem_size && b->mem_base < a->mem_base + a->mem_size;
+}
+
+/* an overlay only shares memory with the cell it is declared over */
+static bool _media_mem_cell_overlay(const struct media_memory_cell *a, const struct media_memory_cell *b)
+{
+	return ((a->req->flags & MEDIA_MEM_CELL_OVERLAY) && a->req->overlay_type == b->req->mem_type)
+		|| ((b->req->flags & MEDIA_MEM_CELL_OVERLAY) && b->req->overlay_type == a->req->mem_type);
+}
+
+bool media_mem_check_concurrent(int stream_type1, int stream_type2)
+{
+	int b1 = _memdia_mem_find_memory_block(stream_type1);
+	int b2 = _memdia_mem_find_memory_block(stream_type2);
+	struct media_memory_cell cell1, cell2;
+
+	if (b1 < 0 || b2 < 0) {
+		return true;
+	}
+
+	if (b1 == b2) {
+		return false;
 	}
 
-	mem_cell = _memdia_mem_find_memory_cell(mem_block, mem_type);
+	for (int i = 0; i < MEDIA_MEM_REQ_NUM; i++) {
+		if (!_media_mem_get_cell(b1, i, &cell1) || !cell1.mem_size) {
+			continue;
+		}
+
+		for (int j = 0; j < MEDIA_MEM_REQ_NUM; j++) {
+			if (!_media_mem_get_cell(b2, j, &cell2) || !cell2.mem_size) {
+				continue;
+			}
+
+			if (_media_mem_cell_overlap(&cell1, &cell2)) {
+				SYS_LOG_DBG("stream %d type %d overlaps stream %d type %d",
+					stream_type1, cell1.req->mem_type,
+					stream_type2, cell2.req->mem_type);
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+#ifdef CONFIG_MEDIA_MEM_CHECK
+/* bytes of region r covered by the cells of block b, overlays counted once */
+static uint32_t _media_mem_region_used(int b, int r)
+{
+	uintptr_t pos = media_memory_regions[r].base;
+	struct media_memory_cell mem_cell;
+	uint32_t used = 0;
+
+	/* sweep the region in address order, extending over covering cells */
+	for (;;) {
+		uintptr_t next_base = 0, next_end = 0;
+
+		for (int i = 0; i < MEDIA_MEM_REQ_NUM; i++) {
+			if (!_media_mem_get_cell(b, i, &mem_cell) || mem_cell.req->region != r
+				|| mem_cell.mem_base + mem_cell.mem_size <= pos) {
+				continue;
+			}
+
+			if (!next_end || mem_cell.mem_base < next_base) {
+				next_base = mem_cell.mem_base;
+				next_end = mem_cell.mem_base + mem_cell.mem_size;
+			}
+		}
+
+		if (!next_end) {
+			break;
+		}
 
-	if (!mem_cell) {
-		goto exit;
+		used += next_end - MAX(next_base, pos);
+		pos = next_end;
 	}
 
-	return (void *)mem_cell->mem_base;
+	return used;
+}
 
-exit:
-	return addr;
+int media_mem_check_layout(void)
+{
+	struct media_memory_cell mem_cell, other;
+	int err = 0;
+
+	_media_mem_plan();
+
+	for (int b = 0; b < ARRAY_SIZE(media_memory_plan); b++) {
+		const struct media_memory_plan *plan = &media_memory_plan[b];
+
+		for (int i = 0; i < MEDIA_MEM_REQ_NUM; i++) {
+			if (!(plan->req[i].flags & MEDIA_MEM_CELL_USED)) {
+				continue;
+			}
+
+			if (!_media_mem_get_cell(b, i, &mem_cell)) {
+				err++;
+				continue;
+			}
+
+			if (mem_cell.mem_base & (MEDIA_MEM_CELL_ALIGN - 1)) {
+				SYS_LOG_ERR("stream %d type %d 0x%x unaligned",
+					plan->stream_type, plan->req[i].mem_type, (uint32_t)mem_cell.mem_base);
+				err++;
+			}
+
+			for (int j = i + 1; j < MEDIA_MEM_REQ_NUM; j++) {
+				if (!_media_mem_get_cell(b, j, &other)) {
+					continue;
+				}
+
+				if (other.req->mem_type == mem_cell.req->mem_type) {
+					SYS_LOG_ERR("stream %d type %d duplicated",
+						plan->stream_type, mem_cell.req->mem_type);
+					err++;
+				} else if (_media_mem_cell_overlap(&mem_cell, &other)
+					&& !_media_mem_cell_overlay(&mem_cell, &other)) {
+					SYS_LOG_ERR("stream %d type %d overlaps type %d",
+						plan->stream_type, mem_cell.req->mem_type, other.req->mem_type);
+					err++;
+				}
+			}
+		}
+
+		for (int r = 0; r < MEDIA_MEM_REGION_NUM; r++) {
+			const struct media_memory_region *region = &media_memory_regions[r];
+			uint32_t used = _media_mem_region_used(b, r);
+
+			if (used) {
+				SYS_LOG_INF("stream %d %s: 0x%x/0x%x (%d%%)", plan->stream_type,
+					region->name, used, region->size, used * 100 / region->size);
+			}
+		}
+	}
+
+	return err;
 }
 
-int media_mem_get_cache_pool_size(int mem_type, int stream_type)
+int media_mem_get_layout(int stream_type, struct media_mem_layout_cell *cells, int num)
 {
-	const struct media_memory_block *mem_block = NULL;
-	const struct media_memory_cell *mem_cell = NULL;
-	int mem_size = 0;
+	int b = _memdia_mem_find_memory_block(stream_type);
+	struct media_memory_cell mem_cell;
+	int n = 0;
+
+	if (b < 0) {
+		return 0;
+	}
 
-	mem_block = _memdia_mem_find_memory_block(stream_type);
+	for (int i = 0; i < MEDIA_MEM_REQ_NUM && n < num; i++) {
+		if (!_media_mem_get_cell(b, i, &mem_cell)) {
+			continue;
+		}
 
-	if (!mem_block) {
-		goto exit;
+		cells[n].mem_type = mem_cell.req->mem_type;
+		cells[n].overlay_type = (mem_cell.req->flags & MEDIA_MEM_CELL_OVERLAY) ?
+			mem_cell.req->overlay_type : -1;
+		cells[n].region = media_memory_regions[mem_cell.req->region].name;
+		cells[n].region_size = media_memory_regions[mem_cell.req->region].size;
+		cells[n].offset = media_memory_offset[b][i];
+		cells[n].size = mem_cell.mem_size;
+		n++;
 	}
 
-	mem_cell = _memdia_mem_find_memory_cell(mem_block, mem_type);
+	return n;
+}
+#endif /* CONFIG_MEDIA_MEM_CHECK */
 
-	if (!mem_cell) {
-		goto exit;
+void *media_mem_get_cache_pool(int mem_type, int stream_type)
+{
+	struct media_memory_cell mem_cell;
+	int b;
+
+#ifdef CONFIG_MEDIA_MEM_CHECK
+	if (!media_mem_checked) {
+		media_mem_checked = true;
+		if (media_mem_check_layout()) {
+			SYS_LOG_ERR("media memory layout invalid");
+		}
+	}
+#endif
+
+	b = _memdia_mem_find_memory_block(stream_type);
+
+	if (b < 0 || !_memdia_mem_find_memory_cell(b, mem_type, &mem_cell)) {
+		return NULL;
 	}
 
-	return mem_cell->mem_size;
+	return (void *)mem_cell.mem_base;
+}
+
+int media_mem_get_cache_pool_size(int mem_type, int stream_type)
+{
+	struct media_memory_cell mem_cell;
+	int b;
+
+	b = _memdia_mem_find_memory_block(stream_type);
+
+	if (b < 0 || !_memdia_mem_find_memory_cell(b, mem_type, &mem_cell)) {
+		return 0;
+	}
 
-exit:
-	return mem_size;
+	return mem_cell.mem_size;
 }
 #ifdef CONFIG_SOC_NO_PSRAM
 __in_section_unique(media.noinit.heap)
@@ -321,6 +658,11 @@ int media_mem_get_cache_pool_size(int mem_type, int stream_type)
 	return 0;
 }
 
+bool media_mem_check_concurrent(int stream_type1, int stream_type2)
+{
+	return true;
+}
+
 void *media_mem_malloc(int size, int memory_type)
 {
 	return NULL;
@@ -23,6 +23,9 @@
 #include "media_player.h"
 #include "media_service.h"
 #include "media_mem.h"
+#ifdef CONFIG_MEDIA_SEEK_TABLE
+#include <media_seek_table.h>
+#endif
 #ifdef CONFIG_PROPERTY
 #include <property_manager.h>
 #endif
@@ -38,6 +41,9 @@ static bool force_disable_player = false;
 static media_player_t *current_media_dumpable_player;
 static media_player_t *current_media_main_player;
 
+/* stream types of the open players */
+static uint32_t media_player_streams;
+
 /* the media_player_t will be return as parameter "uesr_data" */
 static media_srv_event_notify_t pfn_lifecycle_notify;
 
@@ -104,6 +110,19 @@ int media_player_set_effect_bypass(bool bypass)
     return 0;
 }
 
+/* players whose media memory overlaps would corrupt each other */
+static bool _media_player_check_concurrent(int stream_type)
+{
+	for (int i = 0; i < 32; i++) {
+		if ((media_player_streams & BIT(i)) && !media_mem_check_concurrent(i, stream_type)) {
+			SYS_LOG_ERR("stream %d shares media memory with open stream %d", stream_type, i);
+			return false;
+		}
+	}
+
+	return true;
+}
+
 static int _media_player_check_audio_effect(media_player_t *handle, int stream_type)
 {
 	bool effect_enable = true;
@@ -243,6 +262,10 @@ media_player_t *media_player_open(media_init_param_t *init_param)
 	dvfs_set_level(dvfs_level, "media");
 #endif
 
+	if (!_media_player_check_concurrent(init_param->stream_type)) {
+		goto error_exit;
+	}
+
 	if (!send_async_msg(MEDIA_SERVICE_NAME, &msg)) {
 		goto error_exit;
 	}
@@ -265,11 +288,18 @@ media_player_t *media_player_open(media_init_param_t *init_param)
 	handle->media_srv_handle = srv_param.mediasrv_handle;
 	handle->type = init_param->type;
 	handle->is_tws = is_tws;
+	handle->stream_type = init_param->stream_type;
+	if (handle->stream_type < 32)
+		media_player_streams |= BIT(handle->stream_type);
 
 #ifdef CONFIG_ACTS_DVFS_DYNAMIC_LEVEL
 	handle->dvfs_level = dvfs_level;
 #endif
 
+#ifdef CONFIG_MEDIA_SEEK_TABLE
+	handle->seek_table = NULL;
+#endif
+
 	if (init_param->dumpable && !current_media_dumpable_player) {
 		current_media_dumpable_player = handle;
 	}
@@ -401,6 +431,43 @@ int media_player_resume(media_player_t *handle)
 	return !ret;
 }
 
+#ifdef CONFIG_MEDIA_SEEK_TABLE
+/*
+ * Start a seek without file offset from an exact point of the seek table
+ * close to the target. Estimated points are never handed to the parser, so
+ * the chunk it reports back is always an exact point.
+ */
+static void _media_player_seek_from_table(media_player_t *handle, media_seek_info_t *info)
+{
+	media_breakpoint_info_t bp;
+	int cur_time = 0;
+
+	if (info->file_offset > 0)
+		return;
+
+	if (info->whence == MEDIA_SEEK_CUR) {
+		if (!info->time_offset || media_player_get_breakpoint(handle, &bp))
+			return;
+		cur_time = bp.time_offset;
+	} else if (info->whence != MEDIA_SEEK_SET) {
+		return;
+	}
+
+	if (media_seek_table_find(handle->seek_table, MAX(cur_time + info->time_offset, 0),
+			MEDIA_SEEK_TABLE_TOLERANCE, &bp))
+		return;
+
+	/* relative seek must still move the way it was required */
+	if (info->whence == MEDIA_SEEK_CUR
+		&& ((info->time_offset > 0) ? (bp.time_offset <= cur_time) : (bp.time_offset >= cur_time)))
+		return;
+
+	info->whence = MEDIA_SEEK_SET;
+	info->time_offset = bp.time_offset;
+	info->file_offset = bp.file_offset;
+}
+#endif
+
 int media_player_seek(media_player_t *handle, media_seek_info_t *info)
 {
 	struct app_msg msg = {0};
@@ -411,6 +478,11 @@ int media_player_seek(media_player_t *handle, media_seek_info_t *info)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_MEDIA_SEEK_TABLE
+	if (handle->seek_table)
+		_media_player_seek_from_table(handle, info);
+#endif
+
 	srv_param = media_mem_malloc(sizeof(*srv_param), MCU_MEMORY);
 	if (!srv_param)
 		return -ENOMEM;
@@ -437,8 +509,25 @@ int media_player_seek(media_player_t *handle, media_seek_info_t *info)
 	}
 
 	media_mem_free(srv_param);
+
+#ifdef CONFIG_MEDIA_SEEK_TABLE
+	if (handle->seek_table && info->chunk_time_offset >= 0)
+		media_seek_table_add(handle->seek_table, info->chunk_time_offset, info->chunk_file_offset);
+#endif
+	return 0;
+}
+
+#ifdef CONFIG_MEDIA_SEEK_TABLE
+int media_player_set_seek_table(media_player_t *handle, void *seek_table)
+{
+	if (!handle) {
+		return -EINVAL;
+	}
+
+	handle->seek_table = seek_table;
 	return 0;
 }
+#endif
 
 int media_player_get_parameter(media_player_t *handle,
 		int pname, void *param, unsigned int psize)
@@ -481,6 +570,12 @@ int media_player_get_parameter(media_player_t *handle,
 
 	ret = srv_param->result;
 	media_mem_free(srv_param);
+
+#ifdef CONFIG_MEDIA_SEEK_TABLE
+	/* playing breakpoint is an exact point for some formats */
+	if (!ret && pname == MEDIA_PARAM_BREAKPOINT && handle->seek_table)
+		media_seek_table_add_breakpoint(handle->seek_table, param);
+#endif
 	return ret;
 }
 
@@ -646,6 +741,8 @@ int media_player_close(media_player_t *handle)
 		current_media_dumpable_player = NULL;
 	if (current_media_main_player == handle)
 		current_media_main_player = NULL;
+	if (handle->stream_type < 32)
+		media_player_streams &= ~BIT(handle->stream_type);
 
 #ifdef CONFIG_SYS_WAKELOCK
 	sys_wake_unlock_ext(PARTIAL_WAKE_LOCK,MEDIA_WAKE_LOCK_USER);
@@ -0,0 +1,564 @@
+/*
+ * Copyright (c) 2016 Actions Semi Co., Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief media seek table.
+ *
+ * Per file table from playback time to the byte offset of the frame starting
+ * at that time. Points come from the stream header when the table is built
+ * (FLAC SEEKTABLE or unscaled MP3 VBRI table), and from the positions the
+ * parser reports at seeks and breakpoints during playback. Every point is
+ * exact: a Xing TOC or a scaled VBRI table only gives the duration, the
+ * parser would still have to search around their estimates. Slot i holds
+ * the point nearest after i * interval, so a seek looks at three slots at
+ * most. Tables are kept in a small cache file under
+ * CONFIG_MEDIA_SEEK_TABLE_CACHE_DIR, on an internal volume, never in the
+ * media tree of the user, the least recently saved one replaced. The file
+ * system has no modification time, so a table is keyed by the url, the size
+ * and a crc of the stream start and the middle of the file.
+*/
+
+#include <os_common_api.h>
+#include <mem_manager.h>
+#include <fs/fs.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/byteorder.h>
+#include <sys/crc.h>
+#include <media_type.h>
+#include <media_seek_table.h>
+
+#define SYS_LOG_NO_NEWLINE
+#ifdef SYS_LOG_DOMAIN
+#undef SYS_LOG_DOMAIN
+#endif
+#define SYS_LOG_DOMAIN "seek_table"
+
+#define SEEK_TABLE_MAGIC			0x334B4553	/* "SEK3" */
+#define SEEK_TABLE_POINTS			CONFIG_MEDIA_SEEK_TABLE_POINTS
+/* min interval between slots, ms */
+#define SEEK_TABLE_MIN_INTERVAL		500
+/* interval if the duration is not in the header, ms */
+#define SEEK_TABLE_DEF_INTERVAL		2000
+/* bytes of each sample of the file content in the cache key */
+#define SEEK_TABLE_CRC_LEN			64
+/* header bytes searched for the first mp3 frame */
+#define SEEK_TABLE_SYNC_RANGE		4096
+#define SEEK_TABLE_CACHE_PATH		CONFIG_MEDIA_SEEK_TABLE_CACHE_DIR "/seektab.dat"
+
+struct seek_point {
+	uint32_t time_ms;
+	uint32_t file_offset;	/* 0 if slot empty */
+};
+
+/* cache record, also the table in memory */
+struct seek_table_record {
+	uint32_t magic;
+	uint32_t key;
+	uint32_t file_size;
+	uint32_t crc;
+	uint32_t stamp;
+	uint32_t interval;
+	uint8_t format;
+	uint8_t reserved[3];
+	struct seek_point points[SEEK_TABLE_POINTS];
+};
+
+struct media_seek_table {
+	struct fs_file_t file;
+	uint8_t dirty;
+	int8_t cache_slot;
+	struct seek_table_record rec;
+};
+
+static uint32_t _seek_table_hash(const char *url)
+{
+	uint32_t hash = 2166136261u;
+
+	while (*url) {
+		hash = (hash ^ (uint8_t)*url++) * 16777619u;
+	}
+
+	return hash;
+}
+
+static void _seek_table_insert(struct media_seek_table *table, uint32_t time_ms,
+		uint32_t file_offset)
+{
+	struct seek_table_record *rec = &table->rec;
+	struct seek_point *pt;
+	uint32_t slot, base;
+
+	if (!file_offset || file_offset >= rec->file_size)
+		return;
+
+	slot = MIN(time_ms / rec->interval, SEEK_TABLE_POINTS - 1);
+	base = slot * rec->interval;
+	pt = &rec->points[slot];
+
+	if (pt->file_offset && pt->time_ms - base <= time_ms - base)
+		return;
+
+	pt->time_ms = time_ms;
+	pt->file_offset = file_offset;
+	table->dirty = 1;
+}
+
+static void _seek_table_set_duration(struct media_seek_table *table, uint32_t total_ms)
+{
+	uint32_t interval = SEEK_TABLE_DEF_INTERVAL;
+
+	if (total_ms) {
+		interval = (total_ms + SEEK_TABLE_POINTS - 1) / SEEK_TABLE_POINTS;
+		interval = MAX(ROUND_UP(interval, 100), SEEK_TABLE_MIN_INTERVAL);
+	}
+
+	table->rec.interval = interval;
+}
+
+static int _seek_table_read(struct media_seek_table *table, uint32_t offset, void *buf, int len)
+{
+	if (fs_seek(&table->file, offset, FS_SEEK_SET))
+		return -EIO;
+
+	return (fs_read(&table->file, buf, len) == len) ? 0 : -EIO;
+}
+
+/* offset after an id3v2 tag at the file start */
+static uint32_t _seek_table_skip_id3(struct media_seek_table *table)
+{
+	uint8_t h[10];
+
+	if (_seek_table_read(table, 0, h, sizeof(h)) || memcmp(h, "ID3", 3))
+		return 0;
+
+	return 10 + ((h[5] & 0x10) ? 10 : 0) + (((uint32_t)(h[6] & 0x7f) << 21) |
+			((h[7] & 0x7f) << 14) | ((h[8] & 0x7f) << 7) | (h[9] & 0x7f));
+}
+
+/* crc of the stream start and the middle of the file, changes if audio is rewritten */
+static uint32_t _seek_table_content_crc(struct media_seek_table *table)
+{
+	uint32_t offset[2] = { _seek_table_skip_id3(table), table->rec.file_size / 2 };
+	uint8_t buf[SEEK_TABLE_CRC_LEN];
+	uint32_t crc = 0;
+	int i, len;
+
+	for (i = 0; i < ARRAY_SIZE(offset); i++) {
+		len = MIN(sizeof(buf), table->rec.file_size - MIN(offset[i], table->rec.file_size));
+		if (len > 0 && !_seek_table_read(table, offset[i], buf, len))
+			crc = crc32_ieee_update(crc, buf, len);
+	}
+
+	return crc;
+}
+
+#ifdef CONFIG_PARSER_FLAC
+static int _seek_table_build_flac(struct media_seek_table *table)
+{
+	uint32_t pos = _seek_table_skip_id3(table);
+	uint32_t seektable = 0, seektable_len = 0, sample_rate = 0;
+	uint64_t total_samples = 0, sample, offset;
+	uint8_t b[4], h[18 * 4];
+	uint32_t len, i, n;
+
+	if (_seek_table_read(table, pos, h, 4) || memcmp(h, "fLaC", 4))
+		return -EINVAL;
+
+	pos += 4;
+
+	/* metadata blocks, the first frame follows the last one */
+	do {
+		if (_seek_table_read(table, pos, b, 4))
+			return -EIO;
+
+		len = sys_get_be24(&b[1]);
+		if ((b[0] & 0x7f) == 0 && len >= 18) {
+			if (_seek_table_read(table, pos + 4, h, 18))
+				return -EIO;
+
+			sample_rate = sys_get_be24(&h[10]) >> 4;
+			total_samples = ((uint64_t)(h[13] & 0x0f) << 32) | sys_get_be32(&h[14]);
+		} else if ((b[0] & 0x7f) == 3) {
+			seektable = pos + 4;
+			seektable_len = len;
+		}
+
+		pos += 4 + len;
+	} while (!(b[0] & 0x80) && pos < table->rec.file_size);
+
+	if (!sample_rate)
+		return -EINVAL;
+
+	_seek_table_set_duration(table, (uint32_t)(total_samples * 1000 / sample_rate));
+
+	/* seek points of 18 bytes, read a buffer at a time */
+	for (i = 0; i < seektable_len / 18; i++) {
+		n = i % (sizeof(h) / 18);
+		if (n == 0 && _seek_table_read(table, seektable + i * 18, h,
+				MIN(sizeof(h) / 18, seektable_len / 18 - i) * 18))
+			return -EIO;
+
+		sample = sys_get_be64(&h[n * 18]);
+		offset = sys_get_be64(&h[n * 18 + 8]);
+		if (sample == UINT64_MAX || pos + offset >= table->rec.file_size)
+			continue;
+
+		_seek_table_insert(table, (uint32_t)(sample * 1000 / sample_rate),
+				(uint32_t)(pos + offset));
+	}
+
+	return 0;
+}
+#endif
+
+#ifdef CONFIG_PARSER_MP3
+static const uint16_t mp3_bitrate[5][15] = {
+	{ 0, 32, 64, 96, 128, 160, 192, 224, 256, 288, 320, 352, 384, 416, 448 },	/* v1 l1 */
+	{ 0, 32, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384 },		/* v1 l2 */
+	{ 0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320 },		/* v1 l3 */
+	{ 0, 32, 48, 56, 64, 80, 96, 112, 128, 144, 160, 176, 192, 224, 256 },		/* v2 l1 */
+	{ 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160 },			/* v2 l2 l3 */
+};
+
+struct mp3_frame_info {
+	uint32_t sample_rate;
+	uint32_t samples;		/* per frame */
+	uint32_t frame_len;
+	uint32_t side_len;		/* layer 3 side info */
+};
+
+static int _seek_table_mp3_header(const uint8_t *h, struct mp3_frame_info *info)
+{
+	static const uint16_t sample_rates[3] = { 44100, 48000, 32000 };
+	uint8_t ver = (h[1] >> 3) & 3;		/* 0: 2.5, 2: 2, 3: 1 */
+	uint8_t layer = 4 - ((h[1] >> 1) & 3);
+	uint8_t br_idx = h[2] >> 4;
+	uint8_t sr_idx = (h[2] >> 2) & 3;
+	uint8_t pad = (h[2] >> 1) & 1;
+	bool mono = ((h[3] >> 6) == 3);
+	uint32_t bitrate;
+
+	if (h[0] != 0xff || (h[1] & 0xe0) != 0xe0 || ver == 1 || layer == 4
+		|| br_idx == 0 || br_idx == 15 || sr_idx == 3)
+		return -EINVAL;
+
+	bitrate = mp3_bitrate[(ver == 3) ? (layer - 1) : ((layer == 1) ? 3 : 4)][br_idx] * 1000;
+	info->sample_rate = sample_rates[sr_idx] >> ((ver == 3) ? 0 : ((ver == 2) ? 1 : 2));
+
+	if (layer == 1) {
+		info->samples = 384;
+		info->frame_len = (12 * bitrate / info->sample_rate + pad) * 4;
+	} else {
+		info->samples = (layer == 3 && ver != 3) ? 576 : 1152;
+		info->frame_len = info->samples / 8 * bitrate / info->sample_rate + pad;
+	}
+
+	info->side_len = (ver == 3) ? (mono ? 17 : 32) : (mono ? 9 : 17);
+	return 0;
+}
+
+static int _seek_table_build_vbri(struct media_seek_table *table, uint32_t pos,
+		struct mp3_frame_info *info, const uint8_t *h)
+{
+	uint32_t frames = sys_get_be32(&h[14]);
+	uint16_t entries = sys_get_be16(&h[18]);
+	uint16_t scale = sys_get_be16(&h[20]);
+	uint16_t entry_size = sys_get_be16(&h[22]);
+	uint16_t frames_per_entry = sys_get_be16(&h[24]);
+	uint32_t table_pos = pos + 4 + 32 + 26;
+	uint32_t offset = pos + info->frame_len;
+	uint8_t e[64];
+	uint32_t i, j, n, size;
+
+	if (entry_size < 1 || entry_size > 4)
+		return -EINVAL;
+
+	_seek_table_set_duration(table, (uint32_t)((uint64_t)frames * info->samples * 1000 / info->sample_rate));
+
+	/* scaled entries are rounded sizes, their offsets miss the frames */
+	if (scale != 1)
+		return 0;
+
+	/* entry i is the size of frames_per_entry frames */
+	for (i = 0; i < entries; i++) {
+		_seek_table_insert(table, (uint32_t)((uint64_t)i * frames_per_entry * info->samples * 1000 / info->sample_rate),
+				offset);
+
+		/* entries are read a buffer at a time */
+		n = i % (sizeof(e) / entry_size);
+		if (n == 0 && _seek_table_read(table, table_pos + i * entry_size, e,
+				MIN(sizeof(e) / entry_size, entries - i) * entry_size))
+			return -EIO;
+
+		for (j = 0, size = 0; j < entry_size; j++) {
+			size = (size << 8) | e[n * entry_size + j];
+		}
+
+		offset += size;
+	}
+
+	return 0;
+}
+
+/* offset of the first frame, its header repeated at the next frame */
+static int _seek_table_mp3_sync(struct media_seek_table *table, uint32_t pos,
+		struct mp3_frame_info *info)
+{
+	uint32_t end = pos + SEEK_TABLE_SYNC_RANGE;
+	uint8_t h[64], next[4];
+	int i;
+
+	for (; pos < end; pos += sizeof(h) - 3) {
+		if (_seek_table_read(table, pos, h, sizeof(h)))
+			return -EINVAL;
+
+		for (i = 0; i + 4 <= sizeof(h); i++) {
+			if (!_seek_table_mp3_header(&h[i], info)
+				&& !_seek_table_read(table, pos + i + info->frame_len, next, 4)
+				&& next[0] == 0xff && (next[1] & 0xfe) == (h[i + 1] & 0xfe))
+				return pos + i;
+		}
+	}
+
+	return -EINVAL;
+}
+
+static int _seek_table_build_mp3(struct media_seek_table *table)
+{
+	struct mp3_frame_info info;
+	/* header, side info and vbri header, longer than xing tag, flags and frames */
+	uint8_t h[4 + 32 + 26];
+	uint32_t frames = 0;
+	const uint8_t *x;
+	int pos;
+
+	pos = _seek_table_mp3_sync(table, _seek_table_skip_id3(table), &info);
+	if (pos < 0 || _seek_table_read(table, pos, h, sizeof(h)))
+		return -EINVAL;
+
+	if (!memcmp(&h[4 + 32], "VBRI", 4))
+		return _seek_table_build_vbri(table, pos, &info, &h[4 + 32]);
+
+	x = &h[4 + info.side_len];
+	if (memcmp(x, "Xing", 4) && memcmp(x, "Info", 4))
+		return 0;
+
+	/* the toc is only 1/256 of the stream accurate, the frames give the duration */
+	if (sys_get_be32(&x[4]) & 0x1)
+		frames = sys_get_be32(&x[8]);
+
+	_seek_table_set_duration(table, (uint32_t)((uint64_t)frames * info.samples * 1000 / info.sample_rate));
+	return 0;
+}
+#endif
+
+static int _seek_table_cache_load(struct media_seek_table *table)
+{
+	struct seek_table_record *rec = &table->rec;
+	struct seek_table_record head;
+	struct fs_file_t file;
+	int i, res = -ENOENT;
+
+	fs_file_t_init(&file);
+	if (fs_open(&file, SEEK_TABLE_CACHE_PATH, FS_O_READ))
+		return -ENOENT;
+
+	for (i = 0; i < CONFIG_MEDIA_SEEK_TABLE_CACHE_NUM; i++) {
+		if (fs_seek(&file, i * sizeof(*rec), FS_SEEK_SET)
+			|| fs_read(&file, &head, offsetof(struct seek_table_record, points))
+					!= offsetof(struct seek_table_record, points))
+			break;
+
+		if (head.magic == SEEK_TABLE_MAGIC && head.key == rec->key && head.file_size == rec->file_size
+			&& head.crc == rec->crc && head.format == rec->format && head.interval) {
+			memcpy(rec, &head, offsetof(struct seek_table_record, points));
+			if (fs_read(&file, rec->points, sizeof(rec->points)) == sizeof(rec->points)) {
+				table->cache_slot = i;
+				res = 0;
+			}
+			break;
+		}
+	}
+
+	fs_close(&file);
+	return res;
+}
+
+static int _seek_table_cache_save(struct media_seek_table *table)
+{
+	struct seek_table_record *rec = &table->rec;
+	struct seek_table_record head;
+	struct fs_file_t file;
+	int head_len = offsetof(struct seek_table_record, stamp) + sizeof(head.stamp);
+	uint32_t max_stamp = 0, min_stamp = UINT32_MAX;
+	int i, slot = table->cache_slot, res = 0;
+
+	fs_file_t_init(&file);
+	if (fs_open(&file, SEEK_TABLE_CACHE_PATH, FS_O_RDWR | FS_O_CREATE))
+		return -EIO;
+
+	/* stamps order the saves, an empty or foreign slot is replaced first */
+	for (i = 0; i < CONFIG_MEDIA_SEEK_TABLE_CACHE_NUM; i++) {
+		if (fs_seek(&file, i * sizeof(*rec), FS_SEEK_SET)
+			|| fs_read(&file, &head, head_len) != head_len
+			|| head.magic != SEEK_TABLE_MAGIC) {
+			head.stamp = 0;
+		}
+
+		max_stamp = MAX(max_stamp, head.stamp);
+		if (table->cache_slot < 0 && head.stamp < min_stamp) {
+			min_stamp = head.stamp;
+			slot = i;
+		}
+	}
+
+	rec->magic = SEEK_TABLE_MAGIC;
+	rec->stamp = max_stamp + 1;
+
+	if (fs_seek(&file, slot * sizeof(*rec), FS_SEEK_SET)
+		|| fs_write(&file, rec, sizeof(*rec)) != sizeof(*rec)) {
+		SYS_LOG_ERR("save %s failed", SEEK_TABLE_CACHE_PATH);
+		res = -EIO;
+	} else {
+		table->cache_slot = slot;
+	}
+
+	fs_close(&file);
+	return res;
+}
+
+void *media_seek_table_open(const char *url, uint8_t format)
+{
+	struct media_seek_table *table;
+	struct fs_dirent entry;
+	int res = -EINVAL;
+
+	if (format != MP3_TYPE && format != FLA_TYPE && format != WAV_TYPE && format != WMA_TYPE)
+		return NULL;
+
+	if (fs_stat(url, &entry) || entry.type != FS_DIR_ENTRY_FILE || !entry.size)
+		return NULL;
+
+	table = mem_malloc(sizeof(*table));
+	if (!table)
+		return NULL;
+
+	memset(table, 0, sizeof(*table));
+	table->cache_slot = -1;
+	table->rec.key = _seek_table_hash(url);
+	table->rec.file_size = entry.size;
+	table->rec.format = format;
+
+	fs_file_t_init(&table->file);
+	if (fs_open(&table->file, url, FS_O_READ)) {
+		mem_free(table);
+		return NULL;
+	}
+
+	table->rec.crc = _seek_table_content_crc(table);
+
+	if (!_seek_table_cache_load(table)) {
+		fs_close(&table->file);
+		SYS_LOG_INF("cached slot %d, interval %u", table->cache_slot, table->rec.interval);
+		return table;
+	}
+
+	_seek_table_set_duration(table, 0);
+
+#ifdef CONFIG_PARSER_MP3
+	if (format == MP3_TYPE)
+		res = _seek_table_build_mp3(table);
+#endif
+#ifdef CONFIG_PARSER_FLAC
+	if (format == FLA_TYPE)
+		res = _seek_table_build_flac(table);
+#endif
+
+	fs_close(&table->file);
+
+	SYS_LOG_INF("built %d, interval %u", res, table->rec.interval);
+	return table;
+}
+
+void media_seek_table_close(void *handle)
+{
+	struct media_seek_table *table = handle;
+
+	if (!table)
+		return;
+
+	if (table->dirty)
+		_seek_table_cache_save(table);
+
+	mem_free(table);
+}
+
+int media_seek_table_find(void *handle, int time_ms, int max_err_ms,
+		media_breakpoint_info_t *bp)
+{
+	struct media_seek_table *table = handle;
+	struct seek_table_record *rec;
+	struct seek_point *pt, *best = NULL;
+	uint32_t target, slot, err, best_err = UINT32_MAX;
+	unsigned int key;
+	int i;
+
+	if (!table || time_ms < 0 || max_err_ms < 0)
+		return -EINVAL;
+
+	rec = &table->rec;
+	target = time_ms;
+	slot = MIN(target / rec->interval, SEEK_TABLE_POINTS - 1);
+
+	key = irq_lock();
+
+	for (i = (slot > 0) ? -1 : 0; i <= 1 && slot + i < SEEK_TABLE_POINTS; i++) {
+		pt = &rec->points[slot + i];
+		if (!pt->file_offset)
+			continue;
+
+		err = (pt->time_ms > target) ? (pt->time_ms - target) : (target - pt->time_ms);
+		if (err <= max_err_ms && err < best_err) {
+			best_err = err;
+			best = pt;
+		}
+	}
+
+	if (best) {
+		bp->time_offset = best->time_ms;
+		bp->file_offset = best->file_offset;
+	}
+
+	irq_unlock(key);
+
+	return best ? 0 : -ENOENT;
+}
+
+void media_seek_table_add(void *handle, int time_ms, int file_offset)
+{
+	struct media_seek_table *table = handle;
+	unsigned int key;
+
+	if (!table || time_ms < 0 || file_offset <= 0)
+		return;
+
+	key = irq_lock();
+	_seek_table_insert(table, time_ms, file_offset);
+	irq_unlock(key);
+}
+
+void media_seek_table_add_breakpoint(void *handle, media_breakpoint_info_t *bp)
+{
+	struct media_seek_table *table = handle;
+
+	/* time and file offset of a breakpoint only agree for these formats */
+	if (table && (table->rec.format == MP3_TYPE || table->rec.format == WAV_TYPE
+			|| table->rec.format == WMA_TYPE)) {
+		media_seek_table_add(handle, bp->time_offset, bp->file_offset);
+	}
+}
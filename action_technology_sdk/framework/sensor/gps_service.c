@@ -22,6 +22,9 @@
 
 #include <gps/gps.h>
 #include <minmea.h>
+#ifdef CONFIG_GPS_NMEA_STREAM_PARSER
+#include <nmea_stream.h>
+#endif
 
 #define CONFIG_GPS_DEV_NAME	"gps"
 #define CONFIG_SENSORSRV_STACKSIZE 2048
@@ -31,6 +34,34 @@
 static gps_res_cb_t gps_res_cb = { NULL };
 static gps_res_t gps_res;
 
+#ifdef CONFIG_GPS_NMEA_STREAM_PARSER
+static struct nmea_stream gps_stream;
+
+/* sentence types stored in gps_res_t */
+static const uint32_t gps_stream_mask = 0
+#ifdef CONFIG_GPS_PARSE_RMC_ENABLE
+		| NMEA_STREAM_MASK(MINMEA_SENTENCE_RMC)
+#endif
+#ifdef CONFIG_GPS_PARSE_GGA_ENABLE
+		| NMEA_STREAM_MASK(MINMEA_SENTENCE_GGA)
+#endif
+#ifdef CONFIG_GPS_PARSE_GST_ENABLE
+		| NMEA_STREAM_MASK(MINMEA_SENTENCE_GST)
+#endif
+#ifdef CONFIG_GPS_PARSE_GSV_ENABLE
+		| NMEA_STREAM_MASK(MINMEA_SENTENCE_GSV)
+#endif
+#ifdef CONFIG_GPS_PARSE_VTG_ENABLE
+		| NMEA_STREAM_MASK(MINMEA_SENTENCE_VTG)
+#endif
+#ifdef CONFIG_GPS_PARSE_ZDA_ENABLE
+		| NMEA_STREAM_MASK(MINMEA_SENTENCE_ZDA)
+#endif
+		;
+
+static void gps_stream_callback(enum minmea_sentence_id id, const void *frame, void *user_data);
+#endif /* CONFIG_GPS_NMEA_STREAM_PARSER */
+
 void gps_event_report_nmea(uint8_t* gps_nmea_data)
 {
 	struct app_msg  msg = {0};
@@ -53,6 +84,10 @@ static void _gps_service_init(void)
 		SYS_LOG_ERR("cannot found key dev gps\n");
 	}
 	memset(&gps_res, 0, sizeof(gps_res));
+#ifdef CONFIG_GPS_NMEA_STREAM_PARSER
+	/* decode nothing until someone subscribes */
+	nmea_stream_init(&gps_stream, 0, gps_stream_callback, NULL);
+#endif
     gps_dev_register_notify(gps_dev, gps_notify_callback);
 }
 
@@ -74,6 +109,55 @@ static void gps_disable(void)
 	gps_dev_disable(gps_dev);
 }
 
+#ifdef CONFIG_GPS_NMEA_STREAM_PARSER
+static void gps_stream_callback(enum minmea_sentence_id id, const void *frame, void *user_data)
+{
+	switch (id)
+	{
+#ifdef CONFIG_GPS_PARSE_RMC_ENABLE
+		case MINMEA_SENTENCE_RMC:
+			memcpy(&gps_res.rmc_data, frame, sizeof(gps_res.rmc_data));
+			break;
+#endif
+#ifdef CONFIG_GPS_PARSE_GGA_ENABLE
+		case MINMEA_SENTENCE_GGA:
+			memcpy(&gps_res.gga_data, frame, sizeof(gps_res.gga_data));
+			break;
+#endif
+#ifdef CONFIG_GPS_PARSE_GST_ENABLE
+		case MINMEA_SENTENCE_GST:
+			memcpy(&gps_res.gst_data, frame, sizeof(gps_res.gst_data));
+			break;
+#endif
+#ifdef CONFIG_GPS_PARSE_GSV_ENABLE
+		case MINMEA_SENTENCE_GSV:
+			memcpy(&gps_res.gsv_data, frame, sizeof(gps_res.gsv_data));
+			break;
+#endif
+#ifdef CONFIG_GPS_PARSE_VTG_ENABLE
+		case MINMEA_SENTENCE_VTG:
+			memcpy(&gps_res.vtg_data, frame, sizeof(gps_res.vtg_data));
+			break;
+#endif
+#ifdef CONFIG_GPS_PARSE_ZDA_ENABLE
+		case MINMEA_SENTENCE_ZDA:
+			memcpy(&gps_res.zda_data, frame, sizeof(gps_res.zda_data));
+			break;
+#endif
+		default:
+			return;
+	}
+
+	if (gps_res_cb != NULL) {
+		gps_res_cb(0, &gps_res);
+	}
+}
+
+static void gps_minmea_parse(const char *sentence)
+{
+	nmea_stream_feed(&gps_stream, (const uint8_t *)sentence, strlen(sentence));
+}
+#else /* CONFIG_GPS_NMEA_STREAM_PARSER */
 static void gps_minmea_parse(const char *sentence)
 {
 	uint8_t parse_state = false;
@@ -188,6 +272,7 @@ static void gps_minmea_parse(const char *sentence)
 		gps_res_cb(0, &gps_res);
 	}
 }
+#endif /* CONFIG_GPS_NMEA_STREAM_PARSER */
 
 static void _gps_service_proc(struct app_msg *msg)
 {
@@ -207,10 +292,16 @@ static void _gps_service_proc(struct app_msg *msg)
 
 		case MSG_GPS_ADD_CB:
 			gps_res_cb = (gps_res_cb_t)msg->ptr;
+#ifdef CONFIG_GPS_NMEA_STREAM_PARSER
+			nmea_stream_set_mask(&gps_stream, gps_stream_mask);
+#endif
 			break;
 
 		case MSG_GPS_REMOVE_CB:
 			gps_res_cb = NULL;
+#ifdef CONFIG_GPS_NMEA_STREAM_PARSER
+			nmea_stream_set_mask(&gps_stream, 0);
+#endif
 			break;
 	
 		default:
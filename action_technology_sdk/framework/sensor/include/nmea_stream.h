@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2022 Actions Semi Co., Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief streaming NMEA parser interface
+ *
+ * The parser consumes the NMEA byte stream one byte at a time, validates the
+ * checksum and decodes the fields in the same pass directly into the minmea
+ * fixed-point sentence structures, without buffering the sentence text.
+ * Sentence types not in the subscribe mask are skipped after the address field.
+ */
+
+#ifndef __NMEA_STREAM_H__
+#define __NMEA_STREAM_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <minmea.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* subscribe mask bit of a sentence id */
+#define NMEA_STREAM_MASK(id)	(1u << (id))
+
+/**
+ * @brief Callback invoked for each valid decoded sentence
+ *
+ * @param id sentence id
+ * @param frame pointer to the decoded minmea sentence structure of type id
+ * @param user_data user data passed in nmea_stream_init()
+ */
+typedef void (*nmea_stream_cb_t)(enum minmea_sentence_id id, const void *frame, void *user_data);
+
+/* field accumulator, updated per received byte */
+struct nmea_field_acc {
+	int32_t value;
+	int32_t scale;
+	int32_t head;   /* first 6 leading digits, for date and time */
+	int32_t frac;   /* up to 6 digits after a '.' at the 7th character */
+	int8_t sign;
+	uint8_t len;
+	uint8_t lead;   /* number of leading digits */
+	uint8_t frac_digits;
+	uint8_t error : 1;
+	uint8_t alpha : 1;
+	uint8_t trunc : 1;
+	uint8_t overflow : 1;
+	uint8_t dot : 1;
+	uint8_t frac_end : 1;
+	char first;
+};
+
+/* decoded frame and scratch values of the current sentence */
+struct nmea_stream_frame {
+	union {
+		struct minmea_sentence_gbs gbs;
+		struct minmea_sentence_rmc rmc;
+		struct minmea_sentence_gga gga;
+		struct minmea_sentence_gsa gsa;
+		struct minmea_sentence_gll gll;
+		struct minmea_sentence_gst gst;
+		struct minmea_sentence_gsv gsv;
+		struct minmea_sentence_vtg vtg;
+		struct minmea_sentence_zda zda;
+	};
+
+	int dir[3];
+	char chr[5];
+};
+
+struct nmea_stream {
+	uint8_t state;
+	uint8_t len;
+	uint8_t index;     /* field index in the sentence format */
+	uint8_t optional;  /* the current and later fields are optional */
+	char type;         /* format of the current field, '\0' past the format */
+	const char *fmt;
+	uint8_t checksum;
+	uint8_t expected;
+	uint8_t nhex;
+	int8_t id;
+	char addr[5];
+
+	uint32_t mask;
+	nmea_stream_cb_t callback;
+	void *user_data;
+
+	struct nmea_field_acc acc;
+	struct nmea_stream_frame frame;
+
+	/* statistics */
+	uint32_t num_decoded;
+	uint32_t num_skipped;
+	uint32_t num_checksum_err;
+	uint32_t num_parse_err;
+};
+
+/**
+ * @brief Initialize a NMEA stream parser
+ *
+ * @param stream pointer to the parser
+ * @param mask subscribed sentence ids, combination of NMEA_STREAM_MASK()
+ * @param callback callback invoked for each decoded sentence
+ * @param user_data user data passed to callback
+ *
+ * @retval N/A
+ */
+void nmea_stream_init(struct nmea_stream *stream, uint32_t mask,
+		nmea_stream_cb_t callback, void *user_data);
+
+/**
+ * @brief Change the subscribed sentence ids of a NMEA stream parser
+ *
+ * @param stream pointer to the parser
+ * @param mask subscribed sentence ids, combination of NMEA_STREAM_MASK()
+ *
+ * @retval N/A
+ */
+void nmea_stream_set_mask(struct nmea_stream *stream, uint32_t mask);
+
+/**
+ * @brief Feed bytes to a NMEA stream parser
+ *
+ * Sentences may be split across calls at any byte position. A '$' always
+ * starts a new sentence, so a truncated sentence is dropped at the next one.
+ *
+ * @param stream pointer to the parser
+ * @param buf pointer to the received bytes
+ * @param len number of bytes
+ *
+ * @retval N/A
+ */
+void nmea_stream_feed(struct nmea_stream *stream, const uint8_t *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NMEA_STREAM_H__ */
@@ -26,6 +26,8 @@ enum SENSOR_MSG_ID {
 	MSG_SENSOR_REMOVE_CB,
 	MSG_SENSOR_ENABLE,
 	MSG_SENSOR_DISABLE,
+	MSG_SENSOR_SET_BATCH,
+	MSG_SENSOR_DUMP,
 };
 
 typedef int (*sensor_res_cb_t)(int evt_id, sensor_res_t *res);
@@ -45,6 +47,12 @@ int sensor_manager_disable(uint32_t id, uint32_t func);
 /* sensor manager get algo result funcion */
 int sensor_manager_get_result(sensor_res_t *res);
 
+/* sensor manager set max sample delivery latency (ms), 0 to disable batching */
+int sensor_manager_set_batch_latency(uint32_t id, uint32_t latency_ms);
+
+/* sensor manager dump wakeup and algo cpu time statistics */
+int sensor_manager_dump(void);
+
 /**
  * @brief sensor manager init funcion
  *
@@ -0,0 +1,616 @@
+/*
+ * Copyright (c) 2022 Actions Semi Co., Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief streaming NMEA parser
+ *
+ * Field semantics follow minmea_scan(), so the decoded frames are the same
+ * as the ones produced by minmea_parse_xxx().
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <nmea_stream.h>
+
+enum {
+	NMEA_STATE_IDLE = 0,  /* wait for '$' */
+	NMEA_STATE_ADDR,      /* talker and sentence type */
+	NMEA_STATE_FIELD,     /* data fields */
+	NMEA_STATE_CHECKSUM,  /* checksum hex digits */
+	NMEA_STATE_END,       /* wait for line end */
+	NMEA_STATE_SKIP,      /* skip the sentence */
+};
+
+#define MAX_FIELDS	20
+
+/* with the trailing CR LF */
+#define MAX_SENTENCE_LENGTH	(MINMEA_MAX_SENTENCE_LENGTH + 2)
+
+#define FRAME_OFF(member)	offsetof(struct nmea_stream_frame, member)
+#define DIR_OFF(i)			FRAME_OFF(dir[i])
+#define CHR_OFF(i)			FRAME_OFF(chr[i])
+
+typedef struct nmea_sentence_desc {
+	char type[3];
+	/* minmea_scan() format without the leading 't' */
+	const char *format;
+	uint8_t offsets[MAX_FIELDS];
+	bool (*finish)(struct nmea_stream_frame *frame);
+} nmea_sentence_desc_t;
+
+static bool _finish_rmc(struct nmea_stream_frame *frame)
+{
+	frame->rmc.valid = (frame->chr[0] == 'A');
+	frame->rmc.latitude.value *= frame->dir[0];
+	frame->rmc.longitude.value *= frame->dir[1];
+	frame->rmc.variation.value *= frame->dir[2];
+	return true;
+}
+
+static bool _finish_gga(struct nmea_stream_frame *frame)
+{
+	frame->gga.latitude.value *= frame->dir[0];
+	frame->gga.longitude.value *= frame->dir[1];
+	return true;
+}
+
+static bool _finish_gll(struct nmea_stream_frame *frame)
+{
+	frame->gll.latitude.value *= frame->dir[0];
+	frame->gll.longitude.value *= frame->dir[1];
+	return true;
+}
+
+static bool _finish_vtg(struct nmea_stream_frame *frame)
+{
+	/* values are only valid with the accompanying characters */
+	if (frame->chr[0] != 'T')
+		frame->vtg.true_track_degrees.scale = 0;
+	if (frame->chr[1] != 'M')
+		frame->vtg.magnetic_track_degrees.scale = 0;
+	if (frame->chr[2] != 'N')
+		frame->vtg.speed_knots.scale = 0;
+	if (frame->chr[3] != 'K')
+		frame->vtg.speed_kph.scale = 0;
+	frame->vtg.faa_mode = (enum minmea_faa_mode)frame->chr[4];
+	return true;
+}
+
+static bool _finish_zda(struct nmea_stream_frame *frame)
+{
+	/* check offsets */
+	return abs(frame->zda.hour_offset) <= 13 &&
+		frame->zda.minute_offset <= 59 && frame->zda.minute_offset >= 0;
+}
+
+/* indexed by enum minmea_sentence_id - 1 */
+static const nmea_sentence_desc_t sentence_descs[] = {
+	{ "GBS", "Tfffifff", {
+		FRAME_OFF(gbs.time), FRAME_OFF(gbs.err_latitude), FRAME_OFF(gbs.err_longitude),
+		FRAME_OFF(gbs.err_altitude), FRAME_OFF(gbs.svid), FRAME_OFF(gbs.prob),
+		FRAME_OFF(gbs.bias), FRAME_OFF(gbs.stddev),
+	}, NULL },
+	{ "GGA", "Tfdfdiiffcfcf_", {
+		FRAME_OFF(gga.time), FRAME_OFF(gga.latitude), DIR_OFF(0),
+		FRAME_OFF(gga.longitude), DIR_OFF(1), FRAME_OFF(gga.fix_quality),
+		FRAME_OFF(gga.satellites_tracked), FRAME_OFF(gga.hdop),
+		FRAME_OFF(gga.altitude), FRAME_OFF(gga.altitude_units),
+		FRAME_OFF(gga.height), FRAME_OFF(gga.height_units), FRAME_OFF(gga.dgps_age),
+	}, _finish_gga },
+	{ "GLL", "fdfdTc;c", {
+		FRAME_OFF(gll.latitude), DIR_OFF(0), FRAME_OFF(gll.longitude), DIR_OFF(1),
+		FRAME_OFF(gll.time), FRAME_OFF(gll.status), FRAME_OFF(gll.mode),
+	}, _finish_gll },
+	{ "GSA", "ciiiiiiiiiiiiifff", {
+		FRAME_OFF(gsa.mode), FRAME_OFF(gsa.fix_type),
+		FRAME_OFF(gsa.sats[0]), FRAME_OFF(gsa.sats[1]), FRAME_OFF(gsa.sats[2]),
+		FRAME_OFF(gsa.sats[3]), FRAME_OFF(gsa.sats[4]), FRAME_OFF(gsa.sats[5]),
+		FRAME_OFF(gsa.sats[6]), FRAME_OFF(gsa.sats[7]), FRAME_OFF(gsa.sats[8]),
+		FRAME_OFF(gsa.sats[9]), FRAME_OFF(gsa.sats[10]), FRAME_OFF(gsa.sats[11]),
+		FRAME_OFF(gsa.pdop), FRAME_OFF(gsa.hdop), FRAME_OFF(gsa.vdop),
+	}, NULL },
+	{ "GST", "Tfffffff", {
+		FRAME_OFF(gst.time), FRAME_OFF(gst.rms_deviation),
+		FRAME_OFF(gst.semi_major_deviation), FRAME_OFF(gst.semi_minor_deviation),
+		FRAME_OFF(gst.semi_major_orientation), FRAME_OFF(gst.latitude_error_deviation),
+		FRAME_OFF(gst.longitude_error_deviation), FRAME_OFF(gst.altitude_error_deviation),
+	}, NULL },
+	{ "GSV", "iii;iiiiiiiiiiiiiiii", {
+		FRAME_OFF(gsv.total_msgs), FRAME_OFF(gsv.msg_nr), FRAME_OFF(gsv.total_sats),
+		FRAME_OFF(gsv.sats[0].nr), FRAME_OFF(gsv.sats[0].elevation),
+		FRAME_OFF(gsv.sats[0].azimuth), FRAME_OFF(gsv.sats[0].snr),
+		FRAME_OFF(gsv.sats[1].nr), FRAME_OFF(gsv.sats[1].elevation),
+		FRAME_OFF(gsv.sats[1].azimuth), FRAME_OFF(gsv.sats[1].snr),
+		FRAME_OFF(gsv.sats[2].nr), FRAME_OFF(gsv.sats[2].elevation),
+		FRAME_OFF(gsv.sats[2].azimuth), FRAME_OFF(gsv.sats[2].snr),
+		FRAME_OFF(gsv.sats[3].nr), FRAME_OFF(gsv.sats[3].elevation),
+		FRAME_OFF(gsv.sats[3].azimuth), FRAME_OFF(gsv.sats[3].snr),
+	}, NULL },
+	{ "RMC", "TcfdfdffDfd", {
+		FRAME_OFF(rmc.time), CHR_OFF(0), FRAME_OFF(rmc.latitude), DIR_OFF(0),
+		FRAME_OFF(rmc.longitude), DIR_OFF(1), FRAME_OFF(rmc.speed),
+		FRAME_OFF(rmc.course), FRAME_OFF(rmc.date), FRAME_OFF(rmc.variation), DIR_OFF(2),
+	}, _finish_rmc },
+	{ "VTG", ";fcfcfcfcc", {
+		FRAME_OFF(vtg.true_track_degrees), CHR_OFF(0),
+		FRAME_OFF(vtg.magnetic_track_degrees), CHR_OFF(1),
+		FRAME_OFF(vtg.speed_knots), CHR_OFF(2),
+		FRAME_OFF(vtg.speed_kph), CHR_OFF(3), CHR_OFF(4),
+	}, _finish_vtg },
+	{ "ZDA", "Tiiiii", {
+		FRAME_OFF(zda.time), FRAME_OFF(zda.date.day), FRAME_OFF(zda.date.month),
+		FRAME_OFF(zda.date.year), FRAME_OFF(zda.hour_offset), FRAME_OFF(zda.minute_offset),
+	}, _finish_zda },
+};
+
+static const nmea_sentence_desc_t *_get_desc(int id)
+{
+	return &sentence_descs[id - MINMEA_SENTENCE_GBS];
+}
+
+static int _hex2int(uint8_t c)
+{
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	if (c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	return -1;
+}
+
+static bool _isfield(uint8_t c)
+{
+	return c >= 0x20 && c < 0x7f && c != ',' && c != '*';
+}
+
+/* skip to the format of the next field, ';' makes the rest optional */
+static void _skip_format(struct nmea_stream *stream)
+{
+	while (*stream->fmt == ';') {
+		stream->optional = 1;
+		stream->fmt++;
+	}
+
+	stream->type = *stream->fmt;
+}
+
+/* move to the format of the next field, past the end it stays at '\0' */
+static void _next_format(struct nmea_stream *stream)
+{
+	if (*stream->fmt) {
+		stream->fmt++;
+		stream->index++;
+	}
+
+	_skip_format(stream);
+}
+
+static void _acc_reset(struct nmea_field_acc *acc)
+{
+	memset(acc, 0, sizeof(*acc));
+	acc->value = -1;
+}
+
+/* date and time only look at the 6 leading digits and the fraction after */
+static void _acc_put_datetime(struct nmea_field_acc *acc, uint8_t pos, uint8_t c)
+{
+	bool is_digit = (c >= '0' && c <= '9');
+
+	if (is_digit && acc->lead == pos) {
+		if (acc->lead < 6)
+			acc->head = acc->head * 10 + (c - '0');
+		acc->lead++;
+	}
+
+	if (pos == 6) {
+		acc->dot = (c == '.');
+	} else if (pos > 6 && acc->dot && !acc->frac_end) {
+		if (is_digit && acc->frac_digits < 6) {
+			acc->frac = acc->frac * 10 + (c - '0');
+			acc->frac_digits++;
+		} else {
+			acc->frac_end = 1;
+		}
+	}
+}
+
+static void _acc_put_number(struct nmea_field_acc *acc, uint8_t c)
+{
+	/* minmea_scan() ignores the rest of a fractional field once truncated */
+	if (acc->trunc)
+		return;
+
+	if (c >= '0' && c <= '9') {
+		int digit = c - '0';
+
+		if (acc->overflow)
+			return;
+
+		if (acc->value == -1)
+			acc->value = 0;
+
+		if (acc->value > (INT32_MAX - digit) / 10) {
+			/* truncate extra precision, or flag integer overflow */
+			if (acc->scale)
+				acc->trunc = 1;
+			else
+				acc->overflow = 1;
+			return;
+		}
+
+		acc->value = acc->value * 10 + digit;
+		if (acc->scale)
+			acc->scale *= 10;
+	} else if (c == '.' && acc->scale == 0) {
+		acc->scale = 1;
+	} else if ((c == '+' || c == '-') && !acc->sign && acc->value == -1) {
+		acc->sign = (c == '-') ? -1 : 1;
+	} else if (c == ' ') {
+		/* allow spaces at the start of the field */
+		if (acc->sign != 0 || acc->value != -1 || acc->scale != 0)
+			acc->error = 1;
+	} else {
+		acc->alpha = 1;
+	}
+}
+
+/* accumulate only what _acc_store() reads for the field type */
+static void _acc_put(struct nmea_field_acc *acc, char type, uint8_t c)
+{
+	uint8_t pos = acc->len++;
+
+	switch (type) {
+	case 'c':
+	case 'd':
+		if (pos == 0)
+			acc->first = c;
+		break;
+	case 'f':
+	case 'i':
+		_acc_put_number(acc, c);
+		break;
+	case 'D':
+	case 'T':
+		_acc_put_datetime(acc, pos, c);
+		break;
+	default:
+		break;
+	}
+}
+
+/* decode the accumulated field, return false on parse error */
+static bool _acc_store(const struct nmea_field_acc *acc, char type, void *dst)
+{
+	bool empty = (acc->len == 0);
+
+	switch (type) {
+	case 'c':
+		*(char *)dst = empty ? '\0' : acc->first;
+		break;
+
+	case 'd': {
+		int value = 0;
+
+		if (!empty) {
+			switch (acc->first) {
+			case 'N':
+			case 'E':
+				value = 1;
+				break;
+			case 'S':
+			case 'W':
+				value = -1;
+				break;
+			default:
+				return false;
+			}
+		}
+
+		*(int *)dst = value;
+	} break;
+
+	case 'f': {
+		struct minmea_float *f = dst;
+
+		if (acc->error || acc->alpha || acc->overflow)
+			return false;
+		if ((acc->sign || acc->scale) && acc->value == -1)
+			return false;
+
+		if (acc->value == -1) {
+			f->value = 0;
+			f->scale = 0;
+		} else {
+			f->value = acc->sign ? acc->value * acc->sign : acc->value;
+			f->scale = acc->scale ? acc->scale : 1;
+		}
+	} break;
+
+	case 'i': {
+		int value = 0;
+
+		/* strtol() semantics: spaces, sign, at least one digit, nothing else */
+		if (acc->error || acc->alpha || acc->scale)
+			return false;
+		if (!empty && acc->value == -1)
+			return false;
+		if (acc->overflow)
+			value = (acc->sign < 0) ? INT32_MIN : INT32_MAX;
+		else if (acc->value != -1)
+			value = acc->sign ? acc->value * acc->sign : acc->value;
+
+		*(int *)dst = value;
+	} break;
+
+	case 'D': {
+		struct minmea_date *date = dst;
+
+		if (empty) {
+			date->day = date->month = date->year = -1;
+			break;
+		}
+
+		if (acc->lead < 6)
+			return false;
+
+		date->day = acc->head / 10000;
+		date->month = acc->head / 100 % 100;
+		date->year = acc->head % 100;
+	} break;
+
+	case 'T': {
+		struct minmea_time *time_ = dst;
+		int32_t us = 0;
+		int i;
+
+		if (empty) {
+			time_->hours = time_->minutes = time_->seconds = time_->microseconds = -1;
+			break;
+		}
+
+		if (acc->lead < 6)
+			return false;
+
+		if (acc->dot) {
+			us = acc->frac;
+			for (i = acc->frac_digits; i < 6; i++)
+				us *= 10;
+		}
+
+		time_->hours = acc->head / 10000;
+		time_->minutes = acc->head / 100 % 100;
+		time_->seconds = acc->head % 100;
+		time_->microseconds = us;
+	} break;
+
+	default:
+		break;
+	}
+
+	return true;
+}
+
+static void _nmea_stream_end_field(struct nmea_stream *stream)
+{
+	const nmea_sentence_desc_t *desc = _get_desc(stream->id);
+
+	if (stream->type != '\0' && stream->type != '_') {
+		if (!_acc_store(&stream->acc, stream->type,
+				(uint8_t *)&stream->frame + desc->offsets[stream->index])) {
+			stream->num_parse_err++;
+			stream->state = NMEA_STATE_SKIP;
+			return;
+		}
+	}
+
+	_next_format(stream);
+	_acc_reset(&stream->acc);
+}
+
+static void _nmea_stream_commit(struct nmea_stream *stream)
+{
+	const nmea_sentence_desc_t *desc = _get_desc(stream->id);
+
+	/* fill the missing fields with default values */
+	while (stream->type != '\0') {
+		if (!stream->optional) {
+			stream->num_parse_err++;
+			return;
+		}
+
+		_acc_reset(&stream->acc);
+		_acc_store(&stream->acc, stream->type,
+				(uint8_t *)&stream->frame + desc->offsets[stream->index]);
+		_next_format(stream);
+	}
+
+	if (desc->finish && !desc->finish(&stream->frame)) {
+		stream->num_parse_err++;
+		return;
+	}
+
+	stream->num_decoded++;
+
+	if (stream->callback)
+		stream->callback(stream->id, &stream->frame, stream->user_data);
+}
+
+/* the data fields end at c, a '*' or the line end */
+static void _nmea_stream_end_data(struct nmea_stream *stream, uint8_t c)
+{
+	if (c == '*') {
+		stream->state = NMEA_STATE_CHECKSUM;
+	} else {
+		/* no checksum, accepted in non-strict mode like minmea */
+		stream->state = NMEA_STATE_IDLE;
+		_nmea_stream_commit(stream);
+	}
+}
+
+static void _nmea_stream_begin(struct nmea_stream *stream)
+{
+	stream->state = NMEA_STATE_ADDR;
+	stream->len = 0;
+	stream->checksum = 0;
+	stream->nhex = 0;
+	stream->id = MINMEA_UNKNOWN;
+}
+
+static void _nmea_stream_lookup(struct nmea_stream *stream)
+{
+	int id;
+
+	for (id = MINMEA_SENTENCE_GBS; id <= MINMEA_SENTENCE_ZDA; id++) {
+		if (!memcmp(stream->addr + 2, _get_desc(id)->type, 3))
+			break;
+	}
+
+	if (id > MINMEA_SENTENCE_ZDA || !(stream->mask & NMEA_STREAM_MASK(id))) {
+		stream->num_skipped++;
+		stream->state = NMEA_STATE_SKIP;
+		return;
+	}
+
+	stream->id = id;
+	stream->state = NMEA_STATE_FIELD;
+	stream->fmt = _get_desc(id)->format;
+	stream->index = 0;
+	stream->optional = 0;
+	_skip_format(stream);
+	memset(&stream->frame, 0, sizeof(stream->frame));
+	_acc_reset(&stream->acc);
+}
+
+void nmea_stream_init(struct nmea_stream *stream, uint32_t mask,
+		nmea_stream_cb_t callback, void *user_data)
+{
+	memset(stream, 0, sizeof(*stream));
+	stream->mask = mask;
+	stream->callback = callback;
+	stream->user_data = user_data;
+}
+
+void nmea_stream_set_mask(struct nmea_stream *stream, uint32_t mask)
+{
+	stream->mask = mask;
+}
+
+void nmea_stream_feed(struct nmea_stream *stream, const uint8_t *buf, size_t len)
+{
+	while (len > 0) {
+		uint8_t c;
+
+		/* nothing to decode until the next sentence */
+		if (stream->state == NMEA_STATE_IDLE || stream->state == NMEA_STATE_SKIP) {
+			const uint8_t *start = memchr(buf, '$', len);
+
+			if (start == NULL)
+				return;
+
+			len -= start - buf;
+			buf = start;
+		}
+
+		c = *buf++;
+		len--;
+
+		if (c == '$') {
+			_nmea_stream_begin(stream);
+			continue;
+		}
+
+		if (++stream->len > MAX_SENTENCE_LENGTH) {
+			stream->num_parse_err++;
+			stream->state = NMEA_STATE_IDLE;
+			continue;
+		}
+
+		switch (stream->state) {
+		case NMEA_STATE_ADDR:
+			if (_isfield(c)) {
+				stream->checksum ^= c;
+				if (stream->len <= 5)
+					stream->addr[stream->len - 1] = c;
+				break;
+			}
+
+			/* like minmea, the type is the first 5 characters of the field */
+			if (stream->len <= 5 || (c != ',' && c != '*' && c != '\r' && c != '\n')) {
+				stream->state = NMEA_STATE_SKIP;
+				break;
+			}
+
+			_nmea_stream_lookup(stream);
+			if (stream->state != NMEA_STATE_FIELD)
+				break;
+
+			if (c == ',') {
+				stream->checksum ^= c;
+			} else {
+				/* no data field at all */
+				_nmea_stream_end_data(stream, c);
+			}
+			break;
+
+		case NMEA_STATE_FIELD:
+			if (c == '*' || c == '\r' || c == '\n') {
+				_nmea_stream_end_field(stream);
+				if (stream->state != NMEA_STATE_SKIP)
+					_nmea_stream_end_data(stream, c);
+				break;
+			}
+
+			if (c < 0x20 || c >= 0x7f) {
+				stream->num_parse_err++;
+				stream->state = NMEA_STATE_SKIP;
+				break;
+			}
+
+			stream->checksum ^= c;
+
+			if (c == ',') {
+				_nmea_stream_end_field(stream);
+			} else {
+				_acc_put(&stream->acc, stream->type, c);
+			}
+			break;
+
+		case NMEA_STATE_CHECKSUM: {
+			int hex = _hex2int(c);
+
+			if (hex < 0) {
+				stream->num_checksum_err++;
+				stream->state = NMEA_STATE_SKIP;
+				break;
+			}
+
+			stream->expected = (stream->expected << 4) | hex;
+			if (++stream->nhex == 2) {
+				stream->state = NMEA_STATE_END;
+			}
+		} break;
+
+		case NMEA_STATE_END:
+			if (c == '\r' || c == '\n') {
+				stream->state = NMEA_STATE_IDLE;
+				if (stream->expected != stream->checksum) {
+					stream->num_checksum_err++;
+				} else {
+					_nmea_stream_commit(stream);
+				}
+			} else {
+				stream->num_parse_err++;
+				stream->state = NMEA_STATE_SKIP;
+			}
+			break;
+
+		default:
+			break;
+		}
+	}
+}
@@ -116,6 +116,16 @@ int sensor_manager_get_result(sensor_res_t *res)
 	return sensor_send_msg(MSG_SENSOR_GET_RESULT, sizeof(sensor_res_t), res, 1);
 }
 
+int sensor_manager_set_batch_latency(uint32_t id, uint32_t latency_ms)
+{
+	return sensor_send_msg(MSG_SENSOR_SET_BATCH, id, (void*)latency_ms, 0);
+}
+
+int sensor_manager_dump(void)
+{
+	return sensor_send_msg(MSG_SENSOR_DUMP, 0, NULL, 0);
+}
+
 int sensor_manager_init(void)
 {
 	_sensor_service_start();
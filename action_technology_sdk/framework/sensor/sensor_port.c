@@ -11,6 +11,7 @@
 /******************************************************************************/
 #include <stdio.h>
 #include <string.h>
+#include <errno.h>
 #include <zephyr.h>
 #include <drivers/ipmsg.h>
 #include <rbuf/rbuf_msg_sc.h>
@@ -24,6 +25,24 @@
 /******************************************************************************/
 #define MAX_SENSOR_DATA_NUM			(4)
 
+#ifdef CONFIG_SENSOR_BATCH_MODE
+/* sensors which deliver sample arrays and can be batched */
+#define NUM_BATCH_SENSOR			(ID_MAG + 1)
+#endif
+
+/******************************************************************************/
+//typedefs
+/******************************************************************************/
+#ifdef CONFIG_SENSOR_BATCH_MODE
+typedef struct {
+	uint8_t buf[2][CONFIG_SENSOR_BATCH_BUF_SIZE];
+	sensor_dat_t dat[2];  // dat[i].buf points to buf[i]
+	uint8_t fill;         // index of the buffer being filled
+	uint8_t busy;         // the other buffer is owned by service
+	uint16_t latency;     // max delivery latency (ms), 0 to disable
+} sensor_batch_t;
+#endif
+
 /******************************************************************************/
 //variables
 /******************************************************************************/
@@ -33,26 +52,161 @@ static sensor_dat_t sensor_dat[MAX_SENSOR_DATA_NUM];
 static struct ring_buf sensor_rbuf;
 static os_delayed_work sensor_work;
 
+#ifdef CONFIG_SENSOR_BATCH_MODE
+static sensor_batch_t sensor_batch[NUM_BATCH_SENSOR];
+#endif
+
+static uint32_t sensor_wakeups;
+static uint32_t sensor_samples[NUM_SENSOR];
+static uint32_t sensor_drops[NUM_SENSOR];
+static uint32_t sensor_stat_start;
+
 /******************************************************************************/
 //functions
 /******************************************************************************/
+static void _sensor_work_submit(int32_t delay)
+{
+#ifdef CONFIG_USER_WORK_Q
+	os_work_q *work_queue = os_get_user_work_queue();
+	os_delayed_work_submit_to_queue(work_queue, &sensor_work, delay);
+#else
+	os_delayed_work_submit(&sensor_work, delay);
+#endif
+}
+
+#ifdef CONFIG_SENSOR_BATCH_MODE
+static void _sensor_batch_flush(void)
+{
+	sensor_batch_t *batch;
+	uint32_t key;
+	int id, ret;
+
+	for (id = 0; id < NUM_BATCH_SENSOR; id ++) {
+		batch = &sensor_batch[id];
+
+		key = irq_lock();
+		if (batch->busy || (batch->dat[batch->fill].cnt == 0)) {
+			irq_unlock(key);
+			continue;
+		}
+
+		// hand the filled buffer over to service
+		ret = ring_buf_put(&sensor_rbuf, (const uint8_t *)&batch->dat[batch->fill], sizeof(sensor_dat_t));
+		if (ret) {
+			batch->busy = 1;
+			batch->fill ^= 1;
+			batch->dat[batch->fill].cnt = 0;
+		}
+		irq_unlock(key);
+
+		if (!ret) {
+			SYS_LOG_ERR("sensor rbuf full");
+		}
+	}
+}
+
+/* return 1 if data is batched, else 0 */
+static int _sensor_batch_put(int id, sensor_dat_t *dat)
+{
+	sensor_batch_t *batch;
+	sensor_dat_t *bdat;
+	uint32_t key, len;
+	int32_t delay = -1;
+
+	if ((id >= NUM_BATCH_SENSOR) || (dat->buf == NULL) || (dat->cnt == 0)) {
+		return 0;
+	}
+
+	batch = &sensor_batch[id];
+	if (batch->latency == 0) {
+		return 0;
+	}
+
+	len = dat->sz * dat->cnt;
+
+	key = irq_lock();
+	bdat = &batch->dat[batch->fill];
+	if ((bdat->cnt > 0) && (bdat->sz * (bdat->cnt + dat->cnt) > CONFIG_SENSOR_BATCH_BUF_SIZE)) {
+		// no room, drop the batch if service still owns the other one
+		if (!batch->busy && ring_buf_put(&sensor_rbuf, (const uint8_t *)bdat, sizeof(sensor_dat_t))) {
+			batch->busy = 1;
+			batch->fill ^= 1;
+		} else {
+			sensor_drops[id] += bdat->cnt;
+		}
+		bdat = &batch->dat[batch->fill];
+		bdat->cnt = 0;
+		delay = 0;
+	}
+
+	if (len > CONFIG_SENSOR_BATCH_BUF_SIZE) {
+		irq_unlock(key);
+		return 0;
+	}
+
+	if (bdat->cnt == 0) {
+		*bdat = *dat;
+		bdat->buf = batch->buf[batch->fill];
+		bdat->cnt = 0;
+		if (delay < 0) {
+			delay = batch->latency;
+		}
+	}
+	memcpy(bdat->buf + bdat->sz * bdat->cnt, dat->buf, len);
+	bdat->cnt += dat->cnt;
+	bdat->ts = dat->ts;
+
+	// flush at once if next chunk will not fit
+	if (bdat->sz * (bdat->cnt + dat->cnt) > CONFIG_SENSOR_BATCH_BUF_SIZE) {
+		delay = 0;
+	}
+	irq_unlock(key);
+
+	if (delay == 0) {
+		_sensor_work_submit(0);
+	} else if ((delay > 0) && (!os_delayed_work_is_pending(&sensor_work) ||
+			(os_delayed_work_remaining_get(&sensor_work) > delay))) {
+		_sensor_work_submit(delay);
+	}
+
+	return 1;
+}
+#endif /* CONFIG_SENSOR_BATCH_MODE */
+
 static void _sensor_work_handler(struct k_work *work)
 {
+	sensor_wakeups ++;
+
+#ifdef CONFIG_SENSOR_BATCH_MODE
+	_sensor_batch_flush();
+#endif
+
 	sensor_send_msg(MSG_SENSOR_DATA, 0, NULL, 0);
 }
 
 static void sensor_task_callback(int id, sensor_dat_t *dat, void *ctx)
 {
-	int ret = ring_buf_put(&sensor_rbuf, (const uint8_t *)dat, sizeof(sensor_dat_t));
+	uint32_t key;
+	int ret;
+
+	sensor_samples[id] += dat->cnt;
+
+#ifdef CONFIG_SENSOR_BATCH_MODE
+	if (_sensor_batch_put(id, dat)) {
+		return;
+	}
+#endif
+
+	// same lock as the batch flush, the other producer of sensor_rbuf
+	key = irq_lock();
+	ret = ring_buf_put(&sensor_rbuf, (const uint8_t *)dat, sizeof(sensor_dat_t));
+	irq_unlock(key);
 	if (!ret) {
+		sensor_drops[id] += dat->cnt;
 		SYS_LOG_ERR("sensor rbuf full");
 	}
-#ifdef CONFIG_USER_WORK_Q
-	os_work_q *work_queue = os_get_user_work_queue();
-	os_delayed_work_submit_to_queue(work_queue, &sensor_work, 0);
-#else
-	os_delayed_work_submit(&sensor_work, 0);
-#endif
+
+	_sensor_work_submit(0);
 }
 
 int sensor_init(void)
@@ -75,6 +229,13 @@ int sensor_init(void)
 	ring_buf_init(&sensor_rbuf, sizeof(sensor_dat), sensor_dat);
 	os_delayed_work_init(&sensor_work, _sensor_work_handler);
 
+#ifdef CONFIG_SENSOR_BATCH_MODE
+	sensor_set_batch_latency(ID_ACC, CONFIG_SENSOR_BATCH_MAX_LATENCY);
+	sensor_set_batch_latency(ID_MAG, CONFIG_SENSOR_BATCH_MAX_LATENCY);
+#endif
+
+	sensor_stat_start = k_uptime_get_32();
+
 	return ret;
 }
 
@@ -88,8 +249,70 @@ int sensor_get_data(sensor_dat_t *pdat)
 	return ring_buf_get(&sensor_rbuf, (uint8_t *)pdat, sizeof(sensor_dat_t));
 }
 
+void sensor_put_data(sensor_dat_t *pdat)
+{
+#ifdef CONFIG_SENSOR_BATCH_MODE
+	sensor_batch_t *batch;
+	uint32_t key;
+
+	if (pdat->id >= NUM_BATCH_SENSOR) {
+		return;
+	}
+
+	batch = &sensor_batch[pdat->id];
+
+	key = irq_lock();
+	if (batch->busy && (pdat->buf == batch->buf[batch->fill ^ 1])) {
+		batch->busy = 0;
+		// samples may have been held back while busy
+		if (batch->dat[batch->fill].cnt > 0) {
+			_sensor_work_submit(0);
+		}
+	}
+	irq_unlock(key);
+#endif
+}
+
 int sensor_data_is_empty(void)
 {
 	return ring_buf_is_empty(&sensor_rbuf);
 }
 
+int sensor_set_batch_latency(int id, uint16_t latency_ms)
+{
+#ifdef CONFIG_SENSOR_BATCH_MODE
+	if ((id < 0) || (id >= NUM_BATCH_SENSOR)) {
+		return -EINVAL;
+	}
+
+	sensor_batch[id].latency = latency_ms;
+	if (latency_ms == 0) {
+		// deliver the pending samples
+		_sensor_work_submit(0);
+	}
+
+	return 0;
+#else
+	return (latency_ms == 0) ? 0 : -ENOTSUP;
+#endif
+}
+
+void sensor_dump_stats(void)
+{
+	uint32_t elapsed = k_uptime_get_32() - sensor_stat_start;
+	int id;
+
+	if (elapsed == 0) {
+		elapsed = 1;
+	}
+
+	printk("sensor wakeups %u in %u ms (%u.%02u/s)\n", sensor_wakeups, elapsed,
+		sensor_wakeups * 1000 / elapsed, (sensor_wakeups * 100000 / elapsed) % 100);
+
+	for (id = 0; id < NUM_SENSOR; id ++) {
+		if (sensor_samples[id] > 0) {
+			printk("[%s] samples %u, dropped %u\n", sensor_hal_get_type(id),
+				sensor_samples[id], sensor_drops[id]);
+		}
+	}
+}
@@ -29,7 +29,11 @@ int sensor_init(void);
 int sensor_poll(void);
 
 int sensor_get_data(sensor_dat_t *pdat);
+void sensor_put_data(sensor_dat_t *pdat);
 int sensor_data_is_empty(void);
 
+int sensor_set_batch_latency(int id, uint16_t latency_ms);
+void sensor_dump_stats(void);
+
 #endif  /* _SENSOR_PORT_H */
 
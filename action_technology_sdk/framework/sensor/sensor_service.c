@@ -33,6 +33,7 @@
 #define MAX_SENSOR_CB	8
 
 static sensor_res_cb_t sensor_res_cb[MAX_SENSOR_CB] = { NULL };
+static uint64_t algo_cycles[NUM_SENSOR] = { 0 };
 
 int sensor_service_callback(int evt_id, sensor_res_t *res)
 {
@@ -73,6 +74,7 @@ static void _sensor_service_proc(struct app_msg *msg)
 {
 	sensor_dat_t dat;
 	sensor_res_t *res;
+	uint32_t start;
 	int idx;
 	
 	SYS_LOG_DBG("sensor cmd %d",msg->cmd);
@@ -80,7 +82,24 @@ static void _sensor_service_proc(struct app_msg *msg)
 	case MSG_SENSOR_DATA:
 		while (!sensor_data_is_empty()) {
 			if (sensor_get_data(&dat) > 0) {
+				start = k_cycle_get_32();
 				algo_handler(dat.id, &dat);
+				algo_cycles[dat.id] += k_cycle_get_32() - start;
+				sensor_put_data(&dat);
+			}
+		}
+		break;
+
+	case MSG_SENSOR_SET_BATCH:
+		sensor_set_batch_latency(msg->reserve, (uint16_t)(uint32_t)msg->ptr);
+		break;
+
+	case MSG_SENSOR_DUMP:
+		sensor_dump_stats();
+		for (idx = 0; idx < NUM_SENSOR; idx ++) {
+			if (algo_cycles[idx] > 0) {
+				printk("[%s] algo %llu us\n", sensor_hal_get_type(idx),
+					k_cyc_to_us_floor64(algo_cycles[idx]));
 			}
 		}
 		break;
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Playback of a drifting source through the APS monitor of audio_aps.c,
+ * built once with the PI controller (CONFIG_AUDIO_APS_PI_CONTROLLER) and
+ * once with the watermark state machine.
+ *
+ * The source sends 20 ms packets on its own clock, offset from the sink
+ * by a fixed ppm, with arrival jitter and an occasional 120 ms stall. The
+ * sink plays 1 ms per ms at the rate of the APS level set through
+ * hal_aout_channel_set_aps(), taken from the audio PLL frequencies of
+ * audio_aps_level_e. audio_aps_monitor() sees the stream length every
+ * millisecond on the simulated clock, as from the playback thread.
+ *
+ * After a minute of settling the simulation reports the mean and spread
+ * of the stream length, the underruns and the APS level changes per
+ * minute; with the PI controller also the drift estimate, which must
+ * match the source offset, and a mean length on the target.
+ *
+ * usage: aps_sim [seconds]
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include <os_common_api.h>
+#include <audio_hal.h>
+#include <audio_system.h>
+#include <audio_track.h>
+#include <media_type.h>
+#include <test_common.h>
+
+TEST_MAIN_DEFINE();
+
+#define PKT_MS			20
+#define JITTER_MS		40
+#define STALL_MS		80
+#define STALL_PCT		1
+#define SETTLE_MS		(60 * 1000)
+
+#define WATER_INC		200
+#define WATER_DEC		100
+
+/* audio PLL of APS_LEVEL_1 ~ APS_LEVEL_8 at 44.1KHz, see audio_aps_level_e */
+static const double level_khz[] = {
+	44.0006, 44.0245, 44.0625, 44.0848, 44.0995, 44.1176, 44.1323, 44.1964,
+};
+
+typedef struct {
+	int drift_ppm;          // source clock offset
+	double mean;
+	double sd;
+	double min;
+	double max;
+	int underruns;
+	int changes;            // level changes per minute
+	int est_ppm;            // PI only
+	int target;
+} sim_result_t;
+
+static struct audio_track_t track;
+static int aps_level;
+static int aps_changes;
+
+int hal_aout_channel_set_aps(void *aout_channel_handle, unsigned int aps_level_set, unsigned int aps_mode)
+{
+	if (aps_level_set != aps_level)
+		aps_changes++;
+	aps_level = aps_level_set;
+	return 0;
+}
+
+int audio_policy_get_increase_threshold(int format)
+{
+	return WATER_INC;
+}
+
+int audio_policy_get_reduce_threshold(int format)
+{
+	return WATER_DEC;
+}
+
+int system_check_low_latencey_mode(void)
+{
+	return 0;
+}
+
+int audio_track_set_waitto_start(struct audio_track_t *handle, bool wait)
+{
+	return 0;
+}
+
+static double uniform(uint32_t *seed)
+{
+	return (test_rand(seed) % 1000) / 1000.0;
+}
+
+static void sim_run(int drift_ppm, int seconds, sim_result_t *res)
+{
+	uint32_t seed = 7;
+	double fill = (WATER_INC + WATER_DEC) / 2;
+	double send_ms = 0, arrive_ms = 0, last_arrive_ms = 0;
+	double sum = 0, sum2 = 0;
+	int64_t start = k_uptime_get();
+	int ms, num = 0, changes = 0;
+
+	memset(res, 0, sizeof(*res));
+	res->drift_ppm = drift_ppm;
+	res->min = 1e9;
+
+	track.output_sample_rate_hz = 44100;
+	audio_aps_monitor_init(SBC_TYPE, NULL, &track);
+	aps_level = audio_aps_monitor_get_instance()->current_level;
+	aps_changes = 0;
+	arrive_ms = -1;
+
+	for (ms = 0; ms < seconds * 1000; ms++) {
+		sim_clock_advance(1);
+
+		fill -= level_khz[aps_level] / 44.1;
+		if (fill < 0) {
+			res->underruns++;
+			fill = 0;
+		}
+
+		for (;;) {
+			if (arrive_ms < 0) {
+				arrive_ms = send_ms + uniform(&seed) * JITTER_MS;
+				if (test_rand(&seed) % 100 < STALL_PCT)
+					arrive_ms += STALL_MS;
+				arrive_ms = MAX(arrive_ms, last_arrive_ms);
+				last_arrive_ms = arrive_ms;
+				send_ms += PKT_MS / (1 + drift_ppm * 1e-6);
+			}
+
+			if (arrive_ms > ms)
+				break;
+
+			fill += PKT_MS;
+			arrive_ms = -1;
+		}
+
+		audio_aps_monitor((int)fill);
+
+		if (ms == SETTLE_MS)
+			changes = aps_changes;
+
+		if (ms >= SETTLE_MS) {
+			sum += fill;
+			sum2 += fill * fill;
+			res->min = MIN(res->min, fill);
+			res->max = MAX(res->max, fill);
+			num++;
+		}
+	}
+
+	res->mean = sum / num;
+	res->sd = sqrt(MAX(sum2 / num - res->mean * res->mean, 0));
+	res->changes = (aps_changes - changes) * 60000LL / (k_uptime_get() - start - SETTLE_MS);
+
+#ifdef CONFIG_AUDIO_APS_PI_CONTROLLER
+	{
+		aps_monitor_stat_t stat;
+
+		TEST_CHECK(!audio_aps_monitor_get_stat(&stat));
+		res->est_ppm = stat.drift_ppm;
+		res->target = stat.target_len;
+	}
+#endif
+}
+
+int main(int argc, char *argv[])
+{
+	static const int drifts[] = { -1500, -500, 0, 500, 1500, };
+	int seconds = (argc > 1) ? atoi(argv[1]) : 600;
+	int i;
+
+	seconds = MAX(seconds, SETTLE_MS / 1000 + 10);
+	sim_clock_set(0);
+
+	printf("%-10s %8s %8s %8s %8s %6s %8s", "drift ppm", "mean ms", "sd ms", "min ms",
+			"max ms", "under", "lvl/min");
+#ifdef CONFIG_AUDIO_APS_PI_CONTROLLER
+	printf(" %8s", "est ppm");
+#endif
+	printf("\n");
+
+	for (i = 0; i < ARRAY_SIZE(drifts); i++) {
+		sim_result_t res;
+
+		sim_run(drifts[i], seconds, &res);
+
+		printf("%-10d %8.1f %8.1f %8.1f %8.1f %6d %8d", res.drift_ppm, res.mean, res.sd,
+				res.min, res.max, res.underruns, res.changes);
+#ifdef CONFIG_AUDIO_APS_PI_CONTROLLER
+		printf(" %8d", res.est_ppm);
+#endif
+		printf("\n");
+
+		TEST_CHECK_MSG(res.underruns == 0, "drift %d: %d underruns", res.drift_ppm, res.underruns);
+#ifdef CONFIG_AUDIO_APS_PI_CONTROLLER
+		TEST_CHECK_MSG(fabs(res.mean - res.target) < 10, "drift %d: mean %.1f, target %d",
+				res.drift_ppm, res.mean, res.target);
+		TEST_CHECK_MSG(abs(res.est_ppm - res.drift_ppm) < 150, "drift %d: estimate %d",
+				res.drift_ppm, res.est_ppm);
+#endif
+	}
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,362 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Session buffers of dsp_buffer.c between the cpu and a dsp stand-in.
+ *
+ * The stand-in works on the shared ring of the session buffers as the dsp
+ * does: each step it moves what the input buffer holds, up to a random
+ * block, to the output buffer, adding one to every byte. The cpu side
+ * feeds and drains it through the stream, plain buffer and vectored
+ * transfers with sizes that wrap the rings, and checks the byte sequence
+ * end to end, the transfer statistics and that streams see the ring in
+ * place. The session buffer pool must grow past one chunk and reuse
+ * freed buffers without new allocations.
+ */
+
+#include <stdlib.h>
+#include <os_common_api.h>
+#include <dsp_hal.h>
+#include <test_common.h>
+#include "dsp_inner.h"
+
+TEST_MAIN_DEFINE();
+
+#define IN_SIZE			1000
+#define OUT_SIZE		700
+#define DSP_BLOCK		300
+#define NUM_BUFS		50
+
+static struct dsp_session session;
+static int num_malloc;
+static int num_kick;
+
+void *mem_malloc_debug(size_t size, const char *func)
+{
+	num_malloc++;
+	return calloc(1, size);
+}
+
+void mem_free(void *ptr)
+{
+	free(ptr);
+}
+
+int dsp_session_kick(struct dsp_session *session)
+{
+	num_kick++;
+	return 0;
+}
+
+int system_check_low_latencey_mode(void)
+{
+	return 0;
+}
+
+/* dsp stand-in, straight on the shared rings */
+static int dsp_step(struct dsp_session_buf *in, struct dsp_session_buf *out, uint32_t *seed)
+{
+	uint8_t block[DSP_BLOCK];
+	int i, len;
+
+	len = 1 + test_rand(seed) % DSP_BLOCK;
+	len = MIN(len, acts_ringbuf_length(&in->buf));
+	len = MIN(len, acts_ringbuf_space(&out->buf));
+	if (len <= 0)
+		return 0;
+
+	acts_ringbuf_get(&in->buf, block, len);
+	for (i = 0; i < len; i++)
+		block[i]++;
+	acts_ringbuf_put(&out->buf, block, len);
+	return len;
+}
+
+/* sequence source and sink standing for io streams */
+typedef struct {
+	uint8_t next;
+	int bytes;
+	int limit;              // short transfer after this many bytes, -1 none
+	int calls;
+	int in_ring;            // calls given a pointer into the ring
+	int bad;
+	const uint8_t *ring;
+	int ring_size;
+} seq_stream_t;
+
+static void seq_note(seq_stream_t *st, const void *buf, unsigned int size)
+{
+	const uint8_t *p = buf;
+
+	st->calls++;
+	if (p >= st->ring && p + size <= st->ring + st->ring_size)
+		st->in_ring++;
+}
+
+static int seq_stream_read(void *stream, void *buf, unsigned int size)
+{
+	seq_stream_t *st = stream;
+	uint8_t *p = buf;
+	int i, n = size;
+
+	seq_note(st, buf, size);
+	if (st->limit >= 0)
+		n = MIN(n, st->limit - st->bytes);
+
+	for (i = 0; i < n; i++)
+		p[i] = st->next++;
+
+	st->bytes += n;
+	return n;
+}
+
+static int seq_stream_write(void *stream, const void *buf, unsigned int size)
+{
+	seq_stream_t *st = stream;
+	const uint8_t *p = buf;
+	int i, n = size;
+
+	seq_note(st, buf, size);
+	if (st->limit >= 0)
+		n = MIN(n, st->limit - st->bytes);
+
+	for (i = 0; i < n; i++) {
+		if (p[i] != st->next++)
+			st->bad++;
+	}
+
+	st->bytes += n;
+	return n;
+}
+
+static void seq_stream_init(seq_stream_t *st, struct dsp_session_buf *buf, uint8_t first)
+{
+	memset(st, 0, sizeof(*st));
+	st->next = first;
+	st->limit = -1;
+	st->ring = (const uint8_t *)buf->buf.cpu_ptr;
+	st->ring_size = dsp_session_buf_size(buf);
+}
+
+/* cpu feeds the stand-in and drains it through streams, across many wraps */
+static void test_stream_loop(void)
+{
+	struct dsp_session_buf *in = dsp_session_buf_alloc(&session, IN_SIZE);
+	struct dsp_session_buf *out = dsp_session_buf_alloc(&session, OUT_SIZE);
+	struct dsp_session_buf_stat in_stat, out_stat;
+	seq_stream_t src, sink;
+	uint32_t seed = 3;
+	int i, n, len, written = 0, read = 0, writes = 0, reads = 0;
+
+	TEST_CHECK(in && out);
+	if (!in || !out)
+		return;
+
+	seq_stream_init(&src, in, 0);
+	seq_stream_init(&sink, out, 1);
+
+	for (i = 0; i < 20000; i++) {
+		n = 1 + test_rand(&seed) % 400;
+		len = dsp_session_buf_write_from_stream(in, &src, n, seq_stream_read);
+		TEST_CHECK(len == 0 || len == n);
+		TEST_CHECK(len > 0 || n > dsp_session_buf_space(in));
+		written += len;
+		writes += (len > 0);
+
+		dsp_step(in, out, &seed);
+
+		n = 1 + test_rand(&seed) % 400;
+		len = dsp_session_buf_read_to_stream(out, &sink, n, seq_stream_write);
+		TEST_CHECK(len == 0 || len == n);
+		read += len;
+		reads += (len > 0);
+	}
+
+	TEST_CHECK_MSG(sink.bad == 0, "%d bytes changed", sink.bad);
+	TEST_CHECK(sink.bytes == read && src.bytes == written);
+	TEST_CHECK(written - read == dsp_session_buf_length(in) + dsp_session_buf_length(out));
+	TEST_CHECK_MSG(src.in_ring == src.calls && sink.in_ring == sink.calls,
+			"in place %d/%d, %d/%d", src.in_ring, src.calls, sink.in_ring, sink.calls);
+	/* a wrapped ring takes two stream calls */
+	TEST_CHECK_MSG(src.calls > writes && sink.calls > reads,
+			"wraps not crossed, %d/%d calls", src.calls, sink.calls);
+
+	TEST_CHECK(!dsp_session_buf_get_stat(in, &in_stat, true));
+	TEST_CHECK(!dsp_session_buf_get_stat(out, &out_stat, false));
+	TEST_CHECK(in_stat.write_bytes == written && in_stat.read_bytes == 0);
+	TEST_CHECK(out_stat.read_bytes == read && out_stat.dma_bytes == 0);
+	TEST_CHECK(!dsp_session_buf_get_stat(in, &in_stat, false));
+	TEST_CHECK(in_stat.write_bytes == 0 && in_stat.write_cnt == 0);
+
+	printf("stream loop: %d bytes in, %d out, %d/%d stream calls\n",
+			written, read, src.calls, sink.calls);
+
+	dsp_session_buf_free(in);
+	dsp_session_buf_free(out);
+}
+
+/* short stream transfers move and account only what the stream took */
+static void test_stream_short(void)
+{
+	struct dsp_session_buf *buf = dsp_session_buf_alloc(&session, 64);
+	seq_stream_t src, sink;
+	int len;
+
+	seq_stream_init(&src, buf, 0);
+	seq_stream_init(&sink, buf, 0);
+
+	/* wrap the ring: offsets at 48 */
+	TEST_CHECK(dsp_session_buf_write_from_stream(buf, &src, 48, seq_stream_read) == 48);
+	TEST_CHECK(dsp_session_buf_read_to_stream(buf, &sink, 48, seq_stream_write) == 48);
+
+	/* space of 16 + 48, stream ends within the first span */
+	src.limit = src.bytes + 10;
+	len = dsp_session_buf_write_from_stream(buf, &src, 40, seq_stream_read);
+	TEST_CHECK(len == 10 && src.calls == 2 && dsp_session_buf_length(buf) == 10);
+
+	/* and within the second */
+	src.limit = src.bytes + 30;
+	len = dsp_session_buf_write_from_stream(buf, &src, 40, seq_stream_read);
+	TEST_CHECK(len == 30 && src.calls == 4 && dsp_session_buf_length(buf) == 40);
+
+	sink.limit = sink.bytes + 15;
+	len = dsp_session_buf_read_to_stream(buf, &sink, 40, seq_stream_write);
+	TEST_CHECK(len == 15 && dsp_session_buf_length(buf) == 25);
+
+	sink.limit = -1;
+	len = dsp_session_buf_read_to_stream(buf, &sink, 25, seq_stream_write);
+	TEST_CHECK(len == 25 && dsp_session_buf_length(buf) == 0 && sink.bad == 0);
+
+	/* all or nothing against the ring */
+	TEST_CHECK(dsp_session_buf_read_to_stream(buf, &sink, 1, seq_stream_write) == 0);
+	TEST_CHECK(dsp_session_buf_write_from_stream(buf, &src, 65, seq_stream_read) == 0);
+
+	dsp_session_buf_free(buf);
+}
+
+/* vectored and plain buffer transfers through the stand-in */
+static void test_vec_loop(void)
+{
+	struct dsp_session_buf *in = dsp_session_buf_alloc(&session, IN_SIZE);
+	struct dsp_session_buf *out = dsp_session_buf_alloc(&session, OUT_SIZE);
+	static uint8_t tx[2 * 400], rx[2 * 400];
+	struct dsp_session_buf_vec vec[2];
+	uint8_t tx_next = 0, rx_next = 1;
+	uint32_t seed = 5;
+	int i, j, n, cnt, len, space, bad = 0, moved = 0;
+
+	for (i = 0; i < 20000; i++) {
+		/* every fourth write and read through the plain buffer calls */
+		cnt = (i % 4 == 3) ? 1 : 1 + (i & 1);
+		n = 0;
+		for (j = 0; j < cnt; j++) {
+			vec[j].data = tx + j * 400;
+			vec[j].size = test_rand(&seed) % 400;
+			n += vec[j].size;
+		}
+
+		space = dsp_session_buf_space(in);
+		if (n <= space) {
+			for (j = 0; j < cnt; j++)
+				for (len = 0; len < vec[j].size; len++)
+					((uint8_t *)vec[j].data)[len] = tx_next++;
+		}
+
+		if (i % 4 == 3)
+			len = dsp_session_buf_write_from_buffer(in, vec[0].data, vec[0].size);
+		else
+			len = dsp_session_buf_write_vec(in, vec, cnt, 0);
+		TEST_CHECK(len == ((n <= space) ? n : 0));
+
+		dsp_step(in, out, &seed);
+
+		cnt = (i % 4 == 1) ? 1 : 1 + (i & 1);
+		n = 0;
+		for (j = 0; j < cnt; j++) {
+			vec[j].data = rx + j * 400;
+			vec[j].size = test_rand(&seed) % 400;
+			n += vec[j].size;
+		}
+
+		if (i % 4 == 1)
+			len = dsp_session_buf_read_to_buffer(out, vec[0].data, vec[0].size);
+		else
+			len = dsp_session_buf_read_vec(out, vec, cnt, 0);
+		TEST_CHECK(len == 0 || len == n);
+		if (len <= 0)
+			continue;
+
+		for (j = 0; j < cnt; j++) {
+			for (len = 0; len < vec[j].size; len++) {
+				if (((uint8_t *)vec[j].data)[len] != rx_next++)
+					bad++;
+			}
+		}
+		moved += n;
+	}
+
+	TEST_CHECK_MSG(bad == 0 && moved > 0, "%d of %d bytes changed", bad, moved);
+	TEST_CHECK(dsp_session_buf_read_vec(out, vec, 3, 0) == -EINVAL);
+
+	dsp_session_buf_free(in);
+	dsp_session_buf_free(out);
+}
+
+/* more buffers than one chunk, freed ones reused without allocating */
+static void test_pool(void)
+{
+	static uint8_t data[NUM_BUFS][16];
+	struct dsp_session_buf *bufs[NUM_BUFS];
+	struct dsp_session_buf_stat stat;
+	int i, j, dup = 0, mallocs;
+
+	for (i = 0; i < NUM_BUFS; i++) {
+		bufs[i] = dsp_session_buf_init(&session, data[i], sizeof(data[i]));
+		TEST_CHECK(bufs[i] != NULL);
+		if (!bufs[i])
+			return;
+		for (j = 0; j < i; j++)
+			dup += (bufs[i] == bufs[j]);
+	}
+	TEST_CHECK(dup == 0);
+
+	/* buffers of grown chunks keep their own statistics */
+	TEST_CHECK(dsp_session_buf_write(bufs[NUM_BUFS - 1], "abcd", 4) == 4);
+	TEST_CHECK(dsp_session_buf_write(bufs[0], "ab", 2) == 2);
+	TEST_CHECK(!dsp_session_buf_get_stat(bufs[NUM_BUFS - 1], &stat, false));
+	TEST_CHECK(stat.write_bytes == 4 && stat.write_cnt == 1);
+	TEST_CHECK(!dsp_session_buf_get_stat(bufs[0], &stat, false));
+	TEST_CHECK(stat.write_bytes == 2 && stat.write_cnt == 1);
+	TEST_CHECK(dsp_session_buf_get_stat((struct dsp_session_buf *)data, &stat, false) == -EINVAL);
+
+	for (i = 0; i < NUM_BUFS; i += 2)
+		dsp_session_buf_destroy(bufs[i]);
+
+	mallocs = num_malloc;
+	for (i = 0; i < NUM_BUFS; i += 2) {
+		bufs[i] = dsp_session_buf_init(&session, data[i], sizeof(data[i]));
+		TEST_CHECK(bufs[i] != NULL && dsp_session_buf_length(bufs[i]) == 0);
+	}
+	TEST_CHECK_MSG(num_malloc == mallocs, "%d allocations on reuse", num_malloc - mallocs);
+
+	TEST_CHECK(!dsp_session_buf_get_stat(bufs[0], &stat, false));
+	TEST_CHECK(stat.write_bytes == 0);
+
+	for (i = 0; i < NUM_BUFS; i++)
+		dsp_session_buf_destroy(bufs[i]);
+}
+
+int main(void)
+{
+	TEST_RUN(test_stream_loop);
+	TEST_RUN(test_stream_short);
+	TEST_RUN(test_vec_loop);
+	TEST_RUN(test_pool);
+
+	TEST_CHECK(num_kick > 0);
+
+	return TEST_RESULT();
+}
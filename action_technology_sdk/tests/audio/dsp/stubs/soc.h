@@ -0,0 +1,14 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* the soc headers bring the SYS_LOG macros on the target */
+
+#ifndef TESTS_AUDIO_DSP_STUBS_SOC_H_
+#define TESTS_AUDIO_DSP_STUBS_SOC_H_
+
+#include <os_common_api.h>
+
+#endif /* TESTS_AUDIO_DSP_STUBS_SOC_H_ */
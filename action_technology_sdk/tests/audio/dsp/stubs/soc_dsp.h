@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* no dsp address translation on the host, rings are used by cpu address */
+
+#ifndef TESTS_AUDIO_DSP_STUBS_SOC_DSP_H_
+#define TESTS_AUDIO_DSP_STUBS_SOC_DSP_H_
+
+#endif /* TESTS_AUDIO_DSP_STUBS_SOC_DSP_H_ */
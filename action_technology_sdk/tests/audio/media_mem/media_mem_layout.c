@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Media memory layouts planned by media_mem.c, printed for every stream
+ * type of the configuration the tool is built with: each buffer with its
+ * region, offset and size, the usage of each region and which stream
+ * types can run at the same time.
+ *
+ * Built with the full decoder and parser options the plan must place
+ * every buffer where the hand written table of the previous release put
+ * it, LE audio playback excepted, which now ends at the top of the input
+ * region; the layout check must pass and an overlay must share memory
+ * only with the buffer it is declared over.
+ *
+ * usage: media_mem_layout
+ */
+
+#include <stdlib.h>
+#include <linker/section_tags.h>
+#include <os_common_api.h>
+#include <audio_system.h>
+#include <media_mem.h>
+#include <test_common.h>
+
+TEST_MAIN_DEFINE();
+
+#define MAX_CELLS		24
+
+static const char *const type_names[] = {
+	[INPUT_PLAYBACK] = "INPUT_PLAYBACK",
+	[INPUT_CAPTURE] = "INPUT_CAPTURE",
+	[OUTPUT_PLAYBACK] = "OUTPUT_PLAYBACK",
+	[OUTPUT_CAPTURE] = "OUTPUT_CAPTURE",
+	[OUTPUT_DECODER] = "OUTPUT_DECODER",
+	[INPUT_ENCBUF] = "INPUT_ENCBUF",
+	[AEC_REFBUF0] = "AEC_REFBUF0",
+	[INPUT_PCM] = "INPUT_PCM",
+	[OUTPUT_PCM] = "OUTPUT_PCM",
+	[OUTPUT_SCO] = "OUTPUT_SCO",
+	[TX_SCO] = "TX_SCO",
+	[RX_SCO] = "RX_SCO",
+	[DECODER_GLOBAL_DATA] = "DECODER_GLOBAL_DATA",
+	[CODEC_STACK] = "CODEC_STACK",
+	[TOOL_ASQT_DUMP_BUF] = "TOOL_ASQT_DUMP_BUF",
+	[TOOL_ECTT_BUF] = "TOOL_ECTT_BUF",
+	[PARSER_STACK] = "PARSER_STACK",
+	[PARSER_CHUCK] = "PARSER_CHUCK",
+	[OUTPUT_PARSER] = "OUTPUT_PARSER",
+	[BT_TRANSMIT_INPUT] = "BT_TRANSMIT_INPUT",
+	[BT_TRANSMIT_OUTPUT] = "BT_TRANSMIT_OUTPUT",
+	[OUTPUT_PKG_HDR] = "OUTPUT_PKG_HDR",
+	[DAE_PARAM] = "DAE_PARAM",
+	[VAD_STATE] = "VAD_STATE",
+	[PARSER_EVT_BUFFER] = "PARSER_EVT_BUFFER",
+	[MIX_INPUT_BUF] = "MIX_INPUT_BUF",
+	[MIX_RES_BUF] = "MIX_RES_BUF",
+};
+
+static const struct {
+	int stream_type;
+	const char *name;
+} streams[] = {
+	{ AUDIO_STREAM_MUSIC, "music" },
+	{ AUDIO_STREAM_LOCAL_MUSIC, "local_music" },
+	{ AUDIO_STREAM_TTS, "tts" },
+	{ AUDIO_STREAM_VOICE, "voice" },
+	{ AUDIO_STREAM_AI, "ai" },
+	{ AUDIO_STREAM_LE_AUDIO, "le_audio" },
+};
+
+#ifdef LAYOUT_CHECK_LEGACY
+/* offsets of the previous hand written table in playback_input */
+static const struct {
+	int stream_type;
+	int mem_type;
+	uint32_t offset;
+	uint32_t size;
+} legacy[] = {
+	{ AUDIO_STREAM_MUSIC, OUTPUT_PKG_HDR, 0x0, 0x100 },
+	{ AUDIO_STREAM_MUSIC, INPUT_PLAYBACK, 0x100, 0x2B00 },
+	{ AUDIO_STREAM_MUSIC, MIX_INPUT_BUF, 0x2C00, 0x400 },
+	{ AUDIO_STREAM_MUSIC, MIX_RES_BUF, 0x3000, 0x400 },
+	{ AUDIO_STREAM_LOCAL_MUSIC, INPUT_PLAYBACK, 0x0, 0x800 },
+	{ AUDIO_STREAM_LOCAL_MUSIC, OUTPUT_PARSER, 0x0, 0x1800 },
+	{ AUDIO_STREAM_LOCAL_MUSIC, PARSER_EVT_BUFFER, 0x1800, 0x20 },
+	{ AUDIO_STREAM_LOCAL_MUSIC, BT_TRANSMIT_INPUT, 0x1820, 0xC00 },
+	{ AUDIO_STREAM_LOCAL_MUSIC, BT_TRANSMIT_OUTPUT, 0x2420, 0x800 },
+	{ AUDIO_STREAM_LOCAL_MUSIC, MIX_INPUT_BUF, 0x2C20, 0x400 },
+	{ AUDIO_STREAM_LOCAL_MUSIC, MIX_RES_BUF, 0x3020, 0x400 },
+	{ AUDIO_STREAM_VOICE, INPUT_PLAYBACK, 0x0, 0x2A8 },
+	{ AUDIO_STREAM_VOICE, OUTPUT_DECODER, 0x2A8, 0x400 },
+	{ AUDIO_STREAM_VOICE, OUTPUT_PLAYBACK, 0x6A8, 0x400 },
+	{ AUDIO_STREAM_VOICE, INPUT_PCM, 0xAA8, 0x0 },
+	{ AUDIO_STREAM_VOICE, INPUT_CAPTURE, 0xAA8, 0x800 },
+	{ AUDIO_STREAM_VOICE, INPUT_ENCBUF, 0x12A8, 0x400 },
+	{ AUDIO_STREAM_VOICE, OUTPUT_CAPTURE, 0x16A8, 0x15C },
+	{ AUDIO_STREAM_VOICE, OUTPUT_SCO, 0x1804, 0xE8 },
+	{ AUDIO_STREAM_VOICE, TX_SCO, 0x18EC, 0x7C },
+	{ AUDIO_STREAM_VOICE, RX_SCO, 0x1968, 0xF0 },
+	{ AUDIO_STREAM_VOICE, AEC_REFBUF0, 0x1A58, 0x200 },
+	{ AUDIO_STREAM_VOICE, TOOL_ASQT_DUMP_BUF, 0x1C58, 0xC00 },
+	{ AUDIO_STREAM_VOICE, OUTPUT_PKG_HDR, 0x2858, 0x100 },
+	{ AUDIO_STREAM_AI, INPUT_PCM, 0x0, 0x800 },
+	{ AUDIO_STREAM_AI, INPUT_CAPTURE, 0x800, 0x800 },
+	{ AUDIO_STREAM_AI, INPUT_ENCBUF, 0x1000, 0x1200 },
+	{ AUDIO_STREAM_AI, OUTPUT_CAPTURE, 0x2200, 0x1000 },
+	{ AUDIO_STREAM_AI, VAD_STATE, 0x3200, 0x10 },
+	{ AUDIO_STREAM_LE_AUDIO, INPUT_PCM, 0x0, 0x800 },
+	{ AUDIO_STREAM_LE_AUDIO, INPUT_CAPTURE, 0x800, 0x400 },
+	{ AUDIO_STREAM_LE_AUDIO, INPUT_ENCBUF, 0xC00, 640 },
+	{ AUDIO_STREAM_LE_AUDIO, OUTPUT_CAPTURE, 0xE80, 960 },
+	{ AUDIO_STREAM_LE_AUDIO, VAD_STATE, 0x1240, 0x10 },
+	{ AUDIO_STREAM_LE_AUDIO, AEC_REFBUF0, 0x1250, 0x400 },
+	/* playback at the top of the region, 0x20 higher than before */
+	{ AUDIO_STREAM_LE_AUDIO, OUTPUT_PKG_HDR, 0x1D20, 0x100 },
+	{ AUDIO_STREAM_LE_AUDIO, INPUT_PLAYBACK, 0x1E20, 0xE00 },
+	{ AUDIO_STREAM_LE_AUDIO, MIX_INPUT_BUF, 0x2C20, 0x400 },
+	{ AUDIO_STREAM_LE_AUDIO, MIX_RES_BUF, 0x3020, 0x400 },
+};
+#endif
+
+void *mem_malloc_debug(size_t size, const char *func)
+{
+	return calloc(1, size);
+}
+
+void mem_free(void *ptr)
+{
+	free(ptr);
+}
+
+void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout)
+{
+	return malloc(bytes);
+}
+
+void k_heap_free(struct k_heap *h, void *mem)
+{
+	free(mem);
+}
+
+int system_check_low_latencey_mode(void)
+{
+	return 0;
+}
+
+static const char *type_name(int mem_type)
+{
+	static char buf[16];
+
+	if (mem_type >= 0 && mem_type < ARRAY_SIZE(type_names) && type_names[mem_type])
+		return type_names[mem_type];
+
+	snprintf(buf, sizeof(buf), "type %d", mem_type);
+	return buf;
+}
+
+static const struct media_mem_layout_cell *find_cell(const struct media_mem_layout_cell *cells,
+		int num, int mem_type)
+{
+	for (int i = 0; i < num; i++) {
+		if (cells[i].mem_type == mem_type)
+			return &cells[i];
+	}
+
+	return NULL;
+}
+
+/* bytes of a region covered by the cells, overlays counted once */
+static uint32_t region_used(const struct media_mem_layout_cell *cells, int num, const char *region)
+{
+	uint8_t map[0x4000];
+	uint32_t used = 0, size = 0;
+
+	memset(map, 0, sizeof(map));
+	for (int i = 0; i < num; i++) {
+		if (strcmp(cells[i].region, region))
+			continue;
+		size = MIN(cells[i].region_size, sizeof(map));
+		for (uint32_t j = cells[i].offset; j < cells[i].offset + cells[i].size && j < size; j++)
+			map[j] = 1;
+	}
+
+	for (uint32_t j = 0; j < size; j++)
+		used += map[j];
+
+	return used;
+}
+
+static void print_layout(int s, const struct media_mem_layout_cell *cells, int num)
+{
+	const char *done[MAX_CELLS];
+	int num_done = 0;
+
+	printf("%s (stream %d)\n", streams[s].name, streams[s].stream_type);
+	for (int i = 0; i < num; i++) {
+		printf("  %-20s %-16s 0x%04x +0x%04x", type_name(cells[i].mem_type),
+				cells[i].region, cells[i].offset, cells[i].size);
+		if (cells[i].overlay_type >= 0)
+			printf("  over %s", type_name(cells[i].overlay_type));
+		printf("\n");
+	}
+
+	for (int i = 0; i < num; i++) {
+		int seen = 0;
+
+		for (int j = 0; j < num_done; j++)
+			seen |= !strcmp(done[j], cells[i].region);
+		if (seen)
+			continue;
+
+		done[num_done++] = cells[i].region;
+		uint32_t used = region_used(cells, num, cells[i].region);
+
+		printf("  %-16s used 0x%04x/0x%04x (%u%%)\n", cells[i].region, used,
+				cells[i].region_size, used * 100 / cells[i].region_size);
+	}
+}
+
+static void test_layouts(void)
+{
+	struct media_mem_layout_cell cells[MAX_CELLS];
+	int s, i, j, num;
+
+	TEST_CHECK(media_mem_check_layout() == 0);
+
+	for (s = 0; s < ARRAY_SIZE(streams); s++) {
+		num = media_mem_get_layout(streams[s].stream_type, cells, MAX_CELLS);
+		TEST_CHECK_MSG(num > 0, "%s has no layout", streams[s].name);
+		print_layout(s, cells, num);
+
+		for (i = 0; i < num; i++) {
+			void *addr = media_mem_get_cache_pool(cells[i].mem_type, streams[s].stream_type);
+
+			TEST_CHECK(addr != NULL);
+			TEST_CHECK(media_mem_get_cache_pool_size(cells[i].mem_type,
+					streams[s].stream_type) == cells[i].size);
+			TEST_CHECK(cells[i].offset + cells[i].size <= cells[i].region_size);
+			TEST_CHECK((cells[i].offset & 3) == 0);
+
+			/* an overlay lies inside the one buffer it is declared over */
+			for (j = 0; j < num; j++) {
+				bool overlap = j != i && !strcmp(cells[i].region, cells[j].region) &&
+						cells[i].offset < cells[j].offset + cells[j].size &&
+						cells[j].offset < cells[i].offset + cells[i].size;
+				bool paired = cells[i].overlay_type == cells[j].mem_type ||
+						cells[j].overlay_type == cells[i].mem_type;
+
+				TEST_CHECK_MSG(!overlap || paired, "%s: %s overlaps %s", streams[s].name,
+						type_name(cells[i].mem_type), type_name(cells[j].mem_type));
+			}
+		}
+	}
+
+	TEST_CHECK(media_mem_get_layout(AUDIO_STREAM_DEFAULT, cells, MAX_CELLS) == 0);
+	TEST_CHECK(media_mem_get_cache_pool(INPUT_PLAYBACK, AUDIO_STREAM_DEFAULT) == NULL);
+	TEST_CHECK(media_mem_get_cache_pool(TOOL_ECTT_BUF, AUDIO_STREAM_MUSIC) == NULL);
+}
+
+#ifdef LAYOUT_CHECK_LEGACY
+static void test_legacy(void)
+{
+	struct media_mem_layout_cell cells[MAX_CELLS];
+	const struct media_mem_layout_cell *cell;
+	int i, num, bad = 0;
+
+	for (i = 0; i < ARRAY_SIZE(legacy); i++) {
+		num = media_mem_get_layout(legacy[i].stream_type, cells, MAX_CELLS);
+		cell = find_cell(cells, num, legacy[i].mem_type);
+		if (!cell || strcmp(cell->region, "playback_input") ||
+			cell->offset != legacy[i].offset || cell->size != legacy[i].size) {
+			printf("stream %d %s: 0x%x+0x%x, was 0x%x+0x%x\n", legacy[i].stream_type,
+					type_name(legacy[i].mem_type), cell ? cell->offset : 0,
+					cell ? cell->size : 0, legacy[i].offset, legacy[i].size);
+			bad++;
+		}
+	}
+
+	TEST_CHECK_MSG(bad == 0, "%d buffers moved", bad);
+}
+#endif
+
+static void test_concurrent(void)
+{
+	int i, j;
+
+	printf("%-12s", "concurrent");
+	for (j = 0; j < ARRAY_SIZE(streams); j++)
+		printf(" %-11s", streams[j].name);
+	printf("\n");
+
+	for (i = 0; i < ARRAY_SIZE(streams); i++) {
+		printf("%-12s", streams[i].name);
+		for (j = 0; j < ARRAY_SIZE(streams); j++) {
+			bool ok = media_mem_check_concurrent(streams[i].stream_type, streams[j].stream_type);
+
+			printf(" %-11s", ok ? "yes" : "-");
+			TEST_CHECK(ok == media_mem_check_concurrent(streams[j].stream_type,
+					streams[i].stream_type));
+			if (i == j)
+				TEST_CHECK(!ok);
+		}
+		printf("\n");
+	}
+
+	/* music and prompt both need the output pcm buffer */
+	TEST_CHECK(!media_mem_check_concurrent(AUDIO_STREAM_MUSIC, AUDIO_STREAM_TTS));
+	TEST_CHECK(media_mem_check_concurrent(AUDIO_STREAM_MUSIC, AUDIO_STREAM_DEFAULT));
+}
+
+int main(void)
+{
+	TEST_RUN(test_layouts);
+#ifdef LAYOUT_CHECK_LEGACY
+	TEST_RUN(test_legacy);
+#endif
+	TEST_RUN(test_concurrent);
+
+	return TEST_RESULT();
+}
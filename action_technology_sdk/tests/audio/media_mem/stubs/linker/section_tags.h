@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * No linker sections on the host: an iterable section object is a plain
+ * one, and the media heap defined in one takes its blocks from the test.
+ */
+
+#ifndef TESTS_AUDIO_MEDIA_MEM_STUBS_LINKER_SECTION_TAGS_H_
+#define TESTS_AUDIO_MEDIA_MEM_STUBS_LINKER_SECTION_TAGS_H_
+
+#include <kernel.h>
+
+#define STRUCT_SECTION_ITERABLE(struct_type, name) struct struct_type name
+
+struct k_heap {
+	struct {
+		void *init_mem;
+		size_t init_bytes;
+	} heap;
+};
+
+void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout);
+void k_heap_free(struct k_heap *h, void *mem);
+
+#endif /* TESTS_AUDIO_MEDIA_MEM_STUBS_LINKER_SECTION_TAGS_H_ */
@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* media memory needs nothing of the media service on the host */
+
+#ifndef TESTS_AUDIO_MEDIA_MEM_STUBS_MEDIA_SERVICE_H_
+#define TESTS_AUDIO_MEDIA_MEM_STUBS_MEDIA_SERVICE_H_
+
+#endif /* TESTS_AUDIO_MEDIA_MEM_STUBS_MEDIA_SERVICE_H_ */
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Quality and throughput of the resampler of audio_resample.c.
+ *
+ * For each pair of 8K, 16K, 44.1K and 48K, one second of a stereo tone
+ * (997Hz left, 1296Hz right) goes through the resampler by blocks of 160
+ * samples. THD+N is the residual of a least squares sine fit at the tone
+ * frequency against the fitted sine, after the first 20ms. The time is per
+ * output sample and channel.
+ *
+ * The output must not depend on how the input is cut, so the same tone is
+ * run again by blocks of 1, 7, 33 and 441 samples, and interleaved, and all
+ * must give the very same samples.
+ *
+ * usage: resample_bench [seconds]
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <os_common_api.h>
+#include <audio_resample.h>
+#include <test_common.h>
+
+TEST_MAIN_DEFINE();
+
+#define MAX_RATE		48000
+#define MAX_SECONDS		4
+#define MAX_IN			(MAX_RATE * MAX_SECONDS)
+/* 8K to 48K, with the margin of audio_resample_get_max_out() */
+#define MAX_OUT			(MAX_IN * 6 + 64)
+#define BLOCK			160
+#define TONE_HZ			997.0
+#define TONE_R_RATIO	1.3
+#define SKIP_MS			20
+/* 16 bits quantization alone is near -98dB */
+#define THDN_LIMIT_DB	(-70.0)
+
+static int16_t in_l[MAX_IN], in_r[MAX_IN], in_il[MAX_IN * 2];
+static int16_t out_l[MAX_OUT], out_r[MAX_OUT];
+static int16_t cmp_l[MAX_OUT], cmp_r[MAX_OUT], cmp_il[MAX_OUT * 2];
+
+void *mem_malloc_debug(size_t size, const char *func)
+{
+	return calloc(1, size);
+}
+
+void mem_free(void *ptr)
+{
+	free(ptr);
+}
+
+/* residual of the a * sin + b * cos + c fit at freq, against the sine, in dB */
+static double thd_n(const int16_t *y, int num, double freq, double rate)
+{
+	double m[3][4] = { { 0 } }, x[3], err = 0, sig = 0;
+	int skip = rate * SKIP_MS / 1000;
+	int i, r, c, k;
+
+	for (i = skip; i < num; i++) {
+		double w = 2 * M_PI * freq * i / rate;
+		double v[3] = { sin(w), cos(w), 1, };
+
+		for (r = 0; r < 3; r++) {
+			for (c = 0; c < 3; c++)
+				m[r][c] += v[r] * v[c];
+			m[r][3] += v[r] * y[i];
+		}
+	}
+
+	for (k = 0; k < 3; k++) {
+		for (r = k + 1; r < 3; r++) {
+			double q = m[r][k] / m[k][k];
+
+			for (c = k; c < 4; c++)
+				m[r][c] -= q * m[k][c];
+		}
+	}
+
+	for (k = 2; k >= 0; k--) {
+		x[k] = m[k][3];
+		for (c = k + 1; c < 3; c++)
+			x[k] -= m[k][c] * x[c];
+		x[k] /= m[k][k];
+	}
+
+	for (i = skip; i < num; i++) {
+		double w = 2 * M_PI * freq * i / rate;
+		double tone = x[0] * sin(w) + x[1] * cos(w);
+
+		err += (y[i] - tone - x[2]) * (y[i] - tone - x[2]);
+		sig += tone * tone;
+	}
+
+	return 10 * log10(err / sig);
+}
+
+static int resample_planar(int in_rate, int out_rate, int num, int block,
+		int16_t *l, int16_t *r)
+{
+	void *handle = audio_resample_open(2, 0, in_rate, out_rate);
+	int done, count = 0;
+
+	TEST_CHECK(handle != NULL);
+	if (!handle)
+		return 0;
+
+	for (done = 0; done < num; done += block) {
+		int samples = MIN(block, num - done);
+		int16_t *in_buf[2] = { &in_l[done], &in_r[done], };
+		int16_t *out_buf[2] = { &l[count], &r[count], };
+
+		count += audio_resample_process(handle, out_buf, in_buf, samples,
+				audio_resample_get_max_out(handle, samples));
+	}
+
+	audio_resample_close(handle);
+	return count;
+}
+
+static int resample_interleaved(int in_rate, int out_rate, int num, int block)
+{
+	void *handle = audio_resample_open(2, 1, in_rate, out_rate);
+	int done, count = 0;
+
+	TEST_CHECK(handle != NULL);
+	if (!handle)
+		return 0;
+
+	for (done = 0; done < num; done += block) {
+		int samples = MIN(block, num - done);
+		int16_t *in_buf[2] = { &in_il[done * 2], NULL, };
+		int16_t *out_buf[2] = { &cmp_il[count * 2], NULL, };
+
+		count += audio_resample_process(handle, out_buf, in_buf, samples,
+				audio_resample_get_max_out(handle, samples));
+	}
+
+	audio_resample_close(handle);
+	return count;
+}
+
+static void run_rates(int in_rate, int out_rate, int seconds)
+{
+	static const int blocks[] = { 1, 7, 33, 441, };
+	int num = in_rate * seconds;
+	int expect = out_rate * seconds;
+	double thd_l, thd_r, ns;
+	uint64_t start;
+	int count, i;
+
+	for (i = 0; i < num; i++) {
+		in_l[i] = (int16_t)lrint(29000 * sin(2 * M_PI * TONE_HZ * i / in_rate));
+		in_r[i] = (int16_t)lrint(20000 * sin(2 * M_PI * TONE_HZ * TONE_R_RATIO * i / in_rate));
+		in_il[i * 2] = in_l[i];
+		in_il[i * 2 + 1] = in_r[i];
+	}
+
+	start = test_time_ns();
+	count = resample_planar(in_rate, out_rate, num, BLOCK, out_l, out_r);
+	ns = (double)(test_time_ns() - start) / count / 2;
+
+	thd_l = thd_n(out_l, count, TONE_HZ, out_rate);
+	thd_r = thd_n(out_r, count, TONE_HZ * TONE_R_RATIO, out_rate);
+
+	printf("%5d %5d %8d %8d %8.1f %8.1f %8.1f\n", in_rate, out_rate, count, expect,
+			thd_l, thd_r, ns);
+
+	/* only the filter delay is missing at the end */
+	TEST_CHECK_MSG(count <= expect && count > expect - out_rate / 1000,
+			"%d->%d: %d samples out", in_rate, out_rate, count);
+	TEST_CHECK_MSG(thd_l < THDN_LIMIT_DB && thd_r < THDN_LIMIT_DB,
+			"%d->%d: thd+n %.1f/%.1f dB", in_rate, out_rate, thd_l, thd_r);
+
+	for (i = 0; i < ARRAY_SIZE(blocks); i++) {
+		int num_cmp = resample_planar(in_rate, out_rate, num, blocks[i], cmp_l, cmp_r);
+
+		TEST_CHECK_MSG(num_cmp == count && !memcmp(cmp_l, out_l, count * 2) &&
+				!memcmp(cmp_r, out_r, count * 2),
+				"%d->%d: blocks of %d differ", in_rate, out_rate, blocks[i]);
+	}
+
+	TEST_CHECK_MSG(resample_interleaved(in_rate, out_rate, num, BLOCK) == count,
+			"%d->%d: interleaved count", in_rate, out_rate);
+	for (i = 0; i < count; i++) {
+		if (cmp_il[i * 2] != out_l[i] || cmp_il[i * 2 + 1] != out_r[i]) {
+			TEST_CHECK_MSG(0, "%d->%d: interleaved differs at %d", in_rate, out_rate, i);
+			break;
+		}
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	static const int rates[] = { 8000, 16000, 44100, 48000, };
+	int seconds = (argc > 1) ? atoi(argv[1]) : 1;
+	int i, j;
+
+	seconds = MAX(1, MIN(seconds, MAX_SECONDS));
+
+	printf("%5s %5s %8s %8s %8s %8s %8s\n", "in", "out", "samples", "expect",
+			"L dB", "R dB", "ns/smp");
+
+	for (i = 0; i < ARRAY_SIZE(rates); i++) {
+		for (j = 0; j < ARRAY_SIZE(rates); j++)
+			run_rates(rates[i], rates[j], seconds);
+	}
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,456 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Seek latency with the seek table of media_seek_table.c
+ * (CONFIG_MEDIA_SEEK_TABLE), on FatFs images in RAM: the music on "/SD:",
+ * the table cache on "/NOR:".
+ *
+ * Three tracks are made with known frame offsets: an MP3 with a Xing tag, an
+ * MP3 with a VBRI table and a FLAC with a SEEKTABLE every 10s. For each, the
+ * table is opened and 1000 seeks spread over the track look up a point within
+ * MEDIA_SEEK_TABLE_TOLERANCE. Every point found must be a frame start at its
+ * time, never an estimate: the Xing track has no point until playback adds
+ * its breakpoints, and finds them again from the cache at the next open.
+ *
+ * Sector reads of the music disk stand for the seek latency: the parser
+ * walking the frame headers from the stream start to the target, against
+ * reading the frame at the point found. The table open and the time of a
+ * find are printed as well.
+ *
+ * Then more tracks than CONFIG_MEDIA_SEEK_TABLE_CACHE_NUM replace the oldest
+ * table of the cache, and a track rewritten in place with the same size no
+ * longer matches its table. The cache never lands on the music disk.
+ *
+ * usage: seek_table_bench
+ */
+
+#include <os_common_api.h>
+#include <fs/fs.h>
+#include <sys/byteorder.h>
+#include <media_type.h>
+#include <media_seek_table.h>
+#include <test_common.h>
+#include "ram_disk.h"
+
+TEST_MAIN_DEFINE();
+
+#define SD_SECTORS		(64 * 1024)
+#define NOR_SECTORS		(2 * 1024)
+
+#define MP3_FRAMES		6000
+#define MP3_SAMPLES		1152
+#define MP3_ID3_SIZE	1000
+#define VBRI_ENTRY_FRAMES	100
+#define FLAC_SECONDS	120
+#define FLAC_BLOCK		4096
+#define FLAC_POINT_SEC	10
+#define SAMPLE_RATE		44100
+
+#define MAX_FRAMES		MP3_FRAMES
+#define NUM_SEEKS		1000
+#define NUM_SCANS		10
+/* a breakpoint of the playing track every that many frames */
+#define LEARN_FRAMES	25
+#define SMALL_FRAMES	200
+
+#define CACHE_PATH		CONFIG_MEDIA_SEEK_TABLE_CACHE_DIR "/seektab.dat"
+
+typedef struct {
+	const char *url;
+	uint8_t format;
+	uint32_t size;
+	int num;
+	uint32_t time_ms[MAX_FRAMES];
+	uint32_t offset[MAX_FRAMES];
+} track_t;
+
+typedef struct {
+	uint32_t open_reads;
+	int hits;
+	int on_frame;
+	int max_err_ms;
+	double find_ns;
+	double scan_reads;
+	double table_reads;
+} seek_result_t;
+
+static const uint16_t mp3_kbps[15] = {
+	0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320,
+};
+
+static uint8_t file_buf[12 * 1024 * 1024];
+static track_t xing, vbri, flac, small;
+static uint32_t seed = 5;
+
+static int write_file(const char *path, const uint8_t *buf, size_t size)
+{
+	struct fs_file_t file;
+	int res;
+
+	fs_file_t_init(&file);
+	res = fs_open(&file, path, FS_O_RDWR | FS_O_CREATE);
+	if (res)
+		return res;
+
+	res = fs_truncate(&file, 0);
+	if (!res && size)
+		res = (fs_write(&file, buf, size) == size) ? 0 : -EIO;
+
+	fs_close(&file);
+	return res;
+}
+
+static uint32_t mp3_frame(uint8_t *buf, int br_idx, int pad)
+{
+	uint32_t len = 144 * mp3_kbps[br_idx] * 1000 / SAMPLE_RATE + pad;
+
+	memset(buf, 0, len);
+	buf[0] = 0xff;
+	buf[1] = 0xfb;		/* MPEG 1 layer 3, no crc */
+	buf[2] = (br_idx << 4) | (pad << 1);
+	buf[3] = 0x00;		/* stereo */
+	return len;
+}
+
+/* id3v2 tag, tag frame (Xing or VBRI), then vbr frames */
+static void make_mp3(track_t *track, const char *url, bool with_vbri, int frames)
+{
+	uint32_t pos = 10 + MP3_ID3_SIZE, tag, tag_len, len, i;
+	uint8_t *x;
+
+	track->url = url;
+	track->format = MP3_TYPE;
+	track->num = frames;
+
+	memset(file_buf, 0, pos);
+	memcpy(file_buf, "ID3\x03\x00\x00", 6);
+	file_buf[8] = MP3_ID3_SIZE >> 7;
+	file_buf[9] = MP3_ID3_SIZE & 0x7f;
+
+	tag = pos;
+	tag_len = mp3_frame(&file_buf[tag], with_vbri ? 14 : 9, 0);
+	pos += tag_len;
+
+	for (i = 0; i < frames; i++) {
+		track->time_ms[i] = (uint64_t)i * MP3_SAMPLES * 1000 / SAMPLE_RATE;
+		track->offset[i] = pos;
+		pos += mp3_frame(&file_buf[pos], test_rand_range(&seed, 9, 14), test_rand(&seed) & 1);
+	}
+
+	x = &file_buf[tag + 4 + 32];
+	if (with_vbri) {
+		uint16_t entries = (frames + VBRI_ENTRY_FRAMES - 1) / VBRI_ENTRY_FRAMES;
+
+		memcpy(x, "VBRI", 4);
+		sys_put_be16(1, &x[4]);
+		sys_put_be32(pos - tag, &x[10]);
+		sys_put_be32(frames, &x[14]);
+		sys_put_be16(entries, &x[18]);
+		sys_put_be16(1, &x[20]);
+		sys_put_be16(4, &x[22]);
+		sys_put_be16(VBRI_ENTRY_FRAMES, &x[24]);
+
+		for (i = 0; i < entries; i++) {
+			uint32_t end = (i + 1 < entries) ? track->offset[(i + 1) * VBRI_ENTRY_FRAMES] : pos;
+
+			sys_put_be32(end - track->offset[i * VBRI_ENTRY_FRAMES], &x[26 + i * 4]);
+		}
+	} else {
+		memcpy(x, "Xing", 4);
+		sys_put_be32(0x7, &x[4]);
+		sys_put_be32(frames, &x[8]);
+		sys_put_be32(pos - tag, &x[12]);
+
+		/* toc of the estimated position at each percent */
+		for (i = 0; i < 100; i++) {
+			len = track->offset[i * frames / 100] - tag;
+			x[16 + i] = MIN((uint64_t)len * 256 / (pos - tag), 255);
+		}
+	}
+
+	track->size = pos;
+	TEST_CHECK(!write_file(url, file_buf, pos));
+}
+
+/* STREAMINFO, SEEKTABLE with a point every FLAC_POINT_SEC, then the frames */
+static void make_flac(track_t *track, const char *url)
+{
+	uint64_t total = (uint64_t)SAMPLE_RATE * FLAC_SECONDS;
+	uint32_t frames = (total + FLAC_BLOCK - 1) / FLAC_BLOCK;
+	uint32_t points = 0, pos, first, len, i;
+	uint8_t *meta;
+
+	track->url = url;
+	track->format = FLA_TYPE;
+	track->num = frames;
+
+	for (i = 0; i < frames; i++) {
+		if ((uint64_t)i * FLAC_BLOCK % (SAMPLE_RATE * FLAC_POINT_SEC) < FLAC_BLOCK)
+			points++;
+	}
+
+	memcpy(file_buf, "fLaC", 4);
+	meta = &file_buf[4];
+	memset(meta, 0, 4 + 34);
+	meta[0] = 0;
+	sys_put_be24(34, &meta[1]);
+	sys_put_be16(FLAC_BLOCK, &meta[4]);
+	sys_put_be16(FLAC_BLOCK, &meta[6]);
+	sys_put_be24((SAMPLE_RATE << 4) | (1 << 1), &meta[4 + 10]);
+	meta[4 + 13] = (15 << 4) | (uint8_t)((total >> 32) & 0x0f);
+	sys_put_be32((uint32_t)total, &meta[4 + 14]);
+
+	meta += 4 + 34;
+	meta[0] = 0x83;
+	sys_put_be24(points * 18, &meta[1]);
+	first = meta + 4 + points * 18 - file_buf;
+
+	for (i = 0, pos = first, points = 0; i < frames; i++) {
+		uint64_t sample = (uint64_t)i * FLAC_BLOCK;
+
+		track->time_ms[i] = sample * 1000 / SAMPLE_RATE;
+		track->offset[i] = pos;
+
+		if (sample % (SAMPLE_RATE * FLAC_POINT_SEC) < FLAC_BLOCK) {
+			sys_put_be64(sample, &meta[4 + points * 18]);
+			sys_put_be64(pos - first, &meta[4 + points * 18 + 8]);
+			sys_put_be16(FLAC_BLOCK, &meta[4 + points * 18 + 16]);
+			points++;
+		}
+
+		len = test_rand_range(&seed, 1000, 4000);
+		memset(&file_buf[pos], 0, len);
+		file_buf[pos] = 0xff;
+		file_buf[pos + 1] = 0xf8;
+		pos += len;
+	}
+
+	track->size = pos;
+	TEST_CHECK(!write_file(url, file_buf, pos));
+}
+
+/* frame of the track starting at that offset, -1 if none */
+static int track_frame(const track_t *track, uint32_t offset)
+{
+	int lo = 0, hi = track->num - 1;
+
+	while (lo <= hi) {
+		int mid = (lo + hi) / 2;
+
+		if (track->offset[mid] == offset)
+			return mid;
+		if (track->offset[mid] < offset)
+			lo = mid + 1;
+		else
+			hi = mid - 1;
+	}
+
+	return -1;
+}
+
+/* sector reads of the parser walking the frame headers up to time_ms */
+static uint32_t scan_reads(const track_t *track, uint32_t time_ms)
+{
+	uint32_t reads = ram_disk_reads(RAM_DISK_SD);
+	struct fs_file_t file;
+	uint8_t h[4];
+	int i;
+
+	fs_file_t_init(&file);
+	if (fs_open(&file, track->url, FS_O_READ))
+		return 0;
+
+	for (i = 0; i < track->num && track->time_ms[i] <= time_ms; i++) {
+		fs_seek(&file, track->offset[i], FS_SEEK_SET);
+		fs_read(&file, h, sizeof(h));
+	}
+
+	fs_close(&file);
+	return ram_disk_reads(RAM_DISK_SD) - reads;
+}
+
+/* sector reads of the parser reading the frame at the point */
+static uint32_t point_reads(const track_t *track, uint32_t offset)
+{
+	uint32_t reads = ram_disk_reads(RAM_DISK_SD);
+	struct fs_file_t file;
+	uint8_t h[4];
+
+	fs_file_t_init(&file);
+	if (fs_open(&file, track->url, FS_O_READ))
+		return 0;
+
+	fs_seek(&file, offset, FS_SEEK_SET);
+	fs_read(&file, h, sizeof(h));
+	fs_close(&file);
+	return ram_disk_reads(RAM_DISK_SD) - reads;
+}
+
+static void *table_open(const track_t *track, seek_result_t *res)
+{
+	uint32_t reads = ram_disk_reads(RAM_DISK_SD);
+	void *table = media_seek_table_open(track->url, track->format);
+
+	res->open_reads = ram_disk_reads(RAM_DISK_SD) - reads;
+	TEST_CHECK(table != NULL);
+	return table;
+}
+
+static void seek_run(const track_t *track, void *table, const char *name, seek_result_t *res)
+{
+	uint32_t duration = track->time_ms[track->num - 1];
+	uint32_t scans = 0, points = 0;
+	media_breakpoint_info_t bp;
+	uint64_t start, ns = 0;
+	int i, err, frame;
+
+	res->hits = res->on_frame = res->max_err_ms = 0;
+
+	for (i = 0; i < NUM_SEEKS; i++) {
+		int target = (uint64_t)duration * i / NUM_SEEKS;
+
+		start = test_time_ns();
+		err = media_seek_table_find(table, target, MEDIA_SEEK_TABLE_TOLERANCE, &bp);
+		ns += test_time_ns() - start;
+		if (err)
+			continue;
+
+		res->hits++;
+		res->max_err_ms = MAX(res->max_err_ms, abs(bp.time_offset - target));
+
+		frame = track_frame(track, bp.file_offset);
+		if (frame >= 0 && track->time_ms[frame] == bp.time_offset)
+			res->on_frame++;
+
+		if (i % (NUM_SEEKS / NUM_SCANS) == 0) {
+			scans += scan_reads(track, target);
+			points += point_reads(track, bp.file_offset);
+		}
+	}
+
+	res->find_ns = (double)ns / NUM_SEEKS;
+	res->scan_reads = (double)scans / NUM_SCANS;
+	res->table_reads = (double)points / NUM_SCANS;
+
+	printf("%-12s %8u %8d %8d %8d %8.0f %8.1f %8.1f\n", name, res->open_reads, res->hits,
+			res->on_frame, res->max_err_ms, res->find_ns, res->scan_reads, res->table_reads);
+
+	TEST_CHECK_MSG(res->on_frame == res->hits, "%s: %d of %d points off a frame",
+			name, res->hits - res->on_frame, res->hits);
+	TEST_CHECK_MSG(res->max_err_ms <= MEDIA_SEEK_TABLE_TOLERANCE, "%s: %d ms off",
+			name, res->max_err_ms);
+}
+
+/* playback breakpoints of a whole track */
+static void learn(const track_t *track, void *table)
+{
+	media_breakpoint_info_t bp;
+	int i;
+
+	for (i = 0; i < track->num; i += LEARN_FRAMES) {
+		bp.time_offset = track->time_ms[i];
+		bp.file_offset = track->offset[i];
+		media_seek_table_add_breakpoint(table, &bp);
+	}
+}
+
+static void test_tracks(void)
+{
+	seek_result_t res;
+	void *table;
+
+	printf("%-12s %8s %8s %8s %8s %8s %8s %8s\n", "track", "open rd", "hits",
+			"on frame", "max ms", "find ns", "scan rd", "point rd");
+
+	/* the toc only gives the duration, so no point until playback */
+	table = table_open(&xing, &res);
+	seek_run(&xing, table, "xing", &res);
+	TEST_CHECK_MSG(res.hits == 0, "xing: %d toc estimates served", res.hits);
+	learn(&xing, table);
+	seek_run(&xing, table, "xing played", &res);
+	TEST_CHECK(res.hits > NUM_SEEKS / 4);
+	media_seek_table_close(table);
+
+	table = table_open(&xing, &res);
+	seek_run(&xing, table, "xing cached", &res);
+	TEST_CHECK(res.hits > NUM_SEEKS / 4);
+	media_seek_table_close(table);
+
+	table = table_open(&vbri, &res);
+	seek_run(&vbri, table, "vbri", &res);
+	TEST_CHECK(res.hits > 0 && res.scan_reads > res.table_reads * 10);
+	media_seek_table_close(table);
+
+	/* breakpoint offsets of flac are not frame starts, they are ignored */
+	table = table_open(&flac, &res);
+	learn(&flac, table);
+	seek_run(&flac, table, "flac", &res);
+	TEST_CHECK(res.hits > 0 && res.scan_reads > res.table_reads * 10);
+	media_seek_table_close(table);
+}
+
+static void test_cache(void)
+{
+	media_breakpoint_info_t bp;
+	struct fs_dirent entry;
+	char url[32];
+	void *table;
+	int i;
+
+	/* more tracks than the cache holds, each played a little */
+	for (i = 0; i < CONFIG_MEDIA_SEEK_TABLE_CACHE_NUM; i++) {
+		snprintf(url, sizeof(url), "/SD:/small_%d.mp3", i);
+		make_mp3(&small, url, false, SMALL_FRAMES);
+
+		table = media_seek_table_open(url, MP3_TYPE);
+		TEST_CHECK(table != NULL);
+		bp.time_offset = small.time_ms[SMALL_FRAMES / 2];
+		bp.file_offset = small.offset[SMALL_FRAMES / 2];
+		media_seek_table_add_breakpoint(table, &bp);
+		media_seek_table_close(table);
+	}
+
+	/* the xing table was saved first, so replaced first */
+	table = media_seek_table_open(xing.url, MP3_TYPE);
+	TEST_CHECK(media_seek_table_find(table, xing.time_ms[LEARN_FRAMES * 4],
+			MEDIA_SEEK_TABLE_TOLERANCE, &bp) == -ENOENT);
+	media_seek_table_close(table);
+
+	/* the last small track is still cached, until rewritten in place */
+	table = media_seek_table_open(url, MP3_TYPE);
+	TEST_CHECK(!media_seek_table_find(table, bp.time_offset, 0, &bp));
+	media_seek_table_close(table);
+
+	file_buf[small.size / 2 + 10] ^= 0x55;
+	TEST_CHECK(!write_file(url, file_buf, small.size));
+	table = media_seek_table_open(url, MP3_TYPE);
+	TEST_CHECK(media_seek_table_find(table, bp.time_offset, 0, &bp) == -ENOENT);
+	media_seek_table_close(table);
+
+	TEST_CHECK(!fs_stat(CACHE_PATH, &entry) && entry.size > 0);
+	TEST_CHECK(fs_stat("/SD:/.seektab", &entry) != 0);
+}
+
+int main(int argc, char *argv[])
+{
+	if (ram_disk_mount(RAM_DISK_SD, SD_SECTORS) || ram_disk_mount(RAM_DISK_NOR, NOR_SECTORS)) {
+		printf("ram disk mount failed\n");
+		return EXIT_FAILURE;
+	}
+
+	make_mp3(&xing, "/SD:/xing.mp3", false, MP3_FRAMES);
+	make_mp3(&vbri, "/SD:/vbri.mp3", true, MP3_FRAMES);
+	make_flac(&flac, "/SD:/flac.fla");
+
+	TEST_RUN(test_tracks);
+	TEST_RUN(test_cache);
+
+	ram_disk_unmount(RAM_DISK_NOR);
+	ram_disk_unmount(RAM_DISK_SD);
+
+	return TEST_RESULT();
+}
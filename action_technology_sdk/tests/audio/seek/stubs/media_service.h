@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Host stand-in of the media service, with the breakpoint type of
+ *        framework/media/include/media_service.h used by the seek table
+ */
+
+#ifndef TESTS_AUDIO_SEEK_STUBS_MEDIA_SERVICE_H_
+#define TESTS_AUDIO_SEEK_STUBS_MEDIA_SERVICE_H_
+
+typedef struct {
+	/** required in ms*/
+	int time_offset;
+	/** optional, in bytes, <= 0 if not available */
+	int file_offset;
+} media_breakpoint_info_t;
+
+#endif /* TESTS_AUDIO_SEEK_STUBS_MEDIA_SERVICE_H_ */
@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* no board on the host */
+
+#ifndef TESTS_AUDIO_STUBS_BOARD_H_
+#define TESTS_AUDIO_STUBS_BOARD_H_
+
+#endif /* TESTS_AUDIO_STUBS_BOARD_H_ */
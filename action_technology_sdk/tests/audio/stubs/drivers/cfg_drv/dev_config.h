@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* no driver configuration on the host */
+
+#ifndef TESTS_AUDIO_STUBS_DRIVERS_CFG_DRV_DEV_CONFIG_H_
+#define TESTS_AUDIO_STUBS_DRIVERS_CFG_DRV_DEV_CONFIG_H_
+
+#endif /* TESTS_AUDIO_STUBS_DRIVERS_CFG_DRV_DEV_CONFIG_H_ */
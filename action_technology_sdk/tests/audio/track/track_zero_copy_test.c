@@ -0,0 +1,400 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Zero copy refill of audio_track.c (CONFIG_AUDIO_TRACK_ZERO_COPY) against
+ * a write back data cache.
+ *
+ * The pcm ring buffer has a cpu view and a memory view: cpu writes land in
+ * the cpu view only, mem_dcache_clean() copies them to memory, and dma
+ * reads a region of the ring buffer from memory. The pcm frame buffer of
+ * the copy path is read as written.
+ *
+ * The audio out driver is replaced: each refill request of the track is a
+ * dma transfer done, the data of hal_aout_channel_write_data() is played
+ * at once. Played pcm must be the written pcm, silence while muted, the
+ * faded pcm while fading out, and a region in flight to dma must not be
+ * left dirty in the cache.
+ */
+
+#include <os_common_api.h>
+#include <audio_hal.h>
+#include <audio_system.h>
+#include <audio_track.h>
+#include <audio_device.h>
+#include <media_mem.h>
+#include <memory/mem_cache.h>
+#include <test_common.h>
+
+TEST_MAIN_DEFINE();
+
+#define PCM_POOL_SIZE	(4096)
+#define MAX_PLAYED		(64 * 1024)
+#define MAX_FRAMES		(256)
+
+/* pcm ring buffer, cpu view and memory view */
+static uint8_t pcm_pool[PCM_POOL_SIZE] __aligned(4);
+static uint8_t pcm_mem[PCM_POOL_SIZE];
+
+static uint8_t heap[64 * 1024] __aligned(8);
+static size_t heap_used;
+
+static int (*aout_callback)(void *cb_data, uint32_t reason);
+static void *aout_callback_data;
+static int aout_handle;
+
+static int16_t played[MAX_PLAYED];
+static int num_played;
+static int in_place_writes;
+static int stale_writes;
+static int dirty_in_flight;
+
+/* region in flight to dma */
+static const uint8_t *dma_buf;
+static int dma_len;
+
+static bool in_pool(const void *buf)
+{
+	return ((const uint8_t *)buf >= pcm_pool) && ((const uint8_t *)buf < pcm_pool + PCM_POOL_SIZE);
+}
+
+void *mem_malloc_debug(size_t size, const char *func)
+{
+	void *ptr;
+
+	size = ROUND_UP(size, 8);
+	if (heap_used + size > sizeof(heap))
+		return NULL;
+
+	ptr = &heap[heap_used];
+	heap_used += size;
+	memset(ptr, 0, size);
+	return ptr;
+}
+
+void mem_free(void *ptr)
+{
+}
+
+bool mem_dcache_clean(const void *addr, uint32_t length)
+{
+	if (in_pool(addr))
+		memcpy(&pcm_mem[(const uint8_t *)addr - pcm_pool], addr, length);
+
+	return true;
+}
+
+void mem_dcache_sync(void)
+{
+}
+
+void *media_mem_get_cache_pool(int mem_type, int stream_type)
+{
+	return (mem_type == OUTPUT_PCM) ? pcm_pool : NULL;
+}
+
+int media_mem_get_cache_pool_size(int mem_type, int stream_type)
+{
+	return (mem_type == OUTPUT_PCM) ? PCM_POOL_SIZE : 0;
+}
+
+void *hal_aout_channel_open(audio_out_init_param_t *init_param)
+{
+	aout_callback = init_param->callback;
+	aout_callback_data = init_param->callback_data;
+	return &aout_handle;
+}
+
+/* dma reads a ring buffer region from memory */
+int hal_aout_channel_write_data(void *aout_channel_handle, uint8_t *data, uint32_t data_size)
+{
+	const uint8_t *src = data;
+	int i;
+
+	if (in_pool(data)) {
+		in_place_writes++;
+		src = &pcm_mem[data - pcm_pool];
+		if (memcmp(src, data, data_size))
+			stale_writes++;
+		dma_buf = data;
+		dma_len = data_size;
+	}
+
+	for (i = 0; i + 1 < data_size && num_played < MAX_PLAYED; i += 2)
+		played[num_played++] = src[i] | (src[i + 1] << 8);
+
+	return 0;
+}
+
+int hal_aout_channel_close(void *aout_channel_handle) { return 0; }
+int hal_aout_channel_start(void *aout_channel_handle) { return 0; }
+int hal_aout_channel_stop(void *aout_channel_handle) { return 0; }
+int hal_aout_channel_mute_ctl(void *aout_channel_handle, uint8_t mode) { return 0; }
+int hal_aout_channel_enable_sample_cnt(void *aout_channel_handle, bool enable) { return 0; }
+int hal_aout_channel_reset_sample_cnt(void *aout_channel_handle) { return 0; }
+int hal_aout_set_pcm_threshold(void *aout_channel_handle, int he_thres, int hf_thres) { return 0; }
+int hal_aout_channel_get_buffer_size(void *aout_channel_handle) { return 1024; }
+int hal_aout_channel_get_buffer_space(void *aout_channel_handle) { return 1024; }
+uint32_t hal_aout_channel_get_sample_cnt(void *aout_channel_handle) { return 0; }
+int hal_aout_channel_set_pa_vol_level(void *aout_channel_handle, int vol_level) { return 0; }
+int hal_aout_set_fifo_src(void *aout_channel_handle, uint8_t channel_id, bool from_dsp, void *dsp_audio_set_param) { return 0; }
+int hal_aout_lr_channel_enable(void *aout_channel_handle, bool l_enable, bool r_enable) { return 0; }
+
+int audio_system_mutex_lock(void) { return 0; }
+int audio_system_mutex_unlock(void) { return 0; }
+struct audio_track_t *audio_system_get_track(void) { return NULL; }
+int audio_system_register_track(struct audio_track_t *audio_track) { return 0; }
+int audio_system_unregister_track(struct audio_track_t *audio_track) { return 0; }
+int audio_system_get_output_sample_rate(void) { return 48; }
+int audio_system_get_current_volume(int stream_type) { return 10; }
+int audio_system_get_stream_volume(int stream_type) { return 10; }
+int audio_system_get_current_pa_volume(int stream_type) { return 0; }
+int audio_policy_get_out_channel_type(uint8_t stream_type) { return 0; }
+int audio_policy_get_out_channel_id(uint8_t stream_type) { return AOUT_FIFO_DAC0; }
+int audio_policy_get_out_channel_mode(uint8_t stream_type) { return AUDIO_DMA_MODE; }
+int audio_policy_get_out_audio_mode(uint8_t stream_type) { return AUDIO_MODE_STEREO; }
+int audio_policy_get_pa_volume(uint8_t stream_type, uint8_t volume_level) { return 0; }
+int audio_policy_get_volume_level_by_db(uint8_t stream_type, int volume_db) { return 0; }
+int system_check_low_latencey_mode(void) { return 0; }
+
+uint32_t get_sample_rate_hz(uint8_t fs_khz)
+{
+	return fs_khz * 1000;
+}
+
+/* fade out to half level, in place */
+static int fade_handle;
+
+void *media_fade_open(uint8_t sample_rate, uint8_t channels, uint8_t sample_bits, uint8_t is_interweaved)
+{
+	return &fade_handle;
+}
+
+void media_fade_close(void *handle) { }
+int media_fade_in_set(void *handle, int fade_time_ms) { return 0; }
+int media_fade_out_set(void *handle, int fade_time_ms) { return 0; }
+int media_fade_out_is_finished(void *handle) { return 0; }
+
+int media_fade_process(void *handle, void **inout_buf, int samples)
+{
+	int16_t *pcm = *inout_buf;
+	int i;
+
+	for (i = 0; i < samples * 2; i++)
+		pcm[i] /= 2;
+
+	return 0;
+}
+
+void *media_resample_open(uint8_t channels, uint8_t samplerate_in, uint8_t samplerate_out,
+		int *samples_in, int *samples_out, uint8_t stream_type)
+{
+	return NULL;
+}
+
+void media_resample_close(void *handle) { }
+int stream_read_pcm(asin_pcm_t *aspcm, io_stream_t stream, int max_samples, int debug_space) { return 0; }
+
+void *media_mix_open(uint8_t sample_rate, uint8_t channels, uint8_t is_interweaved) { return NULL; }
+void media_mix_close(void *handle) { }
+int media_mix_process(void *handle, void **inout_buf, void *mix_buf, int samples) { return 0; }
+
+/* a transfer is done, the track refills */
+static void dma_done(void)
+{
+	/* the cache must not write back over the region dma read */
+	if (dma_buf && memcmp(dma_buf, &pcm_mem[dma_buf - pcm_pool], dma_len))
+		dirty_in_flight++;
+
+	dma_buf = NULL;
+	aout_callback(aout_callback_data, AOUT_DMA_IRQ_HF);
+}
+
+static struct audio_track_t *track_open(void)
+{
+	struct audio_track_t *track;
+
+	heap_used = 0;
+	memset(pcm_pool, 0, sizeof(pcm_pool));
+	memset(pcm_mem, 0, sizeof(pcm_mem));
+	num_played = 0;
+	in_place_writes = 0;
+	stale_writes = 0;
+	dirty_in_flight = 0;
+	dma_buf = NULL;
+
+	track = audio_track_create(AUDIO_STREAM_MUSIC, 48, AUDIO_FORMAT_PCM_16_BIT,
+			AUDIO_MODE_STEREO, NULL, NULL, NULL);
+	TEST_CHECK(track != NULL);
+	return track;
+}
+
+/* write n frames of a ramp from *next, as the decoder */
+static void track_write(struct audio_track_t *track, int16_t *next, int frames)
+{
+	int16_t pcm[MAX_FRAMES * 2];
+	int i;
+
+	for (i = 0; i < frames * 2; i++)
+		pcm[i] = (*next)++;
+
+	TEST_CHECK(audio_track_write(track, (uint8_t *)pcm, frames * 4) == frames * 4);
+}
+
+/* play the ramp, with cb at each transfer */
+static void track_play(struct audio_track_t *track, int transfers,
+		void (*cb)(struct audio_track_t *track, int n))
+{
+	int16_t next = 0;
+	int n;
+
+	track_write(track, &next, MAX_FRAMES);
+	track_write(track, &next, MAX_FRAMES);
+	TEST_CHECK(track->stared);
+
+	for (n = 0; n < transfers; n++) {
+		if (stream_get_space(audio_track_get_stream(track)) >= MAX_FRAMES * 4)
+			track_write(track, &next, MAX_FRAMES);
+		if (cb)
+			cb(track, n);
+		dma_done();
+	}
+}
+
+static int ramp_errors(int from, int to, int div)
+{
+	int i, bad = 0;
+
+	for (i = from; i < to; i++) {
+		if (played[i] != (int16_t)i / div)
+			bad++;
+	}
+
+	return bad;
+}
+
+static void test_play(void)
+{
+	struct audio_track_t *track = track_open();
+
+	if (!track)
+		return;
+
+	track_play(track, 64, NULL);
+
+	TEST_CHECK_MSG(in_place_writes > 32, "%d transfers in place", in_place_writes);
+	TEST_CHECK(stale_writes == 0 && dirty_in_flight == 0);
+	TEST_CHECK_MSG(ramp_errors(0, num_played, 1) == 0, "%d samples", num_played);
+
+	audio_track_stop(track);
+	audio_track_destory(track);
+}
+
+static void mute_at(struct audio_track_t *track, int n)
+{
+	if (n == 16)
+		audio_track_mute(track, 1);
+	if (n == 32)
+		audio_track_mute(track, 0);
+}
+
+static void test_mute(void)
+{
+	struct audio_track_t *track = track_open();
+	int i, muted = 0, start = -1, end = -1;
+
+	if (!track)
+		return;
+
+	track_play(track, 64, mute_at);
+
+	for (i = 0; i < num_played; i++) {
+		if (played[i] != (int16_t)i) {
+			if (played[i] == 0) {
+				muted++;
+				if (start < 0)
+					start = i;
+				end = i;
+			}
+		}
+	}
+
+	TEST_CHECK(stale_writes == 0 && dirty_in_flight == 0);
+	TEST_CHECK_MSG(start > 0 && muted == end - start + 1, "silence %d..%d, %d muted",
+			start, end, muted);
+	TEST_CHECK(ramp_errors(0, start, 1) == 0 && ramp_errors(end + 1, num_played, 1) == 0);
+	TEST_CHECK(in_place_writes > 16);
+
+	audio_track_stop(track);
+	audio_track_destory(track);
+}
+
+static void fade_at(struct audio_track_t *track, int n)
+{
+	if (n == 16)
+		audio_track_set_fade_out(track, 100);
+}
+
+static void test_fade_out(void)
+{
+	struct audio_track_t *track = track_open();
+	int i, start = -1;
+
+	if (!track)
+		return;
+
+	track_play(track, 64, fade_at);
+
+	for (i = 0; i < num_played && start < 0; i++) {
+		if (played[i] != (int16_t)i)
+			start = i;
+	}
+
+	TEST_CHECK(stale_writes == 0 && dirty_in_flight == 0);
+	TEST_CHECK_MSG(start > 0 && ramp_errors(start, num_played, 2) == 0,
+			"fade from %d, %d samples", start, num_played);
+
+	audio_track_stop(track);
+	audio_track_destory(track);
+}
+
+/* the tail of a flushed track is padded after the last claim is released */
+static void test_flush_tail(void)
+{
+	struct audio_track_t *track = track_open();
+	io_stream_t stream;
+	int n;
+
+	if (!track)
+		return;
+
+	track_play(track, 8, NULL);
+
+	stream = audio_track_get_stream(track);
+	audio_track_flush(track);
+	for (n = 0; n < 8 && stream_get_length(stream) > 0; n++)
+		dma_done();
+
+	TEST_CHECK(stream_get_length(stream) == 0);
+	TEST_CHECK(stale_writes == 0 && dirty_in_flight == 0);
+	TEST_CHECK(ramp_errors(0, num_played - 4, 1) == 0);
+
+	dma_done();
+	TEST_CHECK(dirty_in_flight == 0);
+
+	audio_track_stop(track);
+	audio_track_destory(track);
+}
+
+int main(void)
+{
+	TEST_RUN(test_play);
+	TEST_RUN(test_mute);
+	TEST_RUN(test_fade_out);
+	TEST_RUN(test_flush_tail);
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Two tws nodes with independent drifting clocks, aligned by the sync
+ * engine of audio_tws_sync.c (CONFIG_AUDIO_TWS_SYNC_ENGINE).
+ *
+ * Both nodes play 48KHz on their own crystal, offset from the bt clock by
+ * a fixed ppm, at the rate of their APS level taken from the level table
+ * of audio_aps.c. The master changes its level now and then, as its own
+ * APS follows the source. Every 100ms it sends its sample counter at a bt
+ * clock, the slave gets it 3ms later as a whole sample difference. The
+ * slave adds its own sample counter every 200ms, and every 10ms asks the
+ * engine for a correction which it plays through the dithered APS level
+ * of audio_aps_monitor_ppm_to_level(), as audio_aps_monitor_slave() does.
+ *
+ * The slave starts 12.7 samples behind. After 30s of settling the
+ * simulation reports the true offset between the nodes, the offset and
+ * drift the engine estimates and the slave level changes per minute. The
+ * offset must stay below one sample and the estimate within one sample of
+ * it; the drift is resolved to one sample over the fit window.
+ *
+ * usage: tws_sync_sim [seconds]
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include <os_common_api.h>
+#include <audio_system.h>
+#include <audio_track.h>
+#include <media_type.h>
+#include <test_common.h>
+#include "audio_tws_sync.h"
+
+TEST_MAIN_DEFINE();
+
+#define SAMPLE_RATE		48000
+#define STEP_US			1000
+#define CTRL_US			10000
+#define LOCAL_US		200000
+#define SYNC_US			100000
+#define SYNC_DELAY_US	3000
+#define MASTER_LVL_US	7000000
+#define SETTLE_US		30000000
+#define START_OFFSET	12.7
+/* one whole sample over the 1.5s of sync points in the fit */
+#define DRIFT_TOL_PPM	15
+
+typedef struct {
+	int master_ppm;         // crystal offsets from the bt clock
+	int slave_ppm;
+	double mean;            // true offset, samples
+	double max;
+	double est_err_us;      // max estimate error
+	int drift_ppm;          // master against uncorrected slave
+	int est_drift_ppm;
+	int changes;            // slave level changes per minute
+} sim_result_t;
+
+static struct audio_track_t track;
+
+int hal_aout_channel_set_aps(void *aout_channel_handle, unsigned int aps_level_set, unsigned int aps_mode)
+{
+	return 0;
+}
+
+int audio_policy_get_increase_threshold(int format)
+{
+	return 200;
+}
+
+int audio_policy_get_reduce_threshold(int format)
+{
+	return 100;
+}
+
+int system_check_low_latencey_mode(void)
+{
+	return 0;
+}
+
+int audio_track_set_waitto_start(struct audio_track_t *handle, bool wait)
+{
+	return 0;
+}
+
+static double node_rate(aps_monitor_info_t *aps, int crystal_ppm, uint8_t level)
+{
+	return SAMPLE_RATE * (1 + crystal_ppm * 1e-6) *
+			(1 + audio_aps_monitor_level_to_ppm(aps, level) * 1e-6);
+}
+
+static void sim_run(int master_ppm, int slave_ppm, int seconds, sim_result_t *res)
+{
+	aps_monitor_info_t *aps;
+	audio_tws_sync_stat_t stat;
+	uint32_t seed = 5;
+	uint8_t master_level = APS_LEVEL_4, slave_level = APS_LEVEL_4, level;
+	double master_smp = 0, slave_smp = -START_OFFSET;
+	double sync_master = 0, sync_slave = 0, sum = 0;
+	uint32_t bt_us, sync_us = 0;
+	bool sync_pending = false;
+	int num = 0;
+
+	memset(res, 0, sizeof(*res));
+	res->master_ppm = master_ppm;
+	res->slave_ppm = slave_ppm;
+	res->drift_ppm = master_ppm - slave_ppm;
+
+	track.output_sample_rate_hz = SAMPLE_RATE;
+	audio_aps_monitor_init(SBC_TYPE, NULL, &track);
+	aps = audio_aps_monitor_get_instance();
+	audio_tws_sync_reset(SAMPLE_RATE);
+
+	/* start the bt clock away from zero, it wraps in the middle of the run */
+	for (bt_us = 0xffffffff - 20000000; ; bt_us += STEP_US) {
+		uint32_t t = bt_us - (0xffffffff - 20000000);
+
+		if ((uint64_t)t >= (uint64_t)seconds * 1000000)
+			break;
+
+		master_smp += node_rate(aps, master_ppm, master_level) * STEP_US * 1e-6;
+		slave_smp += node_rate(aps, slave_ppm, slave_level) * STEP_US * 1e-6;
+
+		if (t % MASTER_LVL_US == 0 && t)
+			master_level = APS_LEVEL_3 + test_rand(&seed) % 3;
+
+		if (t % LOCAL_US == 0)
+			audio_tws_sync_add_local(bt_us, (uint32_t)floor(slave_smp));
+
+		/* both counters are latched at the sync bt clock, the result comes later */
+		if (t % SYNC_US == 0) {
+			sync_us = bt_us;
+			sync_master = floor(master_smp);
+			sync_slave = floor(slave_smp);
+			sync_pending = true;
+		}
+		if (sync_pending && bt_us - sync_us >= SYNC_DELAY_US) {
+			audio_tws_sync_add_diff(sync_us, (int32_t)(sync_master - sync_slave));
+			sync_pending = false;
+		}
+
+		if (t % CTRL_US == 0) {
+			int32_t master_lvl_ppm = audio_aps_monitor_level_to_ppm(aps, master_level);
+			int32_t applied = audio_aps_monitor_level_to_ppm(aps, slave_level) - master_lvl_ppm;
+			int32_t ppm;
+
+			if (!audio_tws_sync_get_correction(bt_us, applied, &ppm)) {
+				level = audio_aps_monitor_ppm_to_level(aps, master_lvl_ppm + ppm);
+				if (level != slave_level && t >= SETTLE_US)
+					res->changes++;
+				slave_level = level;
+			}
+		}
+
+		if (t >= SETTLE_US) {
+			double offset = master_smp - slave_smp;
+
+			sum += offset;
+			res->max = MAX(res->max, fabs(offset));
+			num++;
+
+			if (t % CTRL_US == 0 && !audio_tws_sync_get_stat(&stat)) {
+				double err = stat.offset_us - offset * 1e6 / SAMPLE_RATE;
+
+				res->est_err_us = MAX(res->est_err_us, fabs(err));
+			}
+		}
+	}
+
+	res->mean = sum / num;
+	res->changes = res->changes * 60LL / (seconds - SETTLE_US / 1000000);
+
+	TEST_CHECK(!audio_tws_sync_get_stat(&stat));
+	res->est_drift_ppm = stat.drift_ppm;
+}
+
+int main(int argc, char *argv[])
+{
+	static const int clocks[][2] = {
+		{ 0, 0, }, { 20, -20, }, { -30, 25, }, { 50, 10, }, { -50, -10, },
+	};
+	int seconds = (argc > 1) ? atoi(argv[1]) : 120;
+	int i;
+
+	seconds = MAX(seconds, SETTLE_US / 1000000 + 10);
+
+	printf("%-8s %-8s %8s %8s %8s %8s %8s %8s\n", "master", "slave", "drift", "est ppm",
+			"mean smp", "max smp", "est us", "lvl/min");
+
+	for (i = 0; i < ARRAY_SIZE(clocks); i++) {
+		sim_result_t res;
+
+		sim_run(clocks[i][0], clocks[i][1], seconds, &res);
+
+		printf("%-8d %-8d %8d %8d %8.3f %8.3f %8.1f %8d\n", res.master_ppm, res.slave_ppm,
+				res.drift_ppm, res.est_drift_ppm, res.mean, res.max, res.est_err_us,
+				res.changes);
+
+		TEST_CHECK_MSG(res.max < 1, "clocks %d/%d: offset up to %.3f samples",
+				res.master_ppm, res.slave_ppm, res.max);
+		TEST_CHECK_MSG(abs(res.est_drift_ppm - res.drift_ppm) <= DRIFT_TOL_PPM, "clocks %d/%d: drift %d",
+				res.master_ppm, res.slave_ppm, res.est_drift_ppm);
+		TEST_CHECK_MSG(res.est_err_us < 1e6 / SAMPLE_RATE, "clocks %d/%d: estimate off by %.1fus",
+				res.master_ppm, res.slave_ppm, res.est_err_us);
+	}
+
+	return TEST_RESULT();
+}
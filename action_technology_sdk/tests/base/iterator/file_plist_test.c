@@ -0,0 +1,371 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Play list of the file iterator with the media index
+ * (CONFIG_FILE_ITERATOR_MEDIA_INDEX), on FatFs images in RAM: the music on
+ * "/SD:", the index on "/NOR:".
+ *
+ * The first play list scans the disk and writes the index, later ones on
+ * the unchanged disk restore it with a fraction of the sector reads, and
+ * list the same tracks from the same cursor. A new track, a new empty
+ * track (same free space) and a track changed behind the index each lead
+ * to a scan again. The index never lands on the music disk.
+ *
+ * Sector reads of the music disk stand for the time of the play list
+ * update, they are printed for the scan and for the restore.
+ */
+
+#include <os_common_api.h>
+#include <fs/fs.h>
+#include <iterator/file_iterator.h>
+#include <test_common.h>
+#include "ram_disk.h"
+
+TEST_MAIN_DEFINE();
+
+#define SD_SECTORS		(32 * 1024)
+#define NOR_SECTORS		(2 * 1024)
+
+#define NUM_FOLDERS		12
+#define FOLDER_TRACKS	60
+#define TOP_TRACKS		5
+#define SUB_TRACKS		10
+#define NUM_TRACKS		(TOP_TRACKS + NUM_FOLDERS * FOLDER_TRACKS + SUB_TRACKS)
+
+#define MAX_TRACKS		(NUM_TRACKS + 8)
+#define URL_LEN			(MAX_URL_LEN + 2)
+
+typedef struct {
+	int num;
+	uint32_t sd_reads;
+	char urls[MAX_TRACKS][URL_LEN];
+} plist_t;
+
+static plist_t scanned, listed;
+
+static int match_fn(const char *path, int is_dir)
+{
+	const char *ext = strrchr(path, '.');
+
+	return is_dir || (ext && !strcmp(ext, ".mp3"));
+}
+
+static int write_file(const char *path, size_t size)
+{
+	static uint8_t buf[16 * 1024];
+	struct fs_file_t file;
+	int res;
+
+	fs_file_t_init(&file);
+	res = fs_open(&file, path, FS_O_RDWR | FS_O_CREATE);
+	if (res)
+		return res;
+
+	res = fs_truncate(&file, 0);
+	if (!res && size)
+		res = (fs_write(&file, buf, size) == size) ? 0 : -EIO;
+
+	fs_close(&file);
+	return res;
+}
+
+static size_t track_size(int n)
+{
+	return 700 + (n * 397) % 9000;
+}
+
+static void make_tree(void)
+{
+	char path[64];
+	int i, n, num = 0;
+
+	for (n = 0; n < TOP_TRACKS; n++) {
+		snprintf(path, sizeof(path), "/SD:/top_%02d.mp3", n);
+		TEST_CHECK(!write_file(path, track_size(num++)));
+	}
+	TEST_CHECK(!write_file("/SD:/readme.txt", 300));
+	TEST_CHECK(!write_file("/SD:/.hidden.mp3", 300));
+
+	for (i = 0; i < NUM_FOLDERS; i++) {
+		snprintf(path, sizeof(path), "/SD:/album_%02d", i);
+		TEST_CHECK(!fs_mkdir(path));
+
+		for (n = 0; n < FOLDER_TRACKS; n++) {
+			snprintf(path, sizeof(path), "/SD:/album_%02d/track_%02d.mp3", i, n);
+			TEST_CHECK(!write_file(path, track_size(num++)));
+		}
+
+		snprintf(path, sizeof(path), "/SD:/album_%02d/cover.jpg", i);
+		TEST_CHECK(!write_file(path, 2000));
+	}
+
+	TEST_CHECK(!fs_mkdir("/SD:/album_00/disc_2"));
+	for (n = 0; n < SUB_TRACKS; n++) {
+		snprintf(path, sizeof(path), "/SD:/album_00/disc_2/track_%02d.mp3", n);
+		TEST_CHECK(!write_file(path, track_size(num++)));
+	}
+}
+
+/* play list from the cursor, then every track once from track 1 on */
+static struct iterator *plist_open(const char *cursor_path, plist_t *plist)
+{
+	file_iterator_cursor_t cursor = { .path = cursor_path, };
+	file_iterator_param_t param = {
+		.max_level = 4,
+		.topdir = "/SD:/",
+		.cursor = &cursor,
+		.match_fn = match_fn,
+	};
+	uint32_t reads = ram_disk_reads(RAM_DISK_SD);
+	struct iterator *iter = file_iterator_create(&param);
+	uint16_t num = 0;
+
+	plist->sd_reads = ram_disk_reads(RAM_DISK_SD) - reads;
+	plist->num = 0;
+
+	if (iter)
+		iterator_get_plist_info(iter, &num);
+	plist->num = MIN(num, MAX_TRACKS);
+
+	return iter;
+}
+
+static void plist_list(struct iterator *iter, plist_t *plist)
+{
+	int i;
+
+	for (i = 0; i < plist->num; i++) {
+		const char *url = iterator_set_track_no(iter, i + 1);
+
+		snprintf(plist->urls[i], URL_LEN, "%s", url ? url : "");
+	}
+}
+
+static void plist_read(const char *cursor_path, plist_t *plist)
+{
+	struct iterator *iter = plist_open(cursor_path, plist);
+
+	TEST_CHECK(iter != NULL);
+	if (iter) {
+		plist_list(iter, plist);
+		iterator_destroy(iter);
+	}
+}
+
+static bool plist_equal(const plist_t *a, const plist_t *b)
+{
+	int i;
+
+	if (a->num != b->num)
+		return false;
+
+	for (i = 0; i < a->num; i++) {
+		if (strcmp(a->urls[i], b->urls[i]))
+			return false;
+	}
+
+	return true;
+}
+
+static int plist_find(const plist_t *plist, const char *name)
+{
+	int i;
+
+	for (i = 0; i < plist->num; i++) {
+		const char *slash = strrchr(plist->urls[i], '/');
+
+		if (slash && !strcmp(slash + 1, name))
+			return i;
+	}
+
+	return -1;
+}
+
+/* a scan reads every folder, a restore about a sector per folder */
+static bool restored(const plist_t *plist)
+{
+	return plist->sd_reads * 4 < scanned.sd_reads;
+}
+
+static int count_entries(const char *dir, const char *prefix)
+{
+	struct fs_dir_t zdp;
+	struct fs_dirent entry;
+	int num = 0;
+
+	fs_dir_t_init(&zdp);
+	if (fs_opendir(&zdp, dir))
+		return -1;
+
+	while (!fs_readdir(&zdp, &entry) && entry.name[0]) {
+		if (!strncmp(entry.name, prefix, strlen(prefix)))
+			num++;
+	}
+
+	fs_closedir(&zdp);
+	return num;
+}
+
+static int drop_index(void)
+{
+	struct fs_dir_t zdp;
+	struct fs_dirent entry;
+	char path[32 + MAX_FILE_NAME];
+	int num = 0;
+
+	fs_dir_t_init(&zdp);
+	if (fs_opendir(&zdp, "/NOR:"))
+		return -1;
+
+	while (!fs_readdir(&zdp, &entry) && entry.name[0]) {
+		snprintf(path, sizeof(path), "/NOR:/%s", entry.name);
+		if (!strncmp(entry.name, "plist_", 6) && !fs_unlink(path))
+			num++;
+	}
+
+	fs_closedir(&zdp);
+	return num;
+}
+
+static unsigned long free_clusters(void)
+{
+	struct fs_statvfs stat;
+
+	TEST_CHECK(!fs_statvfs("/SD:", &stat));
+	return stat.f_bfree;
+}
+
+static void test_scan_and_restore(void)
+{
+	plist_read(NULL, &scanned);
+	TEST_CHECK_MSG(scanned.num == NUM_TRACKS, "%d tracks", scanned.num);
+	TEST_CHECK(plist_find(&scanned, "top_00.mp3") >= 0);
+	TEST_CHECK(plist_find(&scanned, "readme.txt") < 0 && plist_find(&scanned, ".hidden.mp3") < 0);
+
+	/* the index is on the internal volume, not in the music */
+	TEST_CHECK(count_entries("/NOR:", "plist_") == 1);
+	TEST_CHECK(count_entries("/SD:", "plist_") == 0 && count_entries("/SD:", ".plist") == 0);
+
+	plist_read(NULL, &listed);
+	TEST_CHECK(plist_equal(&scanned, &listed));
+	TEST_CHECK_MSG(restored(&listed), "reads: scan %u, restore %u",
+			scanned.sd_reads, listed.sd_reads);
+
+	printf("%d tracks, sector reads: scan %u, restore %u\n", scanned.num,
+			scanned.sd_reads, listed.sd_reads);
+}
+
+/* the track after the cursor, from the restored and from the scanned play list */
+static void test_cursor(void)
+{
+	const int positions[] = { 0, 4, 5, 100, NUM_TRACKS - SUB_TRACKS, NUM_TRACKS - 1, };
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(positions); i++) {
+		int n = positions[i];
+		int pass;
+
+		for (pass = 0; pass < 2; pass++) {
+			struct iterator *iter;
+			const char *url;
+			uint16_t track_no = 0;
+
+			/* the second pass scans */
+			if (pass)
+				TEST_CHECK(drop_index() == 1);
+
+			iter = plist_open(scanned.urls[n], &listed);
+			TEST_CHECK(iter != NULL);
+			if (!iter)
+				continue;
+
+			TEST_CHECK(pass == 1 || restored(&listed));
+
+			url = iterator_next(iter, false, &track_no);
+			TEST_CHECK_MSG(url && track_no == (n + 1) % NUM_TRACKS + 1 &&
+					!strcmp(url, scanned.urls[(n + 1) % NUM_TRACKS]),
+					"cursor at %d, pass %d: track %d %s", n + 1, pass, track_no, url);
+			iterator_destroy(iter);
+		}
+	}
+}
+
+static void test_new_track(void)
+{
+	TEST_CHECK(!write_file("/SD:/album_03/bonus.mp3", 5000));
+
+	plist_read(NULL, &listed);
+	TEST_CHECK(!restored(&listed));
+	TEST_CHECK(listed.num == NUM_TRACKS + 1 && plist_find(&listed, "bonus.mp3") >= 0);
+
+	scanned = listed;
+	plist_read(NULL, &listed);
+	TEST_CHECK_MSG(restored(&listed), "reads %u", listed.sd_reads);
+	TEST_CHECK(plist_equal(&scanned, &listed));
+}
+
+/* an empty file takes no cluster, the free space stays the same */
+static void test_empty_track(void)
+{
+	unsigned long bfree = free_clusters();
+
+	TEST_CHECK(!write_file("/SD:/album_05/e.mp3", 0));
+	TEST_CHECK_MSG(free_clusters() == bfree, "free clusters %lu, were %lu",
+			free_clusters(), bfree);
+
+	plist_read(NULL, &listed);
+	TEST_CHECK(!restored(&listed));
+	TEST_CHECK(listed.num == scanned.num + 1 && plist_find(&listed, "e.mp3") >= 0);
+
+	scanned = listed;
+}
+
+/* a track shorter in its clusters is only seen when it is read */
+static void test_stale_track(void)
+{
+	unsigned long bfree = free_clusters();
+	int n = plist_find(&scanned, "track_10.mp3");
+	struct iterator *iter;
+	const char *url;
+	char size[16];
+
+	TEST_CHECK(n >= 0);
+	TEST_CHECK(!write_file("/SD:/album_00/track_10.mp3", track_size(TOP_TRACKS + 10) - 1));
+	TEST_CHECK(free_clusters() == bfree);
+
+	iter = plist_open(NULL, &listed);
+	TEST_CHECK(iter != NULL && restored(&listed));
+	if (!iter)
+		return;
+
+	/* the dir entry is found by counting, with its new size */
+	url = iterator_set_track_no(iter, n + 1);
+	snprintf(size, sizeof(size), "/%u/", (unsigned int)track_size(TOP_TRACKS + 10) - 1);
+	TEST_CHECK_MSG(url && strstr(url, size) && strstr(url, "track_10.mp3"), "%s", url);
+	iterator_destroy(iter);
+
+	plist_read(NULL, &listed);
+	TEST_CHECK(!restored(&listed));
+	TEST_CHECK(listed.num == scanned.num && strstr(listed.urls[n], size));
+}
+
+int main(void)
+{
+	TEST_CHECK(!ram_disk_mount(RAM_DISK_NOR, NOR_SECTORS));
+	TEST_CHECK(!ram_disk_mount(RAM_DISK_SD, SD_SECTORS));
+	make_tree();
+
+	TEST_RUN(test_scan_and_restore);
+	TEST_RUN(test_cursor);
+	TEST_RUN(test_new_track);
+	TEST_RUN(test_empty_track);
+	TEST_RUN(test_stale_track);
+
+	ram_disk_unmount(RAM_DISK_SD);
+	ram_disk_unmount(RAM_DISK_NOR);
+	return TEST_RESULT();
+}
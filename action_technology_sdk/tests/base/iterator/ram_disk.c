@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * RAM disks under the FatFs volumes, in place of the disk drivers, and the
+ * OS glue FatFs takes from the target: sync objects, LFN buffers and the
+ * memory manager. The zephyr fs layer and its FatFs binding are the SDK
+ * ones, a volume is formatted at its first mount.
+ */
+
+#include <os_common_api.h>
+#include <mem_manager.h>
+#include <fs/fs.h>
+#include <ff.h>
+#include <diskio.h>
+#include "ram_disk.h"
+
+#define SECTOR_SIZE		512
+
+static const char * const mnt_points[_VOLUMES] = {
+	"/NOR:", "/NAND:", "/PSRAM:", "/USB:", "/SD:",
+};
+
+static struct {
+	uint8_t *data;
+	uint32_t sectors;
+	uint32_t reads;
+	FATFS fatfs;
+	struct fs_mount_t mount;
+} disks[_VOLUMES];
+
+static struct k_mutex volume_locks[_VOLUMES];
+
+int ram_disk_mount(int drive, uint32_t sectors)
+{
+	int res;
+
+	if (drive >= _VOLUMES || disks[drive].data)
+		return -EINVAL;
+
+	disks[drive].data = calloc(sectors, SECTOR_SIZE);
+	if (!disks[drive].data)
+		return -ENOMEM;
+
+	disks[drive].sectors = sectors;
+	disks[drive].mount.type = FS_FATFS;
+	disks[drive].mount.mnt_point = mnt_points[drive];
+	disks[drive].mount.fs_data = &disks[drive].fatfs;
+
+	res = fs_mount(&disks[drive].mount);
+	if (res) {
+		free(disks[drive].data);
+		memset(&disks[drive], 0, sizeof(disks[drive]));
+		return res;
+	}
+
+	disks[drive].reads = 0;
+	return 0;
+}
+
+int ram_disk_unmount(int drive)
+{
+	int res = fs_unmount(&disks[drive].mount);
+
+	free(disks[drive].data);
+	memset(&disks[drive], 0, sizeof(disks[drive]));
+	return res;
+}
+
+uint32_t ram_disk_reads(int drive)
+{
+	return disks[drive].reads;
+}
+
+DSTATUS disk_initialize(BYTE pdrv)
+{
+	return disk_status(pdrv);
+}
+
+DSTATUS disk_status(BYTE pdrv)
+{
+	return (pdrv < _VOLUMES && disks[pdrv].data) ? 0 : STA_NOINIT;
+}
+
+DRESULT disk_read(BYTE pdrv, BYTE *buff, DWORD sector, UINT count)
+{
+	if (disk_status(pdrv) || sector + count > disks[pdrv].sectors)
+		return RES_PARERR;
+
+	memcpy(buff, disks[pdrv].data + sector * SECTOR_SIZE, count * SECTOR_SIZE);
+	disks[pdrv].reads += count;
+	return RES_OK;
+}
+
+DRESULT disk_write(BYTE pdrv, const BYTE *buff, DWORD sector, UINT count)
+{
+	if (disk_status(pdrv) || sector + count > disks[pdrv].sectors)
+		return RES_PARERR;
+
+	memcpy(disks[pdrv].data + sector * SECTOR_SIZE, buff, count * SECTOR_SIZE);
+	return RES_OK;
+}
+
+DRESULT disk_ioctl(BYTE pdrv, BYTE cmd, void *buff)
+{
+	if (disk_status(pdrv))
+		return RES_NOTRDY;
+
+	switch (cmd) {
+	case CTRL_SYNC:
+		return RES_OK;
+	case GET_SECTOR_COUNT:
+		*(DWORD *)buff = disks[pdrv].sectors;
+		return RES_OK;
+	case GET_SECTOR_SIZE:
+		*(WORD *)buff = SECTOR_SIZE;
+		return RES_OK;
+	case GET_BLOCK_SIZE:
+		*(DWORD *)buff = 1;
+		return RES_OK;
+	case DISK_HW_DETECT:
+		*(BYTE *)buff = STA_DISK_OK;
+		return RES_OK;
+	default:
+		return RES_PARERR;
+	}
+}
+
+int ff_cre_syncobj(BYTE vol, _SYNC_t *sobj)
+{
+	k_mutex_init(&volume_locks[vol]);
+	*sobj = &volume_locks[vol];
+	return 1;
+}
+
+int ff_del_syncobj(_SYNC_t sobj)
+{
+	return 1;
+}
+
+int ff_req_grant(_SYNC_t sobj)
+{
+	return k_mutex_lock(sobj, K_FOREVER) == 0;
+}
+
+void ff_rel_grant(_SYNC_t sobj)
+{
+	k_mutex_unlock(sobj);
+}
+
+void *ff_memalloc(UINT msize)
+{
+	return malloc(msize);
+}
+
+void ff_memfree(void *mblock)
+{
+	free(mblock);
+}
+
+void *mem_malloc_debug(size_t size, const char *func)
+{
+	return calloc(1, size);
+}
+
+void mem_free(void *ptr)
+{
+	free(ptr);
+}
@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TESTS_ITERATOR_RAM_DISK_H_
+#define TESTS_ITERATOR_RAM_DISK_H_
+
+#include <stdint.h>
+
+/* drive numbers of the FatFs volume names */
+enum {
+	RAM_DISK_NOR = 0,
+	RAM_DISK_NAND,
+	RAM_DISK_PSRAM,
+	RAM_DISK_USB,
+	RAM_DISK_SD,
+};
+
+/* format a RAM disk of that many sectors and mount it, on "/SD:" for RAM_DISK_SD */
+int ram_disk_mount(int drive, uint32_t sectors);
+int ram_disk_unmount(int drive);
+
+/* sectors read from the disk since it was mounted */
+uint32_t ram_disk_reads(int drive);
+
+#endif /* TESTS_ITERATOR_RAM_DISK_H_ */
@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TESTS_ITERATOR_STUBS_DISK_ACCESS_H_
+#define TESTS_ITERATOR_STUBS_DISK_ACCESS_H_
+
+/* the RAM disks of ram_disk.c take the place of the disk drivers */
+
+#endif /* TESTS_ITERATOR_STUBS_DISK_ACCESS_H_ */
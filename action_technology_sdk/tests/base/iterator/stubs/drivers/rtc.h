@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TESTS_ITERATOR_STUBS_RTC_H_
+#define TESTS_ITERATOR_STUBS_RTC_H_
+
+/* FatFs is built with _FS_NORTC, it never reads the clock */
+
+#endif /* TESTS_ITERATOR_STUBS_RTC_H_ */
@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Trace replay of mem_malloc() through mem_pool, the heap alone against
+ * the size class front end (CONFIG_MEM_POOL_SIZE_CLASS), both on the
+ * sys_heap of the SDK.
+ *
+ * Every replay starts on a new heap. A checked pass fills each block with
+ * a pattern and verifies it at free, so the front end never hands out a
+ * block twice, then timed passes of both builds alternate. It reports the
+ * time per operation, the class hit rate and the peak heap usage.
+ *
+ * The built-in trace follows the allocations of an app: mostly short
+ * lived messages, strings and UI objects up to 256 bytes, some larger
+ * buffers, and a few long lived blocks.
+ *
+ * usage: mem_pool_bench [operations | trace]
+ *   trace lines: a <id> <size>, or f <id>
+ */
+
+#include <os_common_api.h>
+#include <kheap.h>
+#include <test_common.h>
+#include "heap.h"
+
+TEST_MAIN_DEFINE();
+
+#define MAX_IDS			(1 << 16)
+#define MAX_OPS			(4 << 20)
+#define MIN_RUN_NS		(1000 * 1000 * 1000ull)
+
+typedef struct {
+	uint32_t id : 31;
+	uint32_t is_free : 1;
+	uint32_t size;
+} trace_op_t;
+
+typedef struct {
+	const char *name;
+	void *(*malloc)(unsigned int num_bytes);
+	void (*free)(void *ptr);
+	void (*reset)(void);
+	uint32_t (*hits)(void);
+	struct sys_heap *(*heap)(void);
+} pool_ops_t;
+
+void *heap_pool_malloc(unsigned int num_bytes);
+void heap_pool_free(void *ptr);
+void heap_pool_reset(void);
+uint32_t heap_pool_hits(void);
+struct sys_heap *heap_pool_heap(void);
+
+void *class_pool_malloc(unsigned int num_bytes);
+void class_pool_free(void *ptr);
+void class_pool_reset(void);
+uint32_t class_pool_hits(void);
+struct sys_heap *class_pool_heap(void);
+
+static const pool_ops_t pools[] = {
+	{ "heap", heap_pool_malloc, heap_pool_free, heap_pool_reset,
+		heap_pool_hits, heap_pool_heap, },
+	{ "size class", class_pool_malloc, class_pool_free, class_pool_reset,
+		class_pool_hits, class_pool_heap, },
+};
+
+static trace_op_t *trace;
+static int num_ops;
+static int num_allocs;
+static void *blocks[MAX_IDS];
+static uint32_t block_sizes[MAX_IDS];
+
+void k_heap_init(struct k_heap *h, void *mem, size_t bytes)
+{
+	sys_heap_init(&h->heap, mem, bytes);
+}
+
+void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes, int timeout)
+{
+	unsigned int key = irq_lock();
+	void *ptr = sys_heap_aligned_alloc(&h->heap, align, bytes);
+
+	irq_unlock(key);
+	return ptr;
+}
+
+void k_heap_free(struct k_heap *h, void *mem)
+{
+	unsigned int key = irq_lock();
+
+	sys_heap_free(&h->heap, mem);
+	irq_unlock(key);
+}
+
+void sys_heap_dump(struct sys_heap *heap)
+{
+}
+
+static void trace_add(uint32_t id, bool is_free, uint32_t size)
+{
+	if (num_ops < MAX_OPS && id < MAX_IDS) {
+		trace[num_ops++] = (trace_op_t) { .id = id, .is_free = is_free, .size = size, };
+		num_allocs += !is_free;
+	}
+}
+
+static uint32_t trace_size(uint32_t *seed)
+{
+	int r = test_rand_range(seed, 0, 99);
+
+	if (r < 40) {
+		return test_rand_range(seed, 8, 32);
+	} else if (r < 65) {
+		return test_rand_range(seed, 33, 64);
+	} else if (r < 80) {
+		return test_rand_range(seed, 65, 128);
+	} else if (r < 90) {
+		return test_rand_range(seed, 129, 256);
+	}
+
+	return test_rand_range(seed, 257, 2048);
+}
+
+static uint32_t trace_lifetime(uint32_t *seed)
+{
+	int r = test_rand_range(seed, 0, 99);
+
+	if (r < 80) {
+		return test_rand_range(seed, 1, 16);
+	} else if (r < 98) {
+		return test_rand_range(seed, 16, 128);
+	}
+
+	return test_rand_range(seed, 500, 5000);
+}
+
+/* an allocation per step, each freed at the end of its lifetime */
+static void trace_build(int num_steps)
+{
+	int *free_head = malloc(sizeof(int) * (num_steps + 1));
+	int *free_next = malloc(sizeof(int) * MAX_IDS);
+	int free_id_top = 0, *free_ids = malloc(sizeof(int) * MAX_IDS);
+	uint32_t seed = 0x3e3e0032u;
+	int t, id;
+
+	for (t = 0; t <= num_steps; t++) {
+		free_head[t] = -1;
+	}
+	for (id = MAX_IDS - 1; id >= 0; id--) {
+		free_ids[free_id_top++] = id;
+	}
+
+	for (t = 0; t < num_steps; t++) {
+		uint32_t end;
+
+		if (free_id_top > 0) {
+			id = free_ids[--free_id_top];
+			trace_add(id, false, trace_size(&seed));
+
+			end = t + trace_lifetime(&seed);
+			end = MIN(end, (uint32_t)num_steps);
+			free_next[id] = free_head[end];
+			free_head[end] = id;
+		}
+
+		for (id = free_head[t + 1]; id >= 0; id = free_next[id]) {
+			trace_add(id, true, 0);
+			free_ids[free_id_top++] = id;
+		}
+	}
+
+	free(free_ids);
+	free(free_next);
+	free(free_head);
+}
+
+static int trace_load(const char *path)
+{
+	FILE *fp = fopen(path, "r");
+	unsigned int id, size;
+	char op;
+
+	if (fp == NULL) {
+		return -errno;
+	}
+
+	while (fscanf(fp, " %c %u", &op, &id) == 2) {
+		if (op == 'a' && fscanf(fp, "%u", &size) == 1) {
+			trace_add(id, false, size);
+		} else if (op == 'f') {
+			trace_add(id, true, 0);
+		}
+	}
+
+	fclose(fp);
+	return 0;
+}
+
+static uint8_t pattern(uint32_t id)
+{
+	return (uint8_t)(id * 31 + 7);
+}
+
+/* return the number of failed allocations, and of corrupted blocks if checked */
+static int replay(const pool_ops_t *pool, bool check, int *corrupted)
+{
+	int i, failed = 0;
+
+	pool->reset();
+
+	for (i = 0; i < num_ops; i++) {
+		const trace_op_t *op = &trace[i];
+
+		if (!op->is_free) {
+			blocks[op->id] = pool->malloc(op->size);
+			block_sizes[op->id] = op->size;
+			if (blocks[op->id] == NULL) {
+				failed++;
+			} else if (check) {
+				memset(blocks[op->id], pattern(op->id), op->size);
+			}
+			continue;
+		}
+
+		if (blocks[op->id] == NULL) {
+			continue;
+		}
+
+		if (check) {
+			uint8_t *p = blocks[op->id];
+
+			for (uint32_t n = 0; n < block_sizes[op->id]; n++) {
+				if (p[n] != pattern(op->id)) {
+					(*corrupted)++;
+					break;
+				}
+			}
+		}
+
+		pool->free(blocks[op->id]);
+		blocks[op->id] = NULL;
+	}
+
+	/* blocks of a loaded trace never freed */
+	for (i = 0; i < MAX_IDS; i++) {
+		if (blocks[i]) {
+			pool->free(blocks[i]);
+			blocks[i] = NULL;
+		}
+	}
+
+	return failed;
+}
+
+static uint32_t peak_bytes(const pool_ops_t *pool)
+{
+	struct z_heap *h = pool->heap()->heap;
+
+	return heap_get_stats(h)->peak_chunks * CHUNK_UNIT;
+}
+
+int main(int argc, char *argv[])
+{
+	uint64_t best[ARRAY_SIZE(pools)], total = 0;
+	int i;
+
+	trace = malloc(sizeof(*trace) * MAX_OPS);
+
+	if (argc > 1 && atoi(argv[1]) == 0) {
+		if (trace_load(argv[1])) {
+			printf("cannot read %s\n", argv[1]);
+			return EXIT_FAILURE;
+		}
+	} else {
+		trace_build((argc > 1) ? atoi(argv[1]) : 1000000);
+	}
+
+	printf("%d operations, %d allocations, pool %d bytes\n", num_ops, num_allocs,
+			CONFIG_RAM_POOL_PAGE_NUM * 2048);
+
+	for (i = 0; i < ARRAY_SIZE(pools); i++) {
+		int corrupted = 0;
+		int failed = replay(&pools[i], true, &corrupted);
+
+		TEST_CHECK_MSG(failed == 0, "%s: %d allocations failed", pools[i].name, failed);
+		TEST_CHECK_MSG(corrupted == 0, "%s: %d blocks corrupted", pools[i].name, corrupted);
+		best[i] = UINT64_MAX;
+	}
+
+	/* alternate the builds, so both see the same host load */
+	while (total < MIN_RUN_NS) {
+		for (i = 0; i < ARRAY_SIZE(pools); i++) {
+			uint64_t t0 = test_time_ns(), t;
+
+			replay(&pools[i], false, NULL);
+			t = test_time_ns() - t0;
+			best[i] = MIN(best[i], t);
+			total += t;
+		}
+	}
+
+	for (i = 0; i < ARRAY_SIZE(pools); i++) {
+		printf("%-10s %6.1f ns/op, hits %5.1f%%, heap peak %u bytes\n", pools[i].name,
+				(double)best[i] / MAX(num_ops, 1),
+				pools[i].hits() * 100.0 / MAX(num_allocs, 1), peak_bytes(&pools[i]));
+	}
+
+	printf("size class speedup %.2fx\n", (double)best[0] / best[1]);
+
+	free(trace);
+	return TEST_RESULT();
+}
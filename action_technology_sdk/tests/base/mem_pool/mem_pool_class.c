@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * mem_pool.c with the size class front end (CONFIG_MEM_POOL_SIZE_CLASS),
+ * under the class_ prefix so the benchmark links it with the heap build.
+ */
+
+#ifndef CONFIG_MEM_POOL_SIZE_CLASS
+#define CONFIG_MEM_POOL_SIZE_CLASS
+#endif
+
+#define mem_pool_malloc_nozero	class_pool_malloc_nozero
+#define mem_pool_malloc			class_pool_malloc
+#define mem_pool_free			class_pool_free
+#define mem_pool_dump			class_pool_dump
+#define mem_pool_init			class_pool_init
+#define sys_mem_pool			class_sys_mem_pool
+
+#include "mem_pool.c"
+
+struct sys_heap *class_pool_heap(void)
+{
+	return &sys_mem_pool.heap;
+}
+
+uint32_t class_pool_hits(void)
+{
+	uint32_t hits = 0;
+
+	for (int i = 0; i < MEM_POOL_NUM_CLASSES; i++) {
+		hits += mem_pool_classes[i].hit_cnt;
+	}
+
+	return hits;
+}
+
+/* a new heap, so drop the cached blocks and statistics of the last one */
+void class_pool_reset(void)
+{
+	for (int i = 0; i < MEM_POOL_NUM_CLASSES; i++) {
+		struct mem_pool_class *sc = &mem_pool_classes[i];
+
+		sc->free_list = NULL;
+		sc->free_cnt = 0;
+		sc->alloc_cnt = 0;
+		sc->hit_cnt = 0;
+		sc->busy_cnt = 0;
+	}
+
+	memset(&mem_pool_stats, 0, sizeof(mem_pool_stats));
+	mem_pool_init();
+}
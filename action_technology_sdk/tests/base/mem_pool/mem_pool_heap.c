@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * mem_pool.c without the size class front end, every block from the heap,
+ * under the heap_ prefix so the benchmark links it with the class build.
+ */
+
+#undef CONFIG_MEM_POOL_SIZE_CLASS
+
+#define mem_pool_malloc_nozero	heap_pool_malloc_nozero
+#define mem_pool_malloc			heap_pool_malloc
+#define mem_pool_free			heap_pool_free
+#define mem_pool_dump			heap_pool_dump
+#define mem_pool_init			heap_pool_init
+#define sys_mem_pool			heap_sys_mem_pool
+
+#include "mem_pool.c"
+
+struct sys_heap *heap_pool_heap(void)
+{
+	return &sys_mem_pool.heap;
+}
+
+uint32_t heap_pool_hits(void)
+{
+	return 0;
+}
+
+void heap_pool_reset(void)
+{
+	mem_pool_init();
+}
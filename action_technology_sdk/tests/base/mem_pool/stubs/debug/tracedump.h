@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Host stand-in of the trace dump, disabled as without
+ *        CONFIG_DEBUG_TRACEDUMP
+ */
+
+#ifndef TESTS_BASE_STUBS_DEBUG_TRACEDUMP_H_
+#define TESTS_BASE_STUBS_DEBUG_TRACEDUMP_H_
+
+enum {
+	TRACE_NULL = 0,
+	TRACE_HEAP = (1 << 0),
+	TRACE_HEAP_LEAK = (1 << 1),
+	TRACE_WAKELOCK = (1 << 2),
+};
+
+#define tracedump_get_enable(x)		(0)
+#define tracedump_save(x, y, z)		do { } while (0)
+#define tracedump_remove(x, y)		do { } while (0)
+#define tracedump_lock()			do { } while (0)
+#define tracedump_unlock()			do { } while (0)
+
+#endif /* TESTS_BASE_STUBS_DEBUG_TRACEDUMP_H_ */
@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Host k_heap of the mem_pool benchmark, as the simulator kheap.h:
+ *        the sys_heap of the SDK under the interrupt lock
+ */
+
+#ifndef TESTS_BASE_STUBS_KHEAP_H_
+#define TESTS_BASE_STUBS_KHEAP_H_
+
+#include <sys/sys_heap.h>
+
+struct k_heap {
+	struct sys_heap heap;
+};
+
+void k_heap_init(struct k_heap *h, void *mem, size_t bytes);
+void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes, int timeout);
+void k_heap_free(struct k_heap *h, void *mem);
+
+#endif /* TESTS_BASE_STUBS_KHEAP_H_ */
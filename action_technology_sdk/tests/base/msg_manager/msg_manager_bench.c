@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Send and receive cost of the per-receiver message queues.
+ *
+ * The receiver is registered last of CONFIG_MSG_MANAGER_MAX_RECEIVERS
+ * listeners, the worst case of the name lookup. One thread sends to itself
+ * and receives at once:
+ *   by name     msg_manager_send_async_msg(), the handle cached by name
+ *   lookup      msg_manager_get_handle() on every send, the list walk the
+ *               name cache saves
+ *   by handle   msg_manager_send_async_msg_by_handle()
+ * then two threads bounce a message by name, a full round trip with two
+ * wakeups.
+ *
+ * usage: msg_manager_bench [messages]
+ */
+
+#include <os_common_api.h>
+#include <msg_manager.h>
+#include <test_common.h>
+
+TEST_MAIN_DEFINE();
+
+#define MIN_RUN_NS		(300 * 1000 * 1000ull)
+
+#define FAKE_TID(n)		((os_tid_t)(uintptr_t)(0x1000 + (n)))
+
+enum {
+	SEND_BY_NAME,
+	SEND_LOOKUP,
+	SEND_BY_HANDLE,
+
+	NUM_SEND_MODES,
+};
+
+static const char *mode_names[NUM_SEND_MODES] = {
+	"by name", "lookup", "by handle",
+};
+
+static char rx_name[] = "bench_rx";
+static msg_handle_t rx_handle;
+
+static int send_receive_pass(int mode, int num)
+{
+	struct app_msg msg = { .type = MSG_APP_MESSAGE_START, };
+	int i, num_ok = 0;
+
+	for (i = 0; i < num; i++) {
+		bool sent;
+
+		msg.value = i;
+		switch (mode) {
+		case SEND_BY_NAME:
+			sent = msg_manager_send_async_msg(rx_name, &msg);
+			break;
+		case SEND_LOOKUP:
+			sent = msg_manager_send_async_msg_by_handle(msg_manager_get_handle(rx_name),
+					&msg, MSG_LANE_NORMAL);
+			break;
+		default:
+			sent = msg_manager_send_async_msg_by_handle(rx_handle, &msg, MSG_LANE_NORMAL);
+			break;
+		}
+
+		if (sent && msg_manager_receive_msg(&msg, 0) && msg.value == i) {
+			num_ok++;
+		}
+	}
+
+	return num_ok;
+}
+
+static void bench_send_receive(int num)
+{
+	uint64_t best[NUM_SEND_MODES], total = 0;
+	int mode;
+
+	for (mode = 0; mode < NUM_SEND_MODES; mode++) {
+		best[mode] = UINT64_MAX;
+	}
+
+	/* alternate the modes, so all of them see the same host load */
+	while (total < MIN_RUN_NS) {
+		for (mode = 0; mode < NUM_SEND_MODES; mode++) {
+			uint64_t t0 = test_time_ns(), t;
+			int num_ok = send_receive_pass(mode, num);
+
+			t = test_time_ns() - t0;
+			TEST_CHECK_MSG(num_ok == num, "%s: %d of %d", mode_names[mode], num_ok, num);
+			best[mode] = MIN(best[mode], t);
+			total += t;
+		}
+	}
+
+	for (mode = 0; mode < NUM_SEND_MODES; mode++) {
+		printf("send+receive %-10s %7.1f ns/msg\n", mode_names[mode],
+				(double)best[mode] / num);
+	}
+
+	/* the cached name costs about what the handle does, not the walk */
+	TEST_CHECK(best[SEND_BY_NAME] < best[SEND_LOOKUP]);
+}
+
+static os_sem echo_ready;
+
+static void *echo_thread(void *arg)
+{
+	struct app_msg msg;
+
+	msg_manager_add_listener("bench_echo", os_current_get());
+	os_sem_give(&echo_ready);
+
+	while (msg_manager_receive_msg(&msg, OS_FOREVER) && msg.type != MSG_EXIT_APP) {
+		msg_manager_send_async_msg(rx_name, &msg);
+	}
+
+	msg_manager_remove_listener("bench_echo");
+	return NULL;
+}
+
+static void bench_round_trip(int num)
+{
+	struct app_msg msg = { .type = MSG_APP_MESSAGE_START, };
+	pthread_t thread;
+	uint64_t t0;
+	int i, num_ok = 0;
+
+	os_sem_init(&echo_ready, 0, 1);
+	pthread_create(&thread, NULL, echo_thread, NULL);
+	os_sem_take(&echo_ready, OS_FOREVER);
+
+	t0 = test_time_ns();
+	for (i = 0; i < num; i++) {
+		msg.value = i;
+		if (msg_manager_send_async_msg("bench_echo", &msg) &&
+			msg_manager_receive_msg(&msg, 1000) && msg.value == i) {
+			num_ok++;
+		}
+	}
+
+	printf("round trip by name      %7.1f ns/msg\n", (double)(test_time_ns() - t0) / num);
+	TEST_CHECK_MSG(num_ok == num, "round trip: %d of %d", num_ok, num);
+
+	msg.type = MSG_EXIT_APP;
+	msg_manager_send_async_msg("bench_echo", &msg);
+	pthread_join(thread, NULL);
+}
+
+int main(int argc, char *argv[])
+{
+	int num = (argc > 1) ? atoi(argv[1]) : 100000;
+	int i;
+
+	msg_manager_init();
+
+	/* the echo thread takes the last receiver of the round trip */
+	for (i = 0; i < CONFIG_MSG_MANAGER_MAX_RECEIVERS - 2; i++) {
+		char *name = malloc(16);
+
+		snprintf(name, 16, "app%d", i);
+		msg_manager_add_listener(name, FAKE_TID(i));
+	}
+	msg_manager_add_listener(rx_name, os_current_get());
+	rx_handle = msg_manager_get_handle(rx_name);
+
+	bench_send_receive(num);
+	bench_round_trip(num / 10);
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Message manager with per-receiver queues (CONFIG_MSG_MANAGER_QUEUE):
+ * order and lanes of one receiver, ALL_RECEIVER_NAME delivery, the name
+ * to handle cache across listener removal, and a round trip between two
+ * threads sending by name.
+ */
+
+#include <os_common_api.h>
+#include <srv_manager.h>
+#include <msg_manager.h>
+#include <test_common.h>
+
+TEST_MAIN_DEFINE();
+
+#define ROUND_TRIPS		(20000)
+
+/* listeners on threads that never receive, told apart by their tid */
+#define FAKE_TID(n)		((os_tid_t)(uintptr_t)(0x1000 + (n)))
+
+static struct app_msg make_msg(uint8_t type, int value)
+{
+	struct app_msg msg = { .type = type, .value = value, };
+
+	return msg;
+}
+
+static uint32_t posted(const char *name)
+{
+	struct msg_receiver_stats stats;
+
+	if (msg_manager_get_receiver_stats(msg_manager_get_handle(name), &stats)) {
+		return UINT32_MAX;
+	}
+	return stats.posted;
+}
+
+static void test_order_and_lanes(void)
+{
+	struct app_msg msg;
+	int i;
+
+	TEST_CHECK(msg_manager_add_listener("self", os_current_get()));
+
+	for (i = 0; i < 4; i++) {
+		msg = make_msg(MSG_APP_MESSAGE_START, i);
+		TEST_CHECK(msg_manager_send_async_msg("self", &msg));
+	}
+
+	/* discardable messages go ahead of the normal ones, once each */
+	msg = make_msg(MSG_KEY_INPUT, 100);
+	TEST_CHECK(msg_manager_send_async_msg_discardable("self", &msg));
+	TEST_CHECK(msg_manager_send_async_msg_discardable("self", &msg));
+	TEST_CHECK(msg_manager_get_pending_msg_cnt() == 5);
+
+	TEST_CHECK(msg_manager_receive_msg(&msg, 0));
+	TEST_CHECK(msg.type == MSG_KEY_INPUT && msg.value == 100);
+
+	for (i = 0; i < 4; i++) {
+		TEST_CHECK(msg_manager_receive_msg(&msg, 0));
+		TEST_CHECK(msg.type == MSG_APP_MESSAGE_START && msg.value == i);
+	}
+
+	TEST_CHECK(!msg_manager_receive_msg(&msg, 0));
+	TEST_CHECK(msg_manager_remove_listener("self"));
+}
+
+static void test_priority_restored(void)
+{
+	struct app_msg msg = make_msg(MSG_APP_MESSAGE_START, 0);
+
+	TEST_CHECK(msg_manager_add_listener("self", os_current_get()));
+
+	os_thread_priority_set(os_current_get(), 7);
+	TEST_CHECK(msg_manager_send_async_msg("self", &msg));
+	TEST_CHECK(!msg_manager_send_async_msg("nobody", &msg));
+	TEST_CHECK(os_thread_priority_get(os_current_get()) == 7);
+
+	msg_manager_drop_all_msg();
+	TEST_CHECK(msg_manager_remove_listener("self"));
+	os_thread_priority_set(os_current_get(), 0);
+}
+
+/* "all" goes to one receiver, as from the global mailbox, not to each */
+static void test_all_receivers(void)
+{
+	static char *names[] = { "a", "b", "c", };
+	struct app_msg msg = make_msg(MSG_APP_MESSAGE_START, 0);
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(names); i++) {
+		TEST_CHECK(msg_manager_add_listener(names[i], FAKE_TID(i)));
+	}
+
+	for (i = 0; i < 6; i++) {
+		TEST_CHECK(msg_manager_send_async_msg(ALL_RECEIVER_NAME, &msg));
+	}
+
+	/* the least loaded receiver takes each message */
+	for (i = 0; i < ARRAY_SIZE(names); i++) {
+		TEST_CHECK_MSG(posted(names[i]) == 2, "%s posted %u", names[i], posted(names[i]));
+	}
+
+	msg_manager_drop_all_msg();
+	for (i = 0; i < ARRAY_SIZE(names); i++) {
+		TEST_CHECK(msg_manager_remove_listener(names[i]));
+	}
+
+	TEST_CHECK(!msg_manager_send_async_msg(ALL_RECEIVER_NAME, &msg));
+}
+
+static void test_name_cache(void)
+{
+	struct app_msg msg = make_msg(MSG_APP_MESSAGE_START, 0);
+	char name[8] = "x";
+
+	TEST_CHECK(msg_manager_add_listener("x", FAKE_TID(0)));
+	TEST_CHECK(msg_manager_add_listener("y", FAKE_TID(1)));
+
+	TEST_CHECK(msg_manager_send_async_msg("x", &msg));
+	TEST_CHECK(msg_manager_send_async_msg("x", &msg));
+	TEST_CHECK(posted("x") == 2);
+
+	/* a buffer reused for another name must not hit the cached handle */
+	TEST_CHECK(msg_manager_send_async_msg(name, &msg));
+	strcpy(name, "y");
+	TEST_CHECK(msg_manager_send_async_msg(name, &msg));
+	TEST_CHECK(posted("x") == 3 && posted("y") == 1);
+
+	/* the cached handle of a removed receiver is stale */
+	TEST_CHECK(msg_manager_remove_listener("x"));
+	TEST_CHECK(!msg_manager_send_async_msg("x", &msg));
+
+	TEST_CHECK(msg_manager_add_listener("x", FAKE_TID(2)));
+	TEST_CHECK(msg_manager_send_async_msg("x", &msg));
+	TEST_CHECK(posted("x") == 1);
+
+	msg_manager_drop_all_msg();
+	TEST_CHECK(msg_manager_remove_listener("x"));
+	TEST_CHECK(msg_manager_remove_listener("y"));
+}
+
+static os_sem echo_ready;
+
+/* send every message back to "ping" with the value incremented */
+static void *echo_thread(void *arg)
+{
+	struct app_msg msg;
+
+	msg_manager_add_listener("pong", os_current_get());
+	os_sem_give(&echo_ready);
+
+	while (msg_manager_receive_msg(&msg, OS_FOREVER)) {
+		if (msg.type == MSG_EXIT_APP) {
+			break;
+		}
+		msg.value++;
+		msg_manager_send_async_msg("ping", &msg);
+	}
+
+	msg_manager_remove_listener("pong");
+	return NULL;
+}
+
+static void test_round_trip(void)
+{
+	struct msg_receiver_stats stats;
+	struct app_msg msg;
+	pthread_t thread;
+	int i, errors = 0;
+
+	os_sem_init(&echo_ready, 0, 1);
+	TEST_CHECK(msg_manager_add_listener("ping", os_current_get()));
+	pthread_create(&thread, NULL, echo_thread, NULL);
+	os_sem_take(&echo_ready, OS_FOREVER);
+
+	for (i = 0; i < ROUND_TRIPS; i++) {
+		msg = make_msg(MSG_APP_MESSAGE_START, i * 2);
+		if (!msg_manager_send_async_msg("pong", &msg) ||
+			!msg_manager_receive_msg(&msg, 1000) || msg.value != i * 2 + 1) {
+			errors++;
+		}
+	}
+
+	TEST_CHECK_MSG(errors == 0, "%d of %d round trips failed", errors, ROUND_TRIPS);
+	TEST_CHECK(msg_manager_get_receiver_stats(msg_manager_get_handle("ping"), &stats) == 0);
+	TEST_CHECK(stats.received == ROUND_TRIPS && stats.dropped == 0 && stats.depth == 0);
+
+	msg = make_msg(MSG_EXIT_APP, 0);
+	msg_manager_send_async_msg("pong", &msg);
+	pthread_join(thread, NULL);
+
+	TEST_CHECK(msg_manager_remove_listener("ping"));
+	TEST_CHECK(msg_manager_get_free_msg_num() == CONFIG_MSG_MANAGER_NUM_SLOTS);
+}
+
+int main(void)
+{
+	msg_manager_init();
+
+	TEST_RUN(test_order_and_lanes);
+	TEST_RUN(test_priority_restored);
+	TEST_RUN(test_all_receivers);
+	TEST_RUN(test_name_cache);
+	TEST_RUN(test_round_trip);
+
+	return TEST_RESULT();
+}
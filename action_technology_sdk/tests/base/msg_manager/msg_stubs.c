@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Memory manager and global mailbox of the message manager tests. With
+ * CONFIG_MSG_MANAGER_QUEUE every listener has its own queue, so the
+ * mailbox is never used and stays empty.
+ */
+
+#include <os_common_api.h>
+#include <mem_manager.h>
+
+void *mem_malloc_debug(size_t size, const char *func)
+{
+	return calloc(1, size);
+}
+
+void mem_free(void *ptr)
+{
+	free(ptr);
+}
+
+void os_msg_init(void)
+{
+}
+
+void os_msg_clean(void)
+{
+}
+
+int os_send_async_msg(void *receiver, void *msg, int msg_size)
+{
+	return -ENOENT;
+}
+
+int os_send_async_msg_discardable(void *receiver, void *msg, int msg_size)
+{
+	return -ENOENT;
+}
+
+int os_receive_msg(void *msg, int msg_size, int timeout)
+{
+	if (timeout > 0) {
+		k_msleep(timeout);
+	}
+	return -ETIMEDOUT;
+}
+
+int os_poll_msg(void *msg, int msg_size, os_sem *sem, int timeout)
+{
+	return os_receive_msg(msg, msg_size, timeout) ? OS_POLL_TIMEOUT : OS_POLL_MSG;
+}
+
+int os_get_pending_msg_cnt(void)
+{
+	return 0;
+}
+
+int msg_pool_get_free_msg_num(void)
+{
+	return 0;
+}
+
+void msg_pool_dump(void(*dump_fn)(os_tid_t sender, os_tid_t receiver,
+		const char *content, int max_size))
+{
+}
@@ -0,0 +1,394 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Throughput of the streams of framework/base/utils/stream, and the wakeups
+ * of a blocked reader.
+ *
+ * A producer makes each chunk from a source pattern, through
+ * ringbuff_stream, bufferstream and clonestream (one ringbuff clone, drained
+ * as well):
+ *   copy    the chunk made in a buffer, stream_write(), stream_read() to a
+ *           buffer
+ *   claim   made in place by stream_write_claim/commit(), taken in place by
+ *           stream_read_claim/commit()
+ * A first pass of each checks the data, the timed passes only move it. The
+ * host copies a 512 bytes chunk in less time than the two more calls of the
+ * claim path take, the ratio weighs that call cost against the copy saved.
+ *
+ * Then stream_read() of a ringbuff stream with a ringbuff stream attached,
+ * teed from the region of the origin and drained, against no attachment.
+ *
+ * Last a producer thread writes 64 bytes every 100 us to a MODE_READ_BLOCK
+ * stream read by 1 KB: the reader must wake once per read, not once per
+ * write, and not wait on the 50 ms poll.
+ *
+ * usage: stream_bench [megabytes]
+ */
+
+#include <os_common_api.h>
+#include <stream.h>
+#include <ringbuff_stream.h>
+#include <buffer_stream.h>
+#include <clone_stream.h>
+#include <acts_ringbuf.h>
+#include <test_common.h>
+
+TEST_MAIN_DEFINE();
+
+#define BUF_SIZE		(4096)
+#define CHUNK_SIZE		(512)
+#define MIN_RUN_NS		(200 * 1000 * 1000ull)
+
+#define TRICKLE_SIZE	(64)
+#define TRICKLE_US		(100)
+#define BLOCK_SIZE		(1024)
+#define BLOCK_READS		(200)
+
+enum {
+	STREAM_RINGBUFF,
+	STREAM_BUFFER,
+	STREAM_CLONE,
+
+	NUM_STREAM_TYPES,
+};
+
+static const char *type_names[NUM_STREAM_TYPES] = {
+	"ringbuff", "buffer", "clone",
+};
+
+static uint8_t source[BUF_SIZE];
+static char buffer_mem[BUF_SIZE] __aligned(4);
+static char ring_mem[2][BUF_SIZE] __aligned(4);
+static struct acts_ringbuf rings[2];
+
+/* sem takes of stream.c, each is a wait or a wakeup of a blocked stream */
+static volatile int sem_takes;
+
+int __real_k_sem_take(struct k_sem *sem, k_timeout_t timeout);
+
+int __wrap_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
+{
+	sem_takes++;
+	return __real_k_sem_take(sem, timeout);
+}
+
+void *mem_malloc_debug(size_t size, const char *func)
+{
+	return calloc(1, size);
+}
+
+void mem_free(void *ptr)
+{
+	free(ptr);
+}
+
+static io_stream_t ring_open(int n, int mode)
+{
+	io_stream_t stream;
+
+	acts_ringbuf_init(&rings[n], ring_mem[n], BUF_SIZE);
+	stream = ringbuff_stream_create(&rings[n]);
+	TEST_CHECK(stream && !stream_open(stream, mode));
+	return stream;
+}
+
+/* the stream of a type, and its clone if any */
+static io_stream_t type_open(int type, io_stream_t *clone)
+{
+	struct buffer_t buffer = { .length = BUF_SIZE, .base = buffer_mem, };
+	struct clone_stream_info info = { .clone_mode = MODE_OUT, };
+	io_stream_t stream;
+
+	*clone = NULL;
+
+	switch (type) {
+	case STREAM_RINGBUFF:
+		return ring_open(0, MODE_IN_OUT);
+	case STREAM_BUFFER:
+		stream = buffer_stream_create(&buffer);
+		TEST_CHECK(stream && !stream_open(stream, MODE_IN_OUT));
+		return stream;
+	default:
+		info.clones[0] = *clone = ring_open(1, MODE_IN_OUT);
+		acts_ringbuf_init(&rings[0], ring_mem[0], BUF_SIZE);
+		info.origin = ringbuff_stream_create(&rings[0]);
+		stream = clone_stream_create(&info);
+		TEST_CHECK(stream && !stream_open(stream, MODE_IN_OUT));
+		return stream;
+	}
+}
+
+static void type_close(io_stream_t stream, io_stream_t clone)
+{
+	stream_close(stream);
+	stream_destroy(stream);
+	if (clone) {
+		stream_close(clone);
+		stream_destroy(clone);
+	}
+}
+
+static uint32_t sum(const uint8_t *buf, int len)
+{
+	uint32_t s = 0;
+	int i;
+
+	for (i = 0; i < len; i++)
+		s += buf[i];
+
+	return s;
+}
+
+static uint32_t drain_clone(io_stream_t clone, uint8_t *buf, bool verify)
+{
+	int len;
+
+	if (!clone)
+		return 0;
+
+	len = stream_read(clone, buf, CHUNK_SIZE);
+	return verify ? sum(buf, MAX(len, 0)) : 0;
+}
+
+/* sum of the data read and of the clone, if verify */
+static uint32_t pass_copy(io_stream_t stream, io_stream_t clone, int chunks, bool verify)
+{
+	static uint8_t made[CHUNK_SIZE], got[CHUNK_SIZE];
+	uint32_t s = 0;
+	int i, off = 0;
+
+	for (i = 0; i < chunks; i++) {
+		memcpy(made, &source[off], CHUNK_SIZE);
+		off = (off + CHUNK_SIZE) % BUF_SIZE;
+
+		stream_write(stream, made, CHUNK_SIZE);
+		if ((stream_read(stream, got, CHUNK_SIZE) == CHUNK_SIZE) && verify)
+			s += sum(got, CHUNK_SIZE);
+		s += drain_clone(clone, got, verify);
+	}
+
+	return s;
+}
+
+static uint32_t pass_claim(io_stream_t stream, io_stream_t clone, int chunks, bool verify)
+{
+	static uint8_t got[CHUNK_SIZE];
+	uint32_t s = 0;
+	void *region;
+	int i, len, done, off = 0;
+
+	for (i = 0; i < chunks; i++) {
+		/* in two parts if the region wraps */
+		for (done = 0; done < CHUNK_SIZE; done += len) {
+			len = stream_write_claim(stream, &region, CHUNK_SIZE - done);
+			if (len <= 0)
+				break;
+			memcpy(region, &source[off + done], len);
+			stream_write_commit(stream, len);
+		}
+		off = (off + CHUNK_SIZE) % BUF_SIZE;
+
+		/* the consumer takes the region in place, as dma would */
+		for (done = 0; done < CHUNK_SIZE; done += len) {
+			len = stream_read_claim(stream, &region, CHUNK_SIZE - done);
+			if (len <= 0)
+				break;
+			if (verify)
+				s += sum(region, len);
+			stream_read_commit(stream, len);
+		}
+		s += drain_clone(clone, got, verify);
+	}
+
+	return s;
+}
+
+static void bench_types(int chunks)
+{
+	uint32_t expect = sum(source, BUF_SIZE) * (uint32_t)(chunks / (BUF_SIZE / CHUNK_SIZE));
+	int type;
+
+	for (type = 0; type < NUM_STREAM_TYPES; type++) {
+		uint64_t best[2] = { UINT64_MAX, UINT64_MAX, }, total = 0;
+		io_stream_t stream, clone;
+		uint32_t s;
+
+		stream = type_open(type, &clone);
+		if (!stream)
+			continue;
+
+		if (clone)
+			expect *= 2;
+
+		s = pass_copy(stream, clone, chunks, true);
+		TEST_CHECK_MSG(s == expect, "%s copy: sum %u, expected %u", type_names[type], s, expect);
+		s = pass_claim(stream, clone, chunks, true);
+		TEST_CHECK_MSG(s == expect, "%s claim: sum %u, expected %u", type_names[type], s, expect);
+
+		/* alternate the paths, so both see the same host load */
+		while (total < MIN_RUN_NS) {
+			uint64_t t0 = test_time_ns(), t;
+
+			pass_copy(stream, clone, chunks, false);
+			t = test_time_ns() - t0;
+			best[0] = MIN(best[0], t);
+			total += t;
+
+			t0 = test_time_ns();
+			pass_claim(stream, clone, chunks, false);
+			t = test_time_ns() - t0;
+			best[1] = MIN(best[1], t);
+			total += t;
+		}
+
+		printf("%-10s copy %7.1f MB/s, claim %7.1f MB/s, %.2fx\n", type_names[type],
+				(double)chunks * CHUNK_SIZE * 1000 / best[0],
+				(double)chunks * CHUNK_SIZE * 1000 / best[1],
+				(double)best[0] / best[1]);
+
+		type_close(stream, clone);
+	}
+}
+
+/* stream_read() teed to an attached stream, against none */
+static void bench_tee(int chunks)
+{
+	static uint8_t got[CHUNK_SIZE], tail[BUF_SIZE];
+	uint64_t best[2] = { UINT64_MAX, UINT64_MAX, }, total = 0;
+	io_stream_t origin = ring_open(0, MODE_IN_OUT);
+	io_stream_t attached = ring_open(1, MODE_IN_OUT);
+	uint32_t expect = sum(source, BUF_SIZE) * (uint32_t)(chunks / (BUF_SIZE / CHUNK_SIZE));
+	int i, pass, len, off;
+
+	if (!origin || !attached)
+		return;
+
+	while (total < MIN_RUN_NS) {
+		for (pass = 0; pass < 2; pass++) {
+			uint64_t t0;
+			uint32_t s = 0, s_attached = 0;
+
+			if (pass)
+				TEST_CHECK(!stream_attach(origin, attached, MODE_IN));
+
+			t0 = test_time_ns();
+			for (i = 0, off = 0; i < chunks; i++) {
+				stream_write(origin, &source[off], CHUNK_SIZE);
+				off = (off + CHUNK_SIZE) % BUF_SIZE;
+				if (stream_read(origin, got, CHUNK_SIZE) == CHUNK_SIZE)
+					s += sum(got, CHUNK_SIZE);
+				if (pass) {
+					len = stream_read(attached, got, CHUNK_SIZE);
+					s_attached += sum(got, MAX(len, 0));
+				}
+			}
+			best[pass] = MIN(best[pass], test_time_ns() - t0);
+			total += test_time_ns() - t0;
+
+			TEST_CHECK_MSG(s == expect, "read sum %u, expected %u", s, expect);
+			if (pass) {
+				TEST_CHECK_MSG(s_attached == s, "attached sum %u, read %u", s_attached, s);
+				stream_detach(origin, attached);
+			}
+		}
+	}
+
+	printf("read       plain %6.1f MB/s, teed %6.1f MB/s\n",
+			(double)chunks * CHUNK_SIZE * 1000 / best[0],
+			(double)chunks * CHUNK_SIZE * 1000 / best[1]);
+
+	/* only the bytes read are teed, a short read of ringbuff reads none */
+	stream_attach(origin, attached, MODE_IN);
+	stream_write(origin, source, BUF_SIZE - 100);
+	stream_read(origin, tail, BUF_SIZE - 200);
+	stream_read(attached, tail, BUF_SIZE - 200);
+	stream_write(origin, source, 300);
+	TEST_CHECK(stream_read(origin, tail, CHUNK_SIZE) == 0);
+	TEST_CHECK_MSG(stream_get_length(attached) == 0, "teed %d of none read",
+			stream_get_length(attached));
+
+	/* across the wrap */
+	len = stream_read(origin, tail, 400);
+	TEST_CHECK(len == 400 && stream_get_length(attached) == len);
+	TEST_CHECK(stream_read(attached, tail + len, len) == len && !memcmp(tail, tail + len, len));
+
+	stream_detach(origin, attached);
+	type_close(origin, attached);
+}
+
+static io_stream_t trickle_stream;
+static volatile bool trickle_stop;
+static volatile uint64_t trickle_last_ns;
+
+static void *trickle_thread(void *arg)
+{
+	int off = 0;
+
+	while (!trickle_stop) {
+		if (stream_get_space(trickle_stream) >= TRICKLE_SIZE) {
+			trickle_last_ns = test_time_ns();
+			stream_write(trickle_stream, &source[off], TRICKLE_SIZE);
+			off = (off + TRICKLE_SIZE) % BUF_SIZE;
+		}
+		k_busy_wait(TRICKLE_US);
+	}
+
+	return NULL;
+}
+
+static void bench_blocked_reader(void)
+{
+	static uint8_t got[BLOCK_SIZE];
+	uint64_t lag, max_lag = 0, total_lag = 0;
+	pthread_t thread;
+	int i, takes;
+
+	trickle_stream = ring_open(0, MODE_IN_OUT | MODE_READ_BLOCK);
+	if (!trickle_stream)
+		return;
+
+	trickle_stop = false;
+	pthread_create(&thread, NULL, trickle_thread, NULL);
+
+	takes = sem_takes;
+	for (i = 0; i < BLOCK_READS; i++) {
+		TEST_CHECK(stream_read(trickle_stream, got, BLOCK_SIZE) == BLOCK_SIZE);
+		lag = test_time_ns() - trickle_last_ns;
+		max_lag = MAX(max_lag, lag);
+		total_lag += lag;
+	}
+	takes = sem_takes - takes;
+
+	trickle_stop = true;
+	pthread_join(thread, NULL);
+	type_close(trickle_stream, NULL);
+
+	printf("blocked read of %d by %d: %.2f wakeups/read, lag %.1f us, max %.1f us\n",
+			BLOCK_SIZE, TRICKLE_SIZE, (double)takes / BLOCK_READS,
+			(double)total_lag / BLOCK_READS / 1000, (double)max_lag / 1000);
+
+	/* once per read, and well before the poll */
+	TEST_CHECK_MSG(takes <= BLOCK_READS * 2, "%d wakeups for %d reads", takes, BLOCK_READS);
+	TEST_CHECK_MSG(max_lag < 20 * 1000 * 1000ull, "max lag %llu ns",
+			(unsigned long long)max_lag);
+}
+
+int main(int argc, char *argv[])
+{
+	int megabytes = (argc > 1) ? atoi(argv[1]) : 4;
+	int chunks = MAX(megabytes, 1) * 1024 * 1024 / CHUNK_SIZE;
+	int i;
+
+	for (i = 0; i < BUF_SIZE; i++)
+		source[i] = i * 7 + 1;
+
+	bench_types(chunks);
+	bench_tee(chunks);
+	bench_blocked_reader();
+
+	return TEST_RESULT();
+}
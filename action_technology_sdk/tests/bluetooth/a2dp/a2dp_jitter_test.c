@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Replay of a2dp media packets through the jitter buffer of
+ * bt_manager_a2dp.c (CONFIG_BT_A2DP_JITTER_BUFFER), fed by the bt service
+ * callback as on the target.
+ *
+ * The replay reorders, drops and duplicates packets across the 16 bits
+ * sequence wrap: the media stream must see every sequence number once and
+ * in order, a received packet unchanged, a lost one as zero frames of the
+ * same play time. Zero frames are asked with the codec of the handle the
+ * packets come from, a phone or a TRS player.
+ */
+
+#include <os_common_api.h>
+#include <bt_manager.h>
+#include <test_common.h>
+
+TEST_MAIN_DEFINE();
+
+#define HDL_PHONE		0x80
+#define HDL_PLAYER		0x81
+
+#define HEAD_SIZE		8
+#define PKT_FRAMES		5
+#define PKT_PAYLOAD		500
+#define PKT_MARK		0x11
+#define ZERO_FRAME_LEN	109
+
+#define MAX_OUT			30000
+
+typedef struct {
+	uint16_t seq_no;
+	uint16_t frame_cnt;
+	uint8_t concealed;
+	uint8_t codec_id;       // zero frames only
+	uint8_t seq_low;        // received packets only
+} out_pkt_t;
+
+static btsrv_a2dp_hdl_callback a2dp_cb;
+static char media_stream;
+static int stream_space = 1 << 20;
+static out_pkt_t out[MAX_OUT];
+static int num_out;
+
+static uint8_t zero_frame[ZERO_FRAME_LEN];
+static uint8_t zero_codec_id, zero_sample_rate;
+
+int btif_a2dp_start(struct btsrv_a2dp_start_param *param)
+{
+	a2dp_cb = param->cb;
+	return 0;
+}
+
+int btif_a2dp_stop(void) { return 0; }
+int btif_a2dp_check_state(void) { return 0; }
+int btif_a2dp_send_delay_report(uint16_t delay_time) { return 0; }
+int btif_a2dp_disable(void) { return 0; }
+int btif_a2dp_enable(void) { return 0; }
+
+/* zero frame marked with the codec it was asked for */
+uint8_t *btif_a2dp_get_zero_frame(uint8_t codec_id, uint16_t *len, uint8_t sample_rate)
+{
+	zero_codec_id = codec_id;
+	zero_sample_rate = sample_rate;
+	zero_frame[0] = 0xa0 | codec_id;
+	*len = ZERO_FRAME_LEN;
+	return zero_frame;
+}
+
+bool bt_mgr_check_dev_type(uint8_t type, uint16_t hdl)
+{
+	return (type == BTSRV_DEVICE_PHONE && hdl == HDL_PHONE) ||
+		(type == BTSRV_DEVICE_PLAYER && hdl == HDL_PLAYER);
+}
+
+bool bt_manager_config_support_a2dp_aac(void) { return true; }
+int system_check_low_latencey_mode(void) { return 0; }
+void bt_manager_stream_pool_lock(void) { }
+void bt_manager_stream_pool_unlock(void) { }
+int bt_manager_event_notify(int event_id, void *event_data, int event_data_size) { return 0; }
+
+io_stream_t bt_manager_get_stream(int type)
+{
+	return (type == STREAM_TYPE_A2DP) ? (io_stream_t)&media_stream : NULL;
+}
+
+int stream_get_space(io_stream_t handle)
+{
+	return stream_space;
+}
+
+int stream_write(io_stream_t handle, const void *buf, int num)
+{
+	const uint8_t *pkt = buf;
+	out_pkt_t *o;
+
+	if (num < HEAD_SIZE + 2 || num_out >= MAX_OUT)
+		return num;
+
+	o = &out[num_out++];
+	o->frame_cnt = pkt[0] | (pkt[1] << 8);
+	o->seq_no = pkt[2] | (pkt[3] << 8);
+	o->concealed = (pkt[HEAD_SIZE] != PKT_MARK);
+	o->codec_id = pkt[HEAD_SIZE] & 0x0f;
+	o->seq_low = pkt[HEAD_SIZE + 1];
+	return num;
+}
+
+static void send_codec(uint16_t hdl, uint8_t codec_id, uint8_t sample_rate)
+{
+	uint8_t info[3] = { codec_id, sample_rate, 53, };
+
+	a2dp_cb(hdl, BTSRV_A2DP_CODEC_INFO, info, sizeof(info));
+}
+
+static void send_packet(uint16_t hdl, uint16_t seq_no)
+{
+	uint8_t pkt[HEAD_SIZE + PKT_PAYLOAD];
+
+	memset(pkt, 0, sizeof(pkt));
+	pkt[0] = PKT_FRAMES;
+	pkt[2] = seq_no & 0xff;
+	pkt[3] = seq_no >> 8;
+	pkt[4] = PKT_PAYLOAD & 0xff;
+	pkt[5] = PKT_PAYLOAD >> 8;
+	pkt[HEAD_SIZE] = PKT_MARK;
+	pkt[HEAD_SIZE + 1] = seq_no & 0xff;
+
+	a2dp_cb(hdl, BTSRV_A2DP_DATA_INDICATED, pkt, sizeof(pkt));
+}
+
+static void stream_start(uint16_t hdl, struct bt_a2dp_jitter_stat *stat)
+{
+	a2dp_cb(hdl, BTSRV_A2DP_STREAM_STARED, NULL, 0);
+	bt_manager_a2dp_get_jitter_stat(stat, true);
+	memset(stat, 0, sizeof(*stat));
+	num_out = 0;
+}
+
+/* output in sequence from first, received packets unchanged */
+static int check_output(uint16_t first, int *concealed)
+{
+	int i, bad = 0;
+
+	*concealed = 0;
+	for (i = 0; i < num_out; i++) {
+		if (out[i].seq_no != (uint16_t)(first + i))
+			bad++;
+		if (out[i].concealed) {
+			(*concealed)++;
+			if (out[i].frame_cnt < 1 || out[i].frame_cnt > PKT_FRAMES)
+				bad++;
+		} else if (out[i].seq_low != (out[i].seq_no & 0xff) || out[i].frame_cnt != PKT_FRAMES) {
+			bad++;
+		}
+	}
+
+	return bad;
+}
+
+static void test_replay(void)
+{
+	static uint16_t order[20000];
+	const int num = ARRAY_SIZE(order);
+	const uint16_t first = 65000;
+	struct bt_a2dp_jitter_stat stat;
+	uint32_t seed = 1;
+	int i, dropped = 0, sent = 0, concealed, bad;
+
+	send_codec(HDL_PHONE, 0, 44);
+	stream_start(HDL_PHONE, &stat);
+
+	for (i = 0; i < num; i++)
+		order[i] = first + i;
+
+	/* swap neighbours */
+	for (i = 0; i + 1 < num; i++) {
+		if (test_rand(&seed) % 50 == 0) {
+			uint16_t t = order[i];
+
+			order[i] = order[i + 1];
+			order[i + 1] = t;
+			i++;
+		}
+	}
+
+	for (i = 0; i < num; i++) {
+		if (test_rand(&seed) % 100 == 0) {
+			dropped++;
+			continue;
+		}
+
+		send_packet(HDL_PHONE, order[i]);
+		sent++;
+		if (test_rand(&seed) % 200 == 0) {
+			send_packet(HDL_PHONE, order[i]);
+			sent++;
+		}
+	}
+
+	bt_manager_a2dp_get_jitter_stat(&stat, false);
+	bad = check_output(first, &concealed);
+
+	TEST_CHECK_MSG(bad == 0, "%d packets out of sequence or changed", bad);
+	TEST_CHECK(stat.received == sent);
+	TEST_CHECK(concealed == stat.concealed && stat.concealed == stat.lost);
+	TEST_CHECK_MSG(concealed >= dropped && concealed <= dropped + stat.late,
+			"concealed %d, dropped %d, late %u", concealed, dropped, stat.late);
+	TEST_CHECK_MSG(num_out + stat.max_depth >= num, "out %d of %d", num_out, num);
+	TEST_CHECK(stat.target_depth > 0 && stat.target_depth < CONFIG_BT_A2DP_JITTER_BUFFER_SLOTS);
+	TEST_CHECK(stat.overflow == 0 && stat.resync == 0);
+
+	printf("%d packets, dropped %d: out %d, concealed %u, late %u, duplicate %u, depth %u/%u\n",
+			num, dropped, num_out, stat.concealed, stat.late, stat.duplicate,
+			stat.target_depth, stat.max_depth);
+}
+
+/* zero frames of the codec of the handle, not of the phone */
+static void test_conceal_codec(void)
+{
+	struct bt_a2dp_jitter_stat stat;
+	const struct {
+		uint16_t hdl;
+		uint8_t codec_id;
+		uint8_t sample_rate;
+	} cases[] = {
+		{ HDL_PLAYER, 2, 48, },
+		{ HDL_PHONE, 0, 44, },
+	};
+	uint16_t seq;
+	int i, n;
+
+	send_codec(HDL_PHONE, 0, 44);
+	send_codec(HDL_PLAYER, 2, 48);
+
+	for (i = 0; i < ARRAY_SIZE(cases); i++) {
+		stream_start(cases[i].hdl, &stat);
+		zero_codec_id = 0xff;
+
+		for (seq = 100; seq < 110; seq++) {
+			if (seq != 104)
+				send_packet(cases[i].hdl, seq);
+		}
+
+		for (n = 0; n < num_out && out[n].seq_no != 104; n++)
+			;
+
+		TEST_CHECK(n < num_out && out[n].concealed);
+		TEST_CHECK_MSG(zero_codec_id == cases[i].codec_id && zero_sample_rate == cases[i].sample_rate,
+				"hdl 0x%x: zero frame of codec %u at %u", cases[i].hdl, zero_codec_id,
+				zero_sample_rate);
+		TEST_CHECK(n < num_out && out[n].codec_id == cases[i].codec_id &&
+				out[n].frame_cnt == PKT_FRAMES);
+	}
+}
+
+/* a jump is a restart of the stream, not a loss */
+static void test_resync(void)
+{
+	struct bt_a2dp_jitter_stat stat;
+	uint16_t seq;
+	int i, bad = 0;
+
+	send_codec(HDL_PHONE, 0, 44);
+	stream_start(HDL_PHONE, &stat);
+
+	for (seq = 10; seq < 20; seq++)
+		send_packet(HDL_PHONE, seq);
+	for (seq = 5000; seq < 5010; seq++)
+		send_packet(HDL_PHONE, seq);
+
+	for (i = 0; i < num_out; i++) {
+		if (out[i].concealed || out[i].seq_no != ((i < 10) ? 10 + i : 4990 + i))
+			bad++;
+	}
+
+	bt_manager_a2dp_get_jitter_stat(&stat, false);
+	TEST_CHECK(stat.resync == 1 && stat.concealed == 0 && stat.lost == 0);
+	TEST_CHECK_MSG(num_out == 20 && bad == 0, "out %d, %d out of sequence", num_out, bad);
+}
+
+/* a full media stream drops packets without stalling the buffer */
+static void test_overflow(void)
+{
+	struct bt_a2dp_jitter_stat stat;
+	uint16_t seq;
+
+	send_codec(HDL_PHONE, 0, 44);
+	stream_start(HDL_PHONE, &stat);
+
+	stream_space = 0;
+	for (seq = 0; seq < 8; seq++)
+		send_packet(HDL_PHONE, seq);
+	stream_space = 1 << 20;
+	for (; seq < 16; seq++)
+		send_packet(HDL_PHONE, seq);
+
+	bt_manager_a2dp_get_jitter_stat(&stat, true);
+	TEST_CHECK(stat.overflow == 8 && stat.received == 16 && num_out == 8 && out[0].seq_no == 8);
+
+	bt_manager_a2dp_get_jitter_stat(&stat, false);
+	TEST_CHECK(stat.received == 0 && stat.overflow == 0);
+}
+
+int main(void)
+{
+	bt_manager_a2dp_profile_start();
+	TEST_CHECK(a2dp_cb != NULL);
+	if (!a2dp_cb)
+		return TEST_RESULT();
+
+	TEST_RUN(test_replay);
+	TEST_RUN(test_conceal_codec);
+	TEST_RUN(test_resync);
+	TEST_RUN(test_overflow);
+
+	return TEST_RESULT();
+}
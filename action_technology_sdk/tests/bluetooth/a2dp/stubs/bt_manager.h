@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Host stand-in of the bt manager API used by bt_manager_a2dp.c, with
+ *        the same types as framework/bluetooth/include/bt_manager.h
+ */
+
+#ifndef TESTS_BLUETOOTH_STUBS_BT_MANAGER_H_
+#define TESTS_BLUETOOTH_STUBS_BT_MANAGER_H_
+
+#include <stream.h>
+#include "btservice_api.h"
+
+enum {
+	STREAM_TYPE_A2DP,
+	STREAM_TYPE_SCO,
+};
+
+enum {
+	BT_A2DP_STREAM_START_EVENT,
+	BT_A2DP_STREAM_SUSPEND_EVENT,
+};
+
+/** a2dp media jitter buffer statistics */
+struct bt_a2dp_jitter_stat {
+	uint32_t received;		/* media packets received */
+	uint32_t late;			/* packets arrived after their slot was concealed */
+	uint32_t duplicate;		/* packets already received */
+	uint32_t lost;			/* sequence numbers never received in time */
+	uint32_t concealed;		/* lost packets replaced by zero frames */
+	uint32_t overflow;		/* packets dropped for media stream full */
+	uint32_t resync;		/* sequence jumps handled as stream restart */
+	uint8_t target_depth;	/* packets held before a hole is concealed */
+	uint8_t max_depth;		/* max packets held */
+};
+
+int bt_manager_a2dp_profile_start(void);
+int bt_manager_a2dp_get_jitter_stat(struct bt_a2dp_jitter_stat *stat, bool clear);
+
+void bt_manager_stream_pool_lock(void);
+void bt_manager_stream_pool_unlock(void);
+io_stream_t bt_manager_get_stream(int type);
+int bt_manager_event_notify(int event_id, void *event_data, int event_data_size);
+
+#endif /* TESTS_BLUETOOTH_STUBS_BT_MANAGER_H_ */
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Host stand-in of the bt service a2dp API, with the same types and
+ *        values as framework/bluetooth/include/btservice_api.h
+ */
+
+#ifndef TESTS_BLUETOOTH_STUBS_BTSERVICE_API_H_
+#define TESTS_BLUETOOTH_STUBS_BTSERVICE_API_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** bluetooth device address */
+typedef struct {
+	uint8_t  val[6];
+} bd_address_t;
+
+enum btsrv_device_type_e {
+	BTSRV_DEVICE_ALL         = 0,
+	BTSRV_DEVICE_PHONE       = 1,
+	BTSRV_DEVICE_TWS         = 2,
+	BTSRV_DEVICE_PLAYER      = 3,
+};
+
+typedef enum {
+	BTSRV_A2DP_CONNECTED,
+	BTSRV_A2DP_DISCONNECTED,
+	BTSRV_A2DP_STREAM_OPENED,
+	BTSRV_A2DP_STREAM_CLOSED,
+	BTSRV_A2DP_STREAM_STARED,
+	BTSRV_A2DP_STREAM_SUSPEND,
+	BTSRV_A2DP_DATA_INDICATED,
+	BTSRV_A2DP_CODEC_INFO,
+	BTSRV_A2DP_ACTIVED_DEV_CHANGED,
+	BTSRV_A2DP_GET_INIT_DELAY_REPORT,
+} btsrv_a2dp_event_e;
+
+typedef void (*btsrv_a2dp_callback)(btsrv_a2dp_event_e event, void *packet, int size);
+typedef void (*btsrv_a2dp_hdl_callback)(uint16_t hdl, btsrv_a2dp_event_e event, void *packet, int size);
+
+struct btsrv_a2dp_start_param {
+	btsrv_a2dp_hdl_callback cb;
+	uint8_t *sbc_codec;
+	uint8_t *aac_codec;
+	uint8_t sbc_endpoint_num;
+	uint8_t aac_endpoint_num;
+	uint8_t a2dp_cp_scms_t:1;
+	uint8_t a2dp_delay_report:1;
+};
+
+int btif_a2dp_start(struct btsrv_a2dp_start_param *param);
+int btif_a2dp_stop(void);
+int btif_a2dp_check_state(void);
+int btif_a2dp_send_delay_report(uint16_t delay_time);
+int btif_a2dp_disable(void);
+int btif_a2dp_enable(void);
+uint8_t *btif_a2dp_get_zero_frame(uint8_t codec_id, uint16_t *len, uint8_t sample_rate);
+
+#endif /* TESTS_BLUETOOTH_STUBS_BTSERVICE_API_H_ */
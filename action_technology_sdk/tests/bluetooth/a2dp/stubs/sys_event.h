@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* not used by the code under test on the host */
+
+#ifndef TESTS_BLUETOOTH_STUBS_SYS_EVENT_H_
+#define TESTS_BLUETOOTH_STUBS_SYS_EVENT_H_
+
+#endif /* TESTS_BLUETOOTH_STUBS_SYS_EVENT_H_ */
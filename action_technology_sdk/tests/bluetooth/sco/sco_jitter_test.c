@@ -0,0 +1,469 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Replay of sco frame traces through the receive jitter buffer of
+ * bt_manager_sco.c (CONFIG_BT_SCO_JITTER_BUFFER), fed by the bt service
+ * sco callback as on the target, with loss injected on top of the trace.
+ *
+ * A trace is the arrival time, frame count and bad flag of every frame
+ * the bt service packed. The built in traces are a clean link and a link
+ * with arrival delay bursts of up to four frames, as the controller gives
+ * under wifi coexistence; a trace recorded on the target can be replayed
+ * instead, one frame per line as "<time us> <frame count> <bad flag>".
+ *
+ * The decoder takes one frame from the sco stream every 7.5ms. The stream
+ * must see the frame counts in order without gaps, a received frame
+ * unchanged, a lost one as a bad frame. A loss must not count as a delay,
+ * delays must raise the queued depth so the decoder underruns less, and a
+ * clean link must bring the target depth back down without underruns.
+ *
+ * usage: sco_jitter_test [trace file] [loss %]
+ */
+
+#include <os_common_api.h>
+#include <bt_manager.h>
+#include <test_common.h>
+
+TEST_MAIN_DEFINE();
+
+#define FRAME_US		7500
+#define HEAD_SIZE		8
+#define PAYLOAD_SIZE	60
+#define FRAME_SIZE		(HEAD_SIZE + PAYLOAD_SIZE)
+
+#define MAX_QUEUE		64
+#define MAX_TRACE		20000
+#define MAX_OUT			(MAX_TRACE * 2)
+
+typedef struct {
+	uint32_t time_us;
+	uint16_t frame_cnt;
+	uint8_t bad;
+} trace_frame_t;
+
+typedef struct {
+	uint16_t frame_cnt;
+	uint8_t bad;
+	uint8_t concealed;      // payload not the one sent
+} out_frame_t;
+
+typedef struct {
+	int sent;
+	int dropped;
+	int underruns;
+	int played;
+	int queued;             // frames in the stream at the end
+} replay_result_t;
+
+static btsrv_sco_callback sco_cb;
+static char sco_stream[2];
+static int call;
+static int stream_space = MAX_QUEUE * FRAME_SIZE;
+
+/* frames queued in the sco stream, then played by the decoder */
+static out_frame_t queue[MAX_QUEUE];
+static int queue_rd, queue_len;
+static out_frame_t out[MAX_OUT];
+static int num_out;
+
+static trace_frame_t trace[MAX_TRACE];
+
+int btif_sco_start(btsrv_sco_callback cb)
+{
+	sco_cb = cb;
+	return 0;
+}
+
+int btif_sco_stop(void) { return 0; }
+void bt_manager_stream_pool_lock(void) { }
+void bt_manager_stream_pool_unlock(void) { }
+
+io_stream_t bt_manager_get_stream(int type)
+{
+	return (type == STREAM_TYPE_SCO) ? (io_stream_t)&sco_stream[call % 2] : NULL;
+}
+
+int stream_get_space(io_stream_t handle)
+{
+	return MIN(stream_space, (MAX_QUEUE - queue_len) * FRAME_SIZE);
+}
+
+int stream_get_length(io_stream_t handle)
+{
+	return queue_len * FRAME_SIZE;
+}
+
+int stream_write(io_stream_t handle, const void *buf, int num)
+{
+	const uint8_t *frame = buf;
+	out_frame_t *o;
+
+	if (num != FRAME_SIZE || queue_len >= MAX_QUEUE)
+		return 0;
+
+	o = &queue[(queue_rd + queue_len++) % MAX_QUEUE];
+	o->bad = frame[0];
+	o->frame_cnt = frame[2] | (frame[3] << 8);
+	o->concealed = (frame[HEAD_SIZE] != (uint8_t)~o->frame_cnt ||
+			frame[HEAD_SIZE + 1] != (uint8_t)o->frame_cnt);
+	return num;
+}
+
+/* one decoder period, false on underrun */
+static bool decoder_play(void)
+{
+	if (!queue_len)
+		return false;
+
+	if (num_out < MAX_OUT)
+		out[num_out++] = queue[queue_rd];
+	queue_rd = (queue_rd + 1) % MAX_QUEUE;
+	queue_len--;
+	return true;
+}
+
+static void send_frame(uint32_t time_us, uint16_t frame_cnt, uint8_t bad)
+{
+	uint8_t frame[FRAME_SIZE];
+
+	memset(frame, 0, sizeof(frame));
+	frame[0] = bad;
+	frame[2] = frame_cnt & 0xff;
+	frame[3] = frame_cnt >> 8;
+	frame[4] = PAYLOAD_SIZE;
+	frame[6] = HEAD_SIZE;
+	frame[HEAD_SIZE] = ~frame_cnt;
+	frame[HEAD_SIZE + 1] = frame_cnt;
+
+	sim_cycle_set_us(time_us);
+	sco_cb(BTSRV_SCO_DATA_INDICATED, frame, sizeof(frame));
+}
+
+/* a new sco stream, the buffer starts over with its first frame */
+static void call_start(void)
+{
+	call++;
+	queue_rd = queue_len = num_out = 0;
+}
+
+/*
+ * Frames every 7.5ms after start_us from frame count first; with delay_pct
+ * set, a burst holds frames back by up to four periods, the controller
+ * then delivers them together.
+ */
+static int trace_make(trace_frame_t *tr, uint32_t start_us, uint16_t first, int num,
+		int delay_pct, uint32_t *seed)
+{
+	uint32_t delay = 0, last = 0;
+	int i;
+
+	for (i = 0; i < num; i++) {
+		uint32_t time_us = start_us + FRAME_US * (i + 1);
+
+		if (delay_pct && !delay && test_rand(seed) % 100 < delay_pct)
+			delay = (test_rand(seed) % 4) * FRAME_US + 5000;
+
+		time_us += delay;
+		delay = (delay > FRAME_US) ? delay - FRAME_US : 0;
+
+		tr[i].time_us = MAX(time_us, last);
+		tr[i].frame_cnt = first + i;
+		tr[i].bad = 0;
+		last = tr[i].time_us;
+	}
+
+	return num;
+}
+
+static int trace_load(const char *path)
+{
+	FILE *fp = fopen(path, "r");
+	unsigned int time_us, frame_cnt, bad;
+	int num = 0;
+
+	if (!fp)
+		return -ENOENT;
+
+	while (num < MAX_TRACE && fscanf(fp, "%u %u %u", &time_us, &frame_cnt, &bad) == 3) {
+		trace[num].time_us = time_us;
+		trace[num].frame_cnt = frame_cnt;
+		trace[num].bad = !!bad;
+		num++;
+	}
+
+	fclose(fp);
+	return num;
+}
+
+/*
+ * Trace through the callback with the decoder playing in between. About
+ * loss_pct of the frames are dropped in bursts of 1 ~ 3, not the first
+ * nor the last one, so every drop is a loss. The decoder keeps its period
+ * across calls on the same stream and plays it out at the end with drain.
+ */
+static void replay(const trace_frame_t *tr, int num, int loss_pct, bool drain, uint32_t *seed,
+		replay_result_t *res)
+{
+	static uint32_t tick_us;
+	int i, burst = 0;
+
+	memset(res, 0, sizeof(*res));
+	if (!queue_len && !num_out)
+		tick_us = tr[0].time_us + FRAME_US / 2;
+
+	for (i = 0; i < num; i++) {
+		for (; tick_us <= tr[i].time_us; tick_us += FRAME_US) {
+			if (decoder_play())
+				res->played++;
+			else
+				res->underruns++;
+		}
+
+		if (!burst && loss_pct && i > 0 && test_rand(seed) % 200 < loss_pct)
+			burst = 1 + test_rand(seed) % 3;
+		if (burst && i < num - 1) {
+			burst--;
+			res->dropped++;
+			continue;
+		}
+		burst = 0;
+
+		send_frame(tr[i].time_us, tr[i].frame_cnt, tr[i].bad);
+		res->sent++;
+	}
+
+	res->queued = queue_len;
+	while (drain && decoder_play())
+		res->played++;
+}
+
+/*
+ * Frame counts of the output from first to last never go back and only
+ * skip a trimmed frame, every frame not as sent is a bad one inserted, so
+ * the decoder timeline has no holes.
+ */
+static int check_output(uint16_t first, uint16_t last, int *concealed, int *skipped)
+{
+	uint16_t cnt = first;
+	int i, bad = 0;
+
+	*concealed = 0;
+	*skipped = 0;
+	for (i = 0; i < num_out; i++) {
+		int16_t step = (int16_t)(out[i].frame_cnt - cnt);
+
+		if (step < 0 || step > 2 || (i == 0 && step))
+			bad++;
+		if (step == 2)
+			(*skipped)++;
+		cnt = out[i].frame_cnt;
+
+		if (out[i].concealed) {
+			(*concealed)++;
+			if (!out[i].bad)
+				bad++;
+		}
+	}
+
+	if (cnt != last)
+		bad++;
+
+	return bad;
+}
+
+static void test_loss(void)
+{
+	struct bt_sco_jitter_stat stat;
+	replay_result_t res;
+	uint32_t seed = 1;
+	int num, concealed, skipped, bad;
+
+	call_start();
+	num = trace_make(trace, 0, 65000, 10000, 0, &seed);
+	replay(trace, num, 3, true, &seed, &res);
+	bt_manager_sco_get_jitter_stat(&stat, false);
+	bad = check_output(trace[0].frame_cnt, trace[num - 1].frame_cnt, &concealed, &skipped);
+
+	TEST_CHECK_MSG(bad == 0, "%d frames out of sequence or changed", bad);
+	TEST_CHECK(stat.received == res.sent && stat.bad == 0 && stat.overflow == 0);
+	TEST_CHECK_MSG(stat.lost == res.dropped, "lost %u, dropped %d", stat.lost, res.dropped);
+	TEST_CHECK(concealed == stat.concealed && stat.concealed == stat.lost);
+	TEST_CHECK(skipped == stat.trimmed && num_out == num - stat.trimmed);
+	/* a loss is not a delay, the link keeps its latency */
+	TEST_CHECK_MSG(stat.late == 0 && stat.target_depth == 0, "late %u, depth %u", stat.late,
+			stat.target_depth);
+	TEST_CHECK_MSG(res.queued <= CONFIG_BT_SCO_JITTER_BUFFER_MAX_DEPTH, "queued %d", res.queued);
+
+	printf("clean link %d frames, dropped %d: out %d, concealed %u, trimmed %u, underruns %d, "
+			"queued %d\n", num, res.dropped, num_out, stat.concealed, stat.trimmed,
+			res.underruns, res.queued);
+}
+
+static void test_jitter(void)
+{
+	struct bt_sco_jitter_stat stat;
+	replay_result_t res[3];
+	uint32_t seed = 2, end_us;
+	int num, half, concealed, skipped, bad;
+
+	/* the first half of the trace adapts the depth, the second is measured */
+	call_start();
+	num = trace_make(trace, 0, 100, 12000, 2, &seed);
+	half = num / 2;
+	replay(trace, half, 1, false, &seed, &res[0]);
+	bt_manager_sco_get_jitter_stat(&stat, true);
+	TEST_CHECK_MSG(stat.late > 0 && stat.max_depth > 1, "late %u, depth %u", stat.late,
+			stat.max_depth);
+
+	num_out = 0;
+	replay(&trace[half], num - half, 1, false, &seed, &res[1]);
+	bt_manager_sco_get_jitter_stat(&stat, false);
+	bad = check_output(out[0].frame_cnt, out[num_out - 1].frame_cnt, &concealed, &skipped);
+
+	TEST_CHECK_MSG(bad == 0, "%d frames out of sequence or changed", bad);
+	TEST_CHECK(stat.received == res[1].sent && stat.lost == res[1].dropped && stat.overflow == 0);
+	TEST_CHECK_MSG(res[1].underruns < res[0].underruns, "underruns %d after adapting, %d before",
+			res[1].underruns, res[0].underruns);
+	TEST_CHECK(stat.target_depth <= CONFIG_BT_SCO_JITTER_BUFFER_MAX_DEPTH);
+	TEST_CHECK_MSG(res[1].queued <= CONFIG_BT_SCO_JITTER_BUFFER_MAX_DEPTH + 4, "queued %d",
+			res[1].queued);
+
+	printf("delay bursts %d frames: underruns %d -> %d, late %u, concealed %u, trimmed %u, "
+			"depth %u/%u\n", num, res[0].underruns, res[1].underruns, stat.late, stat.concealed,
+			stat.trimmed, stat.target_depth, stat.max_depth);
+
+	/* then the link settles, the added latency is given back */
+	end_us = trace[num - 1].time_us;
+	num = trace_make(trace, end_us, trace[num - 1].frame_cnt + 1, 6000, 0, &seed);
+	replay(trace, num, 0, false, &seed, &res[2]);
+	bt_manager_sco_get_jitter_stat(&stat, false);
+
+	TEST_CHECK_MSG(stat.target_depth == 0 && res[2].underruns == 0, "depth %u, underruns %d",
+			stat.target_depth, res[2].underruns);
+	TEST_CHECK_MSG(res[2].queued <= res[1].queued, "queued %d, %d before", res[2].queued,
+			res[1].queued);
+
+	printf("settled %d frames: depth %u, trimmed %u, queued %d -> %d\n", num, stat.target_depth,
+			stat.trimmed, res[1].queued, res[2].queued);
+}
+
+/* frames the controller flagged bad go to the decoder as they are */
+static void test_bad_frames(void)
+{
+	struct bt_sco_jitter_stat stat;
+	replay_result_t res;
+	uint32_t seed = 3;
+	int i, num, flagged = 0, passed = 0;
+
+	call_start();
+	num = trace_make(trace, 0, 0, 200, 0, &seed);
+	for (i = 0; i < num; i += 7) {
+		trace[i].bad = 1;
+		flagged++;
+	}
+	replay(trace, num, 0, true, &seed, &res);
+
+	for (i = 0; i < num_out; i++) {
+		if (out[i].bad && !out[i].concealed)
+			passed++;
+	}
+
+	bt_manager_sco_get_jitter_stat(&stat, false);
+	TEST_CHECK(stat.bad == flagged && passed == flagged && stat.concealed == 0);
+}
+
+/* a frame count jump is a restart, not a loss */
+static void test_resync(void)
+{
+	struct bt_sco_jitter_stat stat;
+	uint32_t time_us = 0;
+	uint16_t cnt;
+
+	call_start();
+
+	for (cnt = 10; cnt < 20; cnt++)
+		send_frame(time_us += FRAME_US, cnt, 0);
+	for (cnt = 5000; cnt < 5010; cnt++)
+		send_frame(time_us += FRAME_US, cnt, 0);
+	while (decoder_play())
+		;
+
+	bt_manager_sco_get_jitter_stat(&stat, false);
+	TEST_CHECK(stat.lost == 0 && stat.concealed == 0);
+	TEST_CHECK_MSG(num_out == 20 && out[10].frame_cnt == 5000, "out %d", num_out);
+}
+
+/* a full sco stream drops frames and counts them */
+static void test_overflow(void)
+{
+	struct bt_sco_jitter_stat stat;
+	uint32_t time_us = 0;
+	uint16_t cnt;
+
+	call_start();
+
+	stream_space = 0;
+	for (cnt = 0; cnt < 8; cnt++)
+		send_frame(time_us += FRAME_US, cnt, 0);
+	stream_space = MAX_QUEUE * FRAME_SIZE;
+	for (; cnt < 16; cnt++)
+		send_frame(time_us += FRAME_US, cnt, 0);
+
+	bt_manager_sco_get_jitter_stat(&stat, true);
+	TEST_CHECK(stat.overflow == 8 && stat.received == 16 && queue_len == 8);
+
+	bt_manager_sco_get_jitter_stat(&stat, false);
+	TEST_CHECK(stat.received == 0 && stat.overflow == 0);
+}
+
+/* a recorded trace, checked for a continuous output and reported */
+static void test_recorded(const char *path, int loss_pct)
+{
+	struct bt_sco_jitter_stat stat;
+	replay_result_t res;
+	uint32_t seed = 4;
+	int num, concealed, skipped, bad;
+
+	num = trace_load(path);
+	TEST_CHECK_MSG(num > 0, "%s: no frames", path);
+	if (num <= 0)
+		return;
+
+	call_start();
+	replay(trace, num, loss_pct, true, &seed, &res);
+	bt_manager_sco_get_jitter_stat(&stat, false);
+	bad = check_output(trace[0].frame_cnt, out[num_out - 1].frame_cnt, &concealed, &skipped);
+
+	TEST_CHECK_MSG(bad == 0, "%d frames out of sequence or changed", bad);
+
+	printf("%s: %d frames, dropped %d: underruns %d, received %u, bad %u, lost %u, late %u, "
+			"concealed %u, trimmed %u, overflow %u, depth %u/%u\n", path, num, res.dropped,
+			res.underruns, stat.received, stat.bad, stat.lost, stat.late, stat.concealed,
+			stat.trimmed, stat.overflow, stat.target_depth, stat.max_depth);
+}
+
+int main(int argc, char *argv[])
+{
+	bt_manager_hfp_sco_start();
+	TEST_CHECK(sco_cb != NULL);
+	if (!sco_cb)
+		return TEST_RESULT();
+
+
+	if (argc > 1) {
+		test_recorded(argv[1], (argc > 2) ? atoi(argv[2]) : 0);
+		return TEST_RESULT();
+	}
+
+	TEST_RUN(test_loss);
+	TEST_RUN(test_jitter);
+	TEST_RUN(test_bad_frames);
+	TEST_RUN(test_resync);
+	TEST_RUN(test_overflow);
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Host stand-in of the bt manager API used by bt_manager_sco.c, with
+ *        the same types as framework/bluetooth/include/bt_manager.h
+ */
+
+#ifndef TESTS_BLUETOOTH_SCO_STUBS_BT_MANAGER_H_
+#define TESTS_BLUETOOTH_SCO_STUBS_BT_MANAGER_H_
+
+#include <stream.h>
+#include "btservice_api.h"
+
+enum {
+	STREAM_TYPE_A2DP,
+	STREAM_TYPE_SCO,
+};
+
+/** sco receive jitter buffer statistics */
+struct bt_sco_jitter_stat {
+	uint32_t received;		/* sco frames received */
+	uint32_t bad;			/* frames flagged bad by controller or bt service */
+	uint32_t lost;			/* frames missing from the frame count sequence */
+	uint32_t late;			/* frames arrived after the decoder drained the stream */
+	uint32_t concealed;		/* bad frames inserted for lost frames or to refill depth */
+	uint32_t trimmed;		/* frames dropped to shrink latency */
+	uint32_t overflow;		/* frames dropped for sco stream full */
+	uint8_t target_depth;	/* frames kept queued for the decoder */
+	uint8_t max_depth;		/* max frames queued */
+};
+
+int bt_manager_hfp_sco_start(void);
+int bt_manager_hfp_sco_stop(void);
+int bt_manager_sco_get_jitter_stat(struct bt_sco_jitter_stat *stat, bool clear);
+
+void bt_manager_stream_pool_lock(void);
+void bt_manager_stream_pool_unlock(void);
+io_stream_t bt_manager_get_stream(int type);
+
+#endif /* TESTS_BLUETOOTH_SCO_STUBS_BT_MANAGER_H_ */
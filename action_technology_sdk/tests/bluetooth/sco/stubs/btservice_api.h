@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Host stand-in of the bt service sco API, with the same types and
+ *        values as framework/bluetooth/include/btservice_api.h
+ */
+
+#ifndef TESTS_BLUETOOTH_SCO_STUBS_BTSERVICE_API_H_
+#define TESTS_BLUETOOTH_SCO_STUBS_BTSERVICE_API_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** bluetooth device address */
+typedef struct {
+	uint8_t  val[6];
+} bd_address_t;
+
+struct btsrv_a2dp_start_param;
+
+typedef enum {
+	BTSRV_HFP_CONNECTED,
+	BTSRV_HFP_DISCONNECTED,
+	BTSRV_HFP_CODEC_INFO,
+	BTSRV_HFP_PHONE_NUM,
+	BTSRV_HFP_PHONE_NUM_STOP,
+	BTSRV_HFP_CALL_INCOMING,
+	BTSRV_HFP_CALL_OUTGOING,
+	BTSRV_HFP_CCWA_PHONE_NUM,
+	BTSRV_HFP_CALL_3WAYIN,
+	BTSRV_HFP_CALL_ONGOING,
+	BTSRV_HFP_CALL_MULTIPARTY,
+	BTSRV_HFP_CALL_ALERTED,
+	BTSRV_HFP_CALL_EXIT,
+	BTSRV_HFP_VOLUME_CHANGE,
+	BTSRV_HFP_ACTIVE_DEV_CHANGE,
+	BTSRV_HFP_SIRI_STATE_CHANGE,
+	BTSRV_HFP_SCO,
+	BTSRV_SCO_CONNECTED,
+	BTSRV_SCO_DISCONNECTED,
+	BTSRV_SCO_DATA_INDICATED,
+} btsrv_hfp_event_e;
+
+typedef void (*btsrv_sco_callback)(btsrv_hfp_event_e event,  uint8_t *param, int param_size);
+int btif_sco_start(btsrv_sco_callback cb);
+int btif_sco_stop(void);
+
+#endif /* TESTS_BLUETOOTH_SCO_STUBS_BTSERVICE_API_H_ */
@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* not used by the code under test on the host */
+
+#ifndef TESTS_BLUETOOTH_SCO_STUBS_POWER_MANAGER_H_
+#define TESTS_BLUETOOTH_SCO_STUBS_POWER_MANAGER_H_
+
+#endif /* TESTS_BLUETOOTH_SCO_STUBS_POWER_MANAGER_H_ */
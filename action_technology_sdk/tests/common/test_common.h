@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Minimal assertion and timing helpers of the host tests
+ */
+
+#ifndef TESTS_COMMON_TEST_COMMON_H_
+#define TESTS_COMMON_TEST_COMMON_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+#ifndef MIN
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+#ifndef MAX
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#endif
+#ifndef ARRAY_SIZE
+#define ARRAY_SIZE(array) (sizeof(array) / sizeof((array)[0]))
+#endif
+
+extern int test_failures;
+
+/* define once in the test holding main() */
+#define TEST_MAIN_DEFINE() int test_failures
+
+#define TEST_CHECK(cond) \
+	do { \
+		if (!(cond)) { \
+			printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+			test_failures++; \
+		} \
+	} while (0)
+
+#define TEST_CHECK_MSG(cond, fmt, ...) \
+	do { \
+		if (!(cond)) { \
+			printf("%s:%d: check failed: %s: " fmt "\n", __FILE__, __LINE__, \
+					#cond, ##__VA_ARGS__); \
+			test_failures++; \
+		} \
+	} while (0)
+
+#define TEST_RUN(fn) \
+	do { \
+		int __failures = test_failures; \
+		fn(); \
+		printf("%-40s %s\n", #fn, (test_failures == __failures) ? "ok" : "FAILED"); \
+	} while (0)
+
+#define TEST_RESULT() (test_failures ? EXIT_FAILURE : EXIT_SUCCESS)
+
+static inline uint64_t test_time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/* xorshift32, so every run replays the same sequence */
+static inline uint32_t test_rand(uint32_t *state)
+{
+	uint32_t x = *state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+	return x;
+}
+
+static inline int test_rand_range(uint32_t *state, int lo, int hi)
+{
+	return lo + (int)(test_rand(state) % (uint32_t)(hi - lo + 1));
+}
+
+#endif /* TESTS_COMMON_TEST_COMMON_H_ */
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * VGLite API of the ThorVG stand-in in LVGL (vg_lite_tvg), plus the frame
+ * delimiter of the Actions driver that the stand-in lacks.
+ */
+
+#ifndef TESTS_DISPLAY_SVGRENDER_VG_LITE_H_
+#define TESTS_DISPLAY_SVGRENDER_VG_LITE_H_
+
+#include_next <vg_lite.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum vg_lite_frame_flag {
+	VG_LITE_FRAME_END_FLAG = 1,
+} vg_lite_frame_flag_t;
+
+vg_lite_error_t vg_lite_frame_delimiter(vg_lite_frame_flag_t flag);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_DISPLAY_SVGRENDER_VG_LITE_H_ */
@@ -0,0 +1,13 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TESTS_DISPLAY_SVGRENDER_VG_LITE_VG_LITE_H_
+#define TESTS_DISPLAY_SVGRENDER_VG_LITE_VG_LITE_H_
+
+/* the framework header of the VGLite driver, here the ThorVG stand-in */
+#include <vg_lite.h>
+
+#endif /* TESTS_DISPLAY_SVGRENDER_VG_LITE_VG_LITE_H_ */
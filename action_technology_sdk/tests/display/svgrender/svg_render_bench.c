@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Render time of vglite_renderer on the ThorVG stand-in of VGLite
+ * (vg_lite_tvg of LVGL), built with and without the compiled path cache
+ * (SVG_PATH_CACHE).
+ *
+ * Each image is parsed once and rendered frame after frame, as a watch
+ * face or an icon page is redrawn. The time of a frame is split into the
+ * renderer, which builds the paths, strokes and gradients on the CPU (the
+ * part the cache saves, on the target too), and the rasterization in
+ * vg_lite_finish(), which the GPU does on the target.
+ *
+ * With the cache every frame must be the same as the first. Without it the
+ * gradient stops of a translucent shape are faded again on every render,
+ * so only the first frame is kept. Its CRC is printed, both builds must
+ * print the same ones (svg_render_compare.cmake).
+ *
+ * usage: svg_render_bench [frames]
+ */
+
+#include <math.h>
+#include <string.h>
+#include <sys/crc.h>
+#include <test_common.h>
+#include "nanosvg.h"
+#include "vglite_renderer.h"
+
+TEST_MAIN_DEFINE();
+
+#define FB_SIZE			454
+#define SVG_MAX_LEN		(32 * 1024)
+
+#define SVG_HEAD \
+	"<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"240\" height=\"240\" " \
+	"viewBox=\"0 0 240 240\">"
+
+typedef struct {
+	const char *name;
+	int (*build)(char *svg, size_t size);
+	vg_lite_float_t scale;
+} svg_case_t;
+
+/*
+ * The draws and the frame end are timed apart from the renderer: on the
+ * target they only queue GPU commands, here the stand-in also converts the
+ * paths and rasterizes. vg_lite_update_stroke() does nothing in the
+ * stand-in, on the target the driver builds the stroke path on the CPU.
+ */
+static uint64_t vg_lite_ns;
+static uint32_t num_strokes;
+
+#define VG_LITE_TIMED(call) \
+	do { \
+		uint64_t t0 = test_time_ns(); \
+		vg_lite_error_t error = call; \
+		vg_lite_ns += test_time_ns() - t0; \
+		return error; \
+	} while (0)
+
+vg_lite_error_t __real_vg_lite_finish(void);
+vg_lite_error_t __real_vg_lite_flush(void);
+vg_lite_error_t __real_vg_lite_draw(vg_lite_buffer_t *target, vg_lite_path_t *path,
+		vg_lite_fill_t fill_rule, vg_lite_matrix_t *matrix, vg_lite_blend_t blend,
+		vg_lite_color_t color);
+vg_lite_error_t __real_vg_lite_draw_grad(vg_lite_buffer_t *target, vg_lite_path_t *path,
+		vg_lite_fill_t fill_rule, vg_lite_matrix_t *matrix, vg_lite_linear_gradient_t *grad,
+		vg_lite_blend_t blend);
+vg_lite_error_t __real_vg_lite_draw_linear_grad(vg_lite_buffer_t *target, vg_lite_path_t *path,
+		vg_lite_fill_t fill_rule, vg_lite_matrix_t *path_matrix,
+		vg_lite_ext_linear_gradient_t *grad, vg_lite_color_t paint_color,
+		vg_lite_blend_t blend, vg_lite_filter_t filter);
+vg_lite_error_t __real_vg_lite_draw_radial_grad(vg_lite_buffer_t *target, vg_lite_path_t *path,
+		vg_lite_fill_t fill_rule, vg_lite_matrix_t *path_matrix,
+		vg_lite_radial_gradient_t *grad, vg_lite_color_t paint_color,
+		vg_lite_blend_t blend, vg_lite_filter_t filter);
+vg_lite_error_t __real_vg_lite_update_stroke(vg_lite_path_t *path);
+
+vg_lite_error_t __wrap_vg_lite_finish(void)
+{
+	VG_LITE_TIMED(__real_vg_lite_finish());
+}
+
+vg_lite_error_t __wrap_vg_lite_flush(void)
+{
+	VG_LITE_TIMED(__real_vg_lite_flush());
+}
+
+vg_lite_error_t __wrap_vg_lite_draw(vg_lite_buffer_t *target, vg_lite_path_t *path,
+		vg_lite_fill_t fill_rule, vg_lite_matrix_t *matrix, vg_lite_blend_t blend,
+		vg_lite_color_t color)
+{
+	VG_LITE_TIMED(__real_vg_lite_draw(target, path, fill_rule, matrix, blend, color));
+}
+
+vg_lite_error_t __wrap_vg_lite_draw_grad(vg_lite_buffer_t *target, vg_lite_path_t *path,
+		vg_lite_fill_t fill_rule, vg_lite_matrix_t *matrix, vg_lite_linear_gradient_t *grad,
+		vg_lite_blend_t blend)
+{
+	VG_LITE_TIMED(__real_vg_lite_draw_grad(target, path, fill_rule, matrix, grad, blend));
+}
+
+vg_lite_error_t __wrap_vg_lite_draw_linear_grad(vg_lite_buffer_t *target, vg_lite_path_t *path,
+		vg_lite_fill_t fill_rule, vg_lite_matrix_t *path_matrix,
+		vg_lite_ext_linear_gradient_t *grad, vg_lite_color_t paint_color,
+		vg_lite_blend_t blend, vg_lite_filter_t filter)
+{
+	VG_LITE_TIMED(__real_vg_lite_draw_linear_grad(target, path, fill_rule, path_matrix,
+			grad, paint_color, blend, filter));
+}
+
+vg_lite_error_t __wrap_vg_lite_draw_radial_grad(vg_lite_buffer_t *target, vg_lite_path_t *path,
+		vg_lite_fill_t fill_rule, vg_lite_matrix_t *path_matrix,
+		vg_lite_radial_gradient_t *grad, vg_lite_color_t paint_color,
+		vg_lite_blend_t blend, vg_lite_filter_t filter)
+{
+	VG_LITE_TIMED(__real_vg_lite_draw_radial_grad(target, path, fill_rule, path_matrix,
+			grad, paint_color, blend, filter));
+}
+
+vg_lite_error_t __wrap_vg_lite_update_stroke(vg_lite_path_t *path)
+{
+	num_strokes++;
+	return __real_vg_lite_update_stroke(path);
+}
+
+#define SVG_APPEND(svg, size, len, ...) \
+	((len) += snprintf((svg) + (len), (len) < (int)(size) ? (size) - (len) : 0, __VA_ARGS__))
+
+/* a watch face: gradient dial, 60 stroked ticks, filled and stroked hands */
+static int build_dial(char *svg, size_t size)
+{
+	int i, len = 0;
+
+	SVG_APPEND(svg, size, len, SVG_HEAD "<defs>"
+		"<radialGradient id=\"bg\" cx=\"120\" cy=\"120\" r=\"120\" gradientUnits=\"userSpaceOnUse\">"
+		"<stop offset=\"0\" stop-color=\"#304060\"/><stop offset=\"1\" stop-color=\"#101820\"/>"
+		"</radialGradient>"
+		"<linearGradient id=\"hand\" x1=\"0\" y1=\"0\" x2=\"0\" y2=\"1\">"
+		"<stop offset=\"0\" stop-color=\"#ffcc00\"/><stop offset=\"1\" stop-color=\"#ff6600\"/>"
+		"</linearGradient></defs>"
+		"<circle cx=\"120\" cy=\"120\" r=\"116\" fill=\"url(#bg)\" stroke=\"#c0c0c0\" stroke-width=\"3\"/>");
+
+	for (i = 0; i < 60; i++) {
+		double a = i * M_PI / 30;
+		double r0 = (i % 5) ? 104 : 94;
+
+		SVG_APPEND(svg, size, len, "<line x1=\"%.2f\" y1=\"%.2f\" x2=\"%.2f\" y2=\"%.2f\" "
+			"stroke=\"#f0f0f0\" stroke-width=\"%d\" stroke-linecap=\"round\"/>",
+			120 + r0 * sin(a), 120 - r0 * cos(a), 120 + 110 * sin(a), 120 - 110 * cos(a),
+			(i % 5) ? 2 : 4);
+	}
+
+	SVG_APPEND(svg, size, len,
+		"<path d=\"M116 124 L119 52 Q120 46 121 52 L124 124 Z\" fill=\"url(#hand)\"/>"
+		"<path d=\"M120 120 L176 150\" fill=\"none\" stroke=\"#e0e0e0\" stroke-width=\"6\" "
+		"stroke-linecap=\"round\" opacity=\"0.8\"/>"
+		"<path d=\"M120 132 L120 28\" fill=\"none\" stroke=\"#ff3030\" stroke-width=\"1.5\"/>"
+		"<circle cx=\"120\" cy=\"120\" r=\"6\" fill=\"#ff3030\" stroke=\"#202020\" stroke-width=\"2\"/>"
+		"</svg>");
+
+	return len;
+}
+
+/* an icon page: translucent gradient tiles, curves, joins and dashes */
+static int build_icons(char *svg, size_t size)
+{
+	int row, col, len = 0;
+
+	SVG_APPEND(svg, size, len, SVG_HEAD "<defs>"
+		"<linearGradient id=\"tile\" x1=\"0\" y1=\"0\" x2=\"1\" y2=\"1\">"
+		"<stop offset=\"0\" stop-color=\"#40a0ff\"/><stop offset=\"1\" stop-color=\"#8040ff\"/>"
+		"</linearGradient>"
+		"<radialGradient id=\"glow\" cx=\"0.5\" cy=\"0.4\" r=\"0.6\">"
+		"<stop offset=\"0\" stop-color=\"#ffffff\" stop-opacity=\"0.9\"/>"
+		"<stop offset=\"1\" stop-color=\"#ffffff\" stop-opacity=\"0\"/>"
+		"</radialGradient></defs>");
+
+	for (row = 0; row < 6; row++) {
+		for (col = 0; col < 6; col++) {
+			int x = 4 + col * 39, y = 4 + row * 39;
+
+			SVG_APPEND(svg, size, len, "<g transform=\"translate(%d %d)\">"
+				"<rect width=\"34\" height=\"34\" rx=\"8\" fill=\"url(#tile)\" opacity=\"0.85\"/>"
+				"<ellipse cx=\"17\" cy=\"14\" rx=\"15\" ry=\"11\" fill=\"url(#glow)\"/>"
+				"<path d=\"M17 27 C5 19 6 9 12 9 C15 9 17 12 17 12 C17 12 19 9 22 9 "
+				"C28 9 29 19 17 27 Z\" fill=\"#ff5070\" stroke=\"#ffffff\" stroke-width=\"1\"/>"
+				"<polyline points=\"6,30 12,24 18,28 28,20\" fill=\"none\" stroke=\"#20ff90\" "
+				"stroke-width=\"2\" stroke-linejoin=\"round\"/>"
+				"<circle cx=\"17\" cy=\"17\" r=\"15\" fill=\"none\" stroke=\"#ffffff\" "
+				"stroke-width=\"1\" stroke-dasharray=\"3 2\" opacity=\"0.6\"/>"
+				"</g>", x, y);
+		}
+	}
+
+	SVG_APPEND(svg, size, len, "</svg>");
+	return len;
+}
+
+static const svg_case_t cases[] = {
+	{ "dial", build_dial, FB_SIZE / 240.0f, },
+	{ "icons", build_icons, 1.8f, },
+};
+
+static uint32_t frame_crc(const vg_lite_buffer_t *fb)
+{
+	return crc32_ieee(fb->memory, fb->stride * fb->height);
+}
+
+static void bench_case(const svg_case_t *c, vg_lite_buffer_t *fb, int num_frames)
+{
+	static char svg[SVG_MAX_LEN];
+	uint64_t best = UINT64_MAX, best_vg_lite = 0;
+	uint32_t crc = 0, first_strokes = 0, strokes = 0;
+	int width, height, frame, changed = 0, num_shapes = 0;
+	NSVGimage *image;
+	NSVGshape *shape;
+	int len = c->build(svg, sizeof(svg));
+
+	TEST_CHECK_MSG(len < sizeof(svg), "%s: %d bytes", c->name, len);
+
+	image = parseSVGImage(svg, &width, &height);
+	TEST_CHECK(image != NULL && width > 0 && height > 0);
+	if (image == NULL)
+		return;
+
+	for (shape = image->shapes; shape != NULL; shape = shape->next)
+		num_shapes++;
+
+	for (frame = 0; frame < num_frames; frame++) {
+		uint64_t t0, t;
+		int res;
+
+		vg_lite_clear(fb, NULL, 0xff000000);
+		vg_lite_finish();
+
+		vg_lite_ns = 0;
+		num_strokes = 0;
+		t0 = test_time_ns();
+		res = renderSVGImage(image, fb, NULL, c->scale, NULL);
+		t = test_time_ns() - t0;
+
+		TEST_CHECK_MSG(res == 0, "%s: frame %d: %d", c->name, frame, res);
+
+		/* the first frame compiles the paths with the cache */
+		if (frame == 0) {
+			crc = frame_crc(fb);
+			first_strokes = num_strokes;
+			continue;
+		}
+
+		changed += (frame_crc(fb) != crc);
+		strokes += num_strokes;
+		if (t - vg_lite_ns < best) {
+			best = t - vg_lite_ns;
+			best_vg_lite = vg_lite_ns;
+		}
+	}
+
+	TEST_CHECK(first_strokes > 0);
+#if SVG_PATH_CACHE
+	TEST_CHECK_MSG(changed == 0, "%s: %d of %d frames differ from the first",
+			c->name, changed, num_frames);
+	TEST_CHECK_MSG(strokes == 0, "%s: %u strokes rebuilt", c->name, strokes);
+#endif
+
+	printf("%-6s %3d shapes: renderer %7.1f us, stroke paths %3u/frame (first %3u), "
+			"stand-in draw %7.1f us\n", c->name, num_shapes, best / 1000.0,
+			strokes / (num_frames - 1), first_strokes, best_vg_lite / 1000.0);
+	printf("crc %s %08x\n", c->name, crc);
+
+	deleteSVGImage(image);
+}
+
+int main(int argc, char *argv[])
+{
+	int num_frames = (argc > 1) ? atoi(argv[1]) : 200;
+	vg_lite_buffer_t fb;
+	int i;
+
+	TEST_CHECK(vg_lite_init(FB_SIZE, FB_SIZE) == VG_LITE_SUCCESS);
+
+	memset(&fb, 0, sizeof(fb));
+	fb.width = FB_SIZE;
+	fb.height = FB_SIZE;
+	fb.format = VG_LITE_BGRA8888;
+	TEST_CHECK(vg_lite_allocate(&fb) == VG_LITE_SUCCESS);
+
+	printf("path cache %s, %d frames of %dx%d\n", SVG_PATH_CACHE ? "on" : "off",
+			num_frames, FB_SIZE, FB_SIZE);
+
+	for (i = 0; i < ARRAY_SIZE(cases); i++) {
+		bench_case(&cases[i], &fb, MAX(num_frames, 2));
+	}
+
+	vg_lite_free(&fb);
+	vg_lite_close();
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,22 @@
+# Copyright (c) 2026 Actions Semiconductor Co., Ltd
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Run the bench with and without the path cache, the first frame of every
+# image must have the same CRC.
+#
+#   cmake -DCACHE=<bench> -DNOCACHE=<bench> -DFRAMES=<n> -P svg_render_compare.cmake
+
+foreach(bench CACHE NOCACHE)
+  execute_process(COMMAND ${${bench}} ${FRAMES}
+    OUTPUT_VARIABLE out RESULT_VARIABLE res)
+  message("${out}")
+  if(NOT res EQUAL 0)
+    message(FATAL_ERROR "${${bench}} failed (${res})")
+  endif()
+  string(REGEX MATCHALL "crc [a-z]+ [0-9a-f]+" ${bench}_CRC "${out}")
+endforeach()
+
+if(NOT CACHE_CRC OR NOT CACHE_CRC STREQUAL NOCACHE_CRC)
+  message(FATAL_ERROR "frames differ: cache ${CACHE_CRC}, no cache ${NOCACHE_CRC}")
+endif()
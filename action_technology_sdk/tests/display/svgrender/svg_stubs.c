@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Memory of vg_lite_tvg, the frame delimiter of the VGLite driver and the
+ * PNG decoder of the renderer. The bench images have no embedded PNG.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "vg_lite.h"
+
+void *lv_malloc_zeroed(size_t size)
+{
+	return calloc(1, size);
+}
+
+void lv_free(void *ptr)
+{
+	free(ptr);
+}
+
+void *lv_memcpy(void *dst, const void *src, size_t len)
+{
+	return memcpy(dst, src, len);
+}
+
+void lv_memset(void *dst, uint8_t v, size_t len)
+{
+	memset(dst, v, len);
+}
+
+/* the driver finishes the frame and signals the GPU idle */
+vg_lite_error_t vg_lite_frame_delimiter(vg_lite_frame_flag_t flag)
+{
+	return vg_lite_finish();
+}
+
+int spng_load_memory(vg_lite_buffer_t *buffer, const void *png_bytes, size_t png_len)
+{
+	return -1;
+}
+
+int spng_free_buffer(vg_lite_buffer_t *buffer)
+{
+	return 0;
+}
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Invalidated pixels of UI traces, merged into one bounding box as the
+ * surface did before against ui_region_list with the coalescer.
+ *
+ * The traces replay the invalidation pattern of typical 466x466 watch
+ * screens frame by frame: an analog clock face with a digital time and
+ * step counter, a scrolling list, an icon launcher with two animating
+ * icons, and a notification sliding over a clock.
+ *
+ * usage: ui_region_list_bench [frames]
+ */
+
+#include <string.h>
+#include <ui_region.h>
+#include <test_common.h>
+
+TEST_MAIN_DEFINE();
+
+#define DISP_W 466
+#define DISP_H 466
+#define MAX_AREAS 32
+
+/* per-rect cost of the double buffer swap copy, in pixels */
+#define RECT_COST_PIXELS 1024
+
+typedef struct {
+	int num;
+	ui_region_t areas[MAX_AREAS];
+} frame_t;
+
+typedef void (*trace_fn)(int frame, frame_t *out);
+
+static void frame_add(frame_t *f, int x, int y, int w, int h)
+{
+	ui_region_t *r;
+
+	if (f->num >= MAX_AREAS || w <= 0 || h <= 0) {
+		return;
+	}
+
+	r = &f->areas[f->num++];
+	r->x1 = MAX(x, 0);
+	r->y1 = MAX(y, 0);
+	r->x2 = MIN(x + w - 1, DISP_W - 1);
+	r->y2 = MIN(y + h - 1, DISP_H - 1);
+}
+
+/* bounding box of a hand from the center at angle, 60 steps per turn */
+static void frame_add_hand(frame_t *f, int step, int len, int width)
+{
+	static const int8_t sin60[60] = {
+		0, 10, 21, 31, 41, 50, 59, 67, 74, 81, 87, 91, 95, 98, 99,
+		100, 99, 98, 95, 91, 87, 81, 74, 67, 59, 50, 41, 31, 21, 10,
+		0, -10, -21, -31, -41, -50, -59, -67, -74, -81, -87, -91, -95, -98, -99,
+		-100, -99, -98, -95, -91, -87, -81, -74, -67, -59, -50, -41, -31, -21, -10,
+	};
+	int cx = DISP_W / 2, cy = DISP_H / 2;
+	int ex = cx + sin60[step % 60] * len / 100;
+	int ey = cy - sin60[(step + 15) % 60] * len / 100;
+
+	frame_add(f, MIN(cx, ex) - width, MIN(cy, ey) - width,
+			abs(ex - cx) + 2 * width + 1, abs(ey - cy) + 2 * width + 1);
+}
+
+static void trace_clock(int frame, frame_t *f)
+{
+	/* second hand moves every frame, old and new position */
+	frame_add_hand(f, frame, 200, 4);
+	frame_add_hand(f, frame + 1, 200, 4);
+
+	/* minute hand every 60 frames */
+	if (frame % 60 == 0) {
+		frame_add_hand(f, frame / 60, 170, 8);
+		frame_add_hand(f, frame / 60 + 1, 170, 8);
+	}
+
+	/* digital time and step count in the lower half */
+	frame_add(f, 173, 300, 120, 36);
+	if (frame % 7 == 0) {
+		frame_add(f, 193, 350, 80, 24);
+	}
+}
+
+static void trace_list(int frame, frame_t *f)
+{
+	/* the list scrolls and redraws fully, plus the scrollbar */
+	int dy = (frame % 40) * 4;
+
+	frame_add(f, 40, 60, 386, 346);
+	frame_add(f, 440, 60 + dy, 6, 60);
+	frame_add(f, 440, 60 + dy - 4, 6, 4);
+}
+
+static void trace_launcher(int frame, frame_t *f)
+{
+	/* two pulsing icons in opposite corners of a 3x3 grid and a badge */
+	int s = 4 + (frame % 8);
+
+	frame_add(f, 80 - s, 80 - s, 80 + 2 * s, 80 + 2 * s);
+	frame_add(f, 306 - s, 306 - s, 80 + 2 * s, 80 + 2 * s);
+	if (frame % 30 == 0) {
+		frame_add(f, 280, 180, 24, 24);
+	}
+}
+
+static void trace_notification(int frame, frame_t *f)
+{
+	/* a banner slides down over the clock and stays, then slides up */
+	int phase = frame % 120;
+	int y;
+
+	trace_clock(frame, f);
+
+	if (phase < 20) {
+		y = -100 + phase * 6;
+	} else if (phase < 100) {
+		return;
+	} else {
+		y = 20 - (phase - 100) * 6;
+	}
+
+	frame_add(f, 60, y - 6, 346, 112);
+}
+
+static const struct {
+	const char *name;
+	trace_fn fn;
+} traces[] = {
+	{ "clock", trace_clock, },
+	{ "list", trace_list, },
+	{ "launcher", trace_launcher, },
+	{ "notification", trace_notification, },
+};
+
+/* exact pixel count of the union, by scanline */
+static int64_t union_pixels(const frame_t *f)
+{
+	static uint8_t row[DISP_W];
+	int64_t n = 0;
+
+	for (int y = 0; y < DISP_H; y++) {
+		memset(row, 0, sizeof(row));
+		for (int i = 0; i < f->num; i++) {
+			const ui_region_t *r = &f->areas[i];
+
+			if (y >= r->y1 && y <= r->y2) {
+				memset(&row[r->x1], 1, r->x2 - r->x1 + 1);
+			}
+		}
+		for (int x = 0; x < DISP_W; x++) {
+			n += row[x];
+		}
+	}
+
+	return n;
+}
+
+int main(int argc, char **argv)
+{
+	const ui_region_cost_t cost = {
+		.pixel_cost = 1,
+		.rect_cost = RECT_COST_PIXELS,
+	};
+	int num_frames = (argc > 1) ? atoi(argv[1]) : 240;
+
+	printf("%-14s %12s %12s %12s %8s %8s %10s\n", "trace", "bbox px",
+			"list px", "exact px", "saved", "rects", "ns/frame");
+
+	for (int t = 0; t < ARRAY_SIZE(traces); t++) {
+		int64_t bbox_px = 0, list_px = 0, exact_px = 0, rects = 0;
+		uint64_t ns = 0;
+
+		for (int frame = 0; frame < num_frames; frame++) {
+			ui_region_list_t list;
+			ui_region_t bbox;
+			frame_t f = { .num = 0, };
+			uint64_t start;
+
+			traces[t].fn(frame, &f);
+			if (f.num == 0) {
+				continue;
+			}
+
+			bbox = f.areas[0];
+			for (int i = 1; i < f.num; i++) {
+				ui_region_merge(&bbox, &bbox, &f.areas[i]);
+			}
+
+			start = test_time_ns();
+			ui_region_list_init(&list);
+			for (int i = 0; i < f.num; i++) {
+				ui_region_list_add(&list, &f.areas[i]);
+			}
+			ui_region_list_coalesce(&list, &cost);
+			ns += test_time_ns() - start;
+
+			bbox_px += ui_region_get_size(&bbox);
+			list_px += ui_region_list_get_size(&list);
+			exact_px += union_pixels(&f);
+			rects += list.count;
+		}
+
+		printf("%-14s %12lld %12lld %12lld %7.1f%% %8.2f %10llu\n", traces[t].name,
+				(long long)bbox_px, (long long)list_px, (long long)exact_px,
+				bbox_px ? 100.0 * (bbox_px - list_px) / bbox_px : 0.0,
+				(double)rects / num_frames,
+				(unsigned long long)(ns / num_frames));
+
+		TEST_CHECK(list_px <= bbox_px);
+		TEST_CHECK(list_px >= exact_px);
+	}
+
+	return TEST_RESULT();
+}
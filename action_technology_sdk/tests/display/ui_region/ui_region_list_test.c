@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Property tests of ui_region_list against a pixel bitmap model.
+ *
+ * After every random operation the list must hold non-overlapping valid
+ * rectangles within capacity, and cover at least the pixels the model says
+ * it must (it may cover more after a capacity overflow, never fewer).
+ */
+
+#include <string.h>
+#include <ui_region.h>
+#include <test_common.h>
+
+TEST_MAIN_DEFINE();
+
+#define W 96
+#define H 96
+#define NUM_ROUNDS 20000
+
+typedef struct {
+	uint8_t px[H][W];
+} bitmap_t;
+
+static uint32_t seed = 0x2026u;
+
+static void bitmap_fill(bitmap_t *bm, const ui_region_t *r, uint8_t v)
+{
+	for (int y = r->y1; y <= r->y2; y++) {
+		memset(&bm->px[y][r->x1], v, r->x2 - r->x1 + 1);
+	}
+}
+
+static void bitmap_from_list(bitmap_t *bm, const ui_region_list_t *list)
+{
+	memset(bm, 0, sizeof(*bm));
+	for (int i = 0; i < list->count; i++) {
+		bitmap_fill(bm, &list->rects[i], 1);
+	}
+}
+
+static int bitmap_count(const bitmap_t *bm)
+{
+	int n = 0;
+
+	for (int y = 0; y < H; y++) {
+		for (int x = 0; x < W; x++) {
+			n += bm->px[y][x];
+		}
+	}
+
+	return n;
+}
+
+/* every pixel set in sub is set in super */
+static bool bitmap_is_in(const bitmap_t *sub, const bitmap_t *super)
+{
+	for (int y = 0; y < H; y++) {
+		for (int x = 0; x < W; x++) {
+			if (sub->px[y][x] && !super->px[y][x]) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+static bool bitmap_equal(const bitmap_t *a, const bitmap_t *b)
+{
+	return memcmp(a, b, sizeof(*a)) == 0;
+}
+
+static void random_rect(ui_region_t *r, int max_size)
+{
+	int w = test_rand_range(&seed, 1, max_size);
+	int h = test_rand_range(&seed, 1, max_size);
+
+	r->x1 = test_rand_range(&seed, 0, W - w);
+	r->y1 = test_rand_range(&seed, 0, H - h);
+	r->x2 = r->x1 + w - 1;
+	r->y2 = r->y1 + h - 1;
+}
+
+static void check_invariants(const ui_region_list_t *list)
+{
+	TEST_CHECK(list->count <= UI_REGION_LIST_MAX_RECTS);
+
+	for (int i = 0; i < list->count; i++) {
+		TEST_CHECK(ui_region_is_valid(&list->rects[i]));
+		for (int j = i + 1; j < list->count; j++) {
+			TEST_CHECK_MSG(!ui_region_is_on(&list->rects[i], &list->rects[j]),
+					"rects %d and %d overlap", i, j);
+		}
+	}
+}
+
+static int64_t list_cost(const ui_region_list_t *list, const ui_region_cost_t *cost)
+{
+	return (int64_t)cost->pixel_cost * ui_region_list_get_size(list) +
+			(int64_t)cost->rect_cost * list->count;
+}
+
+/* rectangles of a list are disjoint, so its size must equal the pixel count */
+static void check_size(const ui_region_list_t *list)
+{
+	bitmap_t got;
+
+	bitmap_from_list(&got, list);
+	TEST_CHECK(ui_region_list_get_size(list) == bitmap_count(&got));
+}
+
+static void test_add_exact_below_capacity(void)
+{
+	for (int round = 0; round < NUM_ROUNDS / 10; round++) {
+		ui_region_list_t list;
+		bitmap_t model, got;
+		ui_region_t r;
+
+		ui_region_list_init(&list);
+		memset(&model, 0, sizeof(model));
+
+		/* disjoint rectangles, one per grid cell, never overflow */
+		for (int i = 0; i < UI_REGION_LIST_MAX_RECTS; i++) {
+			int cell = W / UI_REGION_LIST_MAX_RECTS;
+
+			r.x1 = i * cell + test_rand_range(&seed, 0, cell / 2 - 1);
+			r.x2 = r.x1 + test_rand_range(&seed, 0, cell / 2 - 1);
+			r.y1 = test_rand_range(&seed, 0, H / 2);
+			r.y2 = r.y1 + test_rand_range(&seed, 0, H / 2 - 1);
+
+			ui_region_list_add(&list, &r);
+			bitmap_fill(&model, &r, 1);
+		}
+
+		bitmap_from_list(&got, &list);
+		TEST_CHECK(list.count == UI_REGION_LIST_MAX_RECTS);
+		TEST_CHECK(bitmap_equal(&got, &model));
+		check_invariants(&list);
+	}
+}
+
+static void test_add_covers(void)
+{
+	ui_region_list_t list;
+	bitmap_t model, got;
+	ui_region_t r;
+
+	for (int round = 0; round < NUM_ROUNDS; round++) {
+		if (round % 16 == 0) {
+			ui_region_list_init(&list);
+			memset(&model, 0, sizeof(model));
+		}
+
+		random_rect(&r, 40);
+		ui_region_list_add(&list, &r);
+		bitmap_fill(&model, &r, 1);
+
+		bitmap_from_list(&got, &list);
+		TEST_CHECK(bitmap_is_in(&model, &got));
+		check_invariants(&list);
+		check_size(&list);
+
+		/* adding a region inside the list changes nothing */
+		if (list.count > 0) {
+			ui_region_list_t copy = list;
+
+			ui_region_list_add(&list, &list.rects[0]);
+			TEST_CHECK(memcmp(&copy, &list, sizeof(list)) == 0);
+		}
+	}
+}
+
+static void test_subtract(void)
+{
+	for (int round = 0; round < NUM_ROUNDS; round++) {
+		ui_region_list_t list;
+		bitmap_t model, before, got;
+		ui_region_t r, ex;
+		int n = test_rand_range(&seed, 1, 12);
+
+		ui_region_list_init(&list);
+		for (int i = 0; i < n; i++) {
+			random_rect(&r, 48);
+			ui_region_list_add(&list, &r);
+		}
+
+		bitmap_from_list(&before, &list);
+		model = before;
+		random_rect(&ex, 64);
+		bitmap_fill(&model, &ex, 0);
+
+		ui_region_list_subtract(&list, &ex);
+		bitmap_from_list(&got, &list);
+
+		/* never adds pixels, removes at least what fits in the capacity */
+		TEST_CHECK(bitmap_is_in(&got, &before));
+		TEST_CHECK(bitmap_is_in(&model, &got));
+		check_invariants(&list);
+
+		/* with room for every split the result is exact */
+		if (n == 1 && UI_REGION_LIST_MAX_RECTS >= 4) {
+			TEST_CHECK(bitmap_equal(&got, &model));
+		}
+	}
+}
+
+static void test_intersect(void)
+{
+	for (int round = 0; round < NUM_ROUNDS; round++) {
+		ui_region_list_t list;
+		bitmap_t model, clipped, got;
+		ui_region_t r, clip;
+		bool nonempty;
+
+		ui_region_list_init(&list);
+		for (int i = test_rand_range(&seed, 0, 10); i > 0; i--) {
+			random_rect(&r, 48);
+			ui_region_list_add(&list, &r);
+		}
+
+		bitmap_from_list(&model, &list);
+		random_rect(&clip, 64);
+		memset(&clipped, 0, sizeof(clipped));
+		for (int y = clip.y1; y <= clip.y2; y++) {
+			for (int x = clip.x1; x <= clip.x2; x++) {
+				clipped.px[y][x] = model.px[y][x];
+			}
+		}
+
+		nonempty = ui_region_list_intersect(&list, &clip);
+		bitmap_from_list(&got, &list);
+
+		/* clipping is always exact */
+		TEST_CHECK(bitmap_equal(&got, &clipped));
+		TEST_CHECK(nonempty == (bitmap_count(&clipped) > 0));
+		check_invariants(&list);
+	}
+}
+
+static void test_union(void)
+{
+	for (int round = 0; round < NUM_ROUNDS / 4; round++) {
+		ui_region_list_t a, b;
+		bitmap_t model_a, model_b, got;
+		ui_region_t r;
+
+		ui_region_list_init(&a);
+		ui_region_list_init(&b);
+		for (int i = test_rand_range(&seed, 0, 6); i > 0; i--) {
+			random_rect(&r, 32);
+			ui_region_list_add(&a, &r);
+		}
+		for (int i = test_rand_range(&seed, 0, 6); i > 0; i--) {
+			random_rect(&r, 32);
+			ui_region_list_add(&b, &r);
+		}
+
+		bitmap_from_list(&model_a, &a);
+		bitmap_from_list(&model_b, &b);
+
+		ui_region_list_union(&a, &b);
+		bitmap_from_list(&got, &a);
+
+		TEST_CHECK(bitmap_is_in(&model_a, &got));
+		TEST_CHECK(bitmap_is_in(&model_b, &got));
+		check_invariants(&a);
+	}
+}
+
+static void test_coalesce(void)
+{
+	static const ui_region_cost_t costs[] = {
+		{ .pixel_cost = 1, .rect_cost = 0, },
+		{ .pixel_cost = 1, .rect_cost = 64, },
+		{ .pixel_cost = 1, .rect_cost = 1024, },
+		{ .pixel_cost = 1, .rect_cost = 100000, },
+	};
+
+	for (int round = 0; round < NUM_ROUNDS; round++) {
+		const ui_region_cost_t *cost = &costs[round % ARRAY_SIZE(costs)];
+		ui_region_list_t list;
+		bitmap_t before, got;
+		ui_region_t r, bounds_before, bounds;
+		int64_t cost_before;
+
+		ui_region_list_init(&list);
+		for (int i = test_rand_range(&seed, 1, 12); i > 0; i--) {
+			random_rect(&r, 24);
+			ui_region_list_add(&list, &r);
+		}
+
+		bitmap_from_list(&before, &list);
+		cost_before = list_cost(&list, cost);
+		ui_region_list_get_bounds(&bounds_before, &list);
+
+		ui_region_list_coalesce(&list, cost);
+		bitmap_from_list(&got, &list);
+
+		TEST_CHECK(bitmap_is_in(&before, &got));
+		TEST_CHECK(list_cost(&list, cost) <= cost_before);
+		TEST_CHECK(ui_region_list_get_bounds(&bounds, &list));
+		TEST_CHECK(ui_region_is_in(&bounds, &bounds_before));
+		check_invariants(&list);
+
+		/* free rectangles never merge, prohibitive ones always do */
+		if (cost->rect_cost == 0) {
+			TEST_CHECK(bitmap_equal(&got, &before));
+		} else if (cost->rect_cost >= W * H) {
+			TEST_CHECK(list.count == 1);
+		}
+	}
+}
+
+static void test_empty(void)
+{
+	ui_region_list_t list;
+	ui_region_t r = { .x1 = 5, .y1 = 5, .x2 = 4, .y2 = 9, };
+	ui_region_t bounds;
+
+	ui_region_list_init(&list);
+	TEST_CHECK(ui_region_list_is_empty(&list));
+	TEST_CHECK(!ui_region_list_get_bounds(&bounds, &list));
+
+	ui_region_list_add(&list, &r);
+	TEST_CHECK(ui_region_list_is_empty(&list));
+	TEST_CHECK(ui_region_list_get_size(&list) == 0);
+	TEST_CHECK(!ui_region_list_is_on(&list, &r));
+}
+
+int main(void)
+{
+	TEST_RUN(test_empty);
+	TEST_RUN(test_add_exact_below_capacity);
+	TEST_RUN(test_add_covers);
+	TEST_RUN(test_subtract);
+	TEST_RUN(test_intersect);
+	TEST_RUN(test_union);
+	TEST_RUN(test_coalesce);
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,383 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Emulated I2CMT and SPIMT buses for the host tests of sensor_bus.c, see
+ * sensor_bus_emul.h.
+ */
+
+#include <os_common_api.h>
+#include <device.h>
+#include <soc.h>
+#include <drivers/i2cmt.h>
+#include <drivers/spimt.h>
+#include <sensor_bus.h>
+#include "sensor_bus_emul.h"
+
+#define EMUL_NUM_BUS		(NUM_BUS * 2)
+#define EMUL_RX_MAX			(256)
+#define EMUL_QUEUE_LEN		(16)
+
+typedef struct {
+	void (*cb)(unsigned char *buf, int len, void *ctx);
+	void *ctx;
+	const void *attr;
+	uint32_t gen;       // start count, a stopped task is not run
+	bool pending;
+	bool rx_valid;
+	int rx_len;
+	uint8_t rx[EMUL_RX_MAX];
+} emul_task_t;
+
+typedef struct {
+	int bus_type;
+	int bus_id;
+	emul_sensor_t *sensor;
+	int nack_in;
+	int tasks;
+	emul_task_t task[SPI_TASK_NUM];
+} emul_bus_t;
+
+typedef struct {
+	emul_bus_t *bus;
+	int task_id;
+	uint32_t gen;
+} emul_req_t;
+
+static emul_bus_t emul_buses[EMUL_NUM_BUS];
+static int emul_xfer_us = 30;
+
+static pthread_once_t emul_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t emul_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t emul_cond = PTHREAD_COND_INITIALIZER;
+static emul_req_t emul_queue[EMUL_QUEUE_LEN];
+static int emul_head, emul_tail;
+
+static emul_bus_t *emul_bus(int bus_type, int bus_id)
+{
+	return &emul_buses[bus_type * 2 + bus_id];
+}
+
+static void emul_write(emul_sensor_t *s, const uint8_t *buf, int len)
+{
+	int i = 0;
+
+	/* register address first */
+	if (len > 0) {
+		s->ptr = 0;
+		for (; (i < s->adr_len) && (i < len); i++) {
+			s->ptr = (s->ptr << 8) | buf[i];
+		}
+	}
+
+	for (; i < len; i++) {
+		s->regs[s->ptr++] = buf[i];
+	}
+}
+
+static uint8_t emul_read(emul_sensor_t *s)
+{
+	if ((s->ptr == s->fifo_reg) && (s->fifo_len > 0)) {
+		return s->fifo[s->fifo_pos++ % s->fifo_len];
+	}
+
+	return s->regs[s->ptr++];
+}
+
+static bool emul_i2c_run(emul_bus_t *bus, emul_task_t *t, const i2c_task_t *task)
+{
+	emul_sensor_t *s = bus->sensor;
+	const uint8_t *data = (const uint8_t *)(uintptr_t)task->dma.addr;
+	uint8_t wr[1 + EMUL_RX_MAX];
+	int i, n = 0;
+
+	if ((s == NULL) || (task->ctl.sdevaddr != s->addr) || (task->dma.len > EMUL_RX_MAX)) {
+		return false;
+	}
+
+	if (!task->ctl.tdataddr) {
+		wr[n++] = task->ctl.sdataddr;
+	}
+
+	if (!task->ctl.rwsel) {
+		for (i = 0; i < task->dma.len; i++) {
+			wr[n++] = data[i];
+		}
+		emul_write(s, wr, n);
+		return true;
+	}
+
+	emul_write(s, wr, n);
+	for (i = 0; i < task->dma.len; i++) {
+		t->rx[i] = emul_read(s);
+	}
+	t->rx_len = task->dma.len;
+	t->rx_valid = true;
+	return true;
+}
+
+static bool emul_spi_run(emul_bus_t *bus, emul_task_t *t, const spi_task_t *task)
+{
+	emul_sensor_t *s = bus->sensor;
+	const uint8_t *data = (const uint8_t *)(uintptr_t)task->dma.addr;
+	uint16_t rd_bit = task->ctl.sbsh ? (1 << 15) : (1 << 7);
+	int i;
+
+	if ((s == NULL) || (task->dma.len > EMUL_RX_MAX)) {
+		return false;
+	}
+
+	s->ptr = task->ctl.wsdat & ~rd_bit;
+
+	if (!task->ctl.rwsel) {
+		for (i = 0; i < task->dma.len; i++) {
+			s->regs[s->ptr++] = data[i];
+		}
+		return true;
+	}
+
+	for (i = 0; i < task->dma.len; i++) {
+		t->rx[i] = emul_read(s);
+	}
+	t->rx_len = task->dma.len;
+	t->rx_valid = true;
+	return true;
+}
+
+/* task irq of a request, under irq_lock() */
+static void emul_complete(const emul_req_t *req)
+{
+	emul_bus_t *bus = req->bus;
+	emul_task_t *t = &bus->task[req->task_id];
+	bool ok;
+
+	if (!t->pending || (t->gen != req->gen)) {
+		return;
+	}
+
+	bus->tasks++;
+	if (bus->bus_type == BUS_I2C) {
+		ok = emul_i2c_run(bus, t, t->attr);
+	} else {
+		ok = emul_spi_run(bus, t, t->attr);
+	}
+
+	if (bus->nack_in == 0) {
+		ok = false;
+	}
+	if (bus->nack_in >= 0) {
+		bus->nack_in--;
+	}
+
+	t->pending = false;
+	if (t->cb) {
+			t->cb(ok ? t->rx : NULL, ok ? t->rx_len : 0, t->ctx);
+	}
+}
+
+static void *emul_thread(void *arg)
+{
+	emul_req_t req;
+	unsigned int key;
+
+	for (;;) {
+		pthread_mutex_lock(&emul_lock);
+		while (emul_head == emul_tail) {
+			pthread_cond_wait(&emul_cond, &emul_lock);
+		}
+		req = emul_queue[emul_tail++ % EMUL_QUEUE_LEN];
+		pthread_mutex_unlock(&emul_lock);
+
+		/* transfer time */
+		k_busy_wait(emul_xfer_us);
+
+		key = irq_lock();
+		emul_complete(&req);
+		irq_unlock(key);
+	}
+
+	return NULL;
+}
+
+static void emul_thread_start(void)
+{
+	pthread_t thread;
+
+	pthread_create(&thread, NULL, emul_thread, NULL);
+	pthread_detach(thread);
+}
+
+static int emul_task_start(emul_bus_t *bus, int task_id, const void *attr)
+{
+	emul_task_t *t = &bus->task[task_id];
+	unsigned int key;
+
+	pthread_once(&emul_once, emul_thread_start);
+
+	key = irq_lock();
+	t->attr = attr;
+	t->gen++;
+	t->pending = true;
+	t->rx_valid = false;
+
+	pthread_mutex_lock(&emul_lock);
+	emul_queue[emul_head++ % EMUL_QUEUE_LEN] = (emul_req_t) {
+		.bus = bus, .task_id = task_id, .gen = t->gen,
+	};
+	pthread_cond_signal(&emul_cond);
+	pthread_mutex_unlock(&emul_lock);
+	irq_unlock(key);
+
+	return 0;
+}
+
+/* cancel the task, and copy read data to the task buffer */
+static int emul_task_stop(emul_bus_t *bus, int task_id)
+{
+	emul_task_t *t = &bus->task[task_id];
+	unsigned int key;
+
+	key = irq_lock();
+	t->gen++;
+	t->pending = false;
+	if (t->rx_valid && t->attr) {
+		uint32_t addr, len;
+
+		if (bus->bus_type == BUS_I2C) {
+			addr = ((const i2c_task_t *)t->attr)->dma.addr;
+			len = ((const i2c_task_t *)t->attr)->dma.len;
+		} else {
+			addr = ((const spi_task_t *)t->attr)->dma.addr;
+			len = ((const spi_task_t *)t->attr)->dma.len;
+		}
+
+		memcpy((void *)(uintptr_t)addr, t->rx, MIN(t->rx_len, len));
+		t->rx_valid = false;
+	}
+	irq_unlock(key);
+
+	return 0;
+}
+
+static void emul_i2c_register_callback(struct device *dev, int task_id,
+		i2c_task_callback_t cb, void *ctx)
+{
+	emul_bus_t *bus = dev->data;
+
+	bus->task[task_id].cb = cb;
+	bus->task[task_id].ctx = ctx;
+}
+
+static int emul_i2c_task_start(struct device *dev, int task_id, const i2c_task_t *attr)
+{
+	return emul_task_start(dev->data, task_id, attr);
+}
+
+static int emul_i2c_task_stop(struct device *dev, int task_id)
+{
+	return emul_task_stop(dev->data, task_id);
+}
+
+static void emul_spi_register_callback(const struct device *dev, int task_id,
+		spi_task_callback_t cb, void *ctx)
+{
+	emul_bus_t *bus = dev->data;
+
+	bus->task[task_id].cb = cb;
+	bus->task[task_id].ctx = ctx;
+}
+
+static int emul_spi_task_start(const struct device *dev, int task_id, const spi_task_t *attr)
+{
+	return emul_task_start(dev->data, task_id, attr);
+}
+
+static int emul_spi_task_stop(const struct device *dev, int task_id)
+{
+	return emul_task_stop(dev->data, task_id);
+}
+
+static const struct i2cmt_driver_api emul_i2cmt_api = {
+	.register_callback = emul_i2c_register_callback,
+	.task_start = emul_i2c_task_start,
+	.task_stop = emul_i2c_task_stop,
+};
+
+static const struct spimt_driver_api emul_spimt_api = {
+	.register_callback = emul_spi_register_callback,
+	.task_start = emul_spi_task_start,
+	.task_stop = emul_spi_task_stop,
+};
+
+static const struct device emul_devices[] = {
+	{ "I2CMT_0", &emul_i2cmt_api, &emul_buses[BUS_I2C * 2 + 0], },
+	{ "I2CMT_1", &emul_i2cmt_api, &emul_buses[BUS_I2C * 2 + 1], },
+	{ "SPIMT_0", &emul_spimt_api, &emul_buses[BUS_SPI * 2 + 0], },
+	{ "SPIMT_1", &emul_spimt_api, &emul_buses[BUS_SPI * 2 + 1], },
+};
+
+const struct device *device_get_binding(const char *name)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(emul_devices); i++) {
+		if (!strcmp(emul_devices[i].name, name)) {
+			return &emul_devices[i];
+		}
+	}
+
+	return NULL;
+}
+
+int soc_in_sleep_mode(void)
+{
+	return 0;
+}
+
+uint64_t soc_sys_uptime_get(void)
+{
+	return k_uptime_get();
+}
+
+uint8_t *i2c_task_get_data(int bus_id, int task_id, int trig, int *plen)
+{
+	return NULL;
+}
+
+uint8_t *spi_task_get_data(int bus_id, int task_id, int trig, int *plen)
+{
+	return NULL;
+}
+
+void emul_attach(int bus_type, int bus_id, emul_sensor_t *sensor)
+{
+	emul_bus_t *bus = emul_bus(bus_type, bus_id);
+	unsigned int key = irq_lock();
+
+	bus->bus_type = bus_type;
+	bus->bus_id = bus_id;
+	bus->sensor = sensor;
+	bus->nack_in = -1;
+	irq_unlock(key);
+}
+
+void emul_inject_nack(int bus_type, int bus_id, int num)
+{
+	unsigned int key = irq_lock();
+
+	emul_bus(bus_type, bus_id)->nack_in = num;
+	irq_unlock(key);
+}
+
+void emul_set_xfer_us(int us)
+{
+	emul_xfer_us = us;
+}
+
+int emul_tasks(int bus_type, int bus_id)
+{
+	return emul_bus(bus_type, bus_id)->tasks;
+}
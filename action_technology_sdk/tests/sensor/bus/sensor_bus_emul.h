@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Emulated I2CMT and SPIMT buses with one sensor on each
+ *
+ * The devices "I2CMT_0/1" and "SPIMT_0/1" run the soft tasks of
+ * sensor_bus.c: a started task completes on the emulator thread after the
+ * transfer time, which calls the task callback under irq_lock() as the
+ * task irq would. Read data is copied to the task buffer when the task is
+ * stopped, as by the driver.
+ *
+ * The sensor is a register file with an auto-incremented register pointer,
+ * set by the first 1 or 2 bytes written on I2C, or by the command of the
+ * SPI task. Reads of the fifo register return the fifo bytes instead.
+ */
+
+#ifndef TESTS_SENSOR_BUS_SENSOR_BUS_EMUL_H_
+#define TESTS_SENSOR_BUS_SENSOR_BUS_EMUL_H_
+
+#include <stdint.h>
+
+typedef struct emul_sensor_s {
+	uint8_t addr;           // i2c slave address
+	uint8_t adr_len;        // register address bytes
+	uint16_t ptr;           // register pointer
+	uint16_t fifo_reg;      // register read from fifo, 0xffff if none
+	const uint8_t *fifo;
+	int fifo_len;
+	int fifo_pos;
+	uint8_t regs[0x10000];
+} emul_sensor_t;
+
+/* sensor on a bus, NULL for none (NACK) */
+void emul_attach(int bus_type, int bus_id, emul_sensor_t *sensor);
+
+/* NACK the task started after the next num tasks, -1 for none */
+void emul_inject_nack(int bus_type, int bus_id, int num);
+
+/* transfer time of a task in us */
+void emul_set_xfer_us(int us);
+
+/* tasks run on a bus, a task stopped before it completes is not run */
+int emul_tasks(int bus_type, int bus_id);
+
+#endif /* TESTS_SENSOR_BUS_SENSOR_BUS_EMUL_H_ */
@@ -0,0 +1,375 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Register transaction lists of sensor_bus.c on the emulated I2CMT and
+ * SPIMT buses (CONFIG_SENSOR_TASK_CFG, CONFIG_SENSOR_BUS_STAT).
+ *
+ * A list runs as a chain of soft tasks, the next one started from the
+ * task irq: contiguous burst reads are merged into one task and scattered,
+ * a 2 bytes address read takes an address task first, as the OTP read of
+ * the icp10125. The caller waits once for the list, or gets a callback.
+ * A NACK ends the list with an error, a timeout aborts it without a late
+ * callback. Single transfers of a bus are refused while its list runs.
+ *
+ * The DMA addresses of the tasks are 32 bits, the buffers are static and
+ * the test is linked at a low address.
+ */
+
+#include <os_common_api.h>
+#include <drivers/i2cmt.h>
+#include <drivers/spimt.h>
+#include <sensor_bus.h>
+#include <test_common.h>
+#include "sensor_bus_emul.h"
+
+TEST_MAIN_DEFINE();
+
+#define ACC_ADDR		(0x68)
+#define BARO_ADDR		(0x63)
+
+#define STRESS_LOOPS	(500)
+
+static const i2c_task_t acc_i2c_task = {
+	.ctl = {
+		.rwsel = 1,
+		.sdevaddr = ACC_ADDR,
+	},
+};
+
+static const i2c_task_t baro_i2c_task = {
+	.ctl = {
+		.rwsel = 1,
+		.sdevaddr = BARO_ADDR,
+	},
+};
+
+static const spi_task_t acc_spi_task = {
+	.ctl = {
+		.rwsel = 1,
+	},
+};
+
+static const sensor_dev_t acc_i2c = {
+	.hw = { .name = "acc_i2c", .dev_addr = ACC_ADDR, .adr_len = 1, .reg_len = 1, },
+	.io = { .bus_type = BUS_I2C, .bus_id = 0, },
+	.task = (void *)&acc_i2c_task,
+};
+
+static const sensor_dev_t baro_i2c = {
+	.hw = { .name = "icp10125", .dev_addr = BARO_ADDR, .adr_len = 2, .reg_len = 1, },
+	.io = { .bus_type = BUS_I2C, .bus_id = 1, },
+	.task = (void *)&baro_i2c_task,
+};
+
+static const sensor_dev_t acc_spi = {
+	.hw = { .name = "acc_spi", .adr_len = 1, .reg_len = 1, },
+	.io = { .bus_type = BUS_SPI, .bus_id = 0, .bus_cs = 0, },
+	.task = (void *)&acc_spi_task,
+};
+
+static emul_sensor_t acc_sensor, baro_sensor, spi_sensor;
+
+/* DMA buffers */
+static uint8_t status, data[2][6], wr_data[4], rd_data[4];
+
+static void fill_regs(emul_sensor_t *s)
+{
+	int i;
+
+	for (i = 0; i < 0x100; i++) {
+		s->regs[i] = (uint8_t)(i * 7 + 3);
+	}
+	s->regs[0x0f] = 0x01;
+}
+
+static void read_list(sensor_bus_msg_t *msgs)
+{
+	msgs[0] = (sensor_bus_msg_t) { 0x0f, 1, &status, SENSOR_BUS_MSG_READ, };
+	msgs[1] = (sensor_bus_msg_t) { 0x10, 6, data[0], SENSOR_BUS_MSG_READ | SENSOR_BUS_MSG_BURST, };
+	msgs[2] = (sensor_bus_msg_t) { 0x16, 6, data[1], SENSOR_BUS_MSG_READ | SENSOR_BUS_MSG_BURST, };
+}
+
+static bool check_read(const emul_sensor_t *s)
+{
+	int i;
+
+	if (status != s->regs[0x0f]) {
+		return false;
+	}
+
+	for (i = 0; i < 12; i++) {
+		if (data[i / 6][i % 6] != s->regs[0x10 + i]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void test_merge(const sensor_dev_t *dev, const emul_sensor_t *s)
+{
+	sensor_bus_msg_t msgs[3];
+	sensor_bus_stat_t stat;
+	int tasks = emul_tasks(dev->io.bus_type, dev->io.bus_id);
+
+	sensor_bus_clear_stat(dev->io.bus_type, dev->io.bus_id);
+	memset(data, 0, sizeof(data));
+	status = 0;
+
+	read_list(msgs);
+	TEST_CHECK(sensor_bus_xfer_list(dev, msgs, 3) == 0);
+	TEST_CHECK(check_read(s));
+
+	/* status and data in one task */
+	TEST_CHECK(emul_tasks(dev->io.bus_type, dev->io.bus_id) == tasks + 1);
+
+	TEST_CHECK(sensor_bus_get_stat(dev->io.bus_type, dev->io.bus_id, &stat) == 0);
+	TEST_CHECK_MSG(stat.xfer_cnt == 1 && stat.list_cnt == 1 && stat.merge_cnt == 2
+			&& stat.bytes == 13 && stat.err_cnt == 0,
+			"%s: xfer %u list %u merge %u bytes %u err %u", dev->hw.name, stat.xfer_cnt,
+			stat.list_cnt, stat.merge_cnt, (uint32_t)stat.bytes, stat.err_cnt);
+}
+
+static void test_i2c_merge(void)
+{
+	test_merge(&acc_i2c, &acc_sensor);
+}
+
+static void test_spi_merge(void)
+{
+	test_merge(&acc_spi, &spi_sensor);
+}
+
+/* write, then read back, then a read not contiguous: three tasks */
+static void test_write_read(void)
+{
+	const sensor_dev_t *devs[] = { &acc_i2c, &acc_spi, };
+	const emul_sensor_t *sensors[] = { &acc_sensor, &spi_sensor, };
+	sensor_bus_msg_t msgs[3];
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(devs); i++) {
+		const sensor_dev_t *dev = devs[i];
+		int tasks = emul_tasks(dev->io.bus_type, dev->io.bus_id);
+
+		wr_data[0] = 0x5a + i;
+		wr_data[1] = 0xa5 - i;
+		memset(rd_data, 0, sizeof(rd_data));
+		status = 0;
+
+		msgs[0] = (sensor_bus_msg_t) { 0x40, 2, wr_data, 0, };
+		msgs[1] = (sensor_bus_msg_t) { 0x40, 2, rd_data, SENSOR_BUS_MSG_READ, };
+		msgs[2] = (sensor_bus_msg_t) { 0x0f, 1, &status, SENSOR_BUS_MSG_READ | SENSOR_BUS_MSG_BURST, };
+
+		TEST_CHECK(sensor_bus_xfer_list(dev, msgs, 3) == 0);
+		TEST_CHECK(sensors[i]->regs[0x40] == wr_data[0] && sensors[i]->regs[0x41] == wr_data[1]);
+		TEST_CHECK_MSG(!memcmp(rd_data, wr_data, 2), "%s: %02x %02x", dev->hw.name,
+				rd_data[0], rd_data[1]);
+		TEST_CHECK(status == sensors[i]->regs[0x0f]);
+		TEST_CHECK(emul_tasks(dev->io.bus_type, dev->io.bus_id) == tasks + 3);
+	}
+}
+
+/* the OTP read of the icp10125: a command with data, 4 command reads */
+static void test_otp_list(void)
+{
+	static const uint8_t otp[12] = {
+		0x12, 0x34, 0xaa, 0x56, 0x78, 0xbb, 0x9a, 0xbc, 0xcc, 0xde, 0xf0, 0xdd,
+	};
+	static uint8_t mode[3] = { 0x00, 0x66, 0x9c };
+	static uint8_t buf[4][3];
+	sensor_bus_msg_t msgs[5];
+	int i, tasks = emul_tasks(BUS_I2C, 1);
+
+	baro_sensor.fifo = otp;
+	baro_sensor.fifo_len = sizeof(otp);
+	baro_sensor.fifo_pos = 0;
+
+	msgs[0] = (sensor_bus_msg_t) { 0xc595, 3, mode, 0, };
+	for (i = 0; i < 4; i++) {
+		msgs[i + 1] = (sensor_bus_msg_t) { 0xc7f7, 3, buf[i], SENSOR_BUS_MSG_READ, };
+	}
+
+	TEST_CHECK(sensor_bus_xfer_list(&baro_i2c, msgs, 5) == 0);
+	TEST_CHECK(!memcmp(&baro_sensor.regs[0xc595], mode, 3));
+	for (i = 0; i < 4; i++) {
+		TEST_CHECK_MSG(!memcmp(buf[i], &otp[i * 3], 3), "otp %d: %02x%02x", i,
+				buf[i][0], buf[i][1]);
+	}
+
+	/* the write, then address and data task for each read */
+	TEST_CHECK(emul_tasks(BUS_I2C, 1) == tasks + 9);
+}
+
+static os_sem list_done;
+static int list_ret;
+
+static void list_cb(int ret, void *ctx)
+{
+	list_ret = ret;
+	os_sem_give((os_sem *)ctx);
+}
+
+static void test_async(void)
+{
+	sensor_bus_msg_t msgs[3], other[1];
+
+	os_sem_init(&list_done, 0, 1);
+	memset(data, 0, sizeof(data));
+	read_list(msgs);
+	msgs[2].flags = SENSOR_BUS_MSG_READ; // not merged, three tasks
+	other[0] = msgs[0];
+	list_ret = 1;
+
+	emul_set_xfer_us(2000);
+	TEST_CHECK(sensor_bus_list_start(&acc_i2c, msgs, 3, list_cb, &list_done) == 0);
+
+	/* the task of the bus is taken until the list is done */
+	TEST_CHECK(sensor_bus_read(&acc_i2c, 0x0f, &status, 1) == -EBUSY);
+	TEST_CHECK(sensor_bus_list_start(&acc_i2c, other, 1, list_cb, &list_done) == -EBUSY);
+
+	/* another bus runs at the same time */
+	TEST_CHECK(sensor_bus_xfer_list(&acc_spi, other, 1) == 0);
+
+	TEST_CHECK(os_sem_take(&list_done, 1000) == 0);
+	emul_set_xfer_us(30);
+
+	TEST_CHECK(list_ret == 0);
+	TEST_CHECK(check_read(&acc_sensor));
+	TEST_CHECK(sensor_bus_read(&acc_i2c, 0x0f, &status, 1) == 0);
+}
+
+static void test_nack(void)
+{
+	sensor_bus_msg_t msgs[3];
+	sensor_bus_stat_t stat;
+	int tasks = emul_tasks(BUS_I2C, 0);
+
+	sensor_bus_clear_stat(BUS_I2C, 0);
+	read_list(msgs);
+	msgs[1].flags = SENSOR_BUS_MSG_READ;
+	msgs[2].flags = SENSOR_BUS_MSG_READ;
+
+	/* the second task fails, the third is not started */
+	emul_inject_nack(BUS_I2C, 0, 1);
+	TEST_CHECK(sensor_bus_xfer_list(&acc_i2c, msgs, 3) == -1);
+	TEST_CHECK(emul_tasks(BUS_I2C, 0) == tasks + 2);
+
+	TEST_CHECK(sensor_bus_get_stat(BUS_I2C, 0, &stat) == 0);
+	TEST_CHECK(stat.xfer_cnt == 2 && stat.err_cnt == 1 && stat.list_cnt == 1);
+
+	/* no sensor on the bus */
+	emul_attach(BUS_I2C, 0, NULL);
+	TEST_CHECK(sensor_bus_xfer_list(&acc_i2c, msgs, 3) == -1);
+	emul_attach(BUS_I2C, 0, &acc_sensor);
+
+	TEST_CHECK(sensor_bus_xfer_list(&acc_i2c, msgs, 3) == 0);
+	TEST_CHECK(check_read(&acc_sensor));
+}
+
+/* the task is stopped at the timeout, it never completes */
+static void test_timeout(void)
+{
+	sensor_bus_msg_t msgs[1] = { { 0x0f, 1, &status, SENSOR_BUS_MSG_READ, }, };
+	int tasks = emul_tasks(BUS_I2C, 0);
+
+	emul_set_xfer_us(40 * 1000);
+	TEST_CHECK(sensor_bus_xfer_list(&acc_i2c, msgs, 1) == -1);
+	emul_set_xfer_us(30);
+
+	/* no late irq of the stopped task */
+	k_msleep(50);
+	TEST_CHECK(emul_tasks(BUS_I2C, 0) == tasks);
+
+	/* the bus is free again */
+	TEST_CHECK(sensor_bus_xfer_list(&acc_i2c, msgs, 1) == 0);
+}
+
+typedef struct {
+	const sensor_dev_t *dev;
+	const emul_sensor_t *sensor;
+	uint8_t buf[16];
+	int errors;
+} stress_t;
+
+static stress_t stress[2] = {
+	{ &acc_i2c, &acc_sensor, },
+	{ &acc_spi, &spi_sensor, },
+};
+
+static void *stress_thread(void *arg)
+{
+	stress_t *st = arg;
+	sensor_bus_msg_t msgs[2];
+	int i;
+
+	msgs[0] = (sensor_bus_msg_t) { 0x10, 4, &st->buf[0], SENSOR_BUS_MSG_READ, };
+	msgs[1] = (sensor_bus_msg_t) { 0x14, 8, &st->buf[4], SENSOR_BUS_MSG_READ | SENSOR_BUS_MSG_BURST, };
+
+	for (i = 0; i < STRESS_LOOPS; i++) {
+		memset(st->buf, 0, sizeof(st->buf));
+		if (sensor_bus_xfer_list(st->dev, msgs, 2)
+			|| memcmp(st->buf, &st->sensor->regs[0x10], 12)) {
+			st->errors++;
+		}
+	}
+
+	return NULL;
+}
+
+/* lists on two buses at once, every transfer counted once */
+static void test_stress(void)
+{
+	pthread_t threads[ARRAY_SIZE(stress)];
+	sensor_bus_stat_t stat;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(stress); i++) {
+		sensor_bus_clear_stat(stress[i].dev->io.bus_type, stress[i].dev->io.bus_id);
+		pthread_create(&threads[i], NULL, stress_thread, &stress[i]);
+	}
+
+	for (i = 0; i < ARRAY_SIZE(stress); i++) {
+		pthread_join(threads[i], NULL);
+		TEST_CHECK_MSG(stress[i].errors == 0, "%s: %d errors", stress[i].dev->hw.name,
+				stress[i].errors);
+
+		sensor_bus_get_stat(stress[i].dev->io.bus_type, stress[i].dev->io.bus_id, &stat);
+		TEST_CHECK(stat.list_cnt == STRESS_LOOPS && stat.xfer_cnt == STRESS_LOOPS
+				&& stat.merge_cnt == STRESS_LOOPS && stat.bytes == STRESS_LOOPS * 12);
+	}
+}
+
+int main(void)
+{
+	acc_sensor.addr = ACC_ADDR;
+	acc_sensor.adr_len = 1;
+	acc_sensor.fifo_reg = REG_NULL;
+	fill_regs(&acc_sensor);
+	emul_attach(BUS_I2C, 0, &acc_sensor);
+
+	baro_sensor.addr = BARO_ADDR;
+	baro_sensor.adr_len = 2;
+	baro_sensor.fifo_reg = 0xc7f7;
+	emul_attach(BUS_I2C, 1, &baro_sensor);
+
+	spi_sensor.adr_len = 1;
+	spi_sensor.fifo_reg = REG_NULL;
+	fill_regs(&spi_sensor);
+	emul_attach(BUS_SPI, 0, &spi_sensor);
+
+	TEST_RUN(test_i2c_merge);
+	TEST_RUN(test_spi_merge);
+	TEST_RUN(test_write_read);
+	TEST_RUN(test_otp_list);
+	TEST_RUN(test_async);
+	TEST_RUN(test_nack);
+	TEST_RUN(test_timeout);
+	TEST_RUN(test_stress);
+
+	return TEST_RESULT();
+}
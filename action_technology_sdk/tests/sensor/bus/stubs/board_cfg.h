@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* no board pins are used by the code under test on the host */
+
+#ifndef TESTS_SENSOR_BUS_STUBS_BOARD_CFG_H_
+#define TESTS_SENSOR_BUS_STUBS_BOARD_CFG_H_
+
+#endif /* TESTS_SENSOR_BUS_STUBS_BOARD_CFG_H_ */
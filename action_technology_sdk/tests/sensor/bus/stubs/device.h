@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Host stand-in of the Zephyr device model, the bus devices are the
+ *        emulated ones of sensor_bus_emul.c
+ */
+
+#ifndef TESTS_SENSOR_BUS_STUBS_DEVICE_H_
+#define TESTS_SENSOR_BUS_STUBS_DEVICE_H_
+
+#include <init.h>
+
+struct device {
+	const char *name;
+	const void *api;
+	void *data;
+};
+
+const struct device *device_get_binding(const char *name);
+
+#endif /* TESTS_SENSOR_BUS_STUBS_DEVICE_H_ */
@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* the synchronous i2c API, only its slot in the i2cmt driver API */
+
+#ifndef TESTS_SENSOR_BUS_STUBS_DRIVERS_I2C_H_
+#define TESTS_SENSOR_BUS_STUBS_DRIVERS_I2C_H_
+
+struct i2c_driver_api {
+	void *transfer;
+};
+
+#endif /* TESTS_SENSOR_BUS_STUBS_DRIVERS_I2C_H_ */
@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* the synchronous spi API, only its slot in the spimt driver API */
+
+#ifndef TESTS_SENSOR_BUS_STUBS_DRIVERS_SPI_H_
+#define TESTS_SENSOR_BUS_STUBS_DRIVERS_SPI_H_
+
+struct spi_driver_api {
+	void *transceive;
+};
+
+#endif /* TESTS_SENSOR_BUS_STUBS_DRIVERS_SPI_H_ */
@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Host stand-in of the SoC header, the PPI task numbers of
+ *        soc_ppi.h and the sleep mode queries
+ */
+
+#ifndef TESTS_SENSOR_BUS_STUBS_SOC_H_
+#define TESTS_SENSOR_BUS_STUBS_SOC_H_
+
+#include <stdint.h>
+
+#define __act_s2_sleep_data
+
+enum {
+	SPIMT0_TASK0 = 0,
+	SPIMT1_TASK0 = 8,
+	I2CMT0_TASK0 = 16,
+	I2CMT1_TASK0 = 20,
+};
+
+int soc_in_sleep_mode(void);
+uint64_t soc_sys_uptime_get(void);
+
+#endif /* TESTS_SENSOR_BUS_STUBS_SOC_H_ */
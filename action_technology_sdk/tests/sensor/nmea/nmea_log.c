@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * NMEA logs of the NMEA parser tests: the output of a multi-constellation
+ * receiver at 1 Hz along a walk, synthesized or read from a file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include <test_common.h>
+#include "nmea_log.h"
+
+static int log_append(char *buf, size_t size, size_t *len, const char *body)
+{
+	uint8_t checksum = 0;
+	const char *p;
+	int n;
+
+	for (p = body; *p; p++) {
+		checksum ^= (uint8_t)*p;
+	}
+
+	n = snprintf(buf + *len, size - *len, "$%s*%02X\r\n", body, checksum);
+	if (n < 0 || (size_t)n >= size - *len) {
+		return -1;
+	}
+
+	*len += n;
+	return 0;
+}
+
+/* ddmm.mmmm of an angle in degrees */
+static void log_angle(char *out, size_t size, double deg, int deg_digits)
+{
+	double a = fabs(deg);
+	int d = (int)a;
+
+	snprintf(out, size, "%0*d%07.4f", deg_digits, d, (a - d) * 60.0);
+}
+
+static int log_gsv(char *buf, size_t size, size_t *len, const char *talker,
+		int num_sats, uint32_t *seed, int prn_base)
+{
+	char body[128];
+	int msgs = (num_sats + 3) / 4;
+	int m, i, n;
+
+	for (m = 0; m < msgs; m++) {
+		n = snprintf(body, sizeof(body), "%sGSV,%d,%d,%02d", talker, msgs, m + 1, num_sats);
+		for (i = m * 4; i < MIN(num_sats, m * 4 + 4); i++) {
+			int snr = test_rand_range(seed, 0, 48);
+
+			if (snr < 12) {
+				/* not tracked, empty SNR */
+				n += snprintf(body + n, sizeof(body) - n, ",%02d,%02d,%03d,",
+						prn_base + i, test_rand_range(seed, 5, 85),
+						test_rand_range(seed, 0, 359));
+			} else {
+				n += snprintf(body + n, sizeof(body) - n, ",%02d,%02d,%03d,%02d",
+						prn_base + i, test_rand_range(seed, 5, 85),
+						test_rand_range(seed, 0, 359), snr);
+			}
+		}
+		if (log_append(buf, size, len, body)) {
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+size_t nmea_log_build(char *buf, size_t size, int epochs, uint32_t seed)
+{
+	double lat = 31.2304, lon = 121.4737, heading = 45.0;
+	size_t len = 0;
+	int e;
+
+	buf[0] = '\0';
+
+	for (e = 0; e < epochs; e++) {
+		char body[160], la[32], lo[32], tm[32], date[16];
+		int sec = 3600 * 8 + e;
+		double speed = 2.5 + test_rand_range(&seed, 0, 100) / 100.0;
+		bool fix = (e % 97) > 3;
+		int err = 0;
+
+		heading += test_rand_range(&seed, -10, 10);
+		lat += speed * cos(heading * M_PI / 180) / 1852.0 / 60.0;
+		lon += speed * sin(heading * M_PI / 180) / 1852.0 / 60.0;
+
+		log_angle(la, sizeof(la), lat, 2);
+		log_angle(lo, sizeof(lo), lon, 3);
+		snprintf(tm, sizeof(tm), "%02d%02d%02d.%02d", sec / 3600 % 24, sec / 60 % 60,
+				sec % 60, e % 5 * 20);
+		snprintf(date, sizeof(date), "%02d%02d%02d", 19 + sec / 86400, 10, 26);
+
+		if (fix) {
+			snprintf(body, sizeof(body), "GNRMC,%s,A,%s,N,%s,E,%.3f,%.2f,%s,,,A",
+					tm, la, lo, speed / 0.5144, fmod(heading + 360, 360), date);
+		} else {
+			snprintf(body, sizeof(body), "GNRMC,%s,V,,,,,,,%s,,,N", tm, date);
+		}
+		err |= log_append(buf, size, &len, body);
+
+		if (fix) {
+			snprintf(body, sizeof(body), "GNGGA,%s,%s,N,%s,E,1,%02d,%.2f,%.1f,M,8.6,M,,",
+					tm, la, lo, test_rand_range(&seed, 6, 18),
+					test_rand_range(&seed, 60, 250) / 100.0,
+					12.0 + test_rand_range(&seed, -30, 30) / 10.0);
+		} else {
+			snprintf(body, sizeof(body), "GNGGA,%s,,,,,0,00,99.99,,,,,,", tm);
+		}
+		err |= log_append(buf, size, &len, body);
+
+		err |= log_append(buf, size, &len,
+				"GNGSA,A,3,10,32,24,12,25,15,,,,,,,1.42,0.89,1.11");
+		err |= log_append(buf, size, &len,
+				"GNGSA,A,3,72,71,81,,,,,,,,,,1.42,0.89,1.11");
+		err |= log_gsv(buf, size, &len, "GP", test_rand_range(&seed, 8, 12), &seed, 1);
+		err |= log_gsv(buf, size, &len, "GL", test_rand_range(&seed, 4, 8), &seed, 65);
+
+		snprintf(body, sizeof(body), "GNVTG,%.2f,T,,M,%.3f,N,%.3f,K,%c",
+				fmod(heading + 360, 360), speed / 0.5144, speed * 3.6, fix ? 'A' : 'N');
+		err |= log_append(buf, size, &len, body);
+
+		snprintf(body, sizeof(body), "GNGLL,%s,N,%s,E,%s,%c,%c", la, lo, tm,
+				fix ? 'A' : 'V', fix ? 'A' : 'N');
+		err |= log_append(buf, size, &len, body);
+
+		snprintf(body, sizeof(body), "GNGST,%s,0.65,4.2,2.9,93.4,3.1,3.9,5.6", tm);
+		err |= log_append(buf, size, &len, body);
+
+		snprintf(body, sizeof(body), "GNZDA,%s,%.2s,%.2s,20%.2s,00,00", tm,
+				date, date + 2, date + 4);
+		err |= log_append(buf, size, &len, body);
+
+		/* proprietary and text sentences every few epochs */
+		if (e % 10 == 0) {
+			err |= log_append(buf, size, &len, "GPTXT,01,01,02,ANTSTATUS=OK");
+			err |= log_append(buf, size, &len, "PMTK010,002");
+		}
+
+		if (err) {
+			break;
+		}
+	}
+
+	return len;
+}
+
+size_t nmea_log_load(const char *path, char *buf, size_t size)
+{
+	FILE *fp = fopen(path, "rb");
+	size_t len;
+
+	if (fp == NULL) {
+		return 0;
+	}
+
+	len = fread(buf, 1, size - 1, fp);
+	buf[len] = '\0';
+	fclose(fp);
+
+	return len;
+}
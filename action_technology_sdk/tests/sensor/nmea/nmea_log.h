@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TESTS_SENSOR_NMEA_LOG_H_
+#define TESTS_SENSOR_NMEA_LOG_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Synthesize epochs seconds of receiver output into buf, one sentence per
+ * CR LF terminated line. Return the length, stopping early when buf is full.
+ */
+size_t nmea_log_build(char *buf, size_t size, int epochs, uint32_t seed);
+
+/* read a recorded log into buf, return its length or 0 */
+size_t nmea_log_load(const char *path, char *buf, size_t size);
+
+#endif /* TESTS_SENSOR_NMEA_LOG_H_ */
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Decode time of NMEA logs, minmea against nmea_stream, sentence by
+ * sentence as gps_service gets them from the driver.
+ *
+ * minmea is timed as gps_minmea_parse() uses it: minmea_sentence_id() on
+ * every sentence, then minmea_parse_xxx() on the enabled types. Both are
+ * run with every type enabled and with RMC and GGA only.
+ *
+ * usage: nmea_stream_bench [epochs | recorded log]
+ */
+
+#include <string.h>
+#include <nmea_stream.h>
+#include <test_common.h>
+#include "nmea_log.h"
+
+TEST_MAIN_DEFINE();
+
+#define MAX_LOG_SIZE	(8 * 1024 * 1024)
+#define MIN_RUN_NS		(1000 * 1000 * 1000ull)
+
+#define ALL_SENTENCES	(((1u << (MINMEA_SENTENCE_ZDA + 1)) - 1) & ~1u)
+#define FIX_SENTENCES	(NMEA_STREAM_MASK(MINMEA_SENTENCE_RMC) | \
+						 NMEA_STREAM_MASK(MINMEA_SENTENCE_GGA))
+
+static char log_buf[MAX_LOG_SIZE];
+static char *sentence_buf;
+static const char **sentences;
+static int num_lines;
+
+static volatile uint32_t sink;
+
+/* the driver hands over each sentence NUL terminated with its line end */
+static void split_lines(const char *buf, size_t len)
+{
+	const char *pos = buf, *end;
+	char *out;
+
+	sentence_buf = out = malloc(len * 2);
+	sentences = malloc(sizeof(*sentences) * (len / 8 + 1));
+
+	while ((end = strchr(pos, '\n')) != NULL) {
+		sentences[num_lines++] = out;
+		memcpy(out, pos, end + 1 - pos);
+		out += end + 1 - pos;
+		*out++ = '\0';
+		pos = end + 1;
+	}
+}
+
+static int minmea_pass(uint32_t mask)
+{
+	int num = 0;
+
+	for (int i = 0; i < num_lines; i++) {
+		const char *sentence = sentences[i];
+		enum minmea_sentence_id id;
+		bool ok = false;
+
+		id = minmea_sentence_id(sentence, false);
+		if (id <= MINMEA_UNKNOWN || !(mask & NMEA_STREAM_MASK(id))) {
+			continue;
+		}
+
+		switch (id) {
+		case MINMEA_SENTENCE_GBS: {
+			struct minmea_sentence_gbs f;
+			ok = minmea_parse_gbs(&f, sentence);
+		} break;
+		case MINMEA_SENTENCE_GGA: {
+			struct minmea_sentence_gga f;
+			ok = minmea_parse_gga(&f, sentence);
+		} break;
+		case MINMEA_SENTENCE_GLL: {
+			struct minmea_sentence_gll f;
+			ok = minmea_parse_gll(&f, sentence);
+		} break;
+		case MINMEA_SENTENCE_GSA: {
+			struct minmea_sentence_gsa f;
+			ok = minmea_parse_gsa(&f, sentence);
+		} break;
+		case MINMEA_SENTENCE_GST: {
+			struct minmea_sentence_gst f;
+			ok = minmea_parse_gst(&f, sentence);
+		} break;
+		case MINMEA_SENTENCE_GSV: {
+			struct minmea_sentence_gsv f;
+			ok = minmea_parse_gsv(&f, sentence);
+		} break;
+		case MINMEA_SENTENCE_RMC: {
+			struct minmea_sentence_rmc f;
+			ok = minmea_parse_rmc(&f, sentence);
+		} break;
+		case MINMEA_SENTENCE_VTG: {
+			struct minmea_sentence_vtg f;
+			ok = minmea_parse_vtg(&f, sentence);
+		} break;
+		case MINMEA_SENTENCE_ZDA: {
+			struct minmea_sentence_zda f;
+			ok = minmea_parse_zda(&f, sentence);
+		} break;
+		default:
+			break;
+		}
+
+		num += ok;
+	}
+
+	return num;
+}
+
+static void stream_callback(enum minmea_sentence_id id, const void *frame, void *user_data)
+{
+	sink += id;
+}
+
+static int stream_pass(uint32_t mask)
+{
+	struct nmea_stream stream;
+
+	nmea_stream_init(&stream, mask, stream_callback, NULL);
+
+	for (int i = 0; i < num_lines; i++) {
+		nmea_stream_feed(&stream, (const uint8_t *)sentences[i], strlen(sentences[i]));
+	}
+
+	return stream.num_decoded;
+}
+
+/* time one pass of each, best of alternate runs so both see the same load */
+static void bench(const char *name, uint32_t mask, size_t bytes)
+{
+	uint64_t t_minmea = UINT64_MAX, t_stream = UINT64_MAX, total = 0;
+	int num_minmea = 0, num_stream = 0;
+
+	while (total < MIN_RUN_NS) {
+		uint64_t t0 = test_time_ns(), t1, t2;
+
+		num_minmea = minmea_pass(mask);
+		t1 = test_time_ns();
+		num_stream = stream_pass(mask);
+		t2 = test_time_ns();
+
+		t_minmea = MIN(t_minmea, t1 - t0);
+		t_stream = MIN(t_stream, t2 - t1);
+		total += t2 - t0;
+	}
+
+	printf("%-10s minmea %7.1f ns/sentence %7.1f MB/s | stream %7.1f ns/sentence "
+			"%7.1f MB/s | %.2fx\n", name,
+			(double)t_minmea / num_lines, bytes * 1e3 / t_minmea,
+			(double)t_stream / num_lines, bytes * 1e3 / t_stream,
+			(double)t_minmea / t_stream);
+
+	TEST_CHECK_MSG(num_minmea == num_stream, "%s: minmea decoded %d, stream %d",
+			name, num_minmea, num_stream);
+}
+
+int main(int argc, char *argv[])
+{
+	int epochs = 3600;
+	size_t len;
+
+	if (argc > 1 && atoi(argv[1]) == 0) {
+		len = nmea_log_load(argv[1], log_buf, sizeof(log_buf));
+	} else {
+		if (argc > 1) {
+			epochs = atoi(argv[1]);
+		}
+		len = nmea_log_build(log_buf, sizeof(log_buf), epochs, 0x0028u);
+	}
+
+	if (len == 0) {
+		printf("no log\n");
+		return EXIT_FAILURE;
+	}
+
+	split_lines(log_buf, len);
+	printf("%d sentences, %zu bytes\n", num_lines, len);
+
+	bench("all types", ALL_SENTENCES, len);
+	bench("RMC+GGA", FIX_SENTENCES, len);
+
+	free(sentences);
+	free(sentence_buf);
+	return TEST_RESULT();
+}
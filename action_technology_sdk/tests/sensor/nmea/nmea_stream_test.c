@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Equivalence of nmea_stream with the minmea path of gps_service.
+ *
+ * Every sentence is decoded with minmea_sentence_id() and
+ * minmea_parse_xxx(), and fed to nmea_stream split at random byte
+ * positions. Both must accept the same sentences and decode the same
+ * frames, on a synthesized log and on randomly corrupted sentences.
+ */
+
+#include <string.h>
+#include <nmea_stream.h>
+#include <test_common.h>
+#include "nmea_log.h"
+
+TEST_MAIN_DEFINE();
+
+#define LOG_EPOCHS		(600)
+#define LOG_SIZE		(LOG_EPOCHS * 1400)
+#define NUM_MUTATIONS	(200000)
+
+#define ALL_SENTENCES	(((1u << (MINMEA_SENTENCE_ZDA + 1)) - 1) & ~1u)
+
+typedef union {
+	struct minmea_sentence_gbs gbs;
+	struct minmea_sentence_rmc rmc;
+	struct minmea_sentence_gga gga;
+	struct minmea_sentence_gsa gsa;
+	struct minmea_sentence_gll gll;
+	struct minmea_sentence_gst gst;
+	struct minmea_sentence_gsv gsv;
+	struct minmea_sentence_vtg vtg;
+	struct minmea_sentence_zda zda;
+} frame_t;
+
+typedef struct {
+	int num;
+	enum minmea_sentence_id id;
+	frame_t frame;
+} decoded_t;
+
+static char log_buf[LOG_SIZE];
+static uint32_t seed = 0x0028u;
+
+static size_t frame_size(enum minmea_sentence_id id)
+{
+	switch (id) {
+	case MINMEA_SENTENCE_GBS: return sizeof(struct minmea_sentence_gbs);
+	case MINMEA_SENTENCE_GGA: return sizeof(struct minmea_sentence_gga);
+	case MINMEA_SENTENCE_GLL: return sizeof(struct minmea_sentence_gll);
+	case MINMEA_SENTENCE_GSA: return sizeof(struct minmea_sentence_gsa);
+	case MINMEA_SENTENCE_GST: return sizeof(struct minmea_sentence_gst);
+	case MINMEA_SENTENCE_GSV: return sizeof(struct minmea_sentence_gsv);
+	case MINMEA_SENTENCE_RMC: return sizeof(struct minmea_sentence_rmc);
+	case MINMEA_SENTENCE_VTG: return sizeof(struct minmea_sentence_vtg);
+	case MINMEA_SENTENCE_ZDA: return sizeof(struct minmea_sentence_zda);
+	default: return 0;
+	}
+}
+
+/* the minmea path of gps_minmea_parse() */
+static void minmea_decode(const char *sentence, decoded_t *out)
+{
+	enum minmea_sentence_id id = minmea_sentence_id(sentence, false);
+	bool ok = false;
+
+	memset(out, 0, sizeof(*out));
+
+	switch (id) {
+	case MINMEA_SENTENCE_GBS: ok = minmea_parse_gbs(&out->frame.gbs, sentence); break;
+	case MINMEA_SENTENCE_GGA: ok = minmea_parse_gga(&out->frame.gga, sentence); break;
+	case MINMEA_SENTENCE_GLL: ok = minmea_parse_gll(&out->frame.gll, sentence); break;
+	case MINMEA_SENTENCE_GSA: ok = minmea_parse_gsa(&out->frame.gsa, sentence); break;
+	case MINMEA_SENTENCE_GST: ok = minmea_parse_gst(&out->frame.gst, sentence); break;
+	case MINMEA_SENTENCE_GSV: ok = minmea_parse_gsv(&out->frame.gsv, sentence); break;
+	case MINMEA_SENTENCE_RMC: ok = minmea_parse_rmc(&out->frame.rmc, sentence); break;
+	case MINMEA_SENTENCE_VTG: ok = minmea_parse_vtg(&out->frame.vtg, sentence); break;
+	case MINMEA_SENTENCE_ZDA: ok = minmea_parse_zda(&out->frame.zda, sentence); break;
+	default: break;
+	}
+
+	if (ok) {
+		out->num = 1;
+		out->id = id;
+	} else {
+		memset(&out->frame, 0, sizeof(out->frame));
+	}
+}
+
+static void stream_callback(enum minmea_sentence_id id, const void *frame, void *user_data)
+{
+	decoded_t *out = user_data;
+
+	if (out->num++ == 0) {
+		out->id = id;
+		memcpy(&out->frame, frame, frame_size(id));
+	}
+}
+
+/* feed one sentence in random chunks */
+static void stream_decode(struct nmea_stream *stream, const char *sentence, decoded_t *out)
+{
+	size_t len = strlen(sentence), pos = 0;
+
+	memset(out, 0, sizeof(*out));
+	stream->user_data = out;
+
+	while (pos < len) {
+		size_t n = MIN(len - pos, (size_t)test_rand_range(&seed, 1, 24));
+
+		nmea_stream_feed(stream, (const uint8_t *)sentence + pos, n);
+		pos += n;
+	}
+}
+
+static bool decoded_equal(const decoded_t *a, const decoded_t *b)
+{
+	if (a->num != b->num || a->id != b->id) {
+		return false;
+	}
+
+	return a->num == 0 || !memcmp(&a->frame, &b->frame, frame_size(a->id));
+}
+
+static void check_sentence(struct nmea_stream *stream, const char *sentence)
+{
+	decoded_t ref, got;
+
+	minmea_decode(sentence, &ref);
+	stream_decode(stream, sentence, &got);
+
+	TEST_CHECK_MSG(decoded_equal(&ref, &got), "%s minmea %d/%d stream %d/%d",
+			sentence, ref.num, ref.id, got.num, got.id);
+}
+
+/* next CR LF terminated line of the log, return its length or 0 at the end */
+static size_t next_line(const char **pos, char *line, size_t size)
+{
+	const char *end = strstr(*pos, "\r\n");
+	size_t len;
+
+	if (end == NULL) {
+		return 0;
+	}
+
+	len = MIN((size_t)(end - *pos) + 2, size - 1);
+	memcpy(line, *pos, len);
+	line[len] = '\0';
+	*pos = end + 2;
+
+	return len;
+}
+
+static void test_log(void)
+{
+	struct nmea_stream stream;
+	const char *pos = log_buf;
+	char line[128];
+	int num = 0;
+
+	nmea_stream_init(&stream, ALL_SENTENCES, stream_callback, NULL);
+
+	while (next_line(&pos, line, sizeof(line))) {
+		check_sentence(&stream, line);
+		num++;
+	}
+
+	TEST_CHECK(num > LOG_EPOCHS * 10);
+	TEST_CHECK(stream.num_decoded > LOG_EPOCHS * 10);
+	TEST_CHECK(stream.num_checksum_err == 0 && stream.num_parse_err == 0);
+}
+
+/* fix the checksum after the corruption, so the fields are decoded */
+static void fix_checksum(char *line)
+{
+	char *star = strchr(line, '*');
+	uint8_t checksum = 0;
+	char *p;
+
+	if (line[0] != '$' || star == NULL || strcmp(star + 3, "\r\n")) {
+		return;
+	}
+
+	for (p = line + 1; p < star; p++) {
+		checksum ^= (uint8_t)*p;
+	}
+
+	snprintf(star + 1, 3, "%02X", checksum);
+	star[3] = '\r';
+}
+
+static void mutate(char *line)
+{
+	/* no '$', nmea_stream resynchronizes on it by design */
+	static const char chars[] = ",.-+*0159AENSWTVM \t";
+	size_t len = strlen(line) - 2;
+	int num = test_rand_range(&seed, 1, 3);
+
+	while (num-- > 0 && len > 1) {
+		size_t at = test_rand_range(&seed, 1, len - 1);
+		char c = chars[test_rand_range(&seed, 0, sizeof(chars) - 2)];
+
+		switch (test_rand_range(&seed, 0, 3)) {
+		case 0:
+			line[at] = c;
+			break;
+		case 1:
+			memmove(line + at, line + at + 1, len + 2 - at);
+			len--;
+			break;
+		case 2:
+			if (len + 3 < MINMEA_MAX_SENTENCE_LENGTH) {
+				memmove(line + at + 1, line + at, len + 3 - at);
+				line[at] = c;
+				len++;
+			}
+			break;
+		default:
+			/* empty a field */
+			while (at < len && line[at] != ',' && line[at] != '*') {
+				memmove(line + at, line + at + 1, len + 2 - at);
+				len--;
+			}
+			break;
+		}
+	}
+
+	if (test_rand_range(&seed, 0, 3) > 0) {
+		fix_checksum(line);
+	}
+}
+
+static void test_mutations(void)
+{
+	struct nmea_stream stream;
+	const char *pos = log_buf;
+	char line[128], mutated[128];
+	int i;
+
+	nmea_stream_init(&stream, ALL_SENTENCES, stream_callback, NULL);
+
+	for (i = 0; i < NUM_MUTATIONS; i++) {
+		if (!next_line(&pos, line, sizeof(line))) {
+			pos = log_buf;
+			continue;
+		}
+
+		strcpy(mutated, line);
+		mutate(mutated);
+		check_sentence(&stream, mutated);
+	}
+}
+
+static void test_mask(void)
+{
+	struct nmea_stream stream;
+	decoded_t got;
+	const char *pos = log_buf;
+	char line[128];
+	int num_rmc = 0;
+
+	nmea_stream_init(&stream, NMEA_STREAM_MASK(MINMEA_SENTENCE_RMC), stream_callback, NULL);
+
+	while (next_line(&pos, line, sizeof(line))) {
+		bool is_rmc = (minmea_sentence_id(line, false) == MINMEA_SENTENCE_RMC);
+
+		stream_decode(&stream, line, &got);
+		TEST_CHECK(got.num == (is_rmc ? 1 : 0));
+		num_rmc += is_rmc;
+	}
+
+	TEST_CHECK(stream.num_decoded == num_rmc);
+	TEST_CHECK(stream.num_skipped > 0);
+}
+
+/* sentences split across feeds and glued together decode the same */
+static void test_stream_split(void)
+{
+	struct nmea_stream stream;
+	decoded_t got;
+	size_t len = strlen(log_buf), pos = 0;
+	uint32_t decoded_whole;
+
+	nmea_stream_init(&stream, ALL_SENTENCES, stream_callback, &got);
+	nmea_stream_feed(&stream, (const uint8_t *)log_buf, len);
+	decoded_whole = stream.num_decoded;
+
+	nmea_stream_init(&stream, ALL_SENTENCES, stream_callback, &got);
+	while (pos < len) {
+		size_t n = MIN(len - pos, (size_t)test_rand_range(&seed, 1, 300));
+
+		memset(&got, 0, sizeof(got));
+		nmea_stream_feed(&stream, (const uint8_t *)log_buf + pos, n);
+		pos += n;
+	}
+
+	TEST_CHECK(stream.num_decoded == decoded_whole);
+}
+
+int main(void)
+{
+	TEST_CHECK(nmea_log_build(log_buf, sizeof(log_buf), LOG_EPOCHS, 0x0028u) > 0);
+
+	TEST_RUN(test_log);
+	TEST_RUN(test_mutations);
+	TEST_RUN(test_mask);
+	TEST_RUN(test_stream_split);
+
+	return TEST_RESULT();
+}
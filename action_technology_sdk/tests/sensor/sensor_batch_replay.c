@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Replay of sensor HAL callbacks through sensor_port, unbatched (max
+ * latency 0, the delivery before batching) against batched latencies.
+ *
+ * The HAL and the service thread are replaced: each callback of the trace
+ * is injected at its time stamp on the simulated clock, and every
+ * MSG_SENSOR_DATA runs the service loop of sensor_service.c at once with a
+ * stand-in algo_handler(). It reports service wakeups per second and the
+ * algorithm CPU time, and checks that every sample is delivered once and
+ * in order.
+ *
+ * The built-in trace follows a watch recording: acc at 50 Hz and mag at
+ * 25 Hz read one sample per task period with scheduling jitter, acc FIFO
+ * bursts of 8 samples while the screen is off, and HR at 1 Hz.
+ *
+ * usage: sensor_batch_replay [trace]
+ *   trace lines: <time ms> <sensor id> <sample count> <sample size>
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <zephyr.h>
+#include <os_common_api.h>
+#include "sensor_port.h"
+#include "sensor_manager.h"
+#include <test_common.h>
+
+TEST_MAIN_DEFINE();
+
+#define MAX_EVENTS		(20000)
+#define MAX_CHUNK_SAMPLES	(32)
+#define TRACE_MS		(60 * 1000)
+
+/* fixed cost of one algo_handler() call and cost per sample, in loops */
+#define ALGO_CALL_LOOPS		(20000)
+#define ALGO_SAMPLE_LOOPS	(500)
+
+typedef struct {
+	uint32_t ts;
+	uint8_t id;
+	uint8_t cnt;
+	uint8_t sz;
+} trace_event_t;
+
+typedef struct {
+	uint32_t wakeups;
+	uint32_t algo_calls;
+	uint64_t algo_ns;
+	uint32_t sent[NUM_SENSOR];
+	uint32_t delivered[NUM_SENSOR];
+	uint32_t out_of_order;
+	uint32_t duration_ms;
+} replay_result_t;
+
+static trace_event_t events[MAX_EVENTS];
+static int num_events;
+
+static sensor_cb_t hal_cb[NUM_SENSOR];
+static replay_result_t result;
+
+/* next sequence number of each sensor, sent and expected by the algorithm */
+static uint32_t seq_sent[NUM_SENSOR];
+static uint32_t seq_expected[NUM_SENSOR];
+
+static volatile uint32_t algo_sink;
+
+int sensor_hal_init(void)
+{
+	return 0;
+}
+
+void sensor_hal_add_callback(int id, sensor_cb_t cb, void *ctx)
+{
+	hal_cb[id] = cb;
+}
+
+const char *sensor_hal_get_type(int id)
+{
+	static const char *types[NUM_SENSOR] = {
+		"acc", "gyro", "mag", "baro", "temp", "hr", "gnss", "offbody",
+	};
+
+	return types[id];
+}
+
+static void algo_burn(uint32_t loops)
+{
+	uint32_t x = algo_sink;
+
+	while (loops--) {
+		x = x * 1103515245u + 12345u;
+	}
+	algo_sink = x;
+}
+
+void algo_handler(int id, sensor_dat_t *dat)
+{
+	uint32_t seq;
+	int i;
+
+	result.algo_calls++;
+	algo_burn(ALGO_CALL_LOOPS);
+
+	for (i = 0; i < dat->cnt; i++) {
+		memcpy(&seq, dat->buf + i * dat->sz, sizeof(seq));
+		if (seq != seq_expected[id]) {
+			result.out_of_order++;
+		}
+		seq_expected[id] = seq + 1;
+		algo_burn(ALGO_SAMPLE_LOOPS);
+	}
+
+	result.delivered[id] += dat->cnt;
+}
+
+/* the MSG_SENSOR_DATA case of _sensor_service_proc() */
+int sensor_send_msg(uint32_t cmd, uint32_t len, void *ptr, uint8_t notify)
+{
+	sensor_dat_t dat;
+	uint32_t start;
+
+	if (cmd != MSG_SENSOR_DATA) {
+		return 0;
+	}
+
+	result.wakeups++;
+
+	while (!sensor_data_is_empty()) {
+		if (sensor_get_data(&dat) > 0) {
+			start = k_cycle_get_32();
+			algo_handler(dat.id, &dat);
+			result.algo_ns += (uint32_t)(k_cycle_get_32() - start);
+			sensor_put_data(&dat);
+		}
+	}
+
+	return 0;
+}
+
+static void trace_add(uint32_t ts, int id, int cnt, int sz)
+{
+	if (num_events < MAX_EVENTS) {
+		events[num_events++] = (trace_event_t) { ts, id, cnt, sz, };
+	}
+}
+
+static int trace_cmp(const void *a, const void *b)
+{
+	const trace_event_t *ea = a, *eb = b;
+
+	return (int)ea->ts - (int)eb->ts;
+}
+
+static void trace_build(void)
+{
+	uint32_t seed = 0x5e750027u;
+	uint32_t t;
+
+	for (t = 0; t < TRACE_MS; t += 20) {
+		/* screen off in the second half, acc drained from its FIFO */
+		if (t < TRACE_MS / 2) {
+			trace_add(t + test_rand_range(&seed, 0, 4), ID_ACC, 1, 6);
+		} else if (t % 160 == 0) {
+			trace_add(t + test_rand_range(&seed, 0, 4), ID_ACC, 8, 6);
+		}
+	}
+
+	for (t = 0; t < TRACE_MS; t += 40) {
+		trace_add(t + test_rand_range(&seed, 0, 6), ID_MAG, 1, 6);
+	}
+
+	for (t = 0; t < TRACE_MS; t += 1000) {
+		trace_add(t + 3, ID_HR, 1, 4);
+	}
+
+	qsort(events, num_events, sizeof(events[0]), trace_cmp);
+}
+
+static int trace_load(const char *path)
+{
+	unsigned int ts, id, cnt, sz;
+	FILE *fp = fopen(path, "r");
+
+	if (fp == NULL) {
+		return -errno;
+	}
+
+	while (fscanf(fp, "%u %u %u %u", &ts, &id, &cnt, &sz) == 4) {
+		if (id < NUM_SENSOR && cnt > 0 && cnt <= MAX_CHUNK_SAMPLES &&
+			sz >= sizeof(uint32_t) && sz <= 16) {
+			trace_add(ts, id, cnt, sz);
+		}
+	}
+
+	fclose(fp);
+	qsort(events, num_events, sizeof(events[0]), trace_cmp);
+	return 0;
+}
+
+/* run the delayed work due up to time ts, then move the clock to ts */
+static void replay_run_until(uint32_t ts)
+{
+	int64_t due;
+
+	while ((due = sim_work_next_due()) >= 0 && due <= ts) {
+		sim_clock_set(MAX(due, k_uptime_get()));
+		sim_work_run_due();
+	}
+
+	sim_clock_set(MAX((int64_t)ts, k_uptime_get()));
+}
+
+static void replay_inject(const trace_event_t *ev)
+{
+	uint8_t buf[MAX_CHUNK_SAMPLES * 16];
+	sensor_dat_t dat = {
+		.id = ev->id, .evt = EVT_TASK, .sz = ev->sz, .cnt = ev->cnt,
+		.buf = buf, .ts = ev->ts,
+	};
+	int i;
+
+	memset(buf, 0, sizeof(buf));
+	for (i = 0; i < ev->cnt; i++) {
+		memcpy(buf + i * ev->sz, &seq_sent[ev->id], sizeof(uint32_t));
+		seq_sent[ev->id]++;
+	}
+
+	result.sent[ev->id] += ev->cnt;
+	if (hal_cb[ev->id]) {
+		hal_cb[ev->id](ev->id, &dat, NULL);
+	}
+
+	/* the HAL buffer is reused by the next read, batches must hold a copy */
+	sim_work_run_due();
+	memset(buf, 0xff, sizeof(buf));
+}
+
+static void replay(uint16_t latency_ms)
+{
+	uint32_t end;
+	int i;
+
+	sim_clock_set(0);
+	sensor_init();
+	sensor_set_batch_latency(ID_ACC, latency_ms);
+	sensor_set_batch_latency(ID_MAG, latency_ms);
+	sim_work_run_due();
+	result.wakeups = 0;
+
+	for (i = 0; i < num_events; i++) {
+		replay_run_until(events[i].ts);
+		replay_inject(&events[i]);
+	}
+
+	end = num_events ? events[num_events - 1].ts : 0;
+	replay_run_until(end + 5000);
+	result.duration_ms = end;
+
+	/* deliver what is still held back */
+	sensor_set_batch_latency(ID_ACC, 0);
+	sensor_set_batch_latency(ID_MAG, 0);
+	sim_work_run_due();
+}
+
+/* sensor_port keeps its state in statics, so replay each latency in a child */
+static int replay_fork(uint16_t latency_ms, replay_result_t *res)
+{
+	int fds[2], status;
+	pid_t pid;
+
+	if (pipe(fds)) {
+		return -errno;
+	}
+
+	fflush(stdout);
+	pid = fork();
+	if (pid < 0) {
+		return -errno;
+	}
+
+	if (pid == 0) {
+		close(fds[0]);
+		replay(latency_ms);
+		if (write(fds[1], &result, sizeof(result)) != sizeof(result)) {
+			_exit(EXIT_FAILURE);
+		}
+		_exit(EXIT_SUCCESS);
+	}
+
+	close(fds[1]);
+	status = (read(fds[0], res, sizeof(*res)) == sizeof(*res)) ? 0 : -EIO;
+	close(fds[0]);
+	waitpid(pid, NULL, 0);
+
+	return status;
+}
+
+int main(int argc, char *argv[])
+{
+	static const uint16_t latencies[] = { 0, 100, 200, 1000, };
+	replay_result_t res[ARRAY_SIZE(latencies)];
+	int i, id;
+
+	if (argc > 1) {
+		if (trace_load(argv[1])) {
+			printf("cannot read %s\n", argv[1]);
+			return EXIT_FAILURE;
+		}
+	} else {
+		trace_build();
+	}
+
+	printf("%d events\n", num_events);
+	printf("latency  wakeups/s  algo calls  algo time (us)  delivered  dropped\n");
+
+	for (i = 0; i < ARRAY_SIZE(latencies); i++) {
+		replay_result_t *r = &res[i];
+		uint32_t sent = 0, delivered = 0;
+
+		TEST_CHECK(replay_fork(latencies[i], r) == 0);
+
+		for (id = 0; id < NUM_SENSOR; id++) {
+			sent += r->sent[id];
+			delivered += r->delivered[id];
+			TEST_CHECK_MSG(r->delivered[id] == r->sent[id],
+					"latency %u: %s sent %u delivered %u", latencies[i],
+					sensor_hal_get_type(id), r->sent[id], r->delivered[id]);
+		}
+		TEST_CHECK(r->out_of_order == 0);
+
+		printf("%5u ms  %9.2f  %10u  %14llu  %9u  %7u\n", latencies[i],
+				r->wakeups * 1000.0 / MAX(r->duration_ms, 1), r->algo_calls,
+				(unsigned long long)r->algo_ns / 1000, delivered, sent - delivered);
+	}
+
+	/* batching must cut wakeups, more as the latency grows */
+	for (i = 1; i < ARRAY_SIZE(latencies); i++) {
+		TEST_CHECK(res[i].wakeups * 4 < res[0].wakeups);
+		TEST_CHECK(res[i].algo_calls * 2 < res[0].algo_calls);
+		TEST_CHECK(res[i].wakeups <= res[i - 1].wakeups);
+	}
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* the host C library has everything minmea needs */
+
+#ifndef TESTS_SENSOR_STUBS_MINMEA_COMPAT_H_
+#define TESTS_SENSOR_STUBS_MINMEA_COMPAT_H_
+
+#endif /* TESTS_SENSOR_STUBS_MINMEA_COMPAT_H_ */
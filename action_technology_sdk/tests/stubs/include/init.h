@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TESTS_STUBS_INIT_H_
+#define TESTS_STUBS_INIT_H_
+
+struct device;
+
+/* run before main(), the levels in their boot order */
+#define SYS_INIT_PRIO_PRE_KERNEL_1	101
+#define SYS_INIT_PRIO_PRE_KERNEL_2	102
+#define SYS_INIT_PRIO_POST_KERNEL	103
+#define SYS_INIT_PRIO_APPLICATION	104
+
+#define SYS_INIT(init_fn, level, prio) \
+	static void __attribute__((constructor(SYS_INIT_PRIO_##level))) _sys_init_##init_fn(void) \
+	{ \
+		init_fn(NULL); \
+	}
+
+#endif /* TESTS_STUBS_INIT_H_ */
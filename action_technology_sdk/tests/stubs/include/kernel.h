@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Host stand-in of the Zephyr kernel API used by framework modules
+ *
+ * Semaphores and mutexes are backed by pthreads. irq_lock() takes one
+ * global recursive lock, so code under test keeps its critical sections
+ * when a test drives it from several threads.
+ *
+ * Time is the host monotonic clock, or a simulated clock once a test
+ * calls sim_clock_set(). Delayed work only runs on the simulated clock,
+ * from sim_work_run_due(). The cycle counter stays on the host clock, for
+ * timing measurements, until a test replaying timed events sets it with
+ * sim_cycle_set_us().
+ */
+
+#ifndef TESTS_STUBS_KERNEL_H_
+#define TESTS_STUBS_KERNEL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sys/atomic.h>
+#include <sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define __aligned(x) __attribute__((__aligned__(x)))
+#define __packed __attribute__((__packed__))
+#define __unused __attribute__((__unused__))
+#define __ramfunc
+#define __in_section_unique(seg)
+#define ARCH_STACK_PTR_ALIGN 8
+#define likely(x) __builtin_expect(!!(x), 1)
+#define unlikely(x) __builtin_expect(!!(x), 0)
+
+typedef int32_t s32_t;
+typedef uint32_t u32_t;
+typedef int16_t s16_t;
+typedef uint16_t u16_t;
+typedef uint8_t u8_t;
+
+/* 1 ms ticks */
+typedef int64_t k_ticks_t;
+
+typedef struct {
+	k_ticks_t ticks;
+} k_timeout_t;
+
+#define K_MSEC(ms)		((k_timeout_t) { .ticks = (ms), })
+#define K_SECONDS(s)	K_MSEC((s) * 1000)
+#define K_NO_WAIT		((k_timeout_t) { .ticks = 0, })
+#define K_FOREVER		((k_timeout_t) { .ticks = -1, })
+#define K_TIMEOUT_EQ(a, b)	((a).ticks == (b).ticks)
+#define SYS_FOREVER_MS	(-1)
+#define SYS_TIMEOUT_MS(ms)	((ms) == SYS_FOREVER_MS ? K_FOREVER : K_MSEC(ms))
+
+/* cycles are nanoseconds */
+#define SIM_CYCLES_PER_SEC	1000000000ull
+
+/* clock */
+void sim_clock_set(uint64_t ms);
+void sim_clock_advance(uint64_t ms);
+bool sim_clock_is_simulated(void);
+void sim_cycle_set_us(uint64_t us);
+int64_t k_uptime_get(void);
+uint32_t k_cycle_get_32(void);
+
+static inline uint32_t k_uptime_get_32(void)
+{
+	return (uint32_t)k_uptime_get();
+}
+
+static inline uint64_t k_cyc_to_us_floor64(uint64_t cyc)
+{
+	return cyc / (SIM_CYCLES_PER_SEC / 1000000);
+}
+
+static inline uint32_t k_cyc_to_us_floor32(uint32_t cyc)
+{
+	return cyc / (SIM_CYCLES_PER_SEC / 1000000);
+}
+
+static inline uint32_t k_us_to_cyc_ceil32(uint32_t us)
+{
+	return us * (SIM_CYCLES_PER_SEC / 1000000);
+}
+
+static inline uint32_t k_ms_to_cyc_ceil32(uint32_t ms)
+{
+	return ms * (SIM_CYCLES_PER_SEC / 1000);
+}
+
+void k_msleep(int32_t ms);
+void k_busy_wait(uint32_t us);
+
+/* interrupt lock */
+unsigned int irq_lock(void);
+void irq_unlock(unsigned int key);
+bool k_is_in_isr(void);
+
+/* threads */
+typedef void *k_tid_t;
+
+k_tid_t k_current_get(void);
+void k_yield(void);
+
+/* preemption is not simulated, only one thread runs the code under test */
+static inline void k_sched_lock(void)
+{
+}
+
+static inline void k_sched_unlock(void)
+{
+}
+
+/*
+ * Priorities are only recorded, per calling thread, the host scheduler
+ * ignores them. Only the current thread may be passed.
+ */
+int k_thread_priority_get(k_tid_t thread);
+void k_thread_priority_set(k_tid_t thread, int prio);
+
+/* semaphores */
+struct k_sem {
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	unsigned int count;
+	unsigned int limit;
+};
+
+#define K_SEM_DEFINE(name, initial_count, count_limit) \
+	struct k_sem name = { \
+		.lock = PTHREAD_MUTEX_INITIALIZER, \
+		.cond = PTHREAD_COND_INITIALIZER, \
+		.count = initial_count, \
+		.limit = count_limit, \
+	}
+
+int k_sem_init(struct k_sem *sem, unsigned int initial_count, unsigned int limit);
+int k_sem_take(struct k_sem *sem, k_timeout_t timeout);
+void k_sem_give(struct k_sem *sem);
+void k_sem_reset(struct k_sem *sem);
+unsigned int k_sem_count_get(struct k_sem *sem);
+
+/* mutexes */
+struct k_mutex {
+	pthread_mutex_t lock;
+};
+
+#define K_MUTEX_DEFINE(name) \
+	struct k_mutex name = { .lock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP, }
+
+int k_mutex_init(struct k_mutex *mutex);
+int k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout);
+int k_mutex_unlock(struct k_mutex *mutex);
+
+/* memory slabs, blocks from the host heap up to the slab count */
+struct k_mem_slab {
+	size_t block_size;
+	uint32_t num_blocks;
+	uint32_t num_used;
+};
+
+#define K_MEM_SLAB_DEFINE(name, slab_block_size, slab_num_blocks, slab_align) \
+	struct k_mem_slab name = { \
+		.block_size = (slab_block_size), \
+		.num_blocks = (slab_num_blocks), \
+	}
+
+int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout);
+void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
+
+/* work, run on the simulated clock by sim_work_run_due() */
+struct k_work;
+typedef void (*k_work_handler_t)(struct k_work *work);
+
+struct k_work {
+	k_work_handler_t handler;
+};
+
+struct k_work_q {
+	int unused;
+};
+
+struct k_delayed_work {
+	struct k_work work;
+	bool pending;
+	int64_t due;
+};
+
+void k_delayed_work_init(struct k_delayed_work *work, k_work_handler_t handler);
+int k_delayed_work_submit(struct k_delayed_work *work, k_timeout_t delay);
+int k_delayed_work_cancel(struct k_delayed_work *work);
+bool k_delayed_work_pending(struct k_delayed_work *work);
+int32_t k_delayed_work_remaining_get(struct k_delayed_work *work);
+
+/*
+ * Run the delayed work due at or before the simulated time, in due order.
+ * Return the number of handlers run.
+ */
+int sim_work_run_due(void);
+
+/* due time of the earliest pending work, or -1 */
+int64_t sim_work_next_due(void);
+
+/* assertions stay on, the host tests are there to catch them */
+#define __ASSERT(test, fmt, ...) \
+	do { \
+		if (!(test)) { \
+			printf("ASSERTION FAIL %s:%d: " fmt "\n", __FILE__, __LINE__, ##__VA_ARGS__); \
+			abort(); \
+		} \
+	} while (0)
+#define __ASSERT_NO_MSG(test) __ASSERT(test, "%s", #test)
+
+#define printk printf
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_STUBS_KERNEL_H_ */
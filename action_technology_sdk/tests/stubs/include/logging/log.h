@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TESTS_STUBS_LOGGING_LOG_H_
+#define TESTS_STUBS_LOGGING_LOG_H_
+
+#include <os_common_api.h>
+
+#endif /* TESTS_STUBS_LOGGING_LOG_H_ */
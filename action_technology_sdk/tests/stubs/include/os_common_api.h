@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Host stand-in of the OS common APIs, mapped on the kernel stand-in
+ *        the same way the real header maps them on Zephyr
+ */
+
+#ifndef TESTS_STUBS_OS_COMMON_API_H_
+#define TESTS_STUBS_OS_COMMON_API_H_
+
+#include <kernel.h>
+#include <stdlib.h>
+
+#define OS_FOREVER		(-1)
+#define OS_NO_WAIT		(0)
+#define OS_MSEC(ms)		K_MSEC(ms)
+
+typedef struct k_mutex os_mutex;
+typedef struct k_sem os_sem;
+typedef struct k_delayed_work os_delayed_work;
+typedef struct k_work os_work;
+typedef struct k_work_q os_work_q;
+typedef k_tid_t os_tid_t;
+
+typedef enum {
+	OS_POLL_TIMEOUT = 0,
+	OS_POLL_MSG,
+	OS_POLL_SEM,
+} os_poll_e;
+
+#define OS_MUTEX_DEFINE(name) K_MUTEX_DEFINE(name)
+#define OS_SEM_DEFINE(name, initial_count, count_limit) \
+	K_SEM_DEFINE(name, initial_count, count_limit)
+
+/* mutex */
+#define os_mutex_init(mutex) k_mutex_init(mutex)
+#define os_mutex_lock(mutex, timeout) k_mutex_lock(mutex, SYS_TIMEOUT_MS(timeout))
+#define os_mutex_unlock(mutex) k_mutex_unlock(mutex)
+
+/* semaphore */
+#define os_sem_init(sem, initial_count, limit) k_sem_init(sem, initial_count, limit)
+#define os_sem_take(sem, timeout) k_sem_take(sem, SYS_TIMEOUT_MS(timeout))
+#define os_sem_give(sem) k_sem_give(sem)
+#define os_sem_reset(sem) k_sem_reset(sem)
+#define os_sem_count_get(sem) k_sem_count_get(sem)
+
+/* irq */
+#define os_irq_lock() irq_lock()
+#define os_irq_unlock(key) irq_unlock(key)
+#define os_is_in_isr() k_is_in_isr()
+
+/* thread and time */
+#define os_current_get() k_current_get()
+#define os_yield() k_yield()
+#define os_sched_lock() k_sched_lock()
+#define os_sched_unlock() k_sched_unlock()
+#define os_thread_priority_get(thread) k_thread_priority_get(thread)
+#define os_thread_priority_set(thread, prio) k_thread_priority_set(thread, prio)
+#define os_sleep(ms) k_msleep(ms)
+#define os_uptime_get() k_uptime_get()
+#define os_uptime_get_32() k_uptime_get_32()
+#define os_cycle_get_32() k_cycle_get_32()
+
+/* delayed work */
+#define os_delayed_work_init(work, handler) k_delayed_work_init(work, handler)
+#define os_delayed_work_submit(work, delay) k_delayed_work_submit(work, K_MSEC(delay))
+#define os_delayed_work_submit_to_queue(work_q, work, delay) \
+	k_delayed_work_submit(work, K_MSEC(delay))
+#define os_delayed_work_cancel(work) k_delayed_work_cancel(work)
+#define os_delayed_work_is_pending(work) k_delayed_work_pending(work)
+#define os_delayed_work_remaining_get(work) k_delayed_work_remaining_get(work)
+
+static inline os_work_q *os_get_user_work_queue(void)
+{
+	return NULL;
+}
+
+/* global mailbox, defined by the tests that link a message user */
+#define OS_ANY NULL
+
+int msg_pool_get_free_msg_num(void);
+void msg_pool_dump(void(*dump_fn)(os_tid_t sender, os_tid_t receiver,
+		const char *content, int max_size));
+int os_send_async_msg_discardable(void *receiver, void *msg, int msg_size);
+int os_send_async_msg(void *receiver, void *msg, int msg_size);
+int os_receive_msg(void *msg, int msg_size, int timeout);
+int os_poll_msg(void *msg, int msg_size, os_sem *sem, int timeout);
+void os_msg_clean(void);
+void os_msg_init(void);
+
+/* system */
+int system_check_low_latencey_mode(void);
+
+/* log */
+#define printk printf
+#define os_printk printf
+
+#ifdef SIM_LOG_QUIET
+#define SYS_LOG_ERR(...) do { } while (0)
+#else
+#define SYS_LOG_ERR(fmt, ...) printf("E: " fmt "\n", ##__VA_ARGS__)
+#endif
+#define SYS_LOG_WRN(...) do { } while (0)
+#define SYS_LOG_INF(...) do { } while (0)
+#define SYS_LOG_DBG(...) do { } while (0)
+
+#define LOG_MODULE_DECLARE(...)
+#define LOG_MODULE_REGISTER(...)
+#define LOG_ERR(fmt, ...) SYS_LOG_ERR(fmt, ##__VA_ARGS__)
+#define LOG_WRN(...) do { } while (0)
+#define LOG_INF(...) do { } while (0)
+#define LOG_DBG(...) do { } while (0)
+
+#endif /* TESTS_STUBS_OS_COMMON_API_H_ */
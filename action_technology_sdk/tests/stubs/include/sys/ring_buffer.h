@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Host stand-in of the Zephyr byte mode ring buffer
+ *
+ * Same partial put/get semantics as the kernel one, without the claim API.
+ */
+
+#ifndef TESTS_STUBS_SYS_RING_BUFFER_H_
+#define TESTS_STUBS_SYS_RING_BUFFER_H_
+
+#include <kernel.h>
+
+struct ring_buf {
+	uint32_t head;
+	uint32_t tail;
+	uint32_t size;
+	uint8_t *data;
+};
+
+static inline void ring_buf_init(struct ring_buf *buf, uint32_t size, void *data)
+{
+	memset(buf, 0, sizeof(*buf));
+	buf->size = size;
+	buf->data = data;
+}
+
+static inline uint32_t ring_buf_size_get(struct ring_buf *buf)
+{
+	return buf->tail - buf->head;
+}
+
+static inline uint32_t ring_buf_space_get(struct ring_buf *buf)
+{
+	return buf->size - ring_buf_size_get(buf);
+}
+
+static inline int ring_buf_is_empty(struct ring_buf *buf)
+{
+	return buf->head == buf->tail;
+}
+
+static inline void ring_buf_reset(struct ring_buf *buf)
+{
+	buf->head = buf->tail = 0;
+}
+
+static inline uint32_t ring_buf_put(struct ring_buf *buf, const uint8_t *data, uint32_t size)
+{
+	uint32_t i;
+
+	size = MIN(size, ring_buf_space_get(buf));
+	for (i = 0; i < size; i++) {
+		buf->data[(buf->tail + i) % buf->size] = data[i];
+	}
+	buf->tail += size;
+
+	return size;
+}
+
+static inline uint32_t ring_buf_get(struct ring_buf *buf, uint8_t *data, uint32_t size)
+{
+	uint32_t i;
+
+	size = MIN(size, ring_buf_size_get(buf));
+	for (i = 0; i < size; i++) {
+		if (data) {
+			data[i] = buf->data[(buf->head + i) % buf->size];
+		}
+	}
+	buf->head += size;
+
+	return size;
+}
+
+#endif /* TESTS_STUBS_SYS_RING_BUFFER_H_ */
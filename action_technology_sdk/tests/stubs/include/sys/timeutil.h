@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TESTS_STUBS_SYS_TIMEUTIL_H_
+#define TESTS_STUBS_SYS_TIMEUTIL_H_
+
+#include <time.h>
+#include <stdint.h>
+
+time_t timegm(struct tm *tm);
+
+static inline time_t timeutil_timegm(const struct tm *tm)
+{
+	struct tm copy = *tm;
+
+	return timegm(&copy);
+}
+
+static inline int64_t timeutil_timegm64(const struct tm *tm)
+{
+	return timeutil_timegm(tm);
+}
+
+#endif /* TESTS_STUBS_SYS_TIMEUTIL_H_ */
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Host stand-in of the Zephyr utility macros, enough for the
+ *        sys/slist.h of the SDK tree
+ */
+
+#ifndef TESTS_STUBS_SYS_UTIL_H_
+#define TESTS_STUBS_SYS_UTIL_H_
+
+#include <stddef.h>
+
+#ifndef MIN
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+#ifndef MAX
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#endif
+#ifndef min
+#define min(a, b) MIN(a, b)
+#endif
+#ifndef ARRAY_SIZE
+#define ARRAY_SIZE(array) (sizeof(array) / sizeof((array)[0]))
+#endif
+#ifndef ROUND_UP
+#define ROUND_UP(x, align) ((((unsigned long)(x) + ((unsigned long)(align) - 1)) / \
+		(unsigned long)(align)) * (unsigned long)(align))
+#endif
+#ifndef ROUND_DOWN
+#define ROUND_DOWN(x, align) (((unsigned long)(x) / (unsigned long)(align)) * (unsigned long)(align))
+#endif
+#define CONTAINER_OF(ptr, type, field) ((type *)(((char *)(ptr)) - offsetof(type, field)))
+#define ARG_UNUSED(x) (void)(x)
+#ifndef BIT
+#define BIT(n) (1UL << (n))
+#endif
+#define BUILD_ASSERT(expr, ...) _Static_assert(expr, "" __VA_ARGS__)
+
+static inline int is_power_of_two(unsigned int x)
+{
+	return (x != 0) && !(x & (x - 1));
+}
+
+/* 1 if the config macro is defined to 1, else 0 */
+#define IS_ENABLED(config_macro) Z_IS_ENABLED1(config_macro)
+#define Z_IS_ENABLED1(config_macro) Z_IS_ENABLED2(_XXXX##config_macro)
+#define _XXXX1 _YYYY,
+#define Z_IS_ENABLED2(one_or_two_args) Z_IS_ENABLED3(one_or_two_args 1, 0)
+#define Z_IS_ENABLED3(ignore_this, val, ...) val
+
+#endif /* TESTS_STUBS_SYS_UTIL_H_ */
@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TESTS_STUBS_ZEPHYR_H_
+#define TESTS_STUBS_ZEPHYR_H_
+
+#include <kernel.h>
+
+#endif /* TESTS_STUBS_ZEPHYR_H_ */
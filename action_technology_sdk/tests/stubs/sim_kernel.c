@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) 2026 Actions Semiconductor Co., Ltd
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Host stand-in of the Zephyr kernel, see include/kernel.h
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <kernel.h>
+#include <time.h>
+#include <sched.h>
+
+#define SIM_MAX_WORKS 32
+
+static pthread_mutex_t irq_mutex = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+static bool sim_clock_on;
+static int64_t sim_clock_ms;
+
+static bool sim_cycle_on;
+static uint64_t sim_cycle_ns;
+
+static struct k_delayed_work *sim_works[SIM_MAX_WORKS];
+static int sim_num_works;
+
+static uint64_t host_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+void sim_clock_set(uint64_t ms)
+{
+	sim_clock_on = true;
+	sim_clock_ms = ms;
+}
+
+void sim_clock_advance(uint64_t ms)
+{
+	sim_clock_on = true;
+	sim_clock_ms += ms;
+}
+
+bool sim_clock_is_simulated(void)
+{
+	return sim_clock_on;
+}
+
+void sim_cycle_set_us(uint64_t us)
+{
+	sim_cycle_on = true;
+	sim_cycle_ns = us * 1000;
+}
+
+int64_t k_uptime_get(void)
+{
+	return sim_clock_on ? sim_clock_ms : (int64_t)(host_ns() / 1000000);
+}
+
+/* the host clock unless set, so cycle counts measure real execution time */
+uint32_t k_cycle_get_32(void)
+{
+	return (uint32_t)(sim_cycle_on ? sim_cycle_ns : host_ns());
+}
+
+void k_msleep(int32_t ms)
+{
+	struct timespec ts = { .tv_sec = ms / 1000, .tv_nsec = (ms % 1000) * 1000000L, };
+
+	if (sim_clock_on) {
+		sim_clock_ms += ms;
+		return;
+	}
+
+	nanosleep(&ts, NULL);
+}
+
+void k_busy_wait(uint32_t us)
+{
+	uint64_t end = host_ns() + us * 1000ull;
+
+	while (host_ns() < end) {
+	}
+}
+
+unsigned int irq_lock(void)
+{
+	pthread_mutex_lock(&irq_mutex);
+	return 0;
+}
+
+void irq_unlock(unsigned int key)
+{
+	pthread_mutex_unlock(&irq_mutex);
+}
+
+bool k_is_in_isr(void)
+{
+	return false;
+}
+
+k_tid_t k_current_get(void)
+{
+	return (k_tid_t)pthread_self();
+}
+
+void k_yield(void)
+{
+	sched_yield();
+}
+
+static __thread int sim_thread_prio;
+
+int k_thread_priority_get(k_tid_t thread)
+{
+	return sim_thread_prio;
+}
+
+void k_thread_priority_set(k_tid_t thread, int prio)
+{
+	sim_thread_prio = prio;
+}
+
+int k_sem_init(struct k_sem *sem, unsigned int initial_count, unsigned int limit)
+{
+	pthread_mutex_init(&sem->lock, NULL);
+	pthread_cond_init(&sem->cond, NULL);
+	sem->count = initial_count;
+	sem->limit = limit;
+	return 0;
+}
+
+int k_sem_take(struct k_sem *sem, k_timeout_t timeout)
+{
+	struct timespec ts;
+	int ret = 0;
+
+	pthread_mutex_lock(&sem->lock);
+
+	if (sem->count == 0 && timeout.ticks > 0) {
+		clock_gettime(CLOCK_REALTIME, &ts);
+		ts.tv_sec += timeout.ticks / 1000;
+		ts.tv_nsec += (timeout.ticks % 1000) * 1000000L;
+		if (ts.tv_nsec >= 1000000000L) {
+			ts.tv_sec++;
+			ts.tv_nsec -= 1000000000L;
+		}
+	}
+
+	while (sem->count == 0 && ret == 0) {
+		if (timeout.ticks == 0) {
+			ret = -EBUSY;
+		} else if (timeout.ticks < 0) {
+			pthread_cond_wait(&sem->cond, &sem->lock);
+		} else if (pthread_cond_timedwait(&sem->cond, &sem->lock, &ts)) {
+			ret = -EAGAIN;
+		}
+	}
+
+	if (ret == 0) {
+		sem->count--;
+	}
+
+	pthread_mutex_unlock(&sem->lock);
+	return ret;
+}
+
+void k_sem_give(struct k_sem *sem)
+{
+	pthread_mutex_lock(&sem->lock);
+	if (sem->count < sem->limit) {
+		sem->count++;
+	}
+	pthread_cond_signal(&sem->cond);
+	pthread_mutex_unlock(&sem->lock);
+}
+
+void k_sem_reset(struct k_sem *sem)
+{
+	pthread_mutex_lock(&sem->lock);
+	sem->count = 0;
+	pthread_mutex_unlock(&sem->lock);
+}
+
+unsigned int k_sem_count_get(struct k_sem *sem)
+{
+	return sem->count;
+}
+
+int k_mutex_init(struct k_mutex *mutex)
+{
+	pthread_mutexattr_t attr;
+
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&mutex->lock, &attr);
+	pthread_mutexattr_destroy(&attr);
+	return 0;
+}
+
+int k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
+{
+	if (timeout.ticks == 0) {
+		return pthread_mutex_trylock(&mutex->lock) ? -EBUSY : 0;
+	}
+
+	return pthread_mutex_lock(&mutex->lock) ? -EINVAL : 0;
+}
+
+int k_mutex_unlock(struct k_mutex *mutex)
+{
+	return pthread_mutex_unlock(&mutex->lock) ? -EINVAL : 0;
+}
+
+int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+{
+	unsigned int key = irq_lock();
+	int res = -ENOMEM;
+
+	*mem = NULL;
+	if (slab->num_used < slab->num_blocks) {
+		*mem = malloc(slab->block_size);
+		if (*mem) {
+			slab->num_used++;
+			res = 0;
+		}
+	}
+
+	irq_unlock(key);
+	return res;
+}
+
+void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
+{
+	unsigned int key = irq_lock();
+
+	free(*mem);
+	slab->num_used--;
+	irq_unlock(key);
+}
+
+void k_delayed_work_init(struct k_delayed_work *work, k_work_handler_t handler)
+{
+	memset(work, 0, sizeof(*work));
+	work->work.handler = handler;
+
+	for (int i = 0; i < sim_num_works; i++) {
+		if (sim_works[i] == work) {
+			return;
+		}
+	}
+
+	if (sim_num_works < SIM_MAX_WORKS) {
+		sim_works[sim_num_works++] = work;
+	}
+}
+
+/* like k_delayed_work_submit(), a pending work is rescheduled */
+int k_delayed_work_submit(struct k_delayed_work *work, k_timeout_t delay)
+{
+	unsigned int key = irq_lock();
+
+	work->pending = true;
+	work->due = k_uptime_get() + MAX(delay.ticks, 0);
+
+	irq_unlock(key);
+	return 0;
+}
+
+int k_delayed_work_cancel(struct k_delayed_work *work)
+{
+	work->pending = false;
+	return 0;
+}
+
+bool k_delayed_work_pending(struct k_delayed_work *work)
+{
+	return work->pending;
+}
+
+int32_t k_delayed_work_remaining_get(struct k_delayed_work *work)
+{
+	return work->pending ? (int32_t)MAX(work->due - k_uptime_get(), 0) : 0;
+}
+
+int64_t sim_work_next_due(void)
+{
+	int64_t due = -1;
+
+	for (int i = 0; i < sim_num_works; i++) {
+		if (sim_works[i]->pending && (due < 0 || sim_works[i]->due < due)) {
+			due = sim_works[i]->due;
+		}
+	}
+
+	return due;
+}
+
+int sim_work_run_due(void)
+{
+	int num_run = 0;
+
+	for (;;) {
+		struct k_delayed_work *next = NULL;
+
+		for (int i = 0; i < sim_num_works; i++) {
+			struct k_delayed_work *work = sim_works[i];
+
+			if (work->pending && work->due <= k_uptime_get() &&
+				(next == NULL || work->due < next->due)) {
+				next = work;
+			}
+		}
+
+		if (next == NULL) {
+			return num_run;
+		}
+
+		next->pending = false;
+		next->work.handler(&next->work);
+		num_run++;
+	}
+}
@@ -34,6 +34,20 @@
  *      TYPEDEFS
  **********************/
 
+/* Statistics of one engine in the DMA2D/CPU split rendering */
+typedef struct {
+    uint32_t busy_us;        /* busy time drawing the bands in microseconds */
+    uint32_t pixels;         /* pixels of the bands */
+    uint32_t pixels_per_sec; /* throughput, pixels per second */
+} lv_gpu_split_engine_stats_t;
+
+/* Statistics of the DMA2D/CPU split rendering */
+typedef struct {
+    uint32_t split_cnt;      /* number of split draw tasks */
+    lv_gpu_split_engine_stats_t dma2d;
+    lv_gpu_split_engine_stats_t cpu;
+} lv_gpu_split_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -81,6 +95,18 @@ lv_result_t lv_gpu_draw_buf_dma2d_clear(lv_draw_buf_t * draw_buf, const lv_area_
 lv_result_t lv_gpu_draw_buf_dma2d_copy(lv_draw_buf_t * dest, const lv_area_t * dest_area,
                                        const lv_draw_buf_t * src, const lv_area_t * src_area);
 
+/**
+ * @brief Get the statistics of the DMA2D/CPU split rendering
+ *
+ * The DMA2D band is only measured when DMA2D is idle before it is submitted.
+ *
+ * @param stats pointer to store the statistics
+ * @param reset reset the statistics after read or not
+ *
+ * @retval N/A.
+ */
+void lv_gpu_draw_dma2d_get_split_stats(lv_gpu_split_stats_t * stats, bool reset);
+
 /**
  * @brief Initialize Actions' SW renderer draw unit
  *
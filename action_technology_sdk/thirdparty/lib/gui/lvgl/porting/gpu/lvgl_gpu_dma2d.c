@@ -25,14 +25,131 @@
 #define INDEX_PIXEL_FORMATS \
 	    (HAL_PIXEL_FORMAT_I8 | HAL_PIXEL_FORMAT_I4 | HAL_PIXEL_FORMAT_I2 | HAL_PIXEL_FORMAT_I1)
 
+/* Maximum draw tasks in flight on DMA2D, 0 to complete each task before the next */
+#ifndef LV_DRAW_ACTS_DMA2D_BATCH_SIZE
+  #define LV_DRAW_ACTS_DMA2D_BATCH_SIZE 0
+#endif
+
+/*
+ * Without batching, the draw task is marked ready right after its commands are
+ * submitted, so they must be completed before another unit (VG-Lite) may touch
+ * the same area. With batching, the task keeps in progress until its commands
+ * completed, and the LVGL dependency check holds back the overlapping tasks.
+ */
+#if LV_USE_DRAW_VG_LITE && LV_DRAW_ACTS_DMA2D_BATCH_SIZE == 0
+  #define DMA2D_POLL_EACH_CMD 1
+#else
+  #define DMA2D_POLL_EACH_CMD 0
+#endif
+
+/* Split large fill and blit tasks into a DMA2D band and a CPU band */
+#ifndef LV_DRAW_ACTS_DMA2D_SPLIT
+  #define LV_DRAW_ACTS_DMA2D_SPLIT 0
+#endif
+
+#if LV_DRAW_ACTS_DMA2D_SPLIT
+  #ifndef LV_DRAW_ACTS_DMA2D_SPLIT_MIN_SIZE
+    #define LV_DRAW_ACTS_DMA2D_SPLIT_MIN_SIZE 16384
+  #endif
+
+  /* Minimum rows of each band */
+  #define DMA2D_SPLIT_MIN_ROWS 8
+  /* Maximum rows to move the band boundary to get it aligned */
+  #define DMA2D_SPLIT_ALIGN_ROWS 16
+
+  /*
+   * The CPU band must not share a cache line with the DMA2D band, otherwise the
+   * write-back of the CPU may overwrite the DMA2D output.
+   */
+  #ifdef CONFIG_DCACHE_LINE_SIZE
+    #define DMA2D_SPLIT_ALIGN CONFIG_DCACHE_LINE_SIZE
+  #else
+    #define DMA2D_SPLIT_ALIGN 32
+  #endif
+
+  /* Area of the calibration draw buffer */
+  #define DMA2D_SPLIT_CALIB_W 128
+  #define DMA2D_SPLIT_CALIB_H 64
+
+  /* Pending band armed before its command is submitted, sequence not known yet */
+  #define DMA2D_SPLIT_SEQ_ARMED (-2)
+#endif
+
+#define DMA2D_USE_XFER_CALLBACK (LV_DRAW_ACTS_DMA2D_BATCH_SIZE > 0 || LV_DRAW_ACTS_DMA2D_SPLIT)
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_DRAW_ACTS_DMA2D_SPLIT
+enum {
+    DMA2D_SPLIT_ENGINE_DMA2D = 0,
+    DMA2D_SPLIT_ENGINE_CPU,
+
+    DMA2D_SPLIT_NUM_ENGINES,
+};
+
+enum {
+    DMA2D_SPLIT_COST_FILL = 0, /* opaque fill */
+    DMA2D_SPLIT_COST_BLEND,    /* blended fill and blit */
+
+    DMA2D_SPLIT_NUM_COSTS,
+};
+
+/* cost model of one destination color format */
+typedef struct {
+    lv_color_format_t cf;
+    /* throughput in pixels per millisecond, 0 if not calibrated */
+    uint32_t ppms[DMA2D_SPLIT_NUM_COSTS][DMA2D_SPLIT_NUM_ENGINES];
+} lv_dma2d_split_cost_t;
+
+/* split of the active draw task */
+typedef struct {
+    lv_dma2d_split_cost_t * cost;
+    uint8_t cost_idx;
+    bool dma2d_idle; /* DMA2D is idle before the band submitted */
+    uint32_t dma2d_start;
+    uint32_t cpu_start;
+    lv_area_t dma2d_area;
+    lv_area_t cpu_area;
+    const lv_area_t * clip_area;
+} lv_dma2d_split_t;
+
+/* DMA2D band waiting for completion to be measured */
+typedef struct {
+    lv_dma2d_split_cost_t * cost;
+    uint8_t cost_idx;
+    uint32_t pixels;
+    uint32_t start;
+    volatile int32_t seq; /* command sequence, -1 if completed or DMA2D_SPLIT_SEQ_ARMED */
+    volatile uint32_t end;
+} lv_dma2d_split_pending_t;
+#endif /* LV_DRAW_ACTS_DMA2D_SPLIT */
+
+#if LV_DRAW_ACTS_DMA2D_BATCH_SIZE > 0
+typedef struct {
+    lv_draw_task_t * task;
+    uint16_t seq; /* command sequence of the last DMA2D command of the task */
+} lv_draw_dma2d_batch_t;
+#endif
+
 typedef struct {
     lv_draw_unit_t base_unit;
     lv_draw_task_t * task_act;
     hal_dma2d_handle_t * hdma2d;
+
+#if LV_DRAW_ACTS_DMA2D_BATCH_SIZE > 0
+    /* submitted draw tasks whose DMA2D commands are not completed yet */
+    lv_draw_dma2d_batch_t batch[LV_DRAW_ACTS_DMA2D_BATCH_SIZE];
+    uint8_t batch_cnt;
+    /* command sequence of the last command submitted for task_act, -1 if none */
+    int32_t last_seq;
+#endif
+
+#if LV_DRAW_ACTS_DMA2D_SPLIT
+    /* the CPU is drawing the other band, do not wait for the DMA2D band */
+    bool split_act;
+#endif
 } lv_draw_dma2d_unit_t;
 
 /**********************
@@ -54,12 +171,47 @@ static int32_t _dma2d_draw_evaluate(lv_draw_unit_t * draw_unit, lv_draw_task_t *
 static int32_t _dma2d_draw_delete(lv_draw_unit_t * draw_unit);
 static int32_t _dma2d_wait_for_finish(lv_draw_unit_t * draw_unit);
 
+#if DMA2D_USE_XFER_CALLBACK
+static void _dma2d_xfer_callback(hal_dma2d_handle_t * hdma2d, uint16_t cmd_seq, uint32_t error_code);
+#endif
+
+#if LV_DRAW_ACTS_DMA2D_BATCH_SIZE > 0
+static void _dma2d_batch_retire(lv_draw_dma2d_unit_t * u, bool wait);
+#endif
+
+#if LV_DRAW_ACTS_DMA2D_SPLIT
+static void _dma2d_split_calibrate(lv_draw_dma2d_unit_t * u);
+static bool _dma2d_split_begin(lv_draw_unit_t * draw_unit, const lv_area_t * draw_area,
+                               uint8_t cost_idx, lv_dma2d_split_t * split);
+static void _dma2d_split_cpu_begin(lv_draw_unit_t * draw_unit, lv_dma2d_split_t * split, int dma2d_seq);
+static void _dma2d_split_cancel(lv_draw_unit_t * draw_unit);
+static void _dma2d_split_end(lv_draw_unit_t * draw_unit, lv_dma2d_split_t * split);
+static void _dma2d_split_collect(void);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
 
 static hal_dma2d_handle_t g_hdma2d __in_section_unique(lvgl.noinit.gpu);
 
+#if LV_DRAW_ACTS_DMA2D_BATCH_SIZE > 0
+/* command sequence of the latest completed DMA2D command, -1 if none */
+static atomic_t g_dma2d_done_seq = ATOMIC_INIT(-1);
+#endif
+
+#if LV_DRAW_ACTS_DMA2D_SPLIT
+static lv_dma2d_split_cost_t g_split_cost[] = {
+    { .cf = LV_COLOR_FORMAT_RGB565, },
+    { .cf = LV_COLOR_FORMAT_RGB888, },
+    { .cf = LV_COLOR_FORMAT_ARGB8888, },
+    { .cf = LV_COLOR_FORMAT_XRGB8888, },
+};
+
+static lv_dma2d_split_pending_t g_split_pending = { .seq = -1, };
+static lv_gpu_split_stats_t g_split_stats;
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -75,6 +227,10 @@ void lv_gpu_draw_dma2d_init(void)
         return;
     }
 
+#if DMA2D_USE_XFER_CALLBACK
+    hal_dma2d_register_callback(&g_hdma2d, _dma2d_xfer_callback);
+#endif
+
     lv_draw_dma2d_unit_t * draw_unit = lv_draw_create_unit(sizeof(*draw_unit));
     if (draw_unit) {
         draw_unit->hdma2d = &g_hdma2d;
@@ -82,9 +238,33 @@ void lv_gpu_draw_dma2d_init(void)
         draw_unit->base_unit.evaluate_cb = _dma2d_draw_evaluate;
         draw_unit->base_unit.delete_cb = _dma2d_draw_delete;
         draw_unit->base_unit.wait_for_finish_cb = _dma2d_wait_for_finish;
+
+#if LV_DRAW_ACTS_DMA2D_SPLIT
+        _dma2d_split_calibrate(draw_unit);
+#endif
     }
 }
 
+void lv_gpu_draw_dma2d_get_split_stats(lv_gpu_split_stats_t * stats, bool reset)
+{
+#if LV_DRAW_ACTS_DMA2D_SPLIT
+    lv_gpu_split_engine_stats_t * engines[] = { &stats->dma2d, &stats->cpu };
+
+    _dma2d_split_collect();
+
+    *stats = g_split_stats;
+    for (int i = 0; i < DMA2D_SPLIT_NUM_ENGINES; i++) {
+        engines[i]->pixels_per_sec = (engines[i]->busy_us > 0) ?
+                (uint32_t)((uint64_t)engines[i]->pixels * 1000000 / engines[i]->busy_us) : 0;
+    }
+
+    if (reset) lv_memzero(&g_split_stats, sizeof(g_split_stats));
+#else
+    LV_UNUSED(reset);
+    lv_memzero(stats, sizeof(*stats));
+#endif
+}
+
 lv_result_t lv_gpu_draw_buf_dma2d_clear(lv_draw_buf_t * draw_buf, const lv_area_t * area)
 {
     hal_dma2d_handle_t * hdma2d = &g_hdma2d;
@@ -292,6 +472,27 @@ static bool _dma2d_src_cf_rotation_supported(lv_color_format_t cf)
     }
 }
 
+static void _dma2d_cmd_submitted(lv_draw_unit_t * draw_unit, int cmd_seq)
+{
+    lv_draw_dma2d_unit_t * u = (lv_draw_dma2d_unit_t *)draw_unit;
+
+#if LV_DRAW_ACTS_DMA2D_BATCH_SIZE > 0
+    u->last_seq = cmd_seq;
+#else
+    LV_UNUSED(cmd_seq);
+#endif
+
+#if DMA2D_POLL_EACH_CMD
+#if LV_DRAW_ACTS_DMA2D_SPLIT
+    /* polled in _dma2d_split_end() after the CPU band drawn */
+    if (u->split_act) return;
+#endif
+    hal_dma2d_poll_transfer(u->hdma2d, -1);
+#else
+    LV_UNUSED(u);
+#endif
+}
+
 static int _dma2d_fill(lv_draw_unit_t * draw_unit, const lv_area_t * clip_a, lv_color_t color, lv_opa_t opa)
 {
     hal_dma2d_handle_t * hdma2d = ((lv_draw_dma2d_unit_t *)draw_unit)->hdma2d;
@@ -334,9 +535,7 @@ static int _dma2d_fill(lv_draw_unit_t * draw_unit, const lv_area_t * clip_a, lv_
             dest_addr, dest_w, dest_h, dest_buf->header.stride, dest_buf->header.cf);
     }
     else {
-#if LV_USE_DRAW_VG_LITE
-        hal_dma2d_poll_transfer(hdma2d, -1);
-#endif
+        _dma2d_cmd_submitted(draw_unit, res);
     }
 
     return res;
@@ -393,9 +592,7 @@ static int _dma2d_rotate(lv_draw_unit_t * draw_unit, const lv_area_t * clip_a,
             dest_addr, dest_w, dest_h, dest_buf->header.stride, dest_buf->header.cf);
     }
     else {
-#if LV_USE_DRAW_VG_LITE
-        hal_dma2d_poll_transfer(hdma2d, -1);
-#endif
+        _dma2d_cmd_submitted(draw_unit, res);
     }
 
     return res;
@@ -481,9 +678,7 @@ static int _dma2d_blit(lv_draw_unit_t * draw_unit, const lv_area_t * clip_a,
                 src_addr, src_buf->header.w, src_buf->header.h, src_buf->header.stride, src_buf->header.cf);
     }
     else {
-#if LV_USE_DRAW_VG_LITE
-        hal_dma2d_poll_transfer(hdma2d, -1);
-#endif
+        _dma2d_cmd_submitted(draw_unit, res);
     }
 
     return res;
@@ -505,6 +700,25 @@ static void _dma2d_draw_fill(lv_draw_unit_t * draw_unit,
 
     LV_PROFILER_BEGIN;
 
+#if LV_DRAW_ACTS_DMA2D_SPLIT
+    lv_dma2d_split_t split;
+    uint8_t cost_idx = (dsc->opa < LV_OPA_MAX) ? DMA2D_SPLIT_COST_BLEND : DMA2D_SPLIT_COST_FILL;
+
+    if (_dma2d_split_begin(draw_unit, &draw_area, cost_idx, &split)) {
+        int res = _dma2d_fill(draw_unit, &split.dma2d_area, dsc->color, dsc->opa);
+        if (res >= 0) {
+            _dma2d_split_cpu_begin(draw_unit, &split, res);
+            lv_draw_sw_fill(draw_unit, dsc, coords);
+            _dma2d_split_end(draw_unit, &split);
+
+            LV_PROFILER_END;
+            return;
+        }
+
+        _dma2d_split_cancel(draw_unit);
+    }
+#endif
+
     if (_dma2d_fill(draw_unit, &draw_area, dsc->color, dsc->opa) < 0)
         lv_draw_sw_fill(draw_unit, dsc, coords);
 
@@ -641,6 +855,31 @@ static void _dma2d_draw_image(lv_draw_unit_t * draw_unit, const lv_draw_image_ds
         }
         else {
             lv_area_move(&rel_img_area, -coords->x1, -coords->y1);
+
+#if LV_DRAW_ACTS_DMA2D_SPLIT
+            lv_dma2d_split_t split;
+            bool split_done = false;
+
+            if (draw_dsc->scale_x == LV_SCALE_NONE && draw_dsc->scale_y == LV_SCALE_NONE &&
+                _dma2d_split_begin(draw_unit, &draw_area, DMA2D_SPLIT_COST_BLEND, &split)) {
+                lv_area_t rel_band_area = rel_img_area;
+                rel_band_area.y2 = rel_band_area.y1 + lv_area_get_height(&split.dma2d_area) - 1;
+
+                int res = _dma2d_blit(draw_unit, &split.dma2d_area, (void *)decoder_dsc.decoded,
+                                      &rel_band_area, draw_dsc->recolor, draw_dsc->opa);
+                if (res >= 0) {
+                    _dma2d_split_cpu_begin(draw_unit, &split, res);
+                    lv_draw_sw_image(draw_unit, draw_dsc, coords);
+                    _dma2d_split_end(draw_unit, &split);
+                    split_done = true;
+                }
+                else {
+                    _dma2d_split_cancel(draw_unit);
+                }
+            }
+
+            if (!split_done)
+#endif
             _dma2d_blit(draw_unit, &draw_area, (void *)decoder_dsc.decoded, &rel_img_area,
                         draw_dsc->recolor, draw_dsc->opa);
         }
@@ -693,7 +932,7 @@ static void _dma2d_draw_glyph(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t *
                           glyph_dsc->color, glyph_dsc->opa);
     }
 
-#if LV_USE_DRAW_VG_LITE == 0
+#if DMA2D_POLL_EACH_CMD == 0
     /* FIXME: temp glyph data ? */
     _dma2d_draw_wait_finish(draw_unit);
 #endif
@@ -798,12 +1037,25 @@ static int32_t _dma2d_draw_dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * lay
     /* Return immediately if it's busy with draw task. */
     if (u->task_act) return 0;
 
+#if LV_DRAW_ACTS_DMA2D_BATCH_SIZE > 0
+    /* Release the completed tasks, and wait for the batch only when it is full. */
+    _dma2d_batch_retire(u, u->batch_cnt >= LV_DRAW_ACTS_DMA2D_BATCH_SIZE);
+#endif
+
     /* Try to get an ready to draw. */
     lv_draw_task_t * t = lv_draw_get_next_available_task(layer, NULL, DMA2D_DRAW_UNIT_ID);
 
     /* Return 0 is no selection, some tasks can be supported by other units. */
     if (t == NULL || t->preferred_draw_unit_id != DMA2D_DRAW_UNIT_ID) {
+#if LV_DRAW_ACTS_DMA2D_BATCH_SIZE > 0
+        /*
+         * Keep the batch in flight, other units can draw the independent tasks
+         * meanwhile. It is waited in _dma2d_wait_for_finish() or retired in the
+         * next dispatching.
+         */
+#else
         _dma2d_draw_wait_finish(draw_unit);
+#endif
         return LV_DRAW_UNIT_IDLE;
     }
 
@@ -815,9 +1067,25 @@ static int32_t _dma2d_draw_dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * lay
     u->base_unit.clip_area = &t->clip_area;
     u->task_act = t;
 
+#if LV_DRAW_ACTS_DMA2D_BATCH_SIZE > 0
+    u->last_seq = -1;
+    _dma2d_draw_execute(u);
+
+    if (u->last_seq >= 0 && hal_dma2d_get_state(u->hdma2d) == HAL_DMA2D_STATE_BUSY) {
+        /* Keep it in progress to hold back the dependent tasks */
+        u->batch[u->batch_cnt].task = t;
+        u->batch[u->batch_cnt].seq = (uint16_t)u->last_seq;
+        u->batch_cnt++;
+    }
+    else {
+        u->task_act->state = LV_DRAW_TASK_STATE_READY;
+    }
+#else
     _dma2d_draw_execute(u);
 
     u->task_act->state = LV_DRAW_TASK_STATE_READY;
+#endif
+
     u->task_act = NULL;
 
     /* Request a new dispatching as it can get a new task. */
@@ -958,7 +1226,268 @@ static int32_t _dma2d_wait_for_finish(lv_draw_unit_t * draw_unit)
 {
     lv_draw_dma2d_unit_t * u = (lv_draw_dma2d_unit_t *)draw_unit;
     hal_dma2d_poll_transfer(u->hdma2d, -1);
+#if LV_DRAW_ACTS_DMA2D_BATCH_SIZE > 0
+    _dma2d_batch_retire(u, false);
+#endif
     return 0;
 }
 
+#if DMA2D_USE_XFER_CALLBACK
+static void _dma2d_xfer_callback(hal_dma2d_handle_t * hdma2d, uint16_t cmd_seq, uint32_t error_code)
+{
+    LV_UNUSED(hdma2d);
+    LV_UNUSED(error_code);
+
+    /* may called in interrupt routine */
+#if LV_DRAW_ACTS_DMA2D_BATCH_SIZE > 0
+    atomic_set(&g_dma2d_done_seq, cmd_seq);
+#endif
+
+#if LV_DRAW_ACTS_DMA2D_SPLIT
+    if (g_split_pending.seq == cmd_seq || g_split_pending.seq == DMA2D_SPLIT_SEQ_ARMED) {
+        g_split_pending.end = k_cycle_get_32();
+        g_split_pending.seq = -1;
+    }
+#endif
+}
+#endif /* DMA2D_USE_XFER_CALLBACK */
+
+#if LV_DRAW_ACTS_DMA2D_BATCH_SIZE > 0
+static void _dma2d_batch_retire(lv_draw_dma2d_unit_t * u, bool wait)
+{
+    if (u->batch_cnt == 0) return;
+
+    if (wait) hal_dma2d_poll_transfer(u->hdma2d, -1);
+
+    /* DMA2D commands are completed in order */
+    bool all_done = (hal_dma2d_get_state(u->hdma2d) != HAL_DMA2D_STATE_BUSY);
+    atomic_val_t done_seq = atomic_get(&g_dma2d_done_seq);
+    uint8_t cnt = 0;
+
+    for (uint8_t i = 0; i < u->batch_cnt; i++) {
+        if (all_done || (done_seq >= 0 && (int16_t)((uint16_t)done_seq - u->batch[i].seq) >= 0)) {
+            u->batch[i].task->state = LV_DRAW_TASK_STATE_READY;
+        }
+        else {
+            u->batch[cnt++] = u->batch[i];
+        }
+    }
+
+    if (cnt < u->batch_cnt) {
+        u->batch_cnt = cnt;
+        /* Request a new dispatching as the dependent tasks can be drawn now. */
+        lv_draw_dispatch_request();
+    }
+}
+#endif /* LV_DRAW_ACTS_DMA2D_BATCH_SIZE > 0 */
+
+#if LV_DRAW_ACTS_DMA2D_SPLIT
+static uint32_t _dma2d_split_rate(uint32_t pixels, uint32_t cycles)
+{
+    uint32_t us = k_cyc_to_us_floor32(cycles);
+    return (uint32_t)((uint64_t)pixels * 1000 / LV_MAX(us, 1));
+}
+
+static void _dma2d_split_account(lv_dma2d_split_cost_t * cost, uint8_t cost_idx,
+                                 uint8_t engine, uint32_t pixels, uint32_t cycles)
+{
+    lv_gpu_split_engine_stats_t * stats = (engine == DMA2D_SPLIT_ENGINE_DMA2D) ?
+            &g_split_stats.dma2d : &g_split_stats.cpu;
+    uint32_t rate = _dma2d_split_rate(pixels, cycles);
+
+    stats->busy_us += k_cyc_to_us_floor32(cycles);
+    stats->pixels += pixels;
+
+    /* refine the boot calibration with the measured throughput */
+    cost->ppms[cost_idx][engine] = (cost->ppms[cost_idx][engine] * 3 + rate) / 4;
+}
+
+static void _dma2d_split_calibrate(lv_draw_dma2d_unit_t * u)
+{
+    lv_area_t area = { 0, 0, DMA2D_SPLIT_CALIB_W - 1, DMA2D_SPLIT_CALIB_H - 1 };
+    uint32_t pixels = DMA2D_SPLIT_CALIB_W * DMA2D_SPLIT_CALIB_H;
+    lv_draw_fill_dsc_t fill_dsc;
+    lv_layer_t layer;
+    uint32_t start;
+
+    lv_memzero(&layer, sizeof(layer));
+    layer.buf_area = area;
+    lv_draw_fill_dsc_init(&fill_dsc);
+    fill_dsc.color = lv_color_black();
+
+    u->base_unit.target_layer = &layer;
+    u->base_unit.clip_area = &area;
+
+    for (int i = 0; i < ARRAY_SIZE(g_split_cost); i++) {
+        lv_dma2d_split_cost_t * cost = &g_split_cost[i];
+
+        layer.color_format = cost->cf;
+        layer.draw_buf = lv_draw_buf_create(DMA2D_SPLIT_CALIB_W, DMA2D_SPLIT_CALIB_H, cost->cf, LV_STRIDE_AUTO);
+        if (layer.draw_buf == NULL) continue;
+
+        for (int j = 0; j < DMA2D_SPLIT_NUM_COSTS; j++) {
+            fill_dsc.opa = (j == DMA2D_SPLIT_COST_FILL) ? LV_OPA_COVER : LV_OPA_50;
+
+            start = k_cycle_get_32();
+            if (_dma2d_fill(&u->base_unit, &area, fill_dsc.color, fill_dsc.opa) >= 0 &&
+                hal_dma2d_poll_transfer(u->hdma2d, -1) == 0) {
+                cost->ppms[j][DMA2D_SPLIT_ENGINE_DMA2D] = _dma2d_split_rate(pixels, k_cycle_get_32() - start);
+            }
+
+            start = k_cycle_get_32();
+            lv_draw_sw_fill(&u->base_unit, &fill_dsc, &area);
+            cost->ppms[j][DMA2D_SPLIT_ENGINE_CPU] = _dma2d_split_rate(pixels, k_cycle_get_32() - start);
+
+            LV_LOG_INFO("cf %d cost %d: DMA2D %u px/ms, CPU %u px/ms", cost->cf, j,
+                        cost->ppms[j][DMA2D_SPLIT_ENGINE_DMA2D], cost->ppms[j][DMA2D_SPLIT_ENGINE_CPU]);
+        }
+
+        lv_draw_buf_destroy(layer.draw_buf);
+    }
+
+    u->base_unit.target_layer = NULL;
+    u->base_unit.clip_area = NULL;
+}
+
+static bool _dma2d_split_band_aligned(lv_layer_t * layer, const lv_area_t * draw_area, int32_t rows)
+{
+    uint8_t * addr = lv_draw_buf_goto_xy(layer->draw_buf, draw_area->x1 - layer->buf_area.x1,
+                                         draw_area->y1 + rows - layer->buf_area.y1);
+
+    return ((uintptr_t)addr & (DMA2D_SPLIT_ALIGN - 1)) == 0;
+}
+
+static bool _dma2d_split_begin(lv_draw_unit_t * draw_unit, const lv_area_t * draw_area,
+                               uint8_t cost_idx, lv_dma2d_split_t * split)
+{
+    lv_layer_t * layer = draw_unit->target_layer;
+    int32_t h = lv_area_get_height(draw_area);
+    lv_dma2d_split_cost_t * cost = NULL;
+
+    if (lv_area_get_size(draw_area) < LV_DRAW_ACTS_DMA2D_SPLIT_MIN_SIZE || h < DMA2D_SPLIT_MIN_ROWS * 2)
+        return false;
+
+    for (int i = 0; i < ARRAY_SIZE(g_split_cost); i++) {
+        if (g_split_cost[i].cf == layer->draw_buf->header.cf) {
+            cost = &g_split_cost[i];
+            break;
+        }
+    }
+
+    if (cost == NULL) return false;
+
+    uint32_t dma2d_ppms = cost->ppms[cost_idx][DMA2D_SPLIT_ENGINE_DMA2D];
+    uint32_t cpu_ppms = cost->ppms[cost_idx][DMA2D_SPLIT_ENGINE_CPU];
+    if (dma2d_ppms == 0 || cpu_ppms == 0) return false;
+
+    /* DMA2D takes the top band, sized to finish at the same time as the CPU band */
+    int32_t rows = (int32_t)((uint64_t)h * dma2d_ppms / (dma2d_ppms + cpu_ppms));
+    int32_t delta;
+
+    for (delta = 0; delta <= DMA2D_SPLIT_ALIGN_ROWS; delta++) {
+        if (rows - delta >= DMA2D_SPLIT_MIN_ROWS && rows - delta <= h - DMA2D_SPLIT_MIN_ROWS &&
+            _dma2d_split_band_aligned(layer, draw_area, rows - delta)) {
+            rows -= delta;
+            break;
+        }
+
+        if (rows + delta >= DMA2D_SPLIT_MIN_ROWS && rows + delta <= h - DMA2D_SPLIT_MIN_ROWS &&
+            _dma2d_split_band_aligned(layer, draw_area, rows + delta)) {
+            rows += delta;
+            break;
+        }
+    }
+
+    if (delta > DMA2D_SPLIT_ALIGN_ROWS) return false;
+
+    split->cost = cost;
+    split->cost_idx = cost_idx;
+    split->dma2d_area = *draw_area;
+    split->dma2d_area.y2 = draw_area->y1 + rows - 1;
+    split->cpu_area = *draw_area;
+    split->cpu_area.y1 = draw_area->y1 + rows;
+    split->dma2d_idle = (hal_dma2d_get_state(((lv_draw_dma2d_unit_t *)draw_unit)->hdma2d) != HAL_DMA2D_STATE_BUSY);
+
+    _dma2d_split_collect();
+
+    /*
+     * Only measure the band if DMA2D was idle, otherwise the time includes
+     * the commands queued ahead. Armed before the command is submitted, so
+     * the first completion is the band even if it comes before the sequence
+     * is known.
+     */
+    unsigned int key = irq_lock();
+    g_split_pending.seq = -1;
+    if (split->dma2d_idle) {
+        g_split_pending.cost = cost;
+        g_split_pending.cost_idx = cost_idx;
+        g_split_pending.pixels = lv_area_get_size(&split->dma2d_area);
+        g_split_pending.end = 0;
+        g_split_pending.seq = DMA2D_SPLIT_SEQ_ARMED;
+    }
+    else {
+        g_split_pending.cost = NULL;
+    }
+    split->dma2d_start = k_cycle_get_32();
+    g_split_pending.start = split->dma2d_start;
+    irq_unlock(key);
+
+    ((lv_draw_dma2d_unit_t *)draw_unit)->split_act = true;
+    return true;
+}
+
+static void _dma2d_split_cpu_begin(lv_draw_unit_t * draw_unit, lv_dma2d_split_t * split, int dma2d_seq)
+{
+    unsigned int key;
+
+    /* still pending, wait for the completion of this sequence */
+    key = irq_lock();
+    if (g_split_pending.seq == DMA2D_SPLIT_SEQ_ARMED) {
+        g_split_pending.seq = (uint16_t)dma2d_seq;
+    }
+    irq_unlock(key);
+
+    split->clip_area = draw_unit->clip_area;
+    draw_unit->clip_area = &split->cpu_area;
+    split->cpu_start = k_cycle_get_32();
+}
+
+static void _dma2d_split_end(lv_draw_unit_t * draw_unit, lv_dma2d_split_t * split)
+{
+    lv_draw_dma2d_unit_t * u = (lv_draw_dma2d_unit_t *)draw_unit;
+
+    _dma2d_split_account(split->cost, split->cost_idx, DMA2D_SPLIT_ENGINE_CPU,
+                         lv_area_get_size(&split->cpu_area), k_cycle_get_32() - split->cpu_start);
+
+    draw_unit->clip_area = split->clip_area;
+    u->split_act = false;
+    g_split_stats.split_cnt++;
+
+#if DMA2D_POLL_EACH_CMD
+    hal_dma2d_poll_transfer(u->hdma2d, -1);
+#endif
+}
+
+static void _dma2d_split_cancel(lv_draw_unit_t * draw_unit)
+{
+    unsigned int key = irq_lock();
+    g_split_pending.cost = NULL;
+    g_split_pending.seq = -1;
+    irq_unlock(key);
+
+    ((lv_draw_dma2d_unit_t *)draw_unit)->split_act = false;
+}
+
+static void _dma2d_split_collect(void)
+{
+    lv_dma2d_split_pending_t * pending = &g_split_pending;
+
+    if (pending->cost == NULL || pending->seq != -1) return;
+
+    _dma2d_split_account(pending->cost, pending->cost_idx, DMA2D_SPLIT_ENGINE_DMA2D,
+                         pending->pixels, pending->end - pending->start);
+    pending->cost = NULL;
+}
+#endif /* LV_DRAW_ACTS_DMA2D_SPLIT */
+
 #endif /* LV_USE_DRAW_ACTS_DMA2D */
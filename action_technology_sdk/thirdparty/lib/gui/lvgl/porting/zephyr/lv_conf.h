@@ -59,6 +59,20 @@
     #endif
 #endif
 
+#ifdef CONFIG_LV_DRAW_ACTS_DMA2D_BATCH_SIZE
+    #define LV_DRAW_ACTS_DMA2D_BATCH_SIZE CONFIG_LV_DRAW_ACTS_DMA2D_BATCH_SIZE
+#endif
+
+#if defined(CONFIG_UI_GUI_FRAME_ARENA_SIZE) && CONFIG_UI_GUI_FRAME_ARENA_SIZE > 0
+    /*Draw tasks and their descriptors come from the GUI frame arena*/
+    #define LV_DRAW_TASK_USE_CUSTOM_MALLOC 1
+#endif
+
+#ifdef CONFIG_LV_DRAW_ACTS_DMA2D_SPLIT
+    #define LV_DRAW_ACTS_DMA2D_SPLIT 1
+    #define LV_DRAW_ACTS_DMA2D_SPLIT_MIN_SIZE CONFIG_LV_DRAW_ACTS_DMA2D_SPLIT_MIN_SIZE
+#endif
+
 /*-------------
  * Asserts
  *-----------*/
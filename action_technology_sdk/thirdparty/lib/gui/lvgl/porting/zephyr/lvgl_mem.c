@@ -5,6 +5,7 @@
  */
 
 #include "../../src/stdlib/lv_mem.h"
+#include "../../src/draw/lv_draw_private.h"
 
 #if LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM
 #include <zephyr.h>
@@ -122,6 +123,13 @@ void lv_free_core(void * p)
 #endif
 }
 
+#if defined(LV_DRAW_TASK_USE_CUSTOM_MALLOC) && LV_DRAW_TASK_USE_CUSTOM_MALLOC
+void * lv_draw_task_malloc_core(size_t size)
+{
+    return ui_mem_gui_frame_alloc(size);
+}
+#endif
+
 void lv_mem_monitor_core(lv_mem_monitor_t * mon_p)
 {
     /*Not supported*/
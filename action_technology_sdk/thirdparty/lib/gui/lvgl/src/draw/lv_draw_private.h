@@ -185,10 +185,28 @@ typedef struct {
  * GLOBAL PROTOTYPES
  **********************/
 
+#if defined(LV_DRAW_TASK_USE_CUSTOM_MALLOC) && LV_DRAW_TASK_USE_CUSTOM_MALLOC
+/**
+ * Allocate a draw task, its draw descriptor or the local text of a label.
+ * Implemented by the port. The memory is released by `lv_free()` when the
+ * task is dispatched, so it never outlives the refresh in which the task
+ * is added.
+ * @param size      size in bytes
+ * @return          pointer to the memory or NULL on error
+ */
+void * lv_draw_task_malloc_core(size_t size);
+#endif
+
 /**********************
  *      MACROS
  **********************/
 
+#if defined(LV_DRAW_TASK_USE_CUSTOM_MALLOC) && LV_DRAW_TASK_USE_CUSTOM_MALLOC
+#define lv_draw_task_malloc(size) lv_draw_task_malloc_core(size)
+#else
+#define lv_draw_task_malloc(size) lv_malloc(size)
+#endif
+
 #ifdef __cplusplus
 } /*extern "C"*/
 #endif
@@ -51,7 +51,7 @@ void lv_draw_vector_custom(lv_layer_t * layer, const lv_draw_vector_custom_dsc_t
 {
     lv_draw_task_t * t = lv_draw_add_task(layer, coords ? coords : &(layer->_clip_area));
     t->type = LV_DRAW_TASK_TYPE_VECTOR_CUSTOM;
-    t->draw_dsc = lv_malloc(sizeof(*dsc));
+    t->draw_dsc = lv_draw_task_malloc(sizeof(*dsc));
     lv_memcpy(t->draw_dsc, dsc, sizeof(*dsc));
     lv_draw_finalize_task_creation(layer, t);
 }
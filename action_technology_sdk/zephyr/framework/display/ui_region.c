@@ -326,4 +326,323 @@ bool ui_region_is_valid(const ui_region_t * region)
 bool ui_region_is_empty(const ui_region_t *region)
 {
 	return ui_region_get_width(region) <= 0 || ui_region_get_height(region) <= 0;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Remove a region from a region list by index
+ *
+ * The order of the list is not preserved.
+ */
+static void _region_list_remove(ui_region_list_t * list, int index)
+{
+	list->rects[index] = list->rects[--list->count];
+}
+
+/**
+ * @brief Get the pixels wasted when merging two regions into their bounding box
+ */
+static int32_t _region_merge_waste(const ui_region_t * region1, const ui_region_t * region2)
+{
+	ui_region_t merged;
+
+	ui_region_merge(&merged, region1, region2);
+
+	return ui_region_get_size(&merged) - ui_region_get_size(region1) - ui_region_get_size(region2);
+}
+
+/**
+ * @brief Get the cost of a region list under a cost model
+ */
+static int64_t _region_list_cost(const ui_region_list_t * list, const ui_region_cost_t * cost)
+{
+	return (int64_t)cost->pixel_cost * ui_region_list_get_size(list) +
+			(int64_t)cost->rect_cost * list->count;
+}
+
+/**
+ * @brief Add a region by absorbing all the overlapped regions into its bounding box
+ *
+ * The list count never increases except when the region is disjoint and there
+ * is room left.
+ */
+static void _region_list_cover(ui_region_list_t * list, const ui_region_t * region)
+{
+	ui_region_t merged;
+	bool absorbed;
+
+	ui_region_copy(&merged, region);
+
+	do {
+		absorbed = false;
+
+		for (int i = list->count - 1; i >= 0; i--) {
+			if (ui_region_is_on(&list->rects[i], &merged)) {
+				ui_region_merge(&merged, &merged, &list->rects[i]);
+				_region_list_remove(list, i);
+				absorbed = true;
+			}
+		}
+
+		if (!absorbed && list->count >= UI_REGION_LIST_MAX_RECTS) {
+			int32_t min_waste = INT32_MAX;
+			int best = 0;
+
+			/* no room left, absorb the neighbour which wastes the least pixels */
+			for (int i = 0; i < list->count; i++) {
+				int32_t waste = _region_merge_waste(&merged, &list->rects[i]);
+				if (waste < min_waste) {
+					min_waste = waste;
+					best = i;
+				}
+			}
+
+			ui_region_merge(&merged, &merged, &list->rects[best]);
+			_region_list_remove(list, best);
+			absorbed = true;
+		}
+	} while (absorbed);
+
+	ui_region_copy(&list->rects[list->count++], &merged);
+}
+
+/**
+ * @brief Get the number of pixels covered by a region list
+ *
+ * @param list pointer to a region list
+ *
+ * @retval number of pixels
+ */
+int32_t ui_region_list_get_size(const ui_region_list_t * list)
+{
+	int32_t size = 0;
+
+	for (int i = 0; i < list->count; i++) {
+		size += ui_region_get_size(&list->rects[i]);
+	}
+
+	return size;
+}
+
+/**
+ * @brief Get the bounding box of a region list
+ *
+ * @param result pointer to an region, the result will be stored here
+ * @param list pointer to a region list
+ *
+ * @return false: the list is empty, result is invalid
+ */
+bool ui_region_list_get_bounds(ui_region_t * result, const ui_region_list_t * list)
+{
+	if (list->count == 0) {
+		return false;
+	}
+
+	ui_region_copy(result, &list->rects[0]);
+
+	for (int i = 1; i < list->count; i++) {
+		ui_region_merge(result, result, &list->rects[i]);
+	}
+
+	return true;
+}
+
+/**
+ * @brief Check if a region list has common parts with a region
+ *
+ * @param list pointer to a region list
+ * @param region pointer to a region
+ *
+ * @return false: the list and the region have no common parts
+ */
+bool ui_region_list_is_on(const ui_region_list_t * list, const ui_region_t * region)
+{
+	for (int i = 0; i < list->count; i++) {
+		if (ui_region_is_on(&list->rects[i], region)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * @brief Union a region into a region list
+ *
+ * @param list pointer to a region list
+ * @param region pointer to the region to add
+ *
+ * @retval N/A
+ */
+void __ramfunc ui_region_list_add(ui_region_list_t * list, const ui_region_t * region)
+{
+	ui_region_t pieces[UI_REGION_LIST_MAX_RECTS];
+	ui_region_t splits[4];
+	int num_pieces = 1;
+
+	if (ui_region_is_empty(region)) {
+		return;
+	}
+
+	for (int i = list->count - 1; i >= 0; i--) {
+		if (ui_region_is_in(region, &list->rects[i])) {
+			return;
+		}
+
+		if (ui_region_is_in(&list->rects[i], region)) {
+			_region_list_remove(list, i);
+		}
+	}
+
+	/* split the region into parts which do not overlap the existing ones */
+	ui_region_copy(&pieces[0], region);
+
+	for (int i = 0; i < list->count && num_pieces > 0; i++) {
+		for (int j = num_pieces - 1; j >= 0; j--) {
+			int num_splits;
+
+			if (!ui_region_is_on(&pieces[j], &list->rects[i])) {
+				continue;
+			}
+
+			num_splits = ui_region_subtract(splits, &pieces[j], &list->rects[i]);
+			if (num_pieces - 1 + num_splits > UI_REGION_LIST_MAX_RECTS) {
+				_region_list_cover(list, region);
+				return;
+			}
+
+			pieces[j] = pieces[--num_pieces];
+			for (int k = 0; k < num_splits; k++) {
+				pieces[num_pieces++] = splits[k];
+			}
+		}
+	}
+
+	if (list->count + num_pieces > UI_REGION_LIST_MAX_RECTS) {
+		_region_list_cover(list, region);
+		return;
+	}
+
+	for (int i = 0; i < num_pieces; i++) {
+		ui_region_copy(&list->rects[list->count++], &pieces[i]);
+	}
+}
+
+/**
+ * @brief Union a region list into another
+ *
+ * @param list pointer to the destination region list
+ * @param other pointer to the region list to add
+ *
+ * @retval N/A
+ */
+void ui_region_list_union(ui_region_list_t * list, const ui_region_list_t * other)
+{
+	for (int i = 0; i < other->count; i++) {
+		ui_region_list_add(list, &other->rects[i]);
+	}
+}
+
+/**
+ * @brief Subtract a region from a region list
+ *
+ * @param list pointer to a region list
+ * @param exclude pointer to the region to be subtracted
+ *
+ * @retval N/A
+ */
+void ui_region_list_subtract(ui_region_list_t * list, const ui_region_t * exclude)
+{
+	ui_region_t splits[4];
+
+	for (int i = list->count - 1; i >= 0; i--) {
+		int num_splits;
+
+		if (!ui_region_is_on(&list->rects[i], exclude)) {
+			continue;
+		}
+
+		if (ui_region_is_in(&list->rects[i], exclude)) {
+			_region_list_remove(list, i);
+			continue;
+		}
+
+		num_splits = ui_region_subtract(splits, &list->rects[i], exclude);
+		if (list->count - 1 + num_splits > UI_REGION_LIST_MAX_RECTS) {
+			continue; /* keep it whole */
+		}
+
+		/* the splits are inside the removed one, so never overlap others */
+		list->rects[i] = splits[0];
+		for (int k = 1; k < num_splits; k++) {
+			ui_region_copy(&list->rects[list->count++], &splits[k]);
+		}
+	}
+}
+
+/**
+ * @brief Clip a region list by a region
+ *
+ * @param list pointer to a region list
+ * @param clip pointer to the clip region
+ *
+ * @return false: the result list is empty
+ */
+bool ui_region_list_intersect(ui_region_list_t * list, const ui_region_t * clip)
+{
+	for (int i = list->count - 1; i >= 0; i--) {
+		if (!ui_region_intersect(&list->rects[i], &list->rects[i], clip)) {
+			_region_list_remove(list, i);
+		}
+	}
+
+	return list->count > 0;
+}
+
+/**
+ * @brief Coalesce the regions of a list while it lowers the total cost
+ *
+ * @param list pointer to a region list
+ * @param cost pointer to the cost model
+ *
+ * @retval N/A
+ */
+void ui_region_list_coalesce(ui_region_list_t * list, const ui_region_cost_t * cost)
+{
+	ui_region_list_t trial, best;
+
+	while (list->count > 1) {
+		int64_t list_cost = _region_list_cost(list, cost);
+		int64_t min_cost = list_cost;
+
+		/*
+		 * find the pair whose merging saves the most. The bounding box
+		 * may absorb further regions, so compare the whole list cost.
+		 */
+		for (int i = 0; i < list->count - 1; i++) {
+			for (int j = i + 1; j < list->count; j++) {
+				int64_t trial_cost;
+				ui_region_t merged;
+
+				ui_region_merge(&merged, &list->rects[i], &list->rects[j]);
+
+				trial = *list;
+				/* j > i, so remove j first */
+				_region_list_remove(&trial, j);
+				_region_list_remove(&trial, i);
+				_region_list_cover(&trial, &merged);
+
+				trial_cost = _region_list_cost(&trial, cost);
+				if (trial_cost < min_cost) {
+					min_cost = trial_cost;
+					best = trial;
+				}
+			}
+		}
+
+		if (min_cost >= list_cost) {
+			break;
+		}
+
+		*list = best;
+	}
+}
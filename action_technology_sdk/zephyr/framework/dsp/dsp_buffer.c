@@ -5,33 +5,182 @@
  */
 
 #include <mem_manager.h>
+#ifdef CONFIG_DSP_SESSION_BUF_DMA
+#include <drivers/dma.h>
+#include <drivers/cfg_drv/dev_config.h>
+#include <memory/mem_cache.h>
+#endif
 #include "dsp_inner.h"
 
-#define MAX_SESSION_BUFF_NUM 20
-static struct dsp_session_buf buff_pool[MAX_SESSION_BUFF_NUM] __in_section_unique(DSP_SHARE_RAM);
-static int bit_mask = 0;
+/* session buffers come in chunks, the first one static in DSP_SHARE_RAM */
+#define SESSION_BUF_CHUNK_NUM	20
+#define SESSION_BUF_CHUNK_MASK	((1u << SESSION_BUF_CHUNK_NUM) - 1)
+
+struct session_buf_chunk {
+	/* appended only, grown chunks are kept for reuse */
+	struct session_buf_chunk *next;
+	struct dsp_session_buf *pool;
+	uint32_t bit_mask;
+#ifdef CONFIG_DSP_SESSION_BUF_STAT
+	struct dsp_session_buf_stat stat[SESSION_BUF_CHUNK_NUM];
+#endif
+};
+
+static struct dsp_session_buf buff_pool[SESSION_BUF_CHUNK_NUM] __in_section_unique(DSP_SHARE_RAM);
+static struct session_buf_chunk buff_chunk = {
+	.pool = buff_pool,
+};
+static K_MUTEX_DEFINE(buff_mutex);
+
+#ifdef CONFIG_DSP_SESSION_BUF_DMA
+/* spans shorter than this are copied by cpu */
+#define SESSION_BUF_DMA_MIN_SIZE	(256)
+
+static const struct device *xfer_dma_dev;
+static int xfer_dma_chan;
+static struct dma_config xfer_dma_cfg;
+static struct dma_block_config xfer_dma_block;
+static K_SEM_DEFINE(xfer_dma_sem, 0, 1);
+static K_MUTEX_DEFINE(xfer_dma_mutex);
+#endif
 
-static struct dsp_session_buf * malloc_session_buf(int size)
+/* contiguous piece of a vectored transfer */
+struct session_buf_seg {
+	void *dst;
+	const void *src;
+	unsigned int size;
+};
+
+/* grown chunks are allocated like the ring data, which the dsp reads too */
+static struct session_buf_chunk *session_buf_chunk_grow(struct session_buf_chunk *last)
+{
+	struct session_buf_chunk *chunk;
+
+	chunk = mem_malloc(sizeof(*chunk) + sizeof(struct dsp_session_buf) * SESSION_BUF_CHUNK_NUM);
+	if (chunk == NULL)
+		return NULL;
+
+	memset(chunk, 0, sizeof(*chunk));
+	chunk->pool = (struct dsp_session_buf *)(chunk + 1);
+	last->next = chunk;
+	return chunk;
+}
+
+/* index of buf in its chunk, or -1 if not a session buffer */
+static int session_buf_lookup(struct dsp_session_buf *buf, struct session_buf_chunk **out)
 {
-	for (int i = 0 ; i < MAX_SESSION_BUFF_NUM; i++) {
-		if (!(bit_mask & (1 << i))) {
-			bit_mask |= (1 << i);
-			memset(&buff_pool[i], 0, sizeof(struct dsp_session_buf));
-			return &buff_pool[i];
+	struct session_buf_chunk *chunk;
+
+	for (chunk = &buff_chunk; chunk; chunk = chunk->next) {
+		if (buf >= chunk->pool && buf < chunk->pool + SESSION_BUF_CHUNK_NUM) {
+			*out = chunk;
+			return buf - chunk->pool;
 		}
 	}
-	printk("session malloc failed\n");
-	return NULL;
+
+	return -1;
+}
+
+static struct dsp_session_buf * malloc_session_buf(int size)
+{
+	struct session_buf_chunk *chunk, *last = NULL;
+	struct dsp_session_buf *buf = NULL;
+	int i;
+
+	k_mutex_lock(&buff_mutex, K_FOREVER);
+
+	for (chunk = &buff_chunk; chunk; chunk = chunk->next) {
+		if (chunk->bit_mask != SESSION_BUF_CHUNK_MASK)
+			break;
+		last = chunk;
+	}
+
+	if (chunk == NULL)
+		chunk = session_buf_chunk_grow(last);
+
+	if (chunk) {
+		for (i = 0; chunk->bit_mask & (1u << i); i++)
+			;
+
+		chunk->bit_mask |= (1u << i);
+		buf = &chunk->pool[i];
+		memset(buf, 0, sizeof(struct dsp_session_buf));
+#ifdef CONFIG_DSP_SESSION_BUF_STAT
+		memset(&chunk->stat[i], 0, sizeof(struct dsp_session_buf_stat));
+#endif
+	}
+
+	k_mutex_unlock(&buff_mutex);
+
+	if (buf == NULL)
+		printk("session malloc failed\n");
+
+	return buf;
 }
 
 static void free_session_buf(struct dsp_session_buf * session_buf)
 {
-	for (int i = 0 ; i < MAX_SESSION_BUFF_NUM; i++) {
-		if (&buff_pool[i] == session_buf) {
-			bit_mask &= (~(1 << i));
-			return;
-		}
+	struct session_buf_chunk *chunk;
+	int i;
+
+	k_mutex_lock(&buff_mutex, K_FOREVER);
+
+	i = session_buf_lookup(session_buf, &chunk);
+	if (i >= 0)
+		chunk->bit_mask &= ~(1u << i);
+
+	k_mutex_unlock(&buff_mutex);
+}
+
+static inline uint32_t session_buf_stat_start(void)
+{
+#ifdef CONFIG_DSP_SESSION_BUF_STAT
+	return k_cycle_get_32();
+#else
+	return 0;
+#endif
+}
+
+static inline void session_buf_stat_end(struct dsp_session_buf *buf, bool is_read,
+		int len, unsigned int dma_len, uint32_t start)
+{
+#ifdef CONFIG_DSP_SESSION_BUF_STAT
+	struct session_buf_chunk *chunk;
+	struct dsp_session_buf_stat *stat;
+	unsigned int key;
+	int i = session_buf_lookup(buf, &chunk);
+
+	if (i < 0 || len <= 0)
+		return;
+
+	stat = &chunk->stat[i];
+
+	key = irq_lock();
+	if (is_read) {
+		stat->read_bytes += len;
+		stat->read_cnt++;
+	} else {
+		stat->write_bytes += len;
+		stat->write_cnt++;
 	}
+	stat->dma_bytes += dma_len;
+	stat->busy_us += k_cyc_to_us_floor32(k_cycle_get_32() - start);
+	irq_unlock(key);
+#endif
+}
+
+/* ring data or space starting at offset as up to two spans */
+static int session_buf_ring_spans(struct acts_ringbuf *ring, uint32_t offset,
+		unsigned int size, struct dsp_session_buf_vec span[2])
+{
+	unsigned int len = ACTS_RINGBUF_SIZE8(ring->size - offset);
+
+	span[0].data = (void *)(ring->cpu_ptr + ACTS_RINGBUF_SIZE8(offset));
+	span[0].size = MIN(size, len);
+	span[1].data = (void *)(ring->cpu_ptr);
+	span[1].size = size - span[0].size;
+
+	return span[1].size ? 2 : 1;
 }
 
 struct dsp_session_buf *dsp_session_buf_init(struct dsp_session *session,
@@ -62,7 +211,7 @@ struct dsp_session_buf *dsp_session_buf_alloc(struct dsp_session *session, unsig
 
 	void *data = mem_malloc(size);
 	if (data == NULL) {
-		mem_free(buf);
+		free_session_buf(buf);
 		return NULL;
 	}
 
@@ -103,8 +252,11 @@ unsigned int dsp_session_buf_length(struct dsp_session_buf *buf)
 
 int dsp_session_buf_read(struct dsp_session_buf *buf, void *data, unsigned int size)
 {
+	uint32_t start = session_buf_stat_start();
 	int len = ACTS_RINGBUF_SIZE8(acts_ringbuf_get(&buf->buf, data, ACTS_RINGBUF_NELEM(size)));
 
+	session_buf_stat_end(buf, true, len, 0, start);
+
 #if CONFIG_DSP_ACTIVE_POWER_LATENCY_MS >= 0
 	/* Supposed next read the same size */
 	//if (!k_is_in_isr() && dsp_session_buf_length(buf) < size) {
@@ -118,12 +270,15 @@ int dsp_session_buf_read(struct dsp_session_buf *buf, void *data, unsigned int s
 
 int dsp_session_buf_write(struct dsp_session_buf *buf, const void *data, unsigned int size)
 {
+	uint32_t start = session_buf_stat_start();
 #if CONFIG_DSP_ACTIVE_POWER_LATENCY_MS >= 0
 	bool empty = acts_ringbuf_is_empty(&buf->buf);
 #endif
 
 	int len = ACTS_RINGBUF_SIZE8(acts_ringbuf_put(&buf->buf, data, ACTS_RINGBUF_NELEM(size)));
 
+	session_buf_stat_end(buf, false, len, 0, start);
+
 #if CONFIG_DSP_ACTIVE_POWER_LATENCY_MS >= 0
 	/* Supposed next write the same size */
 	if (!k_is_in_isr() && (empty || dsp_session_buf_space(buf) < size)) {
@@ -137,20 +292,35 @@ int dsp_session_buf_write(struct dsp_session_buf *buf, const void *data, unsigne
 
 int dsp_session_buf_read_to_buffer(struct dsp_session_buf *buf, void *buffer, unsigned int size)
 {
-	int len = ACTS_RINGBUF_SIZE8(
-			acts_ringbuf_read(&buf->buf, buffer, ACTS_RINGBUF_NELEM(size),
-					NULL));
+	struct dsp_session_buf_vec vec = { .data = buffer, .size = size, };
 
-    return len;
+	return dsp_session_buf_read_vec(buf, &vec, 1, 0);
 }
 
 int dsp_session_buf_read_to_stream(struct dsp_session_buf *buf,
 		void *stream, unsigned int size,
 		dsp_session_buf_write_fn stream_write)
 {
-	int len = ACTS_RINGBUF_SIZE8(
-			acts_ringbuf_read(&buf->buf, stream, ACTS_RINGBUF_NELEM(size),
-					(acts_ringbuf_write_fn)stream_write));
+	uint32_t start = session_buf_stat_start();
+	struct dsp_session_buf_vec span[2];
+	int i, span_cnt, ret, len = 0;
+
+	if (size == 0 || ACTS_RINGBUF_NELEM(size) > acts_ringbuf_length(&buf->buf))
+		return 0;
+
+	/* ring spans are written to the stream in place, stop at a short write */
+	span_cnt = session_buf_ring_spans(&buf->buf, buf->buf.head_offset, size, span);
+	for (i = 0; i < span_cnt; i++) {
+		ret = stream_write(stream, span[i].data, span[i].size);
+		if (ret > 0)
+			len += ret;
+		if (ret != (int)span[i].size)
+			break;
+	}
+
+	acts_ringbuf_drop(&buf->buf, ACTS_RINGBUF_NELEM(len));
+
+	session_buf_stat_end(buf, true, len, 0, start);
 
 	//printk("%s, read len 0x%x from dsp outbuf to outstream!\n\n", __func__, len);
 
@@ -167,26 +337,39 @@ int dsp_session_buf_read_to_stream(struct dsp_session_buf *buf,
 
 int dsp_session_buf_write_from_buffer(struct dsp_session_buf *buf, void *buffer, unsigned int size)
 {
-    int len = ACTS_RINGBUF_SIZE8(
-            acts_ringbuf_write(&buf->buf, buffer, ACTS_RINGBUF_NELEM(size),
-                    NULL));
-
-	//printk("%s: %d: write to dsp session in_buf: %p,  len: 0x%x\n\n", __func__, __LINE__, buffer, len);
+	struct dsp_session_buf_vec vec = { .data = buffer, .size = size, };
 
-    return len;
+	return dsp_session_buf_write_vec(buf, &vec, 1, 0);
 }
 
 int dsp_session_buf_write_from_stream(struct dsp_session_buf *buf,
 		void *stream, unsigned int size,
 		dsp_session_buf_read_fn stream_read)
 {
+	uint32_t start = session_buf_stat_start();
+	struct dsp_session_buf_vec span[2];
+	int i, span_cnt, ret, len = 0;
+
+	if (size == 0 || ACTS_RINGBUF_NELEM(size) > acts_ringbuf_space(&buf->buf))
+		return 0;
+
 #if CONFIG_DSP_ACTIVE_POWER_LATENCY_MS >= 0
 	bool empty = acts_ringbuf_is_empty(&buf->buf);
 #endif
 
-	int len = ACTS_RINGBUF_SIZE8(
-			acts_ringbuf_write(&buf->buf, stream, ACTS_RINGBUF_NELEM(size),
-					(acts_ringbuf_read_fn)stream_read));
+	/* stream is read into the ring spans in place, stop at a short read */
+	span_cnt = session_buf_ring_spans(&buf->buf, buf->buf.tail_offset, size, span);
+	for (i = 0; i < span_cnt; i++) {
+		ret = stream_read(stream, span[i].data, span[i].size);
+		if (ret > 0)
+			len += ret;
+		if (ret != (int)span[i].size)
+			break;
+	}
+
+	acts_ringbuf_fill_none(&buf->buf, ACTS_RINGBUF_NELEM(len));
+
+	session_buf_stat_end(buf, false, len, 0, start);
 
 	//printk("%s, dsp session inbuf write 0x%x finish!\n\n", __func__, len);
 
@@ -207,3 +390,246 @@ size_t dsp_session_buf_drop_all(struct dsp_session_buf *buf)
 	return acts_ringbuf_drop_all(&buf->buf);
 }
 
+#ifdef CONFIG_DSP_SESSION_BUF_DMA
+static void session_buf_dma_callback(const struct device *dev, void *user_data,
+		uint32_t channel, int status)
+{
+	k_sem_give(&xfer_dma_sem);
+}
+
+static int session_buf_dma_init(void)
+{
+	if (xfer_dma_dev)
+		return 0;
+
+	xfer_dma_dev = device_get_binding(CONFIG_DMA_0_NAME);
+	if (xfer_dma_dev == NULL) {
+		SYS_LOG_ERR(CONFIG_DMA_0_NAME " not found");
+		return -ENODEV;
+	}
+
+	xfer_dma_chan = dma_request(xfer_dma_dev, 0xFF);
+	if (xfer_dma_chan < 0) {
+		SYS_LOG_ERR("dma_request failed");
+		xfer_dma_dev = NULL;
+		return -ENODEV;
+	}
+
+	xfer_dma_cfg.channel_direction = MEMORY_TO_MEMORY;
+	xfer_dma_cfg.complete_callback_en = 1;
+	xfer_dma_cfg.dma_callback = session_buf_dma_callback;
+	xfer_dma_cfg.source_data_size = 4;
+	xfer_dma_cfg.dest_data_size = 4;
+	xfer_dma_cfg.block_count = 1;
+	xfer_dma_cfg.head_block = &xfer_dma_block;
+	return 0;
+}
+
+static bool session_buf_dma_allowed(const struct session_buf_seg *seg)
+{
+	return seg->size >= SESSION_BUF_DMA_MIN_SIZE &&
+		!(((uintptr_t)seg->dst | (uintptr_t)seg->src | seg->size) & 0x3);
+}
+
+static int session_buf_dma_copy(const struct session_buf_seg *seg)
+{
+	xfer_dma_block.source_address = (uint32_t)seg->src;
+	xfer_dma_block.dest_address = (uint32_t)seg->dst;
+	xfer_dma_block.block_size = seg->size;
+
+	/* drop a completion given late by a previously timed out transfer */
+	k_sem_reset(&xfer_dma_sem);
+
+	if (dma_config(xfer_dma_dev, xfer_dma_chan, &xfer_dma_cfg) ||
+		dma_start(xfer_dma_dev, xfer_dma_chan)) {
+		SYS_LOG_ERR("dma%d start error", xfer_dma_chan);
+		return -EIO;
+	}
+
+	if (k_sem_take(&xfer_dma_sem, K_MSEC(100))) {
+		SYS_LOG_ERR("dma%d timeout", xfer_dma_chan);
+		dma_stop(xfer_dma_dev, xfer_dma_chan);
+		return -ETIMEDOUT;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_DSP_SESSION_BUF_DMA */
+
+/* pair destination and source spans into contiguous segments, at most 3 */
+static int session_buf_segments(const struct dsp_session_buf_vec *dst, int dst_cnt,
+		const struct dsp_session_buf_vec *src, int src_cnt, struct session_buf_seg seg[3])
+{
+	unsigned int dst_ofs = 0, src_ofs = 0, len;
+	int i = 0, j = 0, n = 0;
+
+	while (i < dst_cnt && j < src_cnt && n < 3) {
+		len = MIN(dst[i].size - dst_ofs, src[j].size - src_ofs);
+		if (len > 0) {
+			seg[n].dst = (uint8_t *)dst[i].data + dst_ofs;
+			seg[n].src = (const uint8_t *)src[j].data + src_ofs;
+			seg[n].size = len;
+			n++;
+		}
+
+		dst_ofs += len;
+		src_ofs += len;
+
+		if (dst_ofs >= dst[i].size) {
+			dst_ofs = 0;
+			i++;
+		}
+
+		if (src_ofs >= src[j].size) {
+			src_ofs = 0;
+			j++;
+		}
+	}
+
+	return n;
+}
+
+static unsigned int session_buf_copy(const struct dsp_session_buf_vec *dst, int dst_cnt,
+		const struct dsp_session_buf_vec *src, int src_cnt, unsigned int flags,
+		unsigned int *dma_len)
+{
+	struct session_buf_seg seg[3];
+	unsigned int len = 0;
+	int i, n;
+
+	n = session_buf_segments(dst, dst_cnt, src, src_cnt, seg);
+	*dma_len = 0;
+
+#ifdef CONFIG_DSP_SESSION_BUF_DMA
+	bool use_dma = (flags & DSP_SESSION_BUF_XFER_DMA) && !k_is_in_isr() &&
+			!session_buf_dma_init();
+
+	if (use_dma) {
+		k_mutex_lock(&xfer_dma_mutex, K_FOREVER);
+
+		/* maintain all spans first, then a single barrier */
+		for (i = 0; i < n; i++) {
+			if (!session_buf_dma_allowed(&seg[i]))
+				continue;
+
+			if (mem_is_cacheable(seg[i].src))
+				mem_dcache_clean(seg[i].src, seg[i].size);
+			if (mem_is_cacheable(seg[i].dst))
+				mem_dcache_flush(seg[i].dst, seg[i].size);
+		}
+
+		mem_dcache_sync();
+	}
+#endif
+
+	for (i = 0; i < n; i++) {
+#ifdef CONFIG_DSP_SESSION_BUF_DMA
+		if (use_dma && session_buf_dma_allowed(&seg[i]) &&
+			!session_buf_dma_copy(&seg[i])) {
+			*dma_len += seg[i].size;
+			len += seg[i].size;
+			continue;
+		}
+#endif
+		memcpy(seg[i].dst, seg[i].src, seg[i].size);
+		len += seg[i].size;
+	}
+
+#ifdef CONFIG_DSP_SESSION_BUF_DMA
+	if (use_dma)
+		k_mutex_unlock(&xfer_dma_mutex);
+#endif
+
+	return len;
+}
+
+static unsigned int session_buf_vec_size(const struct dsp_session_buf_vec *vec, int vec_cnt)
+{
+	unsigned int size = 0;
+
+	for (int i = 0; i < vec_cnt; i++)
+		size += vec[i].size;
+
+	return size;
+}
+
+int dsp_session_buf_read_vec(struct dsp_session_buf *buf,
+		const struct dsp_session_buf_vec *vec, int vec_cnt, unsigned int flags)
+{
+	uint32_t start = session_buf_stat_start();
+	struct dsp_session_buf_vec span[2];
+	unsigned int size, dma_len;
+	int span_cnt, len;
+
+	if (vec_cnt < 1 || vec_cnt > 2)
+		return -EINVAL;
+
+	size = session_buf_vec_size(vec, vec_cnt);
+	if (size == 0 || ACTS_RINGBUF_NELEM(size) > acts_ringbuf_length(&buf->buf))
+		return 0;
+
+	span_cnt = session_buf_ring_spans(&buf->buf, buf->buf.head_offset, size, span);
+	len = session_buf_copy(vec, vec_cnt, span, span_cnt, flags, &dma_len);
+	acts_ringbuf_drop(&buf->buf, ACTS_RINGBUF_NELEM(len));
+
+	session_buf_stat_end(buf, true, len, dma_len, start);
+	return len;
+}
+
+int dsp_session_buf_write_vec(struct dsp_session_buf *buf,
+		const struct dsp_session_buf_vec *vec, int vec_cnt, unsigned int flags)
+{
+	uint32_t start = session_buf_stat_start();
+	struct dsp_session_buf_vec span[2];
+	unsigned int size, dma_len;
+	int span_cnt, len;
+
+	if (vec_cnt < 1 || vec_cnt > 2)
+		return -EINVAL;
+
+	size = session_buf_vec_size(vec, vec_cnt);
+	if (size == 0 || ACTS_RINGBUF_NELEM(size) > acts_ringbuf_space(&buf->buf))
+		return 0;
+
+#if CONFIG_DSP_ACTIVE_POWER_LATENCY_MS >= 0
+	bool empty = acts_ringbuf_is_empty(&buf->buf);
+#endif
+
+	span_cnt = session_buf_ring_spans(&buf->buf, buf->buf.tail_offset, size, span);
+	len = session_buf_copy(span, span_cnt, vec, vec_cnt, flags, &dma_len);
+	acts_ringbuf_fill_none(&buf->buf, ACTS_RINGBUF_NELEM(len));
+
+	session_buf_stat_end(buf, false, len, dma_len, start);
+
+#if CONFIG_DSP_ACTIVE_POWER_LATENCY_MS >= 0
+	/* Supposed next write the same size */
+	if (!k_is_in_isr() && (empty || dsp_session_buf_space(buf) < size)) {
+		if (!dsp_session_kick(buf->session))
+			SYS_LOG_DBG("kick %u (%u ms)", dsp_session_buf_space(buf), k_uptime_get_32());
+	}
+#endif
+
+	return len;
+}
+
+#ifdef CONFIG_DSP_SESSION_BUF_STAT
+int dsp_session_buf_get_stat(struct dsp_session_buf *buf,
+		struct dsp_session_buf_stat *stat, bool clear)
+{
+	struct session_buf_chunk *chunk;
+	unsigned int key;
+	int i = session_buf_lookup(buf, &chunk);
+
+	if (i < 0 || stat == NULL)
+		return -EINVAL;
+
+	key = irq_lock();
+	*stat = chunk->stat[i];
+	if (clear)
+		memset(&chunk->stat[i], 0, sizeof(chunk->stat[i]));
+	irq_unlock(key);
+
+	return 0;
+}
+#endif /* CONFIG_DSP_SESSION_BUF_STAT */
+
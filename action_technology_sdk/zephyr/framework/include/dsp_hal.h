@@ -35,6 +35,25 @@ struct dsp_session_info {
 struct dsp_session;
 struct dsp_session_buf;
 
+/* contiguous span of a vectored session buffer transfer */
+struct dsp_session_buf_vec {
+	void *data;
+	unsigned int size;
+};
+
+/* vectored transfer flags */
+#define DSP_SESSION_BUF_XFER_DMA	BIT(0)	/* large aligned spans through dma */
+
+/* session buffer transfer statistics */
+struct dsp_session_buf_stat {
+	uint32_t read_bytes;
+	uint32_t write_bytes;
+	uint32_t dma_bytes;	/* part of read/write bytes moved by dma */
+	uint32_t read_cnt;
+	uint32_t write_cnt;
+	uint32_t busy_us;	/* time spent in transfers */
+};
+
 /* dsp session ops */
 /**
  * @brief open the global session
@@ -757,6 +776,60 @@ int dsp_session_buf_read_to_buffer(struct dsp_session_buf *buf, void *buffer, un
 
 int dsp_session_buf_write_from_buffer(struct dsp_session_buf *buf, void *buffer, unsigned int size);
 
+/**
+ * @brief Read a dsp session buffer into up to two spans.
+ *
+ * The ring data, itself up to two spans when it wraps, is moved into the
+ * destination spans in one call. Nothing is read if the data is less than
+ * the total size of the spans.
+ *
+ * @param buf Address of session buffer.
+ * @param vec Destination spans.
+ * @param vec_cnt Number of destination spans, 1 or 2.
+ * @param flags Transfer flags, DSP_SESSION_BUF_XFER_DMA.
+ *
+ * @return number of bytes successfully read.
+ */
+int dsp_session_buf_read_vec(struct dsp_session_buf *buf,
+		const struct dsp_session_buf_vec *vec, int vec_cnt, unsigned int flags);
+
+/**
+ * @brief Write a dsp session buffer from up to two spans.
+ *
+ * The source spans are moved into the ring space, itself up to two spans
+ * when it wraps, in one call. Nothing is written if the space is less than
+ * the total size of the spans.
+ *
+ * @param buf Address of session buffer.
+ * @param vec Source spans.
+ * @param vec_cnt Number of source spans, 1 or 2.
+ * @param flags Transfer flags, DSP_SESSION_BUF_XFER_DMA.
+ *
+ * @return number of bytes successfully written.
+ */
+int dsp_session_buf_write_vec(struct dsp_session_buf *buf,
+		const struct dsp_session_buf_vec *vec, int vec_cnt, unsigned int flags);
+
+#ifdef CONFIG_DSP_SESSION_BUF_STAT
+/**
+ * @brief Get transfer statistics of a dsp session buffer.
+ *
+ * @param buf Address of session buffer.
+ * @param stat Address of statistics.
+ * @param clear Clear statistics after read.
+ *
+ * @return 0 if successful, otherwise negative errno.
+ */
+int dsp_session_buf_get_stat(struct dsp_session_buf *buf,
+		struct dsp_session_buf_stat *stat, bool clear);
+#else
+static inline int dsp_session_buf_get_stat(struct dsp_session_buf *buf,
+		struct dsp_session_buf_stat *stat, bool clear)
+{
+	return -ENOTSUP;
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
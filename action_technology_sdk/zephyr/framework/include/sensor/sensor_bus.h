@@ -23,10 +23,34 @@ typedef enum {
 	NUM_BUS,
 } bus_type_e;
 
+/* sensor_bus_msg_t flags */
+#define SENSOR_BUS_MSG_READ		(1 << 0)	// read (write if not set)
+#define SENSOR_BUS_MSG_BURST	(1 << 1)	// may merge with previous contiguous read
+
+#define SENSOR_BUS_BURST_MAX	(32)		// max bytes of a merged read
+
 /******************************************************************************/
 //typedefs
 /******************************************************************************/
 typedef void (*sensor_bus_cb_t) (uint8_t *buf, int len, void *ctx);
+typedef void (*sensor_bus_list_cb_t) (int ret, void *ctx);
+
+typedef struct sensor_bus_msg_s {
+	uint16_t reg;    // register address
+	uint16_t len;    // data length
+	uint8_t *buf;    // data buffer
+	uint8_t flags;   // SENSOR_BUS_MSG_xxx
+} sensor_bus_msg_t;
+
+typedef struct sensor_bus_stat_s {
+	uint32_t xfer_cnt;   // bus transfers
+	uint32_t list_cnt;   // transaction lists
+	uint32_t merge_cnt;  // messages merged into a previous transfer
+	uint32_t err_cnt;    // failed transfers
+	uint32_t bytes;      // data bytes transferred
+	uint64_t busy_us;    // time spent in transfers
+	uint64_t total_us;   // time since statistics cleared, ms resolution
+} sensor_bus_stat_t;
 
 /******************************************************************************/
 //functions
@@ -34,8 +58,34 @@ typedef void (*sensor_bus_cb_t) (uint8_t *buf, int len, void *ctx);
 int sensor_bus_read(const sensor_dev_t *dev, uint16_t reg, uint8_t *buf, uint16_t len);
 int sensor_bus_write(const sensor_dev_t *dev, uint16_t reg, uint8_t *buf, uint16_t len);
 
+/*
+ * Start a list of register transactions on the bus task of the sensor, the
+ * transfers are chained from the task completion irq and cb is called from
+ * it with 0 or the first error. Reads flagged SENSOR_BUS_MSG_BURST whose
+ * register follows the previous read are merged into one burst transfer, so
+ * status + data + fifo count reads of a sensor with register auto-increment
+ * take a single bus transaction. msgs must stay valid until cb, one list
+ * runs per bus at a time and single transfers of the bus return -EBUSY
+ * meanwhile. cb is not called if the list fails to start.
+ */
+int sensor_bus_list_start(const sensor_dev_t *dev, sensor_bus_msg_t *msgs, int num,
+		sensor_bus_list_cb_t cb, void *ctx);
+
+/*
+ * Run a list of register transactions and wait for it.
+ */
+int sensor_bus_xfer_list(const sensor_dev_t *dev, sensor_bus_msg_t *msgs, int num);
+
 int sensor_bus_task_start(const sensor_dev_t *dev, sensor_bus_cb_t cb, void *ctx);
 int sensor_bus_task_stop(const sensor_dev_t *dev);
 
+#ifdef CONFIG_SENSOR_BUS_STAT
+/*
+ * Get bus statistics, utilization is busy_us / total_us.
+ */
+int sensor_bus_get_stat(int bus_type, int bus_id, sensor_bus_stat_t *stat);
+void sensor_bus_clear_stat(int bus_type, int bus_id);
+#endif
+
 #endif  /* _SENSOR_DEV_H */
 
@@ -50,6 +50,8 @@ typedef struct sensor_evt_s {
 
 typedef void (*sensor_cb_t) (int id, sensor_dat_t *dat, void *ctx);
 
+struct sensor_bus_msg_s;
+
 /******************************************************************************/
 //functions
 /******************************************************************************/
@@ -70,6 +72,7 @@ int sensor_hal_disable(int id);
 
 int sensor_hal_read(int id, uint16_t reg, uint8_t *buf, uint16_t len);
 int sensor_hal_write(int id, uint16_t reg, uint8_t *buf, uint16_t len);
+int sensor_hal_xfer_list(int id, struct sensor_bus_msg_s *msgs, int num);
 
 void sensor_hal_init_data(int id, sensor_dat_t *dat, uint8_t *buf, int len);
 int sensor_hal_poll_data(int id, sensor_dat_t *dat, uint8_t *buf);
@@ -304,6 +304,146 @@ bool ui_region_is_valid(const ui_region_t * region);
  */
 bool ui_region_is_empty(const ui_region_t *region);
 
+/**
+ * Maximum number of rectangles a region list can hold
+ */
+#ifdef CONFIG_UI_REGION_LIST_MAX_RECTS
+#  define UI_REGION_LIST_MAX_RECTS CONFIG_UI_REGION_LIST_MAX_RECTS
+#else
+#  define UI_REGION_LIST_MAX_RECTS 8
+#endif
+
+/**
+ * @struct ui_region_list
+ * @brief Structure holding a set of non-overlapping regions
+ *
+ * The list is fixed-capacity and never allocates. When an operation would
+ * exceed the capacity, the rectangles are coalesced, so the list may cover
+ * more pixels than requested but never fewer.
+ */
+typedef struct ui_region_list {
+	uint8_t count;
+	ui_region_t rects[UI_REGION_LIST_MAX_RECTS];
+} ui_region_list_t;
+
+/**
+ * @struct ui_region_cost
+ * @brief Structure holding the cost model of region list coalescing
+ *
+ * The cost of a region list is "pixel_cost * pixels + rect_cost * rects",
+ * where rect_cost models the per-rectangle overhead (DMA descriptor setup,
+ * panel window command, etc.).
+ */
+typedef struct ui_region_cost {
+	uint32_t pixel_cost;
+	uint32_t rect_cost;
+} ui_region_cost_t;
+
+/**
+ * @brief Initialize a region list as empty
+ *
+ * @param list pointer to a region list
+ *
+ * @retval N/A
+ */
+static inline void ui_region_list_init(ui_region_list_t * list)
+{
+	list->count = 0;
+}
+
+/**
+ * @brief Check if a region list is empty
+ *
+ * @param list pointer to a region list
+ *
+ * @return true if the list contains no region
+ */
+static inline bool ui_region_list_is_empty(const ui_region_list_t * list)
+{
+	return list->count == 0;
+}
+
+/**
+ * @brief Get the number of pixels covered by a region list
+ *
+ * @param list pointer to a region list
+ *
+ * @retval number of pixels
+ */
+int32_t ui_region_list_get_size(const ui_region_list_t * list);
+
+/**
+ * @brief Get the bounding box of a region list
+ *
+ * @param result pointer to an region, the result will be stored here
+ * @param list pointer to a region list
+ *
+ * @return false: the list is empty, result is invalid
+ */
+bool ui_region_list_get_bounds(ui_region_t * result, const ui_region_list_t * list);
+
+/**
+ * @brief Check if a region list has common parts with a region
+ *
+ * @param list pointer to a region list
+ * @param region pointer to a region
+ *
+ * @return false: the list and the region have no common parts
+ */
+bool ui_region_list_is_on(const ui_region_list_t * list, const ui_region_t * region);
+
+/**
+ * @brief Union a region into a region list
+ *
+ * @param list pointer to a region list
+ * @param region pointer to the region to add
+ *
+ * @retval N/A
+ */
+void ui_region_list_add(ui_region_list_t * list, const ui_region_t * region);
+
+/**
+ * @brief Union a region list into another
+ *
+ * @param list pointer to the destination region list
+ * @param other pointer to the region list to add
+ *
+ * @retval N/A
+ */
+void ui_region_list_union(ui_region_list_t * list, const ui_region_list_t * other);
+
+/**
+ * @brief Subtract a region from a region list
+ *
+ * If a rectangle cannot be split for lack of room, it is kept whole.
+ *
+ * @param list pointer to a region list
+ * @param exclude pointer to the region to be subtracted
+ *
+ * @retval N/A
+ */
+void ui_region_list_subtract(ui_region_list_t * list, const ui_region_t * exclude);
+
+/**
+ * @brief Clip a region list by a region
+ *
+ * @param list pointer to a region list
+ * @param clip pointer to the clip region
+ *
+ * @return false: the result list is empty
+ */
+bool ui_region_list_intersect(ui_region_list_t * list, const ui_region_t * clip);
+
+/**
+ * @brief Coalesce the regions of a list while it lowers the total cost
+ *
+ * @param list pointer to a region list
+ * @param cost pointer to the cost model
+ *
+ * @retval N/A
+ */
+void ui_region_list_coalesce(ui_region_list_t * list, const ui_region_cost_t * cost);
+
 #ifdef __cplusplus
 }
 #endif
@@ -78,24 +78,30 @@ static inv_invpres_t invpres;
 
 static int read_otp_from_i2c(short *out)
 {
-	uint8_t buf[4];
+	uint8_t mode[3] = { 0x00, 0x66, 0x9C };
+	uint8_t buf[4][3];
+	sensor_bus_msg_t msgs[5];
 	int status;
 	int i;
 	
-	// OTP Read mode
-	buf[0] = 0x00;
-	buf[1] = 0x66;
-	buf[2] = 0x9C;
-	status = sensor_hal_write(ID_BARO, 0xC595, buf, 3);
+	// OTP Read mode, then read OTP values in one list
+	msgs[0].reg = 0xC595;
+	msgs[0].len = 3;
+	msgs[0].buf = mode;
+	msgs[0].flags = 0;
+	for (i = 0; i < 4; i++) {
+		msgs[i + 1].reg = 0xC7F7;
+		msgs[i + 1].len = 3;
+		msgs[i + 1].buf = buf[i];
+		msgs[i + 1].flags = SENSOR_BUS_MSG_READ;
+	}
+	
+	status = sensor_hal_xfer_list(ID_BARO, msgs, 5);
 	if (status)
 		return status;
 	
-	// Read OTP values
 	for (i = 0; i < 4; i++) {
-		status = sensor_hal_read(ID_BARO, 0xC7F7, buf, 3);
-		if (status)
-			return status;
-		out[i] = (buf[0] << 8) | buf[1];
+		out[i] = (buf[i][0] << 8) | buf[i][1];
 	}
 	
 	return 0;
@@ -22,6 +22,35 @@
 /******************************************************************************/
 //constants
 /******************************************************************************/
+#define SENSOR_BUS_WR_MAX		(16)	// max bytes of a write with address
+
+/******************************************************************************/
+//typedefs
+/******************************************************************************/
+#ifdef CONFIG_SENSOR_TASK_CFG
+// transaction list running on the bus task
+typedef struct sensor_bus_list_s {
+	const sensor_dev_t *dev;
+	sensor_bus_msg_t *msgs;
+	int num;
+	int cur;         // first message of the transfer in flight
+	int end;         // message after the transfer in flight
+	int merged;      // messages merged into a previous transfer
+	uint16_t len;    // bytes of the transfer in flight
+	uint8_t addr;    // 2 bytes i2c address in flight, data next
+	volatile uint8_t busy;
+	uint32_t start;  // cycles at transfer start
+	sensor_bus_list_cb_t cb;
+	void *ctx;
+	union {
+		i2c_task_t i2c;
+		spi_task_t spi;
+	} task;
+	i2c_task_t addr_task;
+	uint8_t wr_buf[SENSOR_BUS_WR_MAX];
+	uint8_t burst_buf[SENSOR_BUS_BURST_MAX];
+} sensor_bus_list_t;
+#endif
 
 /******************************************************************************/
 //variables
@@ -29,14 +58,63 @@
 #ifdef CONFIG_SENSOR_TASK_CFG
 static struct k_sem sensor_sem[NUM_BUS][2];
 static __act_s2_sleep_data volatile int8_t sensor_stat[NUM_BUS][2] = { 0 };
+static sensor_bus_list_t bus_list[NUM_BUS][2];
 #endif
 
 static __act_s2_sleep_data struct device *spimt_dev[2] = { NULL };
 static __act_s2_sleep_data struct device *i2cmt_dev[2] = { NULL };
 
+#ifdef CONFIG_SENSOR_BUS_STAT
+static __act_s2_sleep_data sensor_bus_stat_t bus_stat[NUM_BUS][2];
+static __act_s2_sleep_data int64_t bus_stat_start[NUM_BUS][2];	// uptime in ms
+#endif
+
 /******************************************************************************/
 //functions
 /******************************************************************************/
+#ifdef CONFIG_SENSOR_BUS_STAT
+// statistics are also updated from the task irq
+static void sensor_bus_stat_xfer(const sensor_dev_t *dev, uint16_t len, int ret, uint32_t cycles)
+{
+	sensor_bus_stat_t *stat;
+	unsigned int key;
+
+	if ((dev->io.bus_type >= NUM_BUS) || (dev->io.bus_id >= 2)) {
+		return;
+	}
+
+	key = irq_lock();
+	stat = &bus_stat[dev->io.bus_type][dev->io.bus_id];
+	stat->busy_us += k_cyc_to_us_floor32(cycles);
+	stat->xfer_cnt ++;
+	if (ret) {
+		stat->err_cnt ++;
+	} else {
+		stat->bytes += len;
+	}
+	irq_unlock(key);
+}
+
+static void sensor_bus_stat_list(const sensor_dev_t *dev, int merged)
+{
+	sensor_bus_stat_t *stat;
+	unsigned int key;
+
+	if ((dev->io.bus_type >= NUM_BUS) || (dev->io.bus_id >= 2)) {
+		return;
+	}
+
+	key = irq_lock();
+	stat = &bus_stat[dev->io.bus_type][dev->io.bus_id];
+	stat->list_cnt ++;
+	stat->merge_cnt += merged;
+	irq_unlock(key);
+}
+#else
+#define sensor_bus_stat_xfer(dev, len, ret, cycles)
+#define sensor_bus_stat_list(dev, merged)
+#endif
+
 #ifdef CONFIG_SENSOR_TASK_CFG
 
 static void sensor_bus_callback(unsigned char *buf, int len, void *ctx)
@@ -99,76 +177,97 @@ static int sensor_bus_i2c_xfer_task(const sensor_dev_t *dev, uint32_t task_id, i
 	return sensor_stat[dev->io.bus_type][dev->io.bus_id];
 }
 
-static int sensor_bus_i2c_xfer(const sensor_dev_t *dev, uint16_t reg, uint8_t *buf, uint16_t len, uint8_t rd)
+/*
+ * Config the soft task of a transfer from the sensor task. Return 1 if the
+ * 2 bytes address must be written by addr_task first, wr_buf holds it.
+ */
+static int sensor_bus_i2c_task_cfg(const sensor_dev_t *dev, uint16_t reg, uint8_t *buf, uint16_t len,
+		uint8_t rd, i2c_task_t *task, i2c_task_t *addr_task, uint8_t *wr_buf)
 {
-	i2c_task_t i2c_task, addr_task;
 	uint32_t task_id, task_off;
-	uint8_t wr_buf[16];
-	
-	if (dev->task == NULL) {
-		return -1;
-	}
-	
+	int ret = 0;
+
 	/* config task */
 	task_id = I2C_TASK_NUM - 1;
 	task_off = dev->io.bus_id * I2C_TASK_NUM + task_id;
-	i2c_task = *(i2c_task_t*)dev->task;
-	i2c_task.irq_type = I2C_TASK_IRQ_CMPLT | I2C_TASK_IRQ_NACK;
-	i2c_task.ctl.soft = 1;
+	*task = *(i2c_task_t*)dev->task;
+	task->irq_type = I2C_TASK_IRQ_CMPLT | I2C_TASK_IRQ_NACK;
+	task->ctl.soft = 1;
 #if defined(CONFIG_SOC_SERIES_LEOPARD)
-	i2c_task.slavedev.rwsel = rd;
-	i2c_task.slavedev.sdataddr = reg;
+	task->slavedev.rwsel = rd;
+	task->slavedev.sdataddr = reg;
 #else
-	i2c_task.ctl.rwsel = rd;
-	i2c_task.ctl.sdataddr = reg;
+	task->ctl.rwsel = rd;
+	task->ctl.sdataddr = reg;
 #endif
-	i2c_task.ctl.rdlen_wsdat = len;
-	i2c_task.dma.reload = 0;
-	i2c_task.dma.addr = (uint32_t)buf;
-	i2c_task.dma.len = len;
-	i2c_task.trig.en = 1;
-	i2c_task.trig.task = I2CMT0_TASK0 + task_off;
+	task->ctl.rdlen_wsdat = len;
+	task->dma.reload = 0;
+	task->dma.addr = (uint32_t)buf;
+	task->dma.len = len;
+	task->trig.en = 1;
+	task->trig.task = I2CMT0_TASK0 + task_off;
 	
 	// ignore data address
 	if (reg == REG_NULL) {
-		i2c_task.ctl.tdataddr = 1;
+		task->ctl.tdataddr = 1;
 	} else {
 		// process 2 bytes address
 		if (dev->hw.adr_len > 1) {
 			// write reg_h + reg_l
 #if defined(CONFIG_SOC_SERIES_LEOPARD)
-			i2c_task.slavedev.sdataddr = (reg >> 8);
+			task->slavedev.sdataddr = (reg >> 8);
 #else
-			i2c_task.ctl.sdataddr = (reg >> 8);
+			task->ctl.sdataddr = (reg >> 8);
 #endif
 			wr_buf[0] = (reg & 0xff);
 			if (!rd) {
-				if ((len + 1) > sizeof(wr_buf)) {
+				if ((len + 1) > SENSOR_BUS_WR_MAX) {
 					return -2;
 				}
 				// write wr_buf(reg_l + buf)
 				if (len > 0) {
 					memcpy(&wr_buf[1], buf, len);
 				}
-				i2c_task.dma.addr = (uint32_t)wr_buf;
-				i2c_task.dma.len = len + 1;
+				task->dma.addr = (uint32_t)wr_buf;
+				task->dma.len = len + 1;
 			} else {
 				// write 2 bytes address
-				addr_task = i2c_task;
+				*addr_task = *task;
 #if defined(CONFIG_SOC_SERIES_LEOPARD)
-				addr_task.slavedev.rwsel = 0;
+				addr_task->slavedev.rwsel = 0;
 #else
-				addr_task.ctl.rwsel = 0;
+				addr_task->ctl.rwsel = 0;
 #endif
-				addr_task.dma.addr = (uint32_t)wr_buf;
-				addr_task.dma.len = 1;
+				addr_task->dma.addr = (uint32_t)wr_buf;
+				addr_task->dma.len = 1;
 				// ignore data address
-				i2c_task.ctl.tdataddr = 1;
-				sensor_bus_i2c_xfer_task(dev, task_id, &addr_task);
+				task->ctl.tdataddr = 1;
+				ret = 1;
 			}
 		}
 	}
 	
+	return ret;
+}
+
+static int sensor_bus_i2c_xfer(const sensor_dev_t *dev, uint16_t reg, uint8_t *buf, uint16_t len, uint8_t rd)
+{
+	i2c_task_t i2c_task, addr_task;
+	uint32_t task_id = I2C_TASK_NUM - 1;
+	uint8_t wr_buf[SENSOR_BUS_WR_MAX];
+	int ret;
+	
+	if (dev->task == NULL) {
+		return -1;
+	}
+	
+	ret = sensor_bus_i2c_task_cfg(dev, reg, buf, len, rd, &i2c_task, &addr_task, wr_buf);
+	if (ret < 0) {
+		return ret;
+	} else if (ret > 0) {
+		sensor_bus_i2c_xfer_task(dev, task_id, &addr_task);
+	}
+	
 	/* start task */
 	return sensor_bus_i2c_xfer_task(dev, task_id, &i2c_task);
 }
@@ -222,35 +321,32 @@ static int sensor_bus_spi_xfer_task(const sensor_dev_t *dev, uint32_t task_id, s
 	return sensor_stat[dev->io.bus_type][dev->io.bus_id];
 }
 
-static int sensor_bus_spi_xfer(const sensor_dev_t *dev, uint16_t reg, uint8_t *buf, uint16_t len, uint8_t rd)
+// config the soft task of a transfer from the sensor task, return the task id
+static uint32_t sensor_bus_spi_task_cfg(const sensor_dev_t *dev, uint16_t reg, uint8_t *buf, uint16_t len,
+		uint8_t rd, spi_task_t *task)
 {
-	spi_task_t spi_task;
 	uint32_t task_id, task_off;
-	
-	if (dev->task == NULL) {
-		return -1;
-	}
 
 	/* config task */
-	spi_task = *(spi_task_t*)dev->task;
-	spi_task.irq_type = SPI_TASK_IRQ_CMPLT;
-	spi_task.ctl.soft = 1;
-	spi_task.ctl.rwsel = rd;
-	spi_task.ctl.sbsh = (dev->hw.adr_len > 1);
-	spi_task.ctl.wsdat = reg;
+	*task = *(spi_task_t*)dev->task;
+	task->irq_type = SPI_TASK_IRQ_CMPLT;
+	task->ctl.soft = 1;
+	task->ctl.rwsel = rd;
+	task->ctl.sbsh = (dev->hw.adr_len > 1);
+	task->ctl.wsdat = reg;
 	if (rd) {
 		if (dev->hw.adr_len > 1) {
-			spi_task.ctl.wsdat |= (1 << 15);
+			task->ctl.wsdat |= (1 << 15);
 		} else {
-			spi_task.ctl.wsdat |= (1 << 7);
+			task->ctl.wsdat |= (1 << 7);
 		}
 	}
-	spi_task.ctl.rdlen = len;
-	spi_task.dma.reload = 0;
-	spi_task.dma.addr = (uint32_t)buf;
-	spi_task.dma.len = len;
+	task->ctl.rdlen = len;
+	task->dma.reload = 0;
+	task->dma.addr = (uint32_t)buf;
+	task->dma.len = len;
 #if defined(CONFIG_SOC_SERIES_LEOPARD)
-	spi_task.task_cs = dev->io.bus_cs;
+	task->task_cs = dev->io.bus_cs;
 	task_id = SPI_TASK_NUM / 2 - 1;
 #else
 	if (dev->io.bus_cs == 0) {
@@ -260,7 +356,21 @@ static int sensor_bus_spi_xfer(const sensor_dev_t *dev, uint16_t reg, uint8_t *b
 	}
 #endif
 	task_off = dev->io.bus_id * SPI_TASK_NUM + task_id;
-	spi_task.trig.task = SPIMT0_TASK0 + task_off;
+	task->trig.task = SPIMT0_TASK0 + task_off;
+
+	return task_id;
+}
+
+static int sensor_bus_spi_xfer(const sensor_dev_t *dev, uint16_t reg, uint8_t *buf, uint16_t len, uint8_t rd)
+{
+	spi_task_t spi_task;
+	uint32_t task_id;
+	
+	if (dev->task == NULL) {
+		return -1;
+	}
+
+	task_id = sensor_bus_spi_task_cfg(dev, reg, buf, len, rd, &spi_task);
 	
 	/* start task */
 	return sensor_bus_spi_xfer_task(dev, task_id, &spi_task);
@@ -384,17 +494,36 @@ static int sensor_bus_spi_xfer(const sensor_dev_t *dev, uint16_t reg, uint8_t *b
 static int sensor_bus_xfer(const sensor_dev_t *dev, uint16_t reg, uint8_t *buf, uint16_t len, uint8_t rd)
 {
 	int ret = 0;
+#ifdef CONFIG_SENSOR_BUS_STAT
+	uint32_t start;
+#endif
 	
 	if (dev->hw.name == NULL) {
 		return -1;
 	}
+
+#ifdef CONFIG_SENSOR_TASK_CFG
+	// the soft task of the bus is taken by a list
+	if ((dev->io.bus_type < NUM_BUS) && (dev->io.bus_id < 2)
+		&& bus_list[dev->io.bus_type][dev->io.bus_id].busy) {
+		return -EBUSY;
+	}
+#endif
 	
+#ifdef CONFIG_SENSOR_BUS_STAT
+	start = k_cycle_get_32();
+#endif
+
 	if (dev->io.bus_type == BUS_I2C) {
 		ret = sensor_bus_i2c_xfer(dev, reg, buf, len, rd);
 	} else if (dev->io.bus_type == BUS_SPI) {
 		ret = sensor_bus_spi_xfer(dev, reg, buf, len, rd);
 	}
 	
+#ifdef CONFIG_SENSOR_BUS_STAT
+	sensor_bus_stat_xfer(dev, len, ret, k_cycle_get_32() - start);
+#endif
+
 	return ret;
 }
 
@@ -408,6 +537,38 @@ int sensor_bus_write(const sensor_dev_t *dev, uint16_t reg, uint8_t *buf, uint16
 	return sensor_bus_xfer(dev, reg, buf, len, 0);
 }
 
+#ifdef CONFIG_SENSOR_BUS_STAT
+int sensor_bus_get_stat(int bus_type, int bus_id, sensor_bus_stat_t *stat)
+{
+	unsigned int key;
+
+	if ((bus_type >= NUM_BUS) || (bus_id >= 2) || (stat == NULL)) {
+		return -1;
+	}
+
+	key = irq_lock();
+	*stat = bus_stat[bus_type][bus_id];
+	stat->total_us = (uint64_t)(k_uptime_get() - bus_stat_start[bus_type][bus_id]) * 1000;
+	irq_unlock(key);
+
+	return 0;
+}
+
+void sensor_bus_clear_stat(int bus_type, int bus_id)
+{
+	unsigned int key;
+
+	if ((bus_type >= NUM_BUS) || (bus_id >= 2)) {
+		return;
+	}
+
+	key = irq_lock();
+	memset(&bus_stat[bus_type][bus_id], 0, sizeof(sensor_bus_stat_t));
+	bus_stat_start[bus_type][bus_id] = k_uptime_get();
+	irq_unlock(key);
+}
+#endif
+
 static int sensor_bus_i2c_task_start(int bus_id, i2c_task_t *task, sensor_bus_cb_t cb, void *ctx)
 {
 	uint32_t task_id;
@@ -498,9 +659,306 @@ int sensor_bus_task_stop(const sensor_dev_t *dev)
 	return ret;
 }
 
-static int sensor_bus_init(const struct device *dev)
+static bool sensor_bus_can_merge(const sensor_bus_msg_t *first, const sensor_bus_msg_t *msg, uint16_t len)
 {
+	if (!(first->flags & SENSOR_BUS_MSG_READ) || (first->reg == REG_NULL)) {
+		return false;
+	}
+
+	if ((msg->flags & (SENSOR_BUS_MSG_READ | SENSOR_BUS_MSG_BURST))
+			!= (SENSOR_BUS_MSG_READ | SENSOR_BUS_MSG_BURST)) {
+		return false;
+	}
+
+	// register must follow the merged range
+	if (msg->reg != (uint16_t)(first->reg + len)) {
+		return false;
+	}
+
+	return ((len + msg->len) <= SENSOR_BUS_BURST_MAX);
+}
+
+// merge contiguous burst reads into msgs[i], return the message after them
+static int sensor_bus_merge(const sensor_bus_msg_t *msgs, int i, int num, uint16_t *plen)
+{
+	uint16_t len = msgs[i].len;
+	int j;
+
+	for (j = i + 1; j < num; j ++) {
+		if (!sensor_bus_can_merge(&msgs[i], &msgs[j], len)) {
+			break;
+		}
+		len += msgs[j].len;
+	}
+
+	*plen = len;
+	return j;
+}
+
+static void sensor_bus_scatter(sensor_bus_msg_t *msgs, int i, int end, const uint8_t *burst_buf)
+{
+	uint16_t off = 0;
+
+	for (; i < end; i ++) {
+		memcpy(msgs[i].buf, &burst_buf[off], msgs[i].len);
+		off += msgs[i].len;
+	}
+}
+
+// run the list one transfer at a time, in sleep mode or without bus tasks
+static int sensor_bus_xfer_list_sync(const sensor_dev_t *dev, sensor_bus_msg_t *msgs, int num)
+{
+	uint8_t burst_buf[SENSOR_BUS_BURST_MAX];
+	uint16_t len;
+	int i, j, merged = 0, ret = 0;
+
+	for (i = 0; i < num; i = j) {
+		j = sensor_bus_merge(msgs, i, num, &len);
+
+		if (j == (i + 1)) {
+			ret = sensor_bus_xfer(dev, msgs[i].reg, msgs[i].buf, msgs[i].len,
+					(msgs[i].flags & SENSOR_BUS_MSG_READ) ? 1 : 0);
+		} else {
+			// one burst read, then scatter to message buffers
+			ret = sensor_bus_xfer(dev, msgs[i].reg, burst_buf, len, 1);
+			if (ret == 0) {
+				sensor_bus_scatter(msgs, i, j, burst_buf);
+			}
+			merged += (j - i - 1);
+		}
+
+		if (ret) {
+			break;
+		}
+	}
+
+	sensor_bus_stat_list(dev, merged);
+
+	return ret;
+}
+
 #ifdef CONFIG_SENSOR_TASK_CFG
+
+static void sensor_bus_list_callback(unsigned char *buf, int len, void *ctx);
+
+static int sensor_bus_list_task_start(sensor_bus_list_t *list)
+{
+	const sensor_dev_t *dev = list->dev;
+
+	if (dev->io.bus_type == BUS_I2C) {
+		return sensor_bus_i2c_task_start(dev->io.bus_id,
+				list->addr ? &list->addr_task : &list->task.i2c, sensor_bus_list_callback, list);
+	} else {
+		return sensor_bus_spi_task_start(dev->io.bus_id, &list->task.spi,
+				sensor_bus_list_callback, list);
+	}
+}
+
+static void sensor_bus_list_task_stop(sensor_bus_list_t *list)
+{
+	const sensor_dev_t *dev = list->dev;
+
+	if (dev->io.bus_type == BUS_I2C) {
+		sensor_bus_i2c_task_stop(dev->io.bus_id, list->addr ? &list->addr_task : &list->task.i2c);
+	} else {
+		sensor_bus_spi_task_stop(dev->io.bus_id, &list->task.spi);
+	}
+}
+
+// start the transfer of msgs[cur] and the burst reads following it
+static int sensor_bus_list_submit(sensor_bus_list_t *list)
+{
+	const sensor_dev_t *dev = list->dev;
+	sensor_bus_msg_t *msg = &list->msgs[list->cur];
+	uint8_t rd = (msg->flags & SENSOR_BUS_MSG_READ) ? 1 : 0;
+	uint8_t *buf = msg->buf;
+	int ret = 0;
+
+	list->end = sensor_bus_merge(list->msgs, list->cur, list->num, &list->len);
+	if (list->end > (list->cur + 1)) {
+		buf = list->burst_buf;
+		list->merged += (list->end - list->cur - 1);
+	}
+
+	list->start = k_cycle_get_32();
+	if (dev->io.bus_type == BUS_I2C) {
+		ret = sensor_bus_i2c_task_cfg(dev, msg->reg, buf, list->len, rd,
+				&list->task.i2c, &list->addr_task, list->wr_buf);
+		if (ret < 0) {
+			return ret;
+		}
+		list->addr = ret;
+	} else {
+		sensor_bus_spi_task_cfg(dev, msg->reg, buf, list->len, rd, &list->task.spi);
+	}
+
+	return sensor_bus_list_task_start(list);
+}
+
+static void sensor_bus_list_done(sensor_bus_list_t *list, int ret)
+{
+	sensor_bus_stat_list(list->dev, list->merged);
+
+	list->busy = 0;
+	list->cb(ret, list->ctx);
+}
+
+// task irq: the transfer in flight is complete, start the next one
+static void sensor_bus_list_callback(unsigned char *buf, int len, void *ctx)
+{
+	sensor_bus_list_t *list = (sensor_bus_list_t*)ctx;
+	int ret = (buf != NULL) ? 0 : -1;
+
+	// stop task, read data is in the buffer after it
+	sensor_bus_list_task_stop(list);
+
+	// data of a 2 bytes address read
+	if (list->addr && (ret == 0)) {
+		list->addr = 0;
+		ret = sensor_bus_list_task_start(list);
+		if (ret) {
+			sensor_bus_list_done(list, ret);
+		}
+		return;
+	}
+
+	sensor_bus_stat_xfer(list->dev, list->len, ret, k_cycle_get_32() - list->start);
+
+	if (ret == 0) {
+		if (list->end > (list->cur + 1)) {
+			sensor_bus_scatter(list->msgs, list->cur, list->end, list->burst_buf);
+		}
+
+		list->cur = list->end;
+		if (list->cur < list->num) {
+			ret = sensor_bus_list_submit(list);
+			if (ret == 0) {
+				return;
+			}
+		}
+	}
+
+	sensor_bus_list_done(list, ret);
+}
+
+static void sensor_bus_list_abort(const sensor_dev_t *dev)
+{
+	sensor_bus_list_t *list = &bus_list[dev->io.bus_type][dev->io.bus_id];
+	unsigned int key;
+
+	key = irq_lock();
+	if (list->busy) {
+		sensor_bus_list_task_stop(list);
+		list->busy = 0;
+	}
+	irq_unlock(key);
+}
+
+static void sensor_bus_list_wake(int ret, void *ctx)
+{
+	const sensor_dev_t *dev = (const sensor_dev_t*)ctx;
+
+	sensor_stat[dev->io.bus_type][dev->io.bus_id] = ret;
+	k_sem_give(&sensor_sem[dev->io.bus_type][dev->io.bus_id]);
+}
+
+int sensor_bus_list_start(const sensor_dev_t *dev, sensor_bus_msg_t *msgs, int num,
+		sensor_bus_list_cb_t cb, void *ctx)
+{
+	sensor_bus_list_t *list;
+	unsigned int key;
+	int ret;
+
+	if ((dev->hw.name == NULL) || (dev->task == NULL) || (msgs == NULL) || (num <= 0)
+		|| (cb == NULL) || (dev->io.bus_type >= NUM_BUS) || (dev->io.bus_id >= 2)) {
+		return -1;
+	}
+
+	list = &bus_list[dev->io.bus_type][dev->io.bus_id];
+
+	key = irq_lock();
+	if (list->busy) {
+		irq_unlock(key);
+		return -EBUSY;
+	}
+	list->busy = 1;
+	list->dev = dev;
+	list->msgs = msgs;
+	list->num = num;
+	list->cur = 0;
+	list->merged = 0;
+	list->addr = 0;
+	list->cb = cb;
+	list->ctx = ctx;
+
+	// first transfer, the following ones start from the task irq
+	ret = sensor_bus_list_submit(list);
+	if (ret) {
+		list->busy = 0;
+	}
+	irq_unlock(key);
+
+	return ret;
+}
+
+int sensor_bus_xfer_list(const sensor_dev_t *dev, sensor_bus_msg_t *msgs, int num)
+{
+	int ret;
+
+	if ((dev->hw.name == NULL) || (msgs == NULL) || (num <= 0)) {
+		return -1;
+	}
+
+	// no task irq in sleep mode
+	if (soc_in_sleep_mode()) {
+		return sensor_bus_xfer_list_sync(dev, msgs, num);
+	}
+
+	k_sem_reset(&sensor_sem[dev->io.bus_type][dev->io.bus_id]);
+	ret = sensor_bus_list_start(dev, msgs, num, sensor_bus_list_wake, (void*)dev);
+	if (ret) {
+		return ret;
+	}
+
+	ret = k_sem_take(&sensor_sem[dev->io.bus_type][dev->io.bus_id], K_MSEC(20 * num));
+	if (ret) {
+		sensor_bus_list_abort(dev);
+		SYS_LOG_ERR("sensor: %s list timeout\n", dev->hw.name);
+		return -1;
+	}
+
+	return sensor_stat[dev->io.bus_type][dev->io.bus_id];
+}
+
+#else
+
+int sensor_bus_list_start(const sensor_dev_t *dev, sensor_bus_msg_t *msgs, int num,
+		sensor_bus_list_cb_t cb, void *ctx)
+{
+	if (cb == NULL) {
+		return -1;
+	}
+
+	// no bus task, run it at once
+	cb(sensor_bus_xfer_list(dev, msgs, num), ctx);
+
+	return 0;
+}
+
+int sensor_bus_xfer_list(const sensor_dev_t *dev, sensor_bus_msg_t *msgs, int num)
+{
+	if ((dev->hw.name == NULL) || (msgs == NULL) || (num <= 0)) {
+		return -1;
+	}
+
+	return sensor_bus_xfer_list_sync(dev, msgs, num);
+}
+
+#endif
+
+static int sensor_bus_init(const struct device *dev)
+{
+#if defined(CONFIG_SENSOR_TASK_CFG) || defined(CONFIG_SENSOR_BUS_STAT)
 	uint32_t i, j;
 #endif
 
@@ -515,6 +973,14 @@ static int sensor_bus_init(const struct device *dev)
 	
 	ARG_UNUSED(dev);
 
+#ifdef CONFIG_SENSOR_BUS_STAT
+	for (i = 0; i < NUM_BUS; i ++) {
+		for (j = 0; j < 2; j ++) {
+			sensor_bus_clear_stat(i, j);
+		}
+	}
+#endif
+
 	/* get device */
 	spimt_dev[0] = (struct device*)device_get_binding("SPIMT_0");
 	if (!spimt_dev[0]) {
@@ -378,6 +378,17 @@ int sensor_hal_write(int id, uint16_t reg, uint8_t *buf, uint16_t len)
 	return sensor_bus_write(dev, reg, buf, len);
 }
 
+int sensor_hal_xfer_list(int id, sensor_bus_msg_t *msgs, int num)
+{
+	const sensor_dev_t *dev = &sensor_dev[id];
+
+	if (!sensor_dev_is_valid(dev)) {
+		return -1;
+	}
+
+	return sensor_bus_xfer_list(dev, msgs, num);
+}
+
 int sensor_hal_poll_data(int id, sensor_dat_t *dat, uint8_t *buf)
 {
 	const sensor_dev_t *dev = &sensor_dev[id];
@@ -393,6 +404,27 @@ int sensor_hal_poll_data(int id, sensor_dat_t *dat, uint8_t *buf)
 		return -1;
 	}
 	
+#ifdef CONFIG_SENSOR_POLL_BURST
+	// read status and following data registers in one transfer
+	if ((buf != NULL) && (dev->hw.sta_reg != REG_NULL) && (dev->hw.data_cmd == 0)
+		&& (dev->hw.data_len > 0) && (dev->hw.data_reg == dev->hw.sta_reg + dev->hw.reg_len)) {
+		sensor_bus_msg_t msgs[2] = {
+			{ dev->hw.sta_reg, dev->hw.reg_len, (uint8_t*)&status, SENSOR_BUS_MSG_READ },
+			{ dev->hw.data_reg, dev->hw.data_len, buf, SENSOR_BUS_MSG_READ | SENSOR_BUS_MSG_BURST },
+		};
+
+		ret = sensor_bus_xfer_list(dev, msgs, ARRAY_SIZE(msgs));
+		if((ret != 0) || !(status & dev->hw.sta_rdy)) {
+			return -2;
+		}
+
+		sensor_hal_init_data(id, dat, NULL, 0);
+		dat->cnt = 1;
+		dat->buf = buf;
+		return dat->sz;
+	}
+#endif
+
 	// check status
 	if (dev->hw.sta_reg != REG_NULL) {
 		ret = sensor_bus_read(dev, dev->hw.sta_reg, (uint8_t*)&status, dev->hw.reg_len);